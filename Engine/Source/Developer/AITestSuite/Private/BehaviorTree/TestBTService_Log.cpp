@@ -0,0 +1,23 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "AITestSuitePrivatePCH.h"
+#include "BehaviorTree/TestBTService_Log.h"
+#include "MockAI_BT.h"
+
+UTestBTService_Log::UTestBTService_Log(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	NodeName = "Log";
+	LogIndex = 0;
+	RandomDeviation = 0.0f;
+}
+
+void UTestBTService_Log::TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
+{
+	Super::TickNode(OwnerComp, NodeMemory, DeltaSeconds);
+
+	// skip tick from search start, log only ticks driven by interval
+	if (DeltaSeconds > 0.0f)
+	{
+		UMockAI_BT::ExecutionLog.Add(LogIndex);
+	}
+}
@@ -1,4 +1,155 @@
 // Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
 
 #include "AITestSuitePrivatePCH.h"
+#include "MockAI.h"
 
+//----------------------------------------------------------------------//
+//
+//----------------------------------------------------------------------//
+struct FAITest_BBNotifies : public FAITestBase
+{
+	UMockAI* AIUser;
+	UBlackboardComponent* BBComp;
+	FBlackboard::FKey BoolKey;
+	FBlackboard::FKey IntKey;
+	FBlackboard::FKey FloatKey;
+
+	TArray<FBlackboard::FKey> NotifiedKeys;
+	TArray<int32> NotifiedIntValues;
+
+	FAITest_BBNotifies()
+		: AIUser(NULL)
+		, BBComp(NULL)
+		, BoolKey(FBlackboard::InvalidKey)
+		, IntKey(FBlackboard::InvalidKey)
+		, FloatKey(FBlackboard::InvalidKey)
+	{}
+
+	virtual void SetUp() override
+	{
+		UBlackboardData* BB = NewAutoDestroyObject<UBlackboardData>();
+		FBlackboardEntry KeyData;
+
+		KeyData.EntryName = TEXT("Bool1");
+		KeyData.KeyType = NewObject<UBlackboardKeyType_Bool>();
+		BB->Keys.Add(KeyData);
+
+		KeyData.EntryName = TEXT("Int1");
+		KeyData.KeyType = NewObject<UBlackboardKeyType_Int>();
+		BB->Keys.Add(KeyData);
+
+		KeyData.EntryName = TEXT("Float1");
+		KeyData.KeyType = NewObject<UBlackboardKeyType_Float>();
+		BB->Keys.Add(KeyData);
+
+		BB->UpdateParentKeys();
+
+		AIUser = NewAutoDestroyObject<UMockAI>();
+		AIUser->UseBlackboardComponent();
+		BBComp = AIUser->BBComp;
+		BBComp->InitializeBlackboard(*BB);
+
+		BoolKey = BBComp->GetKeyID(TEXT("Bool1"));
+		IntKey = BBComp->GetKeyID(TEXT("Int1"));
+		FloatKey = BBComp->GetKeyID(TEXT("Float1"));
+	}
+
+	FDelegateHandle Observe(FBlackboard::FKey KeyID)
+	{
+		return BBComp->RegisterObserver(KeyID, AIUser, FOnBlackboardChange::CreateRaw(this, &FAITest_BBNotifies::OnKeyChanged));
+	}
+
+	void OnKeyChanged(const UBlackboardComponent& Blackboard, FBlackboard::FKey ChangedKeyID)
+	{
+		NotifiedKeys.Add(ChangedKeyID);
+		if (ChangedKeyID == IntKey)
+		{
+			NotifiedIntValues.Add(Blackboard.GetValue<UBlackboardKeyType_Int>(ChangedKeyID));
+		}
+	}
+};
+
+struct FAITest_BBQueuedNotifyFinalValue : public FAITest_BBNotifies
+{
+	virtual void InstantTest() override
+	{
+		Observe(IntKey);
+
+		BBComp->SetQueuedNotifies(true);
+		BBComp->SetValue<UBlackboardKeyType_Int>(IntKey, 1);
+		BBComp->SetValue<UBlackboardKeyType_Int>(IntKey, 2);
+		BBComp->SetValue<UBlackboardKeyType_Int>(IntKey, 3);
+		Test(TEXT("Queued changes should not be sent before dispatch"), NotifiedKeys.Num() == 0);
+
+		BBComp->DispatchQueuedUpdates();
+		Test(TEXT("Key changed multiple times should be notified once"), NotifiedKeys.Num() == 1 && NotifiedKeys[0] == IntKey);
+		Test(TEXT("Observer should see final value of key"), NotifiedIntValues.Num() == 1 && NotifiedIntValues[0] == 3);
+
+		BBComp->DispatchQueuedUpdates();
+		Test(TEXT("Dispatched changes should not be sent again"), NotifiedKeys.Num() == 1);
+
+		// disabling queue sends what is left
+		BBComp->SetValue<UBlackboardKeyType_Int>(IntKey, 4);
+		BBComp->SetQueuedNotifies(false);
+		Test(TEXT("Disabling queue should send remaining changes"), NotifiedIntValues.Num() == 2 && NotifiedIntValues[1] == 4);
+	}
+};
+IMPLEMENT_AI_INSTANT_TEST(FAITest_BBQueuedNotifyFinalValue, "Engine.AI.Blackboard.Queued notifies: single notify with final value")
+
+struct FAITest_BBUnobservedKeys : public FAITest_BBNotifies
+{
+	virtual void InstantTest() override
+	{
+		const FDelegateHandle IntHandle = Observe(IntKey);
+
+		// changes of keys without observers are skipped, not queued
+		BBComp->SetQueuedNotifies(true);
+		BBComp->SetValue<UBlackboardKeyType_Bool>(BoolKey, true);
+		BBComp->SetValue<UBlackboardKeyType_Int>(IntKey, 1);
+		Observe(BoolKey);
+
+		BBComp->DispatchQueuedUpdates();
+		Test(TEXT("Only observed key should be notified"), NotifiedKeys.Num() == 1 && NotifiedKeys[0] == IntKey);
+
+		// key stops being observed after its last observer is removed
+		BBComp->SetQueuedNotifies(false);
+		BBComp->UnregisterObserver(IntKey, IntHandle);
+		BBComp->SetValue<UBlackboardKeyType_Int>(IntKey, 2);
+		BBComp->SetValue<UBlackboardKeyType_Bool>(BoolKey, false);
+		Test(TEXT("Key without observers should not be notified"), NotifiedKeys.Num() == 2 && NotifiedKeys[1] == BoolKey);
+	}
+};
+IMPLEMENT_AI_INSTANT_TEST(FAITest_BBUnobservedKeys, "Engine.AI.Blackboard.Queued notifies: unobserved keys")
+
+struct FAITest_BBTypedSetters : public FAITest_BBNotifies
+{
+	virtual void InstantTest() override
+	{
+		Observe(IntKey);
+		Observe(FloatKey);
+
+		Test(TEXT("Typed setter should accept key of its type"), BBComp->SetValue<UBlackboardKeyType_Int>(IntKey, 7));
+		Test(TEXT("Typed setter should notify about change"), NotifiedKeys.Num() == 1 && NotifiedIntValues.Last() == 7);
+
+		BBComp->SetValueAsInt(TEXT("Int1"), 7);
+		Test(TEXT("Generic setter should not notify when value is the same"), NotifiedKeys.Num() == 1);
+
+		BBComp->SetValueAsInt(TEXT("Int1"), 8);
+		Test(TEXT("Generic setter should notify about change"), NotifiedKeys.Num() == 2 && NotifiedIntValues.Last() == 8);
+
+		BBComp->SetValue<UBlackboardKeyType_Int>(IntKey, 8);
+		Test(TEXT("Typed setter should not notify when value is the same"), NotifiedKeys.Num() == 2);
+
+		Test(TEXT("Typed setter should reject key of other type"), !BBComp->SetValue<UBlackboardKeyType_Float>(IntKey, 1.0f));
+		Test(TEXT("Rejected value should not be notified"), NotifiedKeys.Num() == 2);
+		Test(TEXT("Typed and generic getters should return the same value"),
+			BBComp->GetValue<UBlackboardKeyType_Int>(IntKey) == 8 && BBComp->GetValueAsInt(TEXT("Int1")) == 8);
+
+		BBComp->SetValue<UBlackboardKeyType_Float>(FloatKey, 0.5f);
+		BBComp->SetValueAsFloat(TEXT("Float1"), 0.5f);
+		BBComp->SetValueAsFloat(TEXT("Float1"), 1.5f);
+		BBComp->SetValue<UBlackboardKeyType_Float>(FloatKey, 1.5f);
+		Test(TEXT("Typed and generic setters should notify each change once"), NotifiedKeys.Num() == 4 && NotifiedKeys[2] == FloatKey && NotifiedKeys[3] == FloatKey);
+	}
+};
+IMPLEMENT_AI_INSTANT_TEST(FAITest_BBTypedSetters, "Engine.AI.Blackboard.Typed setters notify like generic setters")
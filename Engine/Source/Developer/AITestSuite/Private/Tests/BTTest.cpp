@@ -3,6 +3,7 @@
 #include "AITestSuitePrivatePCH.h"
 #include "MockAI_BT.h"
 #include "BehaviorTree/TestBTDecorator_CantExecute.h"
+#include "BehaviorTree/Decorators/BTDecorator_Loop.h"
 
 #define LOCTEXT_NAMESPACE "AITestSuite_BTTest"
 
@@ -586,4 +587,185 @@ struct FAITest_BTSubtreeAbortOut : public FAITest_SimpleBT
 };
 IMPLEMENT_AI_LATENT_TEST(FAITest_BTSubtreeAbortOut, "Engine.AI.Behavior Trees.Subtree: abort out")
 
+struct FAITest_BTSubtreeMemoryReuse : public FAITest_SimpleBT
+{
+	TArray<int32> UsedBlocks;
+
+	FAITest_BTSubtreeMemoryReuse()
+	{
+		UBehaviorTree& ChildAsset = FBTBuilder::CreateBehaviorTree(*BTAsset);
+		{
+			UBTCompositeNode& CompNode = FBTBuilder::AddSequence(ChildAsset);
+			{
+				FBTBuilder::AddTask(CompNode, 10, EBTNodeResult::Succeeded, 1);
+			}
+		}
+
+		UBTCompositeNode& CompNode = FBTBuilder::AddSequence(*BTAsset);
+		{
+			FBTBuilder::AddTaskSubtree(CompNode, &ChildAsset);
+			{
+				FBTBuilder::WithDecorator<UBTDecorator_Loop>(CompNode);
+			}
+
+			FBTBuilder::AddTask(CompNode, 1, EBTNodeResult::Succeeded);
+		}
+
+		ExpectedResult.Add(10);
+		ExpectedResult.Add(10);
+		ExpectedResult.Add(10);
+		ExpectedResult.Add(1);
+	}
+
+	virtual bool Update() override
+	{
+		const int32 PrevLogNum = UMockAI_BT::ExecutionLog.Num();
+		const bool bFinished = FAITest_SimpleBT::Update();
+
+		// subtree was pushed again after previous run popped it
+		if (UMockAI_BT::ExecutionLog.Num() > PrevLogNum && UMockAI_BT::ExecutionLog.Last() == 10)
+		{
+			UsedBlocks.Add(FBTInstanceMemoryAllocator::GetNumUsedBlocks());
+		}
+
+		if (bFinished)
+		{
+			bool bReused = (UsedBlocks.Num() == 3);
+			for (int32 Idx = 1; Idx < UsedBlocks.Num(); Idx++)
+			{
+				bReused = bReused && (UsedBlocks[Idx] == UsedBlocks[0]);
+			}
+
+			Test(TEXT("Instance memory of popped subtree is reused by next push"), bReused);
+		}
+
+		return bFinished;
+	}
+};
+IMPLEMENT_AI_LATENT_TEST(FAITest_BTSubtreeMemoryReuse, "Engine.AI.Behavior Trees.Subtree: instance memory reuse")
+
+struct FAITest_BTServiceTickIntervals : public FAITest_SimpleBT
+{
+	bool bBatchedTicks;
+	int32 PrevBatchedTicks;
+
+	FAITest_BTServiceTickIntervals()
+	{
+		bBatchedTicks = false;
+		PrevBatchedTicks = 0;
+
+		UBTCompositeNode& CompNode = FBTBuilder::AddSequence(*BTAsset);
+		{
+			UBTCompositeNode& CompNode2 = FBTBuilder::AddSequence(CompNode);
+			{
+				// 0.09s interval with 1/30s ticks: every 3rd tick
+				FBTBuilder::WithServiceLog(CompNode2, 10, 0.09f);
+
+				FBTBuilder::AddTaskLogFinish(CompNode2, 0, 1, EBTNodeResult::Succeeded, 10);
+			}
+		}
+
+		ExpectedResult.Add(0);
+		ExpectedResult.Add(10);
+		ExpectedResult.Add(10);
+		ExpectedResult.Add(10);
+		ExpectedResult.Add(1);
+	}
+
+	virtual void SetUp() override
+	{
+		IConsoleVariable* BatchedTicksVar = IConsoleManager::Get().FindConsoleVariable(TEXT("ai.BT.BatchedServiceTicks"));
+		PrevBatchedTicks = BatchedTicksVar->GetInt();
+		BatchedTicksVar->Set(bBatchedTicks ? 1 : 0);
+
+		FAITest_SimpleBT::SetUp();
+	}
+
+	virtual void TearDown() override
+	{
+		IConsoleVariable* BatchedTicksVar = IConsoleManager::Get().FindConsoleVariable(TEXT("ai.BT.BatchedServiceTicks"));
+		BatchedTicksVar->Set(PrevBatchedTicks);
+
+		FAITest_SimpleBT::TearDown();
+	}
+};
+IMPLEMENT_AI_LATENT_TEST(FAITest_BTServiceTickIntervals, "Engine.AI.Behavior Trees.Service: tick intervals")
+
+struct FAITest_BTServiceBatchedTickIntervals : public FAITest_BTServiceTickIntervals
+{
+	FAITest_BTServiceBatchedTickIntervals()
+	{
+		bBatchedTicks = true;
+	}
+};
+IMPLEMENT_AI_LATENT_TEST(FAITest_BTServiceBatchedTickIntervals, "Engine.AI.Behavior Trees.Service: batched tick intervals")
+
+struct FAITest_BTQueuedNotifiesSameTick : public FAITest_SimpleBT
+{
+	int32 PrevQueuedNotifies;
+	bool bFlagNotified;
+	bool bFlagChecked;
+
+	FAITest_BTQueuedNotifiesSameTick()
+		: PrevQueuedNotifies(0)
+		, bFlagNotified(false)
+		, bFlagChecked(false)
+	{
+		// flag is set by task executed at the start of a tick, after queued notifies of previous frame were sent
+		UBTCompositeNode& CompNode = FBTBuilder::AddSequence(*BTAsset);
+		{
+			FBTBuilder::AddTask(CompNode, 0, EBTNodeResult::Succeeded, 1);
+			FBTBuilder::AddTaskFlagChange(CompNode, true, EBTNodeResult::Succeeded);
+			FBTBuilder::AddTask(CompNode, 1, EBTNodeResult::Succeeded, 3);
+		}
+
+		ExpectedResult.Add(0);
+		ExpectedResult.Add(1);
+	}
+
+	virtual void SetUp() override
+	{
+		IConsoleVariable* QueuedNotifiesVar = IConsoleManager::Get().FindConsoleVariable(TEXT("ai.BT.QueuedBlackboardNotifies"));
+		PrevQueuedNotifies = QueuedNotifiesVar->GetInt();
+		QueuedNotifiesVar->Set(1);
+
+		FAITest_SimpleBT::SetUp();
+
+		UBlackboardComponent* BBComp = AIBTUser ? AIBTUser->BBComp : NULL;
+		if (BBComp)
+		{
+			BBComp->RegisterObserver(BBComp->GetKeyID(TEXT("Bool1")), AIBTUser, FOnBlackboardChange::CreateRaw(this, &FAITest_BTQueuedNotifiesSameTick::OnFlagChanged));
+		}
+	}
+
+	void OnFlagChanged(const UBlackboardComponent& Blackboard, FBlackboard::FKey ChangedKeyID)
+	{
+		bFlagNotified = true;
+	}
+
+	virtual bool Update() override
+	{
+		const bool bFinished = FAITest_SimpleBT::Update();
+
+		// change made during behavior tree tick has to reach observers by the end of it
+		UBlackboardComponent* BBComp = AIBTUser ? AIBTUser->BBComp : NULL;
+		if (!bFlagChecked && BBComp && BBComp->GetValue<UBlackboardKeyType_Bool>(BBComp->GetKeyID(TEXT("Bool1"))))
+		{
+			bFlagChecked = true;
+			Test(TEXT("Queued blackboard change made by task should be sent in the same tick"), bFlagNotified);
+		}
+
+		return bFinished;
+	}
+
+	virtual void TearDown() override
+	{
+		IConsoleVariable* QueuedNotifiesVar = IConsoleManager::Get().FindConsoleVariable(TEXT("ai.BT.QueuedBlackboardNotifies"));
+		QueuedNotifiesVar->Set(PrevQueuedNotifies);
+
+		FAITest_SimpleBT::TearDown();
+	}
+};
+IMPLEMENT_AI_LATENT_TEST(FAITest_BTQueuedNotifiesSameTick, "Engine.AI.Behavior Trees.Queued blackboard notifies: changes made by nodes")
+
 #undef LOCTEXT_NAMESPACE
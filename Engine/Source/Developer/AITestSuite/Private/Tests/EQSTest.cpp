@@ -0,0 +1,152 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "AITestSuitePrivatePCH.h"
+#include "EnvironmentQuery/EnvQuery.h"
+#include "EnvironmentQuery/EnvQueryOption.h"
+#include "EnvironmentQuery/EnvQueryManager.h"
+#include "EnvironmentQuery/Generators/EnvQueryGenerator_SimpleGrid.h"
+#include "EnvironmentQuery/Tests/EnvQueryTest_Distance.h"
+
+//----------------------------------------------------------------------//
+//
+//----------------------------------------------------------------------//
+struct FAITest_EQSParallelDistance : public FAITestBase
+{
+	UEnvQueryManager* QueryManager;
+	UEnvQuery* QueryTemplate;
+	AActor* Querier;
+
+	FAITest_EQSParallelDistance()
+		: QueryManager(NULL)
+		, QueryTemplate(NULL)
+		, Querier(NULL)
+	{}
+
+	/** creates a node of the query, generators and tests classes aren't exported so they're looked up by name */
+	template<typename BaseClass>
+	BaseClass* NewQueryNode(UObject* Outer, const TCHAR* ClassName)
+	{
+		UClass* NodeClass = FindObject<UClass>(ANY_PACKAGE, ClassName);
+		return NodeClass ? NewObject<BaseClass>(Outer, NodeClass) : NULL;
+	}
+
+	virtual void SetUp() override
+	{
+		UWorld& World = GetWorld();
+
+		// own manager, ticked only by the test
+		QueryManager = NewObject<UEnvQueryManager>(&World);
+		QueryManager->AddToRoot();
+
+		FActorSpawnParameters SpawnInfo;
+		SpawnInfo.ObjectFlags = RF_Transient;
+		Querier = World.SpawnActor<AActor>(AActor::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator, SpawnInfo);
+
+		// grid of about 40k points around the querier, scored by 3D distance and filtered by 2D distance
+		QueryTemplate = NewAutoDestroyObject<UEnvQuery>();
+		UEnvQueryOption* Option = NewObject<UEnvQueryOption>(QueryTemplate);
+		QueryTemplate->Options.Add(Option);
+
+		UEnvQueryGenerator_SimpleGrid* Grid = (UEnvQueryGenerator_SimpleGrid*)NewQueryNode<UEnvQueryGenerator>(Option, TEXT("EnvQueryGenerator_SimpleGrid"));
+		UEnvQueryTest_Distance* Distance3D = (UEnvQueryTest_Distance*)NewQueryNode<UEnvQueryTest>(Option, TEXT("EnvQueryTest_Distance"));
+		UEnvQueryTest_Distance* Distance2D = (UEnvQueryTest_Distance*)NewQueryNode<UEnvQueryTest>(Option, TEXT("EnvQueryTest_Distance"));
+		if (Grid == NULL || Distance3D == NULL || Distance2D == NULL)
+		{
+			Test(TEXT("EQS node classes should exist"), false);
+			return;
+		}
+
+		Grid->GridSize.DefaultValue = 1000.0f;
+		Grid->SpaceBetween.DefaultValue = 10.0f;
+		Grid->ProjectionData.TraceMode = EEnvQueryTrace::None;
+		Option->Generator = Grid;
+
+		Distance3D->TestMode = EEnvTestDistance::Distance3D;
+		Distance3D->TestPurpose = EEnvTestPurpose::Score;
+		Distance3D->TestOrder = 0;
+		Option->Tests.Add(Distance3D);
+
+		Distance2D->TestMode = EEnvTestDistance::Distance2D;
+		Distance2D->TestPurpose = EEnvTestPurpose::FilterAndScore;
+		Distance2D->FilterType = EEnvTestFilterType::Range;
+		Distance2D->FloatValueMin.DefaultValue = 100.0f;
+		Distance2D->FloatValueMax.DefaultValue = 800.0f;
+		Distance2D->TestOrder = 1;
+		Option->Tests.Add(Distance2D);
+	}
+
+	void InstantTest()
+	{
+		if (QueryTemplate->Options.Num() == 0 || QueryTemplate->Options[0]->Generator == NULL)
+		{
+			return;
+		}
+
+		IConsoleVariable* ParallelTestsVar = IConsoleManager::Get().FindConsoleVariable(TEXT("ai.EQS.ParallelTests"));
+		IConsoleVariable* TimeBudgetVar = IConsoleManager::Get().FindConsoleVariable(TEXT("ai.EQS.TimeBudgetMs"));
+		const int32 OldParallelTests = ParallelTestsVar->GetInt();
+		const float OldTimeBudget = TimeBudgetVar->GetFloat();
+
+		FEnvQueryRequest Request(QueryTemplate, Querier);
+
+		// reference: every step on the game thread without a time limit
+		TSharedPtr<FEnvQueryResult> SerialResult = QueryManager->RunInstantQuery(Request, EEnvQueryRunMode::AllMatching);
+
+		// tests scored on worker threads, time sliced over many ticks by a small budget
+		ParallelTestsVar->Set(1);
+		TimeBudgetVar->Set(0.2f);
+
+		TSharedPtr<FEnvQueryInstance> ParallelQuery = QueryManager->PrepareQueryInstance(Request, EEnvQueryRunMode::AllMatching);
+		QueryManager->RunQuery(ParallelQuery, FQueryFinishedSignature());
+
+		int32 NumTicks = 0;
+		const int32 MaxTicks = 100000;
+		while (!ParallelQuery->IsFinished() && NumTicks < MaxTicks)
+		{
+			QueryManager->Tick(FAITestHelpers::TickInterval);
+			NumTicks++;
+		}
+
+		ParallelTestsVar->Set(OldParallelTests);
+		TimeBudgetVar->Set(OldTimeBudget);
+
+		Test(TEXT("Serial query should finish with items"), SerialResult.IsValid() && SerialResult->IsFinished() && SerialResult->Items.Num() > 0);
+		Test(TEXT("Parallel query should finish"), ParallelQuery->IsFinished() && !ParallelQuery->IsAborted());
+		if (!SerialResult.IsValid() || SerialResult->Items.Num() == 0 || !ParallelQuery->IsFinished())
+		{
+			return;
+		}
+
+		// finished queries only keep the items that passed the filter, sorted by score
+		bool bFiltered = true;
+		for (int32 ItemIndex = 0; ItemIndex < SerialResult->Items.Num(); ItemIndex++)
+		{
+			const float Distance2D = SerialResult->GetItemAsLocation(ItemIndex).Size2D();
+			bFiltered = bFiltered && Distance2D >= 100.0f - KINDA_SMALL_NUMBER && Distance2D <= 800.0f + KINDA_SMALL_NUMBER;
+		}
+		Test(TEXT("Items out of the 2D distance range should be filtered out"), bFiltered);
+		Test(TEXT("Both runs should keep the same number of items"), SerialResult->Items.Num() == ParallelQuery->Items.Num());
+
+		bool bSameItems = (SerialResult->Items.Num() == ParallelQuery->Items.Num());
+		for (int32 ItemIndex = 0; bSameItems && ItemIndex < SerialResult->Items.Num(); ItemIndex++)
+		{
+			bSameItems = SerialResult->GetItemAsLocation(ItemIndex).Equals(ParallelQuery->GetItemAsLocation(ItemIndex))
+				&& FMath::IsNearlyEqual(SerialResult->Items[ItemIndex].Score, ParallelQuery->Items[ItemIndex].Score, KINDA_SMALL_NUMBER);
+		}
+		Test(TEXT("Both runs should score the same items the same way"), bSameItems);
+	}
+
+	virtual void TearDown() override
+	{
+		if (Querier)
+		{
+			Querier->Destroy();
+		}
+		if (QueryManager)
+		{
+			QueryManager->RemoveFromRoot();
+		}
+		FAITestBase::TearDown();
+	}
+};
+IMPLEMENT_AI_INSTANT_TEST(FAITest_EQSParallelDistance, "Engine.AI.EQS.Parallel distance tests")
@@ -0,0 +1,159 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "AITestSuitePrivatePCH.h"
+#include "AISystem.h"
+#include "Perception/AIPerceptionSystem.h"
+#include "Perception/AISense_Sight.h"
+#include "Perception/AISenseConfig_Sight.h"
+#include "Components/BoxComponent.h"
+
+//----------------------------------------------------------------------//
+//
+//----------------------------------------------------------------------//
+struct FAITest_SightBatchedTraces : public FAITestBase
+{
+	UWorld* World;
+	UAIPerceptionSystem* PerceptionSystem;
+	TArray<AActor*> Targets;
+	IConsoleVariable* BatchedTracesVar;
+	int32 OldBatchedTraces;
+
+	FAITest_SightBatchedTraces()
+		: World(NULL)
+		, PerceptionSystem(NULL)
+		, BatchedTracesVar(NULL)
+		, OldBatchedTraces(0)
+	{}
+
+	/** spawns an actor with a root component of the given class, not registered yet */
+	template<typename RootClass>
+	RootClass* SpawnActorWithRoot(const FVector& Location, const FRotator& Rotation = FRotator::ZeroRotator)
+	{
+		AActor* Actor = World->SpawnActor<AActor>(AActor::StaticClass(), Location, Rotation);
+		RootClass* Root = NewObject<RootClass>(Actor);
+		Root->RelativeLocation = Location;
+		Root->RelativeRotation = Rotation;
+		Actor->SetRootComponent(Root);
+		return Root;
+	}
+
+	/** spawns an actor seeing in front of it with the sight sense */
+	AActor* SpawnListener(const FVector& Location)
+	{
+		USceneComponent* Root = SpawnActorWithRoot<USceneComponent>(Location);
+		Root->RegisterComponent();
+
+		AActor* Listener = Root->GetOwner();
+		UAIPerceptionComponent* PerceptionComp = NewObject<UAIPerceptionComponent>(Listener);
+		UAISenseConfig_Sight* SightConfig = NewObject<UAISenseConfig_Sight>(PerceptionComp);
+		SightConfig->Implementation = UAISense_Sight::StaticClass();
+		SightConfig->SightRadius = 2000.f;
+		SightConfig->LoseSightRadius = 2500.f;
+		SightConfig->PeripheralVisionAngleDegrees = 90.f;
+		PerceptionComp->ConfigureSense(*SightConfig);
+		PerceptionComp->RegisterComponent();
+		return Listener;
+	}
+
+	virtual void SetUp() override
+	{
+		// own game world, cleaned up by the test while sight traces are still in flight
+		World = UWorld::CreateWorld(EWorldType::Game, false);
+		FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+		WorldContext.SetCurrentWorld(World);
+		World->CreateAISystem();
+
+		FURL URL;
+		World->InitializeActorsForPlay(URL);
+		World->BeginPlay();
+
+		PerceptionSystem = UAIPerceptionSystem::GetCurrent(World);
+		BatchedTracesVar = IConsoleManager::Get().FindConsoleVariable(TEXT("ai.Sight.BatchedTraces"));
+		OldBatchedTraces = BatchedTracesVar->GetInt();
+
+		// a wall hiding some of the targets from some of the listeners
+		UBoxComponent* WallBox = SpawnActorWithRoot<UBoxComponent>(FVector(500.f, 300.f, 100.f));
+		WallBox->SetBoxExtent(FVector(20.f, 150.f, 200.f));
+		WallBox->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+		WallBox->RegisterComponent();
+
+		// in front of the listeners, behind the wall, out of sight range and behind the listeners
+		const FVector TargetLocations[] = { FVector(1000.f, -300.f, 100.f), FVector(1000.f, 0.f, 100.f), FVector(1000.f, 300.f, 100.f),
+			FVector(800.f, 600.f, 100.f), FVector(3000.f, 0.f, 100.f), FVector(-500.f, 0.f, 100.f) };
+		for (int32 TargetIndex = 0; TargetIndex < ARRAY_COUNT(TargetLocations); ++TargetIndex)
+		{
+			USceneComponent* TargetRoot = SpawnActorWithRoot<USceneComponent>(TargetLocations[TargetIndex]);
+			TargetRoot->RegisterComponent();
+			AActor* Target = TargetRoot->GetOwner();
+			UAIPerceptionSystem::RegisterPerceptionStimuliSource(World, UAISense_Sight::StaticClass(), Target);
+			Targets.Add(Target);
+		}
+	}
+
+	/** spawns the listeners, lets the sight sense see the targets and gathers whether each listener saw each target */
+	void SenseTargets(bool bBatched, TArray<bool>& OutSeen)
+	{
+		BatchedTracesVar->Set(bBatched ? 1 : 0);
+
+		TArray<AActor*> Listeners;
+		const FVector ListenerLocations[] = { FVector(0.f, -200.f, 100.f), FVector(0.f, 0.f, 100.f), FVector(0.f, 200.f, 100.f) };
+		for (int32 ListenerIndex = 0; ListenerIndex < ARRAY_COUNT(ListenerLocations); ++ListenerIndex)
+		{
+			Listeners.Add(SpawnListener(ListenerLocations[ListenerIndex]));
+		}
+
+		// enough updates for every query to be traced, batched results are applied by the update after the one submitting them
+		for (int32 TickIndex = 0; TickIndex < 16; ++TickIndex)
+		{
+			PerceptionSystem->Tick(FAITestHelpers::TickInterval);
+		}
+
+		const FAISenseID SightID = UAISense::GetSenseID<UAISense_Sight>();
+		for (AActor* Listener : Listeners)
+		{
+			const UAIPerceptionComponent* PerceptionComp = Listener->FindComponentByClass<UAIPerceptionComponent>();
+			for (AActor* Target : Targets)
+			{
+				const FActorPerceptionInfo* Info = PerceptionComp->GetActorInfo(*Target);
+				OutSeen.Add(Info != NULL && Info->LastSensedStimuli.IsValidIndex(SightID) && Info->LastSensedStimuli[SightID].WasSuccessfullySensed());
+			}
+			Listener->Destroy();
+		}
+	}
+
+	void InstantTest()
+	{
+		if (PerceptionSystem == NULL)
+		{
+			Test(TEXT("Test world should have a perception system"), false);
+			return;
+		}
+
+		TArray<bool> SerialSeen;
+		TArray<bool> BatchedSeen;
+		SenseTargets(false, SerialSeen);
+		SenseTargets(true, BatchedSeen);
+
+		Test(TEXT("Some targets should be seen and some not"), SerialSeen.Contains(true) && SerialSeen.Contains(false));
+		Test(TEXT("Batched and unbatched traces should give the same stimuli"), SerialSeen == BatchedSeen);
+
+		// leave a batch in flight, waited for by the world cleanup in TearDown
+		SpawnListener(FVector(0.f, 0.f, 100.f));
+		PerceptionSystem->Tick(FAITestHelpers::TickInterval);
+	}
+
+	virtual void TearDown() override
+	{
+		if (BatchedTracesVar)
+		{
+			BatchedTracesVar->Set(OldBatchedTraces);
+		}
+		if (World)
+		{
+			GEngine->DestroyWorldContext(World);
+			World->DestroyWorld(false);
+		}
+		FAITestBase::TearDown();
+	}
+};
+IMPLEMENT_AI_INSTANT_TEST(FAITest_SightBatchedTraces, "Engine.AI.Perception.Batched sight traces")
@@ -12,6 +12,7 @@
 
 #include "BehaviorTree/TestBTTask_Log.h"
 #include "BehaviorTree/TestBTTask_SetFlag.h"
+#include "BehaviorTree/TestBTService_Log.h"
 #include "BehaviorTree/TestBTDecorator_DelayedAbort.h"
 
 struct FBTBuilder
@@ -158,6 +159,18 @@ struct FBTBuilder
 		ParentNode.Children[ChildIdx].ChildTask = TaskNode;
 	}
 
+	static void WithServiceLog(UBTCompositeNode& ParentNode, int32 LogIndex, float Interval)
+	{
+		UTestBTService_Log* ServiceOb = NewObject<UTestBTService_Log>(ParentNode.GetTreeAsset());
+		ServiceOb->LogIndex = LogIndex;
+
+		UFloatProperty* IntervalProp = FindField<UFloatProperty>(UBTService::StaticClass(), TEXT("Interval"));
+		float* IntervalPropData = IntervalProp->ContainerPtrToValuePtr<float>(ServiceOb);
+		*IntervalPropData = Interval;
+
+		ParentNode.Services.Add(ServiceOb);
+	}
+
 	template<class T>
 	static T& WithDecorator(UBTCompositeNode& ParentNode, UClass* DecoratorClass = T::StaticClass())
 	{
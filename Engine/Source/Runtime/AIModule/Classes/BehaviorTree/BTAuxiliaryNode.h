@@ -41,6 +41,15 @@ class AIMODULE_API UBTAuxiliaryNode : public UBTNode
 	/** wrapper for node instancing: TickNode */
 	void WrappedTickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) const;
 
+	/** @return true if node can be ticked in batches across components (see UBehaviorTreeManager::TickBatchedServices): not instanced and ticking at intervals */
+	bool CanTickInBatch() const;
+
+	/** batched tick: advances interval of node, @return true if TickNode is due */
+	bool AdvanceTickInterval(uint8* NodeMemory, float DeltaSeconds) const;
+
+	/** batched tick: calls TickNode with time accumulated since last tick */
+	void TickBatchedNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) const;
+
 	virtual void DescribeRuntimeValues(const UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTDescriptionVerbosity::Type Verbosity, TArray<FString>& Values) const override;
 	virtual uint16 GetSpecialMemorySize() const override;
 
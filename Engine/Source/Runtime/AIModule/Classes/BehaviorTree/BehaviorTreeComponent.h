@@ -14,6 +14,7 @@ class UBTDecorator;
 class UBTTask_RunBehavior;
 class FBehaviorTreeDebugger;
 class UBehaviorTree;
+class UBehaviorTreeManager;
 class UBTAuxiliaryNode;
 struct FBehaviorTreeInstance;
 struct FBehaviorTreeInstanceId;
@@ -229,6 +230,12 @@ protected:
 	/** if set, execution requests will be postponed */
 	uint8 bIsPaused : 1;
 
+	/** frame in which interval based auxiliary nodes were ticked by UBehaviorTreeManager::TickBatchedServices */
+	uint64 BatchedServicesFrame;
+
+	/** @return true if interval based auxiliary nodes can be ticked by UBehaviorTreeManager::TickBatchedServices */
+	bool CanTickServicesInBatch() const;
+
 	/** push behavior tree instance on execution stack
 	 *	@NOTE: should never be called out-side of BT execution, meaning only BT tasks can push another BT instance! */
 	bool PushInstance(UBehaviorTree& TreeAsset);
@@ -304,6 +311,7 @@ protected:
 	friend UBTTask_RunBehavior;
 	friend FBehaviorTreeDebugger;
 	friend FBehaviorTreeInstance;
+	friend UBehaviorTreeManager;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -7,6 +7,7 @@ class UBehaviorTreeComponent;
 class UBTCompositeNode;
 class UBTDecorator;
 class UBehaviorTree;
+class UBTAuxiliaryNode;
 
 USTRUCT()
 struct FBehaviorTreeTemplateInfo
@@ -25,6 +26,17 @@ struct FBehaviorTreeTemplateInfo
 	uint16 InstanceMemorySize;
 };
 
+/** auxiliary node due in batched tick */
+struct FBTBatchedServiceTick
+{
+	UBTAuxiliaryNode* AuxNode;
+	UBehaviorTreeComponent* OwnerComp;
+	uint16 InstanceIdx;
+
+	/** position in gathering order, keeps components ticking in the same order within node's batch */
+	int32 Order;
+};
+
 UCLASS(config=Engine)
 class AIMODULE_API UBehaviorTreeManager : public UObject
 {
@@ -57,6 +69,16 @@ class AIMODULE_API UBehaviorTreeManager : public UObject
 	static UBehaviorTreeManager* GetCurrent(UWorld* World);
 	static UBehaviorTreeManager* GetCurrent(UObject* WorldContextObject);
 
+	/** 
+	 * ticks interval based auxiliary nodes (see UBTAuxiliaryNode::CanTickInBatch) of all active components at once,
+	 * called by first component ticking in frame when ai.BT.BatchedServiceTicks is set
+	 *
+	 * Intervals of every eligible component are advanced in a single pass, and due nodes are ticked grouped
+	 * by template node, so each service runs over all AIs using it back to back.
+	 * Components with pending execution request, paused, dilated or not ticking are left to tick their nodes on their own.
+	 */
+	void TickBatchedServices(float DeltaTime);
+
 protected:
 
 	/** initialized tree templates */
@@ -65,4 +87,10 @@ protected:
 
 	UPROPERTY()
 	TArray<UBehaviorTreeComponent*> ActiveComponents;
+
+	/** auxiliary nodes due in current batched tick */
+	TArray<FBTBatchedServiceTick> DueServiceTicks;
+
+	/** frame of last batched tick */
+	uint64 BatchedServicesFrame;
 };
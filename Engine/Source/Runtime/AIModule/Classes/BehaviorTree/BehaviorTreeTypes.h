@@ -34,6 +34,8 @@ DECLARE_CYCLE_STAT_EXTERN(TEXT("Auxiliary Update Time"),STAT_AI_BehaviorTree_Aux
 DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Num Templates"),STAT_AI_BehaviorTree_NumTemplates,STATGROUP_AIBehaviorTree, );
 DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Num Instances"),STAT_AI_BehaviorTree_NumInstances,STATGROUP_AIBehaviorTree, );
 DECLARE_MEMORY_STAT_EXTERN(TEXT("Instance memory"),STAT_AI_BehaviorTree_InstanceMemory,STATGROUP_AIBehaviorTree, AIMODULE_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Instance memory pages"),STAT_AI_BehaviorTree_InstanceMemoryPages,STATGROUP_AIBehaviorTree, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Batched Service Ticks"),STAT_AI_BehaviorTree_BatchedServiceTicks,STATGROUP_AIBehaviorTree, );
 
 namespace FBlackboard
 {
@@ -228,6 +230,103 @@ struct FBehaviorTreeExecutionStep
 	int32 StepIndex;
 };
 
+/**
+ * Allocation policy of behavior tree instance memory.
+ * Blocks are allocated at their exact size from pages owned by UBehaviorTreeManager, one free list per size,
+ * so the memory of all instances of a tree is packed together and copying it between the instance stack and
+ * the persistent memory reuses the existing block.
+ */
+class AIMODULE_API FBTInstanceMemoryAllocator
+{
+public:
+
+	enum { NeedsElementType = false };
+	enum { RequireRangeCheck = true };
+
+	/** @return number of pooled blocks currently in use, blocks too large for pool are not included */
+	static int32 GetNumUsedBlocks();
+
+	class AIMODULE_API ForAnyElementType
+	{
+	public:
+		ForAnyElementType()
+			: Data(NULL)
+			, BlockSize(0)
+		{}
+
+		FORCEINLINE void MoveToEmpty(ForAnyElementType& Other)
+		{
+			check(this != &Other);
+
+			if (Data)
+			{
+				FreeBlock(Data, BlockSize);
+			}
+
+			Data = Other.Data;
+			BlockSize = Other.BlockSize;
+			Other.Data = NULL;
+			Other.BlockSize = 0;
+		}
+
+		FORCEINLINE ~ForAnyElementType()
+		{
+			if (Data)
+			{
+				FreeBlock(Data, BlockSize);
+			}
+		}
+
+		FORCEINLINE FScriptContainerElement* GetAllocation() const
+		{
+			return Data;
+		}
+
+		void ResizeAllocation(int32 PreviousNumElements, int32 NumElements, SIZE_T NumBytesPerElement);
+
+		int32 CalculateSlack(int32 NumElements, int32 NumAllocatedElements, SIZE_T NumBytesPerElement) const
+		{
+			return NumElements;
+		}
+
+		SIZE_T GetAllocatedSize(int32 NumAllocatedElements, SIZE_T NumBytesPerElement) const
+		{
+			return BlockSize;
+		}
+
+	private:
+		ForAnyElementType(const ForAnyElementType&);
+		ForAnyElementType& operator=(const ForAnyElementType&);
+
+		static void FreeBlock(FScriptContainerElement* Block, int32 Size);
+
+		FScriptContainerElement* Data;
+		int32 BlockSize;
+	};
+
+	template<typename ElementType>
+	class ForElementType : public ForAnyElementType
+	{
+	public:
+		ForElementType()
+		{}
+
+		FORCEINLINE ElementType* GetAllocation() const
+		{
+			return (ElementType*)ForAnyElementType::GetAllocation();
+		}
+	};
+};
+
+template <>
+struct TAllocatorTraits<FBTInstanceMemoryAllocator> : TAllocatorTraitsBase<FBTInstanceMemoryAllocator>
+{
+	enum { SupportsMove    = true };
+	enum { IsZeroConstruct = true };
+};
+
+typedef TArray<uint8, FBTInstanceMemoryAllocator> FBTInstanceMemory;
+
 /** identifier of subtree instance */
 struct FBehaviorTreeInstanceId
 {
@@ -241,7 +340,7 @@ struct FBehaviorTreeInstanceId
 	TArray<uint16> Path;
 
 	/** persistent instance memory */
-	TArray<uint8> InstanceMemory;
+	FBTInstanceMemory InstanceMemory;
 
 	/** index of first node instance (BehaviorTreeComponent.NodeInstances) */
 	int32 FirstNodeInstance;
@@ -270,7 +369,7 @@ struct FBehaviorTreeInstance
 	TArray<FBehaviorTreeParallelTask> ParallelTasks;
 
 	/** memory: instance */
-	TArray<uint8> InstanceMemory;
+	FBTInstanceMemory InstanceMemory;
 
 	/** index of identifier (BehaviorTreeComponent.KnownInstances) */
 	uint8 InstanceIdIndex;
@@ -17,5 +17,8 @@ class AIMODULE_API UBlackboardKeyType_Int : public UBlackboardKeyType
 	virtual FString DescribeValue(const uint8* RawData) const override;
 	virtual EBlackboardCompare::Type Compare(const uint8* MemoryBlockA, const uint8* MemoryBlockB) const override;
 	virtual bool TestArithmeticOperation(const uint8* MemoryBlock, EArithmeticKeyOperation::Type Op, int32 OtherIntValue, float OtherFloatValue) const override;
+
+	/** non virtual version of TestArithmeticOperation, for typed fast paths */
+	static bool TestOperation(const uint8* MemoryBlock, EArithmeticKeyOperation::Type Op, int32 OtherIntValue, float OtherFloatValue);
 	virtual FString DescribeArithmeticParam(int32 IntValue, float FloatValue) const override;
 };
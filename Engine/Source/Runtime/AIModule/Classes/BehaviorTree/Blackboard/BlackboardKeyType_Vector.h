@@ -20,4 +20,7 @@ class AIMODULE_API UBlackboardKeyType_Vector : public UBlackboardKeyType
 	virtual bool Clear(uint8* RawData) const override;
 	virtual EBlackboardCompare::Type Compare(const uint8* MemoryBlockA, const uint8* MemoryBlockB) const override;
 	virtual bool TestBasicOperation(const uint8* MemoryBlock, EBasicKeyOperation::Type Op) const override;
+
+	/** non virtual version of TestBasicOperation, for typed fast paths */
+	static bool TestOperation(const uint8* MemoryBlock, EBasicKeyOperation::Type Op);
 };
@@ -83,6 +83,12 @@ public:
 	/** resume change notifies and process queued list */
 	void ResumeUpdates();
 
+	/** queue change notifies until DispatchQueuedUpdates, used by owners dispatching them every frame; disabling dispatches queued list */
+	void SetQueuedNotifies(bool bEnable);
+
+	/** send queued change notifies to observers in one pass, each changed key notified once (unless notifies are paused) */
+	void DispatchQueuedUpdates();
+
 	/** @return associated behavior tree component */
 	UBrainComponent* GetBrainComponent() const;
 
@@ -98,6 +104,10 @@ public:
 	/** @return true if component can be used with specified blackboard asset */
 	bool IsCompatibleWith(UBlackboardData* TestAsset) const;
 
+	/** @return true if key holds values of given type, without looking up blackboard asset */
+	template<class TDataClass>
+	bool IsKeyOfType(FBlackboard::FKey KeyID) const;
+
 	UFUNCTION(BlueprintCallable, Category="AI|Components|Blackboard")
 	UObject* GetValueAsObject(const FName& KeyName) const;
 
@@ -278,24 +288,42 @@ protected:
 	/** offsets in ValueMemory for each key */
 	TArray<uint16> ValueOffsets;
 
+	/** value type for each key, used by typed accessors */
+	TArray<UClass*> ValueTypes;
+
 	/** observers registered for blackboard keys */
 	TMultiMap<uint8, FOnBlackboardChange> Observers;
 
 	/** observers registered from owner objects */
 	TMultiMap<UObject*, FDelegateHandle> ObserverHandles;
 
-	/** queued key change notification, will be processed on ResumeUpdates call */
+	/** queued key change notification, will be processed on ResumeUpdates or DispatchQueuedUpdates call */
 	mutable TArray<uint8> QueuedUpdates;
 
+	/** keys in QueuedUpdates, one bit per key ID */
+	mutable uint32 QueuedKeysMask[8];
+
+	/** keys with registered observers, one bit per key ID: changes of other keys are not queued */
+	uint32 ObservedKeysMask[8];
+
 	/** set when notifies are paused and shouldn't be passed to observers */
 	uint32 bPausedNotifies : 1;
 
+	/** set when notifies are queued until DispatchQueuedUpdates call */
+	uint32 bQueuedNotifies : 1;
+
+	/** set while queued notifies are being sent */
+	uint32 bDispatchingUpdates : 1;
+
 	/** reset to false every time a new BB asset is assigned to this component */
 	uint32 bSynchronizedKeyPopulated : 1;
 
 	/** notifies behavior tree decorators about change in blackboard */
 	void NotifyObservers(FBlackboard::FKey KeyID) const;
 
+	/** updates ObservedKeysMask after observers of key were removed */
+	void UpdateObservedKey(FBlackboard::FKey KeyID);
+
 	/** initializes parent chain in asset */
 	void InitializeParentChain(UBlackboardData* NewAsset);
 
@@ -313,6 +341,12 @@ FORCEINLINE bool UBlackboardComponent::HasValidAsset() const
 	return BlackboardAsset && BlackboardAsset->IsValid();
 }
 
+template<class TDataClass>
+FORCEINLINE bool UBlackboardComponent::IsKeyOfType(FBlackboard::FKey KeyID) const
+{
+	return ValueTypes.IsValidIndex(KeyID) && ValueTypes[KeyID] == TDataClass::StaticClass();
+}
+
 template<class TDataClass>
 bool UBlackboardComponent::SetValue(const FName& KeyName, typename TDataClass::FDataType Value)
 {
@@ -323,7 +357,7 @@ bool UBlackboardComponent::SetValue(const FName& KeyName, typename TDataClass::F
 template<class TDataClass>
 bool UBlackboardComponent::SetValue(FBlackboard::FKey KeyID, typename TDataClass::FDataType Value)
 {
-	if (GetKeyType(KeyID) != TDataClass::StaticClass())
+	if (!IsKeyOfType<TDataClass>(KeyID))
 	{
 		return false;
 	}
@@ -360,7 +394,7 @@ template<class TDataClass>
 typename TDataClass::FDataType UBlackboardComponent::GetValue(const FName& KeyName) const
 {
 	const FBlackboard::FKey KeyID = GetKeyID(KeyName);
-	return (GetKeyType(KeyID) != TDataClass::StaticClass())
+	return !IsKeyOfType<TDataClass>(KeyID)
 		? TDataClass::InvalidValue
 		: GetValue<TDataClass>(KeyID);
 }
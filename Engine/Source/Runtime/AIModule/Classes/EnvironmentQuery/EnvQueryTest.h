@@ -19,6 +19,37 @@ namespace EnvQueryTestVersion
 	const int32 Latest = DataProviders;
 }
 
+/** Values bound and contexts prepared on game thread for a test scoring items on a worker thread, see UEnvQueryTest::PrepareWorkerRun */
+struct AIMODULE_API FEnvQueryTestWorkerData
+{
+	float MinThresholdValue;
+	float MaxThresholdValue;
+	bool bBoolValue;
+
+	FEnvQueryTestWorkerData() : MinThresholdValue(0.0f), MaxThresholdValue(0.0f), bBoolValue(false) {}
+	virtual ~FEnvQueryTestWorkerData() {}
+};
+
+/** Locations of a block of consecutive items in structure of arrays layout, padded with zeros to a multiple of 4 items for vector math */
+struct AIMODULE_API FEnvQueryItemLocations
+{
+	enum { MaxItems = 64 };
+
+	float X[MaxItems];
+	float Y[MaxItems];
+	float Z[MaxItems];
+
+	/** index of the first item of the block */
+	int32 FirstItem;
+
+	/** number of items in the block */
+	int32 NumItems;
+
+	FEnvQueryItemLocations() : FirstItem(0), NumItems(0) {}
+
+	FORCEINLINE int32 NumPadded() const { return Align(NumItems, 4); }
+};
+
 UCLASS(Abstract)
 class AIMODULE_API UEnvQueryTest : public UObject
 {
@@ -125,6 +156,16 @@ public:
 	/** Function that does the actual work */
 	virtual void RunTest(FEnvQueryInstance& QueryInstance) const { checkNoEntry(); }
 
+	/** check if test can score items on a worker thread, with PrepareWorkerRun and RunTestOnWorker */
+	virtual bool CanRunOnWorkerThread() const { return false; }
+
+	/** game thread part of a test run on a worker thread: binds parameter values and prepares contexts
+	 *  @return data for RunTestOnWorker, NULL if there's nothing to score */
+	virtual TSharedPtr<FEnvQueryTestWorkerData> PrepareWorkerRun(FEnvQueryInstance& QueryInstance) const { return NULL; }
+
+	/** scores items with data gathered by PrepareWorkerRun, can be called from any thread */
+	virtual void RunTestOnWorker(FEnvQueryInstance& QueryInstance, const FEnvQueryTestWorkerData& Data) const {}
+
 	/** check if test supports item type */
 	bool IsSupportedItem(TSubclassOf<UEnvQueryItemType> ItemType) const;
 
@@ -149,6 +190,9 @@ public:
 		return GetItemRotation(QueryInstance, *Iterator);
 	}
 
+	/** helper: get locations of up to FEnvQueryItemLocations::MaxItems items starting at FirstItem, for scoring them with vector math */
+	void GetItemLocations(FEnvQueryInstance& QueryInstance, int32 FirstItem, FEnvQueryItemLocations& OutLocations) const;
+
 	/** helper: get actor from item */
 	AActor* GetItemActor(FEnvQueryInstance& QueryInstance, int32 ItemIndex) const;
 		
@@ -16,6 +16,7 @@ class UEnvQueryContext;
 struct FEnvQueryInstance;
 struct FEnvQueryOptionInstance;
 struct FEnvQueryItemDetails;
+struct FEnvQueryTestWorkerData;
 
 AIMODULE_API DECLARE_LOG_CATEGORY_EXTERN(LogEQS, Warning, All);
 
@@ -617,7 +618,13 @@ public:
 	/** if > 0 then it's how much time query has for performing current step */
 	double TimeLimit;
 
-	FEnvQueryInstance() : World(NULL), CurrentTest(-1), NumValidItems(0), bFoundSingleResult(false), bPassOnSingleResult(false)
+	/** data of the test step running on a worker thread, prepared on the game thread */
+	TSharedPtr<FEnvQueryTestWorkerData> WorkerTestData;
+
+	/** value of CurrentTestStartingItem when the worker step was prepared */
+	int32 WorkerStepStartingItem;
+
+	FEnvQueryInstance() : World(NULL), CurrentTest(-1), NumValidItems(0), bFoundSingleResult(false), bPassOnSingleResult(false), WorkerStepStartingItem(0)
 #if USE_EQS_DEBUGGER
 		, bStoreDebugInfo(bDebuggingInfoEnabled) 
 #endif // USE_EQS_DEBUGGER
@@ -628,6 +635,18 @@ public:
 	/** execute single step of query */
 	void ExecuteOneStep(double TimeLimit);
 
+	/** check if the next step is a test that can be scored on a worker thread */
+	bool CanRunStepOnWorkerThread() const;
+
+	/** game thread part of a worker step: binds the test and gathers its contexts, the worker scores items until TimeLimit runs out */
+	void PrepareWorkerStep(double TimeLimit);
+
+	/** scores the items of a step prepared by PrepareWorkerStep, can run on any thread */
+	void ExecuteWorkerStep();
+
+	/** game thread part of a worker step: finalizes the test and advances the query */
+	void FinishWorkerStep();
+
 	/** update context cache */
 	bool PrepareContext(UClass* Context, FEnvQueryContextData& ContextData);
 
@@ -674,6 +693,15 @@ protected:
 	/** sort all scores, from highest to lowest */
 	void SortScores();
 
+	/** set up the scoring behavior of a test before running it */
+	void PrepareTestStep(UEnvQueryTest* TestObject);
+
+	/** check if the test step that started at ItemsAlreadyProcessed has finished */
+	bool IsTestStepDone(int32 ItemsAlreadyProcessed) const;
+
+	/** advance to the next test or option, or finalize the query */
+	void FinishStep(bool bStepDone);
+
 	/** pick one of items with highest score */
 	void PickBestItem();
 
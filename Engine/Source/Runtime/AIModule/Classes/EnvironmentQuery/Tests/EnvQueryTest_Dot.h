@@ -40,6 +40,9 @@ protected:
 	bool bAbsoluteValue;
 
 	virtual void RunTest(FEnvQueryInstance& QueryInstance) const override;
+	virtual bool CanRunOnWorkerThread() const override { return true; }
+	virtual TSharedPtr<FEnvQueryTestWorkerData> PrepareWorkerRun(FEnvQueryInstance& QueryInstance) const override;
+	virtual void RunTestOnWorker(FEnvQueryInstance& QueryInstance, const FEnvQueryTestWorkerData& Data) const override;
 
 	virtual FString GetDescriptionTitle() const override;
 	virtual FText GetDescriptionDetails() const override;
@@ -75,6 +75,9 @@ public:
 
 	FORCEINLINE bool IsSenseInstantiated(const FAISenseID& SenseID) const { return SenseID.IsValid() && Senses.IsValidIndex(SenseID) && Senses[SenseID] != nullptr; }
 
+	/** lets every sense finish the work it has in flight before the world is torn down */
+	void CleanUp();
+
 	/** Registers listener if not registered */
 	void UpdateListener(UAIPerceptionComponent& Listener);
 	void UnregisterListener(UAIPerceptionComponent& Listener);
@@ -4,6 +4,7 @@
 
 #include "Perception/AIPerceptionSystem.h"
 #include "Perception/AISense.h"
+#include "CollisionQueryBatch.h"
 #include "AISense_Sight.generated.h"
 
 class IAISightTargetInterface;
@@ -75,8 +76,14 @@ struct FAISightQuery
 
 	uint32 bLastResult : 1;
 
+	/** set if the query's trace was submitted from its target to its listener, see PendingTraceIndex */
+	uint32 bPendingTraceReversed : 1;
+
+	/** index of the query's line of sight trace in the batch submitted by the last update, INDEX_NONE if none */
+	int32 PendingTraceIndex;
+
 	FAISightQuery(FPerceptionListenerID ListenerId = FPerceptionListenerID::InvalidID(), FAISightTarget::FTargetId Target = FAISightTarget::InvalidTargetId)
-		: ObserverId(ListenerId), TargetId(Target), Age(0), Score(0), Importance(0), bLastResult(false)
+		: ObserverId(ListenerId), TargetId(Target), Age(0), Score(0), Importance(0), bLastResult(false), bPendingTraceReversed(false), PendingTraceIndex(INDEX_NONE)
 	{
 	}
 
@@ -137,9 +144,18 @@ protected:
 	UPROPERTY(config)
 	float SightLimitQueryImportance;
 
+	/** max number of line of sight traces submitted by an update when ai.Sight.BatchedTraces is set */
+	UPROPERTY(config)
+	int32 MaxBatchedTracesPerTick;
+
+	/** line of sight traces submitted by the last update in batched mode, their results are read by the next one */
+	FCollisionQueryBatch SightTraceBatch;
+
 public:
 
 	virtual void PostInitProperties() override;
+	virtual void BeginDestroy() override;
+	virtual void CleanUp() override;
 	
 	void RegisterEvent(const FAISightEvent& Event);	
 
@@ -169,6 +185,15 @@ protected:
 
 	float CalcQueryImportance(const FPerceptionListener& Listener, const FVector& TargetLocation, const float SightRadiusSq) const;
 
+	/** registers stimuli of queries waiting for traces of SightTraceBatch, once they are done */
+	void ApplyPendingTraces(const UWorld& World);
+
+	/** waits for the traces in flight and drops their results, the queries get traced again by the next update */
+	void CancelPendingTraces();
+
+	/** culls whole query queue by sight range and angle, and submits line of sight traces of passing queries as a single async batch */
+	void ProcessQueriesBatched(const UWorld& World, TArray<int32>& InvalidQueries, TArray<FAISightTarget::FTargetId>& InvalidTargets);
+
 public:
 #if !UE_BUILD_SHIPPING
 	//----------------------------------------------------------------------//
@@ -64,7 +64,10 @@ void UAISystem::WorldOriginLocationChanged(FIntVector OldOriginLocation, FIntVec
 
 void UAISystem::CleanupWorld(bool bSessionEnded, bool bCleanupResources, UWorld* NewWorld)
 {
-
+	if (PerceptionSystem)
+	{
+		PerceptionSystem->CleanUp();
+	}
 }
 
 void UAISystem::AIIgnorePlayers()
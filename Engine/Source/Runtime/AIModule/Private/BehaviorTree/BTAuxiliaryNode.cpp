@@ -67,6 +67,29 @@ void UBTAuxiliaryNode::WrappedTickNode(UBehaviorTreeComponent& OwnerComp, uint8*
 	}
 }
 
+bool UBTAuxiliaryNode::CanTickInBatch() const
+{
+	return bNotifyTick && bTickIntervals && !HasInstance();
+}
+
+bool UBTAuxiliaryNode::AdvanceTickInterval(uint8* NodeMemory, float DeltaSeconds) const
+{
+	FBTAuxiliaryMemory* AuxMemory = GetSpecialNodeMemory<FBTAuxiliaryMemory>(NodeMemory);
+	AuxMemory->NextTickRemainingTime -= DeltaSeconds;
+	AuxMemory->AccumulatedDeltaTime += DeltaSeconds;
+
+	return AuxMemory->NextTickRemainingTime <= 0.0f;
+}
+
+void UBTAuxiliaryNode::TickBatchedNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) const
+{
+	FBTAuxiliaryMemory* AuxMemory = GetSpecialNodeMemory<FBTAuxiliaryMemory>(NodeMemory);
+	const float UseDeltaTime = AuxMemory->AccumulatedDeltaTime;
+	AuxMemory->AccumulatedDeltaTime = 0.0f;
+
+	const_cast<UBTAuxiliaryNode*>(this)->TickNode(OwnerComp, NodeMemory, UseDeltaTime);
+}
+
 void UBTAuxiliaryNode::SetNextTickTime(uint8* NodeMemory, float RemainingTime) const
 {
 	if (bTickIntervals)
@@ -9,6 +9,20 @@
 #include "BehaviorTree/BlackboardComponent.h"
 #include "BehaviorTree/BehaviorTreeComponent.h"
 
+static TAutoConsoleVariable<int32> CVarBTBatchedServiceTicks(
+	TEXT("ai.BT.BatchedServiceTicks"),
+	0,
+	TEXT("Whether interval based services and decorators of all behavior tree components are ticked in one batch per frame, grouped by node.\n")
+	TEXT("0: each component ticks its own nodes (default), 1: batch ticks in behavior tree manager"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarBTQueuedBlackboardNotifies(
+	TEXT("ai.BT.QueuedBlackboardNotifies"),
+	0,
+	TEXT("Whether blackboard changes are queued and sent to observers in one pass at the start of the behavior tree component's tick and again after its nodes tick, each changed key once.\n")
+	TEXT("0: notify observers on every change (default), 1: queue notifies until next dispatch"),
+	ECVF_Default);
+
 //----------------------------------------------------------------------//
 // UBehaviorTreeComponent
 //----------------------------------------------------------------------//
@@ -25,6 +39,7 @@ UBehaviorTreeComponent::UBehaviorTreeComponent(const FObjectInitializer& ObjectI
 	bWantsInitializeComponent = true; 
 	bIsRunning = false;
 	bIsPaused = false;
+	BatchedServicesFrame = MAX_uint64;
 }
 
 void UBehaviorTreeComponent::BeginDestroy()
@@ -168,6 +183,12 @@ void UBehaviorTreeComponent::StopTree()
 	PendingExecution = FBTPendingExecutionInfo();
 	ActiveInstanceIdx = 0;
 
+	// nothing will dispatch queued blackboard notifies until tree is running again
+	if (BlackboardComp)
+	{
+		BlackboardComp->SetQueuedNotifies(false);
+	}
+
 	// make sure to allow new execution requests
 	bRequestedFlowUpdate = false;
 }
@@ -811,6 +832,23 @@ void UBehaviorTreeComponent::TickComponent(float DeltaTime, enum ELevelTick Tick
 	SCOPE_CYCLE_COUNTER(STAT_AI_BehaviorTree_Tick);
 
 	check(this != nullptr && this->IsPendingKill() == false);
+
+	// first component ticking in frame ticks interval based nodes of all components
+	if (CVarBTBatchedServiceTicks.GetValueOnGameThread() != 0 && BatchedServicesFrame != GFrameCounter && !GetWorld()->IsPaused())
+	{
+		UBehaviorTreeManager* BTManager = UBehaviorTreeManager::GetCurrent(GetWorld());
+		if (BTManager)
+		{
+			BTManager->TickBatchedServices(DeltaTime);
+		}
+	}
+
+	// blackboard changes since last tick are sent in one pass, execution requests of observers are processed right below
+	if (BlackboardComp)
+	{
+		BlackboardComp->SetQueuedNotifies(CVarBTQueuedBlackboardNotifies.GetValueOnGameThread() != 0 && bIsRunning);
+		BlackboardComp->DispatchQueuedUpdates();
+	}
 		
 	if (bRequestedFlowUpdate)
 	{
@@ -822,6 +860,8 @@ void UBehaviorTreeComponent::TickComponent(float DeltaTime, enum ELevelTick Tick
 		return;
 	}
 
+	const bool bServicesTickedInBatch = (BatchedServicesFrame == GFrameCounter);
+
 	// tick active auxiliary nodes and parallel tasks (in execution order, before task)
 	for (int32 InstanceIndex = 0; InstanceIndex < InstanceStack.Num(); InstanceIndex++)
 	{
@@ -829,6 +869,11 @@ void UBehaviorTreeComponent::TickComponent(float DeltaTime, enum ELevelTick Tick
 		for (int32 AuxIndex = 0; AuxIndex < InstanceInfo.ActiveAuxNodes.Num(); AuxIndex++)
 		{
 			const UBTAuxiliaryNode* AuxNode = InstanceInfo.ActiveAuxNodes[AuxIndex];
+			if (bServicesTickedInBatch && AuxNode->CanTickInBatch())
+			{
+				continue;
+			}
+
 			uint8* NodeMemory = AuxNode->GetNodeMemory<uint8>(InstanceInfo);
 			AuxNode->WrappedTickNode(*this, NodeMemory, DeltaTime);
 		}
@@ -850,6 +895,20 @@ void UBehaviorTreeComponent::TickComponent(float DeltaTime, enum ELevelTick Tick
 		uint8* NodeMemory = ActiveTask->GetNodeMemory<uint8>(ActiveInstance);
 		ActiveTask->WrappedTickTask(*this, NodeMemory, DeltaTime);
 	}
+
+	// changes made by nodes ticked above reach observers in the same frame, as they would without queued notifies
+	if (BlackboardComp)
+	{
+		BlackboardComp->DispatchQueuedUpdates();
+	}
+}
+
+bool UBehaviorTreeComponent::CanTickServicesInBatch() const
+{
+	const AActor* MyOwner = GetOwner();
+	return bIsRunning && !bIsPaused && !bRequestedFlowUpdate && InstanceStack.Num() > 0 &&
+		IsRegistered() && !IsPendingKill() && IsComponentTickEnabled() &&
+		(MyOwner == NULL || MyOwner->CustomTimeDilation == 1.0f);
 }
 
 void UBehaviorTreeComponent::ProcessExecutionRequest()
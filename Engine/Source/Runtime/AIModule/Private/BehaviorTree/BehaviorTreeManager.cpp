@@ -16,10 +16,148 @@ DEFINE_STAT(STAT_AI_BehaviorTree_AuxUpdateTime);
 DEFINE_STAT(STAT_AI_BehaviorTree_NumTemplates);
 DEFINE_STAT(STAT_AI_BehaviorTree_NumInstances);
 DEFINE_STAT(STAT_AI_BehaviorTree_InstanceMemory);
+DEFINE_STAT(STAT_AI_BehaviorTree_InstanceMemoryPages);
+DEFINE_STAT(STAT_AI_BehaviorTree_BatchedServiceTicks);
+
+//----------------------------------------------------------------------//
+// Instance memory pool
+//----------------------------------------------------------------------//
+
+/**
+ * Pages of instance memory blocks, each page split into blocks of a single size.
+ * Shared by all managers, since instance memory can outlive the world it was created in.
+ * Pages are kept for the lifetime of the process and reused by next trees.
+ */
+struct FBTInstanceMemoryPool
+{
+	enum
+	{
+		BlockAlignment = 16,
+		MaxPooledBlockSize = 4096,
+		PageSize = 64 * 1024,
+		NumBlockSizes = MaxPooledBlockSize / BlockAlignment,
+	};
+
+	struct FFreeBlock
+	{
+		FFreeBlock* Next;
+	};
+
+	/** free blocks of each size */
+	FFreeBlock* FreeBlocks[NumBlockSizes];
+
+	/** number of pooled blocks currently in use */
+	int32 NumUsedBlocks;
+
+	FCriticalSection Lock;
+
+	FBTInstanceMemoryPool()
+		: NumUsedBlocks(0)
+	{
+		FMemory::Memzero(FreeBlocks, sizeof(FreeBlocks));
+	}
+
+	/** @return size of block holding Size bytes, blocks larger than MaxPooledBlockSize come from general heap */
+	static int32 GetBlockSize(int32 Size)
+	{
+		return (Size > MaxPooledBlockSize) ? Size : Align(Size, BlockAlignment);
+	}
+
+	void* Allocate(int32 BlockSize)
+	{
+		if (BlockSize > MaxPooledBlockSize)
+		{
+			return FMemory::Malloc(BlockSize, BlockAlignment);
+		}
+
+		FScopeLock ScopeLock(&Lock);
+		FFreeBlock*& FreeList = FreeBlocks[BlockSize / BlockAlignment - 1];
+		if (FreeList == NULL)
+		{
+			// link blocks of new page in address order, so instances created one after another are next to each other
+			uint8* Page = (uint8*)FMemory::Malloc(PageSize, BlockAlignment);
+			INC_MEMORY_STAT_BY(STAT_AI_BehaviorTree_InstanceMemoryPages, PageSize);
+
+			for (int32 BlockIdx = (PageSize / BlockSize) - 1; BlockIdx >= 0; BlockIdx--)
+			{
+				FFreeBlock* Block = (FFreeBlock*)(Page + BlockIdx * BlockSize);
+				Block->Next = FreeList;
+				FreeList = Block;
+			}
+		}
+
+		FFreeBlock* Block = FreeList;
+		FreeList = Block->Next;
+		NumUsedBlocks++;
+		return Block;
+	}
+
+	void Free(void* Block, int32 BlockSize)
+	{
+		if (BlockSize > MaxPooledBlockSize)
+		{
+			FMemory::Free(Block);
+			return;
+		}
+
+		FScopeLock ScopeLock(&Lock);
+		FFreeBlock*& FreeList = FreeBlocks[BlockSize / BlockAlignment - 1];
+		((FFreeBlock*)Block)->Next = FreeList;
+		FreeList = (FFreeBlock*)Block;
+		NumUsedBlocks--;
+	}
+
+	static FBTInstanceMemoryPool& Get()
+	{
+		// never destroyed: instance memory can still be freed during static destruction
+		static FBTInstanceMemoryPool* Pool = new FBTInstanceMemoryPool();
+		return *Pool;
+	}
+};
+
+void FBTInstanceMemoryAllocator::ForAnyElementType::ResizeAllocation(int32 PreviousNumElements, int32 NumElements, SIZE_T NumBytesPerElement)
+{
+	const int32 NewBlockSize = NumElements ? FBTInstanceMemoryPool::GetBlockSize((int32)(NumElements * NumBytesPerElement)) : 0;
+	if (NewBlockSize == BlockSize)
+	{
+		// same sized copies (e.g. between instance stack and persistent memory) keep their block
+		return;
+	}
+
+	FScriptContainerElement* NewData = NewBlockSize ? (FScriptContainerElement*)FBTInstanceMemoryPool::Get().Allocate(NewBlockSize) : NULL;
+	if (Data)
+	{
+		const int32 NumBytesToKeep = FMath::Min((int32)(PreviousNumElements * NumBytesPerElement), NewBlockSize);
+		if (NumBytesToKeep > 0)
+		{
+			FMemory::Memcpy(NewData, Data, NumBytesToKeep);
+		}
+
+		FreeBlock(Data, BlockSize);
+	}
+
+	Data = NewData;
+	BlockSize = NewBlockSize;
+}
+
+void FBTInstanceMemoryAllocator::ForAnyElementType::FreeBlock(FScriptContainerElement* Block, int32 Size)
+{
+	FBTInstanceMemoryPool::Get().Free(Block, Size);
+}
+
+int32 FBTInstanceMemoryAllocator::GetNumUsedBlocks()
+{
+	return FBTInstanceMemoryPool::Get().NumUsedBlocks;
+}
+
+//----------------------------------------------------------------------//
+// UBehaviorTreeManager
+//----------------------------------------------------------------------//
 
 UBehaviorTreeManager::UBehaviorTreeManager(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 	MaxDebuggerSteps = 100;
+	BatchedServicesFrame = MAX_uint64;
 }
 
 void UBehaviorTreeManager::FinishDestroy()
@@ -373,6 +511,76 @@ void UBehaviorTreeManager::RemoveActiveComponent(UBehaviorTreeComponent& Compone
 	ActiveComponents.Remove(&Component);
 }
 
+struct FBTBatchedServiceTickSort
+{
+	FORCEINLINE bool operator()(const FBTBatchedServiceTick& A, const FBTBatchedServiceTick& B) const
+	{
+		return (A.AuxNode == B.AuxNode) ? (A.Order < B.Order) : (A.AuxNode < B.AuxNode);
+	}
+};
+
+void UBehaviorTreeManager::TickBatchedServices(float DeltaTime)
+{
+	if (BatchedServicesFrame == GFrameCounter)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_AI_BehaviorTree_BatchedServiceTicks);
+	BatchedServicesFrame = GFrameCounter;
+
+	// advance intervals of all eligible components and gather due nodes
+	DueServiceTicks.Reset();
+	for (int32 Idx = 0; Idx < ActiveComponents.Num(); Idx++)
+	{
+		UBehaviorTreeComponent* OwnerComp = ActiveComponents[Idx];
+		if (OwnerComp == NULL || !OwnerComp->CanTickServicesInBatch())
+		{
+			continue;
+		}
+
+		OwnerComp->BatchedServicesFrame = GFrameCounter;
+		for (int32 InstanceIndex = 0; InstanceIndex < OwnerComp->InstanceStack.Num(); InstanceIndex++)
+		{
+			FBehaviorTreeInstance& InstanceInfo = OwnerComp->InstanceStack[InstanceIndex];
+			for (int32 AuxIndex = 0; AuxIndex < InstanceInfo.ActiveAuxNodes.Num(); AuxIndex++)
+			{
+				UBTAuxiliaryNode* AuxNode = InstanceInfo.ActiveAuxNodes[AuxIndex];
+				if (AuxNode->CanTickInBatch() && AuxNode->AdvanceTickInterval(AuxNode->GetNodeMemory<uint8>(InstanceInfo), DeltaTime))
+				{
+					FBTBatchedServiceTick& DueTick = DueServiceTicks[DueServiceTicks.AddUninitialized()];
+					DueTick.AuxNode = AuxNode;
+					DueTick.OwnerComp = OwnerComp;
+					DueTick.InstanceIdx = InstanceIndex;
+					DueTick.Order = DueServiceTicks.Num() - 1;
+				}
+			}
+		}
+	}
+
+	// tick due nodes grouped by template node
+	DueServiceTicks.Sort(FBTBatchedServiceTickSort());
+	for (int32 Idx = 0; Idx < DueServiceTicks.Num(); Idx++)
+	{
+		const FBTBatchedServiceTick& DueTick = DueServiceTicks[Idx];
+		UBehaviorTreeComponent* OwnerComp = DueTick.OwnerComp;
+
+		// earlier ticks could have stopped tree or destroyed its owner
+		if (OwnerComp->IsPendingKill() || !OwnerComp->InstanceStack.IsValidIndex(DueTick.InstanceIdx))
+		{
+			continue;
+		}
+
+		FBehaviorTreeInstance& InstanceInfo = OwnerComp->InstanceStack[DueTick.InstanceIdx];
+		if (InstanceInfo.ActiveAuxNodes.Contains(DueTick.AuxNode))
+		{
+			DueTick.AuxNode->TickBatchedNode(*OwnerComp, DueTick.AuxNode->GetNodeMemory<uint8>(InstanceInfo));
+		}
+	}
+
+	DueServiceTicks.Reset();
+}
+
 UBehaviorTreeManager* UBehaviorTreeManager::GetCurrent(UWorld* World)
 {
 	UAISystem* AISys = UAISystem::GetCurrentSafe(World);
@@ -32,6 +32,11 @@ EBlackboardCompare::Type UBlackboardKeyType_Bool::Compare(const uint8* MemoryBlo
 }
 
 bool UBlackboardKeyType_Bool::TestBasicOperation(const uint8* MemoryBlock, EBasicKeyOperation::Type Op) const
+{
+	return TestOperation(MemoryBlock, Op);
+}
+
+bool UBlackboardKeyType_Bool::TestOperation(const uint8* MemoryBlock, EBasicKeyOperation::Type Op)
 {
 	const bool Value = GetValue(MemoryBlock);
 	return (Op == EBasicKeyOperation::Set) ? Value : !Value;
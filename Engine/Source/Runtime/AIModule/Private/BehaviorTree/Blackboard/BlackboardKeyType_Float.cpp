@@ -34,6 +34,11 @@ EBlackboardCompare::Type UBlackboardKeyType_Float::Compare(const uint8* MemoryBl
 }
 
 bool UBlackboardKeyType_Float::TestArithmeticOperation(const uint8* MemoryBlock, EArithmeticKeyOperation::Type Op, int32 OtherIntValue, float OtherFloatValue) const
+{
+	return TestOperation(MemoryBlock, Op, OtherIntValue, OtherFloatValue);
+}
+
+bool UBlackboardKeyType_Float::TestOperation(const uint8* MemoryBlock, EArithmeticKeyOperation::Type Op, int32 OtherIntValue, float OtherFloatValue)
 {
 	const float Value = GetValue(MemoryBlock);
 	switch (Op)
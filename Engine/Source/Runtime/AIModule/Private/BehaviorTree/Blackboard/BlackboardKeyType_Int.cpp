@@ -33,6 +33,11 @@ EBlackboardCompare::Type UBlackboardKeyType_Int::Compare(const uint8* MemoryBloc
 }
 
 bool UBlackboardKeyType_Int::TestArithmeticOperation(const uint8* MemoryBlock, EArithmeticKeyOperation::Type Op, int32 OtherIntValue, float OtherFloatValue) const
+{
+	return TestOperation(MemoryBlock, Op, OtherIntValue, OtherFloatValue);
+}
+
+bool UBlackboardKeyType_Int::TestOperation(const uint8* MemoryBlock, EArithmeticKeyOperation::Type Op, int32 OtherIntValue, float OtherFloatValue)
 {
 	const int32 Value = GetValue(MemoryBlock);
 	switch (Op)
@@ -70,6 +70,11 @@ EBlackboardCompare::Type UBlackboardKeyType_Object::Compare(const uint8* MemoryB
 }
 
 bool UBlackboardKeyType_Object::TestBasicOperation(const uint8* MemoryBlock, EBasicKeyOperation::Type Op) const
+{
+	return TestOperation(MemoryBlock, Op);
+}
+
+bool UBlackboardKeyType_Object::TestOperation(const uint8* MemoryBlock, EBasicKeyOperation::Type Op)
 {
 	FWeakObjectPtr WeakObjPtr = GetValueFromMemory<FWeakObjectPtr>(MemoryBlock);
 	return (Op == EBasicKeyOperation::Set) ? WeakObjPtr.IsValid() : !WeakObjPtr.IsValid();
@@ -50,6 +50,11 @@ EBlackboardCompare::Type UBlackboardKeyType_Vector::Compare(const uint8* MemoryB
 }
 
 bool UBlackboardKeyType_Vector::TestBasicOperation(const uint8* MemoryBlock, EBasicKeyOperation::Type Op) const
+{
+	return TestOperation(MemoryBlock, Op);
+}
+
+bool UBlackboardKeyType_Vector::TestOperation(const uint8* MemoryBlock, EBasicKeyOperation::Type Op)
 {
 	const FVector Location = GetValue(MemoryBlock);
 	return (Op == EBasicKeyOperation::Set) ? FAISystem::IsValidLocation(Location) : !FAISystem::IsValidLocation(Location);
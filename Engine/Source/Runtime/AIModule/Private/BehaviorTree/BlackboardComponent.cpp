@@ -5,12 +5,33 @@
 #include "BehaviorTree/Blackboard/BlackboardKeyAllTypes.h"
 #include "BehaviorTree/BlackboardComponent.h"
 
+static FORCEINLINE bool IsKeyInMask(const uint32* KeyMask, FBlackboard::FKey KeyID)
+{
+	return (KeyMask[KeyID >> 5] & (1u << (KeyID & 31))) != 0;
+}
+
+static FORCEINLINE void SetKeyInMask(uint32* KeyMask, FBlackboard::FKey KeyID, bool bValue)
+{
+	if (bValue)
+	{
+		KeyMask[KeyID >> 5] |= (1u << (KeyID & 31));
+	}
+	else
+	{
+		KeyMask[KeyID >> 5] &= ~(1u << (KeyID & 31));
+	}
+}
+
 UBlackboardComponent::UBlackboardComponent(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 	PrimaryComponentTick.bCanEverTick = false;
 	bWantsInitializeComponent = true;
 	bPausedNotifies = false;
+	bQueuedNotifies = false;
+	bDispatchingUpdates = false;
 	bSynchronizedKeyPopulated = false;
+	FMemory::Memzero(QueuedKeysMask, sizeof(QueuedKeysMask));
+	FMemory::Memzero(ObservedKeysMask, sizeof(ObservedKeysMask));
 }
 
 void UBlackboardComponent::InitializeComponent()
@@ -108,6 +129,7 @@ bool UBlackboardComponent::InitializeBlackboard(UBlackboardData& NewAsset)
 	BlackboardAsset = &NewAsset;
 	ValueMemory.Reset();
 	ValueOffsets.Reset();
+	ValueTypes.Reset();
 	bSynchronizedKeyPopulated = false;
 
 	bool bSuccess = true;
@@ -120,6 +142,7 @@ bool UBlackboardComponent::InitializeBlackboard(UBlackboardData& NewAsset)
 		const int32 NumKeys = BlackboardAsset->GetNumKeys();
 		InitList.Reserve(NumKeys);
 		ValueOffsets.AddZeroed(NumKeys);
+		ValueTypes.AddZeroed(NumKeys);
 
 		for (UBlackboardData* It = BlackboardAsset; It; It = It->Parent)
 		{
@@ -128,6 +151,7 @@ bool UBlackboardComponent::InitializeBlackboard(UBlackboardData& NewAsset)
 				if (It->Keys[KeyIndex].KeyType)
 				{
 					InitList.Add(FBlackboardInitializationData(KeyIndex + It->GetFirstKeyID(), It->Keys[KeyIndex].KeyType->GetValueSize()));
+					ValueTypes[KeyIndex + It->GetFirstKeyID()] = It->Keys[KeyIndex].KeyType->GetClass();
 				}
 			}
 		}
@@ -257,6 +281,7 @@ FDelegateHandle UBlackboardComponent::RegisterObserver(FBlackboard::FKey KeyID,
 
 	FDelegateHandle Handle = Observers.Add(KeyID, ObserverDelegate).GetHandle();
 	ObserverHandles.Add(NotifyOwner, Handle);
+	SetKeyInMask(ObservedKeysMask, KeyID, true);
 
 	return Handle;
 }
@@ -277,6 +302,7 @@ void UBlackboardComponent::UnregisterObserver(FBlackboard::FKey KeyID, FOnBlackb
 			}
 
 			It.RemoveCurrent();
+			UpdateObservedKey(KeyID);
 			break;
 		}
 	}
@@ -298,6 +324,7 @@ void UBlackboardComponent::UnregisterObserver(FBlackboard::FKey KeyID, FDelegate
 			}
 
 			It.RemoveCurrent();
+			UpdateObservedKey(KeyID);
 			break;
 		}
 	}
@@ -311,7 +338,9 @@ void UBlackboardComponent::UnregisterObserversFrom(UObject* NotifyOwner)
 		{
 			if (ObsIt.Value().GetHandle() == It.Value())
 			{
+				const FBlackboard::FKey KeyID = ObsIt.Key();
 				ObsIt.RemoveCurrent();
+				UpdateObservedKey(KeyID);
 				break;
 			}
 		}
@@ -330,19 +359,67 @@ void UBlackboardComponent::ResumeUpdates()
 {
 	bPausedNotifies = false;
 
-	for (int32 UpdateIndex = 0; UpdateIndex < QueuedUpdates.Num(); UpdateIndex++)
+	if (!bQueuedNotifies)
+	{
+		DispatchQueuedUpdates();
+	}
+}
+
+void UBlackboardComponent::SetQueuedNotifies(bool bEnable)
+{
+	bQueuedNotifies = bEnable;
+
+	if (!bEnable)
+	{
+		DispatchQueuedUpdates();
+	}
+}
+
+void UBlackboardComponent::DispatchQueuedUpdates()
+{
+	// nested call from observer: outer loop will reach remaining entries
+	if (bPausedNotifies || bDispatchingUpdates || QueuedUpdates.Num() == 0)
 	{
-		NotifyObservers(QueuedUpdates[UpdateIndex]);
+		return;
 	}
 
-	QueuedUpdates.Empty();
+	// changes made by observers are sent right away, unless they pause notifies
+	bDispatchingUpdates = true;
+
+	int32 UpdateIndex = 0;
+	for (; UpdateIndex < QueuedUpdates.Num() && !bPausedNotifies; UpdateIndex++)
+	{
+		const FBlackboard::FKey KeyID = QueuedUpdates[UpdateIndex];
+		SetKeyInMask(QueuedKeysMask, KeyID, false);
+		NotifyObservers(KeyID);
+	}
+
+	QueuedUpdates.RemoveAt(0, UpdateIndex, false);
+	bDispatchingUpdates = false;
+}
+
+void UBlackboardComponent::UpdateObservedKey(FBlackboard::FKey KeyID)
+{
+	if (Observers.Find(KeyID) == NULL)
+	{
+		SetKeyInMask(ObservedKeysMask, KeyID, false);
+	}
 }
 
 void UBlackboardComponent::NotifyObservers(FBlackboard::FKey KeyID) const
 {
-	if (bPausedNotifies)
+	if (!IsKeyInMask(ObservedKeysMask, KeyID))
 	{
-		QueuedUpdates.AddUnique(KeyID);
+		return;
+	}
+
+	if (bPausedNotifies || (bQueuedNotifies && !bDispatchingUpdates))
+	{
+		if (!IsKeyInMask(QueuedKeysMask, KeyID))
+		{
+			SetKeyInMask(QueuedKeysMask, KeyID, true);
+			QueuedUpdates.Add(KeyID);
+		}
 	}
 	else
 	{
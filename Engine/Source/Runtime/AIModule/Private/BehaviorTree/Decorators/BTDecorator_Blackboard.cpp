@@ -22,7 +22,30 @@ bool UBTDecorator_Blackboard::CalculateRawConditionValue(UBehaviorTreeComponent&
 bool UBTDecorator_Blackboard::EvaluateOnBlackboard(const UBlackboardComponent& BlackboardComp) const
 {
 	bool bResult = false;
-	if (BlackboardKey.SelectedKeyType)
+	const UClass* KeyType = BlackboardKey.SelectedKeyType;
+
+	// typed fast path for common key types, skips virtual calls on key's CDO
+	if (KeyType == UBlackboardKeyType_Bool::StaticClass())
+	{
+		bResult = UBlackboardKeyType_Bool::TestOperation(BlackboardComp.GetKeyRawData(BlackboardKey.GetSelectedKeyID()), (EBasicKeyOperation::Type)OperationType);
+	}
+	else if (KeyType == UBlackboardKeyType_Object::StaticClass())
+	{
+		bResult = UBlackboardKeyType_Object::TestOperation(BlackboardComp.GetKeyRawData(BlackboardKey.GetSelectedKeyID()), (EBasicKeyOperation::Type)OperationType);
+	}
+	else if (KeyType == UBlackboardKeyType_Vector::StaticClass())
+	{
+		bResult = UBlackboardKeyType_Vector::TestOperation(BlackboardComp.GetKeyRawData(BlackboardKey.GetSelectedKeyID()), (EBasicKeyOperation::Type)OperationType);
+	}
+	else if (KeyType == UBlackboardKeyType_Int::StaticClass())
+	{
+		bResult = UBlackboardKeyType_Int::TestOperation(BlackboardComp.GetKeyRawData(BlackboardKey.GetSelectedKeyID()), (EArithmeticKeyOperation::Type)OperationType, IntValue, FloatValue);
+	}
+	else if (KeyType == UBlackboardKeyType_Float::StaticClass())
+	{
+		bResult = UBlackboardKeyType_Float::TestOperation(BlackboardComp.GetKeyRawData(BlackboardKey.GetSelectedKeyID()), (EArithmeticKeyOperation::Type)OperationType, IntValue, FloatValue);
+	}
+	else if (KeyType)
 	{
 		UBlackboardKeyType* KeyCDO = BlackboardKey.SelectedKeyType->GetDefaultObject<UBlackboardKeyType>();
 		const uint8* KeyMemory = BlackboardComp.GetKeyRawData(BlackboardKey.GetSelectedKeyID());
@@ -190,7 +190,6 @@ void FEnvQueryInstance::ExecuteOneStep(double InTimeLimit)
 	CONDITIONAL_SCOPE_CYCLE_COUNTER(STAT_AI_EQS_GeneratorTime, CurrentTest < 0);
 	CONDITIONAL_SCOPE_CYCLE_COUNTER(STAT_AI_EQS_TestTime, CurrentTest >= 0);
 
-	const bool bDoingLastTest = (CurrentTest >= OptionItem.Tests.Num() - 1);
 	bool bStepDone = true;
 	TimeLimit = InTimeLimit;
 
@@ -214,35 +213,11 @@ void FEnvQueryInstance::ExecuteOneStep(double InTimeLimit)
 //		SCOPE_LOG_TIME(*UEnvQueryTypes::GetShortTypeName(Options[OptionIndex].Tests[CurrentTest]).ToString(), nullptr);
 
 		UEnvQueryTest* TestObject = OptionItem.Tests[CurrentTest];
-
-		// item generator uses this flag to alter the scoring behavior
-		bPassOnSingleResult = (bDoingLastTest && Mode == EEnvQueryRunMode::SingleResult && TestObject->CanRunAsFinalCondition());
-
-		if (bPassOnSingleResult)
-		{
-			// Since we know we're the last test that is a final condition, if we were scoring previously we should sort the tests now before we test them
-			bool bSortTests = false;
-			for (int32 TestIndex = 0; TestIndex < OptionItem.Tests.Num() - 1; ++TestIndex)
-			{
-				if (OptionItem.Tests[TestIndex]->TestPurpose != EEnvTestPurpose::Filter)
-				{
-					// Found one.  We should sort.
-					bSortTests = true;
-					break;
-				}
-			}
-
-			if (bSortTests)
-			{
-				SortScores();
-			}
-		}
+		PrepareTestStep(TestObject);
 
 		const int32 ItemsAlreadyProcessed = CurrentTestStartingItem;
 		TestObject->RunTest(*this);
-		bStepDone = CurrentTestStartingItem >= Items.Num() || bFoundSingleResult
-			// or no items processed ==> this means error
-			|| (ItemsAlreadyProcessed == CurrentTestStartingItem);
+		bStepDone = IsTestStepDone(ItemsAlreadyProcessed);
 
 		if (bStepDone)
 		{
@@ -255,6 +230,97 @@ void FEnvQueryInstance::ExecuteOneStep(double InTimeLimit)
 			*QueryName, OptionIndex, CurrentTest);
 	}
 	
+	FinishStep(bStepDone);
+}
+
+bool FEnvQueryInstance::CanRunStepOnWorkerThread() const
+{
+	if (!Owner.IsValid() || IsFinished() || !Options.IsValidIndex(OptionIndex))
+	{
+		return false;
+	}
+
+	const FEnvQueryOptionInstance& OptionItem = Options[OptionIndex];
+	return OptionItem.Tests.IsValidIndex(CurrentTest) && OptionItem.Tests[CurrentTest]->CanRunOnWorkerThread();
+}
+
+void FEnvQueryInstance::PrepareWorkerStep(double InTimeLimit)
+{
+	check(IsInGameThread());
+
+	UEnvQueryTest* TestObject = Options[OptionIndex].Tests[CurrentTest];
+	PrepareTestStep(TestObject);
+
+	// the manager waits for worker steps within its time budget, items left when it runs out are scored by the next step
+	TimeLimit = InTimeLimit;
+	WorkerStepStartingItem = CurrentTestStartingItem;
+	WorkerTestData = TestObject->PrepareWorkerRun(*this);
+}
+
+void FEnvQueryInstance::ExecuteWorkerStep()
+{
+	SCOPE_CYCLE_COUNTER(STAT_AI_EQS_TestTime);
+
+	if (WorkerTestData.IsValid())
+	{
+		const UEnvQueryTest* TestObject = Options[OptionIndex].Tests[CurrentTest];
+		TestObject->RunTestOnWorker(*this, *WorkerTestData);
+	}
+}
+
+void FEnvQueryInstance::FinishWorkerStep()
+{
+	check(IsInGameThread());
+
+	WorkerTestData.Reset();
+
+	const bool bStepDone = IsTestStepDone(WorkerStepStartingItem);
+	if (bStepDone)
+	{
+		FinalizeTest();
+	}
+
+	FinishStep(bStepDone);
+}
+
+void FEnvQueryInstance::PrepareTestStep(UEnvQueryTest* TestObject)
+{
+	const FEnvQueryOptionInstance& OptionItem = Options[OptionIndex];
+	const bool bDoingLastTest = (CurrentTest >= OptionItem.Tests.Num() - 1);
+
+	// item generator uses this flag to alter the scoring behavior
+	bPassOnSingleResult = (bDoingLastTest && Mode == EEnvQueryRunMode::SingleResult && TestObject->CanRunAsFinalCondition());
+
+	if (bPassOnSingleResult)
+	{
+		// Since we know we're the last test that is a final condition, if we were scoring previously we should sort the tests now before we test them
+		bool bSortTests = false;
+		for (int32 TestIndex = 0; TestIndex < OptionItem.Tests.Num() - 1; ++TestIndex)
+		{
+			if (OptionItem.Tests[TestIndex]->TestPurpose != EEnvTestPurpose::Filter)
+			{
+				// Found one.  We should sort.
+				bSortTests = true;
+				break;
+			}
+		}
+
+		if (bSortTests)
+		{
+			SortScores();
+		}
+	}
+}
+
+bool FEnvQueryInstance::IsTestStepDone(int32 ItemsAlreadyProcessed) const
+{
+	return CurrentTestStartingItem >= Items.Num() || bFoundSingleResult
+		// or no items processed ==> this means error
+		|| (ItemsAlreadyProcessed == CurrentTestStartingItem);
+}
+
+void FEnvQueryInstance::FinishStep(bool bStepDone)
+{
 	if (bStepDone)
 	{
 #if USE_EQS_DEBUGGER
@@ -269,6 +335,7 @@ void FEnvQueryInstance::ExecuteOneStep(double InTimeLimit)
 	}
 
 	// sort results or switch to next option when all tests are performed
+	const FEnvQueryOptionInstance& OptionItem = Options[OptionIndex];
 	if (IsFinished() == false &&
 		(OptionItem.Tests.Num() == CurrentTest || NumValidItems <= 0))
 	{
@@ -9,6 +9,9 @@
 #include "EnvironmentQuery/EnvQueryContext.h"
 #include "EnvironmentQuery/EQSTestingPawn.h"
 #include "EnvironmentQuery/EnvQueryDebugHelpers.h"
+#if WITH_RECAST
+#include "AI/Navigation/PImplRecastNavMesh.h"
+#endif // WITH_RECAST
 #if WITH_EDITOR
 #include "UnrealEd.h"
 #include "Engine/Brush.h"
@@ -29,6 +32,60 @@ DEFINE_STAT(STAT_AI_EQS_NumInstances);
 DEFINE_STAT(STAT_AI_EQS_NumItems);
 DEFINE_STAT(STAT_AI_EQS_InstanceMemory);
 
+static TAutoConsoleVariable<float> CVarEQSTimeBudgetMs(
+	TEXT("ai.EQS.TimeBudgetMs"),
+	10.0f,
+	TEXT("Time in milliseconds the environment query manager can spend running queries every tick."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarEQSParallelTests(
+	TEXT("ai.EQS.ParallelTests"),
+	0,
+	TEXT("Whether the tests that support it are scored on task graph worker threads, one task per query.\n")
+	TEXT("0: run every step on the game thread (default), 1: score thread safe tests on worker threads"),
+	ECVF_Default);
+
+/** Scores the items of a query's test step on a worker thread */
+class FEnvQueryWorkerStepTask
+{
+	/** kept alive by the manager until the task is done */
+	FEnvQueryInstance* QueryInstance;
+
+public:
+	FEnvQueryWorkerStepTask(FEnvQueryInstance* InQueryInstance)
+		: QueryInstance(InQueryInstance)
+	{
+	}
+
+	FORCEINLINE TStatId GetStatId() const
+	{
+		RETURN_QUICK_DECLARE_CYCLE_STAT(FEnvQueryWorkerStepTask, STATGROUP_TaskGraphTasks);
+	}
+	static ENamedThreads::Type GetDesiredThread()
+	{
+		return ENamedThreads::AnyThread;
+	}
+	static ESubsequentsMode::Type GetSubsequentsMode()
+	{
+		return ESubsequentsMode::TrackSubsequents;
+	}
+	void DoTask(ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+	{
+		if (IsInGameThread())
+		{
+			// no worker thread picked the task up, just run the step inline
+			QueryInstance->ExecuteWorkerStep();
+			return;
+		}
+
+#if WITH_RECAST
+		// navmesh queries of pathfinding tests can't share the navmesh's query object
+		FRecastNavMeshQueryContext NavQueryContext;
+#endif // WITH_RECAST
+		QueryInstance->ExecuteWorkerStep();
+	}
+};
+
 //////////////////////////////////////////////////////////////////////////
 // FEnvQueryRequest
 
@@ -244,22 +301,47 @@ void UEnvQueryManager::Tick(float DeltaTime)
 {
 	SCOPE_CYCLE_COUNTER(STAT_AI_EQS_Tick);
 	SET_DWORD_STAT(STAT_AI_EQS_NumInstances, RunningQueries.Num());
-	// @TODO: threads?
 
-	const double MaxAllowedSeconds = 0.010;
+	const double MaxAllowedSeconds = FMath::Max(0.0f, CVarEQSTimeBudgetMs.GetValueOnGameThread()) / 1000.0;
+	const double Deadline = FPlatformTime::Seconds() + MaxAllowedSeconds;
+	// without worker threads the steps would run one after another on the game thread, each with the whole budget
+	const bool bParallelTests = CVarEQSParallelTests.GetValueOnGameThread() != 0 && FPlatformProcess::SupportsMultithreading();
 	double TimeLeft = MaxAllowedSeconds;
 	int32 FinishedQueriesCount = 0;
 		
 	TArray<TSharedPtr<FEnvQueryInstance> > RunningQueriesCopy = RunningQueries;
+	TArray<TSharedPtr<FEnvQueryInstance> > WorkerQueries;
+	FGraphEventArray WorkerEvents;
 
 	{
 		SCOPE_CYCLE_COUNTER(STAT_AI_EQS_TickWork);
 		while (TimeLeft > 0.0 && RunningQueriesCopy.Num() > 0)
 		{
-			for (int32 Index = 0; Index < RunningQueriesCopy.Num() && TimeLeft > 0.0; Index++)
+			// tests of worker steps are bound on the game thread, their scoring runs alongside the game thread steps
+			if (bParallelTests)
 			{
-				const double StartTime = FPlatformTime::Seconds();
+				for (int32 Index = 0; Index < RunningQueriesCopy.Num(); Index++)
+				{
+					TSharedPtr<FEnvQueryInstance>& QueryInstance = RunningQueriesCopy[Index];
+					if (QueryInstance->CanRunStepOnWorkerThread())
+					{
+						QueryInstance->PrepareWorkerStep(TimeLeft);
+						WorkerQueries.Add(QueryInstance);
+						RunningQueriesCopy.RemoveAt(Index, 1, /*bAllowShrinking=*/false);
+						Index--;
+					}
+				}
+
+				for (int32 Index = 0; Index < WorkerQueries.Num(); Index++)
+				{
+					WorkerEvents.Add(TGraphTask<FEnvQueryWorkerStepTask>::CreateTask().ConstructAndDispatchWhenReady(WorkerQueries[Index].Get()));
+				}
+
+				TimeLeft = Deadline - FPlatformTime::Seconds();
+			}
 
+			for (int32 Index = 0; Index < RunningQueriesCopy.Num() && TimeLeft > 0.0; Index++)
+			{
 				TSharedPtr<FEnvQueryInstance>& QueryInstance = RunningQueriesCopy[Index];
 				//SCOPE_LOG_TIME(*FString::Printf(TEXT("Query %s step"), *QueryInstance->QueryName), nullptr);
 
@@ -272,7 +354,31 @@ void UEnvQueryManager::Tick(float DeltaTime)
 					++FinishedQueriesCount;
 				}
 
-				TimeLeft -= (FPlatformTime::Seconds() - StartTime);
+				TimeLeft = Deadline - FPlatformTime::Seconds();
+			}
+
+			if (WorkerQueries.Num() > 0)
+			{
+				FTaskGraphInterface::Get().WaitUntilTasksComplete(WorkerEvents, ENamedThreads::GameThread);
+
+				for (int32 Index = 0; Index < WorkerQueries.Num(); Index++)
+				{
+					TSharedPtr<FEnvQueryInstance>& QueryInstance = WorkerQueries[Index];
+					QueryInstance->FinishWorkerStep();
+
+					if (QueryInstance->IsFinished())
+					{
+						++FinishedQueriesCount;
+					}
+					else
+					{
+						RunningQueriesCopy.Add(QueryInstance);
+					}
+				}
+
+				WorkerQueries.Reset();
+				WorkerEvents.Reset();
+				TimeLeft = Deadline - FPlatformTime::Seconds();
 			}
 		}
 	}
@@ -175,6 +175,26 @@ FRotator UEnvQueryTest::GetItemRotation(FEnvQueryInstance& QueryInstance, int32
 		FRotator::ZeroRotator;
 }
 
+void UEnvQueryTest::GetItemLocations(FEnvQueryInstance& QueryInstance, int32 FirstItem, FEnvQueryItemLocations& OutLocations) const
+{
+	OutLocations.FirstItem = FirstItem;
+	OutLocations.NumItems = FMath::Clamp(QueryInstance.Items.Num() - FirstItem, 0, (int32)FEnvQueryItemLocations::MaxItems);
+
+	const int32 NumPadded = OutLocations.NumPadded();
+	for (int32 Index = 0; Index < NumPadded; Index++)
+	{
+		FVector Location = FVector::ZeroVector;
+		if (Index < OutLocations.NumItems && QueryInstance.ItemTypeVectorCDO)
+		{
+			Location = QueryInstance.ItemTypeVectorCDO->GetItemLocation(QueryInstance.RawData.GetData() + QueryInstance.Items[FirstItem + Index].DataOffset);
+		}
+
+		OutLocations.X[Index] = Location.X;
+		OutLocations.Y[Index] = Location.Y;
+		OutLocations.Z[Index] = Location.Z;
+	}
+}
+
 AActor* UEnvQueryTest::GetItemActor(FEnvQueryInstance& QueryInstance, int32 ItemIndex) const
 {
 	return QueryInstance.ItemTypeActorCDO ?
@@ -7,19 +7,44 @@
 
 namespace
 {
-	FORCEINLINE float CalcDistance3D(const FVector& PosA, const FVector& PosB)
+	struct FEnvQueryTestWorkerData_Distance : public FEnvQueryTestWorkerData
 	{
-		return (PosB - PosA).Size();
-	}
+		TArray<FVector> ContextLocations;
+	};
 
-	FORCEINLINE float CalcDistance2D(const FVector& PosA, const FVector& PosB)
+	/** calculates distances from a context to a block of items, 4 items at a time */
+	void CalcDistances(EEnvTestDistance::Type TestMode, const FEnvQueryItemLocations& ItemLocations, const FVector& ContextLocation, float* OutDistances)
 	{
-		return (PosB - PosA).Size2D();
-	}
+		const VectorRegister ContextX = VectorSetFloat1(ContextLocation.X);
+		const VectorRegister ContextY = VectorSetFloat1(ContextLocation.Y);
+		const VectorRegister ContextZ = VectorSetFloat1(ContextLocation.Z);
+		const VectorRegister MinSizeSquared = VectorSetFloat1(SMALL_NUMBER);
 
-	FORCEINLINE float CalcDistanceZ(const FVector& PosA, const FVector& PosB)
-	{
-		return PosB.Z - PosA.Z;
+		for (int32 ItemIndex = 0; ItemIndex < ItemLocations.NumPadded(); ItemIndex += 4)
+		{
+			const VectorRegister DeltaX = VectorSubtract(ContextX, VectorLoad(&ItemLocations.X[ItemIndex]));
+			const VectorRegister DeltaY = VectorSubtract(ContextY, VectorLoad(&ItemLocations.Y[ItemIndex]));
+			const VectorRegister DeltaZ = VectorSubtract(ContextZ, VectorLoad(&ItemLocations.Z[ItemIndex]));
+
+			VectorRegister Distance;
+			if (TestMode == EEnvTestDistance::DistanceZ)
+			{
+				Distance = DeltaZ;
+			}
+			else
+			{
+				VectorRegister SizeSquared = VectorMultiplyAdd(DeltaX, DeltaX, VectorMultiply(DeltaY, DeltaY));
+				if (TestMode == EEnvTestDistance::Distance3D)
+				{
+					SizeSquared = VectorMultiplyAdd(DeltaZ, DeltaZ, SizeSquared);
+				}
+
+				// sqrt(x) = x / sqrt(x), clamped to avoid 0 / 0 for items at the context's location
+				Distance = VectorMultiply(SizeSquared, VectorReciprocalSqrtAccurate(VectorMax(SizeSquared, MinSizeSquared)));
+			}
+
+			VectorStore(Distance, &OutDistances[ItemIndex]);
+		}
 	}
 }
 
@@ -32,56 +57,68 @@ UEnvQueryTest_Distance::UEnvQueryTest_Distance(const FObjectInitializer& ObjectI
 
 void UEnvQueryTest_Distance::RunTest(FEnvQueryInstance& QueryInstance) const
 {
+	TSharedPtr<FEnvQueryTestWorkerData> Data = PrepareWorkerRun(QueryInstance);
+	if (Data.IsValid())
+	{
+		RunTestOnWorker(QueryInstance, *Data);
+	}
+}
+
+TSharedPtr<FEnvQueryTestWorkerData> UEnvQueryTest_Distance::PrepareWorkerRun(FEnvQueryInstance& QueryInstance) const
+{
+	TSharedPtr<FEnvQueryTestWorkerData_Distance> Data = MakeShareable(new FEnvQueryTestWorkerData_Distance);
+
 	FloatValueMin.BindData(QueryInstance.Owner.Get(), QueryInstance.QueryID);
-	float MinThresholdValue = FloatValueMin.GetValue();
+	Data->MinThresholdValue = FloatValueMin.GetValue();
 
 	FloatValueMax.BindData(QueryInstance.Owner.Get(), QueryInstance.QueryID);
-	float MaxThresholdValue = FloatValueMax.GetValue();
+	Data->MaxThresholdValue = FloatValueMax.GetValue();
 
 	// don't support context Item here, it doesn't make any sense
-	TArray<FVector> ContextLocations;
-	if (!QueryInstance.PrepareContext(DistanceTo, ContextLocations))
+	if (!QueryInstance.PrepareContext(DistanceTo, Data->ContextLocations))
+	{
+		return NULL;
+	}
+
+	return Data;
+}
+
+void UEnvQueryTest_Distance::RunTestOnWorker(FEnvQueryInstance& QueryInstance, const FEnvQueryTestWorkerData& Data) const
+{
+	if (TestMode != EEnvTestDistance::Distance3D && TestMode != EEnvTestDistance::Distance2D && TestMode != EEnvTestDistance::DistanceZ)
 	{
 		return;
 	}
 
-	switch (TestMode)
+	const FEnvQueryTestWorkerData_Distance& DistanceData = (const FEnvQueryTestWorkerData_Distance&)Data;
+	const int32 NumContexts = DistanceData.ContextLocations.Num();
+
+	// distances to each context are computed over blocks of item locations in SoA layout, starting at the first item the iterator
+	// reaches, so a time sliced step only pays for the items it scores
+	FEnvQueryItemLocations ItemLocations;
+	TArray<float, TInlineAllocator<FEnvQueryItemLocations::MaxItems * 4> > Distances;
+	Distances.AddUninitialized(FEnvQueryItemLocations::MaxItems * NumContexts);
+	int32 BlockEnd = 0;
+
+	for (FEnvQueryInstance::ItemIterator It(this, QueryInstance); It; ++It)
 	{
-	case EEnvTestDistance::Distance3D:	
-		for (FEnvQueryInstance::ItemIterator It(this, QueryInstance); It; ++It)
+		if (*It >= BlockEnd)
 		{
-			const FVector ItemLocation = GetItemLocation(QueryInstance, *It);
-			for (int32 ContextIndex = 0; ContextIndex < ContextLocations.Num(); ContextIndex++)
-			{
-				const float Distance = CalcDistance3D(ItemLocation, ContextLocations[ContextIndex]);
-				It.SetScore(TestPurpose, FilterType, Distance, MinThresholdValue, MaxThresholdValue);
-			}
-		}
-		break;
-	case EEnvTestDistance::Distance2D:	
-		for (FEnvQueryInstance::ItemIterator It(this, QueryInstance); It; ++It)
-		{
-			const FVector ItemLocation = GetItemLocation(QueryInstance, *It);
-			for (int32 ContextIndex = 0; ContextIndex < ContextLocations.Num(); ContextIndex++)
+			GetItemLocations(QueryInstance, *It, ItemLocations);
+			BlockEnd = ItemLocations.FirstItem + ItemLocations.NumItems;
+
+			for (int32 ContextIndex = 0; ContextIndex < NumContexts; ContextIndex++)
 			{
-				const float Distance = CalcDistance2D(ItemLocation, ContextLocations[ContextIndex]);
-				It.SetScore(TestPurpose, FilterType, Distance, MinThresholdValue, MaxThresholdValue);
+				CalcDistances(TestMode, ItemLocations, DistanceData.ContextLocations[ContextIndex], Distances.GetData() + ContextIndex * FEnvQueryItemLocations::MaxItems);
 			}
 		}
-		break;
-	case EEnvTestDistance::DistanceZ:	
-		for (FEnvQueryInstance::ItemIterator It(this, QueryInstance); It; ++It)
+
+		const int32 BlockIndex = *It - ItemLocations.FirstItem;
+		for (int32 ContextIndex = 0; ContextIndex < NumContexts; ContextIndex++)
 		{
-			const FVector ItemLocation = GetItemLocation(QueryInstance, *It);
-			for (int32 ContextIndex = 0; ContextIndex < ContextLocations.Num(); ContextIndex++)
-			{
-				const float Distance = CalcDistanceZ(ItemLocation, ContextLocations[ContextIndex]);
-				It.SetScore(TestPurpose, FilterType, Distance, MinThresholdValue, MaxThresholdValue);
-			}
+			const float Distance = Distances[ContextIndex * FEnvQueryItemLocations::MaxItems + BlockIndex];
+			It.SetScore(TestPurpose, FilterType, Distance, Data.MinThresholdValue, Data.MaxThresholdValue);
 		}
-		break;
-	default:
-		return;
 	}
 }
 
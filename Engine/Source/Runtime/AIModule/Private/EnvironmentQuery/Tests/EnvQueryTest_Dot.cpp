@@ -20,37 +20,68 @@ UEnvQueryTest_Dot::UEnvQueryTest_Dot(const FObjectInitializer& ObjectInitializer
 	bAbsoluteValue = false;
 }
 
+namespace
+{
+	struct FEnvQueryTestWorkerData_Dot : public FEnvQueryTestWorkerData
+	{
+		/** directions for contexts different than Item */
+		TArray<FVector> LineADirs;
+		TArray<FVector> LineBDirs;
+
+		bool bUpdateLineAPerItem;
+		bool bUpdateLineBPerItem;
+	};
+}
+
 void UEnvQueryTest_Dot::RunTest(FEnvQueryInstance& QueryInstance) const
 {
+	TSharedPtr<FEnvQueryTestWorkerData> Data = PrepareWorkerRun(QueryInstance);
+	if (Data.IsValid())
+	{
+		RunTestOnWorker(QueryInstance, *Data);
+	}
+}
+
+TSharedPtr<FEnvQueryTestWorkerData> UEnvQueryTest_Dot::PrepareWorkerRun(FEnvQueryInstance& QueryInstance) const
+{
+	TSharedPtr<FEnvQueryTestWorkerData_Dot> Data = MakeShareable(new FEnvQueryTestWorkerData_Dot);
+
 	FloatValueMin.BindData(QueryInstance.Owner.Get(), QueryInstance.QueryID);
-	float MinThresholdValue = FloatValueMin.GetValue();
+	Data->MinThresholdValue = FloatValueMin.GetValue();
 
 	FloatValueMax.BindData(QueryInstance.Owner.Get(), QueryInstance.QueryID);
-	float MaxThresholdValue = FloatValueMax.GetValue();
+	Data->MaxThresholdValue = FloatValueMax.GetValue();
 
 	// gather all possible directions: for contexts different than Item
-	TArray<FVector> LineADirs;
-	const bool bUpdateLineAPerItem = RequiresPerItemUpdates(LineA.LineFrom, LineA.LineTo, LineA.Rotation, LineA.DirMode == EEnvDirection::Rotation);
-	if (!bUpdateLineAPerItem)
+	// lines updated per item still gather them once, so the other contexts are cached and per item updates only read the cache
+	Data->bUpdateLineAPerItem = RequiresPerItemUpdates(LineA.LineFrom, LineA.LineTo, LineA.Rotation, LineA.DirMode == EEnvDirection::Rotation);
+	GatherLineDirections(Data->LineADirs, QueryInstance, LineA.LineFrom, LineA.LineTo, LineA.Rotation, LineA.DirMode == EEnvDirection::Rotation);
+	if (!Data->bUpdateLineAPerItem && Data->LineADirs.Num() == 0)
 	{
-		GatherLineDirections(LineADirs, QueryInstance, LineA.LineFrom, LineA.LineTo, LineA.Rotation, LineA.DirMode == EEnvDirection::Rotation);
-		if (LineADirs.Num() == 0)
-		{
-			return;
-		}
+		return NULL;
 	}
 
-	TArray<FVector> LineBDirs;
-	const bool bUpdateLineBPerItem = RequiresPerItemUpdates(LineB.LineFrom, LineB.LineTo, LineB.Rotation, LineB.DirMode == EEnvDirection::Rotation);
-	if (!bUpdateLineBPerItem)
+	Data->bUpdateLineBPerItem = RequiresPerItemUpdates(LineB.LineFrom, LineB.LineTo, LineB.Rotation, LineB.DirMode == EEnvDirection::Rotation);
+	GatherLineDirections(Data->LineBDirs, QueryInstance, LineB.LineFrom, LineB.LineTo, LineB.Rotation, LineB.DirMode == EEnvDirection::Rotation);
+	if (!Data->bUpdateLineBPerItem && Data->LineBDirs.Num() == 0)
 	{
-		GatherLineDirections(LineBDirs, QueryInstance, LineB.LineFrom, LineB.LineTo, LineB.Rotation, LineB.DirMode == EEnvDirection::Rotation);
-		if (LineBDirs.Num() == 0)
-		{
-			return;
-		}
+		return NULL;
 	}
 
+	return Data;
+}
+
+void UEnvQueryTest_Dot::RunTestOnWorker(FEnvQueryInstance& QueryInstance, const FEnvQueryTestWorkerData& Data) const
+{
+	const FEnvQueryTestWorkerData_Dot& DotData = (const FEnvQueryTestWorkerData_Dot&)Data;
+	const bool bUpdateLineAPerItem = DotData.bUpdateLineAPerItem;
+	const bool bUpdateLineBPerItem = DotData.bUpdateLineBPerItem;
+	const float MinThresholdValue = Data.MinThresholdValue;
+	const float MaxThresholdValue = Data.MaxThresholdValue;
+
+	TArray<FVector> LineADirs = DotData.LineADirs;
+	TArray<FVector> LineBDirs = DotData.LineBDirs;
+
 	// loop through all items
 	for (FEnvQueryInstance::ItemIterator It(this, QueryInstance); It; ++It)
 	{
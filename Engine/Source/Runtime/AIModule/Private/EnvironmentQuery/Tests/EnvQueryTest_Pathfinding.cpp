@@ -29,8 +29,33 @@ UEnvQueryTest_Pathfinding::UEnvQueryTest_Pathfinding(const FObjectInitializer& O
 	FloatFilterMax.Value = 1000.0f;
 }
 
+namespace
+{
+	struct FEnvQueryTestWorkerData_Pathfinding : public FEnvQueryTestWorkerData
+	{
+		TArray<FVector> ContextLocations;
+		UNavigationSystem* NavSys;
+		ANavigationData* NavData;
+		UObject* PathOwner;
+		bool bPathToItem;
+		bool bHierarchical;
+		bool bDiscardFailed;
+	};
+}
+
 void UEnvQueryTest_Pathfinding::RunTest(FEnvQueryInstance& QueryInstance) const
 {
+	TSharedPtr<FEnvQueryTestWorkerData> Data = PrepareWorkerRun(QueryInstance);
+	if (Data.IsValid())
+	{
+		RunTestOnWorker(QueryInstance, *Data);
+	}
+}
+
+TSharedPtr<FEnvQueryTestWorkerData> UEnvQueryTest_Pathfinding::PrepareWorkerRun(FEnvQueryInstance& QueryInstance) const
+{
+	TSharedPtr<FEnvQueryTestWorkerData_Pathfinding> Data = MakeShareable(new FEnvQueryTestWorkerData_Pathfinding);
+
 	UObject* DataOwner = QueryInstance.Owner.Get();
 	BoolValue.BindData(DataOwner, QueryInstance.QueryID);
 	PathFromContext.BindData(DataOwner, QueryInstance.QueryID);
@@ -39,27 +64,48 @@ void UEnvQueryTest_Pathfinding::RunTest(FEnvQueryInstance& QueryInstance) const
 	FloatValueMin.BindData(DataOwner, QueryInstance.QueryID);
 	FloatValueMax.BindData(DataOwner, QueryInstance.QueryID);
 
-	bool bWantsPath = BoolValue.GetValue();
-	bool bPathToItem = PathFromContext.GetValue();
-	bool bHierarchical = UseHierarchicalPathfinding.GetValue();
-	bool bDiscardFailed = SkipUnreachable.GetValue();
-	float MinThresholdValue = FloatValueMin.GetValue();
-	float MaxThresholdValue = FloatValueMax.GetValue();
+	Data->bBoolValue = BoolValue.GetValue();
+	Data->bPathToItem = PathFromContext.GetValue();
+	Data->bHierarchical = UseHierarchicalPathfinding.GetValue();
+	Data->bDiscardFailed = SkipUnreachable.GetValue();
+	Data->MinThresholdValue = FloatValueMin.GetValue();
+	Data->MaxThresholdValue = FloatValueMax.GetValue();
+	Data->PathOwner = DataOwner;
 
-	UNavigationSystem* NavSys = QueryInstance.World->GetNavigationSystem();
-	ANavigationData* NavData = FindNavigationData(NavSys, QueryInstance.Owner.Get());
-	if (!NavData)
+	Data->NavSys = QueryInstance.World->GetNavigationSystem();
+	Data->NavData = FindNavigationData(Data->NavSys, DataOwner);
+	if (!Data->NavData)
 	{
-		return;
+		return NULL;
 	}
 
-	TArray<FVector> ContextLocations;
-	if (!QueryInstance.PrepareContext(Context, ContextLocations))
+	if (!QueryInstance.PrepareContext(Context, Data->ContextLocations))
 	{
-		return;
+		return NULL;
 	}
 
-	EPathFindingMode::Type PFMode(bHierarchical ? EPathFindingMode::Hierarchical : EPathFindingMode::Regular);
+	return Data;
+}
+
+void UEnvQueryTest_Pathfinding::RunTestOnWorker(FEnvQueryInstance& QueryInstance, const FEnvQueryTestWorkerData& Data) const
+{
+	const FEnvQueryTestWorkerData_Pathfinding& PathData = (const FEnvQueryTestWorkerData_Pathfinding&)Data;
+	const TArray<FVector>& ContextLocations = PathData.ContextLocations;
+	UNavigationSystem* NavSys = PathData.NavSys;
+	ANavigationData* NavData = PathData.NavData;
+	const bool bPathToItem = PathData.bPathToItem;
+	const bool bWantsPath = Data.bBoolValue;
+	const float MinThresholdValue = Data.MinThresholdValue;
+	const float MaxThresholdValue = Data.MaxThresholdValue;
+
+	EPathFindingMode::Type PFMode(PathData.bHierarchical ? EPathFindingMode::Hierarchical : EPathFindingMode::Regular);
+
+	// batch query bookkeeping isn't thread safe, off game thread each path uses the navmesh query of the worker's context
+	const bool bBatchQuery = IsInGameThread();
+	if (bBatchQuery)
+	{
+		NavData->BeginBatchQuery();
+	}
 
 	if (GetWorkOnFloatValues())
 	{
@@ -68,26 +114,23 @@ void UEnvQueryTest_Pathfinding::RunTest(FEnvQueryInstance& QueryInstance) const
 			(bPathToItem ? &UEnvQueryTest_Pathfinding::FindPathLengthTo : &UEnvQueryTest_Pathfinding::FindPathLengthFrom) :
 			(bPathToItem ? &UEnvQueryTest_Pathfinding::FindPathCostTo : &UEnvQueryTest_Pathfinding::FindPathCostFrom) );
 
-		NavData->BeginBatchQuery();
 		for (FEnvQueryInstance::ItemIterator It(this, QueryInstance); It; ++It)
 		{
 			const FVector ItemLocation = GetItemLocation(QueryInstance, *It);
 			for (int32 ContextIndex = 0; ContextIndex < ContextLocations.Num(); ContextIndex++)
 			{
-				const float PathValue = FindPathFunc.Execute(ItemLocation, ContextLocations[ContextIndex], PFMode, NavData, NavSys, QueryInstance.Owner.Get());
+				const float PathValue = FindPathFunc.Execute(ItemLocation, ContextLocations[ContextIndex], PFMode, NavData, NavSys, PathData.PathOwner);
 				It.SetScore(TestPurpose, FilterType, PathValue, MinThresholdValue, MaxThresholdValue);
 
-				if (bDiscardFailed && PathValue >= BIG_NUMBER)
+				if (PathData.bDiscardFailed && PathValue >= BIG_NUMBER)
 				{
 					It.DiscardItem();
 				}
 			}
 		}
-		NavData->FinishBatchQuery();
 	}
 	else
 	{
-		NavData->BeginBatchQuery();
 		if (bPathToItem)
 		{
 			for (FEnvQueryInstance::ItemIterator It(this, QueryInstance); It; ++It)
@@ -95,7 +138,7 @@ void UEnvQueryTest_Pathfinding::RunTest(FEnvQueryInstance& QueryInstance) const
 				const FVector ItemLocation = GetItemLocation(QueryInstance, *It);
 				for (int32 ContextIndex = 0; ContextIndex < ContextLocations.Num(); ContextIndex++)
 				{
-					const bool bFoundPath = TestPathTo(ItemLocation, ContextLocations[ContextIndex], PFMode, NavData, NavSys, QueryInstance.Owner.Get());
+					const bool bFoundPath = TestPathTo(ItemLocation, ContextLocations[ContextIndex], PFMode, NavData, NavSys, PathData.PathOwner);
 					It.SetScore(TestPurpose, FilterType, bFoundPath, bWantsPath);
 				}
 			}
@@ -107,11 +150,15 @@ void UEnvQueryTest_Pathfinding::RunTest(FEnvQueryInstance& QueryInstance) const
 				const FVector ItemLocation = GetItemLocation(QueryInstance, *It);
 				for (int32 ContextIndex = 0; ContextIndex < ContextLocations.Num(); ContextIndex++)
 				{
-					const bool bFoundPath = TestPathFrom(ItemLocation, ContextLocations[ContextIndex], PFMode, NavData, NavSys, QueryInstance.Owner.Get());
+					const bool bFoundPath = TestPathFrom(ItemLocation, ContextLocations[ContextIndex], PFMode, NavData, NavSys, PathData.PathOwner);
 					It.SetScore(TestPurpose, FilterType, bFoundPath, bWantsPath);
 				}
 			}
 		}
+	}
+
+	if (bBatchQuery)
+	{
 		NavData->FinishBatchQuery();
 	}
 }
@@ -32,6 +32,61 @@ DECLARE_DWORD_COUNTER_STAT(TEXT("Num Agents"), STAT_AI_Crowd_NumAgents, STATGROU
 
 DEFINE_LOG_CATEGORY_STATIC(LogEngineCrowdFollowing, Warning, All)
 
+static TAutoConsoleVariable<int32> CVarCrowdParallelChunkSize(
+	TEXT("ai.Crowd.ParallelChunkSize"),
+	64,
+	TEXT("Number of crowd agents processed by each worker task in neighbour, steering and avoidance steps. Agents are simulated the same way regardless of chunks.\n")
+	TEXT("0: simulate all agents on the game thread"),
+	ECVF_Default);
+
+#if WITH_RECAST
+/** Runs a chunk of agents of a detour crowd update step on a worker thread */
+class FCrowdChunkTask
+{
+	dtParallelJobFunc JobFunc;
+	void* JobData;
+	int32 JobIdx;
+
+public:
+	FCrowdChunkTask(dtParallelJobFunc InJobFunc, void* InJobData, int32 InJobIdx)
+		: JobFunc(InJobFunc)
+		, JobData(InJobData)
+		, JobIdx(InJobIdx)
+	{
+	}
+
+	FORCEINLINE TStatId GetStatId() const
+	{
+		RETURN_QUICK_DECLARE_CYCLE_STAT(FCrowdChunkTask, STATGROUP_TaskGraphTasks);
+	}
+	static ENamedThreads::Type GetDesiredThread()
+	{
+		return ENamedThreads::AnyThread;
+	}
+	static ESubsequentsMode::Type GetSubsequentsMode()
+	{
+		return ESubsequentsMode::TrackSubsequents;
+	}
+	void DoTask(ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+	{
+		JobFunc(JobData, JobIdx);
+	}
+};
+
+/** Parallel for of the detour crowd: the calling thread runs the first chunk while task graph workers run the others */
+static void CrowdParallelFor(void* UserData, dtParallelJobFunc JobFunc, void* JobData, const int NumJobs)
+{
+	FGraphEventArray ChunkEvents;
+	for (int32 JobIdx = 1; JobIdx < NumJobs; JobIdx++)
+	{
+		ChunkEvents.Add(TGraphTask<FCrowdChunkTask>::CreateTask().ConstructAndDispatchWhenReady(JobFunc, JobData, JobIdx));
+	}
+
+	JobFunc(JobData, 0);
+	FTaskGraphInterface::Get().WaitUntilTasksComplete(ChunkEvents, ENamedThreads::GameThread);
+}
+#endif // WITH_RECAST
+
 namespace CrowdDebugDrawing
 {
 	/** if set, debug information will be displayed for agent selected in editor */
@@ -196,6 +251,11 @@ void UCrowdManager::Tick(float DeltaTime)
 		{
 			MyNavData->BeginBatchQuery();
 
+			// per agent parts of detour steps run in chunks on task graph workers
+			const int32 MaxChunks = FTaskGraphInterface::Get().GetNumWorkerThreads() + 1;
+			DetourCrowd->setParallelUpdate(CVarCrowdParallelChunkSize.GetValueOnGameThread(), MaxChunks);
+			DetourCrowd->setParallelFor(&CrowdParallelFor, NULL);
+
 			for (auto It = ActiveAgents.CreateIterator(); It; ++It)
 			{
 				// collect position and velocity
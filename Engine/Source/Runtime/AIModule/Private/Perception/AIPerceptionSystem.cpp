@@ -98,6 +98,17 @@ TStatId UAIPerceptionSystem::GetStatId() const
 }
 
 
+void UAIPerceptionSystem::CleanUp()
+{
+	for (UAISense* Sense : Senses)
+	{
+		if (Sense != nullptr)
+		{
+			Sense->CleanUp();
+		}
+	}
+}
+
 void UAIPerceptionSystem::RegisterSource(FAISenseID SenseID, AActor& SourceActor)
 {
 	ensure(IsSenseInstantiated(SenseID));
@@ -7,8 +7,19 @@
 
 DECLARE_CYCLE_STAT(TEXT("Perception Sense: Sight"),STAT_AI_Sense_Sight,STATGROUP_AI);
 DECLARE_CYCLE_STAT(TEXT("Perception Sense: Sight, Listener Update"), STAT_AI_Sense_Sight_ListenerUpdate, STATGROUP_AI);
+DECLARE_CYCLE_STAT(TEXT("Perception Sense: Sight, Apply Traces"), STAT_AI_Sense_Sight_ApplyTraces, STATGROUP_AI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Perception Sense: Sight, Batched Traces"), STAT_AI_Sense_Sight_BatchedTraces, STATGROUP_AI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Perception Sense: Sight, Shared Traces"), STAT_AI_Sense_Sight_SharedTraces, STATGROUP_AI);
 
 static const int32 DefaultMaxTracesPerTick = 6;
+static const int32 DefaultMaxBatchedTracesPerTick = 64;
+
+static TAutoConsoleVariable<int32> CVarAISightBatchedTraces(
+	TEXT("ai.Sight.BatchedTraces"),
+	0,
+	TEXT("Whether sight queries are culled together and their line of sight traces submitted as one async batch, read by the next update.\n")
+	TEXT("0: trace each query right away, up to MaxTracesPerTick (default), 1: batch up to MaxBatchedTracesPerTick traces per update"),
+	ECVF_Default);
 
 //----------------------------------------------------------------------//
 // helpers
@@ -24,6 +35,87 @@ FORCEINLINE_DEBUGGABLE bool CheckIsTargetInSightPie(const FPerceptionListener& L
 	return false;
 }
 
+/** Sight pie test inputs of many queries, in structure of arrays layout padded with zeros to a multiple of 4 queries */
+struct FSightPieBatch
+{
+	TArray<float> ListenerX, ListenerY, ListenerZ;
+	TArray<float> DirectionX, DirectionY, DirectionZ;
+	TArray<float> TargetX, TargetY, TargetZ;
+	TArray<float> RadiusSq;
+	TArray<float> AngleCos;
+
+	void Init(int32 NumQueries)
+	{
+		const int32 NumPadded = Align(NumQueries, 4);
+		TArray<float>* Arrays[] = { &ListenerX, &ListenerY, &ListenerZ, &DirectionX, &DirectionY, &DirectionZ, &TargetX, &TargetY, &TargetZ, &RadiusSq, &AngleCos };
+		for (int32 ArrayIndex = 0; ArrayIndex < ARRAY_COUNT(Arrays); ++ArrayIndex)
+		{
+			Arrays[ArrayIndex]->Reset(NumPadded);
+			Arrays[ArrayIndex]->AddZeroed(NumPadded);
+		}
+	}
+
+	void Set(int32 Index, const FVector& ListenerLocation, const FVector& ListenerDirection, const FVector& TargetLocation, float InRadiusSq, float InAngleCos)
+	{
+		ListenerX[Index] = ListenerLocation.X;
+		ListenerY[Index] = ListenerLocation.Y;
+		ListenerZ[Index] = ListenerLocation.Z;
+		DirectionX[Index] = ListenerDirection.X;
+		DirectionY[Index] = ListenerDirection.Y;
+		DirectionZ[Index] = ListenerDirection.Z;
+		TargetX[Index] = TargetLocation.X;
+		TargetY[Index] = TargetLocation.Y;
+		TargetZ[Index] = TargetLocation.Z;
+		RadiusSq[Index] = InRadiusSq;
+		AngleCos[Index] = InAngleCos;
+	}
+
+	FORCEINLINE int32 NumPadded() const { return RadiusSq.Num(); }
+};
+
+/** Same test as CheckIsTargetInSightPie, four queries at a time. Padding fails the test */
+static void CheckTargetsInSightPies(const FSightPieBatch& Batch, TArray<uint8>& OutInPie)
+{
+	OutInPie.SetNumUninitialized(Batch.NumPadded());
+
+	const VectorRegister MinDistanceSq = VectorSetFloat1(SMALL_NUMBER);
+	MS_ALIGN(16) uint32 PassedMask[4] GCC_ALIGN(16);
+
+	for (int32 Index = 0; Index < Batch.NumPadded(); Index += 4)
+	{
+		const VectorRegister DeltaX = VectorSubtract(VectorLoad(&Batch.TargetX[Index]), VectorLoad(&Batch.ListenerX[Index]));
+		const VectorRegister DeltaY = VectorSubtract(VectorLoad(&Batch.TargetY[Index]), VectorLoad(&Batch.ListenerY[Index]));
+		const VectorRegister DeltaZ = VectorSubtract(VectorLoad(&Batch.TargetZ[Index]), VectorLoad(&Batch.ListenerZ[Index]));
+
+		const VectorRegister DistanceSq = VectorMultiplyAdd(DeltaZ, DeltaZ, VectorMultiplyAdd(DeltaY, DeltaY, VectorMultiply(DeltaX, DeltaX)));
+		const VectorRegister InRange = VectorCompareGE(VectorLoad(&Batch.RadiusSq[Index]), DistanceSq);
+
+		// dot(Delta / |Delta|, Direction) > Cos  <=>  dot(Delta, Direction) > Cos * |Delta|, which fails for targets at the listener's location like the unsafe normal does
+		const VectorRegister Distance = VectorMultiply(DistanceSq, VectorReciprocalSqrtAccurate(VectorMax(DistanceSq, MinDistanceSq)));
+		const VectorRegister Dot = VectorMultiplyAdd(DeltaZ, VectorLoad(&Batch.DirectionZ[Index]), VectorMultiplyAdd(DeltaY, VectorLoad(&Batch.DirectionY[Index]), VectorMultiply(DeltaX, VectorLoad(&Batch.DirectionX[Index]))));
+		const VectorRegister InAngle = VectorCompareGT(Dot, VectorMultiply(VectorLoad(&Batch.AngleCos[Index]), Distance));
+
+		VectorStoreAligned(VectorBitwiseAnd(InRange, InAngle), PassedMask);
+		for (int32 Lane = 0; Lane < 4; ++Lane)
+		{
+			OutInPie[Index + Lane] = PassedMask[Lane] != 0;
+		}
+	}
+}
+
+/** Traces line of sight from listener to target on the calling thread, the same way UAISense_Sight::Update does */
+static bool TraceLineOfSight(const UWorld& World, const FPerceptionListener& Listener, const AActor* TargetActor, const FVector& TargetLocation)
+{
+	static const FName NAME_AILineOfSight = FName(TEXT("AILineOfSight"));
+
+	FHitResult HitResult;
+	const bool bHit = World.LineTraceSingle(HitResult, Listener.CachedLocation, TargetLocation
+		, FCollisionQueryParams(NAME_AILineOfSight, true, Listener.Listener->GetBodyActor())
+		, FCollisionObjectQueryParams(ECC_WorldStatic));
+
+	return bHit == false || (HitResult.Actor.IsValid() && HitResult.Actor->IsOwnedBy(TargetActor));
+}
+
 //----------------------------------------------------------------------//
 // FAISightTarget
 //----------------------------------------------------------------------//
@@ -66,6 +158,7 @@ UAISense_Sight::UAISense_Sight(const FObjectInitializer& ObjectInitializer)
 	, HighImportanceQueryDistanceThreshold(300.f)
 	, MaxQueryImportance(60.f)
 	, SightLimitQueryImportance(10.f)
+	, MaxBatchedTracesPerTick(DefaultMaxBatchedTracesPerTick)
 {
 	if (HasAnyFlags(RF_ClassDefaultObject) == false)
 	{
@@ -91,6 +184,19 @@ void UAISense_Sight::PostInitProperties()
 	HighImportanceDistanceSquare = FMath::Square(HighImportanceQueryDistanceThreshold);
 }
 
+void UAISense_Sight::BeginDestroy()
+{
+	// chunk tasks of the batch can still be querying the physics scene
+	CancelPendingTraces();
+	Super::BeginDestroy();
+}
+
+void UAISense_Sight::CleanUp()
+{
+	CancelPendingTraces();
+	Super::CleanUp();
+}
+
 float UAISense_Sight::Update()
 {
 	static const FName NAME_AILineOfSight = FName(TEXT("AILineOfSight"));
@@ -113,104 +219,114 @@ float UAISense_Sight::Update()
 
 	AIPerception::FListenerMap& ListenersMap = *GetListeners();
 
-	FAISightQuery* SightQuery = SightQueryQueue.GetData();
-	for (int32 QueryIndex = 0; QueryIndex < SightQueryQueue.Num(); ++QueryIndex, ++SightQuery)
+	// results of the traces submitted by the previous update, also when batching was turned off since
+	ApplyPendingTraces(*World);
+
+	if (CVarAISightBatchedTraces.GetValueOnGameThread() != 0)
+	{
+		ProcessQueriesBatched(*World, InvalidQueries, InvalidTargets);
+	}
+	else
 	{
-		if (TracesCount < MaxTracesPerTick)
+		FAISightQuery* SightQuery = SightQueryQueue.GetData();
+		for (int32 QueryIndex = 0; QueryIndex < SightQueryQueue.Num(); ++QueryIndex, ++SightQuery)
 		{
-			FPerceptionListener& Listener = ListenersMap[SightQuery->ObserverId];
-			ensure(Listener.Listener.IsValid());
-			FAISightTarget& Target = ObservedTargets[SightQuery->TargetId];
-					
-			const bool bTargetValid = Target.Target.IsValid();
-			const bool bListenerValid = Listener.Listener.IsValid();
-
-			// @todo figure out what should we do if not valid
-			if (bTargetValid && bListenerValid)
+			if (TracesCount < MaxTracesPerTick)
 			{
-				AActor* TargetActor = Target.Target.Get();
-				const FVector TargetLocation = TargetActor->GetActorLocation();
-				const FDigestedSightProperties& PropDigest = DigestedProperties[SightQuery->ObserverId];
-				const float SightRadiusSq = SightQuery->bLastResult ? PropDigest.LoseSightRadiusSq : PropDigest.SightRadiusSq;
+				FPerceptionListener& Listener = ListenersMap[SightQuery->ObserverId];
+				ensure(Listener.Listener.IsValid());
+				FAISightTarget& Target = ObservedTargets[SightQuery->TargetId];
+					
+				const bool bTargetValid = Target.Target.IsValid();
+				const bool bListenerValid = Listener.Listener.IsValid();
 
-				if (CheckIsTargetInSightPie(Listener, PropDigest, TargetLocation, SightRadiusSq))
+				// @todo figure out what should we do if not valid
+				if (bTargetValid && bListenerValid)
 				{
-//					UE_VLOG_SEGMENT(Listener.Listener.Get()->GetOwner(), Listener.CachedLocation, TargetLocation, FColor::Green, TEXT("%s"), *(Target.TargetId.ToString()));
+					AActor* TargetActor = Target.Target.Get();
+					const FVector TargetLocation = TargetActor->GetActorLocation();
+					const FDigestedSightProperties& PropDigest = DigestedProperties[SightQuery->ObserverId];
+					const float SightRadiusSq = SightQuery->bLastResult ? PropDigest.LoseSightRadiusSq : PropDigest.SightRadiusSq;
 
-					FVector OutSeenLocation(0.f);
-					// do line checks
-					if (Target.SightTargetInterface != NULL)
+					if (CheckIsTargetInSightPie(Listener, PropDigest, TargetLocation, SightRadiusSq))
 					{
-						int32 NumberOfLoSChecksPerformed = 0;
-						if (Target.SightTargetInterface->CanBeSeenFrom(Listener.CachedLocation, OutSeenLocation, NumberOfLoSChecksPerformed, Listener.Listener->GetBodyActor()) == true)
+//						UE_VLOG_SEGMENT(Listener.Listener.Get()->GetOwner(), Listener.CachedLocation, TargetLocation, FColor::Green, TEXT("%s"), *(Target.TargetId.ToString()));
+
+						FVector OutSeenLocation(0.f);
+						// do line checks
+						if (Target.SightTargetInterface != NULL)
 						{
-							Listener.RegisterStimulus(TargetActor, FAIStimulus(*this, 1.f, OutSeenLocation, Listener.CachedLocation));
-							SightQuery->bLastResult = true;
+							int32 NumberOfLoSChecksPerformed = 0;
+							if (Target.SightTargetInterface->CanBeSeenFrom(Listener.CachedLocation, OutSeenLocation, NumberOfLoSChecksPerformed, Listener.Listener->GetBodyActor()) == true)
+							{
+								Listener.RegisterStimulus(TargetActor, FAIStimulus(*this, 1.f, OutSeenLocation, Listener.CachedLocation));
+								SightQuery->bLastResult = true;
+							}
+							else
+							{
+//								UE_VLOG_LOCATION(Listener.Listener.Get()->GetOwner(), TargetLocation, 25.f, FColor::Red, TEXT(""));
+								Listener.RegisterStimulus(TargetActor, FAIStimulus(*this, 0.f, TargetLocation, Listener.CachedLocation, FAIStimulus::SensingFailed));
+								SightQuery->bLastResult = false;
+							}
+
+							TracesCount += NumberOfLoSChecksPerformed;
 						}
 						else
 						{
-//							UE_VLOG_LOCATION(Listener.Listener.Get()->GetOwner(), TargetLocation, 25.f, FColor::Red, TEXT(""));
-							Listener.RegisterStimulus(TargetActor, FAIStimulus(*this, 0.f, TargetLocation, Listener.CachedLocation, FAIStimulus::SensingFailed));
-							SightQuery->bLastResult = false;
+							// we need to do tests ourselves
+							/*const bool bHit = World->LineTraceTest(Listener.CachedLocation, TargetLocation
+								, FCollisionQueryParams(NAME_AILineOfSight, true, Listener.Listener->GetBodyActor())
+								, FCollisionObjectQueryParams(ECC_WorldStatic));*/
+							FHitResult HitResult;
+							const bool bHit = World->LineTraceSingle(HitResult, Listener.CachedLocation, TargetLocation
+								, FCollisionQueryParams(NAME_AILineOfSight, true, Listener.Listener->GetBodyActor())
+								, FCollisionObjectQueryParams(ECC_WorldStatic));
+
+							++TracesCount;
+
+							if (bHit == false || (HitResult.Actor.IsValid() && HitResult.Actor->IsOwnedBy(TargetActor)))
+							{
+								Listener.RegisterStimulus(TargetActor, FAIStimulus(*this, 1.f, TargetLocation, Listener.CachedLocation));
+								SightQuery->bLastResult = true;
+							}
+							else
+							{
+//								UE_VLOG_LOCATION(Listener.Listener.Get()->GetOwner(), TargetLocation, 25.f, FColor::Red, TEXT(""));
+								Listener.RegisterStimulus(TargetActor, FAIStimulus(*this, 0.f, TargetLocation, Listener.CachedLocation, FAIStimulus::SensingFailed));
+								SightQuery->bLastResult = false;
+							}
 						}
-
-						TracesCount += NumberOfLoSChecksPerformed;
 					}
 					else
 					{
-						// we need to do tests ourselves
-						/*const bool bHit = World->LineTraceTest(Listener.CachedLocation, TargetLocation
-							, FCollisionQueryParams(NAME_AILineOfSight, true, Listener.Listener->GetBodyActor())
-							, FCollisionObjectQueryParams(ECC_WorldStatic));*/
-						FHitResult HitResult;
-						const bool bHit = World->LineTraceSingle(HitResult, Listener.CachedLocation, TargetLocation
-							, FCollisionQueryParams(NAME_AILineOfSight, true, Listener.Listener->GetBodyActor())
-							, FCollisionObjectQueryParams(ECC_WorldStatic));
-
-						++TracesCount;
-
-						if (bHit == false || (HitResult.Actor.IsValid() && HitResult.Actor->IsOwnedBy(TargetActor)))
-						{
-							Listener.RegisterStimulus(TargetActor, FAIStimulus(*this, 1.f, TargetLocation, Listener.CachedLocation));
-							SightQuery->bLastResult = true;
-						}
-						else
-						{
-//							UE_VLOG_LOCATION(Listener.Listener.Get()->GetOwner(), TargetLocation, 25.f, FColor::Red, TEXT(""));
-							Listener.RegisterStimulus(TargetActor, FAIStimulus(*this, 0.f, TargetLocation, Listener.CachedLocation, FAIStimulus::SensingFailed));
-							SightQuery->bLastResult = false;
-						}
+//						UE_VLOG_SEGMENT(Listener.Listener.Get()->GetOwner(), Listener.CachedLocation, TargetLocation, FColor::Red, TEXT("%s"), *(Target.TargetId.ToString()));
+						Listener.RegisterStimulus(TargetActor, FAIStimulus(*this, 0.f, TargetLocation, Listener.CachedLocation, FAIStimulus::SensingFailed));
+						SightQuery->bLastResult = false;
 					}
+
+					SightQuery->Importance = CalcQueryImportance(Listener, TargetLocation, SightRadiusSq);
+
+					// restart query
+					SightQuery->Age = 0.f;
 				}
 				else
 				{
-//					UE_VLOG_SEGMENT(Listener.Listener.Get()->GetOwner(), Listener.CachedLocation, TargetLocation, FColor::Red, TEXT("%s"), *(Target.TargetId.ToString()));
-					Listener.RegisterStimulus(TargetActor, FAIStimulus(*this, 0.f, TargetLocation, Listener.CachedLocation, FAIStimulus::SensingFailed));
-					SightQuery->bLastResult = false;
+					// put this index to "to be removed" array
+					InvalidQueries.Add(QueryIndex);
+					if (bTargetValid == false)
+					{
+						InvalidTargets.AddUnique(SightQuery->TargetId);
+					}
 				}
-
-				SightQuery->Importance = CalcQueryImportance(Listener, TargetLocation, SightRadiusSq);
-
-				// restart query
-				SightQuery->Age = 0.f;
 			}
 			else
 			{
-				// put this index to "to be removed" array
-				InvalidQueries.Add(QueryIndex);
-				if (bTargetValid == false)
-				{
-					InvalidTargets.AddUnique(SightQuery->TargetId);
-				}
+				// age unprocessed queries so that they can advance in the queue during next sort
+				SightQuery->Age += 1.f;
 			}
-		}
-		else
-		{
-			// age unprocessed queries so that they can advance in the queue during next sort
-			SightQuery->Age += 1.f;
-		}
 
-		SightQuery->RecalcScore();
+			SightQuery->RecalcScore();
+		}
 	}
 
 	if (InvalidQueries.Num() > 0)
@@ -243,6 +359,258 @@ float UAISense_Sight::Update()
 	return 0.f;
 }
 
+void UAISense_Sight::ApplyPendingTraces(const UWorld& World)
+{
+	if (SightTraceBatch.Num() == 0)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_AI_Sense_Sight_ApplyTraces);
+
+	// submitted by the previous update, normally done by now
+	SightTraceBatch.WaitForExecution();
+
+	AIPerception::FListenerMap& ListenersMap = *GetListeners();
+
+	FAISightQuery* SightQuery = SightQueryQueue.GetData();
+	for (int32 QueryIndex = 0; QueryIndex < SightQueryQueue.Num(); ++QueryIndex, ++SightQuery)
+	{
+		const int32 TraceIndex = SightQuery->PendingTraceIndex;
+		if (TraceIndex == INDEX_NONE)
+		{
+			continue;
+		}
+		SightQuery->PendingTraceIndex = INDEX_NONE;
+
+		FPerceptionListener* Listener = ListenersMap.Find(SightQuery->ObserverId);
+		FAISightTarget* Target = ObservedTargets.Find(SightQuery->TargetId);
+		if (Listener == NULL || !Listener->Listener.IsValid() || Target == NULL || !Target->Target.IsValid())
+		{
+			// removed by the next pass over the queue
+			continue;
+		}
+
+		AActor* TargetActor = Target->Target.Get();
+		const AActor* BodyActor = Listener->Listener->GetBodyActor();
+		const FVector TargetLocation = TargetActor->GetActorLocation();
+
+		// the batch can't ignore each listener's body, so the trace reports whichever end's actor it hit first
+		const AActor* TraceStartActor = SightQuery->bPendingTraceReversed ? TargetActor : BodyActor;
+		const AActor* TraceEndActor = SightQuery->bPendingTraceReversed ? BodyActor : TargetActor;
+		const FHitResult& HitResult = SightTraceBatch.GetHit(TraceIndex);
+		const AActor* HitActor = HitResult.Actor.Get();
+
+		bool bSeen = false;
+		if (HitResult.bBlockingHit == false || (HitActor && TraceEndActor && HitActor->IsOwnedBy(TraceEndActor)))
+		{
+			bSeen = true;
+		}
+		else if (HitActor && TraceStartActor && HitActor->IsOwnedBy(TraceStartActor))
+		{
+			// hit the actor the trace started in, nothing is known about the rest of the line
+			bSeen = TraceLineOfSight(World, *Listener, TargetActor, TargetLocation);
+		}
+
+		if (bSeen)
+		{
+			Listener->RegisterStimulus(TargetActor, FAIStimulus(*this, 1.f, TargetLocation, Listener->CachedLocation));
+		}
+		else
+		{
+			Listener->RegisterStimulus(TargetActor, FAIStimulus(*this, 0.f, TargetLocation, Listener->CachedLocation, FAIStimulus::SensingFailed));
+		}
+		SightQuery->bLastResult = bSeen;
+	}
+
+	SightTraceBatch.Reset();
+}
+
+void UAISense_Sight::CancelPendingTraces()
+{
+	if (SightTraceBatch.Num() == 0)
+	{
+		return;
+	}
+
+	SightTraceBatch.WaitForExecution();
+
+	for (FAISightQuery& SightQuery : SightQueryQueue)
+	{
+		SightQuery.PendingTraceIndex = INDEX_NONE;
+	}
+	SightTraceBatch.Reset();
+}
+
+void UAISense_Sight::ProcessQueriesBatched(const UWorld& World, TArray<int32>& InvalidQueries, TArray<FAISightTarget::FTargetId>& InvalidTargets)
+{
+	static const FName NAME_AILineOfSight = FName(TEXT("AILineOfSight"));
+
+	AIPerception::FListenerMap& ListenersMap = *GetListeners();
+	const int32 NumQueries = SightQueryQueue.Num();
+
+	// gather every query's listener and target, and cull them all by sight range and angle at once
+	TArray<FPerceptionListener*> QueryListeners;
+	TArray<AActor*> QueryTargets;
+	QueryListeners.SetNumUninitialized(NumQueries);
+	QueryTargets.SetNumUninitialized(NumQueries);
+
+	FSightPieBatch PieBatch;
+	PieBatch.Init(NumQueries);
+
+	for (int32 QueryIndex = 0; QueryIndex < NumQueries; ++QueryIndex)
+	{
+		const FAISightQuery& SightQuery = SightQueryQueue[QueryIndex];
+		FPerceptionListener& Listener = ListenersMap[SightQuery.ObserverId];
+		FAISightTarget& Target = ObservedTargets[SightQuery.TargetId];
+
+		const bool bTargetValid = Target.Target.IsValid();
+		const bool bListenerValid = Listener.Listener.IsValid();
+		if (bTargetValid && bListenerValid)
+		{
+			const FDigestedSightProperties& PropDigest = DigestedProperties[SightQuery.ObserverId];
+			const float SightRadiusSq = SightQuery.bLastResult ? PropDigest.LoseSightRadiusSq : PropDigest.SightRadiusSq;
+			QueryListeners[QueryIndex] = &Listener;
+			QueryTargets[QueryIndex] = Target.Target.Get();
+			PieBatch.Set(QueryIndex, Listener.CachedLocation, Listener.CachedDirection, QueryTargets[QueryIndex]->GetActorLocation(), SightRadiusSq, PropDigest.PeripheralVisionAngleCos);
+		}
+		else
+		{
+			// put this index to "to be removed" array
+			QueryListeners[QueryIndex] = NULL;
+			QueryTargets[QueryIndex] = NULL;
+			InvalidQueries.Add(QueryIndex);
+			if (bTargetValid == false)
+			{
+				InvalidTargets.AddUnique(SightQuery.TargetId);
+			}
+		}
+	}
+
+	TArray<uint8> InPie;
+	CheckTargetsInSightPies(PieBatch, InPie);
+
+	// traces don't ignore the listener's body, see ApplyPendingTraces
+	SightTraceBatch.Init(ECC_WorldStatic, FCollisionQueryParams(NAME_AILineOfSight, true), FCollisionResponseParams::DefaultResponseParam, FCollisionObjectQueryParams(ECC_WorldStatic));
+
+	// targets that are listeners themselves are traced to their eyes, so two listeners looking at each other trace the same line both ways
+	TMap<const AActor*, FVector> ListenerEyes;
+	for (AIPerception::FListenerMap::TConstIterator ItListener(ListenersMap); ItListener; ++ItListener)
+	{
+		const FPerceptionListener& Listener = ItListener->Value;
+		const AActor* BodyActor = Listener.Listener.IsValid() && Listener.HasSense(GetSenseID()) ? Listener.Listener->GetBodyActor() : NULL;
+		if (BodyActor)
+		{
+			ListenerEyes.Add(BodyActor, Listener.CachedLocation);
+		}
+	}
+
+	// eye to eye traces submitted between each pair of actors, to share them with the queries going the other way
+	TMap<uint64, int32> PairTraces;
+	TArray<FVector> TraceStarts;
+	TArray<FVector> TraceEnds;
+	int32 TracesCount = 0;
+
+	FAISightQuery* SightQuery = SightQueryQueue.GetData();
+	for (int32 QueryIndex = 0; QueryIndex < NumQueries; ++QueryIndex, ++SightQuery)
+	{
+		FPerceptionListener* Listener = QueryListeners[QueryIndex];
+		AActor* TargetActor = QueryTargets[QueryIndex];
+		if (Listener == NULL)
+		{
+			continue;
+		}
+
+		if (TracesCount >= MaxBatchedTracesPerTick)
+		{
+			// age unprocessed queries so that they can advance in the queue during next sort
+			SightQuery->Age += 1.f;
+			SightQuery->RecalcScore();
+			continue;
+		}
+
+		const FVector TargetLocation(PieBatch.TargetX[QueryIndex], PieBatch.TargetY[QueryIndex], PieBatch.TargetZ[QueryIndex]);
+
+		if (InPie[QueryIndex] == 0)
+		{
+			Listener->RegisterStimulus(TargetActor, FAIStimulus(*this, 0.f, TargetLocation, Listener->CachedLocation, FAIStimulus::SensingFailed));
+			SightQuery->bLastResult = false;
+		}
+		else if (IAISightTargetInterface* SightTargetInterface = ObservedTargets[SightQuery->TargetId].SightTargetInterface)
+		{
+			// the target does its own checks, on the game thread
+			FVector OutSeenLocation(0.f);
+			int32 NumberOfLoSChecksPerformed = 0;
+			if (SightTargetInterface->CanBeSeenFrom(Listener->CachedLocation, OutSeenLocation, NumberOfLoSChecksPerformed, Listener->Listener->GetBodyActor()) == true)
+			{
+				Listener->RegisterStimulus(TargetActor, FAIStimulus(*this, 1.f, OutSeenLocation, Listener->CachedLocation));
+				SightQuery->bLastResult = true;
+			}
+			else
+			{
+				Listener->RegisterStimulus(TargetActor, FAIStimulus(*this, 0.f, TargetLocation, Listener->CachedLocation, FAIStimulus::SensingFailed));
+				SightQuery->bLastResult = false;
+			}
+
+			TracesCount += NumberOfLoSChecksPerformed;
+		}
+		else
+		{
+			const AActor* BodyActor = Listener->Listener->GetBodyActor();
+			const FVector& ListenerLocation = Listener->CachedLocation;
+			const FVector* TargetEyes = ListenerEyes.Find(TargetActor);
+			const FVector TraceEnd = TargetEyes ? *TargetEyes : TargetLocation;
+
+			// a pair seeing each other shares one trace, if the reversed line has the same ends
+			uint64 PairKey = 0;
+			int32 TraceIndex = INDEX_NONE;
+			const bool bEyeToEye = BodyActor && TargetEyes;
+			if (bEyeToEye)
+			{
+				const uint32 BodyUniqueId = BodyActor->GetUniqueID();
+				const uint32 TargetUniqueId = TargetActor->GetUniqueID();
+				PairKey = (uint64(FMath::Min(BodyUniqueId, TargetUniqueId)) << 32) | uint64(FMath::Max(BodyUniqueId, TargetUniqueId));
+
+				const int32* PairTraceIndex = PairTraces.Find(PairKey);
+				if (PairTraceIndex && TraceEnds[*PairTraceIndex] == ListenerLocation && TraceStarts[*PairTraceIndex] == TraceEnd)
+				{
+					TraceIndex = *PairTraceIndex;
+					SightQuery->bPendingTraceReversed = true;
+					INC_DWORD_STAT(STAT_AI_Sense_Sight_SharedTraces);
+				}
+			}
+
+			if (TraceIndex == INDEX_NONE)
+			{
+				TraceIndex = SightTraceBatch.AddRaycast(ListenerLocation, TraceEnd);
+				TraceStarts.Add(ListenerLocation);
+				TraceEnds.Add(TraceEnd);
+				SightQuery->bPendingTraceReversed = false;
+				if (bEyeToEye)
+				{
+					PairTraces.Add(PairKey, TraceIndex);
+				}
+				++TracesCount;
+			}
+
+			// stimulus is registered by the next update, once the trace is done
+			SightQuery->PendingTraceIndex = TraceIndex;
+		}
+
+		SightQuery->Importance = CalcQueryImportance(*Listener, TargetLocation, PieBatch.RadiusSq[QueryIndex]);
+
+		// restart query
+		SightQuery->Age = 0.f;
+		SightQuery->RecalcScore();
+	}
+
+	if (SightTraceBatch.Num() > 0)
+	{
+		INC_DWORD_STAT_BY(STAT_AI_Sense_Sight_BatchedTraces, SightTraceBatch.Num());
+		SightTraceBatch.ExecuteAsync(&World);
+	}
+}
+
 void UAISense_Sight::RegisterEvent(const FAISightEvent& Event)
 {
 
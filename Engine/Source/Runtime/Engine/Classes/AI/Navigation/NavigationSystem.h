@@ -291,6 +291,7 @@ public:
 
 	// Begin UObject Interface
 	virtual void PostInitProperties() override;
+	virtual void BeginDestroy() override;
 	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
 #if WITH_EDITOR
 	virtual void PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent) override;
@@ -611,6 +612,9 @@ public:
 	/** Called upon UWorld destruction to release what needs to be released */
 	void CleanUp(ECleanupMode Mode = ECleanupMode::CleanupUnsafe);
 
+	/** Blocks until the worker tasks of dispatched async pathfinding requests are done reading navigation data. Game thread only */
+	void WaitForAsyncQueries();
+
 	/** 
 	 *	Called when owner-UWorld initializes actors
 	 */
@@ -692,6 +696,9 @@ protected:
 
 	TArray<FAsyncPathFindingQuery> AsyncPathFindingQueries;
 
+	/** worker tasks of dispatched async pathfinding requests that may still be running */
+	FGraphEventArray AsyncQueryChunkEvents;
+
 	FCriticalSection NavDataRegistration;
 
 	TMap<FNavAgentProperties, ANavigationData*> AgentToNavDataMap;
@@ -812,11 +819,14 @@ private:
 	/** Adds given request to requests queue. Note it's to be called only on game thread only */
 	void AddAsyncQuery(const FAsyncPathFindingQuery& Query);
 		 
-	/** spawns a non-game-thread task to process requests given in PathFindingQueries.
+	/** spawns non-game-thread tasks to process requests given in PathFindingQueries, split in chunks of ai.AsyncPathfindingChunkSize requests.
+	 *	Results are delivered on game thread, in request order, once all chunks are done.
 	 *	In the process PathFindingQueries gets copied. */
 	void TriggerAsyncQueries(TArray<FAsyncPathFindingQuery>& PathFindingQueries);
 
-	/** Processes pathfinding requests given in PathFindingQueries.*/
-	void PerformAsyncQueries(TArray<FAsyncPathFindingQuery> PathFindingQueries);
+	/** Processes a single pathfinding request, called from worker threads. */
+	void PerformAsyncQuery(FAsyncPathFindingQuery& Query);
+
+	friend class FAsyncPathFindingChunkTask;
 };
 
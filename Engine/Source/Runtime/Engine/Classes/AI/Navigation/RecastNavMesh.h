@@ -16,8 +16,9 @@
 #define NAVMESHVER_DYNAMIC_LINKS		7
 #define NAVMESHVER_64BIT				9
 #define NAVMESHVER_CLUSTER_SIMPLIFIED	10
+#define NAVMESHVER_COMPRESSED_TILES		11
 
-#define NAVMESHVER_LATEST				NAVMESHVER_CLUSTER_SIMPLIFIED
+#define NAVMESHVER_LATEST				NAVMESHVER_COMPRESSED_TILES
 #define NAVMESHVER_MIN_COMPATIBLE		NAVMESHVER_CLUSTER_SIMPLIFIED
 
 #define RECAST_MAX_SEARCH_NODES		2048
@@ -560,6 +561,27 @@ class ENGINE_API ARecastNavMesh : public ANavigationData
 	UPROPERTY(config)
 	uint32 bUseVirtualFilters : 1;
 
+	//----------------------------------------------------------------------//
+	// Tile streaming
+	//----------------------------------------------------------------------//
+
+	/** if set, static navmesh (not rebuilt at runtime) keeps only tiles around pawns and generation seeds attached in game,
+	 *	all other tiles are kept compressed in memory. Tiles get cooked compressed */
+	UPROPERTY(EditAnywhere, Category=Streaming, config)
+	uint32 bStreamTiles:1;
+
+	/** tiles within this distance (2D, in uu) from pawns and generation seeds are attached */
+	UPROPERTY(EditAnywhere, Category=Streaming, config, meta=(ClampMin = "0.0", editcondition = "bStreamTiles"))
+	float TileStreamingRadius;
+
+	/** limit of memory used by attached streamed tiles, closest tiles are attached first. 0 means no limit */
+	UPROPERTY(EditAnywhere, Category=Streaming, config, meta=(ClampMin = "0", editcondition = "bStreamTiles"))
+	int32 TileStreamingMemoryBudgetKB;
+
+	/** maximum number of tiles decompressed and attached in single streaming update */
+	UPROPERTY(EditAnywhere, Category=Streaming, config, AdvancedDisplay, meta=(ClampMin = "1", editcondition = "bStreamTiles"))
+	int32 MaxTilesStreamedInPerUpdate;
+
 private:
 	/** Cache rasterized voxels instead of just collision vertices/indices in navigation octree */
 	UPROPERTY(config)
@@ -641,6 +663,10 @@ public:
 #endif // WITH_EDITOR
 	// End UObject Interface
 
+	// Begin AActor Interface
+	virtual void BeginPlay() override;
+	// End AActor Interface
+
 #if WITH_EDITOR
 	/** RecastNavMesh instances are dynamically spawned and should not be coppied */
 	virtual bool ShouldExport() override { return false; }
@@ -669,12 +695,17 @@ public:
 
 	virtual void OnStreamingLevelAdded(ULevel* InLevel) override;
 	virtual void OnStreamingLevelRemoved(ULevel* InLevel) override;
+
+	virtual void TickAsyncBuild(float DeltaSeconds) override;
 	// End ANavigationData Interface
 
 protected:
 	/** Serialization helper. */
 	void SerializeRecastNavMesh(FArchive& Ar, FPImplRecastNavMesh*& NavMesh);
 
+	/** Attaches streamed tiles around pawns, viewers and generation seeds, at most MaxTilesToAttach (0 = no limit), and detaches all others */
+	void UpdateTileStreaming(int32 MaxTilesToAttach);
+
 public:
 	/** Whether NavMesh should adjust his tile pool size when NavBounds are changed */
 	bool IsResizable() const;
@@ -838,6 +869,8 @@ public:
 	
 	// @todo docuement
 	static FPathFindingResult FindPath(const FNavAgentProperties& AgentProperties, const FPathFindingQuery& Query);
+	/** Finds path through clusters on the way first (when cluster graph is built) and looks for polygon path only inside them */
+	static FPathFindingResult FindHierarchicalPath(const FNavAgentProperties& AgentProperties, const FPathFindingQuery& Query);
 	static bool TestPath(const FNavAgentProperties& AgentProperties, const FPathFindingQuery& Query, int32* NumVisitedNodes);
 	static bool TestHierarchicalPath(const FNavAgentProperties& AgentProperties, const FPathFindingQuery& Query, int32* NumVisitedNodes);
 	static bool NavMeshRaycast(const ANavigationData* Self, const FVector& RayStart, const FVector& RayEnd, FVector& HitLocation, TSharedPtr<const FNavigationQueryFilter> QueryFilter, const UObject* Querier, FRaycastResult& Result);
@@ -894,6 +927,9 @@ protected:
 private:
 	/** NavMesh versioning. */
 	uint32 NavMeshVersion;
+
+	/** time left until next tile streaming update, see TileSetUpdateInterval */
+	float TileStreamingTimeLeft;
 	
 	/** 
 	 * This is a pimpl-style arrangement used to tightly hide the Recast internals from the rest of the engine.
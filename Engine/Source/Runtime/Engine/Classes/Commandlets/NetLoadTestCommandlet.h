@@ -0,0 +1,82 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+#include "Commandlets/Commandlet.h"
+#include "NetLoadTestCommandlet.generated.h"
+
+/**
+ * Runs a dedicated server world with simulated clients connected over an in-memory transport (see ULoadTestNetDriver)
+ * and reports server tick time, bytes sent per connection and replication latency percentiles.
+ *
+ * Usage: NetLoadTest [-Map=<map>] [-Game=<game mode>] [-Clients=64] [-Duration=60] [-WarmUp=5] [-TickRate=30]
+ *                    [-Lag=<round trip ms>] [-NetSpeed=<bytes/s>] [-Movement=Idle|Circle|Random] [-Speed=400]
+ *                    [-Radius=500] [-Spacing=300] [-RPCRate=1] [-Seed=0] [-Report=<csv file>]
+ *
+ * Character pawns are driven by generated ServerMove calls, so the server pays for move validation and corrections
+ * like it would for real clients. Other pawns are placed directly.
+ *
+ * Time is simulated at a fixed tick rate, so the run doesn't depend on the speed of the machine.
+ */
+UCLASS()
+class UNetLoadTestCommandlet : public UCommandlet
+{
+	GENERATED_UCLASS_BODY()
+
+
+	// Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	// End UCommandlet Interface
+
+private:
+	/** Applies the scripted input of every simulated client, called from the driver's TickDispatch */
+	void SimulateClients(float DeltaSeconds);
+
+	/** Times location changes of every pawn as the server ran its moves, and samples replication latency for those replicated to a connection since */
+	void GatherReplicationLatency();
+
+	/** Driver the simulated clients are connected to */
+	class ULoadTestNetDriver* Driver;
+
+	/** Connection of each simulated client, NULL if the client failed to join */
+	TArray<class ULoadTestNetConnection*> Clients;
+
+	/** Point each client's movement pattern is centered on */
+	TArray<FVector> Anchors;
+
+	/** Current destination of each client, for the Random movement pattern */
+	TArray<FVector> Destinations;
+
+	/** Driver time at which each client sends its next reliable RPC */
+	TArray<float> NextRPCTimes;
+
+	/** Time stamp of the last move each client sent through ServerMove */
+	TArray<float> ClientTimeStamps;
+
+	/** Whether we already tried spawning a pawn for a client the game didn't spawn one for */
+	TArray<bool> SpawnedDefaultPawn;
+
+	/** Location each client's pawn had when its replication latency was last gathered */
+	TArray<FVector> PawnLocations;
+
+	/**
+	 * Driver time of the oldest location change of client P's pawn that hasn't been replicated to client C yet,
+	 * indexed by C * NumClients + P, negative if there is no pending change
+	 */
+	TArray<float> PendingChangeTimes;
+
+	/** Replication latency histogram, one bucket per millisecond, the last bucket collects everything slower */
+	TArray<uint64> LatencyHistogram;
+
+	/** Wall clock time spent simulating clients during the current frame, excluded from the server tick time */
+	double SimulationTime;
+
+	/** Scripted movement settings */
+	uint8 MovementPattern;
+	float MovementSpeed;
+	float MovementRadius;
+
+	/** Reliable client RPCs sent to each client per second */
+	float RPCRate;
+
+	FRandomStream RandomStream;
+};
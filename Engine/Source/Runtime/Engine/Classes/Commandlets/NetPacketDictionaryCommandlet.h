@@ -0,0 +1,21 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+#include "Commandlets/Commandlet.h"
+#include "NetPacketDictionaryCommandlet.generated.h"
+
+/**
+ * Trains a packet compression dictionary from packets captured with net.PacketCapture.
+ *
+ * Usage: NetPacketDictionary [-Captures=<directory>] [-Output=<file relative to the game directory>]
+ */
+UCLASS()
+class UNetPacketDictionaryCommandlet : public UCommandlet
+{
+	GENERATED_UCLASS_BODY()
+
+
+	// Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	// End UCommandlet Interface
+};
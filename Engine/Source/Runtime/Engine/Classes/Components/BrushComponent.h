@@ -39,10 +39,8 @@ class UBrushComponent : public UPrimitiveComponent
 
 protected:
 	
-	/** Calculate the new ComponentToWorld transform for this component.
-	Parent is optional and can be used for computing ComponentToWorld based on arbitrary USceneComponent.
-	If Parent is not passed in we use the component's AttachParent*/
-	virtual FTransform CalcNewComponentToWorld(const FTransform& NewRelativeTransform, const USceneComponent* Parent = NULL) const override;
+	/** Moves ComponentToWorld by the PrePivot */
+	virtual void AdjustNewComponentToWorld(FTransform& NewComponentToWorld) const override;
 	// End USceneComponent interface
 
 public:
@@ -1190,6 +1190,18 @@ protected:
 	/** Give the static mesh component recreate render state context access to Create/DestroyRenderState_Concurrent(). */
 	friend class FStaticMeshComponentRecreateRenderStateContext;
 
+	/** Give the overlap update batch access to the overlap query and update of UpdateOverlaps(). */
+	friend class FOverlapUpdateBatch;
+
+	/**
+	 * Updates overlap tracking state for this component only, not its children. See UpdateOverlaps().
+	 * @param OverlapQueryResults		If non-null, results of the overlap query of this component at its current location, already run by the caller.
+	 */
+	void UpdateOverlapsOfThisComponent(TArray<FOverlapInfo> const* PendingOverlaps, bool bDoNotifies, const TArray<FOverlapInfo>* OverlapsAtEndLocation, const TArray<struct FOverlapResult>* OverlapQueryResults);
+
+	/** Sets up the params of the overlap query run by UpdateOverlaps() */
+	void InitUpdateOverlapsQueryParams(struct FComponentQueryParams& Params) const;
+
 	// Begin USceneComponent Interface
 	virtual void OnUpdateTransform(bool bSkipPhysicsMove) override;
 
@@ -514,6 +514,7 @@ public:
 
 	// Begin ActorComponent interface
 	virtual void OnRegister() override;
+	virtual void OnUnregister() override;
 	virtual void UpdateComponentToWorld(bool bSkipPhysicsMove = false) override final;
 	virtual void DestroyComponent(bool bPromoteChildren = false) override;
 	virtual void OnComponentDestroyed() override;
@@ -579,6 +580,7 @@ private:
 	void EndScopedMovementUpdate(class FScopedMovementUpdate& ScopedUpdate);
 
 	friend class FScopedMovementUpdate;
+	friend class FSceneComponentTransformStore;
 
 public:
 
@@ -711,11 +713,21 @@ protected:
 
 	/** Calculate the new ComponentToWorld transform for this component.
 		Parent is optional and can be used for computing ComponentToWorld based on arbitrary USceneComponent.
-		If Parent is not passed in we use the component's AttachParent*/
-	virtual FTransform CalcNewComponentToWorld(const FTransform& NewRelativeTransform, const USceneComponent* Parent = NULL) const;
+		If Parent is not passed in we use the component's AttachParent.
+		Components customize the result with AdjustNewComponentToWorld. */
+	FTransform CalcNewComponentToWorld(const FTransform& NewRelativeTransform, const USceneComponent* Parent = NULL) const;
+
+	/**
+	 * Adjusts the ComponentToWorld computed from the relative transform and the parent, for components whose world transform isn't just
+	 * their relative transform applied to their parent's (such as brushes and their pivot). Must only depend on the component's own state.
+	 * The base version does nothing and overrides don't call it, which is how AdjustsComponentToWorld tells that a class overrides it.
+	 */
+	virtual void AdjustNewComponentToWorld(FTransform& NewComponentToWorld) const;
 
-	
 public:
+	/** @return true if this component overrides AdjustNewComponentToWorld; the world's transform store updates those the regular way */
+	bool AdjustsComponentToWorld() const;
+
 	/** Set the location and rotation of this component relative to its parent */
 	UFUNCTION(BlueprintCallable, Category="Utilities|Transformation", meta=(FriendlyName="SetRelativeLocationAndRotation"))
 	void K2_SetRelativeLocationAndRotation(FVector NewLocation, FRotator NewRotation, bool bSweep, FHitResult& SweepHitResult);
@@ -3,8 +3,40 @@
 //
 // Simulated network driver for recording and playing back game sessions.
 #pragma once
+#include "Net/DemoStreamer.h"
 #include "DemoNetDriver.generated.h"
 
+/** Entry in the checkpoint index that is written to the demo's meta data section when recording stops */
+struct FDemoCheckpoint
+{
+	/** Demo time (in game seconds) at which the checkpoint was taken */
+	float	Time;
+
+	/** Number of frames recorded before the checkpoint */
+	int32	FrameNum;
+
+	/** Offset of the checkpoint record in the stream */
+	int32	Offset;
+
+	FDemoCheckpoint() : Time( 0 ), FrameNum( 0 ), Offset( 0 ) {}
+
+	friend FArchive& operator << ( FArchive& Ar, FDemoCheckpoint& Checkpoint )
+	{
+		Ar << Checkpoint.Time;
+		Ar << Checkpoint.FrameNum;
+		Ar << Checkpoint.Offset;
+
+		return Ar;
+	}
+};
+
+/** Every record in the demo stream starts with one of these */
+enum EDemoRecordType
+{
+	DEMO_RECORD_Frame		= 0,	// float DeltaTime, packets, int32 0
+	DEMO_RECORD_Checkpoint	= 1,	// int32 Size, then Size bytes of packets, int32 0
+};
+
 UCLASS(transient, config=Engine)
 class UDemoNetDriver : public UNetDriver
 {
@@ -15,9 +47,24 @@ class UDemoNetDriver : public UNetDriver
 	/** Name of the file to read/write from */
 	FString				DemoFilename;
 
-	/** Handle to the archive that will read/write network packets */
+	/** Storage the demo is streamed to/from, see FDemoStreamerFactory */
+	TSharedPtr< IDemoStreamer > DemoStreamer;
+
+	/** Handle to the archive that will read/write network packets (owned by DemoStreamer) */
 	FArchive*			FileAr;
 
+	/** While a checkpoint is being recorded, the archive its packets are written to */
+	FArchive*			CheckpointAr;
+
+	/** Checkpoints taken while recording, or read from the demo's checkpoint index during playback */
+	TArray< FDemoCheckpoint > Checkpoints;
+
+	/** Demo time of the last checkpoint taken while recording */
+	float				LastCheckpointTime;
+
+	/** Offset of the first record in the stream, playback restarts from here when seeking before the first checkpoint */
+	int32				StreamStartOffset;
+
 	/** Current record/playback frame number */
 	int32				DemoFrameNum;
 
@@ -51,6 +98,10 @@ class UDemoNetDriver : public UNetDriver
 	UPROPERTY( config )
 	FString				DemoSpectatorClass;
 
+	/** Name of the streamer used to store demos, can be overridden with the DemoStreamer= URL option */
+	UPROPERTY( config )
+	FString				DemoStreamerName;
+
 	// Begin UNetDriver interface.
 	virtual bool InitBase( bool bInitAsClient, FNetworkNotify* InNotify, const FURL& URL, bool bReuseAddressAndPort, FString& Error ) override;
 	virtual void FinishDestroy() override;
@@ -78,9 +129,40 @@ class UDemoNetDriver : public UNetDriver
 
 	void TickDemoRecord( float DeltaSeconds );
 	bool ReadDemoFrame();
+
+	/** Feeds the packets of the current frame or checkpoint record to the server connection, up to the terminating zero count */
+	bool ReadDemoPackets();
+
+	/** Closes all actor channels on the playback connection so a checkpoint can be applied, see GotoTime */
+	void ResetPlaybackChannels();
+
 	void TickDemoPlayback( float DeltaSeconds );
 	void SpawnDemoRecSpectator( UNetConnection* Connection );
 	void ResetDemoState();
 
+	/** Records the full state of all replicated actors into a checkpoint record, used to seek during playback */
+	void SaveCheckpoint();
+
+	/**
+	 * Jumps playback to the given time, by restoring the nearest checkpoint before it and fast forwarding from there.
+	 *
+	 * @param TimeInSeconds	Demo time to go to, between 0 and the length of the demo
+	 * @param Error			Why playback wasn't moved, when returning false
+	 * @return true if playback was moved
+	 */
+	bool GotoTime( float TimeInSeconds, FString& Error );
+
+	/** Writes a checkpoint record holding CheckpointData (packets followed by a zero count) to Ar. Returns the offset of the record */
+	static int32 WriteCheckpointRecord( FArchive& Ar, TArray< uint8 >& CheckpointData );
+
+	/** Reads the header of the checkpoint record at the current position of Ar, leaving Ar at its packets. Returns false if there is no valid checkpoint record there */
+	static bool ReadCheckpointRecordHeader( FArchive& Ar );
+
+	/** Skips the checkpoint records starting at the current position of Ar, up to the next frame record or EndOffset */
+	static void SkipCheckpointRecords( FArchive& Ar, int32 EndOffset );
+
+	/** Returns the index of the last checkpoint taken at or before TimeInSeconds, INDEX_NONE if there is none */
+	static int32 FindCheckpointIndex( const TArray< FDemoCheckpoint >& InCheckpoints, float TimeInSeconds );
+
 	void StopDemo();
 };
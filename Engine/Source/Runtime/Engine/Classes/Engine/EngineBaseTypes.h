@@ -294,6 +294,11 @@ private:
 		check(0); // you cannot make this pure virtual in script because it wants to create constructors.
 		return FString(TEXT("invalid"));
 	}
+	/** Returns the actor this tick function updates, used to validate that ticks which may run on any thread only modify their own actor. NULL if the tick isn't tied to an actor. **/
+	virtual class AActor* GetTickedActor() const
+	{
+		return NULL;
+	}
 	
 	friend class FTickTaskSequencer;
 	friend class FTickTaskManager;
@@ -309,6 +314,38 @@ struct TStructOpsTypeTraits<FTickFunction> : public TStructOpsTypeTraitsBase
 	};
 };
 
+/**
+ * Validation of tick functions that run on any thread, enabled with tick.ParallelTicks 2.
+ * In that mode those ticks run on the game thread one at a time and any change they make to an object that isn't part of their own actor is reported.
+ * Code that modifies shared state calls CheckWrite, which is a single compare when validation is off.
+ **/
+struct ENGINE_API FParallelTickValidation
+{
+	/**
+	 * Reports the modification if a validated tick function is running and Object doesn't belong to its actor.
+	 * @param Object - object about to be modified; an actor, a subobject of an actor or some shared object such as the world
+	 * @param Operation - description of the modification for the report
+	 **/
+	static FORCEINLINE void CheckWrite(const UObject* Object, const TCHAR* Operation)
+	{
+		if (ValidatingActor != NULL)
+		{
+			ReportWrite(Object, Operation);
+		}
+	}
+
+private:
+	static void ReportWrite(const UObject* Object, const TCHAR* Operation);
+
+	/** Actor of the tick function that is being validated, only set on the game thread **/
+	static const class AActor* ValidatingActor;
+
+	/** Tick function that is being validated **/
+	static FTickFunction* ValidatingTickFunction;
+
+	friend class FTickTaskSequencer;
+};
+
 /** 
 * Tick function that calls AActor::TickActor
 **/
@@ -330,6 +367,8 @@ struct FActorTickFunction : public FTickFunction
 	ENGINE_API virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
 	/** Abstract function to describe this tick. Used to print messages about illegal cycles in the dependency graph **/
 	ENGINE_API virtual FString DiagnosticMessage();
+	/** Returns the actor this tick function updates **/
+	ENGINE_API virtual class AActor* GetTickedActor() const override;
 };
 
 template<>
@@ -362,6 +401,8 @@ struct FActorComponentTickFunction : public FTickFunction
 	ENGINE_API virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
 	/** Abstract function to describe this tick. Used to print messages about illegal cycles in the dependency graph **/
 	ENGINE_API virtual FString DiagnosticMessage();
+	/** Returns the actor this tick function updates **/
+	ENGINE_API virtual class AActor* GetTickedActor() const override;
 };
 
 
@@ -394,6 +435,8 @@ struct FPrimitiveComponentPostPhysicsTickFunction : public FTickFunction
 	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
 	/** Abstract function to describe this tick. Used to print messages about illegal cycles in the dependency graph **/
 	virtual FString DiagnosticMessage();
+	/** Returns the actor this tick function updates **/
+	virtual class AActor* GetTickedActor() const override;
 };
 
 template<>
@@ -0,0 +1,66 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+//
+// Simulated client connection used by the network load test harness.
+//
+
+#pragma once
+#include "LoadTestNetConnection.generated.h"
+
+/** Outgoing packet the simulated client hasn't acknowledged yet */
+struct FLoadTestPendingAck
+{
+	/** Packet id as it was serialized into the packet */
+	int32	PacketId;
+
+	/** Driver time at which the client's acknowledgment arrives back at the server */
+	float	AckTime;
+};
+
+/**
+ * Server side end of an in-memory connection to a simulated client.
+ *
+ * Nothing is ever decoded on the client side: outgoing packets are only counted, and the client answers them
+ * with real ack packets (after the driver's simulated lag) that go through the regular receive path,
+ * so reliability, saturation and timeouts behave like they do for a remote client.
+ */
+UCLASS(transient, config=Engine)
+class ULoadTestNetConnection : public UNetConnection
+{
+	GENERATED_UCLASS_BODY()
+
+	// Begin UNetConnection interface.
+	virtual void		InitConnection( class UNetDriver* InDriver, EConnectionState InState, const FURL& InURL, int32 InConnectionSpeed = 0 ) override;
+	virtual FString		LowLevelGetRemoteAddress( bool bAppendPort=false ) override;
+	virtual FString		LowLevelDescribe() override;
+	virtual void		LowLevelSend( void* Data, int32 Count ) override;
+	// End UNetConnection interface.
+
+	/** @return The load test driver object */
+	FORCEINLINE class ULoadTestNetDriver* GetDriver() { return (ULoadTestNetDriver*)Driver; }
+
+	/** Sends the client's acks for all packets it has received by now, or a keep alive if there's nothing to ack */
+	void TickSimulatedClient();
+
+	/** Total number of bytes sent to the client, after compression */
+	int64	TotalOutBytes;
+
+	/** Total number of packets sent to the client */
+	int32	TotalOutPackets;
+
+private:
+	/** Builds a client packet out of the given acks and feeds it to the connection */
+	void SendClientPacket( const TArray< int32 >& AckPacketIds, int32 FirstAck, int32 NumAcks );
+
+	/** Packets waiting to be acked by the client, oldest first */
+	TArray< FLoadTestPendingAck > PendingAcks;
+
+	/** Packet id of the next packet the client sends */
+	int32	ClientPacketId;
+
+	/** Driver time at which the client last sent a packet */
+	float	LastClientSendTime;
+
+	/** Scratch buffer used to read the header of compressed packets */
+	TArray< uint8 > HeaderBuffer;
+};
@@ -0,0 +1,52 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+//
+// In-memory server network driver for load testing replication with simulated clients.
+//
+
+#pragma once
+#include "LoadTestNetDriver.generated.h"
+
+/** Called every TickDispatch after the simulated clients' packets were received, to drive their input */
+DECLARE_MULTICAST_DELEGATE_OneParam( FOnLoadTestSimulateClients, float /*DeltaSeconds*/ );
+
+/**
+ * Server driver whose clients all live in the same process, see ULoadTestNetConnection.
+ * Used by the NetLoadTest commandlet to measure server replication cost without real client machines.
+ */
+UCLASS(transient, config=Engine)
+class ULoadTestNetDriver : public UNetDriver
+{
+	GENERATED_UCLASS_BODY()
+
+	/** Round trip time (in seconds) the simulated clients take to acknowledge packets */
+	float				SimulatedLag;
+
+	/** Wall clock time spent in the last ServerReplicateActors call, in seconds */
+	double				LastServerReplicateActorsTime;
+
+	/** Broadcast after incoming client packets have been processed, the time for scripted client input */
+	FOnLoadTestSimulateClients OnSimulateClients;
+
+	// Begin UNetDriver interface.
+	virtual bool IsAvailable() const override { return true; }
+	virtual bool InitBase( bool bInitAsClient, FNetworkNotify* InNotify, const FURL& URL, bool bReuseAddressAndPort, FString& Error ) override;
+	virtual bool InitConnect( FNetworkNotify* InNotify, const FURL& ConnectURL, FString& Error ) override;
+	virtual bool InitListen( FNetworkNotify* InNotify, FURL& ListenURL, bool bReuseAddressAndPort, FString& Error ) override;
+	virtual FString LowLevelGetNetworkNumber() override;
+	virtual void TickDispatch( float DeltaSeconds ) override;
+	virtual int32 ServerReplicateActors( float DeltaSeconds ) override;
+	virtual void ProcessRemoteFunction( class AActor* Actor, class UFunction* Function, void* Parameters, struct FOutParmRec* OutParms, struct FFrame* Stack, class UObject* SubObject = NULL ) override;
+	virtual bool IsNetResourceValid(void) override { return true; }
+	// End UNetDriver interface.
+
+	/**
+	 * Connects a new simulated client and logs it into the game, the same way a remote client's join request is handled.
+	 *
+	 * @param ClientURL		URL options the client joins with (name, etc.)
+	 * @param NetSpeed		Client net speed in bytes per second, 0 to use the configured internet speed
+	 * @param Error			Receives the reason if the client couldn't join
+	 * @return The new connection, or NULL if the game refused the client
+	 */
+	class ULoadTestNetConnection* AddSimulatedClient( const FURL& ClientURL, int32 NetSpeed, FString& Error );
+};
@@ -212,6 +212,9 @@ public:
 
 	// Packet.
 	FBitWriter		SendBuffer;				// Queued up bits waiting to send
+	TArray<uint8>	PacketCompressionBuffer;	// Scratch space for compressing outgoing packets, see UNetDriver::PacketCompressor
+	TArray<uint8>	PacketDecompressionBuffer;	// Scratch space for decompressing incoming packets
+	bool			bPacketCompressionEnabled;	// Whether outgoing packets are compressed, set once both sides agreed on the dictionary, see NegotiatePacketCompression
 	double			OutLagTime[256];		// For lag measuring.
 	int32			OutLagPacketId[256];	// For lag measuring.
 	int32			InPacketId;				// Full incoming packet index.
@@ -538,6 +541,14 @@ public:
 	/** This function validates that ClientMsgType is the next expected msg type. */
 	ENGINE_API bool IsClientMsgTypeValid( const uint8 ClientMsgType );
 
+	/**
+	 * Enables compression of outgoing packets if the remote side uses the same compression dictionary as our driver.
+	 * Called with the dictionary checksum the other side sent in NMT_Hello (server) or NMT_Welcome (client).
+	 *
+	 * @param RemoteChecksum	Checksum of the remote dictionary, 0 if compression is disabled over there
+	 */
+	ENGINE_API void NegotiatePacketCompression( uint32 RemoteChecksum );
+
 	/**
 	 * This function tracks the number of log calls per second for this client, 
 	 * and disconnects the client if it detects too many calls are made per second
@@ -151,6 +151,20 @@ public:
 	UPROPERTY(Config)
 	float ConnectionTimeout;
 
+	/** Compress packets with the dictionary in PacketCompressionDictionary. Both sides must use the same dictionary. */
+	UPROPERTY(Config)
+	uint32 bEnablePacketCompression:1;
+
+	/** Packet compression dictionary, relative to the game directory. Build one from captured traffic (net.PacketCapture) with the NetPacketDictionary commandlet. */
+	UPROPERTY(Config)
+	FString PacketCompressionDictionary;
+
+	/** Coder shared by all connections of this driver, only valid if packet compression is enabled and the dictionary loaded */
+	TSharedPtr< class FNetPacketCompressor > PacketCompressor;
+
+	/** Checksum of the loaded compression dictionary, exchanged during the handshake. 0 if packet compression is disabled */
+	ENGINE_API uint32 GetPacketCompressionChecksum() const;
+
 	/** Connection to the server (this net driver is a client) */
 	UPROPERTY()
 	class UNetConnection* ServerConnection;
@@ -208,6 +222,10 @@ public:
 	uint32						NetGUIDOutBytes;
 	/** Incoming rate of NetGUID Bunches */
 	uint32						NetGUIDInBytes;
+	/** Outgoing packets that were sent compressed */
+	uint32						OutCompressedPackets;
+	/** Outgoing bytes saved by packet compression */
+	uint32						OutCompressionSavedBytes;
 	/** todo document */
 	uint32						InPackets;
 	/** todo document */
@@ -46,6 +46,37 @@ public:
 	uint8						bIsBroken			: 1;	// If this object failed to load, then we set this to signify that we should stop trying
 };
 
+/** Pre-serialized path of a static NetGUID, shared by every connection with the same byte order that exports it */
+class FNetGUIDCachedExport
+{
+public:
+	FNetGUIDCachedExport()
+	{
+		NumBits[0] = 0;
+		NumBits[1] = 0;
+	}
+
+	TArray< uint8 >				Data[2];					// Object name (and package guid for packages), as written after the outer reference, indexed by whether the connection swaps bytes
+	int64						NumBits[2];					// 0 until the path was written in that byte order
+};
+
+/** 
+ * NetGUIDs of a level's replicated startup objects, see FNetGUIDCache::GatherLevelNetObjects.
+ * They are assigned as one consecutive range, so a client with the same content can map the whole level from the first NetGUID.
+ */
+class FNetLevelGUIDs
+{
+public:
+	FNetLevelGUIDs() : Checksum( 0 ), NumNetGUIDs( 0 )
+	{
+	}
+
+	TWeakObjectPtr< ULevel >	Level;
+	uint32						Checksum;					// Checksum of the objects' paths and classes
+	FNetworkGUID				FirstNetGUID;
+	int32						NumNetGUIDs;				// 0 if the objects couldn't be given consecutive NetGUIDs
+};
+
 class ENGINE_API FNetGUIDCache
 {
 public:
@@ -70,11 +101,18 @@ public:
 	void			GenerateFullNetGUIDPath_r( const FNetworkGUID& NetGUID, FString& FullPath ) const;
 
 	void			AsyncPackageCallback( const FName& PackageName, UPackage * Package );
+
+	static uint32			GatherLevelNetObjects( ULevel* Level, TArray< UObject* >& OutObjects );
+	const FNetLevelGUIDs *	GetOrAssignLevelNetGUIDs( ULevel* Level );
+	bool					RegisterLevelNetGUIDs_Client( ULevel* Level, const uint32 Checksum, const FNetworkGUID& FirstNetGUID, const int32 NumNetGUIDs );
 	
 	TMap< FNetworkGUID, FNetGuidCacheObject >		ObjectLookup;
 	TMap< TWeakObjectPtr< UObject >, FNetworkGUID >	NetGUIDLookup;
 	int32											UniqueNetIDs[2];
 
+	TMap< FNetworkGUID, FNetGUIDCachedExport >		CachedExports;		// Server only, paths of exported static NetGUIDs
+	TMap< FName, FNetLevelGUIDs >					LevelNetGUIDs;		// Server only, keyed by level package name
+
 	bool											IsExportingNetGUIDBunch;
 
 	UNetDriver *									Driver;
@@ -134,6 +172,15 @@ public:
 
 	void HandleUnAssignedObject( const UObject* Obj );
 
+	/** Server: tells the client which NetGUIDs the level's startup objects have, so it can skip their path exports */
+	void SendLevelNetGUIDs( ULevel* Level );
+
+	/** Client: maps the level's startup objects to the server's NetGUIDs if our copy of the level matches, and lets the server know */
+	void ReceiveLevelNetGUIDs( const FString& PackageName, const uint32 Checksum, const FNetworkGUID& FirstNetGUID, const int32 NumNetGUIDs );
+
+	/** Server: the client mapped a level's startup objects, so they are as good as acked */
+	void ReceivedLevelNetGUIDsAck( const FString& PackageName, const uint32 Checksum, const FNetworkGUID& FirstNetGUID );
+
 	static void	AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
 
 	virtual void NotifyStreamingLevelUnload(UObject* UnloadedLevel) override;
@@ -152,6 +199,7 @@ protected:
 	void	ExportNetGUIDHeader();
 
 	void			InternalWriteObject( FArchive& Ar, FNetworkGUID NetGUID, const UObject* Object, FString ObjectPathName, UObject* ObjectOuter );	
+	void			InternalWriteObjectPath( FArchive& Ar, FNetworkGUID NetGUID, const UObject* Object, FString ObjectPathName );
 	FNetworkGUID	InternalLoadObject( FArchive & Ar, UObject *& Object, int InternalLoadObjectRecursionCount );
 
 	virtual UObject* ResolvePathAndAssignNetGUID( const FNetworkGUID& NetGUID, const FString& PathName ) override;
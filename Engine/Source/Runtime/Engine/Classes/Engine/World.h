@@ -727,6 +727,9 @@ private:
 	/** Gameplay timers. */
 	class FTimerManager* TimerManager;
 
+	/** Flattened attachment hierarchies of the registered scene components. */
+	class FSceneComponentTransformStore* SceneComponentTransformStore;
+
 	/** Latent action manager. */
 	struct FLatentActionManager LatentActionManager;
 
@@ -2165,6 +2168,9 @@ private:
 	/** Utility function to handle Exec/Console Commands related to stopping demo playback */
 	bool HandleDemoStopCommand( const TCHAR* Cmd, FOutputDevice& Ar, UWorld* InWorld );
 
+	/** Utility function to handle Exec/Console Commands related to seeking during demo playback */
+	bool HandleDemoGotoCommand( const TCHAR* Cmd, FOutputDevice& Ar, UWorld* InWorld );
+
 public:
 
 	// Destroys the current demo net driver
@@ -2562,6 +2568,12 @@ public:
 		return *TimerManager;
 	}
 
+	/** Returns the scene component transform store of this world. */
+	inline FSceneComponentTransformStore* GetSceneComponentTransformStore() const
+	{
+		return SceneComponentTransformStore;
+	}
+
 	/** Returns LatentActionManager instance for this world. */
 	inline FLatentActionManager& GetLatentActionManager()
 	{
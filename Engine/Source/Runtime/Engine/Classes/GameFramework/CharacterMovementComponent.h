@@ -76,6 +76,38 @@ public:
 	void SetFromLineTrace(const FHitResult& InHit, const float InSweepFloorDist, const float InLineDist, const bool bIsWalkableFloor);
 };
 
+/**
+ * Last floor found by a floor sweep, along with the state it depends on.
+ * Used by UCharacterMovementComponent::FindFloor() to skip the sweep while the character stays in place on a static floor (see p.FloorCache).
+ */
+struct FCharacterFloorCache
+{
+	/** Floor found at CapsuleLocation */
+	FFindFloorResult FloorResult;
+
+	/** Component the floor belongs to, and its transform when the floor was found */
+	TWeakObjectPtr<UPrimitiveComponent> FloorComponent;
+	FVector FloorComponentLocation;
+	FQuat FloorComponentRotation;
+
+	/** Capsule that found the floor, with its location and scaled size; any change to its collision shape needs a new sweep */
+	TWeakObjectPtr<class UCapsuleComponent> Capsule;
+	FVector CapsuleLocation;
+	float CapsuleRadius;
+	float CapsuleHalfHeight;
+
+	/** Whether the character was moving on ground, which changes the distance the floor is searched at */
+	bool bMovingOnGround;
+
+	/** False if there's no cached floor */
+	bool bValid;
+
+	FCharacterFloorCache()
+		: bValid(false)
+	{
+	}
+};
+
 /** 
  * Tick function that calls UCharacterMovementComponent::PreClothTick
  **/
@@ -670,6 +702,9 @@ protected:
 	/** Flag set in pre-physics update to indicate that based movement should be updated post-physics */
 	uint32 bDeferUpdateBasedMovement : 1;
 
+	/** Last floor found by a sweep in FindFloor(), reused while the character doesn't move on a static floor */
+	FCharacterFloorCache FloorCache;
+
 	/** forced avoidance velocity, used when AvoidanceLockTimer is > 0 */
 	FVector AvoidanceLockVelocity;
 
@@ -1350,6 +1385,21 @@ protected:
 	 */
 	virtual void FindFloor(const FVector& CapsuleLocation, struct FFindFloorResult& OutFloorResult, bool bZeroDelta, const FHitResult* DownwardSweepResult = NULL) const;
 
+	/** Discard the floor cached by FindFloor(), so the next floor check does a sweep. */
+	void InvalidateFloorCache();
+
+	/** Return true if floors on this component can be cached: it is static and blocks the character. */
+	bool CanCacheFloorOn(const UPrimitiveComponent* FloorComponent) const;
+
+	/**
+	 * Get the cached floor if it is still valid for a capsule at the given location, adjusted to that location.
+	 * @return true if OutFloorResult was set from the cache.
+	 */
+	bool GetCachedFloor(const FVector& CapsuleLocation, FFindFloorResult& OutFloorResult) const;
+
+	/** Cache a floor found by a sweep at the given location, if the component it is on allows it. */
+	void SetCachedFloor(const FVector& CapsuleLocation, const FFindFloorResult& FloorResult);
+
 	/**
 	 * Compute distance to the floor from bottom sphere of capsule. This is the swept distance of the capsule to the first point impacted by the lower sphere.
 	 * SweepDistance MUST be greater than or equal to the line distance.
@@ -1567,6 +1617,18 @@ protected:
 	/** Call the appropriate replicated servermove() function to send a client player move to the server. */
 	virtual void CallServerMove(const class FSavedMove_Character* NewMove, const class FSavedMove_Character* OldMove);
 	
+	/**
+	 * On the server, queue a client move to be simulated by ProcessQueuedServerMoves() instead of simulating it right away.
+	 * Only used when the server batches moves (p.NetBatchServerMoves). ServerData.CurrentClientTimeStamp must already have been verified.
+	 */
+	virtual void QueueServerMove(class FNetworkPredictionData_Server_Character& ServerData, const struct FQueuedServerMove_Character& Move);
+
+	/**
+	 * On the server, simulate all queued client moves in one pass, merging consecutive moves with the same input, then check the client error of the last one.
+	 * Called once per frame from TickComponent, and before anything that depends on the result of the client's moves.
+	 */
+	virtual void ProcessQueuedServerMoves();
+
 	/** Have the server check if the client is outside an error tolerance, and set a client adjustment if so. ClientLoc will be a relative location if MovementBaseUtility::UseRelativePosition(ClientMovementBase) is true. */
 	virtual void ServerMoveHandleClientError(float TimeStamp, float DeltaTime, const FVector& Accel, const FVector& ClientLoc, UPrimitiveComponent* ClientMovementBase, FName ClientBaseBoneName, uint8 ClientMovementMode);
 
@@ -1929,6 +1991,38 @@ FORCEINLINE ACharacter* UCharacterMovementComponent::GetCharacterOwner() const
 	return CharacterOwner;
 }
 
+/** Client move received by the server and waiting to be simulated, when the server batches moves (p.NetBatchServerMoves). */
+struct FQueuedServerMove_Character
+{
+	/** Client TimeStamp of the move, the last one when moves were merged */
+	float TimeStamp;
+
+	/** Time to simulate */
+	float DeltaTime;
+
+	/** Client acceleration */
+	FVector Accel;
+
+	/** Client location after the move, FVector(1,2,3) if the client didn't send one (first part of a ServerMoveDual) */
+	FVector ClientLoc;
+
+	/** Client view rotation */
+	FRotator ViewRot;
+
+	/** Client movement base and bone, ClientLoc is relative to them if MovementBaseUtility::UseRelativeLocation() */
+	TWeakObjectPtr<UPrimitiveComponent> ClientMovementBase;
+	FName ClientBaseBoneName;
+
+	/** Compressed flags, see FSavedMove_Character */
+	uint8 MoveFlags;
+
+	/** Packed client movement mode */
+	uint8 ClientMovementMode;
+
+	/** True for a move recovered by ServerMoveOld, which has no view rotation and isn't checked for client error */
+	bool bOldMove;
+};
+
 class ENGINE_API FNetworkPredictionData_Server_Character : public FNetworkPredictionData_Server
 {
 public:
@@ -1945,6 +2039,9 @@ public:
 	// @TODO: don't duplicate between server and client data (though it's used by both)
 	float MaxResponseTime;
 
+	/** Client moves received since they were last simulated, oldest first. Only used when the server batches moves (p.NetBatchServerMoves). */
+	TArray<FQueuedServerMove_Character> QueuedMoves;
+
 	/** @return time delta to use for the current ServerMove() */
 	float GetServerMoveDeltaTime(float TimeStamp) const;
 };
@@ -0,0 +1,28 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+#include "GameFramework/CharacterMovementComponent.h"
+#include "CharacterMovementTestComponent.generated.h"
+
+/** Character movement that exposes its floor checks to automation tests, see CharacterMovementTests.cpp */
+UCLASS(NotBlueprintable, Transient)
+class UCharacterMovementTestComponent : public UCharacterMovementComponent
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+	using UCharacterMovementComponent::FindFloor;
+	using UCharacterMovementComponent::GetCachedFloor;
+
+	/** @return true if a floor found by a sweep is cached */
+	bool HasCachedFloor() const
+	{
+		return FloorCache.bValid;
+	}
+
+	/** @return location of the floor component when the cached floor was found */
+	FVector GetCachedFloorComponentLocation() const
+	{
+		return FloorCache.FloorComponentLocation;
+	}
+};
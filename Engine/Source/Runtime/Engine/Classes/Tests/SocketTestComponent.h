@@ -0,0 +1,25 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+#include "Components/SceneComponent.h"
+#include "SocketTestComponent.generated.h"
+
+/** Scene component with a single socket at a fixed offset, for attachment tests, see SceneComponentTransformStoreTests.cpp */
+UCLASS(NotBlueprintable, Transient)
+class USocketTestComponent : public USceneComponent
+{
+	GENERATED_UCLASS_BODY()
+
+	/** Name of the socket */
+	static const FName SocketName;
+
+	/** Transform of the socket relative to the component */
+	FTransform SocketRelativeTransform;
+
+	// Begin USceneComponent Interface
+	virtual FTransform GetSocketTransform(FName InSocketName, ERelativeTransformSpace TransformSpace = RTS_World) const override;
+	virtual bool DoesSocketExist(FName InSocketName) const override;
+	virtual bool HasAnySockets() const override;
+	virtual void QuerySupportedSockets(TArray<FComponentSocketDescription>& OutSockets) const override;
+	// End USceneComponent Interface
+};
@@ -87,9 +87,8 @@ void FNavigationOctree::AppendToNode(const FOctreeElementId& Id, INavRelevantInt
 void FNavigationOctree::UpdateNode(const FOctreeElementId& Id, const FBox& NewBounds)
 {
 	FNavigationOctreeElement ElementCopy = GetElementById(Id);
-	RemoveElement(Id);
 	ElementCopy.Bounds = NewBounds;
-	AddElement(ElementCopy);
+	RelocateElement(Id, ElementCopy);
 }
 
 void FNavigationOctree::RemoveNode(const FOctreeElementId& Id)
@@ -119,6 +118,7 @@ void FNavigationRelevantData::Shrink()
 {
 	CollisionData.Shrink();
 	VoxelData.Shrink();
+	ClippedGeometryData.Shrink();
 	Modifiers.Shrink();
 }
 
@@ -9,6 +9,7 @@
 
 #if WITH_RECAST
 #include "RecastNavMeshGenerator.h"
+#include "AI/Navigation/PImplRecastNavMesh.h"
 #endif // WITH_RECAST
 #if WITH_EDITOR
 #include "UnrealEd.h"
@@ -46,6 +47,18 @@ DECLARE_CYCLE_STAT(TEXT("Nav Tick: mark dirty"), STAT_Navigation_TickMarkDirty,
 DECLARE_CYCLE_STAT(TEXT("Nav Tick: async build"), STAT_Navigation_TickAsyncBuild, STATGROUP_Navigation);
 DECLARE_CYCLE_STAT(TEXT("Nav Tick: async pathfinding"), STAT_Navigation_TickAsyncPathfinding, STATGROUP_Navigation);
 DECLARE_CYCLE_STAT(TEXT("Debug NavOctree Time"), STAT_DebugNavOctree, STATGROUP_Navigation);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Async pathfinding batch size"), STAT_Navigation_AsyncPathfindingQueries, STATGROUP_Navigation);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Async pathfinding latency 50% (ms)"), STAT_Navigation_AsyncPathfindingLatency50, STATGROUP_Navigation);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Async pathfinding latency 90% (ms)"), STAT_Navigation_AsyncPathfindingLatency90, STATGROUP_Navigation);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Async pathfinding latency 99% (ms)"), STAT_Navigation_AsyncPathfindingLatency99, STATGROUP_Navigation);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Async pathfinding latency max (ms)"), STAT_Navigation_AsyncPathfindingLatencyMax, STATGROUP_Navigation);
+
+static TAutoConsoleVariable<int32> CVarAsyncPathfindingChunkSize(
+	TEXT("ai.AsyncPathfindingChunkSize"),
+	8,
+	TEXT("Number of async pathfinding requests processed by each worker task. Requests of a tick are split across tasks running in parallel.\n")
+	TEXT("0: process all requests of a tick in a single task"),
+	ECVF_Default);
 
 //----------------------------------------------------------------------//
 // Stats
@@ -55,6 +68,7 @@ DEFINE_STAT(STAT_Navigation_QueriesTimeSync);
 DEFINE_STAT(STAT_Navigation_RequestingAsyncPathfinding);
 DEFINE_STAT(STAT_Navigation_PathfindingSync);
 DEFINE_STAT(STAT_Navigation_PathfindingAsync);
+DEFINE_STAT(STAT_Navigation_RecastFindClusterPath);
 DEFINE_STAT(STAT_Navigation_AddGeneratedTiles);
 DEFINE_STAT(STAT_Navigation_TileNavAreaSorting);
 DEFINE_STAT(STAT_Navigation_TileGeometryExportToObjAsync);
@@ -76,6 +90,9 @@ DEFINE_STAT(STAT_Navigation_UpdateNavOctree);
 DEFINE_STAT(STAT_Navigation_CollisionTreeMemory);
 DEFINE_STAT(STAT_Navigation_NavDataMemory);
 DEFINE_STAT(STAT_Navigation_TileCacheMemory);
+DEFINE_STAT(STAT_Navigation_TileStreaming);
+DEFINE_STAT(STAT_Navigation_StreamedTilesMemory);
+DEFINE_STAT(STAT_Navigation_StreamedTilesAttached);
 DEFINE_STAT(STAT_Navigation_OutOfNodesPath);
 DEFINE_STAT(STAT_Navigation_PartialPath);
 DEFINE_STAT(STAT_Navigation_CumulativeBuildTime);
@@ -335,6 +352,14 @@ void UNavigationSystem::SetSupportedAgentsNavigationClass(int32 AgentIndex, TSub
 #endif // WITH_EDITOR
 }
 
+void UNavigationSystem::BeginDestroy()
+{
+	// running async pathfinding tasks point at this navigation system
+	WaitForAsyncQueries();
+
+	Super::BeginDestroy();
+}
+
 void UNavigationSystem::PostInitProperties()
 {
 	Super::PostInitProperties();
@@ -851,66 +876,159 @@ void UNavigationSystem::AbortAsyncFindPathRequest(uint32 AsynPathQueryID)
 	}
 }
 
-void UNavigationSystem::TriggerAsyncQueries(TArray<FAsyncPathFindingQuery>& PathFindingQueries)
+/** Async pathfinding requests of one navigation system tick, shared by the tasks processing them */
+struct FAsyncPathFindingBatch
 {
-	DECLARE_CYCLE_STAT(TEXT("FSimpleDelegateGraphTask.NavigationSystem batched async queries"),
-		STAT_FSimpleDelegateGraphTask_NavigationSystemBatchedAsyncQueries,
-		STATGROUP_TaskGraphTasks);
+	TArray<FAsyncPathFindingQuery> Queries;
 
-	FSimpleDelegateGraphTask::CreateAndDispatchWhenReady(
-		FSimpleDelegateGraphTask::FDelegate::CreateUObject(this, &UNavigationSystem::PerformAsyncQueries, PathFindingQueries),
-		GET_STATID(STAT_FSimpleDelegateGraphTask_NavigationSystemBatchedAsyncQueries));
-}
+	/** seconds from the batch being dispatched to each request's result being ready */
+	TArray<float> Latencies;
+
+	double DispatchTime;
+};
 
-static void AsyncQueryDone(FAsyncPathFindingQuery Query)
+typedef TSharedRef<FAsyncPathFindingBatch, ESPMode::ThreadSafe> FAsyncPathFindingBatchRef;
+
+/** Processes a chunk of an async pathfinding batch on a worker thread */
+class FAsyncPathFindingChunkTask
 {
-	Query.OnDoneDelegate.ExecuteIfBound(Query.QueryID, Query.Result.Result, Query.Result.Path);
+	/** waits for its chunks before being cleaned up or destroyed, see UNavigationSystem::WaitForAsyncQueries */
+	UNavigationSystem* NavSys;
+	FAsyncPathFindingBatchRef Batch;
+	int32 FirstQuery;
+	int32 NumQueries;
+
+public:
+	FAsyncPathFindingChunkTask(UNavigationSystem* InNavSys, const FAsyncPathFindingBatchRef& InBatch, int32 InFirstQuery, int32 InNumQueries)
+		: NavSys(InNavSys)
+		, Batch(InBatch)
+		, FirstQuery(InFirstQuery)
+		, NumQueries(InNumQueries)
+	{
+	}
+
+	FORCEINLINE TStatId GetStatId() const
+	{
+		RETURN_QUICK_DECLARE_CYCLE_STAT(FAsyncPathFindingChunkTask, STATGROUP_TaskGraphTasks);
+	}
+	static ENamedThreads::Type GetDesiredThread()
+	{
+		return ENamedThreads::AnyThread;
+	}
+	static ESubsequentsMode::Type GetSubsequentsMode()
+	{
+		return ESubsequentsMode::TrackSubsequents;
+	}
+	void DoTask(ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_Navigation_PathfindingAsync);
+
+#if WITH_RECAST
+		// all requests of the chunk share one navmesh query and node pool
+		FRecastNavMeshQueryContext NavQueryContext;
+#endif // WITH_RECAST
+
+		for (int32 QueryIndex = FirstQuery; QueryIndex < FirstQuery + NumQueries; ++QueryIndex)
+		{
+			NavSys->PerformAsyncQuery(Batch->Queries[QueryIndex]);
+			Batch->Latencies[QueryIndex] = float(FPlatformTime::Seconds() - Batch->DispatchTime);
+		}
+	}
+};
+
+static void AsyncQueriesDone(FAsyncPathFindingBatchRef Batch)
+{
+	const int32 QueriesCount = Batch->Queries.Num();
+
+#if STATS
+	TArray<float> SortedLatencies = Batch->Latencies;
+	SortedLatencies.Sort();
+	SET_DWORD_STAT(STAT_Navigation_AsyncPathfindingQueries, QueriesCount);
+	SET_FLOAT_STAT(STAT_Navigation_AsyncPathfindingLatency50, SortedLatencies[(QueriesCount - 1) * 50 / 100] * 1000.f);
+	SET_FLOAT_STAT(STAT_Navigation_AsyncPathfindingLatency90, SortedLatencies[(QueriesCount - 1) * 90 / 100] * 1000.f);
+	SET_FLOAT_STAT(STAT_Navigation_AsyncPathfindingLatency99, SortedLatencies[(QueriesCount - 1) * 99 / 100] * 1000.f);
+	SET_FLOAT_STAT(STAT_Navigation_AsyncPathfindingLatencyMax, SortedLatencies.Last() * 1000.f);
+#endif // STATS
+
+	// @todo make it return more informative results (bResult == false)
+	// delegates are called on main thread - otherwise it may depend too much on stuff being thread safe
+	for (int32 QueryIndex = 0; QueryIndex < QueriesCount; ++QueryIndex)
+	{
+		const FAsyncPathFindingQuery& Query = Batch->Queries[QueryIndex];
+		Query.OnDoneDelegate.ExecuteIfBound(Query.QueryID, Query.Result.Result, Query.Result.Path);
+	}
 }
 
-void UNavigationSystem::PerformAsyncQueries(TArray<FAsyncPathFindingQuery> PathFindingQueries)
+void UNavigationSystem::TriggerAsyncQueries(TArray<FAsyncPathFindingQuery>& PathFindingQueries)
 {
-	SCOPE_CYCLE_COUNTER(STAT_Navigation_PathfindingAsync);
+	DECLARE_CYCLE_STAT(TEXT("FSimpleDelegateGraphTask.Async nav queries finished"),
+		STAT_FSimpleDelegateGraphTask_AsyncNavQueriesFinished,
+		STATGROUP_TaskGraphTasks);
 
-	if (PathFindingQueries.Num() == 0)
+	const int32 QueriesCount = PathFindingQueries.Num();
+	if (QueriesCount == 0)
 	{
 		return;
 	}
-	
-	const int32 QueriesCount = PathFindingQueries.Num();
-	FAsyncPathFindingQuery* Query = PathFindingQueries.GetData();
 
-	for (int32 QueryIndex = 0; QueryIndex < QueriesCount; ++QueryIndex, ++Query)
+	FAsyncPathFindingBatchRef Batch = MakeShareable(new FAsyncPathFindingBatch);
+	Batch->Queries = PathFindingQueries;
+	Batch->Latencies.AddZeroed(QueriesCount);
+	Batch->DispatchTime = FPlatformTime::Seconds();
+
+	const int32 ChunkSize = CVarAsyncPathfindingChunkSize.GetValueOnGameThread() > 0 ? CVarAsyncPathfindingChunkSize.GetValueOnGameThread() : QueriesCount;
+	FGraphEventArray ChunkEvents;
+	for (int32 FirstQuery = 0; FirstQuery < QueriesCount; FirstQuery += ChunkSize)
 	{
-		// @todo this is not necessarily the safest way to use UObjects outside of main thread. 
-		//	think about something else.
-		const ANavigationData* NavData = Query->NavData.IsValid() ? Query->NavData.Get() : GetMainNavData(FNavigationSystem::DontCreate);
+		ChunkEvents.Add(TGraphTask<FAsyncPathFindingChunkTask>::CreateTask().ConstructAndDispatchWhenReady(this, Batch, FirstQuery, FMath::Min(ChunkSize, QueriesCount - FirstQuery)));
+	}
 
-		// perform query
-		if (NavData)
+	// chunks use this navigation system and its navigation data, remember them so both outlive the running ones
+	for (int32 EventIndex = AsyncQueryChunkEvents.Num() - 1; EventIndex >= 0; --EventIndex)
+	{
+		if (AsyncQueryChunkEvents[EventIndex]->IsComplete())
 		{
-			if (Query->Mode == EPathFindingMode::Hierarchical)
-			{
-				Query->Result = NavData->FindHierarchicalPath(FNavAgentProperties(), *Query);
-			}
-			else
-			{
-				Query->Result = NavData->FindPath(FNavAgentProperties(), *Query);
-			}
+			AsyncQueryChunkEvents.RemoveAtSwap(EventIndex);
+		}
+	}
+	AsyncQueryChunkEvents.Append(ChunkEvents);
+
+	FSimpleDelegateGraphTask::CreateAndDispatchWhenReady(
+		FSimpleDelegateGraphTask::FDelegate::CreateStatic(AsyncQueriesDone, Batch),
+		GET_STATID(STAT_FSimpleDelegateGraphTask_AsyncNavQueriesFinished), &ChunkEvents, ENamedThreads::GameThread);
+}
+
+void UNavigationSystem::WaitForAsyncQueries()
+{
+	check(IsInGameThread());
+	if (AsyncQueryChunkEvents.Num() > 0)
+	{
+		FTaskGraphInterface::Get().WaitUntilTasksComplete(AsyncQueryChunkEvents, ENamedThreads::GameThread);
+		AsyncQueryChunkEvents.Reset();
+	}
+}
+
+void UNavigationSystem::PerformAsyncQuery(FAsyncPathFindingQuery& Query)
+{
+	// @todo this is not necessarily the safest way to use UObjects outside of main thread. 
+	//	think about something else.
+	const ANavigationData* NavData = Query.NavData.IsValid() ? Query.NavData.Get() : GetMainNavData(FNavigationSystem::DontCreate);
+
+	// perform query
+	if (NavData)
+	{
+		if (Query.Mode == EPathFindingMode::Hierarchical)
+		{
+			Query.Result = NavData->FindHierarchicalPath(FNavAgentProperties(), Query);
 		}
 		else
 		{
-			Query->Result = ENavigationQueryResult::Error;
+			Query.Result = NavData->FindPath(FNavAgentProperties(), Query);
 		}
-
-		// @todo make it return more informative results (bResult == false)
-		// trigger calling delegate on main thread - otherwise it may depend too much on stuff being thread safe
-		DECLARE_CYCLE_STAT(TEXT("FSimpleDelegateGraphTask.Async nav query finished"),
-			STAT_FSimpleDelegateGraphTask_AsyncNavQueryFinished,
-			STATGROUP_TaskGraphTasks);
-
-		FSimpleDelegateGraphTask::CreateAndDispatchWhenReady(
-			FSimpleDelegateGraphTask::FDelegate::CreateStatic(AsyncQueryDone, *Query),
-			GET_STATID(STAT_FSimpleDelegateGraphTask_AsyncNavQueryFinished), NULL, ENamedThreads::GameThread);
+	}
+	else
+	{
+		Query.Result = ENavigationQueryResult::Error;
 	}
 }
 
@@ -3184,6 +3302,9 @@ void UNavigationSystem::CleanUp(ECleanupMode Mode)
 	}
 #endif // WITH_EDITOR
 
+	// async pathfinding tasks still read the navigation data being released
+	WaitForAsyncQueries();
+
 	FCoreUObjectDelegates::PostLoadMap.RemoveAll(this);
 	UNavigationSystem::NavigationDirtyEvent.RemoveAll(this);
 	FWorldDelegates::LevelAddedToWorld.RemoveAll(this);
@@ -34,13 +34,13 @@ static_assert(RECAST_UNWALKABLE_POLY_COST == DT_UNWALKABLE_POLY_COST, "Unwalkabl
 
 /// Helper for accessing navigation query from different threads
 #define INITIALIZE_NAVQUERY_SIMPLE(NavQueryVariable, NumNodes)	\
-	dtNavMeshQuery NavQueryVariable##Private;	\
-	dtNavMeshQuery& NavQueryVariable = IsInGameThread() ? SharedNavQuery : NavQueryVariable##Private; \
+	FRecastNavMeshQueryContext::FScopedNavQuery NavQueryVariable##Scope(SharedNavQuery);	\
+	dtNavMeshQuery& NavQueryVariable = NavQueryVariable##Scope.Get(); \
 	NavQueryVariable.init(DetourNavMesh, NumNodes);
 
 #define INITIALIZE_NAVQUERY(NavQueryVariable, NumNodes, LinkFilter)	\
-	dtNavMeshQuery NavQueryVariable##Private;	\
-	dtNavMeshQuery& NavQueryVariable = IsInGameThread() ? SharedNavQuery : NavQueryVariable##Private; \
+	FRecastNavMeshQueryContext::FScopedNavQuery NavQueryVariable##Scope(SharedNavQuery);	\
+	dtNavMeshQuery& NavQueryVariable = NavQueryVariable##Scope.Get(); \
 	NavQueryVariable.init(DetourNavMesh, NumNodes, &LinkFilter);
 
 static void* DetourMalloc(int Size, dtAllocHint)
@@ -233,12 +233,76 @@ bool FRecastSpeciaLinkFilter::isLinkAllowed(const int32 UserId) const
 
 
 //----------------------------------------------------------------------//
-// FPImplRecastNavMesh
+// FRecastNavMeshQueryContext
 //----------------------------------------------------------------------//
+uint32 FRecastNavMeshQueryContext::TlsSlot = FPlatformTLS::AllocTlsSlot();
+
+int32 FRecastNavMeshQueryContext::GameThreadDepth = 0;
+
+FRecastNavMeshQueryContext::FRecastNavMeshQueryContext()
+	: Depth(0)
+	, PreviousContext((FRecastNavMeshQueryContext*)FPlatformTLS::GetTlsValue(TlsSlot))
+{
+	// Workers can end up running on the game thread (e.g. with -nothreading), queries there keep using SharedNavQuery
+	// and never look the context up, so it's harmless to have one in scope.
+	FPlatformTLS::SetTlsValue(TlsSlot, this);
+}
+
+FRecastNavMeshQueryContext::~FRecastNavMeshQueryContext()
+{
+	check(FPlatformTLS::GetTlsValue(TlsSlot) == this);
+	check(Depth == 0);
+	FPlatformTLS::SetTlsValue(TlsSlot, PreviousContext);
+}
+
+FRecastNavMeshQueryContext::FScopedNavQuery::FScopedNavQuery(dtNavMeshQuery& GameThreadQuery)
+	: NavQuery(&PrivateQuery)
+	, Context(NULL)
+{
+	if (IsInGameThread())
+	{
+		if (GameThreadDepth == 0)
+		{
+			NavQuery = &GameThreadQuery;
+		}
+		GameThreadDepth++;
+	}
+	else
+	{
+		Context = (FRecastNavMeshQueryContext*)FPlatformTLS::GetTlsValue(TlsSlot);
+		if (Context)
+		{
+			if (Context->NavQueries.Num() <= Context->Depth)
+			{
+				Context->NavQueries.Add(new dtNavMeshQuery());
+			}
+			NavQuery = &Context->NavQueries[Context->Depth];
+			Context->Depth++;
+		}
+	}
+}
+
+FRecastNavMeshQueryContext::FScopedNavQuery::~FScopedNavQuery()
+{
+	if (Context)
+	{
+		Context->Depth--;
+	}
+	else if (IsInGameThread())
+	{
+		GameThreadDepth--;
+	}
+}
 
+//----------------------------------------------------------------------//
+// FPImplRecastNavMesh
+//----------------------------------------------------------------------//
 FPImplRecastNavMesh::FPImplRecastNavMesh(ARecastNavMesh* Owner)
 	: NavMeshOwner(Owner)
 	, DetourNavMesh(NULL)
+	, TileStreamingStamp(0)
+	, AttachedStreamedTilesSize(0)
+	, StreamedTilesCompressedSize(0)
 {
 	check(Owner && "Owner must never be NULL");
 
@@ -255,6 +319,9 @@ FPImplRecastNavMesh::~FPImplRecastNavMesh()
 
 void FPImplRecastNavMesh::ReleaseDetourNavMesh()
 {
+	ReleaseStreamedTiles();
+	LoadedTileRefs.Reset();
+
 	// release navmesh only if we own it
 	if (DetourNavMesh != nullptr)
 	{
@@ -268,7 +335,7 @@ void FPImplRecastNavMesh::ReleaseDetourNavMesh()
  * @param Ar - The archive with which to serialize.
  * @returns true if serialization was successful.
  */
-void FPImplRecastNavMesh::Serialize( FArchive& Ar )
+void FPImplRecastNavMesh::Serialize( FArchive& Ar, uint32 NavMeshVersion )
 {
 	//@todo: How to handle loading nav meshes saved w/ recast when recast isn't present????
 
@@ -331,6 +398,18 @@ void FPImplRecastNavMesh::Serialize( FArchive& Ar )
 	Ar << Params.maxTiles;				///< The maximum number of tiles the navigation mesh can contain.
 	Ar << Params.maxPolys;
 
+	// static navmeshes streaming their tiles are cooked with tiles already compressed
+	const bool bWantsTileStreaming = NavMeshOwner->bStreamTiles && !NavMeshOwner->bRebuildAtRuntime;
+	bool bCompressedTiles = false;
+	if (NavMeshVersion >= NAVMESHVER_COMPRESSED_TILES)
+	{
+		if (Ar.IsSaving())
+		{
+			bCompressedTiles = Ar.IsCooking() && bWantsTileStreaming;
+		}
+		Ar << bCompressedTiles;
+	}
+
 	if (Ar.IsLoading())
 	{
 		// at this point we can tell whether navmesh being loaded is in line
@@ -345,6 +424,13 @@ void FPImplRecastNavMesh::Serialize( FArchive& Ar )
 
 			for (int i = 0; i < NumTiles; ++i)
 			{
+				if (bCompressedTiles)
+				{
+					FStreamedTile StreamedTile;
+					Ar << StreamedTile;
+					continue;
+				}
+
 				dtTileRef TileRef = MAX_uint64;
 				int32 TileDataSize = 0;
 				Ar << TileRef << TileDataSize;
@@ -375,6 +461,23 @@ void FPImplRecastNavMesh::Serialize( FArchive& Ar )
 
 			for (int i = 0; i < NumTiles; ++i)
 			{
+				if (bCompressedTiles)
+				{
+					FStreamedTile StreamedTile;
+					Ar << StreamedTile;
+
+					// keep it compressed until someone gets close, unless streaming got disabled since cooking
+					if (bWantsTileStreaming)
+					{
+						AddStreamedTile(StreamedTile);
+					}
+					else
+					{
+						AttachStreamedTile(StreamedTile);
+					}
+					continue;
+				}
+
 				dtTileRef TileRef = MAX_uint64;
 				int32 TileDataSize = 0;
 				Ar << TileRef << TileDataSize;
@@ -391,7 +494,12 @@ void FPImplRecastNavMesh::Serialize( FArchive& Ar )
 				if (TileData != NULL)
 				{
 					dtMeshHeader* const TileHeader = (dtMeshHeader*)TileData;
-					DetourNavMesh->addTile(TileData, TileDataSize, DT_TILE_FREE_DATA, TileRef, NULL);
+					dtTileRef ResultTileRef = 0;
+					const dtStatus Status = DetourNavMesh->addTile(TileData, TileDataSize, DT_TILE_FREE_DATA, TileRef, &ResultTileRef);
+					if (bWantsTileStreaming && dtStatusSucceed(Status))
+					{
+						LoadedTileRefs.Add(ResultTileRef);
+					}
 				}
 			}
 		}
@@ -403,6 +511,14 @@ void FPImplRecastNavMesh::Serialize( FArchive& Ar )
 		{
 			const dtMeshTile* Tile = ConstNavMesh->getTile(TileIndex);
 			dtTileRef TileRef = ConstNavMesh->getTileRef(Tile);
+			if (bCompressedTiles)
+			{
+				FStreamedTile StreamedTile;
+				CompressStreamedTile(Tile, TileRef, Ar.ForceByteSwapping(), StreamedTile);
+				Ar << StreamedTile;
+				continue;
+			}
+
 			int32 TileDataSize = Tile->dataSize;
 			Ar << TileRef << TileDataSize;
 
@@ -624,6 +740,300 @@ void FPImplRecastNavMesh::SerializeRecastMeshTile(FArchive& Ar, unsigned char*&
 	}
 }
 
+//----------------------------------------------------------------------//
+// Tile streaming
+//----------------------------------------------------------------------//
+FArchive& operator<<(FArchive& Ar, FPImplRecastNavMesh::FStreamedTile& Tile)
+{
+	Ar << Tile.TileRef << Tile.Coord << Tile.Layer << Tile.Bounds;
+	Ar << Tile.TileDataSize << Tile.UncompressedSize;
+	Ar << Tile.CompressedData;
+	return Ar;
+}
+
+bool FPImplRecastNavMesh::CompressStreamedTile(const dtMeshTile* Tile, dtTileRef TileRef, bool bForceByteSwapping, FStreamedTile& OutStreamedTile)
+{
+	// compress serialized form, same as the one written to disk
+	TArray<uint8> UncompressedData;
+	FMemoryWriter Writer(UncompressedData);
+	Writer.SetByteSwapping(bForceByteSwapping);
+
+	unsigned char* TileData = Tile->data;
+	int32 TileDataSize = Tile->dataSize;
+	SerializeRecastMeshTile(Writer, TileData, TileDataSize);
+
+	int32 CompressedSize = FCompression::CompressMemoryBound(COMPRESS_ZLIB, UncompressedData.Num());
+	OutStreamedTile.CompressedData.SetNumUninitialized(CompressedSize);
+	if (!FCompression::CompressMemory(COMPRESS_ZLIB, OutStreamedTile.CompressedData.GetData(), CompressedSize, UncompressedData.GetData(), UncompressedData.Num()))
+	{
+		UE_LOG(LogNavigation, Error, TEXT("Failed to compress navmesh tile (%d,%d:%d)"), Tile->header->x, Tile->header->y, Tile->header->layer);
+		OutStreamedTile.CompressedData.Empty();
+		return false;
+	}
+	OutStreamedTile.CompressedData.SetNum(CompressedSize);
+
+	OutStreamedTile.TileRef = TileRef;
+	OutStreamedTile.Coord = FIntPoint(Tile->header->x, Tile->header->y);
+	OutStreamedTile.Layer = Tile->header->layer;
+	OutStreamedTile.Bounds = Recast2UnrealBox(Tile->header->bmin, Tile->header->bmax);
+	OutStreamedTile.TileDataSize = Tile->dataSize;
+	OutStreamedTile.UncompressedSize = UncompressedData.Num();
+	OutStreamedTile.PendingOffset = FVector::ZeroVector;
+	return true;
+}
+
+void FPImplRecastNavMesh::AddStreamedTile(FStreamedTile& StreamedTile)
+{
+	if (StreamedTile.CompressedData.Num() == 0)
+	{
+		return;
+	}
+
+	StreamedTilesCompressedSize += StreamedTile.CompressedData.Num();
+	INC_MEMORY_STAT_BY(STAT_Navigation_StreamedTilesMemory, StreamedTile.CompressedData.Num());
+
+	const int32 TileIndex = StreamedTiles.Add(MoveTemp(StreamedTile));
+	StreamedTilesGrid.Add(StreamedTiles[TileIndex].Coord, TileIndex);
+
+	if (StreamedTiles[TileIndex].bAttached)
+	{
+		AttachedStreamedTiles.Add(TileIndex);
+		AttachedStreamedTilesSize += StreamedTiles[TileIndex].TileDataSize;
+		INC_DWORD_STAT(STAT_Navigation_StreamedTilesAttached);
+	}
+}
+
+bool FPImplRecastNavMesh::AttachStreamedTile(FStreamedTile& StreamedTile)
+{
+	if (DetourNavMesh == NULL || DetourNavMesh->getTileAt(StreamedTile.Coord.X, StreamedTile.Coord.Y, StreamedTile.Layer) != NULL)
+	{
+		// location is already taken, e.g. by tiles of a streamed level's data chunk
+		return false;
+	}
+
+	TArray<uint8> UncompressedData;
+	UncompressedData.SetNumUninitialized(StreamedTile.UncompressedSize);
+	if (!FCompression::UncompressMemory(COMPRESS_ZLIB, UncompressedData.GetData(), StreamedTile.UncompressedSize, StreamedTile.CompressedData.GetData(), StreamedTile.CompressedData.Num()))
+	{
+		UE_LOG(LogNavigation, Error, TEXT("%s> Failed to decompress navmesh tile (%d,%d:%d)"),
+			*NavMeshOwner->GetName(), StreamedTile.Coord.X, StreamedTile.Coord.Y, StreamedTile.Layer);
+		return false;
+	}
+
+	FMemoryReader Reader(UncompressedData);
+	unsigned char* TileData = NULL;
+	int32 TileDataSize = 0;
+	SerializeRecastMeshTile(Reader, TileData, TileDataSize);
+	if (TileData == NULL)
+	{
+		return false;
+	}
+
+	if (!StreamedTile.PendingOffset.IsZero())
+	{
+		dtApplyTileDataOffset(TileData, &StreamedTile.PendingOffset.X);
+	}
+
+	// try to keep the same ref, so poly refs held by paths stay valid
+	dtTileRef ResultTileRef = 0;
+	dtStatus Status = DetourNavMesh->addTile(TileData, TileDataSize, DT_TILE_FREE_DATA, StreamedTile.TileRef, &ResultTileRef);
+	if (dtStatusFailed(Status) && dtStatusDetail(Status, DT_OUT_OF_MEMORY))
+	{
+		// tile's slot was taken in the meantime, any free one will do
+		Status = DetourNavMesh->addTile(TileData, TileDataSize, DT_TILE_FREE_DATA, 0, &ResultTileRef);
+	}
+
+	if (dtStatusFailed(Status))
+	{
+		dtFree(TileData);
+		return false;
+	}
+
+	StreamedTile.TileRef = ResultTileRef;
+	StreamedTile.TileDataSize = TileDataSize;
+	StreamedTile.PendingOffset = FVector::ZeroVector;
+	StreamedTile.bAttached = true;
+	return true;
+}
+
+void FPImplRecastNavMesh::DetachStreamedTile(FStreamedTile& StreamedTile)
+{
+	// navmesh owns tile data, it gets freed here
+	DetourNavMesh->removeTile(StreamedTile.TileRef, NULL, NULL);
+	StreamedTile.bAttached = false;
+}
+
+void FPImplRecastNavMesh::ReleaseStreamedTiles()
+{
+	DEC_MEMORY_STAT_BY(STAT_Navigation_StreamedTilesMemory, StreamedTilesCompressedSize);
+	DEC_DWORD_STAT_BY(STAT_Navigation_StreamedTilesAttached, AttachedStreamedTiles.Num());
+
+	StreamedTiles.Empty();
+	StreamedTilesGrid.Empty();
+	AttachedStreamedTiles.Empty();
+	WantedStreamedTiles.Empty();
+	AttachedStreamedTilesSize = 0;
+	StreamedTilesCompressedSize = 0;
+}
+
+void FPImplRecastNavMesh::InitTileStreaming()
+{
+	if (DetourNavMesh == NULL || LoadedTileRefs.Num() == 0)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_Navigation_TileStreaming);
+
+	const dtNavMesh* ConstNavMesh = DetourNavMesh;
+	for (const dtTileRef TileRef : LoadedTileRefs)
+	{
+		const dtMeshTile* Tile = ConstNavMesh->getTileByRef(TileRef);
+		if (Tile != NULL && Tile->header != NULL)
+		{
+			FStreamedTile StreamedTile;
+			if (CompressStreamedTile(Tile, TileRef, false, StreamedTile))
+			{
+				StreamedTile.bAttached = true;
+				AddStreamedTile(StreamedTile);
+			}
+		}
+	}
+
+	LoadedTileRefs.Empty();
+}
+
+bool FPImplRecastNavMesh::UpdateWantedStreamedTiles(const TArray<FVector>& Sources, float Radius, int32 MemoryBudget)
+{
+	WantedStreamedTiles.Reset();
+	if (DetourNavMesh == NULL || StreamedTiles.Num() == 0)
+	{
+		return false;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_Navigation_TileStreaming);
+
+	++TileStreamingStamp;
+
+	// find tiles around sources, looking only at grid cells within radius
+	TMap<int32, float> WantedTilesDistSq;
+	const float RadiusSq = FMath::Square(Radius);
+	const int32 RadiusInTiles = FMath::CeilToInt(Radius / DetourNavMesh->getParams()->tileWidth);
+	for (const FVector& Source : Sources)
+	{
+		int32 SourceX = 0, SourceY = 0;
+		if (!GetNavMeshTileXY(Source, SourceX, SourceY))
+		{
+			continue;
+		}
+
+		for (int32 TileY = SourceY - RadiusInTiles; TileY <= SourceY + RadiusInTiles; ++TileY)
+		{
+			for (int32 TileX = SourceX - RadiusInTiles; TileX <= SourceX + RadiusInTiles; ++TileX)
+			{
+				for (TMultiMap<FIntPoint, int32>::TConstKeyIterator It(StreamedTilesGrid, FIntPoint(TileX, TileY)); It; ++It)
+				{
+					const FStreamedTile& StreamedTile = StreamedTiles[It.Value()];
+					const FVector Source2D(Source.X, Source.Y, StreamedTile.Bounds.GetCenter().Z);
+					const float DistSq = StreamedTile.Bounds.ComputeSquaredDistanceToPoint(Source2D);
+					if (DistSq <= RadiusSq)
+					{
+						float* CurrentDistSq = WantedTilesDistSq.Find(It.Value());
+						if (CurrentDistSq == NULL)
+						{
+							WantedTilesDistSq.Add(It.Value(), DistSq);
+						}
+						else
+						{
+							*CurrentDistSq = FMath::Min(*CurrentDistSq, DistSq);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	// closest tiles first, the ones not fitting in memory budget aren't wanted
+	WantedTilesDistSq.ValueSort(TLess<float>());
+
+	bool bChanged = false;
+	WantedStreamedTiles.Reserve(WantedTilesDistSq.Num());
+	int32 WantedTilesSize = 0;
+	for (TMap<int32, float>::TConstIterator It(WantedTilesDistSq); It; ++It)
+	{
+		FStreamedTile& StreamedTile = StreamedTiles[It.Key()];
+		if (MemoryBudget > 0 && WantedTilesSize + StreamedTile.TileDataSize > MemoryBudget)
+		{
+			break;
+		}
+
+		WantedTilesSize += StreamedTile.TileDataSize;
+		StreamedTile.WantedStamp = TileStreamingStamp;
+		WantedStreamedTiles.Add(It.Key());
+		bChanged = bChanged || !StreamedTile.bAttached;
+	}
+
+	for (int32 Idx = 0; Idx < AttachedStreamedTiles.Num() && !bChanged; ++Idx)
+	{
+		bChanged = StreamedTiles[AttachedStreamedTiles[Idx]].WantedStamp != TileStreamingStamp;
+	}
+
+	return bChanged;
+}
+
+void FPImplRecastNavMesh::UpdateTileStreaming(int32 MaxTilesToAttach, TArray<uint32>& OutAttachedTiles, TArray<uint32>& OutDetachedTiles)
+{
+	if (DetourNavMesh == NULL || StreamedTiles.Num() == 0)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_Navigation_TileStreaming);
+
+	// detach first to make room
+	for (int32 Idx = AttachedStreamedTiles.Num() - 1; Idx >= 0; --Idx)
+	{
+		FStreamedTile& StreamedTile = StreamedTiles[AttachedStreamedTiles[Idx]];
+		if (StreamedTile.WantedStamp != TileStreamingStamp)
+		{
+			OutDetachedTiles.AddUnique(DetourNavMesh->decodePolyIdTile(StreamedTile.TileRef));
+			DetachStreamedTile(StreamedTile);
+
+			AttachedStreamedTilesSize -= StreamedTile.TileDataSize;
+			AttachedStreamedTiles.RemoveAtSwap(Idx, 1, /*bAllowShrinking=*/false);
+			DEC_DWORD_STAT(STAT_Navigation_StreamedTilesAttached);
+		}
+	}
+
+	int32 NumAttached = 0;
+	for (int32 Idx = 0; Idx < WantedStreamedTiles.Num() && (MaxTilesToAttach <= 0 || NumAttached < MaxTilesToAttach); ++Idx)
+	{
+		FStreamedTile& StreamedTile = StreamedTiles[WantedStreamedTiles[Idx]];
+		if (!StreamedTile.bAttached && AttachStreamedTile(StreamedTile))
+		{
+			OutAttachedTiles.AddUnique(DetourNavMesh->decodePolyIdTile(StreamedTile.TileRef));
+
+			AttachedStreamedTilesSize += StreamedTile.TileDataSize;
+			AttachedStreamedTiles.Add(WantedStreamedTiles[Idx]);
+			INC_DWORD_STAT(STAT_Navigation_StreamedTilesAttached);
+			NumAttached++;
+		}
+	}
+}
+
+void FPImplRecastNavMesh::StopTileStreaming(TArray<uint32>& OutAttachedTiles)
+{
+	for (FStreamedTile& StreamedTile : StreamedTiles)
+	{
+		if (!StreamedTile.bAttached && AttachStreamedTile(StreamedTile))
+		{
+			OutAttachedTiles.AddUnique(DetourNavMesh->decodePolyIdTile(StreamedTile.TileRef));
+		}
+	}
+
+	ReleaseStreamedTiles();
+}
+
 void FPImplRecastNavMesh::SetRecastMesh(dtNavMesh* NavMesh)
 {
 	if (NavMesh == DetourNavMesh)
@@ -725,7 +1135,7 @@ void FPImplRecastNavMesh::Raycast2D(NavNodeRef StartNode, const FVector& StartLo
 }
 
 // @TODONAV
-ENavigationQueryResult::Type FPImplRecastNavMesh::FindPath(const FVector& StartLoc, const FVector& EndLoc, FNavMeshPath& Path, const FNavigationQueryFilter& InQueryFilter, const UObject* Owner) const
+ENavigationQueryResult::Type FPImplRecastNavMesh::FindPath(const FVector& StartLoc, const FVector& EndLoc, FNavMeshPath& Path, const FNavigationQueryFilter& InQueryFilter, const UObject* Owner, bool bUseClusterGraph) const
 {
 	// temporarily disabling this check due to it causing too much "crashes"
 	// @todo but it needs to be back at some point since it realy checks for a buggy setup
@@ -766,7 +1176,36 @@ ENavigationQueryResult::Type FPImplRecastNavMesh::FindPath(const FVector& StartL
 
 	// get path corridor
 	dtQueryResult PathResult;
-	const dtStatus FindPathStatus = NavQuery.findPath(StartPolyID, EndPolyID, &RecastStartPos.X, &RecastEndPos.X, QueryFilter, PathResult, 0);
+	dtStatus FindPathStatus = DT_FAILURE;
+
+	if (bUseClusterGraph)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_Navigation_RecastFindClusterPath);
+
+		// find clusters on the way first, cluster links are cheap to expand compared to polygons
+		const int32 MaxClusterPath = FMath::Max(1, FMath::TruncToInt(NavMeshOwner->DefaultMaxHierarchicalSearchNodes));
+		TArray<dtClusterRef> ClusterPath;
+		ClusterPath.AddUninitialized(MaxClusterPath);
+
+		int32 ClusterPathCount = 0;
+		const dtStatus ClusterStatus = NavQuery.findClusterPath(StartPolyID, EndPolyID, ClusterPath.GetData(), &ClusterPathCount, MaxClusterPath);
+		if (dtStatusSucceed(ClusterStatus) && !dtStatusDetail(ClusterStatus, DT_PARTIAL_RESULT | DT_BUFFER_TOO_SMALL))
+		{
+			// and then look for polygon path only inside them
+			ClusterPath.SetNum(ClusterPathCount);
+			ClusterPath.Sort();
+
+			const dtClusterCorridorFilter CorridorFilter(DetourNavMesh, QueryFilter, ClusterPath.GetData(), ClusterPath.Num());
+			FindPathStatus = NavQuery.findPath(StartPolyID, EndPolyID, &RecastStartPos.X, &RecastEndPos.X, &CorridorFilter, PathResult, 0);
+		}
+	}
+
+	if (!dtStatusSucceed(FindPathStatus) || dtStatusDetail(FindPathStatus, DT_PARTIAL_RESULT))
+	{
+		// no cluster data or corridor too narrow, run regular search over whole navmesh
+		PathResult.reset();
+		FindPathStatus = NavQuery.findPath(StartPolyID, EndPolyID, &RecastStartPos.X, &RecastEndPos.X, QueryFilter, PathResult, 0);
+	}
 
 	// check for special case, where path has not been found, and starting polygon
 	// was the one closest to the target
@@ -1725,7 +2164,7 @@ bool FPImplRecastNavMesh::GetPolysInTile(int32 TileIndex, TArray<FNavPoly>& Poly
 	}
 
 	const dtMeshTile* Tile = ((const dtNavMesh*)DetourNavMesh)->getTile(TileIndex);
-	const int32 MaxPolys = Tile ? Tile->header->offMeshBase : 0;
+	const int32 MaxPolys = Tile && Tile->header ? Tile->header->offMeshBase : 0;
 	if (MaxPolys > 0)
 	{
 		// only ground type polys
@@ -2317,6 +2756,9 @@ float FPImplRecastNavMesh::GetTotalDataSize() const
 		}
 	}
 
+	// compressed copies of streamed tiles
+	TotalBytes += StreamedTilesCompressedSize;
+
 	return TotalBytes / 1024;
 }
 
@@ -2328,6 +2770,16 @@ void FPImplRecastNavMesh::ApplyWorldOffset(const FVector& InOffset, bool bWorldS
 		const FVector OffsetRC = Unreal2RecastPoint(InOffset);
 		// apply offset
 		DetourNavMesh->applyWorldOffset(&OffsetRC.X);
+
+		// detached tiles get shifted when attached back
+		for (FStreamedTile& StreamedTile : StreamedTiles)
+		{
+			StreamedTile.Bounds = StreamedTile.Bounds.ShiftBy(InOffset);
+			if (!StreamedTile.bAttached)
+			{
+				StreamedTile.PendingOffset += OffsetRC;
+			}
+		}
 	}
 
 }
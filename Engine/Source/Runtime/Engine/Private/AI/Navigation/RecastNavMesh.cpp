@@ -26,13 +26,13 @@
 #if WITH_RECAST
 /// Helper for accessing navigation query from different threads
 #define INITIALIZE_NAVQUERY(NavQueryVariable, NumNodes)	\
-	dtNavMeshQuery NavQueryVariable##Private;	\
-	dtNavMeshQuery& NavQueryVariable = IsInGameThread() ? RecastNavMeshImpl->SharedNavQuery : NavQueryVariable##Private; \
+	FRecastNavMeshQueryContext::FScopedNavQuery NavQueryVariable##Scope(RecastNavMeshImpl->SharedNavQuery);	\
+	dtNavMeshQuery& NavQueryVariable = NavQueryVariable##Scope.Get(); \
 	NavQueryVariable.init(RecastNavMeshImpl->DetourNavMesh, NumNodes);
 
 #define INITIALIZE_NAVQUERY_WLINKFILTER(NavQueryVariable, NumNodes, LinkFilter)	\
-	dtNavMeshQuery NavQueryVariable##Private;	\
-	dtNavMeshQuery& NavQueryVariable = IsInGameThread() ? RecastNavMeshImpl->SharedNavQuery : NavQueryVariable##Private; \
+	FRecastNavMeshQueryContext::FScopedNavQuery NavQueryVariable##Scope(RecastNavMeshImpl->SharedNavQuery);	\
+	dtNavMeshQuery& NavQueryVariable = NavQueryVariable##Scope.Get(); \
 	NavQueryVariable.init(RecastNavMeshImpl->DetourNavMesh, NumNodes, &LinkFilter);
 
 #endif // WITH_RECAST
@@ -207,8 +207,13 @@ ARecastNavMesh::ARecastNavMesh(const FObjectInitializer& ObjectInitializer)
 	, bPerformVoxelFiltering(true)	
 	, bMarkLowHeightAreas(false)
 	, bUseVirtualFilters(true)
+	, bStreamTiles(false)
+	, TileStreamingRadius(10000.f)
+	, TileStreamingMemoryBudgetKB(0)
+	, MaxTilesStreamedInPerUpdate(16)
 	, TileSetUpdateInterval(1.0f)
 	, NavMeshVersion(NAVMESHVER_LATEST)	
+	, TileStreamingTimeLeft(0.f)
 	, RecastNavMeshImpl(NULL)
 {
 	HeuristicScale = 0.999f;
@@ -227,7 +232,7 @@ ARecastNavMesh::ARecastNavMesh(const FObjectInitializer& ObjectInitializer)
 		INC_DWORD_STAT_BY( STAT_NavigationMemory, sizeof(*this) );
 
 		FindPathImplementation = FindPath;
-		FindHierarchicalPathImplementation = FindPath;
+		FindHierarchicalPathImplementation = FindHierarchicalPath;
 
 		TestPathImplementation = TestPath;
 		TestHierarchicalPathImplementation = TestHierarchicalPath;
@@ -661,7 +666,7 @@ void ARecastNavMesh::SerializeRecastNavMesh(FArchive& Ar, FPImplRecastNavMesh*&
 	
 	if (RecastNavMeshImpl)
 	{
-		RecastNavMeshImpl->Serialize(Ar);
+		RecastNavMeshImpl->Serialize(Ar, NavMeshVersion);
 	}	
 }
 
@@ -1471,6 +1476,121 @@ void ARecastNavMesh::OnStreamingLevelRemoved(ULevel* InLevel)
 	}
 }
 
+void ARecastNavMesh::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// tiles around players and pawns placed in level are there before anything looks for a path, not attached over many updates
+	UWorld* World = GetWorld();
+	if (RecastNavMeshImpl && World && World->IsGameWorld() && bStreamTiles && !bRebuildAtRuntime)
+	{
+		UpdateTileStreaming(/*MaxTilesToAttach=*/0);
+		TileStreamingTimeLeft = TileSetUpdateInterval;
+	}
+}
+
+void ARecastNavMesh::TickAsyncBuild(float DeltaSeconds)
+{
+	Super::TickAsyncBuild(DeltaSeconds);
+
+	UWorld* World = GetWorld();
+	if (RecastNavMeshImpl == NULL || World == NULL || !World->IsGameWorld())
+	{
+		return;
+	}
+
+	if (bStreamTiles && !bRebuildAtRuntime)
+	{
+		TileStreamingTimeLeft -= DeltaSeconds;
+		if (TileStreamingTimeLeft <= 0.f)
+		{
+			TileStreamingTimeLeft = TileSetUpdateInterval;
+			UpdateTileStreaming(MaxTilesStreamedInPerUpdate);
+		}
+	}
+	else if (RecastNavMeshImpl->IsStreamingTiles())
+	{
+		UNavigationSystem* NavSys = World->GetNavigationSystem();
+		if (NavSys)
+		{
+			NavSys->WaitForAsyncQueries();
+		}
+
+		TArray<uint32> AttachedIndices;
+		RecastNavMeshImpl->StopTileStreaming(AttachedIndices);
+		if (AttachedIndices.Num() > 0)
+		{
+			RequestDrawingUpdate();
+		}
+	}
+}
+
+void ARecastNavMesh::UpdateTileStreaming(int32 MaxTilesToAttach)
+{
+	// compresses tiles loaded from uncooked data, does nothing once they're taken over
+	RecastNavMeshImpl->InitTileStreaming();
+	if (!RecastNavMeshImpl->IsStreamingTiles())
+	{
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	TArray<FVector> Sources;
+	for (FConstPawnIterator Iterator = World->GetPawnIterator(); Iterator; ++Iterator)
+	{
+		const APawn* Pawn = *Iterator;
+		if (Pawn)
+		{
+			Sources.Add(Pawn->GetActorLocation());
+		}
+	}
+
+	// viewers can be away from their pawns, or have none yet
+	for (FConstPlayerControllerIterator Iterator = World->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		const APlayerController* PlayerController = *Iterator;
+		if (PlayerController)
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			Sources.Add(ViewLocation);
+		}
+	}
+
+	UNavigationSystem* NavSys = World->GetNavigationSystem();
+	if (NavSys)
+	{
+		NavSys->GetGenerationSeeds(Sources);
+	}
+
+	if (!RecastNavMeshImpl->UpdateWantedStreamedTiles(Sources, TileStreamingRadius, TileStreamingMemoryBudgetKB * 1024))
+	{
+		return;
+	}
+
+	// removing a tile frees it and adding one relinks its neighbours, async pathfinding tasks can't be reading them.
+	// EQS steps scored on worker threads are all done by the end of UEnvQueryManager::Tick, on the game thread like this
+	if (NavSys)
+	{
+		NavSys->WaitForAsyncQueries();
+	}
+
+	TArray<uint32> AttachedIndices, DetachedIndices;
+	RecastNavMeshImpl->UpdateTileStreaming(MaxTilesToAttach, AttachedIndices, DetachedIndices);
+
+	// paths going through attached tiles weren't found before, they don't need to be invalidated
+	if (DetachedIndices.Num() > 0)
+	{
+		InvalidateAffectedPaths(DetachedIndices);
+	}
+
+	if (AttachedIndices.Num() > 0 || DetachedIndices.Num() > 0)
+	{
+		RequestDrawingUpdate();
+	}
+}
+
 bool ARecastNavMesh::AdjustLocationWithFilter(const FVector& StartLoc, FVector& OutAdjustedLocation, const FNavigationQueryFilter& Filter, const UObject* QueryOwner) const
 {
 	INITIALIZE_NAVQUERY(NavQuery, Filter.GetMaxSearchNodes());
@@ -1502,13 +1622,13 @@ bool ARecastNavMesh::AdjustLocationWithFilter(const FVector& StartLoc, FVector&
 	}
 }
 
-FPathFindingResult ARecastNavMesh::FindPath(const FNavAgentProperties& AgentProperties, const FPathFindingQuery& Query)
+static FPathFindingResult FindRecastPath(const FPathFindingQuery& Query, bool bUseClusterGraph)
 {
 	const ANavigationData* Self = Query.NavData.Get();
 	check(Cast<const ARecastNavMesh>(Self));
 
 	const ARecastNavMesh* RecastNavMesh = (const ARecastNavMesh*)Self;
-	if (Self == NULL || RecastNavMesh->RecastNavMeshImpl == NULL)
+	if (Self == NULL || RecastNavMesh->GetRecastNavMeshImpl() == NULL)
 	{
 		return ENavigationQueryResult::Error;
 	}
@@ -1530,8 +1650,8 @@ FPathFindingResult ARecastNavMesh::FindPath(const FNavAgentProperties& AgentProp
 	{
 		if(Query.QueryFilter.IsValid())
 		{
-			Result.Result = RecastNavMesh->RecastNavMeshImpl->FindPath(Query.StartLocation, Query.EndLocation, *NavMeshPath,
-				*(Query.QueryFilter.Get()), Query.Owner.Get());
+			Result.Result = RecastNavMesh->GetRecastNavMeshImpl()->FindPath(Query.StartLocation, Query.EndLocation, *NavMeshPath,
+				*(Query.QueryFilter.Get()), Query.Owner.Get(), bUseClusterGraph);
 		}
 		else
 		{
@@ -1542,6 +1662,16 @@ FPathFindingResult ARecastNavMesh::FindPath(const FNavAgentProperties& AgentProp
 	return Result;
 }
 
+FPathFindingResult ARecastNavMesh::FindPath(const FNavAgentProperties& AgentProperties, const FPathFindingQuery& Query)
+{
+	return FindRecastPath(Query, false);
+}
+
+FPathFindingResult ARecastNavMesh::FindHierarchicalPath(const FNavAgentProperties& AgentProperties, const FPathFindingQuery& Query)
+{
+	return FindRecastPath(Query, true);
+}
+
 bool ARecastNavMesh::TestPath(const FNavAgentProperties& AgentProperties, const FPathFindingQuery& Query, int32* NumVisitedNodes)
 {
 	const ANavigationData* Self = Query.NavData.Get();
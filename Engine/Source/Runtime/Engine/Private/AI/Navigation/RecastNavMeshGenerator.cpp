@@ -31,6 +31,27 @@
 
 #define SHOW_NAV_EXPORT_PREVIEW 0
 
+static TAutoConsoleVariable<int32> CVarNavTileParallelLayers(
+	TEXT("ai.NavTileParallelLayers"),
+	1,
+	TEXT("Whether dirty layers of a navmesh tile being rebuilt are built in parallel, on task graph workers.\n")
+	TEXT("0: build layers one after another on the tile's worker thread"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarNavTileAttachBudget(
+	TEXT("ai.NavTileAttachBudgetMs"),
+	2.f,
+	TEXT("Time (ms) the game thread can spend each tick adding rebuilt navmesh tiles. At least one rebuilt tile is added every tick, tiles closest to agents go first.\n")
+	TEXT("0: add all rebuilt tiles right away"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarNavTileGeometryClipping(
+	TEXT("ai.NavTileGeometryClipping"),
+	1,
+	TEXT("Whether a navmesh tile only gathers the triangles of exported geometry that can reach its heightfield. The triangles kept are cached per tile with the geometry, until it is exported again.\n")
+	TEXT("0: every tile gathers all triangles of the geometry it overlaps"),
+	ECVF_Default);
+
 #define TEXT_WEAKOBJ_NAME(obj) (obj.IsValid(false) ? *obj->GetName() : (obj.IsValid(false, true)) ? TEXT("MT-Unreachable") : TEXT("INVALID"))
 
 #define DO_RECAST_STATS 0
@@ -250,6 +271,33 @@ FRecastGeometryCache::FRecastGeometryCache(const uint8* Memory)
 	Indices = (int32*)(Memory + sizeof(FRecastGeometryCache) + (sizeof(float) * Header.NumVerts * 3));
 }
 
+FRecastClippedGeometryCache::FRecastClippedGeometryCache(const uint8* Memory, int32 TileX, int32 TileY, int32 AgentIndex)
+	: Tile(NULL)
+	, VertIndices(NULL)
+	, Indices(NULL)
+{
+	if (Memory == NULL)
+	{
+		return;
+	}
+
+	const int32 NumTiles = *((const int32*)Memory);
+	const uint8* BytesArr = Memory + sizeof(int32);
+	for (int32 i = 0; i < NumTiles; i++)
+	{
+		const FTileInfo* TileInfo = (const FTileInfo*)BytesArr;
+		if (TileInfo->TileX == TileX && TileInfo->TileY == TileY && TileInfo->AgentIndex == AgentIndex)
+		{
+			Tile = TileInfo;
+			VertIndices = (const int32*)(BytesArr + sizeof(FTileInfo));
+			Indices = VertIndices + TileInfo->NumVerts;
+			return;
+		}
+
+		BytesArr += sizeof(FTileInfo) + sizeof(int32) * (TileInfo->NumVerts + TileInfo->NumFaces * 3);
+	}
+}
+
 namespace RecastGeometryExport {
 
 static UWorld* FindEditorWorld()
@@ -273,6 +321,9 @@ static void StoreCollisionCache(FRecastGeometryExport* GeomExport)
 	const int32 NumFaces = GeomExport->IndexBuffer.Num() / 3;
 	const int32 NumVerts = GeomExport->VertexBuffer.Num() / 3;
 
+	// clipped parts of previously exported geometry are no longer valid
+	GeomExport->Data->ClippedGeometryData.Empty();
+
 	if (NumFaces == 0 || NumVerts == 0)
 	{
 		GeomExport->Data->CollisionData.Empty();
@@ -1565,7 +1616,7 @@ void FRecastTileGenerator::GatherGeometry(const FRecastNavMeshGenerator& ParentG
 				}
 				else
 				{
-					AppendGeometry(Element.Data.CollisionData, Element.Data.NavDataPerInstanceTransformDelegate);
+					AppendElementGeometry(Element.Data);
 				}
 			}
 
@@ -1759,6 +1810,84 @@ void FRecastTileGenerator::AddVoxelCache(TNavStatArray<uint8>& RawVoxelCache, co
 	FMemory::Memcpy(RawVoxelCache.GetData() + NewCacheIdx + HeaderSize, CachedVoxels, VoxelsSize);
 }
 
+void FRecastTileGenerator::AddClippedGeometryCache(TNavStatArray<uint8>& RawClippedCache, const TNavStatArray<uint8>& RawCollisionCache, const FVector& ClipMin, const FVector& ClipMax) const
+{
+	// box of tile changes with navmesh config and bounds: drop previous entry, so there's never more than one per tile and agent
+	FRecastClippedGeometryCache PrevCache(RawClippedCache.GetData(), TileX, TileY, TileConfig.AgentIndex);
+	if (PrevCache.Tile)
+	{
+		const int32 PrevCacheIdx = (const uint8*)PrevCache.Tile - RawClippedCache.GetData();
+		RawClippedCache.RemoveAt(PrevCacheIdx, PrevCache.GetTileDataSize(), false);
+
+		int32* NumTiles = (int32*)RawClippedCache.GetData();
+		*NumTiles = *NumTiles - 1;
+	}
+
+	FRecastGeometryCache CollisionCache(RawCollisionCache.GetData());
+	const int32 NumVerts = CollisionCache.Header.NumVerts;
+	const int32 NumFaces = CollisionCache.Header.NumFaces;
+
+	// keep triangles with bounds touching the box, in their original order
+	TArray<int32> VertRemap;
+	VertRemap.Init(INDEX_NONE, NumVerts);
+	TArray<int32> KeptVerts;
+	TArray<int32> KeptIndices;
+
+	for (int32 FaceIdx = 0; FaceIdx < NumFaces; FaceIdx++)
+	{
+		const int32* Tri = CollisionCache.Indices + FaceIdx * 3;
+		const float* V0 = CollisionCache.Verts + Tri[0] * 3;
+		const float* V1 = CollisionCache.Verts + Tri[1] * 3;
+		const float* V2 = CollisionCache.Verts + Tri[2] * 3;
+
+		const FVector TriMin(FMath::Min3(V0[0], V1[0], V2[0]), FMath::Min3(V0[1], V1[1], V2[1]), FMath::Min3(V0[2], V1[2], V2[2]));
+		const FVector TriMax(FMath::Max3(V0[0], V1[0], V2[0]), FMath::Max3(V0[1], V1[1], V2[1]), FMath::Max3(V0[2], V1[2], V2[2]));
+		if (TriMin.X > ClipMax.X || TriMax.X < ClipMin.X ||
+			TriMin.Y > ClipMax.Y || TriMax.Y < ClipMin.Y ||
+			TriMin.Z > ClipMax.Z || TriMax.Z < ClipMin.Z)
+		{
+			continue;
+		}
+
+		for (int32 i = 0; i < 3; i++)
+		{
+			int32& RemappedIdx = VertRemap[Tri[i]];
+			if (RemappedIdx == INDEX_NONE)
+			{
+				RemappedIdx = KeptVerts.Add(Tri[i]);
+			}
+			KeptIndices.Add(RemappedIdx);
+		}
+	}
+
+	if (RawClippedCache.Num() == 0)
+	{
+		RawClippedCache.AddZeroed(sizeof(int32));
+	}
+
+	int32* NumTiles = (int32*)RawClippedCache.GetData();
+	*NumTiles = *NumTiles + 1;
+
+	const int32 NewCacheIdx = RawClippedCache.Num();
+	const int32 HeaderSize = sizeof(FRecastClippedGeometryCache::FTileInfo);
+	const int32 VertIndicesSize = sizeof(int32) * KeptVerts.Num();
+	const int32 IndicesSize = sizeof(int32) * KeptIndices.Num();
+	RawClippedCache.AddUninitialized(HeaderSize + VertIndicesSize + IndicesSize);
+
+	uint8* EntryMemory = RawClippedCache.GetData() + NewCacheIdx;
+	FRecastClippedGeometryCache::FTileInfo* TileInfo = (FRecastClippedGeometryCache::FTileInfo*)EntryMemory;
+	TileInfo->ClipMin = ClipMin;
+	TileInfo->ClipMax = ClipMax;
+	TileInfo->TileX = TileX;
+	TileInfo->TileY = TileY;
+	TileInfo->AgentIndex = TileConfig.AgentIndex;
+	TileInfo->NumVerts = KeptVerts.Num();
+	TileInfo->NumFaces = KeptIndices.Num() / 3;
+
+	FMemory::Memcpy(EntryMemory + HeaderSize, KeptVerts.GetData(), VertIndicesSize);
+	FMemory::Memcpy(EntryMemory + HeaderSize + VertIndicesSize, KeptIndices.GetData(), IndicesSize);
+}
+
 void FRecastTileGenerator::AppendModifier(const FCompositeNavModifier& Modifier, const FNavDataPerInstanceTransformDelegate& InTransformsDelegate)
 {
 	// append all offmesh links (not included in compress layers)
@@ -1826,6 +1955,67 @@ void FRecastTileGenerator::AppendGeometry(const TNavStatArray<uint8>& RawCollisi
 	RawGeometry.Add(MoveTemp(GeometryElement));
 }
 
+void FRecastTileGenerator::AppendElementGeometry(const FNavigationRelevantData& ElementData)
+{
+	// heightfield bounds (see GenerateCompressedLayers) grown by a cell, rasterization skips every triangle outside
+	const float ClipPadding = (TileConfig.borderSize + 1) * TileConfig.cs;
+	const FVector ClipMin(TileConfig.bmin[0] - ClipPadding, TileConfig.bmin[1] - TileConfig.ch, TileConfig.bmin[2] - ClipPadding);
+	const FVector ClipMax(TileConfig.bmax[0] + ClipPadding, TileConfig.bmax[1] + TileConfig.ch, TileConfig.bmax[2] + ClipPadding);
+	const FBox ClipBounds = Recast2UnrealBox(FBox(ClipMin, ClipMax));
+
+	const bool bClipGeometry = CVarNavTileGeometryClipping.GetValueOnGameThread() != 0;
+	if (bClipGeometry && ElementData.CollisionData.Num() && !ElementData.HasPerInstanceTransforms()
+		&& !(ElementData.Bounds.IsValid && DoesBoxContainBox(ClipBounds, ElementData.Bounds)))
+	{
+		// geometry sticking out of the tile, only the triangles reaching it are worth copying and rasterizing
+		FNavigationRelevantData* ModData = (FNavigationRelevantData*)&ElementData;
+		AppendClippedGeometry(*ModData, ClipMin, ClipMax);
+	}
+	else
+	{
+		AppendGeometry(ElementData.CollisionData, ElementData.NavDataPerInstanceTransformDelegate);
+	}
+}
+
+void FRecastTileGenerator::AppendClippedGeometry(FNavigationRelevantData& Data, const FVector& ClipMin, const FVector& ClipMax)
+{
+	FRecastClippedGeometryCache ClippedCache(Data.ClippedGeometryData.GetData(), TileX, TileY, TileConfig.AgentIndex);
+	if (ClippedCache.Tile == NULL || ClippedCache.Tile->ClipMin != ClipMin || ClippedCache.Tile->ClipMax != ClipMax)
+	{
+		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("Rasterization: clip geometry to tile"), Stat_RecastClipGeometry, STATGROUP_Navigation);
+
+		const int32 PrevElementMemory = Data.GetAllocatedSize();
+		AddClippedGeometryCache(Data.ClippedGeometryData, Data.CollisionData, ClipMin, ClipMax);
+
+		const int32 ElementMemoryDelta = Data.GetAllocatedSize() - PrevElementMemory;
+		INC_MEMORY_STAT_BY(STAT_Navigation_CollisionTreeMemory, ElementMemoryDelta);
+
+		ClippedCache = FRecastClippedGeometryCache(Data.ClippedGeometryData.GetData(), TileX, TileY, TileConfig.AgentIndex);
+	}
+
+	check(ClippedCache.Tile);
+	const int32 NumVerts = ClippedCache.Tile->NumVerts;
+	const int32 NumIndices = ClippedCache.Tile->NumFaces * 3;
+	if (NumIndices == 0)
+	{
+		return;
+	}
+
+	FRecastGeometryCache CollisionCache(Data.CollisionData.GetData());
+	FRecastRawGeometryElement GeometryElement;
+	GeometryElement.GeomCoords.AddUninitialized(NumVerts * 3);
+	GeometryElement.GeomIndices.AddUninitialized(NumIndices);
+
+	float* Coords = GeometryElement.GeomCoords.GetData();
+	for (int32 i = 0; i < NumVerts; i++, Coords += 3)
+	{
+		FMemory::Memcpy(Coords, CollisionCache.Verts + ClippedCache.VertIndices[i] * 3, sizeof(float) * 3);
+	}
+	FMemory::Memcpy(GeometryElement.GeomIndices.GetData(), ClippedCache.Indices, sizeof(int32) * NumIndices);
+
+	RawGeometry.Add(MoveTemp(GeometryElement));
+}
+
 bool FRecastTileGenerator::GenerateTile()
 {
 	bool bSuccess = true;
@@ -2201,250 +2391,334 @@ struct FTileGenerationContext
 	TArray<FNavMeshTileData> NavigationData;
 };
 
+/** Builds navigation data of a single tile layer on a task graph worker */
+class FRecastTileLayerTask
+{
+	FRecastTileGenerator& TileGenerator;
+	int32 LayerIdx;
+	FNavMeshTileData& OutNavData;
+	bool& bOutSucceeded;
+
+public:
+	FRecastTileLayerTask(FRecastTileGenerator& InTileGenerator, int32 InLayerIdx, FNavMeshTileData& InOutNavData, bool& bInOutSucceeded)
+		: TileGenerator(InTileGenerator)
+		, LayerIdx(InLayerIdx)
+		, OutNavData(InOutNavData)
+		, bOutSucceeded(bInOutSucceeded)
+	{
+	}
+
+	FORCEINLINE TStatId GetStatId() const
+	{
+		RETURN_QUICK_DECLARE_CYCLE_STAT(FRecastTileLayerTask, STATGROUP_TaskGraphTasks);
+	}
+	static ENamedThreads::Type GetDesiredThread()
+	{
+		return ENamedThreads::AnyThread;
+	}
+	static ESubsequentsMode::Type GetSubsequentsMode()
+	{
+		return ESubsequentsMode::TrackSubsequents;
+	}
+	void DoTask(ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+	{
+		FNavMeshBuildContext BuildContext;
+		bOutSucceeded = TileGenerator.GenerateNavigationDataLayer(BuildContext, LayerIdx, OutNavData);
+	}
+};
+
 bool FRecastTileGenerator::GenerateNavigationData(FNavMeshBuildContext& BuildContext)
 {
 	RECAST_STAT(STAT_Navigation_Async_Recast_Generate);
 	SCOPE_CYCLE_COUNTER(STAT_Navigation_RecastBuildNavigation);
-		
-	FTileCacheAllocator MyAllocator;
-	FTileCacheCompressor TileCompressor;
-	
-	FTileGenerationContext GenerationContext(&MyAllocator);
-	GenerationContext.NavigationData.Reserve(CompressedLayers.Num());
 
-	dtStatus status = DT_SUCCESS;
+	// sort modifiers once for all layers, so layers can be built at the same time
+	if (AdditionalCachedData.bUseSortFunction && AdditionalCachedData.ActorOwner && Modifiers.Num() > 1)
+	{
+		AdditionalCachedData.ActorOwner->SortAreasForGenerator(Modifiers);
+	}
 
-	for (int32 iLayer = 0; iLayer < CompressedLayers.Num(); iLayer++)
+	TArray<int32> LayersToBuild;
+	for (int32 LayerIdx = 0; LayerIdx < CompressedLayers.Num(); LayerIdx++)
 	{
-		if (DirtyLayers[iLayer] == false)
+		// skip layers not marked for rebuild
+		if (DirtyLayers[LayerIdx])
 		{
-			// skip layers not marked for rebuild
-			continue;
+			LayersToBuild.Add(LayerIdx);
 		}
-				
-		FNavMeshTileData& CompressedData = CompressedLayers[iLayer];
-		const dtTileCacheLayerHeader* TileHeader = (const dtTileCacheLayerHeader*)CompressedData.GetData();
-		GenerationContext.ResetIntermediateData();
+	}
 
-		// Decompress tile layer data. 
-		status = dtDecompressTileCacheLayer(&MyAllocator, &TileCompressor, (unsigned char*)CompressedData.GetData(), CompressedData.DataSize, &GenerationContext.Layer);
-		if (dtStatusFailed(status))
+	TArray<FNavMeshTileData> LayersNavigationData;
+	LayersNavigationData.SetNum(LayersToBuild.Num());
+	TArray<bool> LayersSucceeded;
+	LayersSucceeded.Init(false, LayersToBuild.Num());
+
+	// region, contour and poly mesh building of all but the first layer goes to other workers
+	int32 NumLayersOnThisThread = LayersToBuild.Num();
+	FGraphEventArray LayerEvents;
+	if (LayersToBuild.Num() > 1 && CVarNavTileParallelLayers.GetValueOnAnyThread() != 0)
+	{
+		for (int32 Idx = 1; Idx < LayersToBuild.Num(); Idx++)
 		{
-			BuildContext.log(RC_LOG_ERROR, "GenerateNavigationData: failed to decompress layer.");
-			return false;
+			LayerEvents.Add(TGraphTask<FRecastTileLayerTask>::CreateTask().ConstructAndDispatchWhenReady(*this, LayersToBuild[Idx], LayersNavigationData[Idx], LayersSucceeded[Idx]));
 		}
+		NumLayersOnThisThread = 1;
+	}
 
-		// Rasterize obstacles.
-		MarkDynamicAreas(*GenerationContext.Layer);
+	bool bSuccess = true;
+	for (int32 Idx = 0; Idx < NumLayersOnThisThread && bSuccess; Idx++)
+	{
+		LayersSucceeded[Idx] = GenerateNavigationDataLayer(BuildContext, LayersToBuild[Idx], LayersNavigationData[Idx]);
+		bSuccess = LayersSucceeded[Idx];
+	}
 
-		{
-			RECAST_STAT(STAT_Navigation_Async_Recast_BuildRegions)
-			// Build regions
-			if (TileConfig.TileCachePartitionType == RC_REGION_MONOTONE)
-			{
-				status = dtBuildTileCacheRegionsMonotone(&MyAllocator, *GenerationContext.Layer);
-			}
-			else if (TileConfig.TileCachePartitionType == RC_REGION_WATERSHED)
-			{
-				GenerationContext.DistanceField = dtAllocTileCacheDistanceField(&MyAllocator);
-				if (GenerationContext.DistanceField == NULL)
-				{
-					BuildContext.log(RC_LOG_ERROR, "GenerateNavigationData: Out of memory 'DistanceField'.");
-					return false;
-				}
+	if (LayerEvents.Num())
+	{
+		FTaskGraphInterface::Get().WaitUntilTasksComplete(LayerEvents);
+	}
 
-				status = dtBuildTileCacheDistanceField(&MyAllocator, *GenerationContext.Layer, *GenerationContext.DistanceField);
-				if (dtStatusFailed(status))
-				{
-					BuildContext.log(RC_LOG_ERROR, "GenerateNavigationData: Failed to build distance field.");
-					return false;
-				}
+	for (int32 Idx = 0; Idx < LayersSucceeded.Num() && bSuccess; Idx++)
+	{
+		bSuccess = LayersSucceeded[Idx];
+	}
 
-				const int TileBoderSize = 0;
-				status = dtBuildTileCacheRegions(&MyAllocator, TileBoderSize, TileConfig.minRegionArea, TileConfig.mergeRegionArea, *GenerationContext.Layer, *GenerationContext.DistanceField);
-			}
-			else
-			{
-				status = dtBuildTileCacheRegionsChunky(&MyAllocator, *GenerationContext.Layer, TileConfig.TileCacheChunkSize);
-			}
+	if (!bSuccess)
+	{
+		return false;
+	}
 
-			if (dtStatusFailed(status))
-			{
-				BuildContext.log(RC_LOG_ERROR, "GenerateNavigationData: Failed to build regions.");
-				return false;
-			}
+	// prepare navigation data of actually rebuild layers for transfer
+	NavigationData = LayersNavigationData;
+	return true;
+}
+
+bool FRecastTileGenerator::GenerateNavigationDataLayer(FNavMeshBuildContext& BuildContext, int32 LayerIdx, FNavMeshTileData& OutNavData)
+{
+	FTileCacheAllocator MyAllocator;
+	FTileCacheCompressor TileCompressor;
+
+	FTileGenerationContext GenerationContext(&MyAllocator);
+	dtStatus status = DT_SUCCESS;
+
+	FNavMeshTileData& CompressedData = CompressedLayers[LayerIdx];
+	const dtTileCacheLayerHeader* TileHeader = (const dtTileCacheLayerHeader*)CompressedData.GetData();
+
+	// Decompress tile layer data. 
+	status = dtDecompressTileCacheLayer(&MyAllocator, &TileCompressor, (unsigned char*)CompressedData.GetData(), CompressedData.DataSize, &GenerationContext.Layer);
+	if (dtStatusFailed(status))
+	{
+		BuildContext.log(RC_LOG_ERROR, "GenerateNavigationData: failed to decompress layer.");
+		return false;
+	}
+
+	// Rasterize obstacles.
+	MarkDynamicAreas(*GenerationContext.Layer);
+
+	{
+		RECAST_STAT(STAT_Navigation_Async_Recast_BuildRegions)
+		// Build regions
+		if (TileConfig.TileCachePartitionType == RC_REGION_MONOTONE)
+		{
+			status = dtBuildTileCacheRegionsMonotone(&MyAllocator, *GenerationContext.Layer);
 		}
-	
+		else if (TileConfig.TileCachePartitionType == RC_REGION_WATERSHED)
 		{
-			RECAST_STAT(STAT_Navigation_Async_Recast_BuildContours);
-			// Build contour set
-			GenerationContext.ContourSet = dtAllocTileCacheContourSet(&MyAllocator);
-			if (GenerationContext.ContourSet == NULL)
-			{
-				BuildContext.log(RC_LOG_ERROR, "GenerateNavigationData: Out of memory 'ContourSet'.");
-				return false;
-			}
-
-			GenerationContext.ClusterSet = dtAllocTileCacheClusterSet(&MyAllocator);
-			if (GenerationContext.ClusterSet == NULL)
+			GenerationContext.DistanceField = dtAllocTileCacheDistanceField(&MyAllocator);
+			if (GenerationContext.DistanceField == NULL)
 			{
-				BuildContext.log(RC_LOG_ERROR, "GenerateNavigationData: Out of memory 'ClusterSet'.");
+				BuildContext.log(RC_LOG_ERROR, "GenerateNavigationData: Out of memory 'DistanceField'.");
 				return false;
 			}
 
-			status = dtBuildTileCacheContours(&MyAllocator, *GenerationContext.Layer,
-				TileConfig.walkableClimb, TileConfig.maxSimplificationError, TileConfig.cs, TileConfig.ch,
-				*GenerationContext.ContourSet, *GenerationContext.ClusterSet);
+			status = dtBuildTileCacheDistanceField(&MyAllocator, *GenerationContext.Layer, *GenerationContext.DistanceField);
 			if (dtStatusFailed(status))
 			{
-				BuildContext.log(RC_LOG_ERROR, "GenerateNavigationData: Failed to generate contour set (0x%08X).", status);
+				BuildContext.log(RC_LOG_ERROR, "GenerateNavigationData: Failed to build distance field.");
 				return false;
 			}
+
+			const int TileBoderSize = 0;
+			status = dtBuildTileCacheRegions(&MyAllocator, TileBoderSize, TileConfig.minRegionArea, TileConfig.mergeRegionArea, *GenerationContext.Layer, *GenerationContext.DistanceField);
+		}
+		else
+		{
+			status = dtBuildTileCacheRegionsChunky(&MyAllocator, *GenerationContext.Layer, TileConfig.TileCacheChunkSize);
 		}
 
+		if (dtStatusFailed(status))
 		{
-			RECAST_STAT(STAT_Navigation_Async_Recast_BuildPolyMesh);
-			// Build poly mesh
-			GenerationContext.PolyMesh = dtAllocTileCachePolyMesh(&MyAllocator);
-			if (GenerationContext.PolyMesh == NULL)
-			{
-				BuildContext.log(RC_LOG_ERROR, "GenerateNavigationData: Out of memory 'PolyMesh'.");
-				return false;
-			}
+			BuildContext.log(RC_LOG_ERROR, "GenerateNavigationData: Failed to build regions.");
+			return false;
+		}
+	}
 
-			status = dtBuildTileCachePolyMesh(&MyAllocator, &BuildContext, *GenerationContext.ContourSet, *GenerationContext.PolyMesh);
-			if (dtStatusFailed(status))
-			{
-				BuildContext.log(RC_LOG_ERROR, "GenerateNavigationData: Failed to generate poly mesh.");
-				return false;
-			}
+	{
+		RECAST_STAT(STAT_Navigation_Async_Recast_BuildContours);
+		// Build contour set
+		GenerationContext.ContourSet = dtAllocTileCacheContourSet(&MyAllocator);
+		if (GenerationContext.ContourSet == NULL)
+		{
+			BuildContext.log(RC_LOG_ERROR, "GenerateNavigationData: Out of memory 'ContourSet'.");
+			return false;
+		}
 
-			status = dtBuildTileCacheClusters(&MyAllocator, *GenerationContext.ClusterSet, *GenerationContext.PolyMesh);
-			if (dtStatusFailed(status))
-			{
-				BuildContext.log(RC_LOG_ERROR, "GenerateNavigationData: Failed to update cluster set.");
-				return false;
-			}
+		GenerationContext.ClusterSet = dtAllocTileCacheClusterSet(&MyAllocator);
+		if (GenerationContext.ClusterSet == NULL)
+		{
+			BuildContext.log(RC_LOG_ERROR, "GenerateNavigationData: Out of memory 'ClusterSet'.");
+			return false;
 		}
 
-		// Build detail mesh
-		if (TileConfig.bGenerateDetailedMesh)
+		status = dtBuildTileCacheContours(&MyAllocator, *GenerationContext.Layer,
+			TileConfig.walkableClimb, TileConfig.maxSimplificationError, TileConfig.cs, TileConfig.ch,
+			*GenerationContext.ContourSet, *GenerationContext.ClusterSet);
+		if (dtStatusFailed(status))
 		{
-			RECAST_STAT(STAT_Navigation_Async_Recast_BuildPolyDetail);
+			BuildContext.log(RC_LOG_ERROR, "GenerateNavigationData: Failed to generate contour set (0x%08X).", status);
+			return false;
+		}
+	}
 
-			// Build detail mesh.
-			GenerationContext.DetailMesh = dtAllocTileCachePolyMeshDetail(&MyAllocator);
-			if (GenerationContext.DetailMesh == NULL)
-			{
-				BuildContext.log(RC_LOG_ERROR, "GenerateNavigationData: Out of memory 'DetailMesh'.");
-				return false;
-			}
+	{
+		RECAST_STAT(STAT_Navigation_Async_Recast_BuildPolyMesh);
+		// Build poly mesh
+		GenerationContext.PolyMesh = dtAllocTileCachePolyMesh(&MyAllocator);
+		if (GenerationContext.PolyMesh == NULL)
+		{
+			BuildContext.log(RC_LOG_ERROR, "GenerateNavigationData: Out of memory 'PolyMesh'.");
+			return false;
+		}
 
-			status = dtBuildTileCachePolyMeshDetail(&MyAllocator, TileConfig.cs, TileConfig.ch, TileConfig.detailSampleDist, TileConfig.detailSampleMaxError,
-				*GenerationContext.Layer, *GenerationContext.PolyMesh, *GenerationContext.DetailMesh);
-			if (dtStatusFailed(status))
-			{
-				BuildContext.log(RC_LOG_ERROR, "GenerateNavigationData: Failed to generate poly detail mesh.");
-				return false;
-			}
+		status = dtBuildTileCachePolyMesh(&MyAllocator, &BuildContext, *GenerationContext.ContourSet, *GenerationContext.PolyMesh);
+		if (dtStatusFailed(status))
+		{
+			BuildContext.log(RC_LOG_ERROR, "GenerateNavigationData: Failed to generate poly mesh.");
+			return false;
 		}
 
-		unsigned char* NavData = 0;
-		int32 NavDataSize = 0;
+		status = dtBuildTileCacheClusters(&MyAllocator, *GenerationContext.ClusterSet, *GenerationContext.PolyMesh);
+		if (dtStatusFailed(status))
+		{
+			BuildContext.log(RC_LOG_ERROR, "GenerateNavigationData: Failed to update cluster set.");
+			return false;
+		}
+	}
+
+	// Build detail mesh
+	if (TileConfig.bGenerateDetailedMesh)
+	{
+		RECAST_STAT(STAT_Navigation_Async_Recast_BuildPolyDetail);
 
-		if (TileConfig.maxVertsPerPoly <= DT_VERTS_PER_POLYGON &&
-			GenerationContext.PolyMesh->npolys > 0 && GenerationContext.PolyMesh->nverts > 0)
+		// Build detail mesh.
+		GenerationContext.DetailMesh = dtAllocTileCachePolyMeshDetail(&MyAllocator);
+		if (GenerationContext.DetailMesh == NULL)
 		{
-			ensure(GenerationContext.PolyMesh->npolys <= TileConfig.MaxPolysPerTile && "Polys per Tile limit exceeded!");
-			if (GenerationContext.PolyMesh->nverts >= 0xffff)
-			{
-				// The vertex indices are ushorts, and cannot point to more than 0xffff vertices.
-				BuildContext.log(RC_LOG_ERROR, "Too many vertices per tile %d (max: %d).", GenerationContext.PolyMesh->nverts, 0xffff);
-				return false;
-			}
+			BuildContext.log(RC_LOG_ERROR, "GenerateNavigationData: Out of memory 'DetailMesh'.");
+			return false;
+		}
 
-			// if we didn't failed already then it's hight time we created data for off-mesh links
-			FOffMeshData OffMeshData;
-			if (OffmeshLinks.Num() > 0)
-			{
-				RECAST_STAT(STAT_Navigation_Async_GatherOffMeshData);
+		status = dtBuildTileCachePolyMeshDetail(&MyAllocator, TileConfig.cs, TileConfig.ch, TileConfig.detailSampleDist, TileConfig.detailSampleMaxError,
+			*GenerationContext.Layer, *GenerationContext.PolyMesh, *GenerationContext.DetailMesh);
+		if (dtStatusFailed(status))
+		{
+			BuildContext.log(RC_LOG_ERROR, "GenerateNavigationData: Failed to generate poly detail mesh.");
+			return false;
+		}
+	}
 
-				OffMeshData.Reserve(OffmeshLinks.Num());
-				OffMeshData.AreaClassToIdMap = &AdditionalCachedData.AreaClassToIdMap;
-				OffMeshData.FlagsPerArea = AdditionalCachedData.FlagsPerOffMeshLinkArea;
-				const uint32 AgentMask = (1 << TileConfig.AgentIndex);
-				const FSimpleLinkNavModifier* LinkModifier = OffmeshLinks.GetData();
+	unsigned char* NavData = 0;
+	int32 NavDataSize = 0;
 
-				for (int32 LinkModifierIndex = 0; LinkModifierIndex < OffmeshLinks.Num(); ++LinkModifierIndex, ++LinkModifier)
-				{
-					OffMeshData.AddLinks(LinkModifier->Links, LinkModifier->LocalToWorld, AgentMask);
+	if (TileConfig.maxVertsPerPoly <= DT_VERTS_PER_POLYGON &&
+		GenerationContext.PolyMesh->npolys > 0 && GenerationContext.PolyMesh->nverts > 0)
+	{
+		ensure(GenerationContext.PolyMesh->npolys <= TileConfig.MaxPolysPerTile && "Polys per Tile limit exceeded!");
+		if (GenerationContext.PolyMesh->nverts >= 0xffff)
+		{
+			// The vertex indices are ushorts, and cannot point to more than 0xffff vertices.
+			BuildContext.log(RC_LOG_ERROR, "Too many vertices per tile %d (max: %d).", GenerationContext.PolyMesh->nverts, 0xffff);
+			return false;
+		}
+
+		// if we didn't failed already then it's hight time we created data for off-mesh links
+		FOffMeshData OffMeshData;
+		if (OffmeshLinks.Num() > 0)
+		{
+			RECAST_STAT(STAT_Navigation_Async_GatherOffMeshData);
+
+			OffMeshData.Reserve(OffmeshLinks.Num());
+			OffMeshData.AreaClassToIdMap = &AdditionalCachedData.AreaClassToIdMap;
+			OffMeshData.FlagsPerArea = AdditionalCachedData.FlagsPerOffMeshLinkArea;
+			const uint32 AgentMask = (1 << TileConfig.AgentIndex);
+			const FSimpleLinkNavModifier* LinkModifier = OffmeshLinks.GetData();
+
+			for (int32 LinkModifierIndex = 0; LinkModifierIndex < OffmeshLinks.Num(); ++LinkModifierIndex, ++LinkModifier)
+			{
+				OffMeshData.AddLinks(LinkModifier->Links, LinkModifier->LocalToWorld, AgentMask);
 #if GENERATE_SEGMENT_LINKS
-					OffMeshData.AddSegmentLinks(LinkModifier->SegmentLinks, LinkModifier->LocalToWorld, AgentMask);
+				OffMeshData.AddSegmentLinks(LinkModifier->SegmentLinks, LinkModifier->LocalToWorld, AgentMask);
 #endif // GENERATE_SEGMENT_LINKS
-				}
 			}
+		}
 
-			// fill flags, or else detour won't be able to find polygons
-			// Update poly flags from areas.
-			for (int32 i = 0; i < GenerationContext.PolyMesh->npolys; i++)
-			{
-				GenerationContext.PolyMesh->flags[i] = AdditionalCachedData.FlagsPerArea[GenerationContext.PolyMesh->areas[i]];
-			}
-
-			dtNavMeshCreateParams Params;
-			memset(&Params, 0, sizeof(Params));
-			Params.verts = GenerationContext.PolyMesh->verts;
-			Params.vertCount = GenerationContext.PolyMesh->nverts;
-			Params.polys = GenerationContext.PolyMesh->polys;
-			Params.polyAreas = GenerationContext.PolyMesh->areas;
-			Params.polyFlags = GenerationContext.PolyMesh->flags;
-			Params.polyCount = GenerationContext.PolyMesh->npolys;
-			Params.nvp = GenerationContext.PolyMesh->nvp;
-			if (TileConfig.bGenerateDetailedMesh)
-			{
-				Params.detailMeshes = GenerationContext.DetailMesh->meshes;
-				Params.detailVerts = GenerationContext.DetailMesh->verts;
-				Params.detailVertsCount = GenerationContext.DetailMesh->nverts;
-				Params.detailTris = GenerationContext.DetailMesh->tris;
-				Params.detailTriCount = GenerationContext.DetailMesh->ntris;
-			}
-			Params.offMeshCons = OffMeshData.LinkParams.GetData();
-			Params.offMeshConCount = OffMeshData.LinkParams.Num();
-			Params.walkableHeight = TileConfig.AgentHeight;
-			Params.walkableRadius = TileConfig.AgentRadius;
-			Params.walkableClimb = TileConfig.AgentMaxClimb;
-			Params.tileX = TileX;
-			Params.tileY = TileY;
-			Params.tileLayer = iLayer;
-			rcVcopy(Params.bmin, GenerationContext.Layer->header->bmin);
-			rcVcopy(Params.bmax, GenerationContext.Layer->header->bmax);
-			Params.cs = TileConfig.cs;
-			Params.ch = TileConfig.ch;
-			Params.buildBvTree = TileConfig.bGenerateBVTree;
+		// fill flags, or else detour won't be able to find polygons
+		// Update poly flags from areas.
+		for (int32 i = 0; i < GenerationContext.PolyMesh->npolys; i++)
+		{
+			GenerationContext.PolyMesh->flags[i] = AdditionalCachedData.FlagsPerArea[GenerationContext.PolyMesh->areas[i]];
+		}
+
+		dtNavMeshCreateParams Params;
+		memset(&Params, 0, sizeof(Params));
+		Params.verts = GenerationContext.PolyMesh->verts;
+		Params.vertCount = GenerationContext.PolyMesh->nverts;
+		Params.polys = GenerationContext.PolyMesh->polys;
+		Params.polyAreas = GenerationContext.PolyMesh->areas;
+		Params.polyFlags = GenerationContext.PolyMesh->flags;
+		Params.polyCount = GenerationContext.PolyMesh->npolys;
+		Params.nvp = GenerationContext.PolyMesh->nvp;
+		if (TileConfig.bGenerateDetailedMesh)
+		{
+			Params.detailMeshes = GenerationContext.DetailMesh->meshes;
+			Params.detailVerts = GenerationContext.DetailMesh->verts;
+			Params.detailVertsCount = GenerationContext.DetailMesh->nverts;
+			Params.detailTris = GenerationContext.DetailMesh->tris;
+			Params.detailTriCount = GenerationContext.DetailMesh->ntris;
+		}
+		Params.offMeshCons = OffMeshData.LinkParams.GetData();
+		Params.offMeshConCount = OffMeshData.LinkParams.Num();
+		Params.walkableHeight = TileConfig.AgentHeight;
+		Params.walkableRadius = TileConfig.AgentRadius;
+		Params.walkableClimb = TileConfig.AgentMaxClimb;
+		Params.tileX = TileX;
+		Params.tileY = TileY;
+		Params.tileLayer = LayerIdx;
+		rcVcopy(Params.bmin, GenerationContext.Layer->header->bmin);
+		rcVcopy(Params.bmax, GenerationContext.Layer->header->bmax);
+		Params.cs = TileConfig.cs;
+		Params.ch = TileConfig.ch;
+		Params.buildBvTree = TileConfig.bGenerateBVTree;
 #if GENERATE_CLUSTER_LINKS
-			Params.clusterCount = GenerationContext.ClusterSet->nclusters;
-			Params.polyClusters = GenerationContext.ClusterSet->polyMap;
+		Params.clusterCount = GenerationContext.ClusterSet->nclusters;
+		Params.polyClusters = GenerationContext.ClusterSet->polyMap;
 #endif
 
-			RECAST_STAT(STAT_Navigation_Async_Recast_CreateNavMeshData);
+		RECAST_STAT(STAT_Navigation_Async_Recast_CreateNavMeshData);
 
-			if (!dtCreateNavMeshData(&Params, &NavData, &NavDataSize))
-			{
-				BuildContext.log(RC_LOG_ERROR, "Could not build Detour navmesh.");
-				return false;
-			}
+		if (!dtCreateNavMeshData(&Params, &NavData, &NavDataSize))
+		{
+			BuildContext.log(RC_LOG_ERROR, "Could not build Detour navmesh.");
+			return false;
 		}
+	}
 
-		GenerationContext.NavigationData.Add(FNavMeshTileData(NavData, NavDataSize, iLayer, CompressedData.LayerBBox));
+	OutNavData = FNavMeshTileData(NavData, NavDataSize, LayerIdx, CompressedData.LayerBBox);
 
-		const float ModkB = 1.0f / 1024.0f;
-		BuildContext.log(RC_LOG_PROGRESS, ">> Layer[%d] = Verts(%d) Polys(%d) Memory(%.2fkB) Cache(%.2fkB)",
-			iLayer, GenerationContext.PolyMesh->nverts, GenerationContext.PolyMesh->npolys,
-			GenerationContext.NavigationData.Last().DataSize * ModkB, CompressedLayers[iLayer].DataSize * ModkB);
-	}
+	const float ModkB = 1.0f / 1024.0f;
+	BuildContext.log(RC_LOG_PROGRESS, ">> Layer[%d] = Verts(%d) Polys(%d) Memory(%.2fkB) Cache(%.2fkB)",
+		LayerIdx, GenerationContext.PolyMesh->nverts, GenerationContext.PolyMesh->npolys,
+		OutNavData.DataSize * ModkB, CompressedLayers[LayerIdx].DataSize * ModkB);
 
-	// prepare navigation data of actually rebuild layers for transfer
-	NavigationData = GenerationContext.NavigationData;
 	return true;
 }
 
@@ -2457,11 +2731,7 @@ void FRecastTileGenerator::MarkDynamicAreas(dtTileCacheLayer& Layer)
 	
 	RECAST_STAT(STAT_Navigation_Async_MarkAreas);
 
-	if (AdditionalCachedData.bUseSortFunction && AdditionalCachedData.ActorOwner && Modifiers.Num() > 1)
-	{
-		AdditionalCachedData.ActorOwner->SortAreasForGenerator(Modifiers);
-	}
-		
+	// modifiers are already sorted by GenerateNavigationData
 	for (const auto& Element : Modifiers)
 	{
 		for (const auto& Area : Element.Areas)
@@ -2674,6 +2944,7 @@ FRecastNavMeshGenerator::FRecastNavMeshGenerator(ARecastNavMesh& InDestNavMesh)
 	: NumActiveTiles(0),
 	  MaxTileGeneratorTasks(1),
 	  AvgLayersPerTile(8.0f),
+	  SortPendingTilesTimeLeft(0.0f),
 	  DestNavMesh(&InDestNavMesh),
 	  bInitialized(false),
 	  Version(0)
@@ -2981,12 +3252,23 @@ void FRecastNavMeshGenerator::TickAsyncBuild(float DeltaSeconds)
 	}
 #endif//WITH_EDITOR
 
+	// Agents move, keep tiles closest to them first in line
+	if (PendingDirtyTiles.Num() > 1)
+	{
+		SortPendingTilesTimeLeft -= DeltaSeconds;
+		if (SortPendingTilesTimeLeft <= 0.0f)
+		{
+			SortPendingBuildTiles();
+		}
+	}
+
 	// Submit async tile build tasks in case we have dirty tiles and have room for them
 	const UNavigationSystem* NavSys = UNavigationSystem::GetCurrent(GetWorld());
 	check(NavSys);
 	const int32 NumRunningTasks = NavSys->GetNumRunningBuildTasks();
 	const int32 NumTasksToSubmit = MaxTileGeneratorTasks - NumRunningTasks;
-	TArray<uint32> UpdatedTileIndices = ProcessTileTasks(NumTasksToSubmit);
+	const double AttachTimeBudget = CVarNavTileAttachBudget.GetValueOnGameThread() / 1000.0;
+	TArray<uint32> UpdatedTileIndices = ProcessTileTasks(NumTasksToSubmit, AttachTimeBudget);
 			
 	if (UpdatedTileIndices.Num() > 0)
 	{
@@ -3362,6 +3644,19 @@ void FRecastNavMeshGenerator::MarkDirtyTiles(const TArray<FNavigationDirtyArea>&
 		}
 	}
 	
+	// Results of running rebuilds are stale when their tile needs full rebuild again, don't spend time adding them to navmesh
+	for (FRunningTileElement& RunningElement : RunningDirtyTiles)
+	{
+		FPendingTileElement Element;
+		Element.Coord = RunningElement.Coord;
+
+		const FPendingTileElement* PendingElement = DirtyTiles.Find(Element);
+		if (PendingElement && PendingElement->bRebuildGeometry)
+		{
+			RunningElement.bShouldDiscard = true;
+		}
+	}
+	
 	// Dump results into array
 	PendingDirtyTiles.Empty(DirtyTiles.Num());
 	for(const FPendingTileElement& Element : DirtyTiles)
@@ -3369,7 +3664,7 @@ void FRecastNavMeshGenerator::MarkDirtyTiles(const TArray<FNavigationDirtyArea>&
 		PendingDirtyTiles.Add(Element);
 	}
 
-	// Sort tiles by proximity to players 
+	// Sort tiles by proximity to agents
 	if (NumTilesMarked > 0)
 	{
 		SortPendingBuildTiles();
@@ -3385,13 +3680,27 @@ void FRecastNavMeshGenerator::SortPendingBuildTiles()
 		return;
 	}
 
-	// Collect players positions
-	for (FConstPlayerControllerIterator PlayerIt = CurWorld->GetPlayerControllerIterator(); PlayerIt; ++PlayerIt)
+	SortPendingTilesTimeLeft = DestNavMesh->TileSetUpdateInterval;
+
+	// Collect agents positions, players included
+	for (FConstPawnIterator Iterator = CurWorld->GetPawnIterator(); Iterator; ++Iterator)
+	{
+		const APawn* Pawn = *Iterator;
+		if (Pawn)
+		{
+			SeedLocations.Add(FVector2D(Pawn->GetActorLocation()));
+		}
+	}
+
+	// and generation seeds registered with navigation system
+	const UNavigationSystem* NavSys = CurWorld->GetNavigationSystem();
+	if (NavSys)
 	{
-		if (*PlayerIt && (*PlayerIt)->GetPawn() != NULL)
+		TArray<FVector> GenerationSeeds;
+		NavSys->GetGenerationSeeds(GenerationSeeds);
+		for (const FVector& SeedLoc : GenerationSeeds)
 		{
-			const FVector2D SeedLoc((*PlayerIt)->GetPawn()->GetActorLocation());
-			SeedLocations.Add(SeedLoc);
+			SeedLocations.Add(FVector2D(SeedLoc));
 		}
 	}
 
@@ -3410,6 +3719,7 @@ void FRecastNavMeshGenerator::SortPendingBuildTiles()
 		{
 			const FBox TileBox = CalculateTileBounds(Element.Coord.X, Element.Coord.Y, FVector::ZeroVector, TotalNavBounds, TileSizeInWorldUnits);
 			FVector2D TileCenter2D = FVector2D(TileBox.GetCenter());
+			Element.SeedDistance = MAX_flt;
 			for (FVector2D SeedLocation : SeedLocations)
 			{
 				const float DistSq = FVector2D::DistSquared(TileCenter2D, SeedLocation);
@@ -3432,7 +3742,7 @@ TSharedRef<FRecastTileGenerator> FRecastNavMeshGenerator::CreateTileGenerator(co
 	return TileGenerator;
 }
 
-TArray<uint32> FRecastNavMeshGenerator::ProcessTileTasks(const int32 NumTasksToSubmit)
+TArray<uint32> FRecastNavMeshGenerator::ProcessTileTasks(const int32 NumTasksToSubmit, const double AttachTimeBudget)
 {
 	QUICK_SCOPE_CYCLE_COUNTER(STAT_RecastNavMeshGenerator_ProcessTileTasks);
 	
@@ -3483,17 +3793,29 @@ TArray<uint32> FRecastNavMeshGenerator::ProcessTileTasks(const int32 NumTasksToS
 		}
 	}
 	
-	// Collect completed tasks and apply generated data to navmesh
-	for (int32 Idx = RunningDirtyTiles.Num() - 1; Idx >=0; --Idx)
+	// Collect completed tasks and apply generated data to navmesh, tiles closest to agents were submitted first
+	const double AttachStartTime = FPlatformTime::Seconds();
+	int32 NumAttachedTasks = 0;
+	for (int32 Idx = 0; Idx < RunningDirtyTiles.Num();)
 	{
 		FRunningTileElement& Element = RunningDirtyTiles[Idx];
 		check(Element.AsyncTask);
 
-		if (Element.AsyncTask->IsDone())
+		if (!Element.AsyncTask->IsDone())
+		{
+			++Idx;
+		}
+		else if (!Element.bShouldDiscard && AttachTimeBudget > 0.0 && NumAttachedTasks > 0 && (FPlatformTime::Seconds() - AttachStartTime) >= AttachTimeBudget)
+		{
+			// Out of time, keep it for the next tick
+			++Idx;
+		}
+		else
 		{
 			// Add generated tiles to navmesh
 			if (!Element.bShouldDiscard)
 			{
+				NumAttachedTasks++;
 				const FRecastTileGenerator& TileGenerator = *(Element.AsyncTask->GetTask().TileGenerator);
 				TArray<uint32> UpdatedTileIndices = AddGeneratedTiles(TileGenerator);
 				UpdatedTiles.Append(UpdatedTileIndices);
@@ -125,6 +125,11 @@ FString FActorTickFunction::DiagnosticMessage()
 	return Target->GetFullName() + TEXT("[TickActor]");
 }
 
+AActor* FActorTickFunction::GetTickedActor() const
+{
+	return Target;
+}
+
 bool AActor::CheckDefaultSubobjectsInternal()
 {
 	bool Result = Super::CheckDefaultSubobjectsInternal();
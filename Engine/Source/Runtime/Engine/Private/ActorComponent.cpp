@@ -608,6 +608,11 @@ FString FActorComponentTickFunction::DiagnosticMessage()
 	return Target->GetFullName() + TEXT("[TickComponent]");
 }
 
+AActor* FActorComponentTickFunction::GetTickedActor() const
+{
+	return Target ? Target->GetOwner() : NULL;
+}
+
 bool UActorComponent::SetupActorComponentTickFunction(struct FTickFunction* TickFunction)
 {
 	AActor* Owner = GetOwner();
@@ -532,16 +532,12 @@ FVector UBrushComponent::GetCustomLocation() const
 	return LocationNoPivot;
 }
 
-FTransform UBrushComponent::CalcNewComponentToWorld(const FTransform& NewRelativeTransform, const USceneComponent* Parent) const
+void UBrushComponent::AdjustNewComponentToWorld(FTransform& NewComponentToWorld) const
 {
-	FTransform CompToWorld = Super::CalcNewComponentToWorld(NewRelativeTransform, Parent);
+	const FVector LocationNoPivot = NewComponentToWorld.GetLocation();
+	const FVector LocationWithPivot = LocationNoPivot + NewComponentToWorld.TransformVector(-PrePivot);
 
-	const FVector LocationNoPivot = CompToWorld.GetLocation();
-	const FVector LocationWithPivot = LocationNoPivot + CompToWorld.TransformVector(-PrePivot);
-
-	CompToWorld.SetLocation(LocationWithPivot);
-
-	return CompToWorld;
+	NewComponentToWorld.SetLocation(LocationWithPivot);
 }
 
 
@@ -43,6 +43,34 @@ static TAutoConsoleVariable<int32> CVarNetEnableMoveCombining(
 	TEXT("0: Disable, 1: Enable"),
 	ECVF_Default);
 
+static TAutoConsoleVariable<int32> CVarNetBatchServerMoves(
+	TEXT("p.NetBatchServerMoves"),
+	0,
+	TEXT("Whether the server queues the moves received from clients and simulates them once per frame, merging consecutive moves with the same input.\n")
+	TEXT("This bounds the cost of a character by the server tick rate rather than by the rate the client sends moves at.\n")
+	TEXT("0: Disable, 1: Enable"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarNetBatchServerMovesMaxMergedTime(
+	TEXT("p.NetBatchServerMovesMaxMergedTime"),
+	0.1f,
+	TEXT("Maximum time in seconds covered by client moves the server merges into one when batching moves (p.NetBatchServerMoves).\n")
+	TEXT("<= 0: never merge moves, > 0: merge up to this amount of time."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarFloorCache(
+	TEXT("p.FloorCache"),
+	1,
+	TEXT("Whether walking characters reuse the last floor found by a sweep while they stay in place on a static floor.\n")
+	TEXT("0: Disable, 1: Enable"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarFloorCacheTolerance(
+	TEXT("p.FloorCacheTolerance"),
+	0.1f,
+	TEXT("Horizontal distance a character can move from where its floor was found and still reuse it (see p.FloorCache)."),
+	ECVF_Default);
+
 static TAutoConsoleVariable<float> CVarNetProxyShrinkRadius(
 	TEXT("p.NetProxyShrinkRadius"),
 	0.01f,
@@ -75,6 +103,16 @@ static TAutoConsoleVariable<float> CVarNetCorrectionLifetime(
 	ECVF_Cheat);
 #endif // !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
 
+DECLARE_CYCLE_STAT(TEXT("Char Process Queued Server Moves"), STAT_CharacterProcessQueuedServerMoves, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Char Server Moves Received"), STAT_CharacterServerMovesReceived, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Char Server Moves Merged"), STAT_CharacterServerMovesMerged, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Char Server Moves Simulated"), STAT_CharacterServerMovesSimulated, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Char Floor Cache Hits"), STAT_CharacterFloorCacheHits, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Char Floor Sweeps"), STAT_CharacterFloorSweeps, STATGROUP_Game);
+
+// Client moves the server queues before simulating them regardless of the frame, so a client can't make it buffer an unbounded number of moves.
+static const int32 MAX_QUEUED_SERVER_MOVES = 32;
+
 // Version that does not use inverse sqrt estimate, for higher precision.
 FORCEINLINE FVector GetSafeNormalPrecise(const FVector& V)
 {
@@ -833,6 +871,9 @@ void UCharacterMovementComponent::TickComponent(float DeltaTime, enum ELevelTick
 		else if (CharacterOwner->GetRemoteRole() == ROLE_AutonomousProxy)
 		{
 			// Server ticking for remote client.
+			// Simulate the moves received from the client since last frame, if we batch them.
+			ProcessQueuedServerMoves();
+
 			// Between net updates from the client we need to update position if based on another object,
 			// otherwise the object will move on intermediate frames and we won't follow it.
 			MaybeUpdateBasedMovement(DeltaTime);
@@ -4366,15 +4407,24 @@ void UCharacterMovementComponent::FindFloor(const FVector& CapsuleLocation, FFin
 	float FloorSweepTraceDist = FMath::Max(MAX_FLOOR_DIST, MaxStepHeight + HeightCheckAdjust);
 	float FloorLineTraceDist = FloorSweepTraceDist;
 	bool bNeedToValidateFloor = true;
+	UCharacterMovementComponent* MutableThis = const_cast<UCharacterMovementComponent*>(this);
 	
 	// Sweep floor
 	if (FloorLineTraceDist > 0.f || FloorSweepTraceDist > 0.f)
 	{
-		UCharacterMovementComponent* MutableThis = const_cast<UCharacterMovementComponent*>(this);
-
 		if ( bAlwaysCheckFloor || !bZeroDelta || bForceNextFloorCheck || bJustTeleported )
 		{
+			// Small moves on a static floor (such as walking into a wall) can reuse the last floor, unless a new check was explicitly requested.
+			const bool bCanUseFloorCache = !bAlwaysCheckFloor && !bForceNextFloorCheck && !bJustTeleported && DownwardSweepResult == NULL;
 			MutableThis->bForceNextFloorCheck = false;
+
+			if (bCanUseFloorCache && GetCachedFloor(CapsuleLocation, OutFloorResult))
+			{
+				INC_DWORD_STAT(STAT_CharacterFloorCacheHits);
+				return;
+			}
+
+			INC_DWORD_STAT(STAT_CharacterFloorSweeps);
 			ComputeFloorDist(CapsuleLocation, FloorLineTraceDist, FloorSweepTraceDist, OutFloorResult, CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleRadius(), DownwardSweepResult);
 		}
 		else
@@ -4404,6 +4454,7 @@ void UCharacterMovementComponent::FindFloor(const FVector& CapsuleLocation, FFin
 			else
 			{
 				MutableThis->bForceNextFloorCheck = false;
+				INC_DWORD_STAT(STAT_CharacterFloorSweeps);
 				ComputeFloorDist(CapsuleLocation, FloorLineTraceDist, FloorSweepTraceDist, OutFloorResult, CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleRadius(), DownwardSweepResult);
 			}
 		}
@@ -4446,6 +4497,104 @@ void UCharacterMovementComponent::FindFloor(const FVector& CapsuleLocation, FFin
 			}
 		}
 	}
+
+	if (bNeedToValidateFloor)
+	{
+		MutableThis->SetCachedFloor(CapsuleLocation, OutFloorResult);
+	}
+}
+
+
+void UCharacterMovementComponent::InvalidateFloorCache()
+{
+	FloorCache.bValid = false;
+	FloorCache.FloorComponent = NULL;
+	FloorCache.Capsule = NULL;
+}
+
+
+bool UCharacterMovementComponent::CanCacheFloorOn(const UPrimitiveComponent* FloorComponent) const
+{
+	// Same conditions as skipping the floor check when not moving at all, see FindFloor()
+	return FloorComponent != NULL
+		&& FloorComponent->IsRegistered()
+		&& FloorComponent->Mobility != EComponentMobility::Movable
+		&& FloorComponent->IsCollisionEnabled()
+		&& FloorComponent->GetCollisionResponseToChannel(UpdatedComponent->GetCollisionObjectType()) == ECR_Block
+		&& !MovementBaseUtility::IsDynamicBase(FloorComponent)
+		&& Cast<const ADestructibleActor>(FloorComponent->GetOwner()) == NULL;
+}
+
+
+bool UCharacterMovementComponent::GetCachedFloor(const FVector& CapsuleLocation, FFindFloorResult& OutFloorResult) const
+{
+	if (!FloorCache.bValid || CVarFloorCache.GetValueOnGameThread() == 0 || FloorCache.bMovingOnGround != IsMovingOnGround())
+	{
+		return false;
+	}
+
+	// Invalidated by the floor moving or changing its collision
+	const UPrimitiveComponent* FloorComponent = FloorCache.FloorComponent.Get();
+	if (!CanCacheFloorOn(FloorComponent)
+		|| FloorComponent->GetComponentLocation() != FloorCache.FloorComponentLocation
+		|| !FloorComponent->GetComponentQuat().Equals(FloorCache.FloorComponentRotation, 0.f))
+	{
+		return false;
+	}
+
+	// Invalidated by our own collision shape changing
+	const UCapsuleComponent* Capsule = CharacterOwner->GetCapsuleComponent();
+	float CapsuleRadius, CapsuleHalfHeight;
+	Capsule->GetScaledCapsuleSize(CapsuleRadius, CapsuleHalfHeight);
+	if (Capsule != FloorCache.Capsule.Get() || CapsuleRadius != FloorCache.CapsuleRadius || CapsuleHalfHeight != FloorCache.CapsuleHalfHeight)
+	{
+		return false;
+	}
+
+	// Invalidated by moving
+	const FVector Delta = CapsuleLocation - FloorCache.CapsuleLocation;
+	const float Tolerance = CVarFloorCacheTolerance.GetValueOnGameThread();
+	if (Delta.SizeSquared2D() > FMath::Square(Tolerance))
+	{
+		return false;
+	}
+
+	// Over the same spot of a static floor, moving vertically only changes the distance to it.
+	// Don't bother with a floor we would now be penetrating or that could be out of range, the sweep handles those.
+	const float FloorDist = FloorCache.FloorResult.FloorDist + Delta.Z;
+	if (FloorDist < 0.f || FloorDist > MAX_FLOOR_DIST)
+	{
+		return false;
+	}
+
+	OutFloorResult = FloorCache.FloorResult;
+	OutFloorResult.FloorDist = FloorDist;
+	if (OutFloorResult.bLineTrace)
+	{
+		OutFloorResult.LineDist += Delta.Z;
+	}
+	return true;
+}
+
+
+void UCharacterMovementComponent::SetCachedFloor(const FVector& CapsuleLocation, const FFindFloorResult& FloorResult)
+{
+	UPrimitiveComponent* FloorComponent = FloorResult.HitResult.Component.Get();
+	if (!FloorResult.IsWalkableFloor() || !CanCacheFloorOn(FloorComponent))
+	{
+		InvalidateFloorCache();
+		return;
+	}
+
+	FloorCache.FloorResult = FloorResult;
+	FloorCache.FloorComponent = FloorComponent;
+	FloorCache.FloorComponentLocation = FloorComponent->GetComponentLocation();
+	FloorCache.FloorComponentRotation = FloorComponent->GetComponentQuat();
+	FloorCache.Capsule = CharacterOwner->GetCapsuleComponent();
+	FloorCache.CapsuleLocation = CapsuleLocation;
+	FloorCache.Capsule->GetScaledCapsuleSize(FloorCache.CapsuleRadius, FloorCache.CapsuleHalfHeight);
+	FloorCache.bMovingOnGround = IsMovingOnGround();
+	FloorCache.bValid = true;
 }
 
 
@@ -5207,14 +5356,26 @@ bool UCharacterMovementComponent::ClientUpdatePositionAfterServerUpdate()
 	CharacterOwner->bClientUpdating = true;
 	bForceNextFloorCheck = true;
 
+	// Only the result of the whole replay needs to be propagated to attached components and checked for overlaps,
+	// unless a move uses root motion, which is converted to world space with the mesh's current transform.
+	bool bDeferReplayUpdates = bEnableScopedMovementUpdates;
+	for (int32 i=0; i<ClientData->SavedMoves.Num() && bDeferReplayUpdates; i++)
+	{
+		bDeferReplayUpdates = !ClientData->SavedMoves[i]->RootMotionMontage.IsValid();
+	}
+
 	// Replay moves that have not yet been acked.
 	UE_LOG(LogNetPlayerMovement, VeryVerbose, TEXT("ClientUpdatePositionAfterServerUpdate Replaying Moves (%d)"), ClientData->SavedMoves.Num());
-	for (int32 i=0; i<ClientData->SavedMoves.Num(); i++)
 	{
-		const FSavedMovePtr& CurrentMove = ClientData->SavedMoves[i];
-		CurrentMove->PrepMoveFor(CharacterOwner);
-		MoveAutonomous(CurrentMove->TimeStamp, CurrentMove->DeltaTime, CurrentMove->GetCompressedFlags(), CurrentMove->Acceleration);
-		CurrentMove->PostUpdate(CharacterOwner, FSavedMove_Character::PostUpdate_Replay);
+		FScopedMovementUpdate ScopedReplayUpdate(UpdatedComponent, bDeferReplayUpdates ? EScopedUpdate::DeferredUpdates : EScopedUpdate::ImmediateUpdates);
+
+		for (int32 i=0; i<ClientData->SavedMoves.Num(); i++)
+		{
+			const FSavedMovePtr& CurrentMove = ClientData->SavedMoves[i];
+			CurrentMove->PrepMoveFor(CharacterOwner);
+			MoveAutonomous(CurrentMove->TimeStamp, CurrentMove->DeltaTime, CurrentMove->GetCompressedFlags(), CurrentMove->Acceleration);
+			CurrentMove->PostUpdate(CharacterOwner, FSavedMove_Character::PostUpdate_Replay);
+		}
 	}
 
 	if (ClientData->PendingMove.IsValid())
@@ -5609,8 +5770,33 @@ void UCharacterMovementComponent::ServerMoveOld_Implementation
 
 	UE_LOG(LogNetPlayerMovement, Log, TEXT("Recovered move from OldTimeStamp %f, DeltaTime: %f"), OldTimeStamp, OldTimeStamp - ServerData->CurrentClientTimeStamp);
 	const float MaxResponseTime = ServerData->MaxResponseTime * CharacterOwner->GetWorldSettings()->GetEffectiveTimeDilation();
+	const float DeltaTime = FMath::Min(OldTimeStamp - ServerData->CurrentClientTimeStamp, MaxResponseTime);
+
+	INC_DWORD_STAT(STAT_CharacterServerMovesReceived);
+
+	if (CVarNetBatchServerMoves.GetValueOnGameThread() != 0)
+	{
+		FQueuedServerMove_Character Move;
+		Move.TimeStamp = OldTimeStamp;
+		Move.DeltaTime = DeltaTime;
+		Move.Accel = OldAccel;
+		Move.ClientLoc = FVector(1.f,2.f,3.f);
+		Move.ViewRot = FRotator::ZeroRotator;
+		Move.ClientBaseBoneName = NAME_None;
+		Move.MoveFlags = OldMoveFlags;
+		Move.ClientMovementMode = 0;
+		Move.bOldMove = true;
+
+		ServerData->CurrentClientTimeStamp = OldTimeStamp;
+		QueueServerMove(*ServerData, Move);
+		return;
+	}
+
+	// Moves queued before batching was turned off must come first
+	ProcessQueuedServerMoves();
 
-	MoveAutonomous(OldTimeStamp, FMath::Min(OldTimeStamp - ServerData->CurrentClientTimeStamp, MaxResponseTime), OldMoveFlags, OldAccel);
+	INC_DWORD_STAT(STAT_CharacterServerMovesSimulated);
+	MoveAutonomous(OldTimeStamp, DeltaTime, OldMoveFlags, OldAccel);
 
 	ServerData->CurrentClientTimeStamp = OldTimeStamp;
 }
@@ -5692,6 +5878,8 @@ void UCharacterMovementComponent::ServerMove_Implementation(
 		return;
 	}
 
+	INC_DWORD_STAT(STAT_CharacterServerMovesReceived);
+
 	bool bServerReadyForClient = true;
 	APlayerController* PC = Cast<APlayerController>(CharacterOwner->GetController());
 	if (PC)
@@ -5718,6 +5906,27 @@ void UCharacterMovementComponent::ServerMove_Implementation(
 	ViewRot.Yaw = FRotator::DecompressAxisFromShort(ViewYaw);
 	ViewRot.Roll = FRotator::DecompressAxisFromByte(ClientRoll);
 
+	if (bServerReadyForClient && CVarNetBatchServerMoves.GetValueOnGameThread() != 0)
+	{
+		FQueuedServerMove_Character Move;
+		Move.TimeStamp = TimeStamp;
+		Move.DeltaTime = DeltaTime;
+		Move.Accel = Accel;
+		Move.ClientLoc = ClientLoc;
+		Move.ViewRot = ViewRot;
+		Move.ClientMovementBase = ClientMovementBase;
+		Move.ClientBaseBoneName = ClientBaseBoneName;
+		Move.MoveFlags = MoveFlags;
+		Move.ClientMovementMode = ClientMovementMode;
+		Move.bOldMove = false;
+
+		QueueServerMove(*ServerData, Move);
+		return;
+	}
+
+	// Moves queued before batching was turned off, or before the server stopped being ready for the client, must come first
+	ProcessQueuedServerMoves();
+
 	if (PC)
 	{
 		PC->SetControlRotation(ViewRot);
@@ -5736,6 +5945,7 @@ void UCharacterMovementComponent::ServerMove_Implementation(
 			PC->UpdateRotation(DeltaTime);
 		}
 
+		INC_DWORD_STAT(STAT_CharacterServerMovesSimulated);
 		MoveAutonomous(TimeStamp, DeltaTime, MoveFlags, Accel);
 	}
 
@@ -5746,6 +5956,102 @@ void UCharacterMovementComponent::ServerMove_Implementation(
 }
 
 
+void UCharacterMovementComponent::QueueServerMove(FNetworkPredictionData_Server_Character& ServerData, const FQueuedServerMove_Character& Move)
+{
+	ServerData.QueuedMoves.Add(Move);
+
+	if (ServerData.QueuedMoves.Num() >= MAX_QUEUED_SERVER_MOVES)
+	{
+		ProcessQueuedServerMoves();
+	}
+}
+
+
+/** Whether two consecutive queued client moves have the same input, so simulating them as one move gives (nearly) the same result. */
+static bool CanMergeQueuedServerMoves(const FQueuedServerMove_Character& Move, const FQueuedServerMove_Character& NextMove, float MaxMergedTime)
+{
+	return !Move.bOldMove && !NextMove.bOldMove
+		&& Move.DeltaTime > 0.f && NextMove.DeltaTime > 0.f
+		&& Move.DeltaTime + NextMove.DeltaTime <= MaxMergedTime
+		&& Move.MoveFlags == NextMove.MoveFlags
+		&& Move.Accel == NextMove.Accel
+		&& Move.ClientMovementMode == NextMove.ClientMovementMode
+		&& Move.ClientMovementBase == NextMove.ClientMovementBase
+		&& Move.ClientBaseBoneName == NextMove.ClientBaseBoneName;
+}
+
+
+void UCharacterMovementComponent::ProcessQueuedServerMoves()
+{
+	if (!HasPredictionData_Server())
+	{
+		return;
+	}
+
+	FNetworkPredictionData_Server_Character* ServerData = GetPredictionData_Server_Character();
+	TArray<FQueuedServerMove_Character>& QueuedMoves = ServerData->QueuedMoves;
+	if (QueuedMoves.Num() == 0)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_CharacterProcessQueuedServerMoves);
+
+	const float MaxMergedTime = CVarNetBatchServerMovesMaxMergedTime.GetValueOnGameThread();
+
+	for (int32 MoveIndex = 0; MoveIndex < QueuedMoves.Num() && HasValidData(); MoveIndex++)
+	{
+		FQueuedServerMove_Character Move = QueuedMoves[MoveIndex];
+
+		// Consecutive moves with the same input are simulated as one; the view and client location of the last one are the ones that matter
+		while (MoveIndex + 1 < QueuedMoves.Num() && CanMergeQueuedServerMoves(Move, QueuedMoves[MoveIndex + 1], MaxMergedTime))
+		{
+			const FQueuedServerMove_Character& NextMove = QueuedMoves[++MoveIndex];
+			Move.TimeStamp = NextMove.TimeStamp;
+			Move.DeltaTime += NextMove.DeltaTime;
+			Move.ClientLoc = NextMove.ClientLoc;
+			Move.ViewRot = NextMove.ViewRot;
+			INC_DWORD_STAT(STAT_CharacterServerMovesMerged);
+		}
+
+		if (Move.bOldMove)
+		{
+			INC_DWORD_STAT(STAT_CharacterServerMovesSimulated);
+			MoveAutonomous(Move.TimeStamp, Move.DeltaTime, Move.MoveFlags, Move.Accel);
+			continue;
+		}
+
+		APlayerController* PC = Cast<APlayerController>(CharacterOwner->GetController());
+		if (PC)
+		{
+			PC->SetControlRotation(Move.ViewRot);
+		}
+
+		if ((CharacterOwner->GetWorldSettings()->Pauser == NULL) && (Move.DeltaTime > 0.f))
+		{
+			if (PC)
+			{
+				PC->UpdateRotation(Move.DeltaTime);
+			}
+
+			INC_DWORD_STAT(STAT_CharacterServerMovesSimulated);
+			MoveAutonomous(Move.TimeStamp, Move.DeltaTime, Move.MoveFlags, Move.Accel);
+		}
+
+		// Only the most recent move is checked, a correction for it is all the client needs
+		if (MoveIndex == QueuedMoves.Num() - 1 && HasValidData())
+		{
+			UE_LOG(LogNetPlayerMovement, Verbose, TEXT("ServerMove (batched) Time %f Acceleration %s Position %s DeltaTime %f"),
+				Move.TimeStamp, *Move.Accel.ToString(), *CharacterOwner->GetActorLocation().ToString(), Move.DeltaTime);
+
+			ServerMoveHandleClientError(Move.TimeStamp, Move.DeltaTime, Move.Accel, Move.ClientLoc, Move.ClientMovementBase.Get(), Move.ClientBaseBoneName, Move.ClientMovementMode);
+		}
+	}
+
+	QueuedMoves.Reset();
+}
+
+
 void UCharacterMovementComponent::ServerMoveHandleClientError(float TimeStamp, float DeltaTime, const FVector& Accel, const FVector& RelativeClientLoc, UPrimitiveComponent* ClientMovementBase, FName ClientBaseBoneName, uint8 ClientMovementMode)
 {
 	if (RelativeClientLoc == FVector(1.f,2.f,3.f)) // first part of double servermove
@@ -5898,6 +6204,8 @@ void UCharacterMovementComponent::UpdateFloorFromAdjustment()
 		return;
 	}
 
+	InvalidateFloorCache();
+
 	// If walking, try to update the cached floor so it is current. This is necessary for UpdateBasedMovement() and MoveAlongFloor() to work properly.
 	// If base is now NULL, presumably we are no longer walking. If we had a valid floor but don't find one now, we'll likely start falling.
 	if (CharacterOwner->GetMovementBase())
@@ -5920,6 +6228,9 @@ void UCharacterMovementComponent::SendClientAdjustment()
 		return;
 	}
 
+	// Moves are normally processed by TickComponent, but it may have skipped its update this frame
+	ProcessQueuedServerMoves();
+
 	FNetworkPredictionData_Server_Character* ServerData = GetPredictionData_Server_Character();
 	check(ServerData);
 
@@ -0,0 +1,859 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	CollisionQueryBatch.cpp: Batched scene queries against a world's physics scene.
+=============================================================================*/
+
+#include "EnginePrivate.h"
+#include "PhysicsPublic.h"
+#include "Collision.h"
+#include "CollisionQueryBatch.h"
+
+#if WITH_PHYSX
+	#include "../PhysicsEngine/PhysXSupport.h"
+	#include "PhysXCollision.h"
+	#include "CollisionConversions.h"
+#endif
+
+DECLARE_CYCLE_STAT(TEXT("QueryBatch"), STAT_Collision_QueryBatch, STATGROUP_Collision);
+DECLARE_DWORD_COUNTER_STAT(TEXT("QueryBatch Queries"), STAT_Collision_QueryBatchQueries, STATGROUP_Collision);
+
+static TAutoConsoleVariable<int32> CVarCollisionQueryBatchChunkSize(
+	TEXT("p.CollisionQueryBatchChunkSize"),
+	128,
+	TEXT("Number of queries of a FCollisionQueryBatch run by each task of ExecuteAsync."),
+	ECVF_Default);
+
+/** Maximum number of components reported by one overlap query of a batch */
+#define MAX_BATCH_OVERLAP_TOUCHES	64
+
+#if WITH_PHYSX
+
+/** Number of physics scenes a batch can query: the sync scene, and the async scene if Params.bTraceAsyncScene is set */
+#define NUM_BATCH_QUERY_SCENES		2
+
+/** Set in word0 of the query filter of raycasts and sweeps, which only report their closest blocking hit (word0 is the ECollisionQuery type) */
+#define BATCH_QUERY_SINGLE_HIT_FLAG	0x80000000
+
+/**
+ * Batch query version of FPxQueryFilterCallback::preFilter.
+ * Batch queries only see filter data, which is enough since shapes store the ActorID of their component in word0.
+ * The constant block points to the IgnoreComponents of the batch's params.
+ */
+static PxQueryHitType::Enum CollisionQueryBatchPreFilter(PxFilterData QueryFilter, PxFilterData ShapeFilter, const void* ConstantBlock, PxU32 ConstantBlockSize, PxHitFlags& HitFlags)
+{
+	const TArray<uint32, TInlineAllocator<1> >& IgnoreComponents = **(const TArray<uint32, TInlineAllocator<1> >* const*)ConstantBlock;
+
+	// See if we are ignoring the actor this shape belongs to (word0 of shape filterdata is actorID)
+	if (IgnoreComponents.Contains(ShapeFilter.word0))
+	{
+		return PxQueryHitType::eNONE;
+	}
+
+	// First check complexity, none of them matches
+	const PxU32 CommonFlags = (ShapeFilter.word3 & 0xFFFFFF) & (QueryFilter.word3 & 0xFFFFFF);
+	if (!(CommonFlags & EPDF_SimpleCollision) && !(CommonFlags & EPDF_ComplexCollision))
+	{
+		return PxQueryHitType::eNONE;
+	}
+
+	const bool bSingleHit = (QueryFilter.word0 & BATCH_QUERY_SINGLE_HIT_FLAG) != 0;
+	QueryFilter.word0 &= ~BATCH_QUERY_SINGLE_HIT_FLAG;
+
+	PxQueryHitType::Enum Result = FPxQueryFilterCallback::CalcQueryHitType(QueryFilter, ShapeFilter, true);
+
+	if (bSingleHit && Result == PxQueryHitType::eTOUCH)
+	{
+		// Raycasts and sweeps have no touch buffer, a touch would be reported as blocking
+		Result = PxQueryHitType::eNONE;
+	}
+
+	return Result;
+}
+
+/** PhysX side of a FCollisionQueryBatch: result buffers and batch query objects for each scene */
+struct FCollisionQueryBatchBuffers
+{
+	struct FSceneBuffers
+	{
+		/** Results of each query type, indexed by FCollisionQueryBatch::TypeIndices */
+		TArray<PxRaycastQueryResult> RaycastResults;
+		TArray<PxSweepQueryResult> SweepResults;
+		TArray<PxOverlapQueryResult> OverlapResults;
+
+		/** MAX_BATCH_OVERLAP_TOUCHES touches per overlap query */
+		TArray<PxOverlapHit> OverlapTouches;
+
+		/** One batch query object per chunk, since issuing queries to a batch query object isn't thread safe */
+		TArray<PxBatchQuery*> BatchQueries;
+
+		/** Scene the batch query objects belong to */
+		PxScene* PScene;
+
+		/** Whether the current execution queries this scene */
+		bool bActive;
+
+		FSceneBuffers()
+			: PScene(NULL)
+			, bActive(false)
+		{
+		}
+	};
+
+	FSceneBuffers Scenes[NUM_BATCH_QUERY_SCENES];
+
+	/** World whose physics scene the batch query objects were created for */
+	TWeakObjectPtr<UWorld> World;
+	FPhysScene* PhysScene;
+
+	FCollisionQueryBatchBuffers()
+		: PhysScene(NULL)
+	{
+	}
+
+	~FCollisionQueryBatchBuffers()
+	{
+		ReleaseBatchQueries();
+	}
+
+	/**
+	 * Makes sure there are batch query objects for NumChunks chunks against the scenes of InWorld, and result buffers for the queries.
+	 * Creating batch query objects isn't thread safe, so this is done by the thread starting the execution.
+	 */
+	void Prepare(const UWorld* InWorld, bool bTraceAsyncScene, int32 NumChunks, const int32* NumQueriesOfType, const void* FilterShaderData, PxU32 FilterShaderDataSize)
+	{
+		FPhysScene* InPhysScene = InWorld ? InWorld->GetPhysicsScene() : NULL;
+
+		if (World.Get() != InWorld || PhysScene != InPhysScene)
+		{
+			ReleaseBatchQueries();
+			World = InWorld;
+			PhysScene = InPhysScene;
+		}
+
+		for (int32 SceneIndex = 0; SceneIndex < NUM_BATCH_QUERY_SCENES; SceneIndex++)
+		{
+			FSceneBuffers& SceneBuffers = Scenes[SceneIndex];
+			PxScene* PScene = NULL;
+
+			if (PhysScene != NULL)
+			{
+				if (SceneIndex == 0)
+				{
+					PScene = PhysScene->GetPhysXScene(PST_Sync);
+				}
+				else if (bTraceAsyncScene && PhysScene->HasAsyncScene())
+				{
+					PScene = PhysScene->GetPhysXScene(PST_Async);
+				}
+			}
+
+			SceneBuffers.bActive = (PScene != NULL);
+
+			if (PScene == NULL)
+			{
+				continue;
+			}
+
+			check(SceneBuffers.PScene == NULL || SceneBuffers.PScene == PScene);
+			SceneBuffers.PScene = PScene;
+
+			if (SceneBuffers.BatchQueries.Num() < NumChunks)
+			{
+				// Memory is given to the batch query objects for each execution
+				PxBatchQueryDesc PDesc(0, 0, 0);
+				PDesc.filterShaderData = const_cast<void*>(FilterShaderData);
+				PDesc.filterShaderDataSize = FilterShaderDataSize;
+				PDesc.preFilterShader = CollisionQueryBatchPreFilter;
+
+				SCOPED_SCENE_WRITE_LOCK(PScene);
+
+				while (SceneBuffers.BatchQueries.Num() < NumChunks)
+				{
+					SceneBuffers.BatchQueries.Add(PScene->createBatchQuery(PDesc));
+				}
+			}
+
+			// Buffers only grow
+			if (SceneBuffers.RaycastResults.Num() < NumQueriesOfType[ECollisionBatchQuery::Raycast])
+			{
+				SceneBuffers.RaycastResults.SetNumUninitialized(NumQueriesOfType[ECollisionBatchQuery::Raycast]);
+			}
+
+			if (SceneBuffers.SweepResults.Num() < NumQueriesOfType[ECollisionBatchQuery::Sweep])
+			{
+				SceneBuffers.SweepResults.SetNumUninitialized(NumQueriesOfType[ECollisionBatchQuery::Sweep]);
+			}
+
+			if (SceneBuffers.OverlapResults.Num() < NumQueriesOfType[ECollisionBatchQuery::Overlap])
+			{
+				SceneBuffers.OverlapResults.SetNumUninitialized(NumQueriesOfType[ECollisionBatchQuery::Overlap]);
+				SceneBuffers.OverlapTouches.SetNumUninitialized(NumQueriesOfType[ECollisionBatchQuery::Overlap] * MAX_BATCH_OVERLAP_TOUCHES);
+			}
+		}
+	}
+
+	/** Releases the batch query objects, unless their scene is gone already (PhysX releases them with the scene) */
+	void ReleaseBatchQueries()
+	{
+		const bool bSceneAlive = World.IsValid() && World->GetPhysicsScene() == PhysScene;
+
+		for (FSceneBuffers& SceneBuffers : Scenes)
+		{
+			if (bSceneAlive && SceneBuffers.PScene != NULL)
+			{
+				SCOPED_SCENE_WRITE_LOCK(SceneBuffers.PScene);
+
+				for (PxBatchQuery* PBatchQuery : SceneBuffers.BatchQueries)
+				{
+					PBatchQuery->release();
+				}
+			}
+
+			SceneBuffers.BatchQueries.Reset();
+			SceneBuffers.PScene = NULL;
+			SceneBuffers.bActive = false;
+		}
+
+		World.Reset();
+		PhysScene = NULL;
+	}
+};
+
+/** Util to add NewOverlap to the overlaps of one query (starting at FirstOverlap) if it is not already there, see AddUniqueOverlap */
+static void AddUniqueBatchOverlap(TArray<FOverlapResult>& OutOverlaps, int32 FirstOverlap, const FOverlapResult& NewOverlap)
+{
+	for (int32 TestIdx = FirstOverlap; TestIdx < OutOverlaps.Num(); TestIdx++)
+	{
+		FOverlapResult& Overlap = OutOverlaps[TestIdx];
+
+		if (Overlap.Component == NewOverlap.Component && Overlap.ItemIndex == NewOverlap.ItemIndex)
+		{
+			// If we had a non-blocking overlap with this component, but now we have a blocking one, use that one instead!
+			if (!Overlap.bBlockingHit && NewOverlap.bBlockingHit)
+			{
+				Overlap = NewOverlap;
+			}
+
+			return;
+		}
+	}
+
+	OutOverlaps.Add(NewOverlap);
+}
+
+#else
+
+struct FCollisionQueryBatchBuffers
+{
+};
+
+#endif // WITH_PHYSX
+
+/** Runs one chunk of a FCollisionQueryBatch::ExecuteAsync */
+class FCollisionQueryBatchChunkTask
+{
+	FCollisionQueryBatch& Batch;
+	int32 ChunkIndex;
+	int32 FirstQuery;
+	int32 NumQueries;
+
+public:
+	FCollisionQueryBatchChunkTask(FCollisionQueryBatch& InBatch, int32 InChunkIndex, int32 InFirstQuery, int32 InNumQueries)
+		: Batch(InBatch)
+		, ChunkIndex(InChunkIndex)
+		, FirstQuery(InFirstQuery)
+		, NumQueries(InNumQueries)
+	{
+	}
+
+	FORCEINLINE TStatId GetStatId() const
+	{
+		RETURN_QUICK_DECLARE_CYCLE_STAT(FCollisionQueryBatchChunkTask, STATGROUP_TaskGraphTasks);
+	}
+	static ENamedThreads::Type GetDesiredThread()
+	{
+		return ENamedThreads::AnyThread;
+	}
+	static ESubsequentsMode::Type GetSubsequentsMode()
+	{
+		return ESubsequentsMode::TrackSubsequents;
+	}
+	void DoTask(ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+	{
+		Batch.ExecuteChunk(ChunkIndex, FirstQuery, NumQueries);
+	}
+};
+
+/** Completes a FCollisionQueryBatch::ExecuteAsync once all chunks are done */
+class FCollisionQueryBatchGatherTask
+{
+	FCollisionQueryBatch& Batch;
+
+public:
+	FCollisionQueryBatchGatherTask(FCollisionQueryBatch& InBatch)
+		: Batch(InBatch)
+	{
+	}
+
+	FORCEINLINE TStatId GetStatId() const
+	{
+		RETURN_QUICK_DECLARE_CYCLE_STAT(FCollisionQueryBatchGatherTask, STATGROUP_TaskGraphTasks);
+	}
+	static ENamedThreads::Type GetDesiredThread()
+	{
+		return ENamedThreads::AnyThread;
+	}
+	static ESubsequentsMode::Type GetSubsequentsMode()
+	{
+		return ESubsequentsMode::TrackSubsequents;
+	}
+	void DoTask(ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+	{
+		Batch.GatherOverlaps();
+	}
+};
+
+/*-----------------------------------------------------------------------------
+	FCollisionQueryBatch.
+-----------------------------------------------------------------------------*/
+
+FCollisionQueryBatch::FCollisionQueryBatch()
+	: TraceChannel(ECC_Visibility)
+	, NumChunks(0)
+	, ChunkSize(0)
+	, Buffers(new FCollisionQueryBatchBuffers())
+{
+	FMemory::Memzero(NumQueriesOfType, sizeof(NumQueriesOfType));
+}
+
+FCollisionQueryBatch::~FCollisionQueryBatch()
+{
+	WaitForExecution();
+}
+
+void FCollisionQueryBatch::Init(ECollisionChannel InTraceChannel, const FCollisionQueryParams& InParams, const FCollisionResponseParams& InResponseParams, const FCollisionObjectQueryParams& InObjectParams)
+{
+	check(!IsExecuting());
+
+	TraceChannel = InTraceChannel;
+	Params = InParams;
+	ResponseParams = InResponseParams;
+	ObjectParams = InObjectParams;
+
+	Reset();
+}
+
+void FCollisionQueryBatch::Reset()
+{
+	check(!IsExecuting());
+
+	QueryTypes.Reset();
+	Starts.Reset();
+	Ends.Reset();
+	Rotations.Reset();
+	Shapes.Reset();
+	TypeIndices.Reset();
+	FMemory::Memzero(NumQueriesOfType, sizeof(NumQueriesOfType));
+
+	Hits.Reset();
+	OverlapRanges.Reset();
+	Overlaps.Reset();
+}
+
+int32 FCollisionQueryBatch::AddRaycast(const FVector& Start, const FVector& End)
+{
+	return AddQuery(ECollisionBatchQuery::Raycast, Start, End, FQuat::Identity, FCollisionShape::LineShape);
+}
+
+int32 FCollisionQueryBatch::AddSweep(const FVector& Start, const FVector& End, const FQuat& Rot, const FCollisionShape& Shape)
+{
+	if (Shape.ShapeType == ECollisionShape::Line || Shape.IsNearlyZero())
+	{
+		return AddQuery(ECollisionBatchQuery::Raycast, Start, End, FQuat::Identity, FCollisionShape::LineShape);
+	}
+
+	return AddQuery(ECollisionBatchQuery::Sweep, Start, End, Rot, Shape);
+}
+
+int32 FCollisionQueryBatch::AddOverlap(const FVector& Pos, const FQuat& Rot, const FCollisionShape& Shape)
+{
+	return AddQuery(ECollisionBatchQuery::Overlap, Pos, Pos, Rot, Shape);
+}
+
+int32 FCollisionQueryBatch::AddQuery(ECollisionBatchQuery::Type Type, const FVector& Start, const FVector& End, const FQuat& Rot, const FCollisionShape& Shape)
+{
+	check(!IsExecuting());
+
+	// Zero length raycasts and sweeps aren't run and report no hit, like the single query functions
+	const bool bRunQuery = (Type == ECollisionBatchQuery::Overlap) || ((End - Start).SizeSquared() > FMath::Square(KINDA_SMALL_NUMBER));
+
+	QueryTypes.Add((uint8)Type);
+	Starts.Add(Start);
+	Ends.Add(End);
+	Rotations.Add(Rot);
+	Shapes.Add(Shape);
+	TypeIndices.Add(bRunQuery ? NumQueriesOfType[Type]++ : INDEX_NONE);
+
+	return QueryTypes.Num() - 1;
+}
+
+void FCollisionQueryBatch::Execute(const UWorld* World)
+{
+	check(!IsExecuting());
+
+	PrepareExecution(World, 1, Num());
+	ExecuteChunk(0, 0, Num());
+	GatherOverlaps();
+}
+
+FGraphEventRef FCollisionQueryBatch::ExecuteAsync(const UWorld* World)
+{
+	check(!IsExecuting());
+
+	const int32 InChunkSize = FMath::Max(1, CVarCollisionQueryBatchChunkSize.GetValueOnAnyThread());
+	const int32 InNumChunks = FMath::Max(1, FMath::DivideAndRoundUp(Num(), InChunkSize));
+
+	PrepareExecution(World, InNumChunks, InChunkSize);
+
+	FGraphEventArray ChunkEvents;
+
+	for (int32 ChunkIndex = 0; ChunkIndex < NumChunks; ChunkIndex++)
+	{
+		const int32 FirstQuery = ChunkIndex * ChunkSize;
+		const int32 NumQueries = FMath::Min(ChunkSize, Num() - FirstQuery);
+
+		ChunkEvents.Add(TGraphTask<FCollisionQueryBatchChunkTask>::CreateTask().ConstructAndDispatchWhenReady(*this, ChunkIndex, FirstQuery, NumQueries));
+	}
+
+	PendingExecution = TGraphTask<FCollisionQueryBatchGatherTask>::CreateTask(&ChunkEvents).ConstructAndDispatchWhenReady(*this);
+
+	return PendingExecution;
+}
+
+void FCollisionQueryBatch::WaitForExecution()
+{
+	if (PendingExecution.GetReference())
+	{
+		FTaskGraphInterface::Get().WaitUntilTaskCompletes(PendingExecution);
+		PendingExecution = NULL;
+	}
+}
+
+void FCollisionQueryBatch::PrepareExecution(const UWorld* World, int32 InNumChunks, int32 InChunkSize)
+{
+	NumChunks = InNumChunks;
+	ChunkSize = InChunkSize;
+
+	// Each chunk only writes the results of its own queries, so the result arrays are sized up front
+	Hits.SetNum(Num(), false);
+	OverlapRanges.SetNumUninitialized(Num());
+
+	if (ChunkOverlaps.Num() < NumChunks)
+	{
+		ChunkOverlaps.SetNum(NumChunks);
+	}
+
+#if WITH_PHYSX
+	// The prefilter shader gets a copy of this pointer, Params lives as long as the batch query objects
+	const void* IgnoreComponents = &Params.IgnoreComponents;
+
+	Buffers->Prepare(World, Params.bTraceAsyncScene, NumChunks, NumQueriesOfType, &IgnoreComponents, sizeof(IgnoreComponents));
+#endif // WITH_PHYSX
+}
+
+void FCollisionQueryBatch::ExecuteChunk(int32 ChunkIndex, int32 FirstQuery, int32 NumQueries)
+{
+	SCOPE_CYCLE_COUNTER(STAT_Collision_QueryBatch);
+	INC_DWORD_STAT_BY(STAT_Collision_QueryBatchQueries, NumQueries);
+
+	TArray<FOverlapResult>& OutOverlaps = ChunkOverlaps[ChunkIndex];
+	OutOverlaps.Reset();
+
+	const int32 EndQuery = FirstQuery + NumQueries;
+
+	for (int32 QueryIndex = FirstQuery; QueryIndex < EndQuery; QueryIndex++)
+	{
+		FHitResult& Hit = Hits[QueryIndex];
+		Hit.Reset(1.f, false);
+		Hit.TraceStart = Starts[QueryIndex];
+		Hit.TraceEnd = Ends[QueryIndex];
+
+		OverlapRanges[QueryIndex].First = 0;
+		OverlapRanges[QueryIndex].Num = 0;
+	}
+
+#if WITH_PHYSX
+	// Find where the results of this chunk go in the buffers of each query type
+	int32 FirstOfType[3] = { 0, 0, 0 };
+	int32 NumOfType[3] = { 0, 0, 0 };
+
+	for (int32 QueryIndex = FirstQuery; QueryIndex < EndQuery; QueryIndex++)
+	{
+		const int32 TypeIndex = TypeIndices[QueryIndex];
+
+		if (TypeIndex != INDEX_NONE && NumOfType[QueryTypes[QueryIndex]]++ == 0)
+		{
+			FirstOfType[QueryTypes[QueryIndex]] = TypeIndex;
+		}
+	}
+
+	// Create filter data used to filter collisions
+	const PxFilterData PFilter = CreateQueryFilterData(TraceChannel, Params.bTraceComplex, ResponseParams.CollisionResponse, ObjectParams, false);
+	const PxFilterData POverlapFilter = CreateQueryFilterData(TraceChannel, Params.bTraceComplex, ResponseParams.CollisionResponse, ObjectParams, true);
+	PxFilterData PSingleHitFilter = PFilter;
+	PSingleHitFilter.word0 |= BATCH_QUERY_SINGLE_HIT_FLAG;
+
+	const PxQueryFilterData PTraceQueryFilterData(PSingleHitFilter, PxQueryFlag::eSTATIC | PxQueryFlag::eDYNAMIC | PxQueryFlag::ePREFILTER);
+	// Overlaps have no blocking hit, every overlapping shape is reported as a touch
+	const PxQueryFilterData POverlapQueryFilterData(POverlapFilter, PxQueryFlag::eSTATIC | PxQueryFlag::eDYNAMIC | PxQueryFlag::ePREFILTER | PxQueryFlag::eNO_BLOCK);
+	const PxHitFlags POutputFlags = PxHitFlag::ePOSITION | PxHitFlag::eNORMAL | PxHitFlag::eDISTANCE | PxHitFlag::eMTD;
+
+	// Scenes stay locked until the results are converted, since the conversion reads the hit shapes
+	PxScene* LockedScenes[NUM_BATCH_QUERY_SCENES] = { NULL, NULL };
+
+	for (int32 SceneIndex = 0; SceneIndex < NUM_BATCH_QUERY_SCENES; SceneIndex++)
+	{
+		FCollisionQueryBatchBuffers::FSceneBuffers& SceneBuffers = Buffers->Scenes[SceneIndex];
+
+		if (!SceneBuffers.bActive)
+		{
+			continue;
+		}
+
+		PxBatchQueryMemory PMemory(NumOfType[ECollisionBatchQuery::Raycast], NumOfType[ECollisionBatchQuery::Sweep], NumOfType[ECollisionBatchQuery::Overlap]);
+		PMemory.userRaycastResultBuffer = SceneBuffers.RaycastResults.GetData() + FirstOfType[ECollisionBatchQuery::Raycast];
+		PMemory.userSweepResultBuffer = SceneBuffers.SweepResults.GetData() + FirstOfType[ECollisionBatchQuery::Sweep];
+		PMemory.userOverlapResultBuffer = SceneBuffers.OverlapResults.GetData() + FirstOfType[ECollisionBatchQuery::Overlap];
+		PMemory.userOverlapTouchBuffer = SceneBuffers.OverlapTouches.GetData() + FirstOfType[ECollisionBatchQuery::Overlap] * MAX_BATCH_OVERLAP_TOUCHES;
+		PMemory.overlapTouchBufferSize = NumOfType[ECollisionBatchQuery::Overlap] * MAX_BATCH_OVERLAP_TOUCHES;
+
+		PxBatchQuery* PBatchQuery = SceneBuffers.BatchQueries[ChunkIndex];
+		PBatchQuery->setUserMemory(PMemory);
+
+		SCENE_LOCK_READ(SceneBuffers.PScene);
+		LockedScenes[SceneIndex] = SceneBuffers.PScene;
+
+		for (int32 QueryIndex = FirstQuery; QueryIndex < EndQuery; QueryIndex++)
+		{
+			if (TypeIndices[QueryIndex] == INDEX_NONE)
+			{
+				continue;
+			}
+
+			const FVector& Start = Starts[QueryIndex];
+			const FVector Delta = Ends[QueryIndex] - Start;
+			const float DeltaMag = Delta.Size();
+
+			switch (QueryTypes[QueryIndex])
+			{
+			case ECollisionBatchQuery::Raycast:
+				PBatchQuery->raycast(U2PVector(Start), U2PVector(Delta / DeltaMag), DeltaMag, 0, POutputFlags, PTraceQueryFilterData);
+				break;
+
+			case ECollisionBatchQuery::Sweep:
+				{
+					// The geometry is copied by the batch query
+					FPhysXShapeAdaptor ShapeAdaptor(Rotations[QueryIndex], Shapes[QueryIndex]);
+					PBatchQuery->sweep(ShapeAdaptor.GetGeometry(), ShapeAdaptor.GetGeomPose(Start), U2PVector(Delta / DeltaMag), DeltaMag, 0, POutputFlags, PTraceQueryFilterData);
+				}
+				break;
+
+			case ECollisionBatchQuery::Overlap:
+				{
+					FPhysXShapeAdaptor ShapeAdaptor(Rotations[QueryIndex], Shapes[QueryIndex]);
+					PBatchQuery->overlap(ShapeAdaptor.GetGeometry(), ShapeAdaptor.GetGeomPose(Start), MAX_BATCH_OVERLAP_TOUCHES, POverlapQueryFilterData);
+				}
+				break;
+			}
+		}
+
+		PBatchQuery->execute();
+	}
+
+	// Convert the results
+	for (int32 QueryIndex = FirstQuery; QueryIndex < EndQuery; QueryIndex++)
+	{
+		const int32 TypeIndex = TypeIndices[QueryIndex];
+
+		if (TypeIndex == INDEX_NONE)
+		{
+			continue;
+		}
+
+		const FVector& Start = Starts[QueryIndex];
+		const FVector& End = Ends[QueryIndex];
+		const uint8 QueryType = QueryTypes[QueryIndex];
+		FHitResult& Hit = Hits[QueryIndex];
+
+		if (QueryType == ECollisionBatchQuery::Overlap)
+		{
+			FOverlapRange& Range = OverlapRanges[QueryIndex];
+			Range.First = OutOverlaps.Num();
+
+			for (int32 SceneIndex = 0; SceneIndex < NUM_BATCH_QUERY_SCENES; SceneIndex++)
+			{
+				if (!Buffers->Scenes[SceneIndex].bActive)
+				{
+					continue;
+				}
+
+				const PxOverlapQueryResult& PResult = Buffers->Scenes[SceneIndex].OverlapResults[TypeIndex];
+
+				if (PResult.queryStatus == PxBatchQueryStatus::eOVERFLOW)
+				{
+					UE_LOG(LogCollision, Warning, TEXT("FCollisionQueryBatch : Overlap query found more than %d shapes, results are incomplete"), MAX_BATCH_OVERLAP_TOUCHES);
+					UE_LOG(LogCollision, Warning, TEXT("--------TraceChannel : %d"), (int32)TraceChannel);
+					UE_LOG(LogCollision, Warning, TEXT("--------%s"), *Params.ToString());
+				}
+
+				for (PxU32 HitIndex = 0; HitIndex < PResult.getNbAnyHits(); HitIndex++)
+				{
+					const PxOverlapHit& PHit = PResult.getAnyHit(HitIndex);
+
+					FOverlapResult NewOverlap;
+					ConvertQueryOverlap(PHit.shape, PHit.actor, NewOverlap, POverlapFilter);
+
+					if (NewOverlap.bBlockingHit)
+					{
+						Hit.bBlockingHit = true;
+					}
+
+					AddUniqueBatchOverlap(OutOverlaps, Range.First, NewOverlap);
+				}
+			}
+
+			Range.Num = OutOverlaps.Num() - Range.First;
+		}
+		else
+		{
+			// If both scenes have a blocking hit, the first one becomes the blocking hit, as in RaycastSingle/GeomSweepSingle
+			const PxLocationHit* PBestHit = NULL;
+
+			for (int32 SceneIndex = 0; SceneIndex < NUM_BATCH_QUERY_SCENES; SceneIndex++)
+			{
+				const FCollisionQueryBatchBuffers::FSceneBuffers& SceneBuffers = Buffers->Scenes[SceneIndex];
+
+				if (!SceneBuffers.bActive)
+				{
+					continue;
+				}
+
+				bool bHasBlock;
+				const PxLocationHit* PHit;
+
+				if (QueryType == ECollisionBatchQuery::Raycast)
+				{
+					bHasBlock = SceneBuffers.RaycastResults[TypeIndex].hasBlock;
+					PHit = &SceneBuffers.RaycastResults[TypeIndex].block;
+				}
+				else
+				{
+					bHasBlock = SceneBuffers.SweepResults[TypeIndex].hasBlock;
+					PHit = &SceneBuffers.SweepResults[TypeIndex].block;
+				}
+
+				if (bHasBlock && (PBestHit == NULL || PHit->distance < PBestHit->distance))
+				{
+					PBestHit = PHit;
+				}
+			}
+
+			if (PBestHit != NULL)
+			{
+				const float DeltaMag = (End - Start).Size();
+
+				if (QueryType == ECollisionBatchQuery::Raycast)
+				{
+					PxTransform PStartTM(U2PVector(Start));
+					ConvertQueryImpactHit(*PBestHit, Hit, DeltaMag, PFilter, Start, End, NULL, PStartTM, Params.bReturnFaceIndex, Params.bReturnPhysicalMaterial);
+				}
+				else
+				{
+					FPhysXShapeAdaptor ShapeAdaptor(Rotations[QueryIndex], Shapes[QueryIndex]);
+					ConvertQueryImpactHit(*PBestHit, Hit, DeltaMag, PFilter, Start, End, &ShapeAdaptor.GetGeometry(), ShapeAdaptor.GetGeomPose(Start), false, Params.bReturnPhysicalMaterial);
+				}
+			}
+		}
+	}
+
+	for (PxScene* LockedScene : LockedScenes)
+	{
+		SCENE_UNLOCK_READ(LockedScene);
+	}
+#endif // WITH_PHYSX
+
+	//@TODO: BOX2D: Implement batched queries
+}
+
+void FCollisionQueryBatch::GatherOverlaps()
+{
+	Overlaps.Reset();
+
+	for (int32 ChunkIndex = 0; ChunkIndex < NumChunks; ChunkIndex++)
+	{
+		const int32 ChunkFirstOverlap = Overlaps.Num();
+		Overlaps.Append(ChunkOverlaps[ChunkIndex]);
+
+		const int32 FirstQuery = ChunkIndex * ChunkSize;
+		const int32 EndQuery = FMath::Min(FirstQuery + ChunkSize, Num());
+
+		for (int32 QueryIndex = FirstQuery; QueryIndex < EndQuery; QueryIndex++)
+		{
+			OverlapRanges[QueryIndex].First += ChunkFirstOverlap;
+		}
+	}
+}
+
+#if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
+/**
+ * Measures the throughput of single scene queries against the same queries run through a FCollisionQueryBatch,
+ * with random queries around the first player's view point.
+ *
+ * Usage: p.CollisionQueryBatchBenchmark [NumQueries=1024] [Iterations=10]
+ */
+static void CollisionQueryBatchBenchmark(const TArray<FString>& Args, UWorld* World)
+{
+	static const FName NAME_CollisionQueryBatchBenchmark = FName(TEXT("CollisionQueryBatchBenchmark"));
+	static const TCHAR* QueryTypeNames[] = { TEXT("Raycast"), TEXT("Sweep"), TEXT("Overlap") };
+
+	if (World == NULL || World->GetPhysicsScene() == NULL)
+	{
+		UE_LOG(LogCollision, Warning, TEXT("CollisionQueryBatchBenchmark: No physics scene to query"));
+		return;
+	}
+
+	const int32 NumQueries = (Args.Num() > 0) ? FMath::Max(1, FCString::Atoi(*Args[0])) : 1024;
+	const int32 Iterations = (Args.Num() > 1) ? FMath::Max(1, FCString::Atoi(*Args[1])) : 10;
+	const float QueryLength = 10000.f;
+
+	FVector Origin(0.f);
+	APlayerController* PlayerController = World->GetFirstPlayerController();
+
+	if (PlayerController != NULL)
+	{
+		FRotator ViewRotation;
+		PlayerController->GetPlayerViewPoint(Origin, ViewRotation);
+	}
+
+	// Same queries for every run
+	FRandomStream RandomStream(0);
+	TArray<FVector> Ends;
+	TArray<FVector> OverlapPositions;
+
+	for (int32 QueryIndex = 0; QueryIndex < NumQueries; QueryIndex++)
+	{
+		Ends.Add(Origin + RandomStream.GetUnitVector() * QueryLength);
+		OverlapPositions.Add(Origin + RandomStream.GetUnitVector() * RandomStream.FRand() * QueryLength);
+	}
+
+	const FCollisionQueryParams Params(NAME_CollisionQueryBatchBenchmark, false);
+	FCollisionShape SweepShape;
+	SweepShape.SetSphere(30.f);
+	FCollisionShape OverlapShape;
+	OverlapShape.SetSphere(500.f);
+
+	FCollisionQueryBatch Batch;
+	FHitResult Hit;
+	TArray<FOverlapResult> Overlaps;
+	int32 NumHits[3] = { 0, 0, 0 };
+
+	UE_LOG(LogCollision, Display, TEXT("CollisionQueryBatchBenchmark: %d queries x %d iterations from %s"), NumQueries, Iterations, *Origin.ToString());
+
+	for (int32 Type = ECollisionBatchQuery::Raycast; Type <= ECollisionBatchQuery::Overlap; Type++)
+	{
+		// Single queries
+		double StartTime = FPlatformTime::Seconds();
+
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			NumHits[0] = 0;
+
+			for (int32 QueryIndex = 0; QueryIndex < NumQueries; QueryIndex++)
+			{
+				bool bHit = false;
+
+				switch (Type)
+				{
+				case ECollisionBatchQuery::Raycast:
+					bHit = World->LineTraceSingle(Hit, Origin, Ends[QueryIndex], ECC_Visibility, Params);
+					break;
+				case ECollisionBatchQuery::Sweep:
+					bHit = World->SweepSingle(Hit, Origin, Ends[QueryIndex], FQuat::Identity, ECC_Visibility, SweepShape, Params);
+					break;
+				case ECollisionBatchQuery::Overlap:
+					Overlaps.Reset();
+					World->OverlapMulti(Overlaps, OverlapPositions[QueryIndex], FQuat::Identity, ECC_Visibility, OverlapShape, Params);
+					bHit = Overlaps.Num() > 0;
+					break;
+				}
+
+				NumHits[0] += bHit ? 1 : 0;
+			}
+		}
+
+		const double SingleTime = FPlatformTime::Seconds() - StartTime;
+
+		// Batched, on this thread and then on worker threads
+		double BatchTimes[2];
+
+		for (int32 bAsync = 0; bAsync < 2; bAsync++)
+		{
+			StartTime = FPlatformTime::Seconds();
+
+			for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+			{
+				Batch.Init(ECC_Visibility, Params);
+
+				for (int32 QueryIndex = 0; QueryIndex < NumQueries; QueryIndex++)
+				{
+					switch (Type)
+					{
+					case ECollisionBatchQuery::Raycast:
+						Batch.AddRaycast(Origin, Ends[QueryIndex]);
+						break;
+					case ECollisionBatchQuery::Sweep:
+						Batch.AddSweep(Origin, Ends[QueryIndex], FQuat::Identity, SweepShape);
+						break;
+					case ECollisionBatchQuery::Overlap:
+						Batch.AddOverlap(OverlapPositions[QueryIndex], FQuat::Identity, OverlapShape);
+						break;
+					}
+				}
+
+				if (bAsync)
+				{
+					Batch.ExecuteAsync(World);
+					Batch.WaitForExecution();
+				}
+				else
+				{
+					Batch.Execute(World);
+				}
+
+				NumHits[1 + bAsync] = 0;
+
+				for (int32 QueryIndex = 0; QueryIndex < NumQueries; QueryIndex++)
+				{
+					const bool bHit = (Type == ECollisionBatchQuery::Overlap) ? Batch.GetNumOverlaps(QueryIndex) > 0 : Batch.GetHit(QueryIndex).bBlockingHit;
+					NumHits[1 + bAsync] += bHit ? 1 : 0;
+				}
+			}
+
+			BatchTimes[bAsync] = FPlatformTime::Seconds() - StartTime;
+		}
+
+		const double TotalQueries = (double)NumQueries * Iterations;
+
+		UE_LOG(LogCollision, Display, TEXT("%s: single %.0f queries/s, batch %.0f queries/s, async batch %.0f queries/s (%d/%d/%d queries hit)"),
+			QueryTypeNames[Type], TotalQueries / FMath::Max(SingleTime, SMALL_NUMBER), TotalQueries / FMath::Max(BatchTimes[0], SMALL_NUMBER), TotalQueries / FMath::Max(BatchTimes[1], SMALL_NUMBER),
+			NumHits[0], NumHits[1], NumHits[2]);
+	}
+}
+
+FAutoConsoleCommandWithWorldAndArgs CollisionQueryBatchBenchmarkCommand(
+	TEXT("p.CollisionQueryBatchBenchmark"),
+	TEXT("Compares queries per second of single scene queries and FCollisionQueryBatch. Usage: p.CollisionQueryBatchBenchmark [NumQueries] [Iterations]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(CollisionQueryBatchBenchmark)
+	);
+#endif // !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
@@ -0,0 +1,217 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	OverlapUpdateBatch.cpp: Deferred, parallel UpdateOverlaps for a tick group.
+=============================================================================*/
+
+#include "EnginePrivate.h"
+#include "OverlapUpdateBatch.h"
+
+DECLARE_CYCLE_STAT(TEXT("UpdateOverlaps Batch"), STAT_UpdateOverlapsBatch, STATGROUP_Game);
+DECLARE_CYCLE_STAT(TEXT("UpdateOverlaps Batch Queries"), STAT_UpdateOverlapsBatchQueries, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("UpdateOverlaps Batched"), STAT_UpdateOverlapsBatched, STATGROUP_Game);
+
+static TAutoConsoleVariable<int32> CVarParallelUpdateOverlaps(
+	TEXT("p.ParallelUpdateOverlaps"),
+	0,
+	TEXT("Whether the overlap updates of moved components are deferred to the end of their tick group, to run their overlap queries in parallel.\n")
+	TEXT("0: update overlaps right away (default), 1: batch overlap updates per tick group"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarParallelUpdateOverlapsChunkSize(
+	TEXT("p.ParallelUpdateOverlapsChunkSize"),
+	16,
+	TEXT("Number of overlap queries run by each task when p.ParallelUpdateOverlaps is set. Batches of a single chunk run on the game thread."),
+	ECVF_Default);
+
+/** Runs a chunk of the overlap queries of the batch */
+class FOverlapUpdateBatchTask
+{
+	FOverlapUpdateBatch& Batch;
+	int32 First;
+	int32 Num;
+
+public:
+	FOverlapUpdateBatchTask(FOverlapUpdateBatch& InBatch, int32 InFirst, int32 InNum)
+		: Batch(InBatch)
+		, First(InFirst)
+		, Num(InNum)
+	{
+	}
+
+	FORCEINLINE TStatId GetStatId() const
+	{
+		RETURN_QUICK_DECLARE_CYCLE_STAT(FOverlapUpdateBatchTask, STATGROUP_TaskGraphTasks);
+	}
+	static ENamedThreads::Type GetDesiredThread()
+	{
+		return ENamedThreads::AnyThread;
+	}
+	static ESubsequentsMode::Type GetSubsequentsMode()
+	{
+		return ESubsequentsMode::TrackSubsequents;
+	}
+	void DoTask(ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+	{
+		Batch.RunQueries(First, Num);
+	}
+};
+
+FOverlapUpdateBatch& FOverlapUpdateBatch::Get()
+{
+	static FOverlapUpdateBatch Batch;
+	return Batch;
+}
+
+void FOverlapUpdateBatch::Open(UWorld* InWorld)
+{
+	check(IsInGameThread());
+
+	FOverlapUpdateBatch& Batch = Get();
+	if (Batch.World)
+	{
+		// A batch left open by a tick group that didn't flush it
+		Flush();
+	}
+
+	if (CVarParallelUpdateOverlaps.GetValueOnGameThread() != 0)
+	{
+		Batch.World = InWorld;
+	}
+}
+
+bool FOverlapUpdateBatch::Defer(UPrimitiveComponent* Component, TArray<FOverlapInfo> const* PendingOverlaps, bool bDoNotifies, const TArray<FOverlapInfo>* OverlapsAtEndLocation)
+{
+	FOverlapUpdateBatch& Batch = Get();
+	if (Batch.World == NULL || !IsInGameThread() || Component->GetWorld() != Batch.World)
+	{
+		return false;
+	}
+
+	int32* ExistingIndex = Batch.UpdateIndices.Find(Component);
+	int32 UpdateIndex;
+	if (ExistingIndex)
+	{
+		UpdateIndex = *ExistingIndex;
+	}
+	else
+	{
+		UpdateIndex = Batch.Updates.Num();
+		new(Batch.Updates) FDeferredUpdate(Component);
+		Batch.UpdateIndices.Add(Component, UpdateIndex);
+		INC_DWORD_STAT(STAT_UpdateOverlapsBatched);
+	}
+
+	FDeferredUpdate& Update = Batch.Updates[UpdateIndex];
+	if (PendingOverlaps)
+	{
+		for (int32 Idx = 0; Idx < PendingOverlaps->Num(); ++Idx)
+		{
+			Update.PendingOverlaps.AddUnique((*PendingOverlaps)[Idx]);
+		}
+	}
+	Update.bDoNotifies |= bDoNotifies;
+
+	// Only the overlaps at the end of the latest move are of any use
+	Update.bHasOverlapsAtEndLocation = (OverlapsAtEndLocation != NULL);
+	if (OverlapsAtEndLocation)
+	{
+		Update.OverlapsAtEndLocation = *OverlapsAtEndLocation;
+		Update.Location = Component->GetComponentLocation();
+		Update.Rotation = Component->GetComponentRotation();
+	}
+	else
+	{
+		Update.OverlapsAtEndLocation.Reset();
+	}
+
+	return true;
+}
+
+void FOverlapUpdateBatch::RunQueries(int32 First, int32 Num)
+{
+	SCOPE_CYCLE_COUNTER(STAT_UpdateOverlapsBatchQueries);
+
+	for (int32 Idx = First; Idx < First + Num; ++Idx)
+	{
+		FDeferredUpdate& Update = Updates[QueryIndices[Idx]];
+		World->ComponentOverlapMulti(Update.QueryResults, Update.Component.Get(), Update.Location, Update.Rotation, Update.QueryParams);
+	}
+}
+
+void FOverlapUpdateBatch::Flush()
+{
+	FOverlapUpdateBatch& Batch = Get();
+	if (Batch.World == NULL)
+	{
+		return;
+	}
+
+	check(IsInGameThread());
+	SCOPE_CYCLE_COUNTER(STAT_UpdateOverlapsBatch);
+
+	// Gather the queries on the game thread, with the same conditions UpdateOverlaps queries under
+	Batch.QueryIndices.Reset();
+	for (int32 UpdateIdx = 0; UpdateIdx < Batch.Updates.Num(); ++UpdateIdx)
+	{
+		FDeferredUpdate& Update = Batch.Updates[UpdateIdx];
+		UPrimitiveComponent* Component = Update.Component.Get();
+		if (Component && Component->IsRegistered() && !Update.bHasOverlapsAtEndLocation && !Component->IsPendingKill() &&
+			Component->bGenerateOverlapEvents && Component->IsCollisionEnabled())
+		{
+			AActor* const Owner = Component->GetOwner();
+			if (Owner && Owner->bActorInitialized)
+			{
+				Update.bQueried = true;
+				Update.Location = Component->GetComponentLocation();
+				Update.Rotation = Component->GetComponentRotation();
+				Component->InitUpdateOverlapsQueryParams(Update.QueryParams);
+				Batch.QueryIndices.Add(UpdateIdx);
+			}
+		}
+	}
+
+	// Run them, the game thread takes the last chunk
+	const int32 NumQueries = Batch.QueryIndices.Num();
+	const int32 ChunkSize = FMath::Max(1, CVarParallelUpdateOverlapsChunkSize.GetValueOnGameThread());
+	const int32 NumChunks = FMath::DivideAndRoundUp(NumQueries, ChunkSize);
+	if (NumChunks > 1)
+	{
+		FGraphEventArray ChunkEvents;
+		for (int32 ChunkIndex = 0; ChunkIndex < NumChunks - 1; ++ChunkIndex)
+		{
+			ChunkEvents.Add(TGraphTask<FOverlapUpdateBatchTask>::CreateTask().ConstructAndDispatchWhenReady(Batch, ChunkIndex * ChunkSize, ChunkSize));
+		}
+		const int32 LastFirst = (NumChunks - 1) * ChunkSize;
+		Batch.RunQueries(LastFirst, NumQueries - LastFirst);
+		FTaskGraphInterface::Get().WaitUntilTasksComplete(ChunkEvents, ENamedThreads::GameThread);
+	}
+	else if (NumQueries > 0)
+	{
+		Batch.RunQueries(0, NumQueries);
+	}
+
+	// Close the batch before applying, so overlap updates triggered by the notifies happen right away
+	Batch.World = NULL;
+
+	// Apply the results in request order, so notifies are dispatched in the same order every run
+	for (int32 UpdateIdx = 0; UpdateIdx < Batch.Updates.Num(); ++UpdateIdx)
+	{
+		FDeferredUpdate& Update = Batch.Updates[UpdateIdx];
+		UPrimitiveComponent* Component = Update.Component.Get();
+		if (Component == NULL || !Component->IsRegistered())
+		{
+			continue;
+		}
+
+		// Results of a component moved by an earlier update's notifies are stale, it is queried again
+		const bool bStillInPlace = Component->GetComponentLocation() == Update.Location && Component->GetComponentRotation() == Update.Rotation;
+		const TArray<FOverlapInfo>* OverlapsAtEndLocation = (Update.bHasOverlapsAtEndLocation && bStillInPlace) ? &Update.OverlapsAtEndLocation : NULL;
+		const TArray<FOverlapResult>* QueryResults = (Update.bQueried && bStillInPlace) ? &Update.QueryResults : NULL;
+
+		Component->UpdateOverlapsOfThisComponent(Update.PendingOverlaps.Num() > 0 ? &Update.PendingOverlaps : NULL, Update.bDoNotifies, OverlapsAtEndLocation, QueryResults);
+	}
+
+	Batch.Updates.Reset();
+	Batch.UpdateIndices.Reset();
+}
@@ -0,0 +1,624 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	NetLoadTestCommandlet.cpp: Measures server replication cost with simulated clients.
+=============================================================================*/
+
+#include "EnginePrivate.h"
+#include "Commandlets/NetLoadTestCommandlet.h"
+#include "Engine/LoadTestNetDriver.h"
+#include "Engine/LoadTestNetConnection.h"
+#include "Engine/ActorChannel.h"
+#include "GameFramework/PlayerStart.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogNetLoadTestCommandlet, Log, All);
+
+/** Scripted movement of the simulated clients' pawns */
+namespace ELoadTestMovement
+{
+	enum Type
+	{
+		/** Pawns stand still, only RPCs and camera updates are sent */
+		Idle,
+		/** Pawns run in circles around their spawn point */
+		Circle,
+		/** Pawns run to random points around their spawn point */
+		Random,
+	};
+}
+
+/** Number of one millisecond buckets in the latency histogram, slower samples all go to the last bucket */
+static const int32 LATENCY_HISTOGRAM_BUCKETS = 10000;
+
+/** @return The value below which Percentile (0..1) of the sorted values fall */
+static float GetPercentile(const TArray<float>& SortedValues, float Percentile)
+{
+	if (SortedValues.Num() == 0)
+	{
+		return 0.0f;
+	}
+
+	const int32 Index = FMath::Clamp(FMath::TruncToInt(Percentile * SortedValues.Num()), 0, SortedValues.Num() - 1);
+	return SortedValues[Index];
+}
+
+/** @return The bucket below which Percentile (0..1) of the samples fall */
+static int32 GetHistogramPercentile(const TArray<uint64>& Histogram, uint64 NumSamples, float Percentile)
+{
+	const uint64 Target = (uint64)(Percentile * NumSamples);
+	uint64 Count = 0;
+
+	for (int32 Bucket = 0; Bucket < Histogram.Num(); Bucket++)
+	{
+		Count += Histogram[Bucket];
+
+		if (Count > Target)
+		{
+			return Bucket;
+		}
+	}
+
+	return Histogram.Num() - 1;
+}
+
+/** @return The average of the values */
+static float GetAverage(const TArray<float>& Values)
+{
+	float Total = 0.0f;
+
+	for (int32 i = 0; i < Values.Num(); i++)
+	{
+		Total += Values[i];
+	}
+
+	return Values.Num() > 0 ? Total / Values.Num() : 0.0f;
+}
+
+/** Result reported at the end of a run */
+struct FLoadTestMetric
+{
+	FString Name;
+	float Value;
+};
+
+static void AddMetric(TArray<FLoadTestMetric>& Metrics, const TCHAR* Name, float Value)
+{
+	FLoadTestMetric& Metric = *new(Metrics) FLoadTestMetric;
+	Metric.Name = Name;
+	Metric.Value = Value;
+}
+
+UNetLoadTestCommandlet::UNetLoadTestCommandlet(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = true;
+	LogToConsole = true;
+}
+
+int32 UNetLoadTestCommandlet::Main(const FString& Params)
+{
+	FString MapName = UGameMapsSettings::GetGameDefaultMap();
+	FString GameModeName;
+	FString MovementName = TEXT("Circle");
+	FString ReportFilename;
+	int32 NumClients = 64;
+	int32 NetSpeed = 0;
+	int32 Seed = 0;
+	float Duration = 60.0f;
+	float WarmUp = 5.0f;
+	float TickRate = 30.0f;
+	float LagMs = 100.0f;
+	float Spacing = 300.0f;
+
+	MovementSpeed = 400.0f;
+	MovementRadius = 500.0f;
+	RPCRate = 1.0f;
+
+	FParse::Value(*Params, TEXT("Map="), MapName);
+	FParse::Value(*Params, TEXT("Game="), GameModeName);
+	FParse::Value(*Params, TEXT("Movement="), MovementName);
+	FParse::Value(*Params, TEXT("Report="), ReportFilename);
+	FParse::Value(*Params, TEXT("Clients="), NumClients);
+	FParse::Value(*Params, TEXT("NetSpeed="), NetSpeed);
+	FParse::Value(*Params, TEXT("Seed="), Seed);
+	FParse::Value(*Params, TEXT("Duration="), Duration);
+	FParse::Value(*Params, TEXT("WarmUp="), WarmUp);
+	FParse::Value(*Params, TEXT("TickRate="), TickRate);
+	FParse::Value(*Params, TEXT("Lag="), LagMs);
+	FParse::Value(*Params, TEXT("Spacing="), Spacing);
+	FParse::Value(*Params, TEXT("Speed="), MovementSpeed);
+	FParse::Value(*Params, TEXT("Radius="), MovementRadius);
+	FParse::Value(*Params, TEXT("RPCRate="), RPCRate);
+
+	if (MovementName == TEXT("Idle"))
+	{
+		MovementPattern = ELoadTestMovement::Idle;
+	}
+	else if (MovementName == TEXT("Random"))
+	{
+		MovementPattern = ELoadTestMovement::Random;
+	}
+	else
+	{
+		MovementPattern = ELoadTestMovement::Circle;
+		MovementName = TEXT("Circle");
+	}
+
+	if (NumClients <= 0 || TickRate <= 0.0f || Duration <= 0.0f || MovementRadius <= 0.0f)
+	{
+		UE_LOG(LogNetLoadTestCommandlet, Error, TEXT("Clients, TickRate, Duration and Radius must be positive"));
+		return 1;
+	}
+
+	if (MapName.IsEmpty())
+	{
+		UE_LOG(LogNetLoadTestCommandlet, Error, TEXT("No map to test, use -Map=<map>"));
+		return 1;
+	}
+
+	RandomStream.Initialize(Seed);
+
+	// Make the world listen with the in-memory driver instead of sockets
+	FName OldDriverClassName;
+	FName OldDriverClassNameFallback;
+
+	for (int32 i = 0; i < GEngine->NetDriverDefinitions.Num(); i++)
+	{
+		FNetDriverDefinition& Definition = GEngine->NetDriverDefinitions[i];
+
+		if (Definition.DefName == NAME_GameNetDriver)
+		{
+			OldDriverClassName = Definition.DriverClassName;
+			OldDriverClassNameFallback = Definition.DriverClassNameFallback;
+
+			Definition.DriverClassName = Definition.DriverClassNameFallback = FName(*ULoadTestNetDriver::StaticClass()->GetPathName());
+		}
+	}
+
+	FURL URL(NULL, *MapName, TRAVEL_Absolute);
+
+	if (!GameModeName.IsEmpty())
+	{
+		URL.AddOption(*FString::Printf(TEXT("game=%s"), *GameModeName));
+	}
+
+	UGameEngine* GameEngine = Cast<UGameEngine>(GEngine);
+	FWorldContext& WorldContext = (GameEngine && GameEngine->GameInstance) ? *GameEngine->GameInstance->GetWorldContext() : GEngine->CreateNewWorldContext(EWorldType::Game);
+
+	FString Error;
+	const bool bLoadedMap = GEngine->LoadMap(WorldContext, URL, NULL, Error);
+
+	for (int32 i = 0; i < GEngine->NetDriverDefinitions.Num(); i++)
+	{
+		FNetDriverDefinition& Definition = GEngine->NetDriverDefinitions[i];
+
+		if (Definition.DefName == NAME_GameNetDriver)
+		{
+			Definition.DriverClassName = OldDriverClassName;
+			Definition.DriverClassNameFallback = OldDriverClassNameFallback;
+		}
+	}
+
+	UWorld* World = WorldContext.World();
+
+	if (!bLoadedMap || World == NULL)
+	{
+		UE_LOG(LogNetLoadTestCommandlet, Error, TEXT("Failed to load %s: %s"), *MapName, *Error);
+		return 1;
+	}
+
+	Driver = Cast<ULoadTestNetDriver>(World->GetNetDriver());
+
+	if (Driver == NULL)
+	{
+		UE_LOG(LogNetLoadTestCommandlet, Error, TEXT("%s isn't listening with the load test driver"), *MapName);
+		return 1;
+	}
+
+	if (World->GetNetMode() != NM_DedicatedServer)
+	{
+		UE_LOG(LogNetLoadTestCommandlet, Warning, TEXT("Not running as a dedicated server, client updates will be throttled like on a listen server"));
+	}
+
+	Driver->SimulatedLag = LagMs / 1000.0f;
+	Driver->OnSimulateClients.AddUObject(this, &UNetLoadTestCommandlet::SimulateClients);
+
+	// Lay the clients out on a grid around the first player start
+	FVector Center = FVector::ZeroVector;
+
+	for (TActorIterator<APlayerStart> It(World); It; ++It)
+	{
+		Center = It->GetActorLocation();
+		break;
+	}
+
+	const int32 GridSize = FMath::CeilToInt(FMath::Sqrt(NumClients));
+
+	Clients.Empty(NumClients);
+	Anchors.Empty(NumClients);
+	Destinations.Empty(NumClients);
+	NextRPCTimes.Empty(NumClients);
+	ClientTimeStamps.Empty(NumClients);
+	SpawnedDefaultPawn.Empty(NumClients);
+	PawnLocations.Empty(NumClients);
+
+	int32 NumJoined = 0;
+
+	for (int32 i = 0; i < NumClients; i++)
+	{
+		FURL ClientURL;
+		ClientURL.AddOption(*FString::Printf(TEXT("Name=LoadTestClient%d"), i));
+
+		ULoadTestNetConnection* Connection = Driver->AddSimulatedClient(ClientURL, NetSpeed, Error);
+
+		if (Connection == NULL)
+		{
+			UE_LOG(LogNetLoadTestCommandlet, Warning, TEXT("Client %d failed to join: %s"), i, *Error);
+		}
+		else
+		{
+			NumJoined++;
+		}
+
+		const FVector Anchor = Center + FVector((i % GridSize - GridSize / 2) * Spacing, (i / GridSize - GridSize / 2) * Spacing, 0.0f);
+
+		Clients.Add(Connection);
+		Anchors.Add(Anchor);
+		Destinations.Add(Anchor);
+		NextRPCTimes.Add(RPCRate > 0.0f ? Driver->Time + RandomStream.FRand() / RPCRate : 0.0f);
+		ClientTimeStamps.Add(0.0f);
+		SpawnedDefaultPawn.Add(false);
+		PawnLocations.Add(Anchor);
+	}
+
+	if (NumJoined == 0)
+	{
+		UE_LOG(LogNetLoadTestCommandlet, Error, TEXT("No client could join %s"), *MapName);
+		return 1;
+	}
+
+	PendingChangeTimes.Init(-1.0f, NumClients * NumClients);
+	LatencyHistogram.Init(0, LATENCY_HISTOGRAM_BUCKETS);
+
+	UE_LOG(LogNetLoadTestCommandlet, Display, TEXT("Running %s with %d/%d clients for %.1f seconds at %.0f Hz (%.1f seconds warm up), movement %s, lag %.0f ms"),
+		*MapName, NumJoined, NumClients, Duration, TickRate, WarmUp, *MovementName, LagMs);
+
+	const float DeltaSeconds = 1.0f / TickRate;
+	const int32 NumWarmUpFrames = FMath::CeilToInt(WarmUp * TickRate);
+	const int32 NumFrames = NumWarmUpFrames + FMath::CeilToInt(Duration * TickRate);
+
+	TArray<float> TickTimes;
+	TArray<float> ReplicateTimes;
+	TArray<int64> StartOutBytes;
+	TArray<int32> StartOutPackets;
+
+	for (int32 Frame = 0; Frame < NumFrames && !GIsRequestingExit; Frame++)
+	{
+		if (Frame == NumWarmUpFrames)
+		{
+			// Start measuring
+			for (int32 i = 0; i < Clients.Num(); i++)
+			{
+				StartOutBytes.Add(Clients[i] != NULL ? Clients[i]->TotalOutBytes : 0);
+				StartOutPackets.Add(Clients[i] != NULL ? Clients[i]->TotalOutPackets : 0);
+			}
+
+			LatencyHistogram.Init(0, LATENCY_HISTOGRAM_BUCKETS);
+		}
+
+		SimulationTime = 0.0;
+
+		const double StartTime = FPlatformTime::Seconds();
+
+		World->Tick(LEVELTICK_All, DeltaSeconds);
+
+		const double FrameTime = FPlatformTime::Seconds() - StartTime - SimulationTime;
+
+		GFrameCounter++;
+
+		if (Frame >= NumWarmUpFrames)
+		{
+			TickTimes.Add(FrameTime * 1000.0f);
+			ReplicateTimes.Add(Driver->LastServerReplicateActorsTime * 1000.0f);
+		}
+
+		GatherReplicationLatency();
+	}
+
+	const float MeasuredTime = (TickTimes.Num() > 0 ? TickTimes.Num() : 1) * DeltaSeconds;
+
+	// Bandwidth per connection
+	TArray<float> BytesPerSecond;
+	int64 TotalPackets = 0;
+	int32 NumDropped = 0;
+
+	for (int32 i = 0; i < Clients.Num() && i < StartOutBytes.Num(); i++)
+	{
+		ULoadTestNetConnection* Connection = Clients[i];
+
+		if (Connection == NULL)
+		{
+			continue;
+		}
+
+		if (Connection->State != USOCK_Open)
+		{
+			NumDropped++;
+			continue;
+		}
+
+		BytesPerSecond.Add((Connection->TotalOutBytes - StartOutBytes[i]) / MeasuredTime);
+		TotalPackets += Connection->TotalOutPackets - StartOutPackets[i];
+	}
+
+	uint64 NumLatencySamples = 0;
+
+	for (int32 Bucket = 0; Bucket < LatencyHistogram.Num(); Bucket++)
+	{
+		NumLatencySamples += LatencyHistogram[Bucket];
+	}
+
+	const float AverageTickTime = GetAverage(TickTimes);
+	const float AverageReplicateTime = GetAverage(ReplicateTimes);
+	const float AverageBytesPerSecond = GetAverage(BytesPerSecond);
+	const float PacketsPerSecond = BytesPerSecond.Num() > 0 ? TotalPackets / (BytesPerSecond.Num() * MeasuredTime) : 0.0f;
+
+	TickTimes.Sort();
+	ReplicateTimes.Sort();
+	BytesPerSecond.Sort();
+
+	// Name/value pairs, so CI can pick them up from the log or the report
+	TArray<FLoadTestMetric> Metrics;
+
+	AddMetric(Metrics, TEXT("Clients"), BytesPerSecond.Num());
+	AddMetric(Metrics, TEXT("DroppedClients"), NumDropped);
+	AddMetric(Metrics, TEXT("TickMsAvg"), AverageTickTime);
+	AddMetric(Metrics, TEXT("TickMsP50"), GetPercentile(TickTimes, 0.50f));
+	AddMetric(Metrics, TEXT("TickMsP95"), GetPercentile(TickTimes, 0.95f));
+	AddMetric(Metrics, TEXT("TickMsP99"), GetPercentile(TickTimes, 0.99f));
+	AddMetric(Metrics, TEXT("TickMsMax"), GetPercentile(TickTimes, 1.0f));
+	AddMetric(Metrics, TEXT("ReplicateActorsMsAvg"), AverageReplicateTime);
+	AddMetric(Metrics, TEXT("ReplicateActorsMsP95"), GetPercentile(ReplicateTimes, 0.95f));
+	AddMetric(Metrics, TEXT("ReplicateActorsMsMax"), GetPercentile(ReplicateTimes, 1.0f));
+	AddMetric(Metrics, TEXT("ConnectionBytesPerSecAvg"), AverageBytesPerSecond);
+	AddMetric(Metrics, TEXT("ConnectionBytesPerSecMin"), GetPercentile(BytesPerSecond, 0.0f));
+	AddMetric(Metrics, TEXT("ConnectionBytesPerSecP50"), GetPercentile(BytesPerSecond, 0.50f));
+	AddMetric(Metrics, TEXT("ConnectionBytesPerSecMax"), GetPercentile(BytesPerSecond, 1.0f));
+	AddMetric(Metrics, TEXT("ConnectionPacketsPerSecAvg"), PacketsPerSecond);
+	AddMetric(Metrics, TEXT("LatencySamples"), NumLatencySamples);
+	AddMetric(Metrics, TEXT("LatencyMsP50"), GetHistogramPercentile(LatencyHistogram, NumLatencySamples, 0.50f));
+	AddMetric(Metrics, TEXT("LatencyMsP90"), GetHistogramPercentile(LatencyHistogram, NumLatencySamples, 0.90f));
+	AddMetric(Metrics, TEXT("LatencyMsP99"), GetHistogramPercentile(LatencyHistogram, NumLatencySamples, 0.99f));
+	AddMetric(Metrics, TEXT("LatencyMsMax"), GetHistogramPercentile(LatencyHistogram, NumLatencySamples, 1.0f));
+
+	FString Report;
+
+	for (int32 i = 0; i < Metrics.Num(); i++)
+	{
+		UE_LOG(LogNetLoadTestCommandlet, Display, TEXT("%s\t%.3f"), *Metrics[i].Name, Metrics[i].Value);
+		Report += FString::Printf(TEXT("%s,%.3f") LINE_TERMINATOR, *Metrics[i].Name, Metrics[i].Value);
+	}
+
+	UE_LOG(LogNetLoadTestCommandlet, Display, TEXT("Latency is measured from a pawn moving on the server to the update being sent, clients receive it %.0f ms later"), LagMs * 0.5f);
+
+	if (!ReportFilename.IsEmpty() && !FFileHelper::SaveStringToFile(Report, *ReportFilename))
+	{
+		UE_LOG(LogNetLoadTestCommandlet, Error, TEXT("Failed to write report %s"), *ReportFilename);
+	}
+
+	// Shut down
+	Driver->OnSimulateClients.RemoveAll(this);
+	Driver = NULL;
+	Clients.Empty();
+
+	GEngine->DestroyNamedNetDriver(World, NAME_GameNetDriver);
+	World->SetNetDriver(NULL);
+
+	return NumDropped > 0 ? 1 : 0;
+}
+
+void UNetLoadTestCommandlet::SimulateClients(float DeltaSeconds)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	const float Time = Driver->Time;
+	const int32 NumClients = Clients.Num();
+
+	AGameMode* GameMode = Driver->GetWorld()->GetAuthGameMode();
+
+	for (int32 i = 0; i < NumClients; i++)
+	{
+		ULoadTestNetConnection* Connection = Clients[i];
+
+		if (Connection == NULL || Connection->State != USOCK_Open || Connection->PlayerController == NULL)
+		{
+			continue;
+		}
+
+		APlayerController* PC = Connection->PlayerController;
+		APawn* Pawn = PC->GetPawn();
+
+		// Maps without enough player starts, spawn the default pawn ourselves
+		if (Pawn == NULL && !SpawnedDefaultPawn[i] && GameMode != NULL && GameMode->HasMatchStarted())
+		{
+			SpawnedDefaultPawn[i] = true;
+
+			UClass* PawnClass = GameMode->GetDefaultPawnClassForController(PC);
+
+			if (PawnClass != NULL)
+			{
+				FActorSpawnParameters SpawnInfo;
+				SpawnInfo.bNoCollisionFail = true;
+
+				Pawn = Driver->GetWorld()->SpawnActor<APawn>(PawnClass, Anchors[i], FRotator::ZeroRotator, SpawnInfo);
+
+				if (Pawn != NULL)
+				{
+					PC->Possess(Pawn);
+				}
+			}
+		}
+
+		if (Pawn == NULL)
+		{
+			continue;
+		}
+
+		const FVector OldLocation = Pawn->GetActorLocation();
+		FVector NewLocation = OldLocation;
+
+		switch (MovementPattern)
+		{
+			case ELoadTestMovement::Circle:
+			{
+				const float Angle = 2.0f * PI * i / NumClients + Time * MovementSpeed / MovementRadius;
+				NewLocation = Anchors[i] + MovementRadius * FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.0f);
+				break;
+			}
+			case ELoadTestMovement::Random:
+			{
+				FVector ToDestination = Destinations[i] - OldLocation;
+				ToDestination.Z = 0.0f;
+
+				const float Step = MovementSpeed * DeltaSeconds;
+
+				if (ToDestination.Size() <= Step)
+				{
+					NewLocation = Destinations[i];
+
+					const float Angle = RandomStream.FRandRange(0.0f, 2.0f * PI);
+					Destinations[i] = Anchors[i] + RandomStream.FRandRange(0.0f, MovementRadius) * FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.0f);
+				}
+				else
+				{
+					NewLocation = OldLocation + ToDestination.GetSafeNormal() * Step;
+				}
+				break;
+			}
+			default:
+				break;
+		}
+
+		NewLocation.Z = OldLocation.Z;
+
+		FRotator ViewRotation = PC->GetControlRotation();
+
+		if (!NewLocation.Equals(OldLocation))
+		{
+			ViewRotation = (NewLocation - OldLocation).Rotation();
+		}
+
+		const int32 CamPitchAndYaw = (FRotator::CompressAxisToShort(ViewRotation.Yaw) << 16) | FRotator::CompressAxisToShort(ViewRotation.Pitch);
+
+		ACharacter* Character = Cast<ACharacter>(Pawn);
+		UCharacterMovementComponent* MoveComp = Character != NULL ? Character->GetCharacterMovement() : NULL;
+
+		if (MoveComp != NULL)
+		{
+			// Send the move a client would send, accelerating towards the scripted location. The server runs it
+			// through the same validation, batching and correction path as moves decoded from real client packets.
+			FVector Accel = NewLocation - OldLocation;
+			Accel = Accel.GetSafeNormal() * MoveComp->GetMaxAcceleration();
+
+			// Where the client predicted it ended up, so the server only sends corrections when it disagrees
+			const FVector ClientLoc = OldLocation + MoveComp->Velocity * DeltaSeconds;
+
+			ClientTimeStamps[i] += DeltaSeconds;
+			MoveComp->ServerMove(ClientTimeStamps[i], Accel, ClientLoc, 0, 0, CamPitchAndYaw, Pawn->GetMovementBase(), NAME_None, MoveComp->PackNetworkMovementMode());
+		}
+		else if (!NewLocation.Equals(OldLocation))
+		{
+			// Pawns without character movement have no move RPC, place them directly
+			Pawn->SetActorLocationAndRotation(NewLocation, ViewRotation);
+			PC->SetControlRotation(ViewRotation);
+		}
+
+		// The camera update every client sends each frame
+		PC->ServerUpdateCamera(NewLocation + FVector(0.0f, 0.0f, Pawn->BaseEyeHeight), CamPitchAndYaw);
+
+		if (RPCRate > 0.0f && Time >= NextRPCTimes[i])
+		{
+			NextRPCTimes[i] += 1.0f / RPCRate;
+			PC->ClientMessage(TEXT("NetLoadTest"));
+		}
+	}
+
+	SimulationTime += FPlatformTime::Seconds() - StartTime;
+}
+
+void UNetLoadTestCommandlet::GatherReplicationLatency()
+{
+	const float Time = Driver->Time;
+	const int32 NumClients = Clients.Num();
+
+	// Scripted input only takes effect once the server ran the move, so changes are timed from when the
+	// pawn's replicated location actually moves rather than from when the input was sent
+	for (int32 i = 0; i < NumClients; i++)
+	{
+		APawn* Pawn = (Clients[i] != NULL && Clients[i]->PlayerController != NULL) ? Clients[i]->PlayerController->GetPawn() : NULL;
+
+		if (Pawn == NULL)
+		{
+			continue;
+		}
+
+		const FVector Location = Pawn->GetActorLocation();
+
+		if (Location.Equals(PawnLocations[i]))
+		{
+			continue;
+		}
+
+		PawnLocations[i] = Location;
+
+		// Everybody that can see this pawn has to be told about the change
+		for (int32 Viewer = 0; Viewer < NumClients; Viewer++)
+		{
+			float& PendingChangeTime = PendingChangeTimes[Viewer * NumClients + i];
+
+			if (PendingChangeTime < 0.0f && Clients[Viewer] != NULL && Clients[Viewer]->ActorChannels.Contains(Pawn))
+			{
+				PendingChangeTime = Time;
+			}
+		}
+	}
+
+	for (int32 Viewer = 0; Viewer < NumClients; Viewer++)
+	{
+		ULoadTestNetConnection* Connection = Clients[Viewer];
+
+		if (Connection == NULL)
+		{
+			continue;
+		}
+
+		for (int32 i = 0; i < NumClients; i++)
+		{
+			float& PendingChangeTime = PendingChangeTimes[Viewer * NumClients + i];
+
+			if (PendingChangeTime < 0.0f)
+			{
+				continue;
+			}
+
+			APawn* Pawn = (Clients[i] != NULL && Clients[i]->PlayerController != NULL) ? Clients[i]->PlayerController->GetPawn() : NULL;
+			UActorChannel* Channel = Pawn != NULL ? Connection->ActorChannels.FindRef(Pawn) : NULL;
+
+			if (Channel == NULL)
+			{
+				// No longer relevant, the change will never be sent
+				PendingChangeTime = -1.0f;
+			}
+			else if (Channel->LastUpdateTime >= PendingChangeTime)
+			{
+				const int32 Bucket = FMath::Min(FMath::TruncToInt((Channel->LastUpdateTime - PendingChangeTime) * 1000.0f), LATENCY_HISTOGRAM_BUCKETS - 1);
+				LatencyHistogram[Bucket]++;
+
+				PendingChangeTime = -1.0f;
+			}
+		}
+	}
+}
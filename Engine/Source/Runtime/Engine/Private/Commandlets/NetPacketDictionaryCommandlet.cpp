@@ -0,0 +1,118 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	NetPacketDictionaryCommandlet.cpp: Trains packet compression dictionaries from captured traffic.
+=============================================================================*/
+
+#include "EnginePrivate.h"
+#include "Commandlets/NetPacketDictionaryCommandlet.h"
+#include "Net/PacketCompression.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogNetPacketDictionaryCommandlet, Log, All);
+
+UNetPacketDictionaryCommandlet::UNetPacketDictionaryCommandlet(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UNetPacketDictionaryCommandlet::Main(const FString& Params)
+{
+	FString CaptureDir = FPaths::GameSavedDir() / TEXT("NetCapture");
+	FString Output = TEXT("Config/NetPacketDictionary.bin");
+
+	FParse::Value(*Params, TEXT("Captures="), CaptureDir);
+	FParse::Value(*Params, TEXT("Output="), Output);
+
+	TArray<FString> CaptureFiles;
+	IFileManager::Get().FindFiles(CaptureFiles, *(CaptureDir / TEXT("*.bin")), true, false);
+
+	if (CaptureFiles.Num() == 0)
+	{
+		UE_LOG(LogNetPacketDictionaryCommandlet, Error, TEXT("No captures found in %s, record some with net.PacketCapture 1"), *CaptureDir);
+		return 1;
+	}
+
+	// Gather the byte distribution of all captured packets
+	TArray< TArray<uint8> > Packets;
+	uint64 Frequencies[256] = { 0 };
+	uint64 TotalBytes = 0;
+
+	for (int32 FileIndex = 0; FileIndex < CaptureFiles.Num(); FileIndex++)
+	{
+		const FString Filename = CaptureDir / CaptureFiles[FileIndex];
+		const int32 FirstPacket = Packets.Num();
+
+		if (!FNetPacketCapture::ReadCaptureFile(Filename, Packets))
+		{
+			UE_LOG(LogNetPacketDictionaryCommandlet, Warning, TEXT("Skipping unreadable capture %s"), *Filename);
+			Packets.SetNum(FirstPacket);
+			continue;
+		}
+
+		for (int32 PacketIndex = FirstPacket; PacketIndex < Packets.Num(); PacketIndex++)
+		{
+			const TArray<uint8>& Packet = Packets[PacketIndex];
+
+			for (int32 i = 0; i < Packet.Num(); i++)
+			{
+				Frequencies[Packet[i]]++;
+			}
+
+			TotalBytes += Packet.Num();
+		}
+	}
+
+	if (Packets.Num() == 0)
+	{
+		UE_LOG(LogNetPacketDictionaryCommandlet, Error, TEXT("No packets could be read from %s"), *CaptureDir);
+		return 1;
+	}
+
+	uint8 CodeLengths[256];
+	FNetPacketCompressor::BuildCodeLengths(Frequencies, CodeLengths);
+
+	FNetPacketCompressor Compressor;
+	if (!Compressor.InitFromCodeLengths(CodeLengths))
+	{
+		UE_LOG(LogNetPacketDictionaryCommandlet, Error, TEXT("Failed to build a valid code from the captured packets"));
+		return 1;
+	}
+
+	// Measure what the dictionary would have saved on the training set, the same way UNetConnection::FlushNet applies it
+	uint64 SentBytes = 0;
+	int32 NumCompressed = 0;
+	TArray<uint8> Compressed;
+
+	for (int32 PacketIndex = 0; PacketIndex < Packets.Num(); PacketIndex++)
+	{
+		const TArray<uint8>& Packet = Packets[PacketIndex];
+
+		if (Compressor.Compress(Packet.GetData(), Packet.Num(), Compressed))
+		{
+			SentBytes += Compressed.Num();
+			NumCompressed++;
+		}
+		else
+		{
+			SentBytes += Packet.Num();
+		}
+	}
+
+	const FString OutputPath = FPaths::GameDir() / Output;
+
+	if (!FNetPacketCompressor::SaveDictionary(OutputPath, CodeLengths))
+	{
+		UE_LOG(LogNetPacketDictionaryCommandlet, Error, TEXT("Failed to write %s"), *OutputPath);
+		return 1;
+	}
+
+	UE_LOG(LogNetPacketDictionaryCommandlet, Display, TEXT("Trained on %i packets (%llu bytes) from %i captures"), Packets.Num(), TotalBytes, CaptureFiles.Num());
+	UE_LOG(LogNetPacketDictionaryCommandlet, Display, TEXT("Compressed %i packets, %llu bytes would have been sent (%.1f%% saved)"), NumCompressed, SentBytes, 100.0 * (1.0 - (double)SentBytes / (double)TotalBytes));
+	UE_LOG(LogNetPacketDictionaryCommandlet, Display, TEXT("Wrote %s (checksum 0x%08x), set PacketCompressionDictionary=%s and bEnablePacketCompression=true on the net driver to use it"), *OutputPath, Compressor.GetDictionaryChecksum(), *Output);
+
+	return 0;
+}
@@ -1007,6 +1007,8 @@ IMPLEMENT_CONTROL_CHANNEL_MESSAGE(Abort);
 IMPLEMENT_CONTROL_CHANNEL_MESSAGE(PCSwap);
 IMPLEMENT_CONTROL_CHANNEL_MESSAGE(ActorChannelFailure);
 IMPLEMENT_CONTROL_CHANNEL_MESSAGE(DebugText);
+IMPLEMENT_CONTROL_CHANNEL_MESSAGE(LevelNetGUIDs);
+IMPLEMENT_CONTROL_CHANNEL_MESSAGE(LevelNetGUIDsAck);
 IMPLEMENT_CONTROL_CHANNEL_MESSAGE(BeaconWelcome);
 IMPLEMENT_CONTROL_CHANNEL_MESSAGE(BeaconJoin);
 IMPLEMENT_CONTROL_CHANNEL_MESSAGE(BeaconAssignGUID);
@@ -1182,6 +1184,13 @@ void UControlChannel::ReceivedBunch( FInBunch& Bunch )
 					break;
 				case NMT_NetGUIDAssign:
 					FNetControlMessage<NMT_NetGUIDAssign>::Discard(Bunch);
+					break;
+				case NMT_LevelNetGUIDs:
+					FNetControlMessage<NMT_LevelNetGUIDs>::Discard(Bunch);
+					break;
+				case NMT_LevelNetGUIDsAck:
+					FNetControlMessage<NMT_LevelNetGUIDsAck>::Discard(Bunch);
+					break;
 				case NMT_BeaconWelcome:
 					//FNetControlMessage<NMT_BeaconWelcome>::Discard(Bunch);
 					break;
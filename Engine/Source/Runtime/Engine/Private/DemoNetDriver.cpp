@@ -20,6 +20,7 @@ DEFINE_LOG_CATEGORY_STATIC( LogDemo, Log, All );
 
 static TAutoConsoleVariable<float> CVarDemoRecordHz( TEXT( "demo.RecordHz" ), 10, TEXT( "Number of demo frames recorded per second" ) );
 static TAutoConsoleVariable<float> CVarDemoTimeDilation( TEXT( "demo.TimeDilation" ), -1.0f, TEXT( "Override time dilation during demo playback (-1 = don't override)" ) );
+static TAutoConsoleVariable<float> CVarDemoCheckpointDelay( TEXT( "demo.CheckpointDelay" ), 30, TEXT( "Seconds of demo time between checkpoints when recording (0 = don't record checkpoints)" ) );
 
 static const int32 MAX_DEMO_READ_WRITE_BUFFER = 1024 * 2;
 
@@ -43,6 +44,19 @@ bool UDemoNetDriver::InitBase( bool bInitAsClient, FNetworkNotify* InNotify, con
 		bIsRecordingDemoFrame	= false;
 		bDemoPlaybackDone		= false;
 		EndOfStreamOffset		= 0;
+		StreamStartOffset		= 0;
+		FileAr					= NULL;
+		CheckpointAr			= NULL;
+
+		const FString StreamerName = URL.GetOption( TEXT( "DemoStreamer=" ), *DemoStreamerName );
+
+		DemoStreamer = FDemoStreamerFactory::CreateStreamer( FName( StreamerName.IsEmpty() ? TEXT( "File" ) : *StreamerName ) );
+
+		if ( !DemoStreamer.IsValid() )
+		{
+			Error = FString::Printf( TEXT( "Unknown demo streamer: %s" ), *StreamerName );
+			return false;
+		}
 
 		ResetDemoState();
 
@@ -72,7 +86,7 @@ FString UDemoNetDriver::LowLevelGetNetworkNumber()
 }
 
 #define NETWORK_DEMO_MAGIC			( 0x2CF5A13D )
-#define NETWORK_DEMO_VERSION		( 0 )
+#define NETWORK_DEMO_VERSION		( 1 )		// 1: Records are tagged with EDemoRecordType, checkpoints and checkpoint index
 
 struct FNetworkDemoHeader
 {
@@ -117,6 +131,9 @@ void UDemoNetDriver::ResetDemoState()
 	DemoTotalTime	= 0;
 	DemoCurrentTime	= 0;
 	DemoTotalFrames	= 0;
+
+	Checkpoints.Empty();
+	LastCheckpointTime = 0;
 }
 
 bool UDemoNetDriver::InitConnect( FNetworkNotify* InNotify, const FURL& ConnectURL, FString& Error )
@@ -145,7 +162,7 @@ bool UDemoNetDriver::InitConnect( FNetworkNotify* InNotify, const FURL& ConnectU
 	ResetDemoState();
 
 	// open the pre-recorded demo file
-	FileAr = IFileManager::Get().CreateFileReader( *DemoFilename );
+	FileAr = DemoStreamer->StartStreaming( DemoFilename, false );
 
 	if ( !FileAr )
 	{
@@ -262,11 +279,21 @@ bool UDemoNetDriver::InitConnect( FNetworkNotify* InNotify, const FURL& ConnectU
 		UE_LOG( LogDemo, Log, TEXT( "  Loading streamingLevel: %s, %s" ), *PackageName, *PackageNameToLoad );
 	}
 
+	// Read the checkpoint index
+	(*FileAr) << Checkpoints;
+
+	if ( FileAr->IsError() )
+	{
+		UE_LOG( LogDemo, Warning, TEXT( "UDemoNetDriver::InitConnect: Failed to read checkpoint index, seeking will replay from the start" ) );
+		Checkpoints.Empty();
+	}
+
 	// Jump back to start of stream
 	FileAr->Seek( OldPos );
 
 	// Remember where the meta data is, this is where we must stop reading the demo stream
 	EndOfStreamOffset = DemoHeader.MetaDataOffset;
+	StreamStartOffset = OldPos;
 
 	return true;
 }
@@ -293,7 +320,7 @@ bool UDemoNetDriver::InitListen( FNetworkNotify* InNotify, FURL& ListenURL, bool
 	Connection->InitConnection( this, USOCK_Open, ListenURL, 1000000 );
 	Connection->InitSendBuffer();
 
-	FileAr = IFileManager::Get().CreateFileWriter( *DemoFilename );
+	FileAr = DemoStreamer->StartStreaming( DemoFilename, true );
 	ClientConnections.Add( Connection );
 
 	if( !FileAr )
@@ -314,6 +341,8 @@ bool UDemoNetDriver::InitListen( FNetworkNotify* InNotify, FURL& ListenURL, bool
 	// Write the initial header (a lot of the fields will be placeholder until we fill them in later)
 	(*FileAr) << DemoHeader;
 
+	StreamStartOffset = FileAr->Tell();
+
 	// Spawn the demo recording spectator.
 	SpawnDemoRecSpectator( Connection );
 
@@ -471,6 +500,9 @@ void UDemoNetDriver::StopDemo()
 					(*FileAr) << World->StreamingLevels[i]->LevelTransform;
 				}
 			}
+
+			// Save out the checkpoint index, so playback can seek without scanning the stream
+			(*FileAr) << Checkpoints;
 		}
 
 		// let GC cleanup the object
@@ -491,7 +523,7 @@ void UDemoNetDriver::StopDemo()
 		ServerConnection = NULL;
 	}
 
-	delete FileAr;
+	DemoStreamer->StopStreaming();
 	FileAr = NULL;
 
 	check( ClientConnections.Num() == 0 );
@@ -573,6 +605,9 @@ void UDemoNetDriver::TickDemoRecord( float DeltaSeconds )
 	DemoFrameNum++;
 	ReplicationFrame++;
 
+	uint8 RecordType = DEMO_RECORD_Frame;
+	*FileAr << RecordType;
+
 	// Save elapsed game time for this frame
 	*FileAr << DemoDeltaTime;
 
@@ -621,6 +656,149 @@ void UDemoNetDriver::TickDemoRecord( float DeltaSeconds )
 	int32 EndCount = 0;
 
 	*FileAr << EndCount;
+
+	const float CheckpointDelay = CVarDemoCheckpointDelay.GetValueOnGameThread();
+
+	if ( CheckpointDelay > 0 && DemoCurrentTime - LastCheckpointTime >= CheckpointDelay )
+	{
+		SaveCheckpoint();
+	}
+}
+
+void UDemoNetDriver::SaveCheckpoint()
+{
+	check( ClientConnections.Num() == 1 );
+	check( CheckpointAr == NULL );
+
+	UDemoNetConnection* RecordingConnection = CastChecked< UDemoNetConnection >( ClientConnections[0] );
+
+	TArray< uint8 > CheckpointData;
+	FMemoryWriter CheckpointWriter( CheckpointData );
+
+	// Replicate through a fresh connection so every channel sends a full initial bunch (spawn info, all properties and NetGUID exports).
+	// The channels use the same indices as on the recording connection, so the frames following the checkpoint apply on top of it.
+	UDemoNetConnection* CheckpointConnection = ConstructObject< UDemoNetConnection >( UDemoNetConnection::StaticClass() );
+	CheckpointConnection->InitConnection( this, USOCK_Open, RecordingConnection->URL, 1000000 );
+
+	// CleanUp expects the connection to be registered with the driver
+	ClientConnections.Add( CheckpointConnection );
+
+	CheckpointAr			= &CheckpointWriter;
+	bIsRecordingDemoFrame	= true;
+
+	TArray< AActor* > CheckpointActors;
+	CheckpointActors.Add( World->GetWorldSettings() );
+	CheckpointActors.Append( World->NetworkActors );
+
+	for ( int32 i = 0; i < CheckpointActors.Num(); i++ )
+	{
+		AActor* Actor = CheckpointActors[i];
+
+		// Player controllers are skipped, playback keeps its own spectator when seeking
+		if ( Actor == NULL || Cast< APlayerController >( Actor ) != NULL )
+		{
+			continue;
+		}
+
+		UActorChannel* RecordingChannel = RecordingConnection->ActorChannels.FindRef( Actor );
+
+		// Actors without a channel yet will be opened by the frames that follow the checkpoint
+		if ( RecordingChannel == NULL || RecordingChannel->Closing )
+		{
+			continue;
+		}
+
+		UActorChannel* Channel = (UActorChannel*)CheckpointConnection->CreateChannel( CHTYPE_Actor, 1, RecordingChannel->ChIndex );
+
+		if ( Channel != NULL )
+		{
+			Channel->SetChannelActor( Actor );
+			Channel->ReplicateActor();
+		}
+	}
+
+	CheckpointConnection->FlushNet();
+
+	bIsRecordingDemoFrame	= false;
+	CheckpointAr			= NULL;
+
+	// Throw the checkpoint connection away without sending anything else
+	CheckpointConnection->State = USOCK_Closed;
+	CheckpointConnection->CleanUp();
+
+	check( ClientConnections.Num() == 1 );
+
+	int32 EndCount = 0;
+	CheckpointWriter << EndCount;
+
+	FDemoCheckpoint Checkpoint;
+	Checkpoint.Time		= DemoCurrentTime;
+	Checkpoint.FrameNum	= DemoFrameNum;
+	Checkpoint.Offset	= WriteCheckpointRecord( *FileAr, CheckpointData );
+
+	Checkpoints.Add( Checkpoint );
+	LastCheckpointTime = DemoCurrentTime;
+
+	UE_LOG( LogDemo, Verbose, TEXT( "UDemoNetDriver::SaveCheckpoint: Time: %2.2f, Frame: %i, Size: %i" ), Checkpoint.Time, Checkpoint.FrameNum, CheckpointData.Num() );
+}
+
+int32 UDemoNetDriver::WriteCheckpointRecord( FArchive& Ar, TArray< uint8 >& CheckpointData )
+{
+	const int32 RecordOffset = Ar.Tell();
+
+	uint8 RecordType = DEMO_RECORD_Checkpoint;
+	int32 CheckpointSize = CheckpointData.Num();
+
+	Ar << RecordType;
+	Ar << CheckpointSize;
+	Ar.Serialize( CheckpointData.GetData(), CheckpointSize );
+
+	return RecordOffset;
+}
+
+bool UDemoNetDriver::ReadCheckpointRecordHeader( FArchive& Ar )
+{
+	uint8 RecordType = DEMO_RECORD_Frame;
+	int32 CheckpointSize = 0;
+
+	Ar << RecordType;
+	Ar << CheckpointSize;
+
+	return !Ar.IsError() && RecordType == DEMO_RECORD_Checkpoint && CheckpointSize >= 0;
+}
+
+void UDemoNetDriver::SkipCheckpointRecords( FArchive& Ar, int32 EndOffset )
+{
+	while ( !Ar.AtEnd() && Ar.Tell() < EndOffset )
+	{
+		const int32 RecordPos = Ar.Tell();
+
+		uint8 RecordType = DEMO_RECORD_Frame;
+		Ar << RecordType;
+
+		if ( RecordType != DEMO_RECORD_Checkpoint )
+		{
+			Ar.Seek( RecordPos );
+			break;
+		}
+
+		int32 CheckpointSize = 0;
+		Ar << CheckpointSize;
+
+		Ar.Seek( Ar.Tell() + CheckpointSize );
+	}
+}
+
+int32 UDemoNetDriver::FindCheckpointIndex( const TArray< FDemoCheckpoint >& InCheckpoints, float TimeInSeconds )
+{
+	int32 CheckpointIndex = INDEX_NONE;
+
+	for ( int32 i = 0; i < InCheckpoints.Num() && InCheckpoints[i].Time <= TimeInSeconds; i++ )
+	{
+		CheckpointIndex = i;
+	}
+
+	return CheckpointIndex;
 }
 
 bool UDemoNetDriver::ReadDemoFrame()
@@ -631,6 +809,9 @@ bool UDemoNetDriver::ReadDemoFrame()
 		return false;
 	}
 
+	// Checkpoints are only needed when seeking, skip over any we run into during normal playback
+	SkipCheckpointRecords( *FileAr, EndOfStreamOffset );
+
 	if ( FileAr->AtEnd() || FileAr->Tell() >= EndOfStreamOffset )
 	{
 		bDemoPlaybackDone = true;
@@ -658,6 +839,16 @@ bool UDemoNetDriver::ReadDemoFrame()
 
 	const int32 OldFilePos = FileAr->Tell();
 
+	uint8 RecordType = DEMO_RECORD_Frame;
+	*FileAr << RecordType;
+
+	if ( FileAr->IsError() || RecordType != DEMO_RECORD_Frame )
+	{
+		UE_LOG( LogDemo, Error, TEXT( "UDemoNetDriver::ReadDemoFrame: Unexpected record type: %i" ), (int32)RecordType );
+		StopDemo();
+		return false;
+	}
+
 	float ServerDeltaTime;
 
 	// Peek at the next demo delta time, and see if we should process this frame
@@ -695,6 +886,11 @@ bool UDemoNetDriver::ReadDemoFrame()
 
 	DemoDeltaTime -= ServerDeltaTime;
 
+	return ReadDemoPackets();
+}
+
+bool UDemoNetDriver::ReadDemoPackets()
+{
 	while ( true )
 	{
 		uint8 ReadBuffer[ MAX_DEMO_READ_WRITE_BUFFER ];
@@ -705,7 +901,7 @@ bool UDemoNetDriver::ReadDemoFrame()
 
 		if ( FileAr->IsError() )
 		{
-			UE_LOG( LogDemo, Error, TEXT( "UDemoNetDriver::ReadDemoFrame: Failed to read demo PacketBytes" ) );
+			UE_LOG( LogDemo, Error, TEXT( "UDemoNetDriver::ReadDemoPackets: Failed to read demo PacketBytes" ) );
 			StopDemo();
 			return false;
 		}
@@ -717,13 +913,13 @@ bool UDemoNetDriver::ReadDemoFrame()
 
 		if ( PacketBytes > sizeof( ReadBuffer ) )
 		{
-			UE_LOG( LogDemo, Error, TEXT( "UDemoNetDriver::ReadDemoFrame: PacketBytes > sizeof( ReadBuffer )" ) );
+			UE_LOG( LogDemo, Error, TEXT( "UDemoNetDriver::ReadDemoPackets: PacketBytes > sizeof( ReadBuffer )" ) );
 
 			StopDemo();
 
 			if ( World != NULL && World->GetGameInstance() != NULL )
 			{
-				World->GetGameInstance()->HandleDemoPlaybackFailure( EDemoPlayFailure::Generic, FString( TEXT( "UDemoNetDriver::ReadDemoFrame: PacketBytes > sizeof( ReadBuffer )" ) ) );
+				World->GetGameInstance()->HandleDemoPlaybackFailure( EDemoPlayFailure::Generic, FString( TEXT( "UDemoNetDriver::ReadDemoPackets: PacketBytes > sizeof( ReadBuffer )" ) ) );
 			}
 
 			return false;
@@ -734,7 +930,7 @@ bool UDemoNetDriver::ReadDemoFrame()
 
 		if ( FileAr->IsError() )
 		{
-			UE_LOG( LogDemo, Error, TEXT( "UDemoNetDriver::ReadDemoFrame: Failed to read demo file packet" ) );
+			UE_LOG( LogDemo, Error, TEXT( "UDemoNetDriver::ReadDemoPackets: Failed to read demo file packet" ) );
 			StopDemo();
 			return false;
 		}
@@ -748,7 +944,7 @@ bool UDemoNetDriver::ReadDemoFrame()
 
 			if ( Checksum != ServerChecksum )
 			{
-				UE_LOG( LogDemo, Error, TEXT( "UDemoNetDriver::ReadDemoFrame: Checksum != ServerChecksum" ) );
+				UE_LOG( LogDemo, Error, TEXT( "UDemoNetDriver::ReadDemoPackets: Checksum != ServerChecksum" ) );
 				StopDemo();
 				return false;
 			}
@@ -761,7 +957,7 @@ bool UDemoNetDriver::ReadDemoFrame()
 		if ( ServerConnection == NULL || ServerConnection->State == USOCK_Closed )
 		{
 			// Something we received resulted in the demo being stopped
-			UE_LOG( LogDemo, Error, TEXT( "UDemoNetDriver::ReadDemoFrame: ReceivedRawPacket closed connection" ) );
+			UE_LOG( LogDemo, Error, TEXT( "UDemoNetDriver::ReadDemoPackets: ReceivedRawPacket closed connection" ) );
 			StopDemo();
 			return false;
 		}
@@ -793,6 +989,113 @@ void UDemoNetDriver::TickDemoPlayback( float DeltaSeconds )
 	}
 }
 
+void UDemoNetDriver::ResetPlaybackChannels()
+{
+	check( ServerConnection != NULL );
+
+	for ( int32 i = ServerConnection->OpenChannels.Num() - 1; i >= 0; i-- )
+	{
+		UActorChannel* ActorChannel = Cast< UActorChannel >( ServerConnection->OpenChannels[i] );
+
+		if ( ActorChannel == NULL )
+		{
+			continue;
+		}
+
+		AActor* Actor = ActorChannel->GetActor();
+
+		// Keep our spectator, checkpoints don't contain player controllers
+		if ( Actor != NULL && Actor == SpectatorController )
+		{
+			continue;
+		}
+
+		if ( Actor != NULL && Actor->IsNetStartupActor() )
+		{
+			// Startup actors stay in the level, the checkpoint will refresh their state.
+			// Detach them so cleaning up the channel doesn't destroy them.
+			ServerConnection->ActorChannels.Remove( Actor );
+			ActorChannel->Actor = NULL;
+
+			// Undo the pause from reaching the end of the demo
+			Actor->CustomTimeDilation = 1.0f;
+		}
+
+		// Dynamic actors are destroyed here, the checkpoint will spawn them again
+		ActorChannel->Dormant = 0;
+		ActorChannel->ConditionalCleanUp();
+	}
+}
+
+bool UDemoNetDriver::GotoTime( float TimeInSeconds, FString& Error )
+{
+	if ( ServerConnection == NULL || FileAr == NULL )
+	{
+		Error = TEXT( "No demo is being played back" );
+		return false;
+	}
+
+	if ( TimeInSeconds < 0.0f || TimeInSeconds > DemoTotalTime )
+	{
+		Error = FString::Printf( TEXT( "Time %2.2f is out of range, the demo is %2.2f seconds long" ), TimeInSeconds, DemoTotalTime );
+		return false;
+	}
+
+	// Find the last checkpoint at or before the time we want to go to
+	const int32 CheckpointIndex = FindCheckpointIndex( Checkpoints, TimeInSeconds );
+
+	ResetPlaybackChannels();
+
+	bDemoPlaybackDone = false;
+
+	if ( CheckpointIndex == INDEX_NONE )
+	{
+		// No checkpoint early enough, replay from the start of the stream
+		FileAr->Seek( StreamStartOffset );
+
+		DemoCurrentTime	= 0;
+		DemoFrameNum	= 0;
+	}
+	else
+	{
+		const FDemoCheckpoint& Checkpoint = Checkpoints[CheckpointIndex];
+
+		FileAr->Seek( Checkpoint.Offset );
+
+		if ( !ReadCheckpointRecordHeader( *FileAr ) )
+		{
+			Error = FString::Printf( TEXT( "Checkpoint %i at %2.2f seconds is corrupt" ), CheckpointIndex, Checkpoint.Time );
+			UE_LOG( LogDemo, Error, TEXT( "UDemoNetDriver::GotoTime: %s" ), *Error );
+			StopDemo();
+			return false;
+		}
+
+		// Restore the full state recorded in the checkpoint, this leaves the stream at the first frame after it
+		if ( !ReadDemoPackets() )
+		{
+			Error = FString::Printf( TEXT( "Failed to apply checkpoint %i at %2.2f seconds" ), CheckpointIndex, Checkpoint.Time );
+			return false;
+		}
+
+		DemoCurrentTime	= Checkpoint.Time;
+		DemoFrameNum	= Checkpoint.FrameNum;
+	}
+
+	UE_LOG( LogDemo, Log, TEXT( "UDemoNetDriver::GotoTime: Time: %2.2f, Checkpoint: %i, Fast forwarding %2.2f seconds" ), TimeInSeconds, CheckpointIndex, TimeInSeconds - DemoCurrentTime );
+
+	// Fast forward by reading every frame up to the requested time right away
+	DemoDeltaTime = 0;
+	TickDemoPlayback( TimeInSeconds - DemoCurrentTime );
+
+	if ( ServerConnection == NULL )
+	{
+		Error = FString::Printf( TEXT( "Playback stopped while fast forwarding to %2.2f seconds" ), TimeInSeconds );
+		return false;
+	}
+
+	return true;
+}
+
 void UDemoNetDriver::SpawnDemoRecSpectator( UNetConnection* Connection )
 {
 	check( Connection != NULL );
@@ -878,12 +1181,15 @@ void UDemoNetConnection::LowLevelSend( void* Data, int32 Count )
 			return;
 		}
 
-		*GetDriver()->FileAr << Count;
-		GetDriver()->FileAr->Serialize( Data, Count );
+		// While a checkpoint is being recorded, packets go to the checkpoint instead of the frame stream
+		FArchive* Ar = GetDriver()->CheckpointAr != NULL ? GetDriver()->CheckpointAr : GetDriver()->FileAr;
+
+		*Ar << Count;
+		Ar->Serialize( Data, Count );
 		
 #if DEMO_CHECKSUMS == 1
 		uint32 Checksum = FCrc::MemCrc32( Data, Count, 0 );
-		*GetDriver()->FileAr << Checksum;
+		*Ar << Checksum;
 #endif
 	}
 }
@@ -0,0 +1,149 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	DemoStreamer.cpp: Pluggable storage for demo recording and playback.
+=============================================================================*/
+
+#include "EnginePrivate.h"
+#include "Net/DemoStreamer.h"
+
+DEFINE_LOG_CATEGORY_STATIC( LogDemoStreamer, Log, All );
+
+/*-----------------------------------------------------------------------------
+	FDemoStreamerFactory.
+-----------------------------------------------------------------------------*/
+
+static IDemoStreamer* CreateLocalFileDemoStreamer()
+{
+	return new FLocalFileDemoStreamer();
+}
+
+static IDemoStreamer* CreateMemoryDemoStreamer()
+{
+	return new FMemoryDemoStreamer();
+}
+
+static TMap< FName, FDemoStreamerFactory::FCreateStreamerFunc >& GetDemoStreamerRegistry()
+{
+	static TMap< FName, FDemoStreamerFactory::FCreateStreamerFunc > Registry;
+
+	if ( Registry.Num() == 0 )
+	{
+		// Built in streamers
+		Registry.Add( FName( TEXT( "File" ) ), &CreateLocalFileDemoStreamer );
+		Registry.Add( FName( TEXT( "Memory" ) ), &CreateMemoryDemoStreamer );
+	}
+
+	return Registry;
+}
+
+void FDemoStreamerFactory::RegisterStreamer( const FName Name, FCreateStreamerFunc CreateFunc )
+{
+	check( CreateFunc != NULL );
+	GetDemoStreamerRegistry().Add( Name, CreateFunc );
+}
+
+void FDemoStreamerFactory::UnregisterStreamer( const FName Name )
+{
+	GetDemoStreamerRegistry().Remove( Name );
+}
+
+TSharedPtr< IDemoStreamer > FDemoStreamerFactory::CreateStreamer( const FName Name )
+{
+	const FCreateStreamerFunc* CreateFunc = GetDemoStreamerRegistry().Find( Name );
+
+	if ( CreateFunc == NULL )
+	{
+		UE_LOG( LogDemoStreamer, Warning, TEXT( "FDemoStreamerFactory::CreateStreamer: Unknown streamer: %s" ), *Name.ToString() );
+		return NULL;
+	}
+
+	return TSharedPtr< IDemoStreamer >( ( *CreateFunc )() );
+}
+
+/*-----------------------------------------------------------------------------
+	FLocalFileDemoStreamer.
+-----------------------------------------------------------------------------*/
+
+FLocalFileDemoStreamer::~FLocalFileDemoStreamer()
+{
+	StopStreaming();
+}
+
+FArchive* FLocalFileDemoStreamer::StartStreaming( const FString& StreamName, bool bRecord )
+{
+	StopStreaming();
+
+	FileAr = bRecord ? IFileManager::Get().CreateFileWriter( *StreamName ) : IFileManager::Get().CreateFileReader( *StreamName );
+
+	return FileAr;
+}
+
+void FLocalFileDemoStreamer::StopStreaming()
+{
+	delete FileAr;
+	FileAr = NULL;
+}
+
+/*-----------------------------------------------------------------------------
+	FMemoryDemoStreamer.
+-----------------------------------------------------------------------------*/
+
+static TMap< FString, TSharedPtr< TArray< uint8 > > >& GetMemoryDemoStreams()
+{
+	static TMap< FString, TSharedPtr< TArray< uint8 > > > Streams;
+	return Streams;
+}
+
+FMemoryDemoStreamer::~FMemoryDemoStreamer()
+{
+	StopStreaming();
+}
+
+FArchive* FMemoryDemoStreamer::StartStreaming( const FString& StreamName, bool bRecord )
+{
+	StopStreaming();
+
+	if ( bRecord )
+	{
+		// Recording always starts a fresh stream
+		Buffer = MakeShareable( new TArray< uint8 >() );
+		GetMemoryDemoStreams().Add( StreamName, Buffer );
+
+		Archive = new FMemoryWriter( *Buffer, true );
+	}
+	else
+	{
+		const TSharedPtr< TArray< uint8 > >* ExistingBuffer = GetMemoryDemoStreams().Find( StreamName );
+
+		if ( ExistingBuffer == NULL )
+		{
+			return NULL;
+		}
+
+		Buffer = *ExistingBuffer;
+
+		Archive = new FMemoryReader( *Buffer, true );
+	}
+
+	return Archive;
+}
+
+void FMemoryDemoStreamer::StopStreaming()
+{
+	delete Archive;
+	Archive = NULL;
+
+	Buffer.Reset();
+}
+
+const TArray< uint8 >* FMemoryDemoStreamer::FindStream( const FString& StreamName )
+{
+	const TSharedPtr< TArray< uint8 > >* ExistingBuffer = GetMemoryDemoStreams().Find( StreamName );
+	return ExistingBuffer != NULL ? ExistingBuffer->Get() : NULL;
+}
+
+void FMemoryDemoStreamer::DiscardStream( const FString& StreamName )
+{
+	GetMemoryDemoStreams().Remove( StreamName );
+}
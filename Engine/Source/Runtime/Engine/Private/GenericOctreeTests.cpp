@@ -0,0 +1,158 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "EnginePrivate.h"
+#include "GenericOctree.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenericOctreeTest, "Engine.GenericOctree", EAutomationTestFlags::ATF_Editor)
+
+#define OCTREE_TEST_TEXT( Format, ... ) FString::Printf(TEXT("%s - %d: %s"), TEXT(__FILE__) , __LINE__ , *FString::Printf(TEXT(Format), ##__VA_ARGS__) )
+
+/** A moving box, which knows where the octree keeps it */
+struct FOctreeTestElement
+{
+	FBoxCenterAndExtent Bounds;
+	TArray<FOctreeElementId>* ElementIds;
+	int32 Index;
+};
+
+struct FOctreeTestSemantics
+{
+	enum { MaxElementsPerLeaf = 16 };
+	enum { MinInclusiveElementsPerNode = 7 };
+	enum { MaxNodeDepth = 12 };
+
+	typedef TInlineAllocator<MaxElementsPerLeaf> ElementAllocator;
+
+	FORCEINLINE static const FBoxCenterAndExtent& GetBoundingBox(const FOctreeTestElement& Element)
+	{
+		return Element.Bounds;
+	}
+
+	FORCEINLINE static void SetElementId(const FOctreeTestElement& Element, FOctreeElementId Id)
+	{
+		(*Element.ElementIds)[Element.Index] = Id;
+	}
+};
+
+typedef TOctree<FOctreeTestElement, FOctreeTestSemantics> FOctreeTestTree;
+
+/** How the elements are moved every frame */
+namespace EOctreeTestUpdate
+{
+	enum Type
+	{
+		RemoveAndAdd,
+		RelocateElement,
+		RelocateElements,
+	};
+}
+
+/** Moves NumElements boxes around the octree for NumFrames frames, checks the octree still finds all of them, and returns the time spent updating the octree */
+double GenericOctreeTest_MovingElements(EOctreeTestUpdate::Type UpdateType, FAutomationTestBase* Test)
+{
+	const int32 NumElements = 10000;
+	const int32 NumFrames = 60;
+	const float WorldExtent = 50000.f;
+	const float MaxSpeed = 20.f;
+
+	FOctreeTestTree Octree(FVector::ZeroVector, HALF_WORLD_MAX);
+	TArray<FOctreeElementId> ElementIds;
+	ElementIds.SetNum(NumElements);
+
+	// The same seed for every update type, so they all move the same boxes the same way
+	FRandomStream RandomStream(0);
+
+	TArray<FOctreeTestElement> Elements;
+	TArray<FVector> Velocities;
+	Elements.SetNum(NumElements);
+	Velocities.SetNum(NumElements);
+	for (int32 Idx = 0; Idx < NumElements; ++Idx)
+	{
+		const FVector Center(RandomStream.FRandRange(-WorldExtent, WorldExtent), RandomStream.FRandRange(-WorldExtent, WorldExtent), RandomStream.FRandRange(-WorldExtent, WorldExtent));
+		Elements[Idx].Bounds = FBoxCenterAndExtent(Center, FVector(RandomStream.FRandRange(50.f, 200.f)));
+		Elements[Idx].ElementIds = &ElementIds;
+		Elements[Idx].Index = Idx;
+		Velocities[Idx] = RandomStream.GetUnitVector() * RandomStream.FRandRange(0.f, MaxSpeed);
+		Octree.AddElement(Elements[Idx]);
+	}
+
+	double UpdateTime = 0.0;
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		for (int32 Idx = 0; Idx < NumElements; ++Idx)
+		{
+			Elements[Idx].Bounds.Center += FVector4(Velocities[Idx], 0.f);
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+		switch (UpdateType)
+		{
+		case EOctreeTestUpdate::RemoveAndAdd:
+			for (int32 Idx = 0; Idx < NumElements; ++Idx)
+			{
+				Octree.RemoveElement(ElementIds[Idx]);
+				Octree.AddElement(Elements[Idx]);
+			}
+			break;
+		case EOctreeTestUpdate::RelocateElement:
+			for (int32 Idx = 0; Idx < NumElements; ++Idx)
+			{
+				Octree.RelocateElement(ElementIds[Idx], Elements[Idx]);
+			}
+			break;
+		case EOctreeTestUpdate::RelocateElements:
+			Octree.RelocateElements(ElementIds, Elements);
+			break;
+		}
+		UpdateTime += FPlatformTime::Seconds() - StartTime;
+	}
+
+	for (int32 Idx = 0; Idx < NumElements; ++Idx)
+	{
+		if (!ElementIds[Idx].IsValidId() || Octree.GetElementById(ElementIds[Idx]).Index != Idx)
+		{
+			Test->AddError(OCTREE_TEST_TEXT("Update type %d: element %d has a stale ID", (int32)UpdateType, Idx));
+			return UpdateTime;
+		}
+
+		bool bFound = false;
+		for (FOctreeTestTree::TConstElementBoxIterator<> It(Octree, Elements[Idx].Bounds); It.HasPendingElements() && !bFound; It.Advance())
+		{
+			bFound = (It.GetCurrentElement().Index == Idx);
+		}
+		if (!bFound)
+		{
+			Test->AddError(OCTREE_TEST_TEXT("Update type %d: element %d isn't found at its bounds", (int32)UpdateType, Idx));
+			return UpdateTime;
+		}
+	}
+
+	int32 NumElementsInOctree = 0;
+	for (FOctreeTestTree::TConstIterator<> NodeIt(Octree); NodeIt.HasPendingNodes(); NodeIt.Advance())
+	{
+		const FOctreeTestTree::FNode& Node = NodeIt.GetCurrentNode();
+		NumElementsInOctree += Node.GetElements().Num();
+		FOREACH_OCTREE_CHILD_NODE(ChildRef)
+		{
+			if (Node.HasChild(ChildRef))
+			{
+				NodeIt.PushChild(ChildRef);
+			}
+		}
+	}
+	Test->TestTrue(OCTREE_TEST_TEXT("Update type %d: the octree holds every element once", (int32)UpdateType), NumElementsInOctree == NumElements);
+
+	return UpdateTime;
+}
+
+bool FGenericOctreeTest::RunTest(const FString& Parameters)
+{
+	const double RemoveAndAddTime = GenericOctreeTest_MovingElements(EOctreeTestUpdate::RemoveAndAdd, this);
+	const double RelocateElementTime = GenericOctreeTest_MovingElements(EOctreeTestUpdate::RelocateElement, this);
+	const double RelocateElementsTime = GenericOctreeTest_MovingElements(EOctreeTestUpdate::RelocateElements, this);
+
+	AddLogItem(FString::Printf(TEXT("10000 elements moving for 60 frames: remove and add %.2f ms, RelocateElement %.2f ms, RelocateElements %.2f ms"),
+		RemoveAndAddTime * 1000.0, RelocateElementTime * 1000.0, RelocateElementsTime * 1000.0));
+
+	return true;
+}
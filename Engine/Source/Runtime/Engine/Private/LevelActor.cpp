@@ -230,6 +230,7 @@ AActor* UWorld::SpawnActor( UClass* Class, FVector const* Location, FRotator con
 {
 	SCOPE_CYCLE_COUNTER(STAT_SpawnActorTime);
 	check( CurrentLevel ); 	
+	FParallelTickValidation::CheckWrite(this, TEXT("SpawnActor"));
 	check(GIsEditor || (CurrentLevel == PersistentLevel));
 
 	// Make sure this class is spawnable.
@@ -391,6 +392,7 @@ bool UWorld::DestroyActor( AActor* ThisActor, bool bNetForce, bool bShouldModify
 {
 	check(ThisActor);
 	check(ThisActor->IsValidLowLevel());
+	FParallelTickValidation::CheckWrite(this, TEXT("DestroyActor"));
 	//UE_LOG(LogSpawn, Log,  "Destroy %s", *ThisActor->GetClass()->GetName() );
 
 	if (ThisActor->GetWorld() == NULL)
@@ -17,6 +17,7 @@
 //#include "SoundDefinitions.h"
 #include "FXSystem.h"
 #include "TickTaskManagerInterface.h"
+#include "OverlapUpdateBatch.h"
 #include "IPlatformFileProfilerWrapper.h"
 #if WITH_PHYSX
 #include "PhysicsEngine/PhysXSupport.h"
@@ -692,7 +693,10 @@ void UWorld::ProcessLevelStreamingVolumes(FVector* OverrideViewLocation)
 void UWorld::RunTickGroup(ETickingGroup Group, bool bBlockTillComplete = true)
 {
 	check(TickGroup == Group); // this should already be at the correct value, but we want to make sure things are happening in the right order
+	// Overlap updates of components moved by this group are applied together once its ticks are done (see p.ParallelUpdateOverlaps)
+	FOverlapUpdateBatch::Open(this);
 	FTickTaskManagerInterface::Get().RunTickGroup(Group, bBlockTillComplete);
+	FOverlapUpdateBatch::Flush();
 	TickGroup = ETickingGroup(TickGroup + 1); // new actors go into the next tick group because this one is already gone
 }
 
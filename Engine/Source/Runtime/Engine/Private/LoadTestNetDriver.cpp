@@ -0,0 +1,293 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	LoadTestNetDriver.cpp: In-memory server network driver for load testing replication with simulated clients.
+=============================================================================*/
+
+#include "EnginePrivate.h"
+#include "Engine/LoadTestNetDriver.h"
+#include "Engine/LoadTestNetConnection.h"
+#include "Net/PacketCompression.h"
+
+DEFINE_LOG_CATEGORY_STATIC( LogLoadTestNet, Log, All );
+
+/** Acks that fit in one client packet, each ack is at most 16 bits and packets are at least 512 bytes */
+static const int32 MAX_ACKS_PER_CLIENT_PACKET = 200;
+
+/*-----------------------------------------------------------------------------
+	ULoadTestNetDriver.
+-----------------------------------------------------------------------------*/
+
+ULoadTestNetDriver::ULoadTestNetDriver( const FObjectInitializer& ObjectInitializer )
+	: Super( ObjectInitializer )
+	, SimulatedLag( 0.0f )
+	, LastServerReplicateActorsTime( 0.0 )
+{
+}
+
+bool ULoadTestNetDriver::InitBase( bool bInitAsClient, FNetworkNotify* InNotify, const FURL& URL, bool bReuseAddressAndPort, FString& Error )
+{
+	if ( bInitAsClient )
+	{
+		Error = TEXT( "The load test driver only supports the server side of a connection" );
+		return false;
+	}
+
+	return Super::InitBase( bInitAsClient, InNotify, URL, bReuseAddressAndPort, Error );
+}
+
+bool ULoadTestNetDriver::InitConnect( FNetworkNotify* InNotify, const FURL& ConnectURL, FString& Error )
+{
+	return InitBase( true, InNotify, ConnectURL, false, Error );
+}
+
+bool ULoadTestNetDriver::InitListen( FNetworkNotify* InNotify, FURL& ListenURL, bool bReuseAddressAndPort, FString& Error )
+{
+	if ( !InitBase( false, InNotify, ListenURL, bReuseAddressAndPort, Error ) )
+	{
+		return false;
+	}
+
+	UE_LOG( LogLoadTestNet, Log, TEXT( "%s listening for simulated clients" ), *GetDescription() );
+
+	return true;
+}
+
+FString ULoadTestNetDriver::LowLevelGetNetworkNumber()
+{
+	return FString( TEXT( "" ) );
+}
+
+void ULoadTestNetDriver::TickDispatch( float DeltaSeconds )
+{
+	Super::TickDispatch( DeltaSeconds );
+
+	// Receive whatever the clients sent us since the last frame
+	for ( int32 i = 0; i < ClientConnections.Num(); i++ )
+	{
+		ULoadTestNetConnection* Connection = Cast< ULoadTestNetConnection >( ClientConnections[i] );
+
+		if ( Connection != NULL && Connection->State == USOCK_Open )
+		{
+			Connection->TickSimulatedClient();
+		}
+	}
+
+	OnSimulateClients.Broadcast( DeltaSeconds );
+}
+
+int32 ULoadTestNetDriver::ServerReplicateActors( float DeltaSeconds )
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	const int32 Updated = Super::ServerReplicateActors( DeltaSeconds );
+
+	LastServerReplicateActorsTime = FPlatformTime::Seconds() - StartTime;
+
+	return Updated;
+}
+
+void ULoadTestNetDriver::ProcessRemoteFunction( class AActor* Actor, class UFunction* Function, void* Parameters, struct FOutParmRec* OutParms, struct FFrame* Stack, class UObject* SubObject )
+{
+	// Same routing as a socket based server
+	if ( Function->FunctionFlags & FUNC_NetMulticast )
+	{
+		for ( int32 i = 0; i < ClientConnections.Num(); i++ )
+		{
+			UNetConnection* Connection = ClientConnections[i];
+
+			if ( Connection != NULL && Connection->Viewer )
+			{
+				bool IsRelevant = true;
+
+				if ( ( Function->FunctionFlags & FUNC_NetReliable ) == 0 )
+				{
+					FNetViewer Viewer( Connection, 0.f );
+					IsRelevant = Actor->IsNetRelevantFor( Viewer.InViewer, Viewer.Viewer, Viewer.ViewLocation );
+				}
+
+				if ( IsRelevant )
+				{
+					InternalProcessRemoteFunction( Actor, SubObject, Connection, Function, Parameters, OutParms, Stack, true );
+				}
+			}
+		}
+
+		return;
+	}
+
+	UNetConnection* Connection = Actor->GetNetConnection();
+
+	if ( Connection != NULL )
+	{
+		InternalProcessRemoteFunction( Actor, SubObject, Connection, Function, Parameters, OutParms, Stack, true );
+	}
+}
+
+ULoadTestNetConnection* ULoadTestNetDriver::AddSimulatedClient( const FURL& ClientURL, int32 NetSpeed, FString& Error )
+{
+	check( World != NULL );
+
+	ULoadTestNetConnection* Connection = ConstructObject< ULoadTestNetConnection >( NetConnectionClass );
+	Connection->InitConnection( this, USOCK_Open, ClientURL, NetSpeed );
+
+	// The client would ask for this with NMT_Netspeed
+	Connection->CurrentNetSpeed = FMath::Clamp( Connection->CurrentNetSpeed, 1800, MaxClientRate );
+
+	ClientConnections.Add( Connection );
+
+	// Skip the handshake, the client is always welcome and has the current map loaded
+	Connection->RequestURL = ClientURL.ToString();
+	Connection->SetClientLoginState( EClientLoginState::Welcomed );
+	Connection->ClientWorldPackageName = World->GetCurrentLevel()->GetOutermost()->GetFName();
+
+	// Simulated clients share the server's compression dictionary
+	Connection->NegotiatePacketCompression( GetPacketCompressionChecksum() );
+
+	Connection->PlayerController = World->SpawnPlayActor( Connection, ROLE_AutonomousProxy, ClientURL, Connection->PlayerId, Error );
+
+	if ( Connection->PlayerController == NULL )
+	{
+		// Cleaned up by the next TickDispatch
+		Connection->Close();
+		return NULL;
+	}
+
+	return Connection;
+}
+
+/*-----------------------------------------------------------------------------
+	ULoadTestNetConnection.
+-----------------------------------------------------------------------------*/
+
+ULoadTestNetConnection::ULoadTestNetConnection( const FObjectInitializer& ObjectInitializer )
+	: Super( ObjectInitializer )
+	, TotalOutBytes( 0 )
+	, TotalOutPackets( 0 )
+	, ClientPacketId( 0 )
+	, LastClientSendTime( 0.0f )
+{
+}
+
+void ULoadTestNetConnection::InitConnection( UNetDriver* InDriver, EConnectionState InState, const FURL& InURL, int32 InConnectionSpeed )
+{
+	Super::InitConnection( InDriver, InState, InURL, InConnectionSpeed );
+
+	InitSendBuffer();
+
+	// the driver must be a load test driver (GetDriver makes assumptions to avoid Cast'ing each time)
+	check( InDriver->IsA( ULoadTestNetDriver::StaticClass() ) );
+
+	LastReceiveTime = Driver->Time;
+	LastClientSendTime = Driver->Time;
+}
+
+FString ULoadTestNetConnection::LowLevelGetRemoteAddress( bool bAppendPort )
+{
+	return GetName();
+}
+
+FString ULoadTestNetConnection::LowLevelDescribe()
+{
+	return FString::Printf( TEXT( "Simulated client %s" ), *GetName() );
+}
+
+void ULoadTestNetConnection::LowLevelSend( void* Data, int32 Count )
+{
+	TotalOutBytes += Count;
+	TotalOutPackets++;
+
+	uint8* PacketData = (uint8*)Data;
+	int32 PacketSize = Count;
+
+	if ( FNetPacketCompressor::IsCompressedPacket( PacketData, PacketSize ) )
+	{
+		if ( !Driver->PacketCompressor.IsValid() || !Driver->PacketCompressor->Decompress( PacketData, PacketSize, HeaderBuffer ) )
+		{
+			UE_LOG( LogLoadTestNet, Warning, TEXT( "%s: Failed to decompress outgoing packet, it won't be acked" ), *LowLevelDescribe() );
+			return;
+		}
+
+		PacketData = HeaderBuffer.GetData();
+		PacketSize = HeaderBuffer.Num();
+	}
+
+	// The client only looks at the packet id, so it can ack it
+	FBitReader Reader( PacketData, PacketSize * 8 );
+
+	FLoadTestPendingAck PendingAck;
+	PendingAck.PacketId = Reader.ReadInt( MAX_PACKETID );
+	PendingAck.AckTime = Driver->Time + GetDriver()->SimulatedLag;
+
+	if ( !Reader.IsError() )
+	{
+		PendingAcks.Add( PendingAck );
+	}
+}
+
+void ULoadTestNetConnection::TickSimulatedClient()
+{
+	int32 NumDueAcks = 0;
+
+	while ( NumDueAcks < PendingAcks.Num() && PendingAcks[NumDueAcks].AckTime <= Driver->Time )
+	{
+		NumDueAcks++;
+	}
+
+	if ( NumDueAcks > 0 )
+	{
+		TArray< int32 > AckPacketIds;
+		AckPacketIds.Reserve( NumDueAcks );
+
+		for ( int32 i = 0; i < NumDueAcks; i++ )
+		{
+			AckPacketIds.Add( PendingAcks[i].PacketId );
+		}
+
+		PendingAcks.RemoveAt( 0, NumDueAcks, false );
+
+		for ( int32 FirstAck = 0; FirstAck < AckPacketIds.Num() && State == USOCK_Open; FirstAck += MAX_ACKS_PER_CLIENT_PACKET )
+		{
+			SendClientPacket( AckPacketIds, FirstAck, FMath::Min( MAX_ACKS_PER_CLIENT_PACKET, AckPacketIds.Num() - FirstAck ) );
+		}
+	}
+	else if ( Driver->Time - LastClientSendTime > Driver->KeepAliveTime )
+	{
+		SendClientPacket( TArray< int32 >(), 0, 0 );
+	}
+}
+
+void ULoadTestNetConnection::SendClientPacket( const TArray< int32 >& AckPacketIds, int32 FirstAck, int32 NumAcks )
+{
+	// Same layout UNetConnection uses on the client: packet id, acks, then the terminator bit
+	FBitWriter Writer( MaxPacket * 8 );
+
+	Writer.WriteIntWrapped( ClientPacketId++, MAX_PACKETID );
+
+	for ( int32 i = FirstAck; i < FirstAck + NumAcks; i++ )
+	{
+		const int32 AckPacketId = AckPacketIds[i];
+
+		Writer.WriteBit( 1 );
+		Writer.WriteIntWrapped( AckPacketId, MAX_PACKETID );
+
+		if ( ( AckPacketId % PING_ACK_PACKET_INTERVAL ) == 0 )
+		{
+			// No ping ack data
+			Writer.WriteBit( 0 );
+		}
+	}
+
+	Writer.WriteBit( 1 );
+
+	while ( Writer.GetNumBits() & 7 )
+	{
+		Writer.WriteBit( 0 );
+	}
+
+	check( !Writer.IsError() );
+
+	LastClientSendTime = Driver->Time;
+
+	ReceivedRawPacket( Writer.GetData(), Writer.GetNumBytes() );
+}
@@ -8,6 +8,7 @@
 #include "Net/UnrealNetwork.h"
 #include "Net/NetworkProfiler.h"
 #include "Net/DataReplication.h"
+#include "Net/PacketCompression.h"
 #include "Engine/ActorChannel.h"
 #include "DataChannel.h"
 #include "Engine/PackageMapClient.h"
@@ -54,6 +55,7 @@ UNetConnection::UNetConnection(const FObjectInitializer& ObjectInitializer)
 ,	CountedFrames		( 0 )
 
 ,	SendBuffer			( 0 )
+,	bPacketCompressionEnabled( false )
 ,	InPacketId			( -1 )
 ,	OutPacketId			( 0 ) // must be initialized as OutAckPacketId + 1 so loss of first packet can be detected
 ,	OutAckPacketId		( -1 )
@@ -442,6 +444,23 @@ void UNetConnection::ReceivedRawPacket( void* InData, int32 Count )
 	InBytes += PacketBytes;
 	Driver->InBytes += PacketBytes;
 	Driver->InPackets++;
+
+	// Compressed packets end with a zero byte, which can't happen for regular packets since those end with the terminator bit.
+	// The other side only compresses once it got our dictionary checksum in the handshake and it matched its own,
+	// which can be before we got its checksum, so any packet is decompressed as long as we have a dictionary.
+	if( !InternalAck && FNetPacketCompressor::IsCompressedPacket( Data, Count ) )
+	{
+		if( !Driver->PacketCompressor.IsValid() || !Driver->PacketCompressor->Decompress( Data, Count, PacketDecompressionBuffer ) )
+		{
+			UE_LOG( LogNetTraffic, Error, TEXT( "Failed to decompress packet from %s (compression %s), closing connection" ), *LowLevelGetRemoteAddress(), Driver->PacketCompressor.IsValid() ? TEXT( "enabled" ) : TEXT( "disabled" ) );
+			Close();
+			return;
+		}
+
+		Data = PacketDecompressionBuffer.GetData();
+		Count = PacketDecompressionBuffer.Num();
+	}
+
 	if( Count>0 )
 	{
 		uint8 LastByte = Data[Count-1];
@@ -494,6 +513,24 @@ void UNetConnection::FlushNet(bool bIgnoreSimulation)
 		}
 		ValidateSendBuffer();
 
+		uint8* PacketData = SendBuffer.GetData();
+		int32 PacketSize = SendBuffer.GetNumBytes();
+
+		if( !InternalAck )
+		{
+			FNetPacketCapture::CapturePacket( PacketData, PacketSize );
+
+			// Send compressed if that makes the packet smaller
+			if( bPacketCompressionEnabled && Driver->PacketCompressor.IsValid() && Driver->PacketCompressor->Compress( PacketData, PacketSize, PacketCompressionBuffer ) )
+			{
+				Driver->OutCompressedPackets++;
+				Driver->OutCompressionSavedBytes += PacketSize - PacketCompressionBuffer.Num();
+
+				PacketData = PacketCompressionBuffer.GetData();
+				PacketSize = PacketCompressionBuffer.Num();
+			}
+		}
+
 		// Send now.
 #if DO_ENABLE_NET_TEST
 		// if the connection is closing/being destroyed/etc we need to send immediately regardless of settings
@@ -503,14 +540,14 @@ void UNetConnection::FlushNet(bool bIgnoreSimulation)
 			// Checked in FlushNet() so each child class doesn't have to implement this
 			if (Driver->IsNetResourceValid())
 			{
-				LowLevelSend(SendBuffer.GetData(), SendBuffer.GetNumBytes());
+				LowLevelSend(PacketData, PacketSize);
 			}
 		}
 		else if( PacketSimulationSettings.PktOrder )
 		{
 			DelayedPacket& B = *(new(Delayed)DelayedPacket);
-			B.Data.AddUninitialized( SendBuffer.GetNumBytes() );
-			FMemory::Memcpy( B.Data.GetData(), SendBuffer.GetData(), SendBuffer.GetNumBytes() );
+			B.Data.AddUninitialized( PacketSize );
+			FMemory::Memcpy( B.Data.GetData(), PacketData, PacketSize );
 
 			for( int32 i=Delayed.Num()-1; i>=0; i-- )
 			{
@@ -533,8 +570,8 @@ void UNetConnection::FlushNet(bool bIgnoreSimulation)
 			if( !PacketSimulationSettings.PktLoss || FMath::FRand()*100.f > PacketSimulationSettings.PktLoss )
 			{
 				DelayedPacket& B = *(new(Delayed)DelayedPacket);
-				B.Data.AddUninitialized( SendBuffer.GetNumBytes() );
-				FMemory::Memcpy( B.Data.GetData(), SendBuffer.GetData(), SendBuffer.GetNumBytes() );
+				B.Data.AddUninitialized( PacketSize );
+				FMemory::Memcpy( B.Data.GetData(), PacketData, PacketSize );
 				B.SendTime = FPlatformTime::Seconds() + (double(PacketSimulationSettings.PktLag)  + 2.0f * (FMath::FRand() - 0.5f) * double(PacketSimulationSettings.PktLagVariance))/ 1000.f;
 			}
 		}
@@ -544,7 +581,7 @@ void UNetConnection::FlushNet(bool bIgnoreSimulation)
 			// Checked in FlushNet() so each child class doesn't have to implement this
 			if (Driver->IsNetResourceValid())
 			{
-				LowLevelSend( SendBuffer.GetData(), SendBuffer.GetNumBytes() );
+				LowLevelSend( PacketData, PacketSize );
 			}
 #if DO_ENABLE_NET_TEST
 			if( PacketSimulationSettings.PktDup && FMath::FRand()*100.f < PacketSimulationSettings.PktDup )
@@ -552,7 +589,7 @@ void UNetConnection::FlushNet(bool bIgnoreSimulation)
 				// Checked in FlushNet() so each child class doesn't have to implement this
 				if (Driver->IsNetResourceValid())
 				{
-					LowLevelSend( (char*)SendBuffer.GetData(), SendBuffer.GetNumBytes() );
+					LowLevelSend( PacketData, PacketSize );
 				}
 			}
 		}
@@ -564,7 +601,7 @@ void UNetConnection::FlushNet(bool bIgnoreSimulation)
 		OutPacketId++;
 		Driver->OutPackets++;
 		LastSendTime = Driver->Time;
-		const int32 PacketBytes = SendBuffer.GetNumBytes() + PacketOverhead;
+		const int32 PacketBytes = PacketSize + PacketOverhead;
 		QueuedBytes += PacketBytes;
 		OutBytes += PacketBytes;
 		Driver->OutBytes += PacketBytes;
@@ -638,7 +675,10 @@ void UNetConnection::ReceivedPacket( FBitReader& Reader )
 	LastReceiveTime = Driver->Time;
 
 	// Check packet ordering.
-	const int32 PacketId = MakeRelative(Reader.ReadInt(MAX_PACKETID),InPacketId,MAX_PACKETID);
+	// Internally acked connections (demo playback) are always in order. Their sequence is implicit, so the stream
+	// can be entered at any point (checkpoints are recorded on a different connection than the frames that follow them).
+	const int32 SerializedPacketId = Reader.ReadInt(MAX_PACKETID);
+	const int32 PacketId = InternalAck ? InPacketId + 1 : MakeRelative(SerializedPacketId,InPacketId,MAX_PACKETID);
 	if( PacketId > InPacketId )
 	{
 		const int32 PacketsLost = PacketId - InPacketId - 1;
@@ -813,7 +853,8 @@ void UNetConnection::ReceivedPacket( FBitReader& Reader )
 			if ( Bunch.bReliable )
 			{
 				// If this is a reliable bunch, use the last processed reliable sequence to read the new reliable sequence
-				Bunch.ChSequence = MakeRelative( Reader.ReadInt( MAX_CHSEQUENCE ), InReliable[Bunch.ChIndex], MAX_CHSEQUENCE );
+				const int32 SerializedChSequence = Reader.ReadInt( MAX_CHSEQUENCE );
+				Bunch.ChSequence = InternalAck ? InReliable[Bunch.ChIndex] + 1 : MakeRelative( SerializedChSequence, InReliable[Bunch.ChIndex], MAX_CHSEQUENCE );
 			} 
 			else if ( Bunch.bPartial )
 			{
@@ -1746,6 +1787,23 @@ void UNetConnection::SetExpectedClientLoginMsgType( const uint8 NewType )
 }
 
 /** This function validates that ClientMsgType is the next expected msg type. */
+void UNetConnection::NegotiatePacketCompression( uint32 RemoteChecksum )
+{
+	const uint32 LocalChecksum = Driver->GetPacketCompressionChecksum();
+
+	bPacketCompressionEnabled = ( LocalChecksum != 0 && LocalChecksum == RemoteChecksum );
+
+	if ( LocalChecksum != 0 && RemoteChecksum != 0 && LocalChecksum != RemoteChecksum )
+	{
+		UE_LOG( LogNet, Error, TEXT( "Packet compression dictionary mismatch with %s (local checksum %08X, remote checksum %08X). Packet compression is disabled for this connection, make sure both sides use the same PacketCompressionDictionary." ),
+			*LowLevelGetRemoteAddress(), LocalChecksum, RemoteChecksum );
+	}
+	else
+	{
+		UE_LOG( LogNet, Log, TEXT( "Packet compression %s for %s" ), bPacketCompressionEnabled ? TEXT( "enabled" ) : TEXT( "disabled" ), *LowLevelGetRemoteAddress() );
+	}
+}
+
 bool UNetConnection::IsClientMsgTypeValid( const uint8 ClientMsgType )
 {
 	if ( ClientLoginState == EClientLoginState::LoggingIn )
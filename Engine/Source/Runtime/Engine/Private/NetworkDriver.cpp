@@ -9,6 +9,7 @@
 #include "Net/UnrealNetwork.h"
 #include "Net/NetworkProfiler.h"
 #include "Net/RepLayout.h"
+#include "Net/PacketCompression.h"
 #include "Engine/ActorChannel.h"
 #include "Engine/VoiceChannel.h"
 #include "GameFramework/GameNetworkManager.h"
@@ -47,6 +48,8 @@ DEFINE_STAT(STAT_NumNetGUIDsPending);
 DEFINE_STAT(STAT_NumNetGUIDsUnAckd);
 DEFINE_STAT(STAT_ObjPathBytes);
 DEFINE_STAT(STAT_NetGUIDInRate);
+DEFINE_STAT(STAT_OutCompressedPackets);
+DEFINE_STAT(STAT_OutCompressionSavedRate);
 DEFINE_STAT(STAT_NetGUIDOutRate);
 DEFINE_STAT(STAT_NetSaturated);
 
@@ -107,6 +110,8 @@ UNetDriver::UNetDriver(const FObjectInitializer& ObjectInitializer)
 ,	OutBytes(0)
 ,	NetGUIDOutBytes(0)
 ,	NetGUIDInBytes(0)
+,	OutCompressedPackets(0)
+,	OutCompressionSavedBytes(0)
 ,	InPackets(0)
 ,	OutPackets(0)
 ,	InBunches(0)
@@ -192,6 +197,9 @@ void UNetDriver::TickFlush(float DeltaSeconds)
 			NetGUIDOutBytes = FMath::TruncToInt(NetGUIDOutBytes / RealTime);
 			NetGUIDInBytes = FMath::TruncToInt(NetGUIDInBytes / RealTime);
 
+			OutCompressedPackets = FMath::TruncToInt(OutCompressedPackets / RealTime);
+			OutCompressionSavedBytes = FMath::TruncToInt(OutCompressionSavedBytes / RealTime);
+
 			// Save off for stats later
 
 			InBytesPerSecond = InBytes;
@@ -273,6 +281,9 @@ void UNetDriver::TickFlush(float DeltaSeconds)
 		SET_DWORD_STAT(STAT_NetGUIDInRate, NetGUIDInBytes);
 		SET_DWORD_STAT(STAT_NetGUIDOutRate, NetGUIDOutBytes);
 
+		SET_DWORD_STAT(STAT_OutCompressedPackets, OutCompressedPackets);
+		SET_DWORD_STAT(STAT_OutCompressionSavedRate, OutCompressionSavedBytes);
+
 		SET_DWORD_STAT(STAT_VoicePacketsSent, VoicePacketsSent);
 		SET_DWORD_STAT(STAT_VoicePacketsRecv, VoicePacketsRecv);
 		SET_DWORD_STAT(STAT_VoiceBytesSent, VoiceBytesSent);
@@ -295,6 +306,8 @@ void UNetDriver::TickFlush(float DeltaSeconds)
 		OutBytes = 0;
 		NetGUIDOutBytes = 0;
 		NetGUIDInBytes = 0;
+		OutCompressedPackets = 0;
+		OutCompressionSavedBytes = 0;
 		InPackets = 0;
 		OutPackets = 0;
 		InBunches = 0;
@@ -484,9 +497,31 @@ bool UNetDriver::InitBase(bool bInitAsClient, FNetworkNotify* InNotify, const FU
 {
 	bool bSuccess = InitConnectionClass();
 	Notify = InNotify;
+
+	PacketCompressor.Reset();
+
+	if (bEnablePacketCompression)
+	{
+		TSharedPtr< FNetPacketCompressor > Compressor = MakeShareable(new FNetPacketCompressor());
+
+		if (Compressor->LoadDictionary(FPaths::GameDir() / PacketCompressionDictionary))
+		{
+			PacketCompressor = Compressor;
+		}
+		else
+		{
+			UE_LOG(LogNet, Warning, TEXT("UNetDriver::InitBase: Failed to load packet compression dictionary %s, packets will be sent uncompressed"), *PacketCompressionDictionary);
+		}
+	}
+
 	return bSuccess;
 }
 
+uint32 UNetDriver::GetPacketCompressionChecksum() const
+{
+	return PacketCompressor.IsValid() ? PacketCompressor->GetDictionaryChecksum() : 0;
+}
+
 ENetMode UNetDriver::GetNetMode() const
 {
 	// Special case for PIE - forcing dedicated server behavior
@@ -1725,6 +1760,54 @@ FActorPriority::FActorPriority(class UNetConnection* InConnection, struct FActor
 	}
 }
 
+/**
+ * Binary max-heap helpers for the prioritized actors of a connection.
+ * Only the actors that get replicated before the connection saturates are ever pulled out in order,
+ * so building the heap and popping from it is cheaper than sorting the whole list.
+ */
+static void SiftDownActorPriority(FActorPriority** Heap, int32 Index, int32 Count)
+{
+	while (true)
+	{
+		const int32 Left = Index * 2 + 1;
+		const int32 Right = Left + 1;
+		int32 Highest = Index;
+
+		if (Left < Count && Heap[Left]->Priority > Heap[Highest]->Priority)
+		{
+			Highest = Left;
+		}
+		if (Right < Count && Heap[Right]->Priority > Heap[Highest]->Priority)
+		{
+			Highest = Right;
+		}
+		if (Highest == Index)
+		{
+			return;
+		}
+
+		Swap(Heap[Index], Heap[Highest]);
+		Index = Highest;
+	}
+}
+
+static void HeapifyActorPriorities(FActorPriority** Heap, int32 Count)
+{
+	for (int32 Index = Count / 2 - 1; Index >= 0; Index--)
+	{
+		SiftDownActorPriority(Heap, Index, Count);
+	}
+}
+
+/** Moves the highest priority entry of a heap of Count entries to Heap[Count - 1] and returns it, the heap is left with Count - 1 entries */
+static FActorPriority* PopActorPriority(FActorPriority** Heap, int32 Count)
+{
+	check(Count > 0);
+	Swap(Heap[0], Heap[Count - 1]);
+	SiftDownActorPriority(Heap, 0, Count - 1);
+	return Heap[Count - 1];
+}
+
 int32 UNetDriver::ServerReplicateActors(float DeltaSeconds)
 {
 	SCOPE_CYCLE_COUNTER(STAT_NetServerRepActorsTime);
@@ -2269,15 +2352,8 @@ int32 UNetDriver::ServerReplicateActors(float DeltaSeconds)
 				SET_DWORD_STAT(STAT_PrioritizedActors,ConsiderCount);
 				SET_DWORD_STAT(STAT_NumRelevantDeletedActors,DeletedCount);
 
-				// Sort by priority
-				struct FCompareFActorPriority
-				{
-					FORCEINLINE bool operator()( const FActorPriority& A, const FActorPriority& B ) const
-					{
-						return B.Priority < A.Priority;
-					}
-				};
-				Sort( PriorityActors, ConsiderCount, FCompareFActorPriority() );
+				// Order by priority, actors are pulled out of the heap as they get replicated
+				HeapifyActorPriorities( PriorityActors, ConsiderCount );
 
 			} // END PRIORITIZE
 
@@ -2293,11 +2369,13 @@ int32 UNetDriver::ServerReplicateActors(float DeltaSeconds)
 				int32 FinalRelevantCount = 0;
 				for (j = 0; j < ConsiderCount; j++)
 				{
+					FActorPriority* const ActorPriority = PopActorPriority( PriorityActors, ConsiderCount - j );
+
 					// Deletion entry
-					if (PriorityActors[j]->Actor == NULL && PriorityActors[j]->DestructionInfo)
+					if (ActorPriority->Actor == NULL && ActorPriority->DestructionInfo)
 					{
 						// Make sure client has streaming level loaded
-						if (PriorityActors[j]->DestructionInfo->StreamingLevelName != NAME_None && !Connection->ClientVisibleLevelNames.Contains(PriorityActors[j]->DestructionInfo->StreamingLevelName))
+						if (ActorPriority->DestructionInfo->StreamingLevelName != NAME_None && !Connection->ClientVisibleLevelNames.Contains(ActorPriority->DestructionInfo->StreamingLevelName))
 						{
 							// This deletion entry is for an actor in a streaming level the connection doesn't have loaded, so skip it
 							continue;
@@ -2307,28 +2385,28 @@ int32 UNetDriver::ServerReplicateActors(float DeltaSeconds)
 						if (Channel)
 						{
 							FinalRelevantCount++;
-							UE_LOG(LogNetTraffic, Log, TEXT("Server replicate actor creating destroy channel for NetGUID <%s,%s> Priority: %d"), *PriorityActors[j]->DestructionInfo->NetGUID.ToString(), *PriorityActors[j]->DestructionInfo->PathName, PriorityActors[j]->Priority );
+							UE_LOG(LogNetTraffic, Log, TEXT("Server replicate actor creating destroy channel for NetGUID <%s,%s> Priority: %d"), *ActorPriority->DestructionInfo->NetGUID.ToString(), *ActorPriority->DestructionInfo->PathName, ActorPriority->Priority );
 
-							Channel->SetChannelActorForDestroy( PriorityActors[j]->DestructionInfo ); // Send a close bunch on the new channel
-							Connection->DestroyedStartupOrDormantActors.Remove( PriorityActors[j]->DestructionInfo->NetGUID ); // Remove from connections to-be-destroyed list (close bunch of reliable, so it will make it there)
+							Channel->SetChannelActorForDestroy( ActorPriority->DestructionInfo ); // Send a close bunch on the new channel
+							Connection->DestroyedStartupOrDormantActors.Remove( ActorPriority->DestructionInfo->NetGUID ); // Remove from connections to-be-destroyed list (close bunch of reliable, so it will make it there)
 						}
 						continue;
 					}
 
 #if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
 					static IConsoleVariable* DebugObjectCvar = IConsoleManager::Get().FindConsoleVariable(TEXT("net.PackageMap.DebugObject"));
-					if (DebugObjectCvar && !DebugObjectCvar->GetString().IsEmpty() && PriorityActors[j]->Actor && PriorityActors[j]->Actor->GetName().Contains(DebugObjectCvar->GetString()) )
+					if (DebugObjectCvar && !DebugObjectCvar->GetString().IsEmpty() && ActorPriority->Actor && ActorPriority->Actor->GetName().Contains(DebugObjectCvar->GetString()) )
 					{
-						UE_LOG(LogNetPackageMap, Log, TEXT("Evaluating actor for replication %s"), *PriorityActors[j]->Actor->GetName());
+						UE_LOG(LogNetPackageMap, Log, TEXT("Evaluating actor for replication %s"), *ActorPriority->Actor->GetName());
 					}
 #endif
 
 					// Normal actor replication
-					UActorChannel* Channel     = PriorityActors[j]->Channel;
-					UE_LOG(LogNetTraffic, Log, TEXT(" Maybe Replicate %s"),*PriorityActors[j]->Actor->GetName());
+					UActorChannel* Channel     = ActorPriority->Channel;
+					UE_LOG(LogNetTraffic, Log, TEXT(" Maybe Replicate %s"),*ActorPriority->Actor->GetName());
 					if ( !Channel || Channel->Actor ) //make sure didn't just close this channel
 					{ 
-						AActor*		Actor       = PriorityActors[j]->Actor;
+						AActor*		Actor       = ActorPriority->Actor;
 						bool		bIsRelevant = false;
 
 						const bool bLevelInitializedForActor = IsLevelInitializedForActor(Actor, Connection);
@@ -2404,7 +2482,7 @@ int32 UNetDriver::ServerReplicateActors(float DeltaSeconds)
 								if( Channel->IsNetReady(0) )
 								{
 									// replicate the actor
-									UE_LOG(LogNetTraffic, Log, TEXT("- Replicate %s. %d"),*Actor->GetName(), PriorityActors[j]->Priority);
+									UE_LOG(LogNetTraffic, Log, TEXT("- Replicate %s. %d"),*Actor->GetName(), ActorPriority->Priority);
 									if (DebugRelevantActors)
 									{
 										LastRelevantActors.Add( Actor );
@@ -2455,7 +2533,8 @@ int32 UNetDriver::ServerReplicateActors(float DeltaSeconds)
 			}
 
 			// relevant actors that could not be processed this frame are marked to be considered for next frame
-			for ( int32 k=j; k<ConsiderCount; k++ )
+			// (those are still in the heap, along with the last one we processed if we stopped because of saturation)
+			for ( int32 k=0; k<ConsiderCount-j; k++ )
 			{
 				AActor* Actor = PriorityActors[k]->Actor;
 				if (!Actor)
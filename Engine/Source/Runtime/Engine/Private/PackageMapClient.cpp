@@ -24,6 +24,8 @@ static const int INTERNAL_LOAD_OBJECT_RECURSION_LIMIT = 16;
 
 static TAutoConsoleVariable<int32> CVarAllowAsyncLoading( TEXT( "net.AllowAsyncLoading" ), 0, TEXT( "Allow async loading" ) );
 static TAutoConsoleVariable<int32> CVarIgnorePackageMismatch( TEXT( "net.IgnorePackageMismatch" ), 0, TEXT( "Ignore when package versions are different" ) );
+static TAutoConsoleVariable<int32> CVarNetGUIDExportCache( TEXT( "net.NetGUIDExportCache" ), 1, TEXT( "Serialize the path of static objects once and share it between all connections" ) );
+static TAutoConsoleVariable<int32> CVarLevelNetGUIDs( TEXT( "net.LevelNetGUIDs" ), 1, TEXT( "Send clients the NetGUIDs of a level's startup objects in one message, so they don't need path exports if their copy of the level matches" ) );
 
 /*-----------------------------------------------------------------------------
 	UPackageMapClient implementation.
@@ -403,7 +405,6 @@ void UPackageMapClient::InternalWriteObject( FArchive & Ar, FNetworkGUID NetGUID
 			// If the object isn't NULL, expect an empty path name, then fill it out with the actual info
 			check( ObjectOuter == NULL );
 			check( ObjectPathName.IsEmpty() );
-			ObjectPathName = Object->GetName();
 			ObjectOuter = Object->GetOuter();
 		}
 		else
@@ -413,26 +414,32 @@ void UPackageMapClient::InternalWriteObject( FArchive & Ar, FNetworkGUID NetGUID
 			check( !ObjectPathName.IsEmpty() );
 		}
 
-		const bool bIsPackage = ( NetGUID.IsStatic() && Object != NULL && Object->GetOuter() == NULL );
-
-		check( bIsPackage == ( Cast< UPackage >( Object ) != NULL ) );		// Make sure it really is a package
-
 		// Serialize reference to outer. This is basically a form of compression.
 		FNetworkGUID OuterNetGUID = GuidCache->GetOrAssignNetGUID( ObjectOuter );
 
 		InternalWriteObject( Ar, OuterNetGUID, ObjectOuter, TEXT( "" ), NULL );
 
-		GEngine->NetworkRemapPath(Connection->Driver->GetWorld(), ObjectPathName, false);
+		if ( Object != NULL && NetGUID.IsStatic() && IsNetGUIDAuthority() && CVarNetGUIDExportCache.GetValueOnGameThread() > 0 )
+		{
+			// The path of a static object is the same for every connection with the same byte order, so we only serialize it once per byte order
+			FNetGUIDCachedExport& CachedExport = GuidCache->CachedExports.FindOrAdd( NetGUID );
+			const int32 ByteOrder = Ar.IsByteSwapping() ? 1 : 0;
 
-		// Serialize Name of object
-		Ar << ObjectPathName;
+			if ( CachedExport.NumBits[ByteOrder] == 0 )
+			{
+				FBitWriter PathWriter( 0, true );
+				PathWriter.SetByteSwapping( Ar.IsByteSwapping() );
+				InternalWriteObjectPath( PathWriter, NetGUID, Object, ObjectPathName );
 
-		if ( bIsPackage )
-		{
-			FGuid PackageGuid = CastChecked< const UPackage >( Object )->GetGuid();
-			Ar << PackageGuid;
+				CachedExport.Data[ByteOrder]	= *PathWriter.GetBuffer();
+				CachedExport.NumBits[ByteOrder]	= PathWriter.GetNumBits();
+			}
 
-			UE_LOG( LogNetPackageMap, VeryVerbose, TEXT( "InternalWriteObject: Package: %s, GUID: %s" ), *ObjectPathName, *PackageGuid.ToString() );
+			Ar.SerializeBits( CachedExport.Data[ByteOrder].GetData(), CachedExport.NumBits[ByteOrder] );
+		}
+		else
+		{
+			InternalWriteObjectPath( Ar, NetGUID, Object, ObjectPathName );
 		}
 
 		if ( GuidCache->IsExportingNetGUIDBunch )
@@ -445,6 +452,32 @@ void UPackageMapClient::InternalWriteObject( FArchive & Ar, FNetworkGUID NetGUID
 	}
 }
 
+/** Writes the name of an object (and the guid of its package if it is one), the part of a path export that follows the reference to its outer */
+void UPackageMapClient::InternalWriteObjectPath( FArchive& Ar, FNetworkGUID NetGUID, const UObject* Object, FString ObjectPathName )
+{
+	if ( Object != NULL )
+	{
+		ObjectPathName = Object->GetName();
+	}
+
+	const bool bIsPackage = ( NetGUID.IsStatic() && Object != NULL && Object->GetOuter() == NULL );
+
+	check( bIsPackage == ( Cast< UPackage >( Object ) != NULL ) );		// Make sure it really is a package
+
+	GEngine->NetworkRemapPath(Connection->Driver->GetWorld(), ObjectPathName, false);
+
+	// Serialize Name of object
+	Ar << ObjectPathName;
+
+	if ( bIsPackage )
+	{
+		FGuid PackageGuid = CastChecked< const UPackage >( Object )->GetGuid();
+		Ar << PackageGuid;
+
+		UE_LOG( LogNetPackageMap, VeryVerbose, TEXT( "InternalWriteObject: Package: %s, GUID: %s" ), *ObjectPathName, *PackageGuid.ToString() );
+	}
+}
+
 //--------------------------------------------------------------------
 //
 //	Loading
@@ -1043,6 +1076,138 @@ void UPackageMapClient::HandleUnAssignedObject(const UObject* Obj)
 	}
 }
 
+/** Finds the level of World whose package has the given name */
+static ULevel* FindLevelByPackageName( UWorld* World, const FString& PackageName )
+{
+	if ( World == NULL )
+	{
+		return NULL;
+	}
+
+	const TArray< ULevel* >& Levels = World->GetLevels();
+
+	for ( int32 i = 0; i < Levels.Num(); i++ )
+	{
+		if ( Levels[i] != NULL && Levels[i]->GetOutermost()->GetName() == PackageName )
+		{
+			return Levels[i];
+		}
+	}
+
+	return NULL;
+}
+
+void UPackageMapClient::SendLevelNetGUIDs( ULevel* Level )
+{
+	check( Level != NULL );
+	check( IsNetGUIDAuthority() );
+
+	if ( CVarLevelNetGUIDs.GetValueOnGameThread() == 0 )
+	{
+		return;
+	}
+
+	const FNetLevelGUIDs* LevelGUIDs = GuidCache->GetOrAssignLevelNetGUIDs( Level );
+
+	if ( LevelGUIDs == NULL )
+	{
+		return;
+	}
+
+	FString			PackageName		= Level->GetOutermost()->GetName();
+	uint32			Checksum		= LevelGUIDs->Checksum;
+	FNetworkGUID	FirstNetGUID	= LevelGUIDs->FirstNetGUID;
+	int32			NumNetGUIDs		= LevelGUIDs->NumNetGUIDs;
+
+	GEngine->NetworkRemapPath( Connection->Driver->GetWorld(), PackageName, false );
+
+	UE_LOG( LogNetPackageMap, Log, TEXT( "SendLevelNetGUIDs: Level: %s, Checksum: %u, FirstNetGUID: %s, NumNetGUIDs: %i" ), *PackageName, Checksum, *FirstNetGUID.ToString(), NumNetGUIDs );
+
+	FNetControlMessage<NMT_LevelNetGUIDs>::Send( Connection, PackageName, Checksum, FirstNetGUID, NumNetGUIDs );
+}
+
+void UPackageMapClient::ReceiveLevelNetGUIDs( const FString& PackageName, const uint32 Checksum, const FNetworkGUID& FirstNetGUID, const int32 NumNetGUIDs )
+{
+	check( !IsNetGUIDAuthority() );
+
+	if ( CVarLevelNetGUIDs.GetValueOnGameThread() == 0 )
+	{
+		// Not acking is enough, the server will keep exporting paths
+		return;
+	}
+
+	if ( !FirstNetGUID.IsStatic() || NumNetGUIDs <= 0 )
+	{
+		UE_LOG( LogNetPackageMap, Warning, TEXT( "ReceiveLevelNetGUIDs: Invalid range. Level: %s, FirstNetGUID: %s, NumNetGUIDs: %i" ), *PackageName, *FirstNetGUID.ToString(), NumNetGUIDs );
+		return;
+	}
+
+	FString LocalPackageName = PackageName;
+
+	GEngine->NetworkRemapPath( Connection->Driver->GetWorld(), LocalPackageName, true );
+
+	ULevel* Level = FindLevelByPackageName( Connection->Driver->GetWorld(), LocalPackageName );
+
+	if ( Level == NULL )
+	{
+		UE_LOG( LogNetPackageMap, Log, TEXT( "ReceiveLevelNetGUIDs: Level %s isn't loaded" ), *LocalPackageName );
+		return;
+	}
+
+	if ( !GuidCache->RegisterLevelNetGUIDs_Client( Level, Checksum, FirstNetGUID, NumNetGUIDs ) )
+	{
+		return;
+	}
+
+	FString			AckPackageName	= PackageName;
+	uint32			AckChecksum		= Checksum;
+	FNetworkGUID	AckFirstNetGUID	= FirstNetGUID;
+
+	FNetControlMessage<NMT_LevelNetGUIDsAck>::Send( Connection, AckPackageName, AckChecksum, AckFirstNetGUID );
+}
+
+void UPackageMapClient::ReceivedLevelNetGUIDsAck( const FString& PackageName, const uint32 Checksum, const FNetworkGUID& FirstNetGUID )
+{
+	check( IsNetGUIDAuthority() );
+
+	FString LocalPackageName = PackageName;
+
+	GEngine->NetworkRemapPath( Connection->Driver->GetWorld(), LocalPackageName, true );
+
+	// Don't add names on behalf of the client, a level we know about already has its name
+	const FNetLevelGUIDs* LevelGUIDs = GuidCache->LevelNetGUIDs.Find( FName( *LocalPackageName, FNAME_Find ) );
+
+	// The level could have been reloaded (and given new NetGUIDs) while the message was in flight
+	if ( LevelGUIDs == NULL || !LevelGUIDs->Level.IsValid() || LevelGUIDs->NumNetGUIDs == 0 || LevelGUIDs->Checksum != Checksum || LevelGUIDs->FirstNetGUID != FirstNetGUID )
+	{
+		UE_LOG( LogNetPackageMap, Log, TEXT( "ReceivedLevelNetGUIDsAck: Stale ack ignored. Level: %s, Checksum: %u, FirstNetGUID: %s" ), *LocalPackageName, Checksum, *FirstNetGUID.ToString() );
+		return;
+	}
+
+	for ( int32 i = 0; i < LevelGUIDs->NumNetGUIDs; i++ )
+	{
+		const FNetworkGUID NetGUID( LevelGUIDs->FirstNetGUID.Value + i * 2 );
+
+		int32* AckPacketId = NetGUIDAckStatus.Find( NetGUID );
+
+		if ( AckPacketId == NULL )
+		{
+			NetGUIDAckStatus.Add( NetGUID, GUID_PACKET_ACKED );
+		}
+		else if ( *AckPacketId != GUID_PACKET_ACKED )
+		{
+			if ( *AckPacketId > GUID_PACKET_ACKED )
+			{
+				PendingAckGUIDs.Remove( NetGUID );
+			}
+
+			*AckPacketId = GUID_PACKET_ACKED;
+		}
+	}
+
+	UE_LOG( LogNetPackageMap, Log, TEXT( "ReceivedLevelNetGUIDsAck: Level: %s, NumNetGUIDs: %i" ), *LocalPackageName, LevelGUIDs->NumNetGUIDs );
+}
+
 //--------------------------------------------------------------------
 //
 //	Misc
@@ -1265,6 +1430,7 @@ void FNetGUIDCache::CleanReferences()
 
 			if ( FPlatformTime::Seconds() - It.Value().ReadOnlyTimestamp > NETWORK_GUID_TIMEOUT )
 			{
+				CachedExports.Remove( It.Key() );
 				It.RemoveCurrent();
 			}
 
@@ -1278,6 +1444,9 @@ void FNetGUIDCache::CleanReferences()
 		}
 	}
 
+	// Static guids are read only now, their objects will get new guids
+	LevelNetGUIDs.Empty();
+
 	for ( auto It = NetGUIDLookup.CreateIterator(); It; ++It )
 	{
 		if ( !It.Key().IsValid() || !ObjectLookup.Contains( It.Value() ) )
@@ -1594,6 +1763,192 @@ void FNetGUIDCache::RegisterNetGUIDFromPath_Client( const FNetworkGUID& NetGUID,
 	RegisterNetGUID_Internal( NetGUID, CacheObject );
 }
 
+/**
+ *	Collects the objects of a level that can be mapped with FNetLevelGUIDs: the level and its outers, and the level's replicated
+ *	startup actors with their replicated components. Sorted by path relative to the package, so that the server and a client with
+ *	the same content end up with the same list. Returns a checksum of the list.
+ */
+uint32 FNetGUIDCache::GatherLevelNetObjects( ULevel* Level, TArray< UObject* >& OutObjects )
+{
+	check( Level != NULL );
+
+	struct FLevelNetObject
+	{
+		FString		Path;
+		UObject*	Object;
+
+		bool operator<( const FLevelNetObject& Other ) const
+		{
+			return Path < Other.Path;
+		}
+	};
+
+	UPackage* LevelPackage = Level->GetOutermost();
+
+	TArray< FLevelNetObject > LevelNetObjects;
+
+	for ( UObject* Outer = Level; Outer != NULL; Outer = Outer->GetOuter() )
+	{
+		FLevelNetObject LevelNetObject = { Outer->GetPathName( LevelPackage ), Outer };
+		LevelNetObjects.Add( LevelNetObject );
+	}
+
+	for ( int32 ActorIndex = 0; ActorIndex < Level->Actors.Num(); ActorIndex++ )
+	{
+		AActor* Actor = Level->Actors[ActorIndex];
+
+		// Remote role is set for replicated actors on both sides (the client just swaps it with the local role)
+		if ( Actor == NULL || Actor->IsPendingKill() || !Actor->IsNetStartupActor() || Actor->GetRemoteRole() == ROLE_None || !Actor->IsFullNameStableForNetworking() )
+		{
+			continue;
+		}
+
+		FLevelNetObject LevelNetObject = { Actor->GetPathName( LevelPackage ), Actor };
+		LevelNetObjects.Add( LevelNetObject );
+
+		const TArray< UActorComponent* >& ReplicatedComponents = Actor->GetReplicatedComponents();
+
+		for ( int32 ComponentIndex = 0; ComponentIndex < ReplicatedComponents.Num(); ComponentIndex++ )
+		{
+			UActorComponent* Component = ReplicatedComponents[ComponentIndex];
+
+			if ( Component != NULL && !Component->IsPendingKill() && Component->IsFullNameStableForNetworking() )
+			{
+				FLevelNetObject ComponentNetObject = { Component->GetPathName( LevelPackage ), Component };
+				LevelNetObjects.Add( ComponentNetObject );
+			}
+		}
+	}
+
+	LevelNetObjects.Sort();
+
+	uint32 Checksum = 0;
+
+	OutObjects.Empty( LevelNetObjects.Num() );
+
+	for ( int32 i = 0; i < LevelNetObjects.Num(); i++ )
+	{
+		Checksum = FCrc::StrCrc32( *LevelNetObjects[i].Path, Checksum );
+		Checksum = FCrc::StrCrc32( *LevelNetObjects[i].Object->GetClass()->GetName(), Checksum );
+
+		OutObjects.Add( LevelNetObjects[i].Object );
+	}
+
+	return Checksum;
+}
+
+/**
+ *	Assigns consecutive static NetGUIDs to the level's net objects, the first time it's called for a level.
+ *	Returns NULL if some of them already had other NetGUIDs.
+ */
+const FNetLevelGUIDs* FNetGUIDCache::GetOrAssignLevelNetGUIDs( ULevel* Level )
+{
+	check( IsNetGUIDAuthority() );
+
+	const FName PackageName = Level->GetOutermost()->GetFName();
+
+	FNetLevelGUIDs* LevelGUIDs = LevelNetGUIDs.Find( PackageName );
+
+	if ( LevelGUIDs == NULL || LevelGUIDs->Level.Get() != Level )
+	{
+		LevelGUIDs = &LevelNetGUIDs.Add( PackageName, FNetLevelGUIDs() );
+		LevelGUIDs->Level = Level;
+
+		TArray< UObject* > Objects;
+		LevelGUIDs->Checksum = GatherLevelNetObjects( Level, Objects );
+
+		int32 NumNetGUIDs = 0;
+
+		for ( ; NumNetGUIDs < Objects.Num(); NumNetGUIDs++ )
+		{
+			const FNetworkGUID NetGUID = GetOrAssignNetGUID( Objects[NumNetGUIDs] );
+
+			if ( NumNetGUIDs == 0 )
+			{
+				LevelGUIDs->FirstNetGUID = NetGUID;
+			}
+
+			if ( !NetGUID.IsStatic() || NetGUID.Value != LevelGUIDs->FirstNetGUID.Value + NumNetGUIDs * 2 )
+			{
+				// Objects that were referenced earlier keep their NetGUID, which breaks up the range
+				UE_LOG( LogNetPackageMap, Log, TEXT( "GetOrAssignLevelNetGUIDs: %s already had NetGUID %s, clients will get path exports for %s" ), *Objects[NumNetGUIDs]->GetPathName(), *NetGUID.ToString(), *PackageName.ToString() );
+				NumNetGUIDs = 0;
+				break;
+			}
+		}
+
+		LevelGUIDs->NumNetGUIDs = NumNetGUIDs;
+	}
+
+	return LevelGUIDs->NumNetGUIDs > 0 ? LevelGUIDs : NULL;
+}
+
+/**
+ *	Maps the level's net objects to the server's NetGUID range, if our copy of the level has the same objects.
+ *  This function is only called on the client
+ */
+bool FNetGUIDCache::RegisterLevelNetGUIDs_Client( ULevel* Level, const uint32 Checksum, const FNetworkGUID& FirstNetGUID, const int32 NumNetGUIDs )
+{
+	check( !IsNetGUIDAuthority() );
+	check( FirstNetGUID.IsStatic() );
+
+	TArray< UObject* > Objects;
+
+	const uint32 LocalChecksum = GatherLevelNetObjects( Level, Objects );
+
+	if ( LocalChecksum != Checksum || Objects.Num() != NumNetGUIDs )
+	{
+		UE_LOG( LogNetPackageMap, Log, TEXT( "RegisterLevelNetGUIDs_Client: Level %s doesn't match the server's. Checksum: %u, Expected: %u, NumObjects: %i, Expected: %i" ), *Level->GetOutermost()->GetName(), LocalChecksum, Checksum, Objects.Num(), NumNetGUIDs );
+		return false;
+	}
+
+	// Refuse the whole range if anything was already mapped differently
+	for ( int32 i = 0; i < Objects.Num(); i++ )
+	{
+		const FNetworkGUID NetGUID( FirstNetGUID.Value + i * 2 );
+
+		const FNetGuidCacheObject* ExistingCacheObject = ObjectLookup.Find( NetGUID );
+		const FNetworkGUID* ExistingNetGUID = NetGUIDLookup.Find( Objects[i] );
+
+		if ( ( ExistingCacheObject != NULL && ExistingCacheObject->Object.Get() != Objects[i] ) || ( ExistingNetGUID != NULL && *ExistingNetGUID != NetGUID ) )
+		{
+			UE_LOG( LogNetPackageMap, Warning, TEXT( "RegisterLevelNetGUIDs_Client: NetGUID mismatch. Object: %s, NetGUID: %s" ), *Objects[i]->GetPathName(), *NetGUID.ToString() );
+			return false;
+		}
+	}
+
+	for ( int32 i = 0; i < Objects.Num(); i++ )
+	{
+		const FNetworkGUID NetGUID( FirstNetGUID.Value + i * 2 );
+
+		if ( !ObjectLookup.Contains( NetGUID ) )
+		{
+			FNetGuidCacheObject CacheObject;
+
+			CacheObject.Object		= Objects[i];
+			CacheObject.PathName	= Objects[i]->GetFName();
+			CacheObject.bNoLoad		= true;			// Part of a level we already have loaded
+
+			RegisterNetGUID_Internal( NetGUID, CacheObject );
+		}
+	}
+
+	// Outers are in the list too, but not necessarily before the objects they contain
+	for ( int32 i = 0; i < Objects.Num(); i++ )
+	{
+		FNetGuidCacheObject& CacheObject = ObjectLookup.FindChecked( FNetworkGUID( FirstNetGUID.Value + i * 2 ) );
+
+		UPackage* Package = Cast< UPackage >( Objects[i] );
+
+		CacheObject.OuterGUID	= NetGUIDLookup.FindRef( Objects[i]->GetOuter() );
+		CacheObject.PackageGuid	= Package != NULL ? Package->GetGuid() : FGuid();
+	}
+
+	UE_LOG( LogNetPackageMap, Log, TEXT( "RegisterLevelNetGUIDs_Client: Level: %s, FirstNetGUID: %s, NumNetGUIDs: %i" ), *Level->GetOutermost()->GetName(), *FirstNetGUID.ToString(), NumNetGUIDs );
+
+	return true;
+}
+
 void FNetGUIDCache::AsyncPackageCallback( const FName& PackageName, UPackage * Package )
 {
 	check( Package == NULL || Package->IsFullyLoaded() );
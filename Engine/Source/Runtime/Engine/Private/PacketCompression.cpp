@@ -0,0 +1,422 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	PacketCompression.cpp: Optional entropy coding of net packets.
+=============================================================================*/
+
+#include "EnginePrivate.h"
+#include "Net/PacketCompression.h"
+
+DEFINE_LOG_CATEGORY_STATIC( LogNetCompression, Log, All );
+
+static TAutoConsoleVariable<int32> CVarNetPacketCapture( TEXT( "net.PacketCapture" ), 0, TEXT( "When set, raw outgoing packets are written to Saved/NetCapture, to train packet compression dictionaries from" ) );
+
+#define NET_PACKET_DICTIONARY_MAGIC		( 0x4E504448 )
+#define NET_PACKET_DICTIONARY_VERSION	( 1 )
+
+/*-----------------------------------------------------------------------------
+	FNetPacketCompressor.
+-----------------------------------------------------------------------------*/
+
+FNetPacketCompressor::FNetPacketCompressor()
+	: bIsValid( false )
+	, DictionaryChecksum( 0 )
+{
+	FMemory::Memzero( CodeLengths, sizeof( CodeLengths ) );
+	FMemory::Memzero( Codes, sizeof( Codes ) );
+}
+
+bool FNetPacketCompressor::InitFromCodeLengths( const uint8* InCodeLengths )
+{
+	bIsValid = false;
+
+	// Make sure the lengths describe a complete prefix code, otherwise decoding could hit holes in the table
+	uint32 LengthCount[MAX_CODE_LENGTH + 1] = { 0 };
+	uint32 KraftSum = 0;
+
+	for ( int32 Symbol = 0; Symbol < 256; Symbol++ )
+	{
+		const uint8 Length = InCodeLengths[Symbol];
+
+		if ( Length == 0 || Length > MAX_CODE_LENGTH )
+		{
+			UE_LOG( LogNetCompression, Warning, TEXT( "FNetPacketCompressor::InitFromCodeLengths: Invalid code length %i for symbol %i" ), (int32)Length, Symbol );
+			return false;
+		}
+
+		LengthCount[Length]++;
+		KraftSum += 1 << ( MAX_CODE_LENGTH - Length );
+	}
+
+	if ( KraftSum != ( 1 << MAX_CODE_LENGTH ) )
+	{
+		UE_LOG( LogNetCompression, Warning, TEXT( "FNetPacketCompressor::InitFromCodeLengths: Code lengths don't form a complete code" ) );
+		return false;
+	}
+
+	FMemory::Memcpy( CodeLengths, InCodeLengths, sizeof( CodeLengths ) );
+
+	// Assign canonical codes, shortest codes first, ties broken by symbol value
+	uint32 NextCode[MAX_CODE_LENGTH + 1] = { 0 };
+	uint32 Code = 0;
+
+	for ( int32 Length = 1; Length <= MAX_CODE_LENGTH; Length++ )
+	{
+		Code = ( Code + LengthCount[Length - 1] ) << 1;
+		NextCode[Length] = Code;
+	}
+
+	for ( int32 Symbol = 0; Symbol < 256; Symbol++ )
+	{
+		const int32 Length = CodeLengths[Symbol];
+		const uint32 SymbolCode = NextCode[Length]++;
+
+		// Reverse so the first bit of the code ends up in the lowest bit of the stream
+		uint32 Reversed = 0;
+		for ( int32 Bit = 0; Bit < Length; Bit++ )
+		{
+			Reversed |= ( ( SymbolCode >> Bit ) & 1 ) << ( Length - 1 - Bit );
+		}
+
+		Codes[Symbol] = (uint16)Reversed;
+	}
+
+	// Every MAX_CODE_LENGTH bit pattern that starts with a symbol's code decodes to that symbol
+	DecodeTable.Empty( 1 << MAX_CODE_LENGTH );
+	DecodeTable.AddZeroed( 1 << MAX_CODE_LENGTH );
+
+	for ( int32 Symbol = 0; Symbol < 256; Symbol++ )
+	{
+		const int32 Length = CodeLengths[Symbol];
+		const uint16 Entry = (uint16)( Symbol | ( Length << 8 ) );
+
+		for ( int32 Index = Codes[Symbol]; Index < ( 1 << MAX_CODE_LENGTH ); Index += ( 1 << Length ) )
+		{
+			DecodeTable[Index] = Entry;
+		}
+	}
+
+	DictionaryChecksum	= FCrc::MemCrc32( CodeLengths, sizeof( CodeLengths ), 0 );
+	bIsValid			= true;
+
+	return true;
+}
+
+bool FNetPacketCompressor::LoadDictionary( const FString& Filename )
+{
+	TArray< uint8 > FileData;
+
+	if ( !FFileHelper::LoadFileToArray( FileData, *Filename, FILEREAD_Silent ) )
+	{
+		UE_LOG( LogNetCompression, Warning, TEXT( "FNetPacketCompressor::LoadDictionary: Failed to read %s" ), *Filename );
+		return false;
+	}
+
+	FMemoryReader Ar( FileData );
+
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	uint8 FileCodeLengths[256];
+
+	Ar << Magic;
+	Ar << Version;
+	Ar.Serialize( FileCodeLengths, sizeof( FileCodeLengths ) );
+
+	if ( Ar.IsError() || Magic != NET_PACKET_DICTIONARY_MAGIC || Version != NET_PACKET_DICTIONARY_VERSION )
+	{
+		UE_LOG( LogNetCompression, Warning, TEXT( "FNetPacketCompressor::LoadDictionary: %s is not a valid dictionary" ), *Filename );
+		return false;
+	}
+
+	if ( !InitFromCodeLengths( FileCodeLengths ) )
+	{
+		return false;
+	}
+
+	UE_LOG( LogNetCompression, Log, TEXT( "Loaded packet compression dictionary %s (checksum 0x%08x)" ), *Filename, DictionaryChecksum );
+
+	return true;
+}
+
+bool FNetPacketCompressor::SaveDictionary( const FString& Filename, const uint8* CodeLengths )
+{
+	TArray< uint8 > FileData;
+	FMemoryWriter Ar( FileData );
+
+	uint32 Magic = NET_PACKET_DICTIONARY_MAGIC;
+	uint32 Version = NET_PACKET_DICTIONARY_VERSION;
+
+	Ar << Magic;
+	Ar << Version;
+	Ar.Serialize( const_cast< uint8* >( CodeLengths ), 256 );
+
+	return FFileHelper::SaveArrayToFile( FileData, *Filename );
+}
+
+void FNetPacketCompressor::BuildCodeLengths( const uint64* Frequencies, uint8* OutCodeLengths )
+{
+	// Every symbol gets a non zero weight so it can always be encoded
+	uint64 Weights[256];
+
+	for ( int32 Symbol = 0; Symbol < 256; Symbol++ )
+	{
+		Weights[Symbol] = Frequencies[Symbol] + 1;
+	}
+
+	while ( true )
+	{
+		// Leaves sorted by weight (and symbol, to keep the result deterministic)
+		TArray< int32 > Leaves;
+		Leaves.AddUninitialized( 256 );
+
+		for ( int32 Symbol = 0; Symbol < 256; Symbol++ )
+		{
+			Leaves[Symbol] = Symbol;
+		}
+
+		Leaves.Sort( [&Weights]( const int32 A, const int32 B )
+		{
+			return Weights[A] != Weights[B] ? Weights[A] < Weights[B] : A < B;
+		});
+
+		// Two queue Huffman construction. Nodes 0-255 are the leaves, internal nodes are appended in non decreasing weight order.
+		uint64 NodeWeights[511];
+		int32 NodeParents[511];
+
+		for ( int32 Symbol = 0; Symbol < 256; Symbol++ )
+		{
+			NodeWeights[Symbol] = Weights[Symbol];
+		}
+
+		int32 LeafIndex = 0;
+		int32 InternalIndex = 256;
+		int32 NumNodes = 256;
+
+		auto PopLightest = [&]() -> int32
+		{
+			if ( LeafIndex < 256 && ( InternalIndex >= NumNodes || NodeWeights[Leaves[LeafIndex]] <= NodeWeights[InternalIndex] ) )
+			{
+				return Leaves[LeafIndex++];
+			}
+
+			return InternalIndex++;
+		};
+
+		while ( NumNodes < 511 )
+		{
+			const int32 First = PopLightest();
+			const int32 Second = PopLightest();
+
+			NodeWeights[NumNodes] = NodeWeights[First] + NodeWeights[Second];
+			NodeParents[First] = NumNodes;
+			NodeParents[Second] = NumNodes;
+			NumNodes++;
+		}
+
+		NodeParents[510] = INDEX_NONE;
+
+		int32 MaxLength = 0;
+
+		for ( int32 Symbol = 0; Symbol < 256; Symbol++ )
+		{
+			int32 Length = 0;
+
+			for ( int32 Node = Symbol; NodeParents[Node] != INDEX_NONE; Node = NodeParents[Node] )
+			{
+				Length++;
+			}
+
+			OutCodeLengths[Symbol] = (uint8)FMath::Min( Length, 255 );
+			MaxLength = FMath::Max( MaxLength, Length );
+		}
+
+		if ( MaxLength <= MAX_CODE_LENGTH )
+		{
+			break;
+		}
+
+		// Codes are too long, flatten the distribution and try again
+		for ( int32 Symbol = 0; Symbol < 256; Symbol++ )
+		{
+			Weights[Symbol] = ( Weights[Symbol] >> 1 ) + 1;
+		}
+	}
+}
+
+bool FNetPacketCompressor::Compress( const uint8* Data, int32 Count, TArray< uint8 >& Out ) const
+{
+	check( bIsValid );
+
+	if ( Count <= 0 || Count > MAX_UNCOMPRESSED_SIZE )
+	{
+		return false;
+	}
+
+	Out.Reset();
+	Out.Reserve( Count );
+
+	// Uncompressed size
+	Out.Add( (uint8)( Count & 0xFF ) );
+	Out.Add( (uint8)( Count >> 8 ) );
+
+	uint64 BitBuffer = 0;
+	int32 NumBits = 0;
+
+	for ( int32 i = 0; i < Count; i++ )
+	{
+		const uint8 Symbol = Data[i];
+
+		BitBuffer |= (uint64)Codes[Symbol] << NumBits;
+		NumBits += CodeLengths[Symbol];
+
+		while ( NumBits >= 8 )
+		{
+			Out.Add( (uint8)BitBuffer );
+			BitBuffer >>= 8;
+			NumBits -= 8;
+		}
+
+		// Not worth it, the marker byte alone would make this as big as the original
+		if ( Out.Num() + 1 >= Count )
+		{
+			return false;
+		}
+	}
+
+	if ( NumBits > 0 )
+	{
+		Out.Add( (uint8)BitBuffer );
+	}
+
+	// Marker
+	Out.Add( 0 );
+
+	return Out.Num() < Count;
+}
+
+bool FNetPacketCompressor::Decompress( const uint8* Data, int32 Count, TArray< uint8 >& Out ) const
+{
+	if ( !bIsValid || Count < 3 || !IsCompressedPacket( Data, Count ) )
+	{
+		return false;
+	}
+
+	const int32 UncompressedSize = Data[0] | ( Data[1] << 8 );
+
+	if ( UncompressedSize == 0 || UncompressedSize > MAX_UNCOMPRESSED_SIZE )
+	{
+		return false;
+	}
+
+	const uint8* Bits = Data + 2;
+	const int32 NumBytes = Count - 3;
+	const int64 NumAvailableBits = (int64)NumBytes * 8;
+	const uint16* Table = DecodeTable.GetData();
+
+	Out.SetNumUninitialized( UncompressedSize );
+
+	uint64 BitBuffer = 0;
+	int32 NumBits = 0;
+	int32 ReadPos = 0;
+	int64 NumConsumedBits = 0;
+
+	for ( int32 i = 0; i < UncompressedSize; i++ )
+	{
+		while ( NumBits <= 56 && ReadPos < NumBytes )
+		{
+			BitBuffer |= (uint64)Bits[ReadPos++] << NumBits;
+			NumBits += 8;
+		}
+
+		const uint16 Entry = Table[BitBuffer & ( ( 1 << MAX_CODE_LENGTH ) - 1 )];
+		const int32 Length = Entry >> 8;
+
+		NumConsumedBits += Length;
+
+		if ( Length == 0 || NumConsumedBits > NumAvailableBits )
+		{
+			return false;
+		}
+
+		Out[i] = (uint8)( Entry & 0xFF );
+
+		BitBuffer >>= Length;
+		NumBits -= Length;
+	}
+
+	return true;
+}
+
+/*-----------------------------------------------------------------------------
+	FNetPacketCapture.
+-----------------------------------------------------------------------------*/
+
+static FArchive* GNetPacketCaptureAr = NULL;
+
+void FNetPacketCapture::CapturePacket( const uint8* Data, int32 Count )
+{
+	if ( CVarNetPacketCapture.GetValueOnGameThread() == 0 )
+	{
+		if ( GNetPacketCaptureAr != NULL )
+		{
+			StopCapture();
+		}
+		return;
+	}
+
+	if ( GNetPacketCaptureAr == NULL )
+	{
+		const FString CaptureDir = FPaths::GameSavedDir() / TEXT( "NetCapture" );
+		IFileManager::Get().MakeDirectory( *CaptureDir, true );
+
+		const FString Filename = CaptureDir / FString::Printf( TEXT( "Capture-%s.bin" ), *FDateTime::Now().ToString() );
+
+		GNetPacketCaptureAr = IFileManager::Get().CreateFileWriter( *Filename );
+
+		if ( GNetPacketCaptureAr == NULL )
+		{
+			UE_LOG( LogNetCompression, Warning, TEXT( "FNetPacketCapture: Failed to open %s, disabling capture" ), *Filename );
+			CVarNetPacketCapture.AsVariable()->Set( 0 );
+			return;
+		}
+
+		UE_LOG( LogNetCompression, Log, TEXT( "FNetPacketCapture: Capturing packets to %s" ), *Filename );
+	}
+
+	*GNetPacketCaptureAr << Count;
+	GNetPacketCaptureAr->Serialize( const_cast< uint8* >( Data ), Count );
+}
+
+void FNetPacketCapture::StopCapture()
+{
+	delete GNetPacketCaptureAr;
+	GNetPacketCaptureAr = NULL;
+}
+
+bool FNetPacketCapture::ReadCaptureFile( const FString& Filename, TArray< TArray< uint8 > >& OutPackets )
+{
+	TScopedPointer< FArchive > Ar( IFileManager::Get().CreateFileReader( *Filename ) );
+
+	if ( !Ar.IsValid() )
+	{
+		return false;
+	}
+
+	while ( !Ar->AtEnd() )
+	{
+		int32 Count = 0;
+		*Ar << Count;
+
+		if ( Ar->IsError() || Count <= 0 || Count > FNetPacketCompressor::MAX_UNCOMPRESSED_SIZE )
+		{
+			UE_LOG( LogNetCompression, Warning, TEXT( "FNetPacketCapture::ReadCaptureFile: %s is corrupt" ), *Filename );
+			return false;
+		}
+
+		TArray< uint8 >& Packet = *new( OutPackets ) TArray< uint8 >();
+		Packet.AddUninitialized( Count );
+		Ar->Serialize( Packet.GetData(), Count );
+	}
+
+	return !Ar->IsError();
+}
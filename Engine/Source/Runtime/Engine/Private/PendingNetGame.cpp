@@ -44,7 +44,9 @@ void UPendingNetGame::InitNetDriver()
 			
 			uint32 LocalNetworkVersion = FNetworkVersion::GetLocalNetworkVersion();
 
-			FNetControlMessage<NMT_Hello>::Send( NetDriver->ServerConnection, IsLittleEndian, LocalNetworkVersion );
+			uint32 PacketCompressionChecksum = NetDriver->GetPacketCompressionChecksum();
+
+			FNetControlMessage<NMT_Hello>::Send( NetDriver->ServerConnection, IsLittleEndian, LocalNetworkVersion, PacketCompressionChecksum );
 
 			NetDriver->ServerConnection->FlushNet();
 		}
@@ -199,8 +201,11 @@ void UPendingNetGame::NotifyControlMessage(UNetConnection* Connection, uint8 Mes
 			// Server accepted connection.
 			FString GameName;
 			FString RedirectURL;
+			uint32 ServerPacketCompressionChecksum = 0;
+
+			FNetControlMessage<NMT_Welcome>::Receive(Bunch, URL.Map, GameName, RedirectURL, ServerPacketCompressionChecksum);
 
-			FNetControlMessage<NMT_Welcome>::Receive(Bunch, URL.Map, GameName, RedirectURL);
+			Connection->NegotiatePacketCompression(ServerPacketCompressionChecksum);
 
 			//GEngine->NetworkRemapPath(this, URL.Map);
 
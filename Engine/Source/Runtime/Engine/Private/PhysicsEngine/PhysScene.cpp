@@ -34,6 +34,13 @@ static TAutoConsoleVariable<float> CVarBounceThresholdVelocity(
 	TEXT("A contact with a relative velocity below this will not bounce. Default: 200"),
 	ECVF_Default);
 
+static TAutoConsoleVariable<int32> CVarFrameLagSyncScene(
+	TEXT("p.FrameLagSyncScene"),
+	0,
+	TEXT("If 1, the sync scene of game worlds is stepped at the end of TG_EndPhysics instead of in TG_StartPhysics, so it simulates while\n")
+	TEXT("post physics gameplay and the next frame's pre physics work run. Its results are applied one frame late, during the next frame's physics tick groups."),
+	ECVF_Default);
+
 FORCEINLINE EPhysicsSceneType SceneType(const FBodyInstance* BodyInstance)
 {
 #if WITH_PHYSX
@@ -61,18 +68,33 @@ FORCEINLINE static bool FrameLagAsync()
 	return true;
 }
 
+/**
+* Return true if we should lag the sync scene of the given world a frame
+**/
+FORCEINLINE static bool FrameLagSync(const UWorld* World)
+{
+	return CVarFrameLagSyncScene.GetValueOnGameThread() != 0 && World != NULL && World->IsGameWorld();
+}
+
 
 /** Exposes creation of physics-engine scene outside Engine (for use with PhAT for example). */
 FPhysScene::FPhysScene()
 {
 	LineBatcher = NULL;
 	OwningWorld = NULL;
+	bLaggedSyncStepInFlight = false;
 #if WITH_PHYSX
 #if WITH_VEHICLE
 	VehicleManager = NULL;
 #endif
 	PhysxUserData = FPhysxUserData(this);
 
+	for (uint32 SceneType = 0; SceneType < PST_MAX; ++SceneType)
+	{
+		FrontSimulatedBodyStates[SceneType] = 0;
+		bSimulatedBodyStatesFetched[SceneType] = false;
+	}
+
 	// Create dispatcher for tasks
 	if (PhysSingleThreadedMode())
 	{
@@ -325,6 +347,12 @@ void FPhysScene::RemoveActiveBody(FBodyInstance* BodyInstance, uint32 SceneType)
 	{
 		ActiveBodyInstances[SceneType][BodyIndex] = nullptr;
 	}
+
+	// A new body could be allocated at the same address. Worker threads may be reading the front snapshot, so it's removed when the buffers flip.
+	if (FrameLagSync(OwningWorld))
+	{
+		PendingSimulatedBodyStateRemovals[SceneType].Add(BodyInstance);
+	}
 }
 #endif
 void FPhysScene::TermBody(FBodyInstance* BodyInstance)
@@ -635,6 +663,13 @@ void FPhysScene::WaitPhysScenes()
 	{
 		FTaskGraphInterface::Get().WaitUntilTasksComplete(ThingsToComplete, ENamedThreads::GameThread);
 	}
+
+	// Nothing is going to fetch the results of a frame lagged step before StartFrame, do it now so the scene isn't left simulating
+	if (bLaggedSyncStepInFlight)
+	{
+		ProcessPhysScene(PST_Sync);
+		bLaggedSyncStepInFlight = false;
+	}
 }
 
 void FPhysScene::WaitClothScene()
@@ -729,6 +764,13 @@ void FPhysScene::UpdateActiveTransforms(uint32 SceneType)
 	ActiveBodyInstances[SceneType].Empty(NumTransforms);
 	ActiveDestructibleActors[SceneType].Empty(NumTransforms);
 
+	// Gameplay may read body states while the next step simulates, snapshot them into the back buffer
+	const bool bTakeSnapshot = FrameLagSync(OwningWorld);
+	FSimulatedBodyStates& BackBodyStates = SimulatedBodyStates[SceneType][1 - FrontSimulatedBodyStates[SceneType]];
+	BackBodyStates.States.Reset();
+	BackBodyStates.StateIndices.Empty(bTakeSnapshot ? NumTransforms : 0);
+	bSimulatedBodyStatesFetched[SceneType] = true;
+
 	for (PxU32 TransformIdx = 0; TransformIdx < NumTransforms; ++TransformIdx)
 	{
 		const PxActiveTransform& PActiveTransform = PActiveTransforms[TransformIdx];
@@ -740,6 +782,18 @@ void FPhysScene::UpdateActiveTransforms(uint32 SceneType)
 			if (BodyInstance->InstanceBodyIndex == INDEX_NONE && BodyInstance->OwnerComponent.IsValid() && BodyInstance->IsInstanceSimulatingPhysics())
 			{
 				ActiveBodyInstances[SceneType].Add(BodyInstance);
+
+				if (bTakeSnapshot)
+				{
+					FSimulatedBodyState& State = BackBodyStates.States[BackBodyStates.States.AddUninitialized()];
+					State.Transform = P2UTransform(PActiveTransform.actor2World);
+
+					const PxRigidBody* PRigidBody = RigidActor->isRigidBody();
+					State.LinearVelocity = PRigidBody ? P2UVector(PRigidBody->getLinearVelocity()) : FVector::ZeroVector;
+					State.AngularVelocity = PRigidBody ? P2UVector(PRigidBody->getAngularVelocity()) : FVector::ZeroVector;
+
+					BackBodyStates.StateIndices.Add(BodyInstance, BackBodyStates.States.Num() - 1);
+				}
 			}
 		}
 		else if (const FDestructibleChunkInfo* DestructibleChunkInfo = FPhysxUserData::Get<FDestructibleChunkInfo>(RigidActor->userData))
@@ -879,11 +933,15 @@ void FPhysScene::StartFrame()
 {
 	FGraphEventArray FinishPrerequisites;
 
-	//Update the collision disable table before ticking
-	FlushDeferredCollisionDisableTableQueue();
+	// Run the sync scene, unless it has been running since the end of the last frame, in which case we only fetch its results
+	if (!bLaggedSyncStepInFlight && !FrameLagSync(OwningWorld))
+	{
+		//Update the collision disable table before ticking
+		FlushDeferredCollisionDisableTableQueue();
 
-	// Run the sync scene
-	TickPhysScene(PST_Sync, PhysicsSubsceneCompletion[PST_Sync]);
+		TickPhysScene(PST_Sync, PhysicsSubsceneCompletion[PST_Sync]);
+	}
+	bLaggedSyncStepInFlight = false;
 	{
 		FGraphEventArray MainScenePrerequisites;
 		if (FrameLagAsync() && bAsyncSceneEnabled)
@@ -997,6 +1055,20 @@ void FPhysScene::EndFrame(ULineBatchComponent* InLineBatcher)
 {
 	PhysicsSceneCompletion = NULL;
 
+#if WITH_PHYSX
+	// Gameplay sees the snapshots of the results we're about to apply to components
+	for (uint32 SceneType = 0; SceneType < NumPhysScenes; ++SceneType)
+	{
+		ApplySimulatedBodyStateRemovals(SceneType);
+
+		if (bSimulatedBodyStatesFetched[SceneType])
+		{
+			FrontSimulatedBodyStates[SceneType] = 1 - FrontSimulatedBodyStates[SceneType];
+			bSimulatedBodyStatesFetched[SceneType] = false;
+		}
+	}
+#endif
+
 	if (bAsyncSceneEnabled)
 	{
 		SyncComponentsToBodies(PST_Async);
@@ -1007,6 +1079,16 @@ void FPhysScene::EndFrame(ULineBatchComponent* InLineBatcher)
 	// Perform any collision notification events
 	DispatchPhysNotifications();
 
+	if (FrameLagSync(OwningWorld) && !bPhysXSceneExecuting[PST_Sync])
+	{
+		// Start the next step now, it simulates while post physics gameplay runs and gets fetched by the next StartFrame.
+		// Changes made to bodies in the meantime are buffered by the physics scene and apply to the step after it.
+		FlushDeferredCollisionDisableTableQueue();
+
+		TickPhysScene(PST_Sync, PhysicsSubsceneCompletion[PST_Sync]);
+		bLaggedSyncStepInFlight = PhysicsSubsceneCompletion[PST_Sync].GetReference() != NULL;
+	}
+
 #if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
 	// Handle debug rendering
 	if (InLineBatcher)
@@ -1022,6 +1104,35 @@ void FPhysScene::EndFrame(ULineBatchComponent* InLineBatcher)
 #endif // !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
 }
 
+#if WITH_PHYSX
+void FPhysScene::ApplySimulatedBodyStateRemovals(uint32 SceneType)
+{
+	for (const FBodyInstance* BodyInstance : PendingSimulatedBodyStateRemovals[SceneType])
+	{
+		SimulatedBodyStates[SceneType][0].StateIndices.Remove(BodyInstance);
+		SimulatedBodyStates[SceneType][1].StateIndices.Remove(BodyInstance);
+	}
+	PendingSimulatedBodyStateRemovals[SceneType].Reset();
+}
+#endif
+
+bool FPhysScene::GetSimulatedBodyState(const FBodyInstance* BodyInstance, FSimulatedBodyState& OutState) const
+{
+#if WITH_PHYSX
+	for (uint32 SceneType = 0; SceneType < NumPhysScenes; ++SceneType)
+	{
+		const FSimulatedBodyStates& FrontBodyStates = SimulatedBodyStates[SceneType][FrontSimulatedBodyStates[SceneType]];
+		if (const int32* StateIndex = FrontBodyStates.StateIndices.Find(BodyInstance))
+		{
+			OutState = FrontBodyStates.States[*StateIndex];
+			return true;
+		}
+	}
+#endif
+
+	return false;
+}
+
 void FPhysScene::SetIsStaticLoading(bool bStaticLoading)
 {
 #if WITH_PHYSX
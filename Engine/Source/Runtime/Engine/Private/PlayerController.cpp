@@ -263,6 +263,24 @@ void APlayerController::ServerUpdateLevelVisibility_Implementation(FName Package
 			{
 				Connection->ClientVisibleLevelNames.AddUnique(PackageName);
 				UE_LOG( LogPlayerController, Verbose, TEXT("ServerUpdateLevelVisibility() Added '%s'"), *PackageName.ToString() );
+
+				// Let the client map the streamed in level's startup objects up front
+				ULevel* VisibleLevel = NULL;
+				const TArray<ULevel*>& Levels = GetWorld()->GetLevels();
+				for (int32 i = 0; i < Levels.Num(); i++)
+				{
+					if (Levels[i] != NULL && Levels[i]->GetOutermost()->GetFName() == PackageName)
+					{
+						VisibleLevel = Levels[i];
+						break;
+					}
+				}
+
+				UPackageMapClient* PackageMapClient = Cast<UPackageMapClient>(Connection->PackageMap);
+				if (VisibleLevel != NULL && PackageMapClient != NULL)
+				{
+					PackageMapClient->SendLevelNetGUIDs(VisibleLevel);
+				}
 			}
 			else
 			{
@@ -27,6 +27,7 @@
 #include "CollisionDebugDrawingPublic.h"
 #include "GameFramework/CheatManager.h"
 #include "GameFramework/DamageType.h"
+#include "OverlapUpdateBatch.h"
 
 #define LOCTEXT_NAMESPACE "PrimitiveComponent"
 
@@ -217,6 +218,11 @@ FString FPrimitiveComponentPostPhysicsTickFunction::DiagnosticMessage()
 	return Target->GetFullName() + TEXT("[UPrimitiveComponent::PostPhysicsTick]");
 }
 
+AActor* FPrimitiveComponentPostPhysicsTickFunction::GetTickedActor() const
+{
+	return Target ? Target->GetOwner() : NULL;
+}
+
 void UPrimitiveComponent::RegisterComponentTickFunctions(bool bRegister)
 {
 	Super::RegisterComponentTickFunctions(bRegister);
@@ -1980,6 +1986,8 @@ void UPrimitiveComponent::BeginComponentOverlap(const FOverlapInfo& OtherOverlap
 
 			const bool bNotifyActorTouch = bDoNotifies && !IsOverlappingActor(OtherActor);
 
+			FParallelTickValidation::CheckWrite(OtherComp, TEXT("BeginComponentOverlap"));
+
 			// Perform reflexive touch.
 			OverlappingComponents.Add(OtherOverlap);										// already verified uniqueness above
 			OtherComp->OverlappingComponents.AddUnique(FOverlapInfo(this, INDEX_NONE));		// uniqueness unverified, so addunique
@@ -2037,6 +2045,8 @@ void UPrimitiveComponent::EndComponentOverlap(const FOverlapInfo& OtherOverlap,
 	AActor* const OtherActor = OtherComp ? OtherComp->GetOwner() : NULL;
 	AActor* const MyActor = GetOwner();
 
+	FParallelTickValidation::CheckWrite(OtherComp, TEXT("EndComponentOverlap"));
+
 	//	UE_LOG(LogActor, Log, TEXT("END OVERLAP! Self=%s SelfComp=%s, Other=%s, OtherComp=%s"), *GetNameSafe(this), *GetNameSafe(MyComp), *GetNameSafe(OtherActor), *GetNameSafe(OtherComp));
 
 	if ( (OtherActor != NULL) && bDoNotifies && IsOverlappingComponent(OtherOverlap) )
@@ -2215,6 +2225,35 @@ void UPrimitiveComponent::UpdateOverlaps(TArray<FOverlapInfo> const* PendingOver
 		return;
 	}
 
+	// When the tick group batches overlap updates, our query runs with the others on worker threads at the end of the group
+	if (!FOverlapUpdateBatch::Defer(this, PendingOverlaps, bDoNotifies, OverlapsAtEndLocation))
+	{
+		UpdateOverlapsOfThisComponent(PendingOverlaps, bDoNotifies, OverlapsAtEndLocation, NULL);
+	}
+
+	// now update any children down the chain.
+	for (int32 ChildIdx=0; ChildIdx<AttachChildren.Num(); ++ChildIdx)
+	{
+		USceneComponent* const ChildComp = AttachChildren[ChildIdx];
+		if (ChildComp)
+		{
+			// Do not pass on OverlapsAtEndLocation, it only applied to this component.
+			ChildComp->UpdateOverlaps(NULL, bDoNotifies, NULL);
+		}
+	}
+}
+
+void UPrimitiveComponent::InitUpdateOverlapsQueryParams(FComponentQueryParams& Params) const
+{
+	static FName NAME_UpdateOverlaps = FName(TEXT("UpdateOverlaps"));
+	// note this will include overlaps with components in the same actor.  
+	Params = FComponentQueryParams(NAME_UpdateOverlaps);
+	Params.bTraceAsyncScene = bCheckAsyncSceneOnMove;
+	Params.AddIgnoredActors(MoveIgnoreActors);
+}
+
+void UPrimitiveComponent::UpdateOverlapsOfThisComponent(TArray<FOverlapInfo> const* PendingOverlaps, bool bDoNotifies, const TArray<FOverlapInfo>* OverlapsAtEndLocation, const TArray<FOverlapResult>* OverlapQueryResults)
+{
 	// first, dispatch any pending overlaps
 	if (bGenerateOverlapEvents && IsCollisionEnabled())
 	{
@@ -2247,15 +2286,17 @@ void UPrimitiveComponent::UpdateOverlaps(TArray<FOverlapInfo> const* PendingOver
 				}
 				else
 				{
-					UE_LOG(LogPrimitiveComponent, VeryVerbose, TEXT("%s Performing overlaps!"), *GetName());
 					UWorld* const MyWorld = MyActor->GetWorld();
-					TArray<FOverlapResult> Overlaps;
-					static FName NAME_UpdateOverlaps = FName(TEXT("UpdateOverlaps"));
-					// note this will include overlaps with components in the same actor.  
-					FComponentQueryParams Params(NAME_UpdateOverlaps);
-					Params.bTraceAsyncScene = bCheckAsyncSceneOnMove;
-					Params.AddIgnoredActors(MoveIgnoreActors);
-					MyWorld->ComponentOverlapMulti(Overlaps, this, GetComponentLocation(), GetComponentRotation(), Params);
+					TArray<FOverlapResult> QueriedOverlaps;
+					if (OverlapQueryResults == NULL)
+					{
+						UE_LOG(LogPrimitiveComponent, VeryVerbose, TEXT("%s Performing overlaps!"), *GetName());
+						FComponentQueryParams Params;
+						InitUpdateOverlapsQueryParams(Params);
+						MyWorld->ComponentOverlapMulti(QueriedOverlaps, this, GetComponentLocation(), GetComponentRotation(), Params);
+						OverlapQueryResults = &QueriedOverlaps;
+					}
+					const TArray<FOverlapResult>& Overlaps = *OverlapQueryResults;
 
 					for( int32 ResultIdx=0; ResultIdx<Overlaps.Num(); ResultIdx++ )
 					{
@@ -2337,17 +2378,6 @@ void UPrimitiveComponent::UpdateOverlaps(TArray<FOverlapInfo> const* PendingOver
 	{
 		UpdatePhysicsVolume(bDoNotifies);
 	}
-
-	// now update any children down the chain.
-	for (int32 ChildIdx=0; ChildIdx<AttachChildren.Num(); ++ChildIdx)
-	{
-		USceneComponent* const ChildComp = AttachChildren[ChildIdx];
-		if (ChildComp)
-		{
-			// Do not pass on OverlapsAtEndLocation, it only applied to this component.
-			ChildComp->UpdateOverlaps(NULL, bDoNotifies, NULL);
-		}
-	}
 }
 
 bool UPrimitiveComponent::ComponentOverlapMulti(TArray<struct FOverlapResult>& OutOverlaps, const UWorld* World, const FVector& Pos, const FRotator& Rot, ECollisionChannel TestChannel, const struct FComponentQueryParams& Params, const struct FCollisionObjectQueryParams& ObjectQueryParams) const
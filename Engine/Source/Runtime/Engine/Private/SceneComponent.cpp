@@ -10,6 +10,7 @@
 #include "Net/UnrealNetwork.h"
 #include "GameFramework/PhysicsVolume.h"
 #include "ComponentReregisterContext.h"
+#include "SceneComponentTransformStore.h"
 
 #define LOCTEXT_NAMESPACE "SceneComponent"
 
@@ -74,20 +75,42 @@ FTransform USceneComponent::CalcNewComponentToWorld(const FTransform& NewRelativ
 			NewCompToWorld.SetScale3D(NewRelativeTransform.GetScale3D());
 		}
 
+		AdjustNewComponentToWorld(NewCompToWorld);
 		return NewCompToWorld;
 	}
 	else
 	{
-		return NewRelativeTransform;
+		FTransform NewCompToWorld = NewRelativeTransform;
+		AdjustNewComponentToWorld(NewCompToWorld);
+		return NewCompToWorld;
 	}
 }
 
+/** Cleared by the base USceneComponent::AdjustNewComponentToWorld, to tell the classes that override it (same as UObject::ImplementsGetWorld) */
+static bool GAdjustNewComponentToWorldOverridden = false;
+
+void USceneComponent::AdjustNewComponentToWorld(FTransform& NewComponentToWorld) const
+{
+	GAdjustNewComponentToWorldOverridden = false;
+}
+
+bool USceneComponent::AdjustsComponentToWorld() const
+{
+	check(IsInGameThread());
+	GAdjustNewComponentToWorldOverridden = true;
+	FTransform ProbeTransform = ComponentToWorld;
+	AdjustNewComponentToWorld(ProbeTransform);
+	return GAdjustNewComponentToWorldOverridden;
+}
+
 void USceneComponent::OnUpdateTransform(bool bSkipPhysicsMove)
 {
 }
 
 void USceneComponent::UpdateComponentToWorldWithParent(USceneComponent * Parent, bool bSkipPhysicsMove)
 {
+	FParallelTickValidation::CheckWrite(this, TEXT("UpdateComponentToWorld"));
+
 	// If our parent hasn't been updated before, we'll need walk up our parent attach hierarchy
 	if (Parent && !Parent->bWorldToComponentUpdated)
 	{
@@ -101,6 +124,7 @@ void USceneComponent::UpdateComponentToWorldWithParent(USceneComponent * Parent,
 	}
 
 	bWorldToComponentUpdated = true;
+	FSceneComponentTransformStore::NotifyTransformUpdated(this);
 
 	// Calculate the new ComponentToWorld transform
 	const FTransform RelativeTransform(RelativeRotation, RelativeLocation, RelativeScale3D);
@@ -129,6 +153,9 @@ void USceneComponent::OnRegister()
 	
 	Super::OnRegister();
 
+	// Registered components can be batched with their parent
+	FSceneComponentTransformStore::NotifyAttachmentChanged(this);
+
 #if WITH_EDITORONLY_DATA
 	if (bVisualizeComponent && SpriteComponent == nullptr && GetOwner() && !GetWorld()->IsGameWorld() )
 	{
@@ -157,6 +184,14 @@ void USceneComponent::UpdateComponentToWorld(bool bSkipPhysicsMove)
 	UpdateComponentToWorldWithParent(AttachParent, bSkipPhysicsMove);
 }
 
+void USceneComponent::OnUnregister()
+{
+	// Unregistered components are not kept in the transform store
+	FSceneComponentTransformStore::NotifyAttachmentChanged(this);
+
+	Super::OnUnregister();
+}
+
 
 void USceneComponent::PropagateTransformUpdate(bool bTransformChanged, bool bSkipPhysicsMove)
 {
@@ -367,6 +402,7 @@ void USceneComponent::DestroyComponent(bool bPromoteChildren/*= false*/)
 
 					Index = FMath::Clamp<int32>(Index, 0, CachedAttachParent->AttachChildren.Num());
 					CachedAttachParent->AttachChildren.Insert(ChildToPromote, Index);
+					FSceneComponentTransformStore::NotifyAttachmentChanged(ChildToPromote);
 				}
 			}
 
@@ -978,6 +1014,7 @@ void USceneComponent::AttachTo(class USceneComponent* Parent, FName InSocketName
 		{
 			Parent->AttachChildren.Add(this);
 		}
+		FSceneComponentTransformStore::NotifyAttachmentChanged(this);
 
 		switch ( AttachType )
 		{
@@ -1097,6 +1134,7 @@ void USceneComponent::DetachFromParent(bool bMaintainWorldPosition)
 
 		PrimaryComponentTick.RemovePrerequisite(AttachParent, AttachParent->PrimaryComponentTick); // no longer required to tick after the attachment
 
+		FSceneComponentTransformStore::NotifyAttachmentChanged(this);
 		AttachParent->AttachChildren.Remove(this);
 		AttachParent->OnChildDetached(this);
 
@@ -1235,6 +1273,11 @@ FName USceneComponent::GetComponentInstanceDataType() const
 
 void USceneComponent::UpdateChildTransforms()
 {
+	if (AttachChildren.Num() > 0 && FSceneComponentTransformStore::UpdateChildTransforms(this))
+	{
+		return;
+	}
+
 	for(int32 i=0; i<AttachChildren.Num(); i++)
 	{
 		USceneComponent* ChildComp = AttachChildren[i];
@@ -1537,6 +1580,7 @@ void USceneComponent::SetPhysicsVolume( APhysicsVolume * NewVolume,  bool bTrigg
 void USceneComponent::BeginDestroy()
 {
 	PhysicsVolumeChangedDelegate.Clear();
+	FSceneComponentTransformStore::NotifyAttachmentChanged(this);
 
 	Super::BeginDestroy();
 }
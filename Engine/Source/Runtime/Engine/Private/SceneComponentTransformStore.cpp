@@ -0,0 +1,294 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	SceneComponentTransformStore.cpp: Flattened scene component attachment hierarchies.
+=============================================================================*/
+
+#include "EnginePrivate.h"
+#include "SceneComponentTransformStore.h"
+
+DECLARE_CYCLE_STAT(TEXT("Batched Child Transforms"), STAT_BatchedChildTransforms, STATGROUP_Game);
+DECLARE_CYCLE_STAT(TEXT("Build Transform Hierarchy"), STAT_BuildTransformHierarchy, STATGROUP_Game);
+
+static TAutoConsoleVariable<int32> CVarSceneComponentTransformStore(
+	TEXT("SceneComponent.TransformStore"),
+	0,
+	TEXT("Whether the children of a moved scene component are updated through the flattened hierarchies of the world's transform store.\n")
+	TEXT("0: recursive update (default), 1: batched update through the store"),
+	ECVF_Default);
+
+FSceneComponentTransformStore* FSceneComponentTransformStore::UpdatingStore = NULL;
+
+FSceneComponentTransformStore::FSceneComponentTransformStore()
+	: UpdatingHierarchy(INDEX_NONE)
+	, bUpdateInterrupted(false)
+{
+}
+
+FSceneComponentTransformStore::~FSceneComponentTransformStore()
+{
+	check(UpdatingStore != this);
+}
+
+bool FSceneComponentTransformStore::CanBatchWithParent(const USceneComponent* Child)
+{
+	const USceneComponent* Parent = Child->AttachParent;
+	return Parent && Child->IsRegistered() && Parent->IsRegistered() && Child->AttachSocketName == NAME_None && !Parent->HasAnySockets() && !Child->AdjustsComponentToWorld();
+}
+
+bool FSceneComponentTransformStore::UpdateChildTransforms(USceneComponent* Parent)
+{
+	if (UpdatingStore || !Parent->IsRegistered() || CVarSceneComponentTransformStore.GetValueOnGameThread() == 0 || !IsInGameThread())
+	{
+		return false;
+	}
+
+	UWorld* World = Parent->GetWorld();
+	FSceneComponentTransformStore* Store = World ? World->GetSceneComponentTransformStore() : NULL;
+	FEntryLocation Location;
+	if (Store == NULL || !Store->FindOrAddEntry(Parent, Location))
+	{
+		return false;
+	}
+
+	return Store->UpdateSubtree(Location.HierarchyIndex, Location.Index);
+}
+
+void FSceneComponentTransformStore::NotifyAttachmentChanged(USceneComponent* Component)
+{
+	UWorld* World = Component->GetWorld();
+	FSceneComponentTransformStore* Store = World ? World->GetSceneComponentTransformStore() : NULL;
+	if (Store == NULL || Store->Entries.Num() == 0)
+	{
+		return;
+	}
+
+	// The parent's hierarchy lists the component even when it is updated the regular way
+	USceneComponent* Components[] = { Component, Component->AttachParent };
+	for (int32 Idx = 0; Idx < ARRAY_COUNT(Components); ++Idx)
+	{
+		const FEntryLocation* Location = Components[Idx] ? Store->Entries.Find(Components[Idx]) : NULL;
+		if (Location)
+		{
+			Store->RemoveHierarchy(Location->HierarchyIndex);
+		}
+	}
+}
+
+bool FSceneComponentTransformStore::FindOrAddEntry(USceneComponent* Component, FEntryLocation& OutLocation)
+{
+	if (const FEntryLocation* Location = Entries.Find(Component))
+	{
+		OutLocation = *Location;
+		return true;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_BuildTransformHierarchy);
+
+	// The hierarchy starts at the first ancestor whose children can't be batched with it
+	USceneComponent* Root = Component;
+	while (CanBatchWithParent(Root))
+	{
+		Root = Root->AttachParent;
+	}
+
+	const int32 HierarchyIndex = Hierarchies.Add(FHierarchy());
+	Hierarchies[HierarchyIndex].bPendingRemove = false;
+	AddEntry(HierarchyIndex, Root, INDEX_NONE, false);
+
+	FHierarchy& Hierarchy = Hierarchies[HierarchyIndex];
+	Hierarchy.RelativeTransforms.SetNumUninitialized(Hierarchy.Components.Num());
+	Hierarchy.WorldTransforms.SetNumUninitialized(Hierarchy.Components.Num());
+
+	OutLocation = Entries.FindChecked(Component);
+	return true;
+}
+
+void FSceneComponentTransformStore::AddEntry(int32 HierarchyIndex, USceneComponent* Component, int32 ParentIndex, bool bRegularUpdate)
+{
+	FHierarchy& Hierarchy = Hierarchies[HierarchyIndex];
+	const int32 Index = Hierarchy.Components.Add(Component);
+	Hierarchy.ParentIndices.Add(ParentIndex);
+	Hierarchy.SubtreeEnds.Add(Index + 1);
+	Hierarchy.Flags.Add(bRegularUpdate ? EF_RegularUpdate : 0);
+
+	if (!bRegularUpdate)
+	{
+		FEntryLocation Location;
+		Location.HierarchyIndex = HierarchyIndex;
+		Location.Index = Index;
+		Entries.Add(Component, Location);
+
+		for (int32 ChildIdx = 0; ChildIdx < Component->AttachChildren.Num(); ++ChildIdx)
+		{
+			USceneComponent* Child = Component->AttachChildren[ChildIdx];
+			if (Child)
+			{
+				AddEntry(HierarchyIndex, Child, Index, !CanBatchWithParent(Child));
+			}
+		}
+
+		Hierarchies[HierarchyIndex].SubtreeEnds[Index] = Hierarchies[HierarchyIndex].Components.Num();
+	}
+}
+
+void FSceneComponentTransformStore::RemoveHierarchy(int32 HierarchyIndex)
+{
+	FHierarchy& Hierarchy = Hierarchies[HierarchyIndex];
+	if (HierarchyIndex == UpdatingHierarchy)
+	{
+		Hierarchy.bPendingRemove = true;
+		bUpdateInterrupted = true;
+		return;
+	}
+
+	for (int32 Index = 0; Index < Hierarchy.Components.Num(); ++Index)
+	{
+		if ((Hierarchy.Flags[Index] & EF_RegularUpdate) == 0)
+		{
+			Entries.Remove(Hierarchy.Components[Index]);
+		}
+	}
+	Hierarchies.RemoveAt(HierarchyIndex);
+}
+
+void FSceneComponentTransformStore::OnTransformUpdatedOutsideBatch(USceneComponent* Component)
+{
+	const FEntryLocation* Location = Entries.Find(Component);
+	if (Location && Location->HierarchyIndex == UpdatingHierarchy)
+	{
+		bUpdateInterrupted = true;
+	}
+}
+
+void FSceneComponentTransformStore::CloseEntry(USceneComponent* Component, bool bTransformChanged)
+{
+	// Same as the end of USceneComponent::PropagateTransformUpdate
+	if (bTransformChanged)
+	{
+		Component->UpdateNavigationData();
+	}
+	else
+	{
+		Component->MarkRenderTransformDirty();
+	}
+}
+
+bool FSceneComponentTransformStore::UpdateSubtree(int32 HierarchyIndex, int32 Index)
+{
+	SCOPE_CYCLE_COUNTER(STAT_BatchedChildTransforms);
+
+	FHierarchy& Hierarchy = Hierarchies[HierarchyIndex];
+	const int32 First = Index + 1;
+	const int32 End = Hierarchy.SubtreeEnds[Index];
+
+	// Gather the relative transforms
+	for (int32 EntryIdx = First; EntryIdx < End; ++EntryIdx)
+	{
+		uint8& Flags = Hierarchy.Flags[EntryIdx];
+		if ((Flags & EF_RegularUpdate) == 0)
+		{
+			const USceneComponent* Component = Hierarchy.Components[EntryIdx];
+			Hierarchy.RelativeTransforms[EntryIdx] = FTransform(Component->RelativeRotation, Component->RelativeLocation, Component->RelativeScale3D);
+			Flags = (Component->bAbsoluteLocation ? EF_AbsoluteLocation : 0) | (Component->bAbsoluteRotation ? EF_AbsoluteRotation : 0) | (Component->bAbsoluteScale ? EF_AbsoluteScale : 0);
+		}
+	}
+
+	// Compute the world transforms, parents come first so theirs are always ready (same as USceneComponent::CalcNewComponentToWorld)
+	Hierarchy.WorldTransforms[Index] = Hierarchy.Components[Index]->ComponentToWorld;
+	for (int32 EntryIdx = First; EntryIdx < End; ++EntryIdx)
+	{
+		const uint8 Flags = Hierarchy.Flags[EntryIdx];
+		if ((Flags & EF_RegularUpdate) == 0)
+		{
+			const FTransform& RelativeTransform = Hierarchy.RelativeTransforms[EntryIdx];
+			FTransform& WorldTransform = Hierarchy.WorldTransforms[EntryIdx];
+			WorldTransform = RelativeTransform * Hierarchy.WorldTransforms[Hierarchy.ParentIndices[EntryIdx]];
+
+			if (Flags & EF_AbsoluteLocation)
+			{
+				WorldTransform.SetTranslation(RelativeTransform.GetTranslation());
+			}
+			if (Flags & EF_AbsoluteRotation)
+			{
+				WorldTransform.SetRotation(RelativeTransform.GetRotation());
+			}
+			if (Flags & EF_AbsoluteScale)
+			{
+				WorldTransform.SetScale3D(RelativeTransform.GetScale3D());
+			}
+		}
+	}
+
+	// Write them back and run the transform updates in the order of the recursive walk, a component being closed once its subtree is done
+	UpdatingStore = this;
+	UpdatingHierarchy = HierarchyIndex;
+	bUpdateInterrupted = false;
+
+	TArray<FOpenEntry, TInlineAllocator<16>> OpenEntries;
+	for (int32 EntryIdx = First; EntryIdx < End && !bUpdateInterrupted; )
+	{
+		while (OpenEntries.Num() > 0 && EntryIdx >= Hierarchy.SubtreeEnds[OpenEntries.Last().Index])
+		{
+			const FOpenEntry Entry = OpenEntries.Pop();
+			CloseEntry(Hierarchy.Components[Entry.Index], Entry.bTransformChanged);
+		}
+
+		USceneComponent* Component = Hierarchy.Components[EntryIdx];
+		if (Hierarchy.Flags[EntryIdx] & EF_RegularUpdate)
+		{
+			Component->UpdateComponentToWorld();
+			++EntryIdx;
+			continue;
+		}
+
+		// Same as USceneComponent::UpdateComponentToWorldWithParent and the start of PropagateTransformUpdate
+		FParallelTickValidation::CheckWrite(Component, TEXT("UpdateComponentToWorld"));
+		Component->bWorldToComponentUpdated = true;
+
+		const FTransform& NewTransform = Hierarchy.WorldTransforms[EntryIdx];
+		const bool bTransformChanged = !Component->ComponentToWorld.Equals(NewTransform, SMALL_NUMBER);
+		if (bTransformChanged)
+		{
+			Component->ComponentToWorld = NewTransform;
+		}
+
+		if (Component->IsDeferringMovementUpdates())
+		{
+			// The scoped movement updates the component and its children once it ends
+			EntryIdx = Hierarchy.SubtreeEnds[EntryIdx];
+			continue;
+		}
+
+		Component->UpdateBounds();
+		if (bTransformChanged)
+		{
+			Component->OnUpdateTransform(false);
+			Component->MarkRenderTransformDirty();
+		}
+
+		FOpenEntry Entry;
+		Entry.Index = EntryIdx;
+		Entry.bTransformChanged = bTransformChanged;
+		OpenEntries.Add(Entry);
+		++EntryIdx;
+	}
+
+	while (OpenEntries.Num() > 0)
+	{
+		const FOpenEntry Entry = OpenEntries.Pop();
+		CloseEntry(Hierarchy.Components[Entry.Index], Entry.bTransformChanged);
+	}
+
+	const bool bCompleted = !bUpdateInterrupted;
+	UpdatingStore = NULL;
+	UpdatingHierarchy = INDEX_NONE;
+	bUpdateInterrupted = false;
+
+	if (Hierarchy.bPendingRemove)
+	{
+		RemoveHierarchy(HierarchyIndex);
+	}
+
+	return bCompleted;
+}
@@ -0,0 +1,217 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "EnginePrivate.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Components/BoxComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "Tests/CharacterMovementTestComponent.h"
+
+UCharacterMovementTestComponent::UCharacterMovementTestComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCharacterFloorCacheTest, "Engine.Physics.Character Floor Cache", EAutomationTestFlags::ATF_Editor)
+
+/**
+ * Finds the floor of a walking character standing on a static box, and checks that small moves reuse the floor found by the sweep
+ * while moving the box or resizing the capsule invalidates it.
+ */
+bool FCharacterFloorCacheTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	FURL URL;
+	World->InitializeActorsForPlay(URL);
+	World->BeginPlay();
+
+	IConsoleVariable* FloorCacheVar = IConsoleManager::Get().FindConsoleVariable(TEXT("p.FloorCache"));
+	const int32 OldFloorCache = FloorCacheVar->GetInt();
+	FloorCacheVar->Set(1);
+
+	// Stationary, so the floor can be cached but still be moved by the test
+	const float FloorHalfHeight = 10.f;
+	AActor* FloorActor = World->SpawnActor<AActor>(AActor::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator);
+	UBoxComponent* Floor = NewObject<UBoxComponent>(FloorActor);
+	Floor->SetBoxExtent(FVector(500.f, 500.f, FloorHalfHeight));
+	Floor->SetMobility(EComponentMobility::Stationary);
+	Floor->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+	FloorActor->SetRootComponent(Floor);
+	Floor->RegisterComponent();
+
+	FActorSpawnParameters SpawnInfo;
+	SpawnInfo.bNoCollisionFail = true;
+	ACharacter* Character = World->SpawnActor<ACharacter>(ACharacter::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator, SpawnInfo);
+
+	// Floor checks of the character's capsule, through a movement component that exposes them
+	UCharacterMovementTestComponent* MoveComp = NewObject<UCharacterMovementTestComponent>(Character);
+	MoveComp->RegisterComponent();
+	MoveComp->SetUpdatedComponent(Character->GetCapsuleComponent());
+
+	const FVector StartLocation(0.f, 0.f, FloorHalfHeight + Character->GetCapsuleComponent()->GetScaledCapsuleHalfHeight() + 2.f);
+	Character->SetActorLocation(StartLocation);
+	MoveComp->SetMovementMode(MOVE_Walking);
+	MoveComp->bAlwaysCheckFloor = false;
+	MoveComp->bForceNextFloorCheck = false;
+	MoveComp->bJustTeleported = false;
+
+	// The first check has to sweep, and caches what it found
+	FFindFloorResult FloorResult;
+	MoveComp->FindFloor(StartLocation, FloorResult, false);
+
+	TestTrue(TEXT("Standing on the box"), FloorResult.IsWalkableFloor() && FloorResult.HitResult.Component.Get() == Floor);
+	TestTrue(TEXT("Floor found by the sweep is cached"), MoveComp->HasCachedFloor());
+	const float SweptFloorDist = FloorResult.FloorDist;
+
+	// Blocked moves within the tolerance reuse it, vertical offsets adjust the floor distance
+	const FVector NudgedLocation = StartLocation + FVector(0.05f, 0.f, 0.5f);
+	FFindFloorResult CachedResult;
+	TestTrue(TEXT("Cached floor is reused after a small move"), MoveComp->GetCachedFloor(NudgedLocation, CachedResult));
+	TestTrue(TEXT("Cached floor distance follows the vertical offset"), FMath::IsNearlyEqual(CachedResult.FloorDist, SweptFloorDist + 0.5f, KINDA_SMALL_NUMBER));
+
+	MoveComp->FindFloor(NudgedLocation, CachedResult, false);
+	TestTrue(TEXT("FindFloor returns the cached floor"), CachedResult.IsWalkableFloor() && CachedResult.HitResult.Component.Get() == Floor);
+
+	// Moving further has to sweep again
+	FFindFloorResult MovedResult;
+	TestFalse(TEXT("Cached floor is not reused after moving away"), MoveComp->GetCachedFloor(StartLocation + FVector(10.f, 0.f, 0.f), MovedResult));
+
+	// Moving the base invalidates the cache, the next check sweeps and finds the new distance
+	MoveComp->FindFloor(StartLocation, FloorResult, false);
+	Floor->SetWorldLocation(FVector(0.f, 0.f, -1.f));
+
+	TestFalse(TEXT("Cached floor is invalidated by the base moving"), MoveComp->GetCachedFloor(StartLocation, MovedResult));
+
+	MoveComp->FindFloor(StartLocation, MovedResult, false);
+	TestTrue(TEXT("Still standing on the moved box"), MovedResult.IsWalkableFloor() && MovedResult.HitResult.Component.Get() == Floor);
+	TestTrue(TEXT("Floor distance after the base moved"), FMath::IsNearlyEqual(MovedResult.FloorDist, SweptFloorDist + 1.f, 0.01f));
+	TestTrue(TEXT("Floor is cached again after the sweep"), MoveComp->HasCachedFloor() && MoveComp->GetCachedFloorComponentLocation() == Floor->GetComponentLocation());
+
+	// Changing the capsule's collision shape invalidates the cache too
+	UCapsuleComponent* Capsule = Character->GetCapsuleComponent();
+	Capsule->SetCapsuleSize(Capsule->GetUnscaledCapsuleRadius() * 0.5f, Capsule->GetUnscaledCapsuleHalfHeight(), false);
+
+	TestFalse(TEXT("Cached floor is invalidated by resizing the capsule"), MoveComp->GetCachedFloor(StartLocation, MovedResult));
+
+	FloorCacheVar->Set(OldFloorCache);
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCharacterBatchedServerMovesTest, "Engine.Physics.Character Batched Server Moves", EAutomationTestFlags::ATF_Editor)
+
+namespace CharacterBatchedServerMovesTest
+{
+	/** Sends the moves a client walking along Accel would send, @return how far the character moved */
+	static FVector SendServerMoves(UCharacterMovementComponent* MoveComp, float& TimeStamp, int32 NumMoves, const FVector& Accel)
+	{
+		const FVector StartLocation = MoveComp->GetActorLocation();
+
+		for (int32 MoveIndex = 0; MoveIndex < NumMoves; MoveIndex++)
+		{
+			TimeStamp += 1.f / 60.f;
+			MoveComp->ServerMove(TimeStamp, Accel, MoveComp->GetActorLocation(), 0, 0, 0, NULL, NAME_None, MoveComp->PackNetworkMovementMode());
+		}
+
+		return MoveComp->GetActorLocation() - StartLocation;
+	}
+}
+
+/**
+ * Sends the same client moves to two characters walking at full speed on the server, one with p.NetBatchServerMoves 0 and one with 1,
+ * and checks that queued moves are only simulated by the world tick, the queue limit or turning batching off, and end up where serial moves do.
+ */
+bool FCharacterBatchedServerMovesTest::RunTest(const FString& Parameters)
+{
+	using namespace CharacterBatchedServerMovesTest;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	FURL URL;
+	World->InitializeActorsForPlay(URL);
+	World->BeginPlay();
+
+	IConsoleVariable* BatchVar = IConsoleManager::Get().FindConsoleVariable(TEXT("p.NetBatchServerMoves"));
+	IConsoleVariable* MaxMergedTimeVar = IConsoleManager::Get().FindConsoleVariable(TEXT("p.NetBatchServerMovesMaxMergedTime"));
+	const int32 OldBatch = BatchVar->GetInt();
+	const float OldMaxMergedTime = MaxMergedTimeVar->GetFloat();
+	BatchVar->Set(0);
+
+	const float FloorHalfHeight = 10.f;
+	AActor* FloorActor = World->SpawnActor<AActor>(AActor::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator);
+	UBoxComponent* Floor = NewObject<UBoxComponent>(FloorActor);
+	Floor->SetBoxExtent(FVector(5000.f, 5000.f, FloorHalfHeight));
+	Floor->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+	FloorActor->SetRootComponent(Floor);
+	Floor->RegisterComponent();
+
+	// Server side characters of remote clients, A simulates every move when it arrives, B gets them batched
+	FActorSpawnParameters SpawnInfo;
+	SpawnInfo.bNoCollisionFail = true;
+	UCharacterMovementComponent* MoveComps[2];
+	float TimeStamps[2] = { 0.f, 0.f };
+
+	for (int32 CharacterIndex = 0; CharacterIndex < 2; CharacterIndex++)
+	{
+		ACharacter* Character = World->SpawnActor<ACharacter>(ACharacter::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator, SpawnInfo);
+		Character->SetRemoteRoleForBackwardsCompat(ROLE_AutonomousProxy);
+		Character->SetActorLocation(FVector(-4000.f, CharacterIndex * 400.f - 200.f, FloorHalfHeight + Character->GetCapsuleComponent()->GetScaledCapsuleHalfHeight() + 2.f));
+
+		MoveComps[CharacterIndex] = Character->GetCharacterMovement();
+		MoveComps[CharacterIndex]->SetMovementMode(MOVE_Walking);
+	}
+
+	UCharacterMovementComponent* SerialMoveComp = MoveComps[0];
+	UCharacterMovementComponent* BatchedMoveComp = MoveComps[1];
+	const FVector Accel = FVector(1.f, 0.f, 0.f) * SerialMoveComp->GetMaxAcceleration();
+
+	// Get both up to full speed, so simulating several moves as one doesn't change where they end up
+	SendServerMoves(SerialMoveComp, TimeStamps[0], 60, Accel);
+	SendServerMoves(BatchedMoveComp, TimeStamps[1], 60, Accel);
+
+	// Without merging, the queued moves are simulated one by one by the tick
+	const FVector SerialDelta = SendServerMoves(SerialMoveComp, TimeStamps[0], 6, Accel);
+	TestTrue(TEXT("Serial moves are simulated when they arrive"), SerialDelta.X > 0.f);
+
+	BatchVar->Set(1);
+	MaxMergedTimeVar->Set(0.f);
+	FVector BatchedStart = BatchedMoveComp->GetActorLocation();
+	TestTrue(TEXT("Batched moves wait for the tick"), SendServerMoves(BatchedMoveComp, TimeStamps[1], 6, Accel).IsNearlyZero());
+
+	World->Tick(LEVELTICK_All, 1.f / 30.f);
+	GFrameCounter++;
+	TestTrue(TEXT("Batched moves end up where serial moves do"), (BatchedMoveComp->GetActorLocation() - BatchedStart).Equals(SerialDelta, 0.1f));
+
+	// Merged moves cover the same time in fewer simulations
+	MaxMergedTimeVar->Set(0.1f);
+	BatchedStart = BatchedMoveComp->GetActorLocation();
+	SendServerMoves(BatchedMoveComp, TimeStamps[1], 6, Accel);
+
+	World->Tick(LEVELTICK_All, 1.f / 30.f);
+	GFrameCounter++;
+	TestTrue(TEXT("Merged moves end up where serial moves do"), (BatchedMoveComp->GetActorLocation() - BatchedStart).Equals(SerialDelta, 1.f));
+
+	// A full queue is simulated right away
+	TestTrue(TEXT("Full queue is simulated without a tick"), SendServerMoves(BatchedMoveComp, TimeStamps[1], 32, Accel).X > 0.f);
+
+	// Moves queued before batching is turned off are simulated before the next move
+	SendServerMoves(BatchedMoveComp, TimeStamps[1], 5, Accel);
+	BatchVar->Set(0);
+	TestTrue(TEXT("Queued moves are simulated with the first serial move"), SendServerMoves(BatchedMoveComp, TimeStamps[1], 1, Accel).Equals(SerialDelta, 1.f));
+
+	BatchVar->Set(OldBatch);
+	MaxMergedTimeVar->Set(OldMaxMergedTime);
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	return true;
+}
@@ -0,0 +1,262 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "EnginePrivate.h"
+#include "AutomationTest.h"
+#include "Net/DemoStreamer.h"
+#include "Engine/DemoNetDriver.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDemoStreamerTest, "Engine.Network.Demo Streamers", EAutomationTestFlags::ATF_SmokeTest)
+
+/** Writes a header, a fake frame and a checkpoint index through the streamer, then reads them back */
+static bool DemoStreamerRoundTrip( FAutomationTestBase* Test, const FName StreamerName, const FString& StreamName )
+{
+	TSharedPtr< IDemoStreamer > Streamer = FDemoStreamerFactory::CreateStreamer( StreamerName );
+
+	if ( !Streamer.IsValid() )
+	{
+		Test->AddError( FString::Printf( TEXT( "Failed to create streamer %s" ), *StreamerName.ToString() ) );
+		return false;
+	}
+
+	TArray< FDemoCheckpoint > Checkpoints;
+
+	for ( int32 i = 1; i <= 2; i++ )
+	{
+		FDemoCheckpoint Checkpoint;
+		Checkpoint.Time = 30.0f * i;
+		Checkpoint.FrameNum = 300 * i;
+		Checkpoint.Offset = 1000 * i;
+		Checkpoints.Add( Checkpoint );
+	}
+
+	// Record
+	{
+		FArchive* Ar = Streamer->StartStreaming( StreamName, true );
+
+		if ( Ar == NULL )
+		{
+			Test->AddError( FString::Printf( TEXT( "%s: Failed to open %s for recording" ), *StreamerName.ToString(), *StreamName ) );
+			return false;
+		}
+
+		int32 Placeholder = 0;
+		*Ar << Placeholder;
+
+		float DeltaTime = 0.1f;
+		int32 EndCount = 0;
+		*Ar << DeltaTime;
+		*Ar << EndCount;
+
+		// Patch the header like UDemoNetDriver::StopDemo does
+		const int32 IndexOffset = Ar->Tell();
+		*Ar << Checkpoints;
+
+		Ar->Seek( 0 );
+		int32 Header = IndexOffset;
+		*Ar << Header;
+
+		Streamer->StopStreaming();
+		Test->TestNull( TEXT( "Archive is released when streaming stops" ), Streamer->GetStreamingArchive() );
+	}
+
+	// Play back
+	{
+		FArchive* Ar = Streamer->StartStreaming( StreamName, false );
+
+		if ( Ar == NULL )
+		{
+			Test->AddError( FString::Printf( TEXT( "%s: Failed to open %s for playback" ), *StreamerName.ToString(), *StreamName ) );
+			return false;
+		}
+
+		int32 IndexOffset = 0;
+		*Ar << IndexOffset;
+
+		float DeltaTime = 0.0f;
+		*Ar << DeltaTime;
+		Test->TestEqual( TEXT( "Frame delta time survives the round trip" ), DeltaTime, 0.1f );
+
+		Ar->Seek( IndexOffset );
+
+		TArray< FDemoCheckpoint > ReadCheckpoints;
+		*Ar << ReadCheckpoints;
+
+		Test->TestFalse( TEXT( "Checkpoint index reads without errors" ), Ar->IsError() );
+
+		Test->TestEqual( TEXT( "Checkpoint count survives the round trip" ), ReadCheckpoints.Num(), Checkpoints.Num() );
+
+		if ( ReadCheckpoints.Num() == Checkpoints.Num() )
+		{
+			for ( int32 i = 0; i < Checkpoints.Num(); i++ )
+			{
+				Test->TestEqual( TEXT( "Checkpoint time survives the round trip" ), ReadCheckpoints[i].Time, Checkpoints[i].Time );
+				Test->TestEqual( TEXT( "Checkpoint frame survives the round trip" ), ReadCheckpoints[i].FrameNum, Checkpoints[i].FrameNum );
+				Test->TestEqual( TEXT( "Checkpoint offset survives the round trip" ), ReadCheckpoints[i].Offset, Checkpoints[i].Offset );
+			}
+		}
+
+		Streamer->StopStreaming();
+	}
+
+	return true;
+}
+
+bool FDemoStreamerTest::RunTest( const FString& Parameters )
+{
+	const FString MemoryStreamName = TEXT( "DemoStreamerTest" );
+
+	DemoStreamerRoundTrip( this, FName( TEXT( "Memory" ) ), MemoryStreamName );
+
+	TestNotNull( TEXT( "Memory stream outlives the streamer" ), FMemoryDemoStreamer::FindStream( MemoryStreamName ) );
+	FMemoryDemoStreamer::DiscardStream( MemoryStreamName );
+	TestNull( TEXT( "Memory stream is gone after discarding it" ), FMemoryDemoStreamer::FindStream( MemoryStreamName ) );
+
+	const FString DemoFilename = FPaths::AutomationTransientDir() / TEXT( "DemoStreamerTest.demo" );
+
+	DemoStreamerRoundTrip( this, FName( TEXT( "File" ) ), DemoFilename );
+	IFileManager::Get().Delete( *DemoFilename );
+
+	TestFalse( TEXT( "Unknown streamers can't be created" ), FDemoStreamerFactory::CreateStreamer( FName( TEXT( "NoSuchStreamer" ) ) ).IsValid() );
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDemoCheckpointTest, "Engine.Network.Demo Checkpoints", EAutomationTestFlags::ATF_SmokeTest)
+
+/** Writes a frame record holding a single packet, like UDemoNetDriver::TickDemoRecord */
+static void WriteTestFrame( FArchive& Ar, float DeltaTime, uint8 PacketByte )
+{
+	uint8 RecordType = DEMO_RECORD_Frame;
+	int32 PacketBytes = 1;
+	int32 EndCount = 0;
+
+	Ar << RecordType;
+	Ar << DeltaTime;
+	Ar << PacketBytes;
+	Ar << PacketByte;
+	Ar << EndCount;
+}
+
+/** Writes a checkpoint record holding a single packet, like UDemoNetDriver::SaveCheckpoint */
+static FDemoCheckpoint WriteTestCheckpoint( FArchive& Ar, float Time, int32 FrameNum, uint8 PacketByte )
+{
+	TArray< uint8 > CheckpointData;
+	FMemoryWriter CheckpointWriter( CheckpointData );
+
+	int32 PacketBytes = 1;
+	int32 EndCount = 0;
+
+	CheckpointWriter << PacketBytes;
+	CheckpointWriter << PacketByte;
+	CheckpointWriter << EndCount;
+
+	FDemoCheckpoint Checkpoint;
+	Checkpoint.Time		= Time;
+	Checkpoint.FrameNum	= FrameNum;
+	Checkpoint.Offset	= UDemoNetDriver::WriteCheckpointRecord( Ar, CheckpointData );
+
+	return Checkpoint;
+}
+
+/** Reads the single packet following the current position of Ar */
+static uint8 ReadTestPacket( FArchive& Ar )
+{
+	int32 PacketBytes = 0;
+	uint8 PacketByte = 0;
+
+	Ar << PacketBytes;
+	Ar << PacketByte;
+
+	return PacketByte;
+}
+
+bool FDemoCheckpointTest::RunTest( const FString& Parameters )
+{
+	// Frames 1 - 4 at 10 seconds apart, with a checkpoint after frames 2 and 4 (packets hold the frame number, checkpoints 100 + frame number)
+	TArray< uint8 > StreamData;
+	TArray< FDemoCheckpoint > Checkpoints;
+	{
+		FMemoryWriter Writer( StreamData );
+
+		for ( int32 FrameNum = 1; FrameNum <= 4; FrameNum++ )
+		{
+			WriteTestFrame( Writer, 10.0f, FrameNum );
+
+			if ( FrameNum % 2 == 0 )
+			{
+				Checkpoints.Add( WriteTestCheckpoint( Writer, 10.0f * FrameNum, FrameNum, 100 + FrameNum ) );
+			}
+		}
+	}
+
+	const int32 EndOffset = StreamData.Num();
+
+	// Picking the checkpoint to seek to
+	TestEqual( TEXT( "Seeking before the first checkpoint replays from the start" ), UDemoNetDriver::FindCheckpointIndex( Checkpoints, 15.0f ), (int32)INDEX_NONE );
+	TestEqual( TEXT( "Seeking to a checkpoint's time uses it" ), UDemoNetDriver::FindCheckpointIndex( Checkpoints, 20.0f ), 0 );
+	TestEqual( TEXT( "Seeking between checkpoints uses the earlier one" ), UDemoNetDriver::FindCheckpointIndex( Checkpoints, 35.0f ), 0 );
+	TestEqual( TEXT( "Seeking past the last checkpoint uses it" ), UDemoNetDriver::FindCheckpointIndex( Checkpoints, 45.0f ), 1 );
+	TestEqual( TEXT( "Demos without checkpoints replay from the start" ), UDemoNetDriver::FindCheckpointIndex( TArray< FDemoCheckpoint >(), 45.0f ), (int32)INDEX_NONE );
+
+	// Seeking to a checkpoint applies its packets and leaves the stream at the frame after it
+	{
+		FMemoryReader Reader( StreamData );
+		Reader.Seek( Checkpoints[0].Offset );
+
+		TestTrue( TEXT( "Checkpoint record is found at its offset" ), UDemoNetDriver::ReadCheckpointRecordHeader( Reader ) );
+		TestEqual( TEXT( "Seeking restores the checkpoint's packets" ), ReadTestPacket( Reader ), (uint8)102 );
+
+		int32 EndCount = -1;
+		Reader << EndCount;
+		TestEqual( TEXT( "Checkpoint packets end with a zero count" ), EndCount, 0 );
+
+		uint8 RecordType = DEMO_RECORD_Checkpoint;
+		float DeltaTime = 0.0f;
+		Reader << RecordType;
+		Reader << DeltaTime;
+		TestEqual( TEXT( "The frame after the checkpoint follows it" ), (int32)RecordType, (int32)DEMO_RECORD_Frame );
+		TestEqual( TEXT( "The frame after the checkpoint is frame 3" ), ReadTestPacket( Reader ), (uint8)3 );
+
+		Reader.Seek( 0 );
+		TestFalse( TEXT( "Frame records aren't taken for checkpoints" ), UDemoNetDriver::ReadCheckpointRecordHeader( Reader ) );
+	}
+
+	// Normal playback skips the checkpoints and reads every frame in order
+	{
+		FMemoryReader Reader( StreamData );
+		int32 NumFrames = 0;
+
+		while ( true )
+		{
+			UDemoNetDriver::SkipCheckpointRecords( Reader, EndOffset );
+
+			if ( Reader.AtEnd() || Reader.Tell() >= EndOffset )
+			{
+				break;
+			}
+
+			uint8 RecordType = DEMO_RECORD_Checkpoint;
+			float DeltaTime = 0.0f;
+			int32 EndCount = -1;
+
+			Reader << RecordType;
+			Reader << DeltaTime;
+
+			NumFrames++;
+			TestEqual( TEXT( "Playback only stops at frame records" ), (int32)RecordType, (int32)DEMO_RECORD_Frame );
+			TestEqual( TEXT( "Playback reads the frames in order" ), ReadTestPacket( Reader ), (uint8)NumFrames );
+
+			Reader << EndCount;
+
+			if ( Reader.IsError() || RecordType != DEMO_RECORD_Frame )
+			{
+				AddError( TEXT( "Playback lost track of the records" ) );
+				break;
+			}
+		}
+
+		TestEqual( TEXT( "Playback reads every frame" ), NumFrames, 4 );
+	}
+
+	return true;
+}
@@ -0,0 +1,711 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "EnginePrivate.h"
+
+#if WITH_RECAST
+
+#include "DetourNavMesh.h"
+#include "DetourNavMeshBuilder.h"
+#include "DetourNavMeshQuery.h"
+#include "DetourCommon.h"
+#include "DetourCrowd/DetourCrowd.h"
+#include "DetourCrowd/DetourObstacleAvoidance.h"
+
+namespace DetourCrowdTest
+{
+	static const int32 GridSize = 16;
+	static const unsigned short QuadVoxels = 10;
+	static const float CellSize = 10.f;
+	static const int32 MaxVertsPerPoly = 6;
+	static const float Tolerance = 1.e-3f;
+
+	static unsigned short GridVert(int32 X, int32 Z)
+	{
+		return (unsigned short)(Z * (GridSize + 1) + X);
+	}
+
+	static unsigned short GridPoly(int32 X, int32 Z)
+	{
+		return (unsigned short)(Z * GridSize + X);
+	}
+
+	/** Single tile navmesh of GridSize x GridSize square polys on the xz plane, connected to their neighbours */
+	static dtNavMesh* BuildGridNavMesh()
+	{
+		const int32 NumVerts = (GridSize + 1) * (GridSize + 1);
+		const int32 NumPolys = GridSize * GridSize;
+
+		TArray<unsigned short> Verts;
+		Verts.AddZeroed(NumVerts * 3);
+		for (int32 Z = 0; Z <= GridSize; Z++)
+		{
+			for (int32 X = 0; X <= GridSize; X++)
+			{
+				unsigned short* Vert = &Verts[GridVert(X, Z) * 3];
+				Vert[0] = (unsigned short)(X * QuadVoxels);
+				Vert[2] = (unsigned short)(Z * QuadVoxels);
+			}
+		}
+
+		// vertices followed by neighbours of edges starting at them, 0xffff for unused vertices and border edges
+		TArray<unsigned short> Polys;
+		Polys.Init(0xffff, NumPolys * 2 * MaxVertsPerPoly);
+		for (int32 Z = 0; Z < GridSize; Z++)
+		{
+			for (int32 X = 0; X < GridSize; X++)
+			{
+				unsigned short* Poly = &Polys[GridPoly(X, Z) * 2 * MaxVertsPerPoly];
+				Poly[0] = GridVert(X, Z);
+				Poly[1] = GridVert(X + 1, Z);
+				Poly[2] = GridVert(X + 1, Z + 1);
+				Poly[3] = GridVert(X, Z + 1);
+
+				unsigned short* Neighbours = Poly + MaxVertsPerPoly;
+				Neighbours[0] = Z > 0 ? GridPoly(X, Z - 1) : 0xffff;
+				Neighbours[1] = X < GridSize - 1 ? GridPoly(X + 1, Z) : 0xffff;
+				Neighbours[2] = Z < GridSize - 1 ? GridPoly(X, Z + 1) : 0xffff;
+				Neighbours[3] = X > 0 ? GridPoly(X - 1, Z) : 0xffff;
+			}
+		}
+
+		TArray<unsigned short> PolyFlags;
+		PolyFlags.Init(1, NumPolys);
+		TArray<unsigned char> PolyAreas;
+		PolyAreas.AddZeroed(NumPolys);
+
+		dtNavMeshCreateParams Params;
+		FMemory::Memzero(&Params, sizeof(Params));
+		Params.verts = Verts.GetData();
+		Params.vertCount = NumVerts;
+		Params.polys = Polys.GetData();
+		Params.polyFlags = PolyFlags.GetData();
+		Params.polyAreas = PolyAreas.GetData();
+		Params.polyCount = NumPolys;
+		Params.nvp = MaxVertsPerPoly;
+		Params.bmin[0] = 0.f;
+		Params.bmin[1] = 0.f;
+		Params.bmin[2] = 0.f;
+		Params.bmax[0] = GridSize * QuadVoxels * CellSize;
+		Params.bmax[1] = 100.f;
+		Params.bmax[2] = GridSize * QuadVoxels * CellSize;
+		Params.walkableHeight = 200.f;
+		Params.walkableRadius = 34.f;
+		Params.walkableClimb = 40.f;
+		Params.cs = CellSize;
+		Params.ch = CellSize;
+		Params.buildBvTree = true;
+
+		unsigned char* NavData = NULL;
+		int32 NavDataSize = 0;
+		if (!dtCreateNavMeshData(&Params, &NavData, &NavDataSize))
+		{
+			return NULL;
+		}
+
+		dtNavMesh* NavMesh = dtAllocNavMesh();
+		if (NavMesh == NULL || dtStatusFailed(NavMesh->init(NavData, NavDataSize, DT_TILE_FREE_DATA)))
+		{
+			dtFreeNavMesh(NavMesh);
+			return NULL;
+		}
+
+		return NavMesh;
+	}
+
+	static void RunCrowdJob(dtParallelJobFunc JobFunc, void* JobData, int32 JobIdx)
+	{
+		JobFunc(JobData, JobIdx);
+	}
+
+	/** Parallel for running every job on task graph workers, counts its calls in UserData */
+	static void TaskGraphParallelFor(void* UserData, dtParallelJobFunc JobFunc, void* JobData, const int NumJobs)
+	{
+		DECLARE_CYCLE_STAT(TEXT("FSimpleDelegateGraphTask.DetourCrowdTestJob"), STAT_FSimpleDelegateGraphTask_DetourCrowdTestJob, STATGROUP_TaskGraphTasks);
+
+		FGraphEventArray JobEvents;
+		for (int32 JobIdx = 0; JobIdx < NumJobs; JobIdx++)
+		{
+			JobEvents.Add(FSimpleDelegateGraphTask::CreateAndDispatchWhenReady(
+				FSimpleDelegateGraphTask::FDelegate::CreateStatic(&RunCrowdJob, JobFunc, JobData, JobIdx),
+				GET_STATID(STAT_FSimpleDelegateGraphTask_DetourCrowdTestJob)));
+		}
+
+		FTaskGraphInterface::Get().WaitUntilTasksComplete(JobEvents, ENamedThreads::GameThread);
+		(*(int32*)UserData)++;
+	}
+
+	/** Crowd of agents placed on a ring in the middle of the grid, each one walking to the opposite side of it */
+	static dtCrowd* CreateRingCrowd(dtNavMesh* NavMesh, int32 NumAgents, const dtQueryFilter& Filter)
+	{
+		dtCrowd* Crowd = dtAllocCrowd();
+		if (Crowd == NULL || !Crowd->init(NumAgents, 50.f, NavMesh) || !Crowd->initAvoidance(6, 8, 1))
+		{
+			dtFreeCrowd(Crowd);
+			return NULL;
+		}
+
+		dtObstacleAvoidanceParams AvoidanceParams;
+		AvoidanceParams.velBias = 0.4f;
+		AvoidanceParams.weightDesVel = 2.0f;
+		AvoidanceParams.weightCurVel = 0.75f;
+		AvoidanceParams.weightSide = 0.75f;
+		AvoidanceParams.weightToi = 2.5f;
+		AvoidanceParams.horizTime = 2.5f;
+		AvoidanceParams.patternIdx = 0xff;
+		AvoidanceParams.adaptiveDivs = 7;
+		AvoidanceParams.adaptiveRings = 2;
+		AvoidanceParams.adaptiveDepth = 5;
+		Crowd->setObstacleAvoidanceParams(0, &AvoidanceParams);
+
+		dtCrowdAgentParams AgentParams;
+		AgentParams.userData = NULL;
+		AgentParams.radius = 34.f;
+		AgentParams.height = 180.f;
+		AgentParams.maxAcceleration = 1000.f;
+		AgentParams.maxSpeed = 300.f;
+		AgentParams.collisionQueryRange = AgentParams.radius * 12.f;
+		AgentParams.pathOptimizationRange = AgentParams.radius * 30.f;
+		AgentParams.separationWeight = 2.f;
+		AgentParams.avoidanceGroup = 1;
+		AgentParams.groupsToAvoid = MAX_uint32;
+		AgentParams.groupsToIgnore = 0;
+		AgentParams.updateFlags = DT_CROWD_ANTICIPATE_TURNS | DT_CROWD_OBSTACLE_AVOIDANCE | DT_CROWD_SEPARATION | DT_CROWD_OPTIMIZE_VIS | DT_CROWD_OPTIMIZE_TOPO;
+		AgentParams.obstacleAvoidanceType = 0;
+		AgentParams.filter = 0;
+
+		dtNavMeshQuery* NavQuery = dtAllocNavMeshQuery();
+		NavQuery->init(NavMesh, 256);
+
+		const float Center = GridSize * QuadVoxels * CellSize * 0.5f;
+		const float RingRadius = Center * 0.75f;
+		const float Extent[3] = { 50.f, 100.f, 50.f };
+		for (int32 AgentIdx = 0; AgentIdx < NumAgents; AgentIdx++)
+		{
+			const float Angle = (2.f * PI * AgentIdx) / NumAgents;
+			const float Pos[3] = { Center + FMath::Cos(Angle) * RingRadius, 0.f, Center + FMath::Sin(Angle) * RingRadius };
+			const float Goal[3] = { Center - FMath::Cos(Angle) * RingRadius, 0.f, Center - FMath::Sin(Angle) * RingRadius };
+
+			const int32 CrowdIdx = Crowd->addAgent(Pos, AgentParams, &Filter);
+
+			dtPolyRef GoalRef = 0;
+			float GoalPos[3];
+			NavQuery->findNearestPoly(Goal, Extent, &Filter, &GoalRef, GoalPos);
+			if (CrowdIdx >= 0 && GoalRef)
+			{
+				Crowd->requestMoveTarget(CrowdIdx, GoalRef, GoalPos);
+			}
+		}
+
+		dtFreeNavMeshQuery(NavQuery);
+		return Crowd;
+	}
+
+	static bool IsNearlyEqual2D(const float* A, const float* B)
+	{
+		return FMath::IsNearlyEqual(A[0], B[0], Tolerance) && FMath::IsNearlyEqual(A[2], B[2], Tolerance);
+	}
+
+	static const float DT_PI = 3.14159265f;
+
+	/**
+	 * Copy of the per sample scoring of dtObstacleAvoidanceQuery from before candidates were processed in arrays,
+	 * working on obstacles of the tested query, prepared by its last sampling call.
+	 */
+	struct FReferenceSampler
+	{
+		dtObstacleAvoidanceQuery& Query;
+		const dtObstacleAvoidanceParams& m_params;
+		float m_invHorizTime;
+		float m_invVmax;
+
+		FReferenceSampler(dtObstacleAvoidanceQuery& InQuery, const dtObstacleAvoidanceParams& InParams, const float vmax)
+			: Query(InQuery)
+			, m_params(InParams)
+			, m_invHorizTime(1.0f / InParams.horizTime)
+			, m_invVmax(1.0f / vmax)
+		{
+		}
+
+		/** dtVdist2D, its dtSqrt isn't exported by the navmesh module */
+		static float Dist2D(const float* v1, const float* v2)
+		{
+			const float dx = v2[0] - v1[0];
+			const float dz = v2[2] - v1[2];
+			return sqrtf(dx*dx + dz*dz);
+		}
+
+		static int sweepCircleCircle(const float* c0, const float r0, const float* v,
+									 const float* c1, const float r1,
+									 float& tmin, float& tmax)
+		{
+			static const float EPS = 0.0001f;
+			float s[3];
+			dtVsub(s,c1,c0);
+			float r = r0+r1;
+			float c = dtVdot2D(s,s) - r*r;
+			float a = dtVdot2D(v,v);
+			if (a < EPS) return 0;	// not moving
+
+			// Overlap, calc time to exit.
+			float b = dtVdot2D(v,s);
+			float d = b*b - a*c;
+			if (d < 0.0f) return 0; // no intersection.
+			a = 1.0f / a;
+			const float rd = sqrtf(d);
+			tmin = (b - rd) * a;
+			tmax = (b + rd) * a;
+			return 1;
+		}
+
+		static int isectRaySeg(const float* ap, const float* u,
+							   const float* bp, const float* bq,
+							   float& t)
+		{
+			float v[3], w[3];
+			dtVsub(v,bq,bp);
+			dtVsub(w,ap,bp);
+			float d = dtVperp2D(u,v);
+			if (fabsf(d) < 1e-6f) return 0;
+			d = 1.0f/d;
+			t = dtVperp2D(v,w) * d;
+			if (t < 0 || t > 1) return 0;
+			float s = dtVperp2D(u,w) * d;
+			if (s < 0 || s > 1) return 0;
+			return 1;
+		}
+
+		float processSample(const float* vcand, const float cs,
+							const float* pos, const float rad,
+							const float* vel, const float* dvel,
+							dtObstacleAvoidanceDebugData* debug)
+		{
+			// Find min time of impact and exit amongst all obstacles.
+			float tmin = m_params.horizTime;
+			float side = 0;
+			int nside = 0;
+
+			for (int i = 0; i < Query.getObstacleCircleCount(); ++i)
+			{
+				const dtObstacleCircle* cir = Query.getObstacleCircle(i);
+
+				// RVO
+				float vab[3];
+				dtVscale(vab, vcand, 2);
+				dtVsub(vab, vab, vel);
+				dtVsub(vab, vab, cir->vel);
+
+				// Side
+				side += dtClamp(dtMin(dtVdot2D(cir->dp,vab)*0.5f+0.5f, dtVdot2D(cir->np,vab)*2), 0.0f, 1.0f);
+				nside++;
+
+				float htmin = 0, htmax = 0;
+				if (!sweepCircleCircle(pos,rad, vab, cir->p,cir->rad, htmin, htmax))
+					continue;
+
+				// Handle overlapping obstacles.
+				if (htmin < 0.0f && htmax > 0.0f)
+				{
+					// Avoid more when overlapped.
+					htmin = -htmin * 0.5f;
+				}
+
+				if (htmin >= 0.0f)
+				{
+					// The closest obstacle is somewhere ahead of us, keep track of nearest obstacle.
+					if (htmin < tmin)
+						tmin = htmin;
+				}
+			}
+
+			for (int i = 0; i < Query.getObstacleSegmentCount(); ++i)
+			{
+				const dtObstacleSegment* seg = Query.getObstacleSegment(i);
+				float htmin = 0;
+
+				if (seg->touch)
+				{
+					// Special case when the agent is very close to the segment.
+					float sdir[3], snorm[3];
+					dtVsub(sdir, seg->q, seg->p);
+					snorm[0] = -sdir[2];
+					snorm[2] = sdir[0];
+					// If the velocity is pointing towards the segment, no collision.
+					if (dtVdot2D(snorm, vcand) < 0.0f)
+						continue;
+					// Else immediate collision.
+					htmin = 0.0f;
+				}
+				else
+				{
+					if (!isectRaySeg(pos, vcand, seg->p, seg->q, htmin))
+						continue;
+				}
+
+				// Avoid less when facing walls.
+				htmin *= 2.0f;
+
+				// The closest obstacle is somewhere ahead of us, keep track of nearest obstacle.
+				if (htmin < tmin)
+					tmin = htmin;
+			}
+
+			// Normalize side bias, to prevent it dominating too much.
+			if (nside)
+				side /= nside;
+
+			const float vpen = m_params.weightDesVel * (Dist2D(vcand, dvel) * m_invVmax);
+			const float vcpen = m_params.weightCurVel * (Dist2D(vcand, vel) * m_invVmax);
+			const float spen = m_params.weightSide * side;
+			const float tpen = m_params.weightToi * (1.0f/(0.1f+tmin*m_invHorizTime));
+
+			const float penalty = vpen + vcpen + spen + tpen;
+
+			// Store different penalties for debug viewing
+			if (debug)
+				debug->addSample(vcand, cs, penalty, vpen, vcpen, spen, tpen);
+
+			return penalty;
+		}
+
+		int sampleVelocityCustom(const float* pos, const float rad, const float vmax,
+								 const float* vel, const float* dvel, float* nvel,
+								 dtObstacleAvoidanceDebugData* debug)
+		{
+			dtVset(nvel, 0,0,0);
+
+			if (debug)
+				debug->reset();
+
+			dtObstacleAvoidancePattern pattern;
+			Query.getCustomSamplingPattern(m_params.patternIdx, pattern.angles, pattern.radii, &pattern.nsamples);
+			const float dang = atan2f(dvel[2], dvel[0]);
+
+			float pat[DT_MAX_CUSTOM_SAMPLES * 2];
+			for (int i = 0; i < pattern.nsamples; i++)
+			{
+				float a = dang + pattern.angles[i];
+				pat[i * 2 + 0] = cosf(a) * pattern.radii[i];
+				pat[i * 2 + 1] = sinf(a) * pattern.radii[i];
+			}
+
+			float minPenalty = FLT_MAX;
+			float cr = vmax * (1.0f - m_params.velBias);
+			float res[3];
+			bool bFoundSample = false;
+			dtVset(res, dvel[0] * m_params.velBias, 0, dvel[2] * m_params.velBias);
+
+			for (int i = 0; i < pattern.nsamples; ++i)
+			{
+				float vcand[3];
+				vcand[0] = res[0] + pat[i * 2 + 0] * cr;
+				vcand[1] = 0;
+				vcand[2] = res[2] + pat[i * 2 + 1] * cr;
+
+				if (dtSqr(vcand[0]) + dtSqr(vcand[2]) > dtSqr(vmax + 0.001f)) continue;
+
+				const float penalty = processSample(vcand, 20.0f, pos, rad, vel, dvel, debug);
+				if (penalty < minPenalty)
+				{
+					bFoundSample = true;
+					minPenalty = penalty;
+					dtVcopy(nvel, vcand);
+				}
+			}
+
+			if (!bFoundSample)
+			{
+				dtVcopy(nvel, dvel);
+			}
+
+			return pattern.nsamples;
+		}
+
+		int sampleVelocityAdaptive(const float* pos, const float rad, const float vmax,
+								   const float* vel, const float* dvel, float* nvel,
+								   dtObstacleAvoidanceDebugData* debug)
+		{
+			dtVset(nvel, 0,0,0);
+
+			if (debug)
+				debug->reset();
+
+			// Build sampling pattern aligned to desired velocity.
+			float pat[(DT_MAX_PATTERN_DIVS*DT_MAX_PATTERN_RINGS+1)*2];
+			int npat = 0;
+
+			const int ndivs = (int)m_params.adaptiveDivs;
+			const int nrings= (int)m_params.adaptiveRings;
+			const int depth = (int)m_params.adaptiveDepth;
+
+			const int nd = dtClamp(ndivs, 1, DT_MAX_PATTERN_DIVS);
+			const int nr = dtClamp(nrings, 1, DT_MAX_PATTERN_RINGS);
+			const float da = (1.0f/nd) * DT_PI*2;
+			const float dang = atan2f(dvel[2], dvel[0]);
+
+			// Always add sample at zero
+			pat[npat*2+0] = 0;
+			pat[npat*2+1] = 0;
+			npat++;
+
+			for (int j = 0; j < nr; ++j)
+			{
+				const float r = (float)(nr-j)/(float)nr;
+				float a = dang + (j&1)*0.5f*da;
+				for (int i = 0; i < nd; ++i)
+				{
+					pat[npat*2+0] = cosf(a)*r;
+					pat[npat*2+1] = sinf(a)*r;
+					npat++;
+					a += da;
+				}
+			}
+
+			// Start sampling.
+			float cr = vmax * (1.0f - m_params.velBias);
+			float res[3];
+			dtVset(res, dvel[0] * m_params.velBias, 0, dvel[2] * m_params.velBias);
+			int ns = 0;
+
+			for (int k = 0; k < depth; ++k)
+			{
+				float minPenalty = FLT_MAX;
+				float bvel[3];
+				dtVset(bvel, 0,0,0);
+
+				for (int i = 0; i < npat; ++i)
+				{
+					float vcand[3];
+					vcand[0] = res[0] + pat[i*2+0]*cr;
+					vcand[1] = 0;
+					vcand[2] = res[2] + pat[i*2+1]*cr;
+
+					if (dtSqr(vcand[0])+dtSqr(vcand[2]) > dtSqr(vmax+0.001f)) continue;
+
+					const float penalty = processSample(vcand,cr/10, pos,rad,vel,dvel, debug);
+					ns++;
+					if (penalty < minPenalty)
+					{
+						minPenalty = penalty;
+						dtVcopy(bvel, vcand);
+					}
+				}
+
+				dtVcopy(res, bvel);
+
+				cr *= 0.5f;
+			}
+
+			dtVcopy(nvel, res);
+
+			return ns;
+		}
+	};
+
+	static bool HaveSameSamples(const dtObstacleAvoidanceDebugData& A, const dtObstacleAvoidanceDebugData& B)
+	{
+		if (A.getSampleCount() == 0 || A.getSampleCount() != B.getSampleCount())
+		{
+			return false;
+		}
+
+		for (int32 SampleIdx = 0; SampleIdx < A.getSampleCount(); SampleIdx++)
+		{
+			if (!IsNearlyEqual2D(A.getSampleVelocity(SampleIdx), B.getSampleVelocity(SampleIdx))
+				|| A.getSampleSize(SampleIdx) != B.getSampleSize(SampleIdx)
+				|| !FMath::IsNearlyEqual(A.getSamplePenalty(SampleIdx), B.getSamplePenalty(SampleIdx), Tolerance)
+				|| !FMath::IsNearlyEqual(A.getSampleDesiredVelocityPenalty(SampleIdx), B.getSampleDesiredVelocityPenalty(SampleIdx), Tolerance)
+				|| !FMath::IsNearlyEqual(A.getSampleCurrentVelocityPenalty(SampleIdx), B.getSampleCurrentVelocityPenalty(SampleIdx), Tolerance)
+				|| !FMath::IsNearlyEqual(A.getSamplePreferredSidePenalty(SampleIdx), B.getSamplePreferredSidePenalty(SampleIdx), Tolerance)
+				|| !FMath::IsNearlyEqual(A.getSampleCollisionTimePenalty(SampleIdx), B.getSampleCollisionTimePenalty(SampleIdx), Tolerance))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	static void RandomVector2D(FRandomStream& Random, float MinSize, float MaxSize, float* OutVector)
+	{
+		const float Angle = Random.FRandRange(0.f, 2.f * PI);
+		const float Size = Random.FRandRange(MinSize, MaxSize);
+		dtVset(OutVector, FMath::Cos(Angle) * Size, 0.f, FMath::Sin(Angle) * Size);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDetourCrowdParallelUpdateTest, "Engine.AI.Navigation.Crowd Parallel Update", EAutomationTestFlags::ATF_Editor)
+
+/**
+ * Moves the same agents with two crowds, one updating all agents on the calling thread and one splitting them in chunks
+ * run by task graph workers (setParallelUpdate). Agents have to end up at the same positions with the same velocities.
+ */
+bool FDetourCrowdParallelUpdateTest::RunTest(const FString& Parameters)
+{
+	using namespace DetourCrowdTest;
+
+	dtNavMesh* NavMesh = BuildGridNavMesh();
+	if (NavMesh == NULL)
+	{
+		AddError(TEXT("Navmesh wasn't built"));
+		return false;
+	}
+
+	const int32 NumAgents = 40;
+	const dtQueryFilter Filter;
+	dtCrowd* SerialCrowd = CreateRingCrowd(NavMesh, NumAgents, Filter);
+	dtCrowd* ChunkedCrowd = CreateRingCrowd(NavMesh, NumAgents, Filter);
+
+	int32 NumParallelFors = 0;
+	if (SerialCrowd == NULL || ChunkedCrowd == NULL || !ChunkedCrowd->setParallelUpdate(4, 8))
+	{
+		AddError(TEXT("Crowds weren't created"));
+	}
+	else
+	{
+		// 40 agents in chunks of 5, the most chunks allowed
+		ChunkedCrowd->setParallelFor(&TaskGraphParallelFor, &NumParallelFors);
+
+		const float DeltaTime = 1.f / 30.f;
+		for (int32 StepIdx = 0; StepIdx < 60; StepIdx++)
+		{
+			SerialCrowd->update(DeltaTime, NULL);
+			ChunkedCrowd->update(DeltaTime, NULL);
+		}
+
+		TestTrue(TEXT("Chunked crowd runs update steps through parallel for"), NumParallelFors > 0);
+
+		bool bMoved = false;
+		bool bSameAgents = true;
+		for (int32 AgentIdx = 0; AgentIdx < NumAgents; AgentIdx++)
+		{
+			const dtCrowdAgent* SerialAgent = SerialCrowd->getAgent(AgentIdx);
+			const dtCrowdAgent* ChunkedAgent = ChunkedCrowd->getAgent(AgentIdx);
+			bMoved = bMoved || dtVlenSqr(SerialAgent->vel) > 0.f;
+			bSameAgents = bSameAgents && SerialAgent->active == ChunkedAgent->active
+				&& SerialAgent->npos[0] == ChunkedAgent->npos[0] && SerialAgent->npos[2] == ChunkedAgent->npos[2]
+				&& SerialAgent->vel[0] == ChunkedAgent->vel[0] && SerialAgent->vel[2] == ChunkedAgent->vel[2]
+				&& SerialAgent->nvel[0] == ChunkedAgent->nvel[0] && SerialAgent->nvel[2] == ChunkedAgent->nvel[2];
+		}
+
+		TestTrue(TEXT("Agents move towards their targets"), bMoved);
+		TestTrue(TEXT("Chunked update moves agents exactly like serial one"), bSameAgents);
+	}
+
+	dtFreeCrowd(SerialCrowd);
+	dtFreeCrowd(ChunkedCrowd);
+	dtFreeNavMesh(NavMesh);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDetourAvoidanceSamplingTest, "Engine.AI.Navigation.Crowd Avoidance Sampling", EAutomationTestFlags::ATF_Editor)
+
+/**
+ * Samples velocities around random agents, walls and a wall touched by the agent with adaptive and custom patterns,
+ * scoring all candidates at once (dtObstacleAvoidanceQuery::processSamples) and one after another with the reference copy
+ * of the per sample version. Both have to score the same samples the same way and pick the same velocity.
+ */
+bool FDetourAvoidanceSamplingTest::RunTest(const FString& Parameters)
+{
+	using namespace DetourCrowdTest;
+
+	dtObstacleAvoidanceQuery* Query = dtAllocObstacleAvoidanceQuery();
+	dtObstacleAvoidanceDebugData* Debug = dtAllocObstacleAvoidanceDebugData();
+	dtObstacleAvoidanceDebugData* ReferenceDebug = dtAllocObstacleAvoidanceDebugData();
+	if (Query == NULL || !Query->init(8, 8, 1) || Debug == NULL || !Debug->init(256) || ReferenceDebug == NULL || !ReferenceDebug->init(256))
+	{
+		AddError(TEXT("Avoidance query wasn't created"));
+		dtFreeObstacleAvoidanceQuery(Query);
+		dtFreeObstacleAvoidanceDebugData(Debug);
+		dtFreeObstacleAvoidanceDebugData(ReferenceDebug);
+		return false;
+	}
+
+	const int32 NumPatternSamples = 12;
+	float PatternAngles[NumPatternSamples];
+	float PatternRadii[NumPatternSamples];
+	for (int32 SampleIdx = 0; SampleIdx < NumPatternSamples; SampleIdx++)
+	{
+		PatternAngles[SampleIdx] = (SampleIdx - NumPatternSamples / 2) * (PI / NumPatternSamples);
+		PatternRadii[SampleIdx] = (SampleIdx & 1) ? 0.5f : 1.f;
+	}
+	Query->setCustomSamplingPattern(0, PatternAngles, PatternRadii, NumPatternSamples);
+
+	dtObstacleAvoidanceParams Params;
+	Params.velBias = 0.4f;
+	Params.weightDesVel = 2.0f;
+	Params.weightCurVel = 0.75f;
+	Params.weightSide = 0.75f;
+	Params.weightToi = 2.5f;
+	Params.horizTime = 2.5f;
+	Params.adaptiveDivs = 7;
+	Params.adaptiveRings = 2;
+	Params.adaptiveDepth = 5;
+
+	const float Pos[3] = { 0.f, 0.f, 0.f };
+	const float Radius = 34.f;
+	const float MaxSpeed = 300.f;
+
+	FRandomStream Random(0x2f7a);
+	bool bSameAdaptive = true;
+	bool bSameCustom = true;
+	for (int32 CaseIdx = 0; CaseIdx < 16; CaseIdx++)
+	{
+		float Vel[3], DesiredVel[3];
+		RandomVector2D(Random, 0.f, MaxSpeed, Vel);
+		RandomVector2D(Random, MaxSpeed * 0.5f, MaxSpeed, DesiredVel);
+
+		// agents closer than sum of radii overlap the sampling one
+		Query->reset();
+		for (int32 CircleIdx = 0; CircleIdx < 5; CircleIdx++)
+		{
+			float CirclePos[3], CircleVel[3], CircleDesiredVel[3];
+			RandomVector2D(Random, 40.f, 400.f, CirclePos);
+			RandomVector2D(Random, 0.f, MaxSpeed, CircleVel);
+			RandomVector2D(Random, 0.f, MaxSpeed, CircleDesiredVel);
+			Query->addCircle(CirclePos, Radius, CircleVel, CircleDesiredVel);
+		}
+
+		for (int32 SegmentIdx = 0; SegmentIdx < 3; SegmentIdx++)
+		{
+			float SegmentStart[3], SegmentEnd[3];
+			RandomVector2D(Random, 50.f, 300.f, SegmentStart);
+			RandomVector2D(Random, 50.f, 300.f, SegmentEnd);
+			Query->addSegment(SegmentStart, SegmentEnd);
+		}
+
+		if (CaseIdx & 1)
+		{
+			float SegmentDir[3];
+			RandomVector2D(Random, 100.f, 100.f, SegmentDir);
+			const float SegmentStart[3] = { -SegmentDir[0], 0.f, -SegmentDir[2] };
+			Query->addSegment(SegmentStart, SegmentDir);
+		}
+
+		FReferenceSampler Reference(*Query, Params, MaxSpeed);
+		float NewVel[3], ReferenceNewVel[3];
+
+		Params.patternIdx = 0xff;
+		const int32 NumAdaptiveSamples = Query->sampleVelocityAdaptive(Pos, Radius, MaxSpeed, Vel, DesiredVel, NewVel, &Params, Debug);
+		const int32 NumReferenceAdaptiveSamples = Reference.sampleVelocityAdaptive(Pos, Radius, MaxSpeed, Vel, DesiredVel, ReferenceNewVel, ReferenceDebug);
+		bSameAdaptive = bSameAdaptive && NumAdaptiveSamples == NumReferenceAdaptiveSamples
+			&& IsNearlyEqual2D(NewVel, ReferenceNewVel) && HaveSameSamples(*Debug, *ReferenceDebug);
+
+		Params.patternIdx = 0;
+		const int32 NumCustomSamples = Query->sampleVelocityCustom(Pos, Radius, MaxSpeed, Vel, DesiredVel, NewVel, &Params, Debug);
+		const int32 NumReferenceCustomSamples = Reference.sampleVelocityCustom(Pos, Radius, MaxSpeed, Vel, DesiredVel, ReferenceNewVel, ReferenceDebug);
+		bSameCustom = bSameCustom && NumCustomSamples == NumReferenceCustomSamples
+			&& IsNearlyEqual2D(NewVel, ReferenceNewVel) && HaveSameSamples(*Debug, *ReferenceDebug);
+	}
+
+	TestTrue(TEXT("Adaptive sampling scores and picks velocities like the per sample version"), bSameAdaptive);
+	TestTrue(TEXT("Custom pattern sampling scores and picks velocities like the per sample version"), bSameCustom);
+
+	dtFreeObstacleAvoidanceQuery(Query);
+	dtFreeObstacleAvoidanceDebugData(Debug);
+	dtFreeObstacleAvoidanceDebugData(ReferenceDebug);
+
+	return true;
+}
+
+#endif // WITH_RECAST
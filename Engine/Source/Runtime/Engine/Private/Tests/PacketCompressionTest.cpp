@@ -0,0 +1,69 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "EnginePrivate.h"
+#include "AutomationTest.h"
+#include "Net/PacketCompression.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPacketCompressionTest, "Engine.Network.Packet Compression", EAutomationTestFlags::ATF_SmokeTest)
+
+bool FPacketCompressionTest::RunTest(const FString& Parameters)
+{
+	// Train on a skewed distribution, like packets full of small ints and zero padding
+	uint64 Frequencies[256] = { 0 };
+	for (int32 Symbol = 0; Symbol < 256; Symbol++)
+	{
+		Frequencies[Symbol] = Symbol < 16 ? 100000 : 10;
+	}
+
+	uint8 CodeLengths[256];
+	FNetPacketCompressor::BuildCodeLengths(Frequencies, CodeLengths);
+
+	FNetPacketCompressor Compressor;
+	TestTrue(TEXT("Trained code lengths form a valid code"), Compressor.InitFromCodeLengths(CodeLengths));
+
+	if (!Compressor.IsValid())
+	{
+		return false;
+	}
+
+	FRandomStream Random(1234);
+	int32 NumCompressed = 0;
+
+	for (int32 PacketIndex = 0; PacketIndex < 1000; PacketIndex++)
+	{
+		TArray<uint8> Packet;
+		const int32 PacketSize = Random.RandRange(1, 1024);
+
+		for (int32 i = 0; i < PacketSize; i++)
+		{
+			Packet.Add((uint8)(Random.FRand() < 0.9f ? Random.RandRange(0, 15) : Random.RandRange(0, 255)));
+		}
+
+		// Packets always end with the terminator bit
+		Packet[PacketSize - 1] |= 0x80;
+
+		TArray<uint8> Compressed;
+		if (!Compressor.Compress(Packet.GetData(), Packet.Num(), Compressed))
+		{
+			continue;
+		}
+
+		NumCompressed++;
+
+		TArray<uint8> Decompressed;
+		if (!Compressor.Decompress(Compressed.GetData(), Compressed.Num(), Decompressed) || Decompressed != Packet)
+		{
+			AddError(FString::Printf(TEXT("Packet %i (%i bytes) didn't survive the round trip"), PacketIndex, PacketSize));
+			return false;
+		}
+	}
+
+	TestTrue(TEXT("Most packets matching the training data compress"), NumCompressed > 900);
+
+	// Truncated packets must be rejected rather than read out of bounds
+	const uint8 Truncated[] = { 0xFF, 0x03, 0x12, 0x00 };
+	TArray<uint8> Decompressed;
+	TestFalse(TEXT("Truncated packet is rejected"), Compressor.Decompress(Truncated, ARRAY_COUNT(Truncated), Decompressed));
+
+	return true;
+}
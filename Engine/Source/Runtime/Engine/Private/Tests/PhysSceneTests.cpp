@@ -0,0 +1,74 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "EnginePrivate.h"
+#include "PhysicsPublic.h"
+#include "Components/BoxComponent.h"
+
+#if WITH_PHYSX
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSimulatedBodyStateTest, "Engine.Physics.Simulated Body States", EAutomationTestFlags::ATF_Editor)
+
+/**
+ * Steps a frame lagged sync scene with a falling box, and checks the snapshot gameplay reads:
+ * it matches the component once the buffers flip, and a terminated body keeps its state until the next flip.
+ */
+bool FSimulatedBodyStateTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+	World->bShouldSimulatePhysics = true;
+
+	FURL URL;
+	World->InitializeActorsForPlay(URL);
+	World->BeginPlay();
+
+	IConsoleVariable* FrameLagSyncVar = IConsoleManager::Get().FindConsoleVariable(TEXT("p.FrameLagSyncScene"));
+	const int32 OldFrameLagSync = FrameLagSyncVar->GetInt();
+	FrameLagSyncVar->Set(1);
+
+	AActor* BoxActor = World->SpawnActor<AActor>(AActor::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator);
+	UBoxComponent* Box = NewObject<UBoxComponent>(BoxActor);
+	Box->SetBoxExtent(FVector(50.f));
+	Box->SetMobility(EComponentMobility::Movable);
+	Box->SetCollisionProfileName(UCollisionProfile::PhysicsActor_ProfileName);
+	Box->SetSimulatePhysics(true);
+	BoxActor->SetRootComponent(Box);
+	Box->RegisterComponent();
+
+	FPhysScene* PhysScene = World->GetPhysicsScene();
+	FSimulatedBodyState State;
+
+	TestFalse(TEXT("No state before the body was simulated"), PhysScene->GetSimulatedBodyState(&Box->BodyInstance, State));
+
+	// The first frame only starts the lagged step, later frames fetch the step in flight and flip its snapshot to the front at EndFrame
+	for (int32 Frame = 0; Frame < 3; ++Frame)
+	{
+		World->Tick(LEVELTICK_All, 1.f / 30.f);
+		GFrameCounter++;
+	}
+
+	TestTrue(TEXT("Falling body has a state after the flip"), PhysScene->GetSimulatedBodyState(&Box->BodyInstance, State));
+	TestTrue(TEXT("State matches the results applied to the component"), State.Transform.GetLocation().Equals(Box->GetComponentLocation(), KINDA_SMALL_NUMBER));
+	TestTrue(TEXT("State has the falling velocity"), State.LinearVelocity.Z < 0.f);
+
+	// Terminating the body doesn't touch the front buffer worker threads may be reading
+	const FBodyInstance* TerminatedBody = &Box->BodyInstance;
+	Box->BodyInstance.TermBody();
+
+	TestTrue(TEXT("Terminated body keeps its state until the flip"), PhysScene->GetSimulatedBodyState(TerminatedBody, State));
+
+	World->Tick(LEVELTICK_All, 1.f / 30.f);
+	GFrameCounter++;
+
+	TestFalse(TEXT("Terminated body is removed by the flip"), PhysScene->GetSimulatedBodyState(TerminatedBody, State));
+
+	FrameLagSyncVar->Set(OldFrameLagSync);
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	return true;
+}
+
+#endif // WITH_PHYSX
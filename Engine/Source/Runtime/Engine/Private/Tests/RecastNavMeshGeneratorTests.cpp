@@ -0,0 +1,174 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "EnginePrivate.h"
+
+#if WITH_RECAST
+
+#include "AI/NavigationOctree.h"
+#include "AI/Navigation/RecastNavMesh.h"
+#include "AI/Navigation/RecastNavMeshGenerator.h"
+#include "RecastNavMeshTestCommon.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRecastTileGeometryClippingTest, "Engine.AI.Navigation.Tile Geometry Clipping", EAutomationTestFlags::ATF_Editor)
+
+namespace RecastTileGeometryClippingTest
+{
+	/** Gathers centers of polys of every tile, per tile coords and layer */
+	static void GatherTilePolys(const ARecastNavMesh* NavMesh, TMap<FIntVector, TArray<FVector> >& OutTiles)
+	{
+		OutTiles.Empty();
+
+		TArray<FNavPoly> Polys;
+		for (int32 TileIndex = 0; TileIndex < NavMesh->GetNavMeshTilesCount(); TileIndex++)
+		{
+			int32 TileX = 0, TileY = 0, Layer = 0;
+			Polys.Reset();
+			if (NavMesh->GetPolysInTile(TileIndex, Polys) && NavMesh->GetNavMeshTileXY(TileIndex, TileX, TileY, Layer))
+			{
+				TArray<FVector>& PolyCenters = OutTiles.Add(FIntVector(TileX, TileY, Layer));
+				for (const FNavPoly& Poly : Polys)
+				{
+					PolyCenters.Add(Poly.Center);
+				}
+			}
+		}
+	}
+
+	static bool HaveSameTiles(const TMap<FIntVector, TArray<FVector> >& A, const TMap<FIntVector, TArray<FVector> >& B)
+	{
+		if (A.Num() != B.Num())
+		{
+			return false;
+		}
+
+		for (const auto& TileA : A)
+		{
+			const TArray<FVector>* PolysB = B.Find(TileA.Key);
+			if (PolysB == NULL || PolysB->Num() != TileA.Value.Num())
+			{
+				return false;
+			}
+
+			for (int32 PolyIdx = 0; PolyIdx < TileA.Value.Num(); PolyIdx++)
+			{
+				if (!TileA.Value[PolyIdx].Equals((*PolysB)[PolyIdx], KINDA_SMALL_NUMBER))
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	/** Reads tile and agent of every entry of the clipped geometry cache, @return false if an entry is stored twice */
+	static bool GatherClippedEntries(const FNavigationRelevantData& Data, TSet<FIntVector>& OutEntries)
+	{
+		if (Data.ClippedGeometryData.Num() == 0)
+		{
+			return true;
+		}
+
+		bool bUnique = true;
+		const uint8* Memory = Data.ClippedGeometryData.GetData();
+		const int32 NumTiles = *((const int32*)Memory);
+		const uint8* BytesArr = Memory + sizeof(int32);
+		TSet<FIntVector> ElementEntries;
+		for (int32 i = 0; i < NumTiles; i++)
+		{
+			const FRecastClippedGeometryCache::FTileInfo* TileInfo = (const FRecastClippedGeometryCache::FTileInfo*)BytesArr;
+			const FIntVector Entry(TileInfo->TileX, TileInfo->TileY, TileInfo->AgentIndex);
+			bUnique = bUnique && !ElementEntries.Contains(Entry);
+			ElementEntries.Add(Entry);
+
+			BytesArr += sizeof(FRecastClippedGeometryCache::FTileInfo) + sizeof(int32) * (TileInfo->NumVerts + TileInfo->NumFaces * 3);
+		}
+
+		OutEntries.Append(ElementEntries);
+		return bUnique;
+	}
+}
+
+/**
+ * Builds navmeshes of two agents over a floor and walls spanning several tiles with ai.NavTileGeometryClipping set to 0 and to 1,
+ * and checks that both give the same polys, and that the clipped geometry keeps one cache entry per tile and agent.
+ */
+bool FRecastTileGeometryClippingTest::RunTest(const FString& Parameters)
+{
+	using namespace RecastTileGeometryClippingTest;
+
+	FRecastNavMeshTestWorld TestWorld(FBox(FVector(-2000.f, -2000.f, -500.f), FVector(2000.f, 2000.f, 500.f)));
+
+	// floor wider than the navigation bounds and walls across tile borders
+	TestWorld.AddBox(FVector(0.f, 0.f, -50.f), FVector(2500.f, 2500.f, 50.f));
+	TestWorld.AddBox(FVector(0.f, 0.f, 150.f), FVector(700.f, 50.f, 150.f));
+	TestWorld.AddBox(FVector(1000.f, 500.f, 150.f), FVector(50.f, 900.f, 150.f));
+
+	// same tile coords on both navmeshes, different tile boxes
+	TArray<FNavDataConfig> Agents;
+	Agents.Add(FNavDataConfig(34.f, 144.f));
+	Agents.Add(FNavDataConfig(70.f, 144.f));
+	Agents[0].Name = TEXT("Small");
+	Agents[1].Name = TEXT("Large");
+	TestWorld.SetSupportedAgents(Agents);
+
+	if (TestWorld.CreateNavMesh() == NULL || TestWorld.GetNavMeshes().Num() != Agents.Num())
+	{
+		AddError(TEXT("Test world should have a navmesh for each agent"));
+		return false;
+	}
+
+	for (ARecastNavMesh* NavMesh : TestWorld.GetNavMeshes())
+	{
+		NavMesh->TileSizeUU = 1000.f;
+	}
+
+	IConsoleVariable* ClippingVar = IConsoleManager::Get().FindConsoleVariable(TEXT("ai.NavTileGeometryClipping"));
+	const int32 OldClipping = ClippingVar->GetInt();
+
+	TArray<TMap<FIntVector, TArray<FVector> > > FullTiles;
+	FullTiles.SetNum(TestWorld.GetNavMeshes().Num());
+	ClippingVar->Set(0);
+	TestTrue(TEXT("Navmeshes are built"), TestWorld.BuildNavMesh());
+	for (int32 NavMeshIdx = 0; NavMeshIdx < TestWorld.GetNavMeshes().Num(); NavMeshIdx++)
+	{
+		GatherTilePolys(TestWorld.GetNavMeshes()[NavMeshIdx], FullTiles[NavMeshIdx]);
+	}
+
+	ClippingVar->Set(1);
+	TestTrue(TEXT("Navmeshes are built with clipped geometry"), TestWorld.BuildNavMesh());
+	for (int32 NavMeshIdx = 0; NavMeshIdx < TestWorld.GetNavMeshes().Num(); NavMeshIdx++)
+	{
+		TMap<FIntVector, TArray<FVector> > ClippedTiles;
+		GatherTilePolys(TestWorld.GetNavMeshes()[NavMeshIdx], ClippedTiles);
+		TestTrue(TEXT("Navmesh has tiles"), ClippedTiles.Num() > 1);
+		TestTrue(TEXT("Clipped geometry gives the same polys"), HaveSameTiles(FullTiles[NavMeshIdx], ClippedTiles));
+	}
+
+	ClippingVar->Set(OldClipping);
+
+	// floor is clipped to each tile of each navmesh, entries of one agent must not replace the other's
+	bool bUniqueEntries = true;
+	TSet<FIntVector> ClippedEntries;
+	const FNavigationOctree* NavOctree = TestWorld.GetWorld()->GetNavigationSystem()->GetNavOctree();
+	for (FNavigationOctree::TConstElementBoxIterator<> It(*NavOctree, FBox(FVector(-2000.f, -2000.f, -500.f), FVector(2000.f, 2000.f, 500.f))); It.HasPendingElements(); It.Advance())
+	{
+		bUniqueEntries = GatherClippedEntries(It.GetCurrentElement().Data, ClippedEntries) && bUniqueEntries;
+	}
+
+	bool bHasAgentEntries[2] = { false, false };
+	for (const FIntVector& Entry : ClippedEntries)
+	{
+		if (Entry.Z >= 0 && Entry.Z < (int32)ARRAY_COUNT(bHasAgentEntries))
+		{
+			bHasAgentEntries[Entry.Z] = true;
+		}
+	}
+
+	TestTrue(TEXT("Clipped geometry keeps one entry per tile and agent"), bUniqueEntries);
+	TestTrue(TEXT("Clipped geometry is cached for both agents"), bHasAgentEntries[0] && bHasAgentEntries[1]);
+
+	return true;
+}
+
+#endif // WITH_RECAST
@@ -0,0 +1,115 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "EnginePrivate.h"
+
+#if WITH_RECAST
+
+#include "RecastNavMeshTestCommon.h"
+#include "AI/Navigation/RecastNavMesh.h"
+#include "AI/Navigation/NavMeshBoundsVolume.h"
+#include "Components/BoxComponent.h"
+#include "Components/BrushComponent.h"
+#include "PhysicsEngine/BodySetup.h"
+
+FRecastNavMeshTestWorld::FRecastNavMeshTestWorld(const FBox& NavBounds)
+	: NavMesh(NULL)
+{
+	World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	FURL URL;
+	World->InitializeActorsForPlay(URL);
+	World->BeginPlay();
+
+	// bounds of a volume without brush geometry are the ones of its brush body
+	ANavMeshBoundsVolume* BoundsVolume = World->SpawnActor<ANavMeshBoundsVolume>(ANavMeshBoundsVolume::StaticClass(), NavBounds.GetCenter(), FRotator::ZeroRotator);
+	UBrushComponent* BrushComponent = BoundsVolume->GetBrushComponent();
+	const FVector BoundsSize = NavBounds.GetSize();
+	BrushComponent->BrushBodySetup = NewObject<UBodySetup>(BrushComponent);
+	BrushComponent->BrushBodySetup->AggGeom.BoxElems.Add(FKBoxElem(BoundsSize.X, BoundsSize.Y, BoundsSize.Z));
+	BrushComponent->UpdateBounds();
+}
+
+FRecastNavMeshTestWorld::~FRecastNavMeshTestWorld()
+{
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+}
+
+void FRecastNavMeshTestWorld::AddBox(const FVector& Center, const FVector& Extent)
+{
+	AActor* Actor = World->SpawnActor<AActor>(AActor::StaticClass(), Center, FRotator::ZeroRotator);
+	UBoxComponent* Box = NewObject<UBoxComponent>(Actor);
+	Box->SetBoxExtent(Extent, false);
+	Box->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+	Box->RelativeLocation = Center;
+	Actor->SetRootComponent(Box);
+	Box->RegisterComponent();
+}
+
+ARecastNavMesh* FRecastNavMeshTestWorld::CreateNavMesh()
+{
+	if (NavMesh == NULL)
+	{
+		// navigation system takes its agents from the class defaults when created
+		UNavigationSystem* NavSysCDO = GEngine->NavigationSystemClass->GetDefaultObject<UNavigationSystem>();
+		const TArray<FNavDataConfig> DefaultAgents = NavSysCDO->SupportedAgents;
+		if (SupportedAgents.Num())
+		{
+			NavSysCDO->SupportedAgents = SupportedAgents;
+		}
+
+		UNavigationSystem::InitializeForWorld(World, FNavigationSystem::GameMode);
+		NavSysCDO->SupportedAgents = DefaultAgents;
+
+		UNavigationSystem* NavSys = World->GetNavigationSystem();
+		if (NavSys)
+		{
+			// spawns and registers the navmesh of every agent
+			NavSys->Build();
+
+			for (TActorIterator<ARecastNavMesh> It(World); It; ++It)
+			{
+				NavMeshes.Add(*It);
+			}
+		}
+
+		for (ARecastNavMesh* AgentNavMesh : NavMeshes)
+		{
+			// game world navmeshes are only built with runtime generation
+			AgentNavMesh->bRebuildAtRuntime = true;
+		}
+
+		NavMesh = NavMeshes.Num() ? NavMeshes[0] : NULL;
+	}
+
+	return NavMesh;
+}
+
+bool FRecastNavMeshTestWorld::BuildNavMesh()
+{
+	if (CreateNavMesh() == NULL)
+	{
+		return false;
+	}
+
+	// updates the octree with the boxes, rebuilds the navmesh and blocks until it's done
+	World->GetNavigationSystem()->Build();
+
+	TArray<FNavPoly> Polys;
+	for (ARecastNavMesh* AgentNavMesh : NavMeshes)
+	{
+		for (int32 TileIndex = 0; TileIndex < AgentNavMesh->GetNavMeshTilesCount(); TileIndex++)
+		{
+			if (AgentNavMesh->GetPolysInTile(TileIndex, Polys) && Polys.Num() > 0)
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+#endif // WITH_RECAST
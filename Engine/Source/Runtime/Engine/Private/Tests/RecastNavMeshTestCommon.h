@@ -0,0 +1,43 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#if WITH_RECAST
+
+class ARecastNavMesh;
+
+/**
+ * Game world with a navigation system and a Recast navmesh built over boxes added by the test, used by the navmesh automation tests.
+ * Navigation bounds come from a bounds volume without brush geometry, the world is destroyed with the object.
+ */
+class FRecastNavMeshTestWorld : public FNoncopyable
+{
+public:
+	/** Creates the world with navigation bounds NavBounds */
+	explicit FRecastNavMeshTestWorld(const FBox& NavBounds);
+	~FRecastNavMeshTestWorld();
+
+	/** Adds a box blocking everything, the floor and the walls of the test level */
+	void AddBox(const FVector& Center, const FVector& Extent);
+
+	/** Sets agents the navigation system is created with, one navmesh each. Default agents of the navigation system are used when not set */
+	void SetSupportedAgents(const TArray<FNavDataConfig>& Agents) { SupportedAgents = Agents; }
+
+	/** Creates the navigation system and the navmeshes without building tiles, their properties can be changed before BuildNavMesh. @return navmesh of the first agent */
+	ARecastNavMesh* CreateNavMesh();
+
+	/** Rebuilds every tile of the navmeshes over the boxes added so far and waits for the build. @return false if no tile was built */
+	bool BuildNavMesh();
+
+	UWorld* GetWorld() const { return World; }
+	ARecastNavMesh* GetNavMesh() const { return NavMesh; }
+	const TArray<ARecastNavMesh*>& GetNavMeshes() const { return NavMeshes; }
+
+private:
+	UWorld* World;
+	ARecastNavMesh* NavMesh;
+	TArray<ARecastNavMesh*> NavMeshes;
+	TArray<FNavDataConfig> SupportedAgents;
+};
+
+#endif // WITH_RECAST
@@ -0,0 +1,456 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "EnginePrivate.h"
+
+#if WITH_RECAST
+
+#include "AI/Navigation/RecastNavMesh.h"
+#include "RecastNavMeshTestCommon.h"
+#if WITH_EDITOR
+#include "TargetPlatform.h"
+#endif // WITH_EDITOR
+
+namespace RecastNavMeshTest
+{
+	static const FVector ProjectExtent(50.f, 50.f, 250.f);
+
+	/**
+	 * Level of the path tests: a floor split by a wall with a gap at one end, and a walled-in square on one side of it.
+	 * Tiles are small enough for paths to cross many clusters.
+	 */
+	static ARecastNavMesh* BuildWallLevel(FRecastNavMeshTestWorld& TestWorld, FBox& OutWall)
+	{
+		TestWorld.AddBox(FVector(0.f, 0.f, -50.f), FVector(2000.f, 2000.f, 50.f));
+
+		const FVector WallCenter(0.f, -400.f, 150.f);
+		const FVector WallExtent(50.f, 1600.f, 150.f);
+		TestWorld.AddBox(WallCenter, WallExtent);
+		OutWall = FBox(WallCenter - WallExtent, WallCenter + WallExtent);
+
+		const FVector Enclosure(1200.f, -200.f, 150.f);
+		TestWorld.AddBox(Enclosure + FVector(0.f, -300.f, 0.f), FVector(350.f, 50.f, 150.f));
+		TestWorld.AddBox(Enclosure + FVector(0.f, 300.f, 0.f), FVector(350.f, 50.f, 150.f));
+		TestWorld.AddBox(Enclosure + FVector(-300.f, 0.f, 0.f), FVector(50.f, 350.f, 150.f));
+		TestWorld.AddBox(Enclosure + FVector(300.f, 0.f, 0.f), FVector(50.f, 350.f, 150.f));
+
+		ARecastNavMesh* NavMesh = TestWorld.CreateNavMesh();
+		if (NavMesh)
+		{
+			NavMesh->TileSizeUU = 1000.f;
+		}
+
+		return NavMesh && TestWorld.BuildNavMesh() ? NavMesh : NULL;
+	}
+
+	static FPathFindingResult FindPath(ARecastNavMesh* NavMesh, const FVector& Start, const FVector& End, TSharedPtr<const FNavigationQueryFilter> Filter, bool bHierarchical)
+	{
+		const FPathFindingQuery Query(NULL, NavMesh, Start, End, Filter);
+		return bHierarchical ? ARecastNavMesh::FindHierarchicalPath(FNavAgentProperties::DefaultProperties, Query)
+			: ARecastNavMesh::FindPath(FNavAgentProperties::DefaultProperties, Query);
+	}
+
+	static bool HaveSamePoints(const FPathFindingResult& A, const FPathFindingResult& B)
+	{
+		if (!A.Path.IsValid() || !B.Path.IsValid() || A.Path->GetPathPoints().Num() != B.Path->GetPathPoints().Num())
+		{
+			return false;
+		}
+
+		for (int32 PointIdx = 0; PointIdx < A.Path->GetPathPoints().Num(); PointIdx++)
+		{
+			if (!A.Path->GetPathPoints()[PointIdx].Location.Equals(B.Path->GetPathPoints()[PointIdx].Location, KINDA_SMALL_NUMBER))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/** Level of the tile streaming tests: a floor over a row of tiles, too long to keep all of them attached around a pawn */
+	static ARecastNavMesh* BuildStreamingLevel(FRecastNavMeshTestWorld& TestWorld)
+	{
+		TestWorld.AddBox(FVector(0.f, 0.f, -50.f), FVector(4000.f, 1000.f, 50.f));
+
+		ARecastNavMesh* NavMesh = TestWorld.CreateNavMesh();
+		if (NavMesh)
+		{
+			NavMesh->TileSizeUU = 1000.f;
+			NavMesh->bStreamTiles = true;
+			NavMesh->TileStreamingRadius = 1000.f;
+			NavMesh->TileStreamingMemoryBudgetKB = 0;
+			NavMesh->MaxTilesStreamedInPerUpdate = 2;
+		}
+
+		return NavMesh && TestWorld.BuildNavMesh() ? NavMesh : NULL;
+	}
+
+	struct FTestTile
+	{
+		FBox Bounds;
+		TArray<FVector> PolyCenters;
+	};
+
+	/** Gathers every attached tile with polys, per tile coords and layer */
+	static void GatherAttachedTiles(const ARecastNavMesh* NavMesh, TMap<FIntVector, FTestTile>& OutTiles)
+	{
+		OutTiles.Empty();
+
+		TArray<FNavPoly> Polys;
+		for (int32 TileIndex = 0; TileIndex < NavMesh->GetNavMeshTilesCount(); TileIndex++)
+		{
+			int32 TileX = 0, TileY = 0, Layer = 0;
+			Polys.Reset();
+			if (NavMesh->GetPolysInTile(TileIndex, Polys) && NavMesh->GetNavMeshTileXY(TileIndex, TileX, TileY, Layer))
+			{
+				FTestTile& Tile = OutTiles.Add(FIntVector(TileX, TileY, Layer));
+				Tile.Bounds = NavMesh->GetNavMeshTileBounds(TileIndex);
+				for (const FNavPoly& Poly : Polys)
+				{
+					Tile.PolyCenters.Add(Poly.Center);
+				}
+			}
+		}
+	}
+
+	static bool HaveSamePolys(const FTestTile& A, const FTestTile& B)
+	{
+		if (A.PolyCenters.Num() != B.PolyCenters.Num())
+		{
+			return false;
+		}
+
+		for (int32 PolyIdx = 0; PolyIdx < A.PolyCenters.Num(); PolyIdx++)
+		{
+			if (!A.PolyCenters[PolyIdx].Equals(B.PolyCenters[PolyIdx], KINDA_SMALL_NUMBER))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/** @return true if attached tiles are exactly the tiles of AllTiles within Radius (2D) from Location, with the same polys */
+	static bool HasTilesAround(const ARecastNavMesh* NavMesh, const TMap<FIntVector, FTestTile>& AllTiles, const FVector& Location, float Radius)
+	{
+		TMap<FIntVector, FTestTile> AttachedTiles;
+		GatherAttachedTiles(NavMesh, AttachedTiles);
+
+		int32 NumTilesAround = 0;
+		for (TMap<FIntVector, FTestTile>::TConstIterator It(AllTiles); It; ++It)
+		{
+			const FVector Location2D(Location.X, Location.Y, It.Value().Bounds.GetCenter().Z);
+			if (It.Value().Bounds.ComputeSquaredDistanceToPoint(Location2D) > FMath::Square(Radius))
+			{
+				continue;
+			}
+
+			NumTilesAround++;
+			const FTestTile* AttachedTile = AttachedTiles.Find(It.Key());
+			if (AttachedTile == NULL || !HaveSamePolys(*AttachedTile, It.Value()))
+			{
+				return false;
+			}
+		}
+
+		return NumTilesAround > 0 && NumTilesAround == AttachedTiles.Num();
+	}
+
+	/** Pawn with only a root component, the streaming source of the tests */
+	static APawn* SpawnStreamingPawn(UWorld* World, const FVector& Location)
+	{
+		APawn* Pawn = World->SpawnActor<APawn>(APawn::StaticClass(), Location, FRotator::ZeroRotator);
+		USceneComponent* Root = NewObject<USceneComponent>(Pawn);
+		Root->RelativeLocation = Location;
+		Pawn->SetRootComponent(Root);
+		Root->RegisterComponent();
+		return Pawn;
+	}
+
+#if WITH_EDITOR
+	/** Writes an object the way it's cooked for the running platform */
+	class FCookedObjectWriter : public FObjectWriter
+	{
+	public:
+		FCookedObjectWriter(UObject* Obj, TArray<uint8>& InBytes)
+			: FObjectWriter(InBytes)
+		{
+			SetCookingTarget(GetTargetPlatformManagerRef().GetRunningTargetPlatform());
+			Obj->Serialize(*this);
+		}
+	};
+#endif // WITH_EDITOR
+
+	/** Counts finished async pathfinding requests */
+	struct FAsyncPathCounter
+	{
+		int32 NumFinished;
+
+		FAsyncPathCounter() : NumFinished(0) {}
+
+		void OnPathFound(uint32 QueryID, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path)
+		{
+			NumFinished++;
+		}
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRecastClusterPathTest, "Engine.AI.Navigation.Cluster Graph Paths", EAutomationTestFlags::ATF_Editor)
+
+/**
+ * Finds hierarchical paths (FPImplRecastNavMesh::FindPath with the cluster graph) around a wall and checks that they are valid,
+ * and that when the cluster search or the search in its corridor can't reach the goal, the result is the one of the full search.
+ */
+bool FRecastClusterPathTest::RunTest(const FString& Parameters)
+{
+	using namespace RecastNavMeshTest;
+
+	FRecastNavMeshTestWorld TestWorld(FBox(FVector(-2000.f, -2000.f, -100.f), FVector(2000.f, 2000.f, 400.f)));
+	FBox Wall;
+	ARecastNavMesh* NavMesh = BuildWallLevel(TestWorld, Wall);
+	if (NavMesh == NULL)
+	{
+		AddError(TEXT("Navmesh wasn't built"));
+		return false;
+	}
+
+	TSharedPtr<const FNavigationQueryFilter> Filter = NavMesh->GetDefaultQueryFilter();
+	FNavLocation Start, Goal, Enclosed;
+	const bool bProjected = NavMesh->ProjectPoint(FVector(-1500.f, -1500.f, 0.f), Start, ProjectExtent)
+		&& NavMesh->ProjectPoint(FVector(1500.f, -1500.f, 0.f), Goal, ProjectExtent)
+		&& NavMesh->ProjectPoint(FVector(1200.f, -200.f, 0.f), Enclosed, ProjectExtent);
+	if (!bProjected)
+	{
+		AddError(TEXT("Test locations aren't on the navmesh"));
+		return false;
+	}
+
+	TestTrue(TEXT("Start and goal are in different clusters"), NavMesh->GetClusterRef(Start.NodeRef) != 0 && NavMesh->GetClusterRef(Goal.NodeRef) != 0
+		&& NavMesh->GetClusterRef(Start.NodeRef) != NavMesh->GetClusterRef(Goal.NodeRef));
+
+	// reachable goal, the path has to go around the wall through the gap
+	const FPathFindingResult Regular = FindPath(NavMesh, Start.Location, Goal.Location, Filter, false);
+	const FPathFindingResult Hierarchical = FindPath(NavMesh, Start.Location, Goal.Location, Filter, true);
+	TestTrue(TEXT("Regular path is found"), Regular.IsSuccessful() && !Regular.Path->IsPartial());
+	TestTrue(TEXT("Hierarchical path is found"), Hierarchical.IsSuccessful() && !Hierarchical.Path->IsPartial());
+	if (Regular.IsSuccessful() && Hierarchical.IsSuccessful())
+	{
+		const TArray<FNavPathPoint>& Points = Hierarchical.Path->GetPathPoints();
+		TestTrue(TEXT("Hierarchical path starts at the start"), Points.Num() >= 2 && Points[0].Location.Equals(Start.Location, 1.f));
+		TestTrue(TEXT("Hierarchical path ends at the goal"), Points.Num() >= 2 && Points.Last().Location.Equals(Goal.Location, 1.f));
+
+		// the wall reaches from the floor up, only its footprint matters
+		const FBox WallFootprint(FVector(Wall.Min.X, Wall.Min.Y, -HALF_WORLD_MAX), FVector(Wall.Max.X, Wall.Max.Y, HALF_WORLD_MAX));
+		bool bCrossesWall = false;
+		for (int32 PointIdx = 1; PointIdx < Points.Num(); PointIdx++)
+		{
+			const FVector Segment = Points[PointIdx].Location - Points[PointIdx - 1].Location;
+			bCrossesWall = bCrossesWall || FMath::LineBoxIntersection(WallFootprint, Points[PointIdx - 1].Location, Points[PointIdx].Location, Segment);
+		}
+		TestFalse(TEXT("Hierarchical path doesn't cross the wall"), bCrossesWall);
+
+		TestTrue(TEXT("Hierarchical path is close to the regular one"), Hierarchical.Path->GetLength() <= Regular.Path->GetLength() * 1.5f);
+	}
+
+	// walled-in goal, the cluster search can't reach it and the full search gives the partial path
+	const FPathFindingResult RegularToEnclosed = FindPath(NavMesh, Start.Location, Enclosed.Location, Filter, false);
+	const FPathFindingResult HierarchicalToEnclosed = FindPath(NavMesh, Start.Location, Enclosed.Location, Filter, true);
+	TestTrue(TEXT("Regular path to the enclosure is partial"), RegularToEnclosed.IsPartial());
+	TestTrue(TEXT("Hierarchical path to the enclosure is partial"), HierarchicalToEnclosed.IsPartial());
+	TestTrue(TEXT("Hierarchical path to the enclosure falls back to the full search"), HaveSamePoints(RegularToEnclosed, HierarchicalToEnclosed));
+
+	// search node limit too low for the goal, the cluster or corridor search is partial and the full search gives the partial path
+	TSharedPtr<FNavigationQueryFilter> SmallFilter = Filter->GetCopy();
+	SmallFilter->SetMaxSearchNodes(8);
+	const FPathFindingResult RegularLimited = FindPath(NavMesh, Start.Location, Goal.Location, SmallFilter, false);
+	const FPathFindingResult HierarchicalLimited = FindPath(NavMesh, Start.Location, Goal.Location, SmallFilter, true);
+	TestTrue(TEXT("Hierarchical path with few search nodes is partial"), HierarchicalLimited.IsPartial());
+	TestTrue(TEXT("Hierarchical path with few search nodes falls back to the full search"), HaveSamePoints(RegularLimited, HierarchicalLimited));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRecastTileStreamingTest, "Engine.AI.Navigation.Tile Streaming", EAutomationTestFlags::ATF_Editor)
+
+/**
+ * Saves a static navmesh streaming its tiles, uncooked and cooked, and loads it back. Checks that begin play attaches all tiles
+ * around the pawn at once, and that when the pawn moves away while async paths are being found, its tiles get detached
+ * and the new ones attached over a few updates, with the polys they were built with.
+ */
+bool FRecastTileStreamingTest::RunTest(const FString& Parameters)
+{
+	using namespace RecastNavMeshTest;
+
+	const FVector FirstLocation(-3500.f, 0.f, 100.f);
+	const FVector SecondLocation(3500.f, 0.f, 100.f);
+
+	// cooking needs the target platforms of the editor
+	const int32 NumPasses = WITH_EDITOR ? 2 : 1;
+	for (int32 Pass = 0; Pass < NumPasses; Pass++)
+	{
+		const bool bCooked = (Pass == 1);
+		const TCHAR* PassName = bCooked ? TEXT("cooked") : TEXT("uncooked");
+
+		FRecastNavMeshTestWorld TestWorld(FBox(FVector(-4100.f, -1100.f, -100.f), FVector(4100.f, 1100.f, 400.f)));
+		ARecastNavMesh* NavMesh = BuildStreamingLevel(TestWorld);
+		if (NavMesh == NULL)
+		{
+			AddError(TEXT("Navmesh wasn't built"));
+			return false;
+		}
+
+		TMap<FIntVector, FTestTile> AllTiles;
+		GatherAttachedTiles(NavMesh, AllTiles);
+
+		// static from now on, loaded tiles are streamed
+		NavMesh->bRebuildAtRuntime = false;
+		TArray<uint8> Bytes;
+#if WITH_EDITOR
+		if (bCooked)
+		{
+			FCookedObjectWriter Writer(NavMesh, Bytes);
+		}
+		else
+#endif // WITH_EDITOR
+		{
+			FObjectWriter Writer(NavMesh, Bytes);
+		}
+		FObjectReader Reader(NavMesh, Bytes);
+
+		TMap<FIntVector, FTestTile> LoadedTiles;
+		GatherAttachedTiles(NavMesh, LoadedTiles);
+		if (bCooked)
+		{
+			TestEqual(TEXT("Cooked tiles are loaded detached"), LoadedTiles.Num(), 0);
+		}
+		else
+		{
+			TestEqual(FString::Printf(TEXT("All %s tiles are loaded attached"), PassName), LoadedTiles.Num(), AllTiles.Num());
+		}
+
+		APawn* Pawn = SpawnStreamingPawn(TestWorld.GetWorld(), FirstLocation);
+		NavMesh->BeginPlay();
+		TestTrue(FString::Printf(TEXT("Begin play attaches all %s tiles around the pawn"), PassName), HasTilesAround(NavMesh, AllTiles, FirstLocation, NavMesh->TileStreamingRadius));
+
+		// paths being found on worker threads while the tiles they're on get detached
+		UNavigationSystem* NavSys = TestWorld.GetWorld()->GetNavigationSystem();
+		FNavLocation PathStart, PathEnd;
+		FAsyncPathCounter PathCounter;
+		const int32 NumPaths = 32;
+		if (NavMesh->ProjectPoint(FirstLocation + FVector(-300.f, -300.f, -100.f), PathStart, ProjectExtent)
+			&& NavMesh->ProjectPoint(FirstLocation + FVector(300.f, 300.f, -100.f), PathEnd, ProjectExtent))
+		{
+			for (int32 PathIdx = 0; PathIdx < NumPaths; PathIdx++)
+			{
+				const FPathFindingQuery Query(NULL, NavMesh, PathStart.Location, PathEnd.Location, NavMesh->GetDefaultQueryFilter());
+				NavSys->FindPathAsync(FNavAgentProperties::DefaultProperties, Query, FNavPathQueryDelegate::CreateRaw(&PathCounter, &FAsyncPathCounter::OnPathFound));
+			}
+		}
+		else
+		{
+			AddError(TEXT("Path locations aren't on the navmesh"));
+		}
+
+		// dispatches the paths without a streaming update
+		NavSys->Tick(KINDA_SMALL_NUMBER);
+
+		Pawn->SetActorLocation(SecondLocation);
+		NavSys->Tick(NavMesh->TileSetUpdateInterval);
+
+		TMap<FIntVector, FTestTile> AttachedTiles;
+		GatherAttachedTiles(NavMesh, AttachedTiles);
+		TestTrue(FString::Printf(TEXT("Single update attaches at most MaxTilesStreamedInPerUpdate %s tiles"), PassName), AttachedTiles.Num() > 0 && AttachedTiles.Num() <= NavMesh->MaxTilesStreamedInPerUpdate);
+
+		for (int32 UpdateIdx = 0; UpdateIdx < AllTiles.Num(); UpdateIdx++)
+		{
+			NavSys->Tick(NavMesh->TileSetUpdateInterval);
+		}
+		TestTrue(FString::Printf(TEXT("Tiles around the moved pawn replace the %s ones around its previous location"), PassName), HasTilesAround(NavMesh, AllTiles, SecondLocation, NavMesh->TileStreamingRadius));
+
+		// results are passed on by a game thread task
+		FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+		TestEqual(TEXT("Async paths being found during the update finish"), PathCounter.NumFinished, NumPaths);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRecastParallelLayersTest, "Engine.AI.Navigation.Parallel Tile Layers", EAutomationTestFlags::ATF_Editor)
+
+/**
+ * Rebuilds tiles with two layers under a platform the way dirty areas are rebuilt in game, first building layers one after another
+ * and adding all tiles right away, then building layers on task graph workers (FRecastTileLayerTask) and adding tiles in time slices.
+ * Both rebuilds have to give the same tiles.
+ */
+bool FRecastParallelLayersTest::RunTest(const FString& Parameters)
+{
+	using namespace RecastNavMeshTest;
+
+	const FBox NavBounds(FVector(-2000.f, -2000.f, -100.f), FVector(2000.f, 2000.f, 600.f));
+	FRecastNavMeshTestWorld TestWorld(NavBounds);
+	TestWorld.AddBox(FVector(0.f, 0.f, -50.f), FVector(2000.f, 2000.f, 50.f));
+	// high enough for agents to walk under it
+	TestWorld.AddBox(FVector(0.f, 0.f, 320.f), FVector(800.f, 800.f, 20.f));
+
+	ARecastNavMesh* NavMesh = TestWorld.CreateNavMesh();
+	if (NavMesh)
+	{
+		NavMesh->TileSizeUU = 1000.f;
+	}
+	if (NavMesh == NULL || !TestWorld.BuildNavMesh())
+	{
+		AddError(TEXT("Navmesh wasn't built"));
+		return false;
+	}
+
+	IConsoleVariable* ParallelLayersVar = IConsoleManager::Get().FindConsoleVariable(TEXT("ai.NavTileParallelLayers"));
+	IConsoleVariable* AttachBudgetVar = IConsoleManager::Get().FindConsoleVariable(TEXT("ai.NavTileAttachBudgetMs"));
+	const int32 OldParallelLayers = ParallelLayersVar->GetInt();
+	const float OldAttachBudget = AttachBudgetVar->GetFloat();
+
+	UNavigationSystem* NavSys = TestWorld.GetWorld()->GetNavigationSystem();
+	TMap<FIntVector, FTestTile> PassTiles[2];
+	for (int32 Pass = 0; Pass < 2; Pass++)
+	{
+		const bool bParallel = (Pass == 1);
+		ParallelLayersVar->Set(bParallel ? 1 : 0);
+		AttachBudgetVar->Set(bParallel ? 0.001f : 0.f);
+
+		NavSys->AddDirtyArea(NavBounds, ENavigationDirtyFlag::All);
+
+		int32 NumTicks = 0;
+		const int32 MaxTicks = 1000;
+		do
+		{
+			NavSys->Tick(1.f);
+			NumTicks++;
+		}
+		while (NavSys->IsNavigationBuildInProgress() && NumTicks < MaxTicks);
+
+		TestFalse(bParallel ? TEXT("Parallel rebuild finishes") : TEXT("Serial rebuild finishes"), NavSys->IsNavigationBuildInProgress());
+		GatherAttachedTiles(NavMesh, PassTiles[Pass]);
+	}
+
+	ParallelLayersVar->Set(OldParallelLayers);
+	AttachBudgetVar->Set(OldAttachBudget);
+
+	bool bHasLayers = false;
+	for (TMap<FIntVector, FTestTile>::TConstIterator It(PassTiles[0]); It; ++It)
+	{
+		bHasLayers = bHasLayers || It.Key().Z > 0;
+	}
+	TestTrue(TEXT("Tiles under the platform have more than one layer"), bHasLayers);
+
+	bool bSameTiles = PassTiles[0].Num() > 0 && PassTiles[0].Num() == PassTiles[1].Num();
+	for (TMap<FIntVector, FTestTile>::TConstIterator It(PassTiles[0]); It && bSameTiles; ++It)
+	{
+		const FTestTile* ParallelTile = PassTiles[1].Find(It.Key());
+		bSameTiles = ParallelTile != NULL && HaveSamePolys(*ParallelTile, It.Value());
+	}
+	TestTrue(TEXT("Parallel layers build the same tiles as serial ones"), bSameTiles);
+
+	return true;
+}
+
+#endif // WITH_RECAST
@@ -0,0 +1,195 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "EnginePrivate.h"
+#include "SceneComponentTransformStore.h"
+#include "Components/BrushComponent.h"
+#include "Tests/SocketTestComponent.h"
+
+const FName USocketTestComponent::SocketName(TEXT("TestSocket"));
+
+USocketTestComponent::USocketTestComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+	, SocketRelativeTransform(FRotator(0.f, 45.f, 0.f), FVector(20.f, 0.f, 10.f))
+{
+}
+
+FTransform USocketTestComponent::GetSocketTransform(FName InSocketName, ERelativeTransformSpace TransformSpace) const
+{
+	if (InSocketName == SocketName)
+	{
+		switch (TransformSpace)
+		{
+			case RTS_World:
+				return SocketRelativeTransform * ComponentToWorld;
+			case RTS_Actor:
+				if (const AActor* Actor = GetOwner())
+				{
+					return (SocketRelativeTransform * ComponentToWorld).GetRelativeTransform(Actor->GetTransform());
+				}
+				break;
+			case RTS_Component:
+				return SocketRelativeTransform;
+		}
+	}
+	return Super::GetSocketTransform(InSocketName, TransformSpace);
+}
+
+bool USocketTestComponent::DoesSocketExist(FName InSocketName) const
+{
+	return InSocketName == SocketName;
+}
+
+bool USocketTestComponent::HasAnySockets() const
+{
+	return true;
+}
+
+void USocketTestComponent::QuerySupportedSockets(TArray<FComponentSocketDescription>& OutSockets) const
+{
+	new (OutSockets) FComponentSocketDescription(SocketName, EComponentSocketType::Socket);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSceneComponentTransformStoreTest, "Engine.Scene.Component Transform Store", EAutomationTestFlags::ATF_Editor)
+
+namespace SceneComponentTransformStoreTest
+{
+	/** Creates, attaches and registers a component of Actor with the given relative transform */
+	template<typename ComponentType>
+	ComponentType* AddComponent(AActor* Actor, USceneComponent* Parent, const FTransform& RelativeTransform, FName SocketName = NAME_None)
+	{
+		ComponentType* Component = NewObject<ComponentType>(Actor);
+		Component->RelativeLocation = RelativeTransform.GetTranslation();
+		Component->RelativeRotation = RelativeTransform.Rotator();
+		Component->RelativeScale3D = RelativeTransform.GetScale3D();
+		if (Parent)
+		{
+			Component->AttachTo(Parent, SocketName);
+		}
+		else
+		{
+			Actor->SetRootComponent(Component);
+		}
+		Component->RegisterComponent();
+		return Component;
+	}
+
+	/** The components of a test hierarchy, in creation order */
+	struct FTestHierarchy
+	{
+		TArray<USceneComponent*> Components;
+		USceneComponent* Mid;
+		USocketTestComponent* SocketParent;
+		UBrushComponent* Brush;
+	};
+
+	/**
+	 * Builds the same nested hierarchy on Actor every time:
+	 * a root with a relative chain mixing absolute location, rotation and scale, a parent with a socket that has a child on
+	 * the socket and one off it (each with a child of its own), and a brush whose pivot moves its ComponentToWorld.
+	 */
+	void BuildHierarchy(AActor* Actor, FTestHierarchy& Out)
+	{
+		USceneComponent* Root = AddComponent<USceneComponent>(Actor, NULL, FTransform::Identity);
+
+		Out.Mid = AddComponent<USceneComponent>(Actor, Root, FTransform(FRotator(10.f, 30.f, 0.f), FVector(100.f, 0.f, 0.f), FVector(2.f)));
+		USceneComponent* Leaf = AddComponent<USceneComponent>(Actor, Out.Mid, FTransform(FRotator(0.f, -15.f, 5.f), FVector(0.f, 50.f, 0.f)));
+
+		USceneComponent* AbsoluteRotation = NewObject<USceneComponent>(Actor);
+		AbsoluteRotation->SetAbsolute(false, true, false);
+		AbsoluteRotation->RelativeLocation = FVector(10.f, 10.f, 0.f);
+		AbsoluteRotation->RelativeRotation = FRotator(0.f, 90.f, 0.f);
+		AbsoluteRotation->AttachTo(Leaf);
+		AbsoluteRotation->RegisterComponent();
+
+		USceneComponent* AbsoluteLocationScale = NewObject<USceneComponent>(Actor);
+		AbsoluteLocationScale->SetAbsolute(true, false, true);
+		AbsoluteLocationScale->RelativeLocation = FVector(-300.f, 0.f, 40.f);
+		AbsoluteLocationScale->RelativeScale3D = FVector(0.5f);
+		AbsoluteLocationScale->AttachTo(Out.Mid);
+		AbsoluteLocationScale->RegisterComponent();
+
+		USceneComponent* UnderAbsolute = AddComponent<USceneComponent>(Actor, AbsoluteLocationScale, FTransform(FVector(0.f, 0.f, 25.f)));
+
+		Out.SocketParent = AddComponent<USocketTestComponent>(Actor, Root, FTransform(FRotator(0.f, 0.f, 20.f), FVector(0.f, -80.f, 0.f)));
+		USceneComponent* OnSocket = AddComponent<USceneComponent>(Actor, Out.SocketParent, FTransform(FVector(5.f, 0.f, 0.f)), USocketTestComponent::SocketName);
+		USceneComponent* OffSocket = AddComponent<USceneComponent>(Actor, Out.SocketParent, FTransform(FRotator(0.f, 60.f, 0.f), FVector(0.f, 30.f, 0.f)));
+		USceneComponent* UnderOnSocket = AddComponent<USceneComponent>(Actor, OnSocket, FTransform(FVector(0.f, 0.f, 15.f)));
+		USceneComponent* UnderOffSocket = AddComponent<USceneComponent>(Actor, OffSocket, FTransform(FVector(0.f, 0.f, 15.f)));
+
+		Out.Brush = NewObject<UBrushComponent>(Actor);
+		Out.Brush->PrePivot = FVector(32.f, -16.f, 8.f);
+		Out.Brush->RelativeLocation = FVector(0.f, 0.f, 200.f);
+		Out.Brush->AttachTo(Root);
+		Out.Brush->RegisterComponent();
+		USceneComponent* UnderBrush = AddComponent<USceneComponent>(Actor, Out.Brush, FTransform(FVector(0.f, 0.f, 10.f)));
+
+		USceneComponent* Components[] = { Root, Out.Mid, Leaf, AbsoluteRotation, AbsoluteLocationScale, UnderAbsolute, Out.SocketParent, OnSocket, OffSocket, UnderOnSocket, UnderOffSocket, Out.Brush, UnderBrush };
+		Out.Components.Append(Components, ARRAY_COUNT(Components));
+	}
+}
+
+/**
+ * Builds two identical nested hierarchies, moves one with the recursive UpdateComponentToWorld walk and the other through the world's
+ * transform store (SceneComponent.TransformStore), and checks that every component ends up with the same ComponentToWorld.
+ */
+bool FSceneComponentTransformStoreTest::RunTest(const FString& Parameters)
+{
+	using namespace SceneComponentTransformStoreTest;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	FURL URL;
+	World->InitializeActorsForPlay(URL);
+	World->BeginPlay();
+
+	IConsoleVariable* TransformStoreVar = IConsoleManager::Get().FindConsoleVariable(TEXT("SceneComponent.TransformStore"));
+	const int32 OldTransformStore = TransformStoreVar->GetInt();
+
+	AActor* RecursiveActor = World->SpawnActor<AActor>(AActor::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator);
+	AActor* BatchedActor = World->SpawnActor<AActor>(AActor::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator);
+
+	FTestHierarchy Recursive;
+	FTestHierarchy Batched;
+	TransformStoreVar->Set(0);
+	BuildHierarchy(RecursiveActor, Recursive);
+	BuildHierarchy(BatchedActor, Batched);
+
+	TestFalse(TEXT("Plain scene components use the default ComponentToWorld"), Batched.Mid->AdjustsComponentToWorld());
+	TestTrue(TEXT("Brushes adjust their ComponentToWorld"), Batched.Brush->AdjustsComponentToWorld());
+
+	// Moves the root, a component in the middle of the hierarchy and the parent with the socket, then compares the hierarchies
+	const FTransform RootMoves[] = { FTransform(FRotator(0.f, 45.f, 0.f), FVector(100.f, 200.f, 0.f)), FTransform(FRotator(30.f, -20.f, 10.f), FVector(-50.f, 0.f, 300.f), FVector(1.5f)) };
+	for (int32 MoveIdx = 0; MoveIdx < ARRAY_COUNT(RootMoves); ++MoveIdx)
+	{
+		const FRotator MidRotation(0.f, 30.f + 25.f * (MoveIdx + 1), 0.f);
+		const FVector SocketParentLocation(0.f, -80.f, 10.f * (MoveIdx + 1));
+
+		TransformStoreVar->Set(0);
+		RecursiveActor->SetActorTransform(RootMoves[MoveIdx]);
+		Recursive.Mid->SetRelativeRotation(MidRotation);
+		Recursive.SocketParent->SetRelativeLocation(SocketParentLocation);
+
+		TransformStoreVar->Set(1);
+		BatchedActor->SetActorTransform(RootMoves[MoveIdx]);
+		Batched.Mid->SetRelativeRotation(MidRotation);
+		Batched.SocketParent->SetRelativeLocation(SocketParentLocation);
+
+		for (int32 CompIdx = 0; CompIdx < Batched.Components.Num(); ++CompIdx)
+		{
+			const FTransform& Expected = Recursive.Components[CompIdx]->ComponentToWorld;
+			const FTransform& Actual = Batched.Components[CompIdx]->ComponentToWorld;
+			TestTrue(FString::Printf(TEXT("Move %d: %s matches the recursive update"), MoveIdx, *Batched.Components[CompIdx]->GetName()), Actual.Equals(Expected, KINDA_SMALL_NUMBER));
+		}
+	}
+
+	TestTrue(TEXT("Batched moves went through the transform store"), World->GetSceneComponentTransformStore()->GetNumComponents() > 0);
+
+	TransformStoreVar->Set(OldTransformStore);
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	return true;
+}
@@ -0,0 +1,84 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "EnginePrivate.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FParallelTicksTest, "Engine.Tick.Parallel Ticks", EAutomationTestFlags::ATF_Editor)
+
+namespace ParallelTicksTest
+{
+	/** Tick function that only records where it ran */
+	struct FRecordingTickFunction : public FTickFunction
+	{
+		int32 NumTicks;
+		bool bTickedOnGameThread;
+
+		FRecordingTickFunction()
+			: NumTicks(0)
+			, bTickedOnGameThread(false)
+		{
+			bCanEverTick = true;
+			bRunOnAnyThread = true;
+			TickGroup = TG_PrePhysics;
+		}
+
+		virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override
+		{
+			NumTicks++;
+			bTickedOnGameThread = IsInGameThread();
+		}
+
+		virtual FString DiagnosticMessage() override
+		{
+			return TEXT("ParallelTicksTest::FRecordingTickFunction");
+		}
+	};
+}
+
+/**
+ * Ticks a world with a tick function marked bRunOnAnyThread, and checks that tick.ParallelTicks 1 runs it on a worker thread,
+ * while the validation mode runs it on the game thread.
+ */
+bool FParallelTicksTest::RunTest(const FString& Parameters)
+{
+	using namespace ParallelTicksTest;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	FURL URL;
+	World->InitializeActorsForPlay(URL);
+	World->BeginPlay();
+
+	IConsoleVariable* ParallelTicksVar = IConsoleManager::Get().FindConsoleVariable(TEXT("tick.ParallelTicks"));
+	const int32 OldParallelTicks = ParallelTicksVar->GetInt();
+
+	FRecordingTickFunction TickFunction;
+	TickFunction.RegisterTickFunction(World->PersistentLevel);
+
+	// The game thread waits for the whole tick group, so the worker's results are visible after the tick
+	ParallelTicksVar->Set(1);
+	World->Tick(LEVELTICK_All, 1.f / 30.f);
+	GFrameCounter++;
+
+	TestEqual(TEXT("Parallel tick ran once"), TickFunction.NumTicks, 1);
+	if (FTaskGraphInterface::Get().GetNumWorkerThreads() > 0)
+	{
+		TestFalse(TEXT("Parallel tick ran on a worker thread"), TickFunction.bTickedOnGameThread);
+	}
+
+	ParallelTicksVar->Set(2);
+	World->Tick(LEVELTICK_All, 1.f / 30.f);
+	GFrameCounter++;
+
+	TestEqual(TEXT("Validated tick ran once"), TickFunction.NumTicks, 2);
+	TestTrue(TEXT("Validated tick ran on the game thread"), TickFunction.bTickedOnGameThread);
+
+	TickFunction.UnRegisterTickFunction();
+	ParallelTicksVar->Set(OldParallelTicks);
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	return true;
+}
@@ -24,6 +24,21 @@ static TAutoConsoleVariable<int32> CVarAllowAsyncComponentTicks(
 	0,
 	TEXT("Used to control async component ticks."));
 
+/**
+ * No engine tick function is marked bRunOnAnyThread; none of the candidates only modify their own actor:
+ *  - character movement moves its updated component, which dispatches overlap events to other actors, moves based actors and reports to the shared avoidance manager
+ *  - skeletal mesh ticks run the anim instance's script, and the script VM is game thread only
+ *  - particle system components already do their simulation in their own async task (see UParticleSystemComponent::TickComponent)
+ * Game tick functions that qualify under tick.ParallelTicks 2 can opt in.
+ */
+static TAutoConsoleVariable<int32> CVarParallelTicks(
+	TEXT("tick.ParallelTicks"),
+	0,
+	TEXT("Controls tick functions that are marked bRunOnAnyThread, which must only modify their own actor.\n")
+	TEXT(" 0: run them as AllowAsyncComponentTicks says, never in single threaded mode (dedicated servers, less than 3 cores)\n")
+	TEXT(" 1: run them on worker threads in parallel with the rest of their tick group, also on dedicated servers\n")
+	TEXT(" 2: validate them; run them on the game thread and report every modification of another actor or the world they make"));
+
 struct FTickContext
 {
 	/** Delta time to tick **/
@@ -73,6 +88,9 @@ class FTickTaskSequencer
 	/** If true, allow concurrent ticks **/
 	bool				bAllowConcurrentTicks; 
 
+	/** If true, tick functions that may run on any thread are validated on the game thread instead **/
+	bool				bValidateParallelTicks; 
+
 	/** If true, log each tick **/
 	bool				bLogTicks; 
 
@@ -118,7 +136,8 @@ public:
 		{
 			UseContext.Thread = ENamedThreads::AnyThread;
 		}
-		TickFunction->CompletionHandle = TGraphTask<FTickFunctionTask>::CreateTask(Prerequisites, TickContext.Thread).ConstructAndDispatchWhenReady(TickFunction, &UseContext, bLogTicks);
+		const bool bValidateTick = bValidateParallelTicks && TickFunction->bRunOnAnyThread;
+		TickFunction->CompletionHandle = TGraphTask<FTickFunctionTask>::CreateTask(Prerequisites, TickContext.Thread).ConstructAndDispatchWhenReady(TickFunction, &UseContext, bLogTicks, bValidateTick);
 	}
 
 	/** Add a completion handle to a tick group **/
@@ -224,7 +243,15 @@ public:
 			UE_LOG(LogTick, Log, TEXT("tick %6d ---------------------------------------- Start Frame"),GFrameCounter);
 		}
 
-		if (SingleThreadedMode())
+		const int32 ParallelTicks = CVarParallelTicks.GetValueOnGameThread();
+		bValidateParallelTicks = (ParallelTicks == 2);
+
+		if (ParallelTicks == 1)
+		{
+			// dependencies are task graph edges, so this is safe in single threaded mode too; the game thread waits for the workers at the end of each tick group
+			bAllowConcurrentTicks = FTaskGraphInterface::Get().GetNumWorkerThreads() > 0;
+		}
+		else if (SingleThreadedMode() || bValidateParallelTicks)
 		{
 			bAllowConcurrentTicks = false;
 		}
@@ -260,6 +287,7 @@ private:
 
 	FTickTaskSequencer()
 		: bAllowConcurrentTicks(false)
+		, bValidateParallelTicks(false)
 		, bLogTicks(false)
 	{
 	}
@@ -282,15 +310,20 @@ private:
 		FTickContext			Context;
 		/** If true, log each tick **/
 		bool					bLogTick; 
+		/** If true, report modifications of other actors made by this tick **/
+		bool					bValidateTick; 
 	public:
 		/** Constructor
 		 * @param InTarget - Function to tick
 		 * @param InContext - context to tick in, here thread is desired execution thread
+		 * @param InbLogTick - if true, log the tick
+		 * @param InbValidateTick - if true, report modifications of other actors made by the tick, only valid on the game thread
 		**/
-		FTickFunctionTask(FTickFunction* InTarget, const FTickContext* InContext, bool InbLogTick)
+		FTickFunctionTask(FTickFunction* InTarget, const FTickContext* InContext, bool InbLogTick, bool InbValidateTick)
 			: Target(InTarget)
 			, Context(*InContext)
 			, bLogTick(InbLogTick)
+			, bValidateTick(InbValidateTick)
 		{
 		}
 		FORCEINLINE TStatId GetStatId() const
@@ -318,12 +351,55 @@ private:
 			{
 				UE_LOG(LogTick, Log, TEXT("tick %6d %2d %s"),GFrameCounter, (int32)CurrentThread, *Target->DiagnosticMessage());
 			}
-			Target->ExecuteTick(Context.DeltaSeconds, Context.TickType, CurrentThread, MyCompletionGraphEvent);
+			if (bValidateTick)
+			{
+				check(IsInGameThread());
+				FParallelTickValidation::ValidatingActor = Target->GetTickedActor();
+				FParallelTickValidation::ValidatingTickFunction = Target;
+				Target->ExecuteTick(Context.DeltaSeconds, Context.TickType, CurrentThread, MyCompletionGraphEvent);
+				FParallelTickValidation::ValidatingActor = NULL;
+				FParallelTickValidation::ValidatingTickFunction = NULL;
+			}
+			else
+			{
+				Target->ExecuteTick(Context.DeltaSeconds, Context.TickType, CurrentThread, MyCompletionGraphEvent);
+			}
 			Target->CompletionHandle = NULL; // Allow the old completion handle to be recycled
 		}
 	};
 };
 
+const AActor* FParallelTickValidation::ValidatingActor = NULL;
+FTickFunction* FParallelTickValidation::ValidatingTickFunction = NULL;
+
+void FParallelTickValidation::ReportWrite(const UObject* Object, const TCHAR* Operation)
+{
+	// the validated tick runs on the game thread, anything else happens outside of it
+	if (!IsInGameThread() || Object == NULL)
+	{
+		return;
+	}
+
+	const AActor* ModifiedActor = Object->IsA(AActor::StaticClass()) ? (const AActor*)Object : Object->GetTypedOuter<AActor>();
+	if (ModifiedActor == ValidatingActor)
+	{
+		return;
+	}
+
+	// report every kind of violation once, not once per instance; 500 pawns of the same class would make the log useless
+	static TSet<FString> Reported;
+	const FString Key = FString::Printf(TEXT("%s %s %s"),
+		ValidatingActor ? *ValidatingActor->GetClass()->GetName() : TEXT("None"),
+		Operation,
+		*(ModifiedActor ? ModifiedActor->GetClass() : Object->GetClass())->GetName());
+	if (!Reported.Contains(Key))
+	{
+		Reported.Add(Key);
+		UE_LOG(LogTick, Warning, TEXT("Tick %s is not safe to run on any thread: %s modified %s"),
+			*ValidatingTickFunction->DiagnosticMessage(), Operation, *Object->GetFullName());
+	}
+}
+
 
 class FTickTaskLevel
 {
@@ -6,14 +6,20 @@
 
 #include "EnginePrivate.h"
 
-void FTimerHandle::MakeValid()
+/** Serial numbers of handles are never reused, so stale handles don't match new timers */
+static uint64 GenerateTimerSerialNumber()
 {
-	static int LastAssignedHandle = -1;
+	static uint64 LastAssignedSerialNumber = 0;
+
+	return ++LastAssignedSerialNumber;
+}
 
+void FTimerHandle::MakeValid()
+{
 	if (!IsValid())
 	{
-		++LastAssignedHandle;
-		Handle = LastAssignedHandle;
+		// Not given to a timer manager yet, so the index doesn't refer to any timer
+		SetIndexAndSerialNumber(NoIndex, GenerateTimerSerialNumber());
 	}
 
 	check(IsValid());
@@ -25,44 +31,55 @@ inline bool DEPRECATED_CompareUnifiedDelegates(const FTimerUnifiedDelegate& Lhs,
 	return ( Lhs.FuncDelegate.IsBound() && (Lhs.FuncDelegate.DEPRECATED_Compare(Rhs.FuncDelegate)) ) || ( Lhs.FuncDynDelegate.IsBound() && (Lhs.FuncDynDelegate == Rhs.FuncDynDelegate) );
 }
 
-// ---------------------------------
-// Private members
-// ---------------------------------
-
-/** Will find and return a timer if it exists, regardless whether it is paused. */ 
-FTimerData const* FTimerManager::DEPRECATED_FindTimer(FTimerUnifiedDelegate const& InDelegate, int32* OutTimerIndex) const
+/** Orders expired timers by expire time, and by index for timers that expire at the same time */
+struct FCompareExpiredTimers
 {
-	int32 ActiveTimerIdx = DEPRECATED_FindTimerInList(ActiveTimerHeap, InDelegate);
-	if (ActiveTimerIdx != INDEX_NONE)
+	const TSparseArray<FTimerManager::FTimerSlot>& Timers;
+
+	FCompareExpiredTimers(const TSparseArray<FTimerManager::FTimerSlot>& InTimers)
+		: Timers(InTimers)
+	{}
+
+	FORCEINLINE bool operator()(int32 A, int32 B) const
 	{
-		// found it in the active heap
-		if (OutTimerIndex)
-		{
-			*OutTimerIndex = ActiveTimerIdx;
-		}
-		return &ActiveTimerHeap[ActiveTimerIdx];
+		const double ExpireTimeA = Timers[A].Data.ExpireTime;
+		const double ExpireTimeB = Timers[B].Data.ExpireTime;
+		return ExpireTimeA < ExpireTimeB || (ExpireTimeA == ExpireTimeB && A < B);
 	}
+};
 
-	int32 PausedTimerIdx = DEPRECATED_FindTimerInList(PausedTimerList, InDelegate);
-	if (PausedTimerIdx != INDEX_NONE)
+FTimerManager::FTimerManager()
+	: WheelTick(0)
+	, InternalTime(0.0)
+	, ExecutingTimerIndex(INDEX_NONE)
+	, LastTickedFrame(static_cast<uint64>(-1))
+{
+	for (int32 BucketIdx = 0; BucketIdx < ARRAY_COUNT(WheelBuckets); ++BucketIdx)
 	{
-		// found it in the paused list
-		if (OutTimerIndex)
-		{
-			*OutTimerIndex = PausedTimerIdx;
-		}
-		return &PausedTimerList[PausedTimerIdx];
+		WheelBuckets[BucketIdx] = INDEX_NONE;
 	}
 
-	int32 PendingTimerIdx = DEPRECATED_FindTimerInList(PendingTimerList, InDelegate);
-	if (PendingTimerIdx != INDEX_NONE)
+	FMemory::Memzero(NumTimersInWheelLevel, sizeof(NumTimersInWheelLevel));
+}
+
+// ---------------------------------
+// Private members
+// ---------------------------------
+
+/** Will find and return a timer if it exists, regardless whether it is paused. */ 
+FTimerData const* FTimerManager::DEPRECATED_FindTimer(FTimerUnifiedDelegate const& InDelegate, int32* OutTimerIndex) const
+{
+	for (TSparseArray<FTimerSlot>::TConstIterator It(Timers); It; ++It)
 	{
-		// found it in the pending list
-		if (OutTimerIndex)
+		const FTimerData& TimerData = It->Data;
+		if (It.GetIndex() != ExecutingTimerIndex && !TimerData.TimerHandle.IsValid() && DEPRECATED_CompareUnifiedDelegates(TimerData.TimerDelegate, InDelegate))
 		{
-			*OutTimerIndex = PendingTimerIdx;
+			if (OutTimerIndex)
+			{
+				*OutTimerIndex = It.GetIndex();
+			}
+			return &TimerData;
 		}
-		return &PendingTimerList[PendingTimerIdx];
 	}
 
 	return nullptr;
@@ -70,72 +87,29 @@ FTimerData const* FTimerManager::DEPRECATED_FindTimer(FTimerUnifiedDelegate cons
 
 FTimerData const* FTimerManager::FindTimer(FTimerHandle const& InHandle, int32* OutTimerIndex) const
 {
-	int32 ActiveTimerIdx = FindTimerInList(ActiveTimerHeap, InHandle);
-	if (ActiveTimerIdx != INDEX_NONE)
-	{
-		// found it in the active heap
-		if (OutTimerIndex)
-		{
-			*OutTimerIndex = ActiveTimerIdx;
-		}
-		return &ActiveTimerHeap[ActiveTimerIdx];
-	}
-
-	int32 PausedTimerIdx = FindTimerInList(PausedTimerList, InHandle);
-	if (PausedTimerIdx != INDEX_NONE)
+	if (!InHandle.IsValid())
 	{
-		// found it in the paused list
-		if (OutTimerIndex)
-		{
-			*OutTimerIndex = PausedTimerIdx;
-		}
-		return &PausedTimerList[PausedTimerIdx];
+		return nullptr;
 	}
 
-	int32 PendingTimerIdx = FindTimerInList(PendingTimerList, InHandle);
-	if (PendingTimerIdx != INDEX_NONE)
+	// The handle knows where its timer is, it only needs to be checked that the timer wasn't replaced
+	const int32 TimerIdx = InHandle.GetIndex();
+	if (TimerIdx >= Timers.GetMaxIndex() || !Timers.IsAllocated(TimerIdx) || TimerIdx == ExecutingTimerIndex)
 	{
-		// found it in the pending list
-		if (OutTimerIndex)
-		{
-			*OutTimerIndex = PendingTimerIdx;
-		}
-		return &PendingTimerList[PendingTimerIdx];
+		return nullptr;
 	}
 
-	return nullptr;
-}
-
-
-/** Will find the given timer in the given TArray and return its index. */ 
-int32 FTimerManager::DEPRECATED_FindTimerInList(const TArray<FTimerData> &SearchArray, FTimerUnifiedDelegate const& InDelegate) const
-{
-	for (int32 Idx=0; Idx<SearchArray.Num(); ++Idx)
+	const FTimerData& TimerData = Timers[TimerIdx].Data;
+	if (TimerData.TimerHandle != InHandle)
 	{
-		if (!SearchArray[Idx].TimerHandle.IsValid() && DEPRECATED_CompareUnifiedDelegates(SearchArray[Idx].TimerDelegate, InDelegate))
-		{
-			return Idx;
-		}
+		return nullptr;
 	}
 
-	return INDEX_NONE;
-}
-
-/** Will find the given timer in the given TArray and return its index. */
-int32 FTimerManager::FindTimerInList(const TArray<FTimerData> &SearchArray, FTimerHandle const& InHandle) const
-{
-	if (InHandle.IsValid())
+	if (OutTimerIndex)
 	{
-		for (int32 Idx = 0; Idx < SearchArray.Num(); ++Idx)
-		{
-			if (SearchArray[Idx].TimerHandle == InHandle)
-			{
-				return Idx;
-			}
-		}
+		*OutTimerIndex = TimerIdx;
 	}
-
-	return INDEX_NONE;
+	return &TimerData;
 }
 
 /** Finds a handle to a dynamic timer bound to a particular pointer and function name. */
@@ -146,19 +120,12 @@ FTimerHandle FTimerManager::K2_FindDynamicTimerHandle(FTimerDynamicDelegate InDy
 		return CurrentlyExecutingTimer.TimerHandle;
 	}
 
-	if (auto* Timer = ActiveTimerHeap.FindByPredicate([=](const FTimerData& Data){ return Data.TimerDelegate.FuncDynDelegate == InDynamicDelegate; }))
+	for (TSparseArray<FTimerSlot>::TConstIterator It(Timers); It; ++It)
 	{
-		return Timer->TimerHandle;
-	}
-
-	if (auto* Timer = PausedTimerList.FindByPredicate([=](const FTimerData& Data){ return Data.TimerDelegate.FuncDynDelegate == InDynamicDelegate; }))
-	{
-		return Timer->TimerHandle;
-	}
-
-	if (auto* Timer = PendingTimerList.FindByPredicate([=](const FTimerData& Data){ return Data.TimerDelegate.FuncDynDelegate == InDynamicDelegate; }))
-	{
-		return Timer->TimerHandle;
+		if (It.GetIndex() != ExecutingTimerIndex && It->Data.TimerDelegate.FuncDynDelegate == InDynamicDelegate)
+		{
+			return It->Data.TimerHandle;
+		}
 	}
 
 	return FTimerHandle();
@@ -206,6 +173,9 @@ void FTimerManager::InternalSetTimer(FTimerHandle& InOutHandle, FTimerUnifiedDel
 		NewTimerData.TimerDelegate = InDelegate;
 
 		InternalSetTimer(NewTimerData, InRate, InbLoop, InFirstDelay);
+
+		// The timer may have been stored somewhere else than the index of the handle
+		InOutHandle = NewTimerData.TimerHandle;
 	}
 }
 
@@ -222,14 +192,20 @@ void FTimerManager::InternalSetTimer(FTimerData& NewTimerData, float InRate, boo
 		{
 			NewTimerData.ExpireTime = InternalTime + FirstDelay;
 			NewTimerData.Status = ETimerStatus::Active;
-			ActiveTimerHeap.HeapPush(NewTimerData);
+
+			const int32 TimerIdx = AddTimer(NewTimerData);
+			NewTimerData.TimerHandle = Timers[TimerIdx].Data.TimerHandle;
+			LinkTimerToWheel(TimerIdx);
 		}
 		else
 		{
 			// Store time remaining in ExpireTime while pending
 			NewTimerData.ExpireTime = FirstDelay;
 			NewTimerData.Status = ETimerStatus::Pending;
-			PendingTimerList.Add(NewTimerData);
+
+			const int32 TimerIdx = AddTimer(NewTimerData);
+			NewTimerData.TimerHandle = Timers[TimerIdx].Data.TimerHandle;
+			AddPendingTimer(TimerIdx);
 		}
 	}
 }
@@ -245,7 +221,7 @@ void FTimerManager::InternalSetTimerForNextTick(FTimerUnifiedDelegate const& InD
 	NewTimerData.TimerDelegate = InDelegate;
 	NewTimerData.ExpireTime = InternalTime;
 	NewTimerData.Status = ETimerStatus::Active;
-	ActiveTimerHeap.HeapPush(NewTimerData);
+	LinkTimerToWheel(AddTimer(NewTimerData));
 }
 
 void FTimerManager::DEPRECATED_InternalClearTimer(FTimerUnifiedDelegate const& InDelegate)
@@ -257,7 +233,7 @@ void FTimerManager::DEPRECATED_InternalClearTimer(FTimerUnifiedDelegate const& I
 	FTimerData const* const TimerData = DEPRECATED_FindTimer(InDelegate, &TimerIdx);
 	if (TimerData)
 	{
-		InternalClearTimer(TimerIdx, TimerData->Status);
+		InternalClearTimer(TimerIdx);
 	}
 	else
 	{
@@ -285,7 +261,7 @@ void FTimerManager::InternalClearTimer(FTimerHandle const& InHandle)
 	FTimerData const* const TimerData = FindTimer(InHandle, &TimerIdx);
 	if (TimerData)
 	{
-		InternalClearTimer(TimerIdx, TimerData->Status);
+		InternalClearTimer(TimerIdx);
 	}
 	else
 	{
@@ -299,25 +275,10 @@ void FTimerManager::InternalClearTimer(FTimerHandle const& InHandle)
 	}
 }
 
-void FTimerManager::InternalClearTimer(int32 TimerIdx, ETimerStatus::Type TimerStatus)
+void FTimerManager::InternalClearTimer(int32 TimerIdx)
 {
-	switch (TimerStatus)
-	{
-		case ETimerStatus::Pending:
-			PendingTimerList.RemoveAtSwap(TimerIdx);
-			break;
-
-		case ETimerStatus::Active:
-			ActiveTimerHeap.HeapRemoveAt(TimerIdx);
-			break;
-
-		case ETimerStatus::Paused:
-			PausedTimerList.RemoveAtSwap(TimerIdx);
-			break;
-
-		default:
-			check(false);
-	}
+	UnlinkTimer(TimerIdx);
+	Timers.RemoveAt(TimerIdx);
 }
 
 
@@ -325,39 +286,13 @@ void FTimerManager::InternalClearAllTimers(void const* Object)
 {
 	if (Object)
 	{
-		// search active timer heap for timers using this object and remove them
-		int32 const OldActiveHeapSize = ActiveTimerHeap.Num();
-
-		for (int32 Idx=0; Idx<ActiveTimerHeap.Num(); ++Idx)
-		{
-			if ( ActiveTimerHeap[Idx].TimerDelegate.IsBoundToObject(Object) )
-			{
-				// remove this item
-				// this will break the heap property, but we will re-heapify afterward
-				ActiveTimerHeap.RemoveAtSwap(Idx--);
-			}
-		}
-		if (OldActiveHeapSize != ActiveTimerHeap.Num())
+		// remove every timer using this object, whether it is active, paused or pending
+		for (TSparseArray<FTimerSlot>::TIterator It(Timers); It; ++It)
 		{
-			// need to heapify
-			ActiveTimerHeap.Heapify();
-		}
-
-		// search paused timer list for timers using this object and remove them, too
-		for (int32 Idx=0; Idx<PausedTimerList.Num(); ++Idx)
-		{
-			if (PausedTimerList[Idx].TimerDelegate.IsBoundToObject(Object))
+			if (It.GetIndex() != ExecutingTimerIndex && It->Data.TimerDelegate.IsBoundToObject(Object))
 			{
-				PausedTimerList.RemoveAtSwap(Idx--);
-			}
-		}
-
-		// search pending timer list for timers using this object and remove them, too
-		for (int32 Idx=0; Idx<PendingTimerList.Num(); ++Idx)
-		{
-			if (PendingTimerList[Idx].TimerDelegate.IsBoundToObject(Object))
-			{
-				PendingTimerList.RemoveAtSwap(Idx--);
+				UnlinkTimer(It.GetIndex());
+				It.RemoveCurrent();
 			}
 		}
 
@@ -424,60 +359,260 @@ void FTimerManager::InternalPauseTimer( FTimerData const* TimerToPause, int32 Ti
 
 	if( TimerToPause && (TimerToPause->Status != ETimerStatus::Paused) )
 	{
-		ETimerStatus::Type PreviousStatus = TimerToPause->Status;
-
-		// Add to Paused list
-		int32 NewIndex = PausedTimerList.Add(*TimerToPause);
-
-		// Set new status
-		FTimerData &NewTimer = PausedTimerList[NewIndex];
-		NewTimer.Status = ETimerStatus::Paused;
+		UnlinkTimer(TimerIdx);
 
-		// Remove from previous TArray
-		switch( PreviousStatus )
+		FTimerData& Timer = Timers[TimerIdx].Data;
+		if (Timer.Status == ETimerStatus::Active)
 		{
-			case ETimerStatus::Active : 
-				// Store time remaining in ExpireTime while paused
-				NewTimer.ExpireTime = NewTimer.ExpireTime - InternalTime;
-				ActiveTimerHeap.HeapRemoveAt(TimerIdx); 
-				break;
-			
-			case ETimerStatus::Pending : 
-				PendingTimerList.RemoveAtSwap(TimerIdx); 
-				break;
-
-			default : check(false);
+			// Store time remaining in ExpireTime while paused
+			Timer.ExpireTime = Timer.ExpireTime - InternalTime;
 		}
+		Timer.Status = ETimerStatus::Paused;
 	}
 }
 
-void FTimerManager::InternalUnPauseTimer(int32 PausedTimerIdx)
+void FTimerManager::InternalUnPauseTimer( FTimerData const* TimerToUnPause, int32 TimerIdx )
 {
 	// not currently threadsafe
 	check(IsInGameThread());
 
-	if (PausedTimerIdx != INDEX_NONE)
+	if (TimerToUnPause && TimerToUnPause->Status == ETimerStatus::Paused)
 	{
-		FTimerData& TimerToUnPause = PausedTimerList[PausedTimerIdx];
-		check(TimerToUnPause.Status == ETimerStatus::Paused);
+		FTimerData& Timer = Timers[TimerIdx].Data;
 
-		// Move it out of paused list and into proper TArray
 		if( HasBeenTickedThisFrame() )
 		{
 			// Convert from time remaining back to a valid ExpireTime
-			TimerToUnPause.ExpireTime += InternalTime;
-			TimerToUnPause.Status = ETimerStatus::Active;
-			ActiveTimerHeap.HeapPush(TimerToUnPause);
+			Timer.ExpireTime += InternalTime;
+			Timer.Status = ETimerStatus::Active;
+			LinkTimerToWheel(TimerIdx);
 		}
 		else
 		{
-			TimerToUnPause.Status = ETimerStatus::Pending;
-			PendingTimerList.Add(TimerToUnPause);
+			Timer.Status = ETimerStatus::Pending;
+			AddPendingTimer(TimerIdx);
 		}
+	}
+}
+
+int32 FTimerManager::AddTimer(FTimerData const& NewTimerData)
+{
+	FTimerHandle const& Handle = NewTimerData.TimerHandle;
 
-		// remove from paused list
-		PausedTimerList.RemoveAtSwap(PausedTimerIdx);
+	if (Handle.IsValid())
+	{
+		const int32 HandleIdx = Handle.GetIndex();
+
+		// Timer set again from its own delegate, the new timer takes the slot over and the executing one won't be put back
+		if (HandleIdx == ExecutingTimerIndex && Timers[HandleIdx].Data.TimerHandle == Handle)
+		{
+			ExecutingTimerIndex = INDEX_NONE;
+			Timers[HandleIdx] = FTimerSlot();
+			Timers[HandleIdx].Data = NewTimerData;
+			return HandleIdx;
+		}
+
+		// Timer set again after being cleared, keep the same handle
+		if (HandleIdx < Timers.GetMaxIndex() && !Timers.IsAllocated(HandleIdx))
+		{
+			Timers.Insert(HandleIdx, FTimerSlot());
+			Timers[HandleIdx].Data = NewTimerData;
+			return HandleIdx;
+		}
 	}
+
+	const int32 TimerIdx = Timers.Add(FTimerSlot());
+	FTimerData& Timer = Timers[TimerIdx].Data;
+	Timer = NewTimerData;
+
+	if (Handle.IsValid())
+	{
+		checkf(TimerIdx < FTimerHandle::NoIndex, TEXT("Too many timers"));
+		Timer.TimerHandle.SetIndexAndSerialNumber(TimerIdx, GenerateTimerSerialNumber());
+	}
+
+	return TimerIdx;
+}
+
+void FTimerManager::UnlinkTimer(int32 TimerIdx)
+{
+	FTimerSlot& Slot = Timers[TimerIdx];
+
+	if (Slot.Bucket >= 0)
+	{
+		if (Slot.PrevInBucket != INDEX_NONE)
+		{
+			Timers[Slot.PrevInBucket].NextInBucket = Slot.NextInBucket;
+		}
+		else
+		{
+			WheelBuckets[Slot.Bucket] = Slot.NextInBucket;
+		}
+
+		if (Slot.NextInBucket != INDEX_NONE)
+		{
+			Timers[Slot.NextInBucket].PrevInBucket = Slot.PrevInBucket;
+		}
+
+		NumTimersInWheelLevel[Slot.Bucket / WheelLevelSize]--;
+	}
+
+	// Expired timers are skipped by Tick once they're no longer in ExpiredBucket
+	Slot.Bucket = INDEX_NONE;
+	Slot.PrevInBucket = INDEX_NONE;
+	Slot.NextInBucket = INDEX_NONE;
+
+	if (Slot.PendingIndex != INDEX_NONE)
+	{
+		const int32 PendingIndex = Slot.PendingIndex;
+		PendingTimers.RemoveAtSwap(PendingIndex, 1, false);
+		if (PendingIndex < PendingTimers.Num())
+		{
+			Timers[PendingTimers[PendingIndex]].PendingIndex = PendingIndex;
+		}
+		Slot.PendingIndex = INDEX_NONE;
+	}
+}
+
+uint64 FTimerManager::GetWheelTick(double Time)
+{
+	return Time > 0.0 ? (uint64)(Time * WheelTicksPerSecond) : 0;
+}
+
+void FTimerManager::LinkTimerToWheel(int32 TimerIdx)
+{
+	FTimerSlot& Slot = Timers[TimerIdx];
+	check(Slot.Bucket == INDEX_NONE && Slot.PendingIndex == INDEX_NONE);
+
+	// Timers due already go in the current bucket, so they are picked up by the next tick
+	uint64 ExpireTick = FMath::Max(GetWheelTick(Slot.Data.ExpireTime), WheelTick);
+	const uint64 Delta = ExpireTick - WheelTick;
+
+	int32 Level = 0;
+	while (Level < WheelNumLevels - 1 && Delta >= ((uint64)1 << (WheelLevelBits * (Level + 1))))
+	{
+		++Level;
+	}
+
+	// Beyond the range of the wheel, wait in the last bucket of the top level and get re-linked when it cascades
+	const uint64 WheelRange = (uint64)1 << (WheelLevelBits * WheelNumLevels);
+	if (Delta >= WheelRange)
+	{
+		ExpireTick = WheelTick + WheelRange - 1;
+	}
+
+	const int32 Bucket = Level * WheelLevelSize + (int32)((ExpireTick >> (WheelLevelBits * Level)) & (WheelLevelSize - 1));
+
+	Slot.Bucket = Bucket;
+	Slot.PrevInBucket = INDEX_NONE;
+	Slot.NextInBucket = WheelBuckets[Bucket];
+	if (Slot.NextInBucket != INDEX_NONE)
+	{
+		Timers[Slot.NextInBucket].PrevInBucket = TimerIdx;
+	}
+	WheelBuckets[Bucket] = TimerIdx;
+
+	NumTimersInWheelLevel[Level]++;
+}
+
+void FTimerManager::AddPendingTimer(int32 TimerIdx)
+{
+	FTimerSlot& Slot = Timers[TimerIdx];
+	check(Slot.Bucket == INDEX_NONE && Slot.PendingIndex == INDEX_NONE);
+
+	Slot.PendingIndex = PendingTimers.Add(TimerIdx);
+}
+
+void FTimerManager::CascadeWheel()
+{
+	for (int32 Level = 1; Level < WheelNumLevels; ++Level)
+	{
+		const int32 LevelIdx = (int32)((WheelTick >> (WheelLevelBits * Level)) & (WheelLevelSize - 1));
+		const int32 Bucket = Level * WheelLevelSize + LevelIdx;
+
+		// Re-link everything to the finer levels, relative to the new wheel tick
+		int32 TimerIdx = WheelBuckets[Bucket];
+		while (TimerIdx != INDEX_NONE)
+		{
+			const int32 NextTimerIdx = Timers[TimerIdx].NextInBucket;
+			UnlinkTimer(TimerIdx);
+			LinkTimerToWheel(TimerIdx);
+			TimerIdx = NextTimerIdx;
+		}
+
+		// Only carry on to the next level when this one went around too
+		if (LevelIdx != 0)
+		{
+			break;
+		}
+	}
+}
+
+void FTimerManager::GatherExpiredTimers()
+{
+	ExpiredTimers.Reset();
+
+	const uint64 TargetTick = GetWheelTick(InternalTime);
+
+	for (;;)
+	{
+		// Collect the bucket of the current tick, InternalTime may be past some of its timers only
+		const int32 Bucket = (int32)(WheelTick & (WheelLevelSize - 1));
+		int32 TimerIdx = WheelBuckets[Bucket];
+		while (TimerIdx != INDEX_NONE)
+		{
+			const int32 NextTimerIdx = Timers[TimerIdx].NextInBucket;
+			UnlinkTimer(TimerIdx);
+			Timers[TimerIdx].Bucket = ExpiredBucket;
+			ExpiredTimers.Add(TimerIdx);
+			TimerIdx = NextTimerIdx;
+		}
+
+		if (WheelTick >= TargetTick)
+		{
+			break;
+		}
+
+		int32 NumTimersInWheel = 0;
+		for (int32 Level = 0; Level < WheelNumLevels; ++Level)
+		{
+			NumTimersInWheel += NumTimersInWheelLevel[Level];
+		}
+
+		if (NumTimersInWheel == 0)
+		{
+			// Nothing to cascade
+			WheelTick = TargetTick;
+		}
+		else if (NumTimersInWheelLevel[0] == 0)
+		{
+			// Skip the empty buckets, up to the next cascade
+			WheelTick = FMath::Min(TargetTick, (WheelTick | (WheelLevelSize - 1)) + 1);
+		}
+		else
+		{
+			++WheelTick;
+		}
+
+		if ((WheelTick & (WheelLevelSize - 1)) == 0)
+		{
+			CascadeWheel();
+		}
+	}
+
+	// Put back the timers that expire later during the current tick
+	for (int32 Idx = 0; Idx < ExpiredTimers.Num(); ++Idx)
+	{
+		const int32 TimerIdx = ExpiredTimers[Idx];
+		if (!(InternalTime > Timers[TimerIdx].Data.ExpireTime))
+		{
+			Timers[TimerIdx].Bucket = INDEX_NONE;
+			LinkTimerToWheel(TimerIdx);
+			ExpiredTimers.RemoveAtSwap(Idx--, 1, false);
+		}
+	}
+
+	ExpiredTimers.Sort(FCompareExpiredTimers(Timers));
 }
 
 // ---------------------------------
@@ -491,70 +626,84 @@ void FTimerManager::Tick(float DeltaTime)
 
 	InternalTime += DeltaTime;
 
-	while (ActiveTimerHeap.Num() > 0)
+	GatherExpiredTimers();
+
+	for (int32 ExpiredIdx = 0; ExpiredIdx < ExpiredTimers.Num(); ++ExpiredIdx)
 	{
-		FTimerData& Top = ActiveTimerHeap.HeapTop();
-		if (InternalTime > Top.ExpireTime)
+		const int32 TimerIdx = ExpiredTimers[ExpiredIdx];
+
+		// Skip timers cleared or paused by the timers that fired before them
+		if (!Timers.IsAllocated(TimerIdx) || Timers[TimerIdx].Bucket != ExpiredBucket)
 		{
-			// Timer has expired! Fire the delegate, then handle potential looping.
+			continue;
+		}
 
-			// Remove it from the heap and store it while we're executing
-			ActiveTimerHeap.HeapPop(CurrentlyExecutingTimer); 
+		// Timer has expired! Fire the delegate, then handle potential looping.
 
-			// Determine how many times the timer may have elapsed (e.g. for large DeltaTime on a short looping timer)
-			int32 const CallCount = CurrentlyExecutingTimer.bLoop ? 
-				FMath::TruncToInt( (InternalTime - CurrentlyExecutingTimer.ExpireTime) / CurrentlyExecutingTimer.Rate ) + 1
-				: 1;
+		// Keep its slot while we're executing, but store it aside so it can't be found
+		Timers[TimerIdx].Bucket = INDEX_NONE;
+		CurrentlyExecutingTimer = Timers[TimerIdx].Data;
+		ExecutingTimerIndex = TimerIdx;
 
-			// Now call the function
-			for (int32 CallIdx=0; CallIdx<CallCount; ++CallIdx)
-			{ 
-				CurrentlyExecutingTimer.TimerDelegate.Execute();
+		// Determine how many times the timer may have elapsed (e.g. for large DeltaTime on a short looping timer)
+		int32 const CallCount = CurrentlyExecutingTimer.bLoop ? 
+			FMath::TruncToInt( (InternalTime - CurrentlyExecutingTimer.ExpireTime) / CurrentlyExecutingTimer.Rate ) + 1
+			: 1;
 
-				// If timer was cleared in the delegate execution, don't execute further 
-				if( !CurrentlyExecutingTimer.TimerHandle.IsValid() && !CurrentlyExecutingTimer.TimerDelegate.IsBound() )
-				{
-					break;
-				}
-			}
+		// Now call the function
+		for (int32 CallIdx=0; CallIdx<CallCount; ++CallIdx)
+		{ 
+			CurrentlyExecutingTimer.TimerDelegate.Execute();
 
-			if( CurrentlyExecutingTimer.bLoop && 
-				(CurrentlyExecutingTimer.TimerHandle.IsValid() ||
-				 CurrentlyExecutingTimer.TimerDelegate.IsBound()) && 							// did not get cleared during execution
-				(CurrentlyExecutingTimer.TimerHandle.IsValid() ? 
-					(FindTimer(CurrentlyExecutingTimer.TimerHandle) == nullptr) : 
-					(DEPRECATED_FindTimer(CurrentlyExecutingTimer.TimerDelegate) == nullptr)) // did not get manually re-added during execution			  
-				)
+			// If timer was cleared in the delegate execution, don't execute further 
+			if( !CurrentlyExecutingTimer.TimerHandle.IsValid() && !CurrentlyExecutingTimer.TimerDelegate.IsBound() )
 			{
-				// Put this timer back on the heap
-				CurrentlyExecutingTimer.ExpireTime += CallCount * CurrentlyExecutingTimer.Rate;
-				ActiveTimerHeap.HeapPush(CurrentlyExecutingTimer);
+				break;
 			}
+		}
 
-			CurrentlyExecutingTimer.TimerDelegate.Unbind();
+		if( CurrentlyExecutingTimer.bLoop && 
+			(CurrentlyExecutingTimer.TimerHandle.IsValid() ||
+			 CurrentlyExecutingTimer.TimerDelegate.IsBound()) && 							// did not get cleared during execution
+			(CurrentlyExecutingTimer.TimerHandle.IsValid() ? 
+				(FindTimer(CurrentlyExecutingTimer.TimerHandle) == nullptr) : 
+				(DEPRECATED_FindTimer(CurrentlyExecutingTimer.TimerDelegate) == nullptr)) // did not get manually re-added during execution			  
+			)
+		{
+			// Put this timer back on the wheel
+			CurrentlyExecutingTimer.ExpireTime += CallCount * CurrentlyExecutingTimer.Rate;
+			Timers[TimerIdx].Data = CurrentlyExecutingTimer;
+			ExecutingTimerIndex = INDEX_NONE;
+			LinkTimerToWheel(TimerIdx);
 		}
-		else
+		else if (ExecutingTimerIndex != INDEX_NONE)
 		{
-			// no need to go further down the heap, we can be finished
-			break;
+			// Done with it, unless it was set again during execution and now holds the new timer
+			ExecutingTimerIndex = INDEX_NONE;
+			Timers.RemoveAt(TimerIdx);
 		}
+
+		CurrentlyExecutingTimer.TimerDelegate.Unbind();
 	}
 
+	ExpiredTimers.Reset();
+
 	// Timer has been ticked.
 	LastTickedFrame = GFrameCounter;
 
 	// If we have any Pending Timers, add them to the Active Queue.
-	if( PendingTimerList.Num() > 0 )
+	if( PendingTimers.Num() > 0 )
 	{
-		for(int32 Index=0; Index<PendingTimerList.Num(); Index++)
+		for(int32 Index=0; Index<PendingTimers.Num(); Index++)
 		{
-			FTimerData& TimerToActivate = PendingTimerList[Index];
+			FTimerSlot& TimerToActivate = Timers[PendingTimers[Index]];
 			// Convert from time remaining back to a valid ExpireTime
-			TimerToActivate.ExpireTime += InternalTime;
-			TimerToActivate.Status = ETimerStatus::Active;
-			ActiveTimerHeap.HeapPush( TimerToActivate );
+			TimerToActivate.Data.ExpireTime += InternalTime;
+			TimerToActivate.Data.Status = ETimerStatus::Active;
+			TimerToActivate.PendingIndex = INDEX_NONE;
+			LinkTimerToWheel(PendingTimers[Index]);
 		}
-		PendingTimerList.Empty();
+		PendingTimers.Reset();
 	}
 }
 
@@ -264,6 +264,75 @@ bool TimerManagerTest_LoopingTimers_DifferentHandles(UWorld* World, FAutomationT
 	return true;
 }
 
+// Adds, queries, clears and fires a large number of timers, and logs how long each step took
+bool TimerManagerTest_ManyTimers(UWorld* World, FAutomationTestBase* Test)
+{
+	// Not the world's timer manager, so timers left by the other tests don't get in the way
+	FTimerManager TimerManager;
+	const int32 NumTimers = 100000;
+	const float MaxRate = 10.f;
+
+	int32 CallCount = 0;
+	auto Func = [](int32* CallCount){ (*CallCount)++; };
+	FTimerDelegate Delegate = FTimerDelegate::CreateStatic(Func, &CallCount);
+
+	TArray<FTimerHandle> Handles;
+	Handles.SetNum(NumTimers);
+
+	FRandomStream RandomStream(0);
+
+	// Make sure the timers are activated right away rather than added to the pending list
+	TimerManager.Tick(0.f);
+
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 Idx = 0; Idx < NumTimers; ++Idx)
+	{
+		TimerManager.SetTimer(Handles[Idx], Delegate, RandomStream.FRandRange(0.1f, MaxRate), false);
+	}
+	const double AddTime = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+	int32 NumActive = 0;
+	for (int32 Idx = 0; Idx < NumTimers; ++Idx)
+	{
+		NumActive += TimerManager.IsTimerActive(Handles[Idx]) ? 1 : 0;
+	}
+	const double QueryTime = FPlatformTime::Seconds() - StartTime;
+
+	Test->TestTrue(TIMER_TEST_TEXT("All timers are active"), NumActive == NumTimers);
+
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Idx = 0; Idx < NumTimers; Idx += 2)
+	{
+		TimerManager.ClearTimer(Handles[Idx]);
+	}
+	const double ClearTime = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+	for (float Time = 0.f; Time <= MaxRate + 1.f; Time += 1.f / 30.f)
+	{
+		TimerManager.Tick(1.f / 30.f);
+		GFrameCounter++;
+	}
+	const double FireTime = FPlatformTime::Seconds() - StartTime;
+
+	Test->TestTrue(TIMER_TEST_TEXT("Every timer that wasn't cleared fired once"), CallCount == NumTimers / 2);
+
+	for (int32 Idx = 0; Idx < NumTimers; ++Idx)
+	{
+		if (TimerManager.TimerExists(Handles[Idx]))
+		{
+			Test->AddError(TIMER_TEST_TEXT("Timer %d still exists after it fired or was cleared", Idx));
+			break;
+		}
+	}
+
+	Test->AddLogItem(FString::Printf(TEXT("%d timers: add %.2f ms, query %.2f ms, clear half %.2f ms, fire the rest %.2f ms"),
+		NumTimers, AddTime * 1000.0, QueryTime * 1000.0, ClearTime * 1000.0, FireTime * 1000.0));
+
+	return true;
+}
+
 bool FTimerManagerTest::RunTest(const FString& Parameters)
 {
 	UWorld *World = UWorld::CreateWorld(EWorldType::Game, false);
@@ -279,6 +348,7 @@ bool FTimerManagerTest::RunTest(const FString& Parameters)
 	TimerManagerTest_ValidTimer_HandleWithDelegate(World, this);
 	TimerManagerTest_ValidTimer_HandleLoopingSetDuringExecute(World, this);
 	TimerManagerTest_LoopingTimers_DifferentHandles(World, this);
+	TimerManagerTest_ManyTimers(World, this);
 
 	GEngine->DestroyWorldContext(World);
 	World->DestroyWorld(false);
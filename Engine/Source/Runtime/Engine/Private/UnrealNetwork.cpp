@@ -24,10 +24,12 @@ uint32 FNetworkVersion::GetLocalNetworkVersion()
 	// Get the project version string (IS case sensitive!)
 	const FString& ProjectVersion = Cast<UGeneralProjectSettings>(UGeneralProjectSettings::StaticClass()->GetDefaultObject())->ProjectVersion;
 
-	// Start with engine version as seed, and then hash with project name + project version
-	const uint32 LocalNetworkVersion = FCrc::StrCrc32( *ProjectVersion, FCrc::StrCrc32( *ProjectName, GEngineNetVersion ) );
+	// Start with engine version as seed, and then hash with network protocol version + project name + project version
+	const uint32 ProtocolVersion = EngineNetworkProtocolVersion;
+	const uint32 EngineNetworkVersion = FCrc::MemCrc32( &ProtocolVersion, sizeof( ProtocolVersion ), GEngineNetVersion );
+	const uint32 LocalNetworkVersion = FCrc::StrCrc32( *ProjectVersion, FCrc::StrCrc32( *ProjectName, EngineNetworkVersion ) );
 
-	UE_LOG( LogNet, Log, TEXT( "GetLocalNetworkVersion: GEngineNetVersion: %i, ProjectName: %s, ProjectVersion: %s, LocalNetworkVersion: %i" ), GEngineNetVersion, *ProjectName, *ProjectVersion, LocalNetworkVersion );
+	UE_LOG( LogNet, Log, TEXT( "GetLocalNetworkVersion: GEngineNetVersion: %i, EngineNetworkProtocolVersion: %i, ProjectName: %s, ProjectVersion: %s, LocalNetworkVersion: %i" ), GEngineNetVersion, EngineNetworkProtocolVersion, *ProjectName, *ProjectVersion, LocalNetworkVersion );
 
 	return LocalNetworkVersion;
 }
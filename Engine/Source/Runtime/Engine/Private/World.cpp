@@ -27,6 +27,7 @@
 #include "EngineModule.h"
 #include "ParticleHelper.h"
 #include "TickTaskManagerInterface.h"
+#include "SceneComponentTransformStore.h"
 #include "FXSystem.h"
 #include "SoundDefinitions.h"
 #include "VisualLogger/VisualLogger.h"
@@ -111,6 +112,7 @@ UWorld::UWorld( const FObjectInitializer& ObjectInitializer )
 ,	NextTravelType(TRAVEL_Relative)
 {
 	TimerManager = new FTimerManager();
+	SceneComponentTransformStore = new FSceneComponentTransformStore();
 #if WITH_EDITOR
 	bBroadcastSelectionChange = true; //Ed Only
 #endif // WITH_EDITOR
@@ -450,6 +452,9 @@ void UWorld::FinishDestroy()
 		delete TimerManager;
 	}
 
+	delete SceneComponentTransformStore;
+	SceneComponentTransformStore = NULL;
+
 	// Remove the PKG_ContainsMap flag from packages that no longer contain a world
 	{
 		UPackage* WorldPackage = GetOutermost();
@@ -2483,6 +2488,10 @@ bool UWorld::Exec( UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& Ar )
 	{		
 		return HandleDemoStopCommand( Cmd, Ar, InWorld );
 	}
+	else if( FParse::Command( &Cmd, TEXT("DEMOGOTO") ) )
+	{
+		return HandleDemoGotoCommand( Cmd, Ar, InWorld );
+	}
 	else if( ExecPhysCommands( Cmd, &Ar, InWorld ) )
 	{
 		return HandleLogActorCountsCommand( Cmd, Ar, InWorld );
@@ -2650,6 +2659,30 @@ bool UWorld::HandleDemoStopCommand( const TCHAR* Cmd, FOutputDevice& Ar, UWorld*
 	return true;
 }
 
+bool UWorld::HandleDemoGotoCommand( const TCHAR* Cmd, FOutputDevice& Ar, UWorld* InWorld )
+{
+	FString TimeString;
+
+	if ( !FParse::Token( Cmd, TimeString, 0 ) )
+	{
+		Ar.Log( TEXT( "You must specify a time in seconds" ) );
+		return true;
+	}
+
+	FString Error;
+
+	if ( DemoNetDriver == NULL )
+	{
+		Ar.Log( TEXT( "No demo is being played back" ) );
+	}
+	else if ( !DemoNetDriver->GotoTime( FCString::Atof( *TimeString ), Error ) )
+	{
+		Ar.Logf( TEXT( "DEMOGOTO failed: %s" ), *Error );
+	}
+
+	return true;
+}
+
 void UWorld::DestroyDemoNetDriver()
 {
 	if ( DemoNetDriver != NULL )
@@ -3522,7 +3555,9 @@ void UWorld::WelcomePlayer(UNetConnection* Connection)
 		RedirectURL = AuthorityGameMode->GetRedirectURL(LevelName);
 	}
 
-	FNetControlMessage<NMT_Welcome>::Send(Connection, LevelName, GameName, RedirectURL);
+	uint32 PacketCompressionChecksum = Connection->Driver->GetPacketCompressionChecksum();
+
+	FNetControlMessage<NMT_Welcome>::Send(Connection, LevelName, GameName, RedirectURL, PacketCompressionChecksum);
 	Connection->FlushNet();
 	// don't count initial join data for netspeed throttling
 	// as it's unnecessary, since connection won't be fully open until it all gets received, and this prevents later gameplay data from being delayed to "catch up"
@@ -3598,6 +3633,21 @@ void UWorld::NotifyControlMessage(UNetConnection* Connection, uint8 MessageType,
 				Connection->PackageMap->ResolvePathAndAssignNetGUID( NetGUID, Path );
 				break;
 			}
+			case NMT_LevelNetGUIDs:
+			{
+				FString PackageName;
+				uint32 Checksum = 0;
+				FNetworkGUID FirstNetGUID;
+				int32 NumNetGUIDs = 0;
+				FNetControlMessage<NMT_LevelNetGUIDs>::Receive(Bunch, PackageName, Checksum, FirstNetGUID, NumNetGUIDs);
+
+				UPackageMapClient* PackageMapClient = Cast<UPackageMapClient>(Connection->PackageMap);
+				if (PackageMapClient != NULL)
+				{
+					PackageMapClient->ReceiveLevelNetGUIDs(PackageName, Checksum, FirstNetGUID, NumNetGUIDs);
+				}
+				break;
+			}
 		}
 	}
 	else
@@ -3621,8 +3671,9 @@ void UWorld::NotifyControlMessage(UNetConnection* Connection, uint8 MessageType,
 				uint8 IsLittleEndian = 0;
 				uint32 RemoteNetworkVersion = 0;
 				uint32 LocalNetworkVersion = FNetworkVersion::GetLocalNetworkVersion();
+				uint32 RemotePacketCompressionChecksum = 0;
 
-				FNetControlMessage<NMT_Hello>::Receive(Bunch, IsLittleEndian, RemoteNetworkVersion);
+				FNetControlMessage<NMT_Hello>::Receive(Bunch, IsLittleEndian, RemoteNetworkVersion, RemotePacketCompressionChecksum);
 
 				if (!FNetworkVersion::IsNetworkCompatible(LocalNetworkVersion, RemoteNetworkVersion))
 				{
@@ -3633,6 +3684,8 @@ void UWorld::NotifyControlMessage(UNetConnection* Connection, uint8 MessageType,
 				}
 				else
 				{
+					Connection->NegotiatePacketCompression(RemotePacketCompressionChecksum);
+
 					Connection->Challenge = FString::Printf(TEXT("%08X"), FPlatformTime::Cycles());
 					Connection->SetExpectedClientLoginMsgType( NMT_Login );
 					FNetControlMessage<NMT_Challenge>::Send(Connection, Connection->Challenge);
@@ -3769,6 +3822,15 @@ void UWorld::NotifyControlMessage(UNetConnection* Connection, uint8 MessageType,
 						{
 							Connection->PlayerController->ClientTravel(LevelName, TRAVEL_Relative, true);
 						}
+						else
+						{
+							// The client has our level loaded, let it map the level's startup objects up front
+							UPackageMapClient* PackageMapClient = Cast<UPackageMapClient>(Connection->PackageMap);
+							if (PackageMapClient != NULL)
+							{
+								PackageMapClient->SendLevelNetGUIDs(PersistentLevel);
+							}
+						}
 
 						// @TODO FIXME - TEMP HACK? - clear queue on join
 						Connection->QueuedBytes = 0;
@@ -3898,6 +3960,20 @@ void UWorld::NotifyControlMessage(UNetConnection* Connection, uint8 MessageType,
 					*Connection->Driver->GetDescription(),*Text,*Connection->LowLevelDescribe(),*Connection->LowLevelGetRemoteAddress());
 				break;
 			}
+			case NMT_LevelNetGUIDsAck:
+			{
+				FString PackageName;
+				uint32 Checksum = 0;
+				FNetworkGUID FirstNetGUID;
+				FNetControlMessage<NMT_LevelNetGUIDsAck>::Receive(Bunch, PackageName, Checksum, FirstNetGUID);
+
+				UPackageMapClient* PackageMapClient = Cast<UPackageMapClient>(Connection->PackageMap);
+				if (PackageMapClient != NULL && !Bunch.IsError())
+				{
+					PackageMapClient->ReceivedLevelNetGUIDsAck(PackageName, Checksum, FirstNetGUID);
+				}
+				break;
+			}
 		}
 	}
 }
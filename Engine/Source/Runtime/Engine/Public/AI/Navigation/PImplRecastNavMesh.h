@@ -70,9 +70,10 @@ public:
 	/**
 	 * Serialization.
 	 * @param Ar - The archive with which to serialize.
+	 * @param NavMeshVersion - version of the owner's navmesh data
 	 * @returns true if serialization was successful.
 	 */
-	void Serialize(FArchive& Ar);
+	void Serialize(FArchive& Ar, uint32 NavMeshVersion);
 
 	/** Debug rendering. */
 	void GetDebugGeometry(FRecastDebugGeometry& OutGeometry, int32 TileIndex = INDEX_NONE) const;
@@ -101,8 +102,10 @@ public:
 	/** Supported queries */
 
 	// @TODONAV
-	/** Generates path from the given query. Synchronous. */
-	ENavigationQueryResult::Type FindPath(const FVector& StartLoc, const FVector& EndLoc, FNavMeshPath& Path, const FNavigationQueryFilter& Filter, const UObject* Owner) const;
+	/** Generates path from the given query. Synchronous.
+	 *	@param bUseClusterGraph - search the cluster graph first and look for the polygon path only in the clusters it goes through,
+	 *		falls back to the regular search if the cluster graph wasn't built or the refined search doesn't reach the end */
+	ENavigationQueryResult::Type FindPath(const FVector& StartLoc, const FVector& EndLoc, FNavMeshPath& Path, const FNavigationQueryFilter& Filter, const UObject* Owner, bool bUseClusterGraph = false) const;
 
 	/** Check if path exists */
 	ENavigationQueryResult::Type TestPath(const FVector& StartLoc, const FVector& EndLoc, const FNavigationQueryFilter& Filter, const UObject* Owner, int32* NumVisitedNodes = 0) const;
@@ -198,6 +201,29 @@ public:
 
 	float GetTotalDataSize() const;
 
+	//----------------------------------------------------------------------//
+	// Tile streaming
+	//----------------------------------------------------------------------//
+
+	/** Keeps a compressed copy of every tile loaded with the navmesh, so they can be detached when no one is around */
+	void InitTileStreaming();
+
+	/** Picks streamed tiles closest to Sources (within Radius, as long as decompressed tiles fit in MemoryBudget bytes, 0 = no limit) to be attached.
+	 *	@return true if UpdateTileStreaming has tiles to attach or detach */
+	bool UpdateWantedStreamedTiles(const TArray<FVector>& Sources, float Radius, int32 MemoryBudget);
+
+	/** Detaches streamed tiles not picked by last UpdateWantedStreamedTiles call and attaches picked ones, closest first, at most MaxTilesToAttach
+	 *	per call (0 = no limit). Changes DetourNavMesh, no query can be running on it. Indices of changed tiles are added to out arrays. */
+	void UpdateTileStreaming(int32 MaxTilesToAttach, TArray<uint32>& OutAttachedTiles, TArray<uint32>& OutDetachedTiles);
+
+	/** Attaches all streamed tiles back and drops their compressed copies, no query can be running on DetourNavMesh. Indices of attached tiles are added to OutAttachedTiles */
+	void StopTileStreaming(TArray<uint32>& OutAttachedTiles);
+
+	FORCEINLINE bool IsStreamingTiles() const { return StreamedTiles.Num() > 0; }
+	FORCEINLINE int32 GetNumStreamedTiles() const { return StreamedTiles.Num(); }
+	FORCEINLINE int32 GetNumAttachedStreamedTiles() const { return AttachedStreamedTiles.Num(); }
+	FORCEINLINE int32 GetStreamedTilesCompressedSize() const { return StreamedTilesCompressedSize; }
+
 	/** Called on world origin changes */
 	void ApplyWorldOffset(const FVector& InOffset, bool bWorldShift);
 
@@ -217,6 +243,64 @@ public:
 	/** Helper function to serialize a single Recast tile. */
 	static void SerializeRecastMeshTile(FArchive& Ar, unsigned char*& TileData, int32& TileDataSize);
 
+	/** Compressed copy of a navmesh tile, attached to DetourNavMesh only when needed */
+	struct FStreamedTile
+	{
+		dtTileRef TileRef;
+		FIntPoint Coord;
+		int32 Layer;
+		/** Unreal coords */
+		FBox Bounds;
+		/** size of tile data once attached */
+		int32 TileDataSize;
+		/** size of serialized tile (SerializeRecastMeshTile) compressed in CompressedData */
+		int32 UncompressedSize;
+		TArray<uint8> CompressedData;
+		/** world offset applied to navmesh since tile was compressed, Recast coords */
+		FVector PendingOffset;
+		/** UpdateWantedStreamedTiles call that wanted this tile attached */
+		uint32 WantedStamp;
+		bool bAttached;
+
+		FStreamedTile() : TileRef(0), Coord(0, 0), Layer(0), Bounds(0), TileDataSize(0), UncompressedSize(0), PendingOffset(0.f), WantedStamp(0), bAttached(false) {}
+
+		friend FArchive& operator<<(FArchive& Ar, FStreamedTile& Tile);
+	};
+
+	/** Compresses tile data (not freed) into a streamed tile */
+	static bool CompressStreamedTile(const dtMeshTile* Tile, dtTileRef TileRef, bool bForceByteSwapping, FStreamedTile& OutStreamedTile);
+	
+	/** Adds streamed tile to store, attached or not */
+	void AddStreamedTile(FStreamedTile& StreamedTile);
+
+	/** Decompresses streamed tile and adds it to DetourNavMesh. @return false if tile can't be attached */
+	bool AttachStreamedTile(FStreamedTile& StreamedTile);
+
+	/** Removes streamed tile from DetourNavMesh, compressed copy stays in store */
+	void DetachStreamedTile(FStreamedTile& StreamedTile);
+
+	/** Drops all streamed tiles */
+	void ReleaseStreamedTiles();
+
+	/** Streamed tiles of the navmesh */
+	TArray<FStreamedTile> StreamedTiles;
+
+	/** Indices in StreamedTiles per tile grid coords */
+	TMultiMap<FIntPoint, int32> StreamedTilesGrid;
+
+	/** Indices in StreamedTiles of attached tiles */
+	TArray<int32> AttachedStreamedTiles;
+
+	/** Indices in StreamedTiles of tiles picked by UpdateWantedStreamedTiles, closest first */
+	TArray<int32> WantedStreamedTiles;
+
+	/** Tiles loaded with navmesh, taken over by InitTileStreaming */
+	TArray<dtTileRef> LoadedTileRefs;
+
+	uint32 TileStreamingStamp;
+	int32 AttachedStreamedTilesSize;
+	int32 StreamedTilesCompressedSize;
+
 	/** Initialize data for pathfinding */
 	bool InitPathfinding(const FVector& UnrealStart, const FVector& UnrealEnd, 
 		const dtNavMeshQuery& Query, const dtQueryFilter* Filter,
@@ -237,4 +321,58 @@ public:
 	void GetEdgesForPathCorridorImpl(const TArray<NavNodeRef>* PathCorridor, TArray<FNavigationPortalEdge>* PathCorridorEdges, const dtNavMeshQuery& NavQuery) const;
 };
 
+/** 
+ *	Navmesh queries used by the queries run on the current (non game) thread while the context is in scope.
+ *	Off the game thread every query otherwise sets up its own dtNavMeshQuery, allocating its node pool each time;
+ *	a worker running a batch of queries keeps a context alive to reuse them. Queries only read the navmesh, so every 
+ *	worker having its own context is all it takes to run them in parallel.
+ *	Outermost queries on the game thread always use FPImplRecastNavMesh::SharedNavQuery, even with a context in scope.
+ */
+class ENGINE_API FRecastNavMeshQueryContext : public FNoncopyable
+{
+public:
+	FRecastNavMeshQueryContext();
+	~FRecastNavMeshQueryContext();
+
+	/** 
+	 *	Picks the dtNavMeshQuery of a query for as long as it's in scope. Queries running from inside another one (e.g. string pulling
+	 *	done while finding a path) get a query of their own, so initializing it doesn't wipe the node pool and link filter of the outer one.
+	 */
+	class ENGINE_API FScopedNavQuery : public FNoncopyable
+	{
+	public:
+		/** @param GameThreadQuery query used on the game thread when no other query is in scope there */
+		explicit FScopedNavQuery(dtNavMeshQuery& GameThreadQuery);
+		~FScopedNavQuery();
+
+		dtNavMeshQuery& Get() const
+		{
+			return *NavQuery;
+		}
+
+	private:
+		/** query used when neither the game thread's shared query nor a context's one is available */
+		dtNavMeshQuery PrivateQuery;
+		dtNavMeshQuery* NavQuery;
+
+		/** context whose query is used, NULL on the game thread or without a context */
+		FRecastNavMeshQueryContext* Context;
+	};
+
+private:
+	/** queries of this context, indexed by nesting depth, created as deeper queries need them */
+	TIndirectArray<dtNavMeshQuery> NavQueries;
+
+	/** number of queries of this context in scope */
+	int32 Depth;
+
+	/** context this one hides, restored when it goes out of scope */
+	FRecastNavMeshQueryContext* PreviousContext;
+
+	static uint32 TlsSlot;
+
+	/** number of queries in scope on the game thread */
+	static int32 GameThreadDepth;
+};
+
 #endif	// WITH_RECAST
@@ -106,6 +106,37 @@ struct FRecastGeometryCache
 	FRecastGeometryCache(const uint8* Memory);
 };
 
+/** Parts of a FRecastGeometryCache clipped to tile boxes, one entry per tile and agent stored one after another */
+struct FRecastClippedGeometryCache
+{
+	struct FTileInfo
+	{
+		/** recast coords of the box the geometry was clipped to, entry is replaced when tile's box changes */
+		FVector ClipMin;
+		FVector ClipMax;
+		int32 TileX;
+		int32 TileY;
+		/** index of the supported agent, navmeshes of different agents share tile coords */
+		int32 AgentIndex;
+		int32 NumVerts;
+		int32 NumFaces;
+	};
+
+	/** info of the tile found, NULL if the geometry wasn't clipped for this tile and agent yet */
+	const FTileInfo* Tile;
+
+	/** indices of the kept vertices in FRecastGeometryCache::Verts (size: NumVerts) */
+	const int32* VertIndices;
+
+	/** vert indices for the kept triangles, into VertIndices (size: NumFaces * 3) */
+	const int32* Indices;
+
+	FRecastClippedGeometryCache(const uint8* Memory, int32 TileX, int32 TileY, int32 AgentIndex);
+
+	/** @return size of tile's entry */
+	FORCEINLINE int32 GetTileDataSize() const { return Tile ? sizeof(FTileInfo) + sizeof(int32) * (Tile->NumVerts + Tile->NumFaces * 3) : 0; }
+};
+
 struct FRecastRawGeometryElement
 {
 	// Instance geometry
@@ -132,6 +163,7 @@ struct FRecastAreaNavModifierElement
 class ENGINE_API FRecastTileGenerator : public FNonAbandonableTask
 {
 	friend FRecastNavMeshGenerator;
+	friend class FRecastTileLayerTask;
 
 public:
 	FRecastTileGenerator(const FRecastNavMeshGenerator& ParentGenerator, const FIntPoint& Location);
@@ -171,9 +203,12 @@ protected:
 	/** builds CompressedLayers array (geometry + modifiers) */
 	virtual bool GenerateCompressedLayers(FNavMeshBuildContext& BuildContext);
 
-	/** builds NavigationData array (layers + obstacles) */
+	/** builds NavigationData array (layers + obstacles), dirty layers are built in parallel (ai.NavTileParallelLayers) */
 	bool GenerateNavigationData(FNavMeshBuildContext& BuildContext);
 
+	/** builds navigation data of a single layer, safe to call for different layers at the same time */
+	bool GenerateNavigationDataLayer(FNavMeshBuildContext& BuildContext, int32 LayerIdx, FNavMeshTileData& OutNavData);
+
 	void ApplyVoxelFilter(struct rcHeightfield* SolidHF, float WalkableRadius);
 
 	/** apply areas from DynamicAreas to layer */
@@ -181,8 +216,12 @@ protected:
 	void MarkDynamicArea(const FAreaNavModifier& Modifier, const FTransform& LocalToWorld, dtTileCacheLayer& Layer);
 	
 	void AppendModifier(const FCompositeNavModifier& Modifier, const FNavDataPerInstanceTransformDelegate& InTransformsDelegate);
+	/** Appends geometry of octree element to tile's geometry, clipped to tile when ai.NavTileGeometryClipping is set */
+	void AppendElementGeometry(const FNavigationRelevantData& ElementData);
 	/** Appends specified geometry to tile's geometry */
 	void AppendGeometry(const TNavStatArray<uint8>& RawCollisionCache, const FNavDataPerInstanceTransformDelegate& InTransformsDelegate);
+	/** Appends the triangles of specified geometry that can reach tile's heightfield, clipping them once per tile and caching the result in Data */
+	void AppendClippedGeometry(FNavigationRelevantData& Data, const FVector& ClipMin, const FVector& ClipMax);
 	void AppendVoxels(rcSpanCache* SpanData, int32 NumSpans);
 	
 	/** prepare voxel cache from collision data */
@@ -190,6 +229,9 @@ protected:
 	bool HasVoxelCache(const TNavStatArray<uint8>& RawVoxelCache, rcSpanCache*& CachedVoxels, int32& NumCachedVoxels) const;
 	void AddVoxelCache(TNavStatArray<uint8>& RawVoxelCache, const rcSpanCache* CachedVoxels, const int32 NumCachedVoxels) const;
 
+	/** clip collision data to box (recast coords) and store the kept triangles as the entry of this tile and agent, replacing the previous one */
+	void AddClippedGeometryCache(TNavStatArray<uint8>& RawClippedCache, const TNavStatArray<uint8>& RawCollisionCache, const FVector& ClipMin, const FVector& ClipMax) const;
+
 protected:
 	uint32 bSucceeded : 1;
 	uint32 bRegenerateCompressedLayers : 1;
@@ -404,7 +446,7 @@ protected:
 	// Updates cached list of navigation bounds
 	void UpdateNavigationBounds();
 		
-	// Sorts pending build tiles by proximity to player, so tiles closer to player will get generated first
+	// Sorts pending build tiles by proximity to agents and generation seeds, so tiles closer to them will get generated first
 	void SortPendingBuildTiles();
 
 	/** Instantiates dtNavMesh and configures it for tiles generation. Returns false if failed */
@@ -416,8 +458,9 @@ protected:
 	/** Marks grid tiles affected by specified areas as dirty */
 	void MarkDirtyTiles(const TArray<FNavigationDirtyArea>& DirtyAreas);
 	
-	/** Processes pending tile generattion tasks */
-	TArray<uint32> ProcessTileTasks(const int32 NumTasksToSubmit);
+	/** Processes pending tile generattion tasks 
+	 *	@param AttachTimeBudget - time (seconds) that can be spent adding generated tiles to navmesh, at least one is added. 0 means no limit */
+	TArray<uint32> ProcessTileTasks(const int32 NumTasksToSubmit, const double AttachTimeBudget = 0.0);
 
 	/** Adds generated tiles to NavMesh, replacing old ones */
 	TArray<uint32> AddGeneratedTiles(const FRecastTileGenerator& TileGenerator);
@@ -444,6 +487,9 @@ private:
 	int32 MaxTileGeneratorTasks;
 	float AvgLayersPerTile;
 
+	/** Time left until pending tiles are sorted again to match agents' positions */
+	float SortPendingTilesTimeLeft;
+
 	/** Total bounding box that includes all volumes, in unreal units. */
 	FBox TotalNavBounds;
 
@@ -35,6 +35,9 @@ struct ENGINE_API FNavigationRelevantData
 	/** cached voxels (used by recast navmesh as FRecastVoxelCache) */
 	TNavStatArray<uint8> VoxelData;
 
+	/** exported geometry clipped to navmesh tiles, indexing into CollisionData (used by recast navmesh as FRecastClippedGeometryCache) */
+	TNavStatArray<uint8> ClippedGeometryData;
+
 	/** bounds of geometry (unreal coords) */
 	FBox Bounds;
 
@@ -50,7 +53,7 @@ struct ENGINE_API FNavigationRelevantData
 	FORCEINLINE bool HasGeometry() const { return VoxelData.Num() || CollisionData.Num(); }
 	FORCEINLINE bool HasModifiers() const { return !Modifiers.IsEmpty(); }
 	FORCEINLINE bool IsEmpty() const { return !HasGeometry() && !HasModifiers(); }
-	FORCEINLINE uint32 GetAllocatedSize() const { return CollisionData.GetAllocatedSize() + VoxelData.GetAllocatedSize() + Modifiers.GetAllocatedSize(); }
+	FORCEINLINE uint32 GetAllocatedSize() const { return CollisionData.GetAllocatedSize() + VoxelData.GetAllocatedSize() + ClippedGeometryData.GetAllocatedSize() + Modifiers.GetAllocatedSize(); }
 	FORCEINLINE int32 GetDirtyFlag() const
 	{
 		return (HasGeometry() ? ENavigationDirtyFlag::Geometry : 0) |
@@ -0,0 +1,188 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	CollisionQueryBatch.h: Batched scene queries against a world's physics scene.
+=============================================================================*/
+
+#pragma once
+
+#include "WorldCollision.h"
+
+/** Types of queries a FCollisionQueryBatch can hold */
+namespace ECollisionBatchQuery
+{
+	enum Type
+	{
+		Raycast,
+		Sweep,
+		Overlap
+	};
+};
+
+/**
+ * A batch of raycasts, sweeps and overlaps that share the same channel and query params,
+ * submitted to the physics scene together instead of one scene query call at a time.
+ *
+ * Query inputs are stored in flat arrays indexed by the query index returned when the query is added.
+ * Raycasts and sweeps report their closest blocking hit (like RaycastSingle / GeomSweepSingle), overlaps report
+ * every overlapping component (like GeomOverlapMulti). Results are flat arrays too, and nothing is freed by Reset(),
+ * so a batch that is refilled every frame stops allocating once it reached its working size.
+ *
+ * Usage:
+ *		Batch.Init(ECC_Visibility, FCollisionQueryParams(TraceTag, true, IgnoredActor));
+ *		for (...) { Batch.AddRaycast(Start, End); }
+ *		Batch.Execute(World);
+ *		for (...) { if (Batch.GetHit(QueryIndex).bBlockingHit) ... }
+ */
+class ENGINE_API FCollisionQueryBatch : public FNoncopyable
+{
+public:
+	FCollisionQueryBatch();
+	~FCollisionQueryBatch();
+
+	/**
+	 * Sets the collision settings used by all queries of the batch, and removes all queries
+	 *
+	 * @param InTraceChannel	Channel of the queries, ignored when InObjectParams is valid
+	 * @param InParams			Query params, the same as for the single query functions
+	 * @param InResponseParams	Response of the queries to each channel
+	 * @param InObjectParams	Object types to query for, turns all queries into object queries when valid
+	 */
+	void Init(ECollisionChannel InTraceChannel, const FCollisionQueryParams& InParams, const FCollisionResponseParams& InResponseParams = FCollisionResponseParams::DefaultResponseParam, const FCollisionObjectQueryParams& InObjectParams = FCollisionObjectQueryParams::DefaultObjectQueryParam);
+
+	/** Removes all queries and results, keeping the allocated memory */
+	void Reset();
+
+	/** @return Index of the new raycast from Start to End */
+	int32 AddRaycast(const FVector& Start, const FVector& End);
+
+	/** @return Index of the new sweep of Shape from Start to End. Nearly zero shapes are traced as rays */
+	int32 AddSweep(const FVector& Start, const FVector& End, const FQuat& Rot, const FCollisionShape& Shape);
+
+	/** @return Index of the new overlap test of Shape at Pos */
+	int32 AddOverlap(const FVector& Pos, const FQuat& Rot, const FCollisionShape& Shape);
+
+	/** Runs all queries on the calling thread, results are available on return */
+	void Execute(const UWorld* World);
+
+	/**
+	 * Runs the queries on task graph worker threads, split into chunks of p.CollisionQueryBatchChunkSize queries.
+	 * The batch must not be modified or read until the returned event completed (see WaitForExecution).
+	 */
+	FGraphEventRef ExecuteAsync(const UWorld* World);
+
+	/** Blocks until the last ExecuteAsync is complete */
+	void WaitForExecution();
+
+	/** @return true while an ExecuteAsync is in flight */
+	bool IsExecuting() const
+	{
+		return PendingExecution.GetReference() && !PendingExecution->IsComplete();
+	}
+
+	/** @return Number of queries in the batch */
+	int32 Num() const
+	{
+		return QueryTypes.Num();
+	}
+
+	/** @return Type of the given query */
+	ECollisionBatchQuery::Type GetQueryType(int32 QueryIndex) const
+	{
+		return (ECollisionBatchQuery::Type)QueryTypes[QueryIndex];
+	}
+
+	/**
+	 * @return Closest blocking hit of a raycast or sweep. bBlockingHit is false if nothing was hit.
+	 * For overlaps, bBlockingHit tells whether any of the overlaps is blocking.
+	 */
+	const FHitResult& GetHit(int32 QueryIndex) const
+	{
+		return Hits[QueryIndex];
+	}
+
+	/** @return Number of components found by an overlap query */
+	int32 GetNumOverlaps(int32 QueryIndex) const
+	{
+		return OverlapRanges[QueryIndex].Num;
+	}
+
+	/** @return Overlap result OverlapIndex of an overlap query */
+	const FOverlapResult& GetOverlap(int32 QueryIndex, int32 OverlapIndex) const
+	{
+		checkSlow(OverlapIndex >= 0 && OverlapIndex < OverlapRanges[QueryIndex].Num);
+		return Overlaps[OverlapRanges[QueryIndex].First + OverlapIndex];
+	}
+
+	/** @return All hits, one per query */
+	const TArray<FHitResult>& GetHits() const
+	{
+		return Hits;
+	}
+
+	/** @return Results of all overlap queries, in query order */
+	const TArray<FOverlapResult>& GetOverlaps() const
+	{
+		return Overlaps;
+	}
+
+private:
+	/** Appends a query to the input arrays */
+	int32 AddQuery(ECollisionBatchQuery::Type Type, const FVector& Start, const FVector& End, const FQuat& Rot, const FCollisionShape& Shape);
+
+	/** Sizes the result buffers and sets up the PhysX batch queries of InNumChunks chunks of InChunkSize queries */
+	void PrepareExecution(const UWorld* World, int32 InNumChunks, int32 InChunkSize);
+
+	/** Runs queries [FirstQuery, FirstQuery + NumQueries) with the PhysX batch query and buffers of chunk ChunkIndex */
+	void ExecuteChunk(int32 ChunkIndex, int32 FirstQuery, int32 NumQueries);
+
+	/** Copies the overlaps of all chunks into Overlaps, once all chunks are done */
+	void GatherOverlaps();
+
+	friend class FCollisionQueryBatchChunkTask;
+	friend class FCollisionQueryBatchGatherTask;
+
+	/** Range of Overlaps holding the results of one overlap query */
+	struct FOverlapRange
+	{
+		int32 First;
+		int32 Num;
+	};
+
+	/** Collision settings shared by every query */
+	ECollisionChannel TraceChannel;
+	FCollisionQueryParams Params;
+	FCollisionResponseParams ResponseParams;
+	FCollisionObjectQueryParams ObjectParams;
+
+	/** Query inputs, indexed by query index. Overlaps store their position in Starts */
+	TArray<uint8> QueryTypes;
+	TArray<FVector> Starts;
+	TArray<FVector> Ends;
+	TArray<FQuat> Rotations;
+	TArray<FCollisionShape> Shapes;
+
+	/** Index of each query among the queries of its type, which is where PhysX puts its result */
+	TArray<int32> TypeIndices;
+
+	/** Number of queries of each type */
+	int32 NumQueriesOfType[3];
+
+	/** Results, indexed by query index */
+	TArray<FHitResult> Hits;
+	TArray<FOverlapRange> OverlapRanges;
+	TArray<FOverlapResult> Overlaps;
+
+	/** Overlaps found by each chunk, OverlapRanges are relative to them until GatherOverlaps */
+	TArray<TArray<FOverlapResult>> ChunkOverlaps;
+
+	/** How the queries were split for the last execution */
+	int32 NumChunks;
+	int32 ChunkSize;
+
+	/** PhysX result buffers, kept between executions */
+	TUniquePtr<struct FCollisionQueryBatchBuffers> Buffers;
+
+	/** Completion event of the last ExecuteAsync */
+	FGraphEventRef PendingExecution;
+};
@@ -682,6 +682,24 @@ public:
 	 */
 	void RemoveElement(FOctreeElementId ElementId);
 
+	/**
+	 * Replaces an element with an updated copy, typically one with different bounds.
+	 * The element stays in its node and keeps its ID if its new bounds still fit in the node's loose bounds and none of the node's
+	 * children could hold it. Otherwise it moves to the closest node that contains its new bounds, without searching from the root.
+	 * @param ElementId - The element to update.
+	 * @param NewElement - The updated element.
+	 */
+	void RelocateElement(FOctreeElementId ElementId, typename TTypeTraits<ElementType>::ConstInitType NewElement);
+
+	/**
+	 * Relocates several elements, see RelocateElement.
+	 * The elements that leave their node are all removed first and then added back sorted by destination node, and the nodes
+	 * left underpopulated are collapsed once at the end instead of after every removal.
+	 * @param ElementIds - The elements to update, each one at most once.
+	 * @param NewElements - The updated elements, in the same order as ElementIds.
+	 */
+	void RelocateElements(const TArray<FOctreeElementId>& ElementIds, const TArray<ElementType>& NewElements);
+
 	void Destroy()
 	{
 		RootNode.~FNode();
@@ -753,6 +771,34 @@ private:
 		const FNode& InNode,
 		const FOctreeNodeContext& InContext
 		);
+
+	/** The nodes on the path from the root to a node, and their contexts. */
+	typedef TArray<const FNode*,TInlineAllocator<16> > FNodePath;
+	typedef TArray<FOctreeNodeContext,TInlineAllocator<16> > FNodePathContexts;
+
+	/** Gathers the nodes from the root down to Node, and computes their contexts. */
+	void GetNodePath(const FNode* Node,FNodePath& OutPath,FNodePathContexts& OutContexts) const;
+
+	/**
+	 * Finds where an element with the given bounds belongs on the path to its current node.
+	 * @return The index in Path of the closest node whose loose bounds contain the element, the root if none does.
+	 */
+	static int32 FindRelocationNode(const FNodePath& Path,const FNodePathContexts& Contexts,const FBoxCenterAndExtent& ElementBounds);
+
+	/** @return true if an element relocated to the last node of Path can stay in its element list. */
+	static bool CanKeepElementInNode(const FNodePath& Path,const FNodePathContexts& Contexts,int32 RelocationNodeIndex,const FBoxCenterAndExtent& ElementBounds);
+
+	/**
+	 * Removes an element from its node's element list, and decrements the inclusive element counts from its node up to LastNode.
+	 * @param LastNode - The last node to update the count of, NULL to go up to the root.
+	 */
+	void RemoveElementFromNode(FOctreeElementId ElementId,const FNode* LastNode);
+
+	/** @return The largest node from Node up to (excluding) StopNode that is small enough to collapse, or NULL. */
+	static const FNode* FindCollapseNode(const FNode* Node,const FNode* StopNode);
+
+	/** Moves the elements of a node's children into the node, and frees the children. */
+	void CollapseNode(const FNode* Node);
 };
 
 #include "GenericOctree.inl"
@@ -187,6 +187,20 @@ void TOctree<ElementType,OctreeSemantics>::RemoveElement(FOctreeElementId Elemen
 {
 	check(ElementId.IsValidId()); 
 
+	const FNode* ElementIdNode = (const FNode*)ElementId.Node;
+	RemoveElementFromNode(ElementId,NULL);
+
+	// Collapse the largest node that was pushed below the threshold for collapse by the removal.
+	const FNode* NodeToCollapse = FindCollapseNode(ElementIdNode,NULL);
+	if(NodeToCollapse)
+	{
+		CollapseNode(NodeToCollapse);
+	}
+}
+
+template<typename ElementType,typename OctreeSemantics>
+void TOctree<ElementType,OctreeSemantics>::RemoveElementFromNode(FOctreeElementId ElementId,const FNode* LastNode)
+{
 	FNode* ElementIdNode = (FNode*)ElementId.Node;
 
 	// Remove the element from the node's element list.
@@ -200,65 +214,270 @@ void TOctree<ElementType,OctreeSemantics>::RemoveElement(FOctreeElementId Elemen
 		OctreeSemantics::SetElementId(ElementIdNode->Elements[ElementId.ElementIndex],ElementId);
 	}
 
-	// Update the inclusive element counts for the nodes between the element and the root node,
-	// and find the largest node that is small enough to collapse.
-	const FNode* CollapseNode = NULL;
+	// Update the inclusive element counts for the nodes between the element and the last node.
 	for(const FNode* Node = ElementIdNode;Node;Node = Node->Parent)
 	{
 		--Node->InclusiveNumElements;
-		if(Node->InclusiveNumElements < OctreeSemantics::MinInclusiveElementsPerNode)
+		if(Node == LastNode)
 		{
-			CollapseNode = Node;
+			break;
 		}
 	}
+}
 
-	// Collapse the largest node that was pushed below the threshold for collapse by the removal.
-	if(CollapseNode)
+template<typename ElementType,typename OctreeSemantics>
+const typename TOctree<ElementType,OctreeSemantics>::FNode* TOctree<ElementType,OctreeSemantics>::FindCollapseNode(const FNode* Node,const FNode* StopNode)
+{
+	const FNode* Result = NULL;
+	for(;Node && Node != StopNode;Node = Node->Parent)
 	{
-		// Gather the elements contained in this node and its children.
-		TArray<ElementType,TInlineAllocator<OctreeSemantics::MaxElementsPerLeaf> > CollapsedChildElements;
-		CollapsedChildElements.Empty(CollapseNode->InclusiveNumElements);
-		for(TConstIterator<> ChildNodeIt(*CollapseNode,RootNodeContext);ChildNodeIt.HasPendingNodes();ChildNodeIt.Advance())
+		if(Node->InclusiveNumElements < OctreeSemantics::MinInclusiveElementsPerNode)
 		{
-			const FNode& ChildNode = ChildNodeIt.GetCurrentNode();
+			Result = Node;
+		}
+	}
+	return Result;
+}
 
-			// Add the child's elements to the collapsed element list.
-			for(ElementConstIt ElementIt(ChildNode.Elements);ElementIt;++ElementIt)
-			{
-				const int32 NewElementIndex = CollapsedChildElements.Add(*ElementIt);
+template<typename ElementType,typename OctreeSemantics>
+void TOctree<ElementType,OctreeSemantics>::CollapseNode(const FNode* NodeToCollapse)
+{
+	// Gather the elements contained in this node and its children.
+	TArray<ElementType,TInlineAllocator<OctreeSemantics::MaxElementsPerLeaf> > CollapsedChildElements;
+	CollapsedChildElements.Empty(NodeToCollapse->InclusiveNumElements);
+	for(TConstIterator<> ChildNodeIt(*NodeToCollapse,RootNodeContext);ChildNodeIt.HasPendingNodes();ChildNodeIt.Advance())
+	{
+		const FNode& ChildNode = ChildNodeIt.GetCurrentNode();
 
-				// Update the external element id for the element that's being collapsed.
-				OctreeSemantics::SetElementId(*ElementIt,FOctreeElementId(CollapseNode,NewElementIndex));
-			}
+		// Add the child's elements to the collapsed element list.
+		for(ElementConstIt ElementIt(ChildNode.Elements);ElementIt;++ElementIt)
+		{
+			const int32 NewElementIndex = CollapsedChildElements.Add(*ElementIt);
+
+			// Update the external element id for the element that's being collapsed.
+			OctreeSemantics::SetElementId(*ElementIt,FOctreeElementId(NodeToCollapse,NewElementIndex));
+		}
 
-			// Recursively visit all child nodes.
-			FOREACH_OCTREE_CHILD_NODE(ChildRef)
+		// Recursively visit all child nodes.
+		FOREACH_OCTREE_CHILD_NODE(ChildRef)
+		{
+			if(ChildNode.HasChild(ChildRef))
 			{
-				if(ChildNode.HasChild(ChildRef))
-				{
-					ChildNodeIt.PushChild(ChildRef);
-				}
+				ChildNodeIt.PushChild(ChildRef);
 			}
 		}
+	}
+
+	// Replace the node's elements with the collapsed element list.
+	Exchange(NodeToCollapse->Elements,CollapsedChildElements);
 
-		// Replace the node's elements with the collapsed element list.
-		Exchange(CollapseNode->Elements,CollapsedChildElements);
+	// Mark the node as a leaf.
+	NodeToCollapse->bIsLeaf = true;
+
+	// Free the child nodes.
+	FOREACH_OCTREE_CHILD_NODE(ChildRef)
+	{
+		if (NodeToCollapse->Children[ChildRef.Index])
+		{
+			SetOctreeMemoryUsage(this, TotalSizeBytes - sizeof(*NodeToCollapse->Children[ChildRef.Index]));
+		}
 
-		// Mark the node as a leaf.
-		CollapseNode->bIsLeaf = true;
+		delete NodeToCollapse->Children[ChildRef.Index];
+		NodeToCollapse->Children[ChildRef.Index] = NULL;
+	}
+}
 
-		// Free the child nodes.
+template<typename ElementType,typename OctreeSemantics>
+void TOctree<ElementType,OctreeSemantics>::GetNodePath(const FNode* Node,FNodePath& OutPath,FNodePathContexts& OutContexts) const
+{
+	OutPath.Reset();
+	for(;Node;Node = Node->Parent)
+	{
+		OutPath.Insert(Node,0);
+	}
+
+	OutContexts.Reset();
+	OutContexts.Add(RootNodeContext);
+	for(int32 PathIndex = 1;PathIndex < OutPath.Num();PathIndex++)
+	{
+		const FNode* Parent = OutPath[PathIndex - 1];
 		FOREACH_OCTREE_CHILD_NODE(ChildRef)
 		{
-			if (CollapseNode->Children[ChildRef.Index])
+			if(Parent->Children[ChildRef.Index] == OutPath[PathIndex])
 			{
-				SetOctreeMemoryUsage(this, TotalSizeBytes - sizeof(*CollapseNode->Children[ChildRef.Index]));
+				OutContexts.Add(OutContexts[PathIndex - 1].GetChildContext(ChildRef));
+				break;
 			}
+		}
+	}
+	check(OutContexts.Num() == OutPath.Num());
+}
 
-			delete CollapseNode->Children[ChildRef.Index];
-			CollapseNode->Children[ChildRef.Index] = NULL;
+template<typename ElementType,typename OctreeSemantics>
+int32 TOctree<ElementType,OctreeSemantics>::FindRelocationNode(const FNodePath& Path,const FNodePathContexts& Contexts,const FBoxCenterAndExtent& ElementBounds)
+{
+	const VectorRegister ElementCenter = VectorLoadAligned(&ElementBounds.Center);
+	const VectorRegister ElementExtent = VectorLoadAligned(&ElementBounds.Extent);
+
+	// Elements that don't fit in any node belong to the root.
+	int32 PathIndex = Path.Num() - 1;
+	for(;PathIndex > 0;PathIndex--)
+	{
+		// The node contains the element if, on every axis, the element's extent plus the distance between their centers is within the node's extent.
+		const FBoxCenterAndExtent& NodeBounds = Contexts[PathIndex].Bounds;
+		const VectorRegister CenterDifference = VectorAbs(VectorSubtract(ElementCenter,VectorLoadAligned(&NodeBounds.Center)));
+		if(!VectorAnyGreaterThan(VectorAdd(CenterDifference,ElementExtent),VectorLoadAligned(&NodeBounds.Extent)))
+		{
+			break;
 		}
 	}
+	return PathIndex;
+}
+
+template<typename ElementType,typename OctreeSemantics>
+bool TOctree<ElementType,OctreeSemantics>::CanKeepElementInNode(const FNodePath& Path,const FNodePathContexts& Contexts,int32 RelocationNodeIndex,const FBoxCenterAndExtent& ElementBounds)
+{
+	// An element that fits in one of the node's children would have been added to that child.
+	const int32 NodeIndex = Path.Num() - 1;
+	return RelocationNodeIndex == NodeIndex
+		&& (Path[NodeIndex]->IsLeaf() || Contexts[NodeIndex].GetContainingChild(ElementBounds).IsNULL());
+}
+
+template<typename ElementType,typename OctreeSemantics>
+void TOctree<ElementType,OctreeSemantics>::RelocateElement(FOctreeElementId ElementId, typename TTypeTraits<ElementType>::ConstInitType NewElement)
+{
+	check(ElementId.IsValidId());
+
+	FNode* ElementIdNode = (FNode*)ElementId.Node;
+	const FBoxCenterAndExtent NewBounds(OctreeSemantics::GetBoundingBox(NewElement));
+
+	FNodePath Path;
+	FNodePathContexts Contexts;
+	GetNodePath(ElementIdNode,Path,Contexts);
+
+	const int32 RelocationNodeIndex = FindRelocationNode(Path,Contexts,NewBounds);
+	if(CanKeepElementInNode(Path,Contexts,RelocationNodeIndex,NewBounds))
+	{
+		ElementIdNode->Elements[ElementId.ElementIndex] = NewElement;
+		return;
+	}
+
+	// The element counts above the relocation node don't change, and adding the element back increments its count again.
+	const FNode* RelocationNode = Path[RelocationNodeIndex];
+	RemoveElementFromNode(ElementId,RelocationNode);
+
+	const FNode* NodeToCollapse = FindCollapseNode(ElementIdNode,RelocationNode);
+	if(NodeToCollapse)
+	{
+		CollapseNode(NodeToCollapse);
+	}
+
+	AddElementToNode(NewElement,*RelocationNode,Contexts[RelocationNodeIndex]);
+}
+
+template<typename ElementType,typename OctreeSemantics>
+void TOctree<ElementType,OctreeSemantics>::RelocateElements(const TArray<FOctreeElementId>& ElementIds, const TArray<ElementType>& NewElements)
+{
+	check(ElementIds.Num() == NewElements.Num());
+
+	/** An element that leaves its node. */
+	struct FRelocation
+	{
+		FOctreeElementId ElementId;
+		int32 NewElementIndex;
+		const FNode* RelocationNode;
+		FOctreeNodeContext RelocationContext;
+	};
+	TArray<FRelocation> Relocations;
+
+	// Update the elements that stay in their node, their IDs don't change.
+	FNodePath Path;
+	FNodePathContexts Contexts;
+	for(int32 Index = 0;Index < ElementIds.Num();Index++)
+	{
+		const FOctreeElementId ElementId = ElementIds[Index];
+		check(ElementId.IsValidId());
+
+		FNode* ElementIdNode = (FNode*)ElementId.Node;
+		const FBoxCenterAndExtent NewBounds(OctreeSemantics::GetBoundingBox(NewElements[Index]));
+		GetNodePath(ElementIdNode,Path,Contexts);
+
+		const int32 RelocationNodeIndex = FindRelocationNode(Path,Contexts,NewBounds);
+		if(CanKeepElementInNode(Path,Contexts,RelocationNodeIndex,NewBounds))
+		{
+			ElementIdNode->Elements[ElementId.ElementIndex] = NewElements[Index];
+		}
+		else
+		{
+			FRelocation* Relocation = new(Relocations) FRelocation;
+			Relocation->ElementId = ElementId;
+			Relocation->NewElementIndex = Index;
+			Relocation->RelocationNode = Path[RelocationNodeIndex];
+			Relocation->RelocationContext = Contexts[RelocationNodeIndex];
+		}
+	}
+
+	if(Relocations.Num() == 0)
+	{
+		return;
+	}
+
+	// Remove the others, from the last element of each node down, so RemoveAtSwap never moves an element that still has to be removed.
+	Relocations.Sort([](const FRelocation& A,const FRelocation& B)
+	{
+		return A.ElementId.Node != B.ElementId.Node ? A.ElementId.Node < B.ElementId.Node : A.ElementId.ElementIndex > B.ElementId.ElementIndex;
+	});
+	for(int32 Index = 0;Index < Relocations.Num();Index++)
+	{
+		RemoveElementFromNode(Relocations[Index].ElementId,Relocations[Index].RelocationNode);
+	}
+
+	// Nodes left underpopulated are collapsed once all elements are back, no node is freed before that.
+	TArray<const FNode*,TInlineAllocator<16> > NodesToCollapse;
+	for(int32 Index = 0;Index < Relocations.Num();Index++)
+	{
+		const FNode* NodeToCollapse = FindCollapseNode((const FNode*)Relocations[Index].ElementId.Node,Relocations[Index].RelocationNode);
+		if(NodeToCollapse)
+		{
+			NodesToCollapse.AddUnique(NodeToCollapse);
+		}
+	}
+
+	// Add the elements back, grouped by the node they are added from.
+	Relocations.Sort([](const FRelocation& A,const FRelocation& B)
+	{
+		return A.RelocationNode != B.RelocationNode ? A.RelocationNode < B.RelocationNode : A.NewElementIndex < B.NewElementIndex;
+	});
+	for(int32 Index = 0;Index < Relocations.Num();Index++)
+	{
+		const FRelocation& Relocation = Relocations[Index];
+		AddElementToNode(NewElements[Relocation.NewElementIndex],*Relocation.RelocationNode,Relocation.RelocationContext);
+	}
+
+	// Drop the nodes that are no longer small enough, and those that go with a collapsing node above them.
+	for(int32 Index = NodesToCollapse.Num() - 1;Index >= 0;Index--)
+	{
+		if(NodesToCollapse[Index]->InclusiveNumElements >= OctreeSemantics::MinInclusiveElementsPerNode)
+		{
+			NodesToCollapse.RemoveAtSwap(Index);
+		}
+	}
+	for(int32 Index = NodesToCollapse.Num() - 1;Index >= 0;Index--)
+	{
+		for(const FNode* Parent = NodesToCollapse[Index]->Parent;Parent;Parent = Parent->Parent)
+		{
+			if(NodesToCollapse.Contains(Parent))
+			{
+				NodesToCollapse.RemoveAtSwap(Index);
+				break;
+			}
+		}
+	}
+
+	for(int32 Index = 0;Index < NodesToCollapse.Num();Index++)
+	{
+		CollapseNode(NodesToCollapse[Index]);
+	}
 }
 
 template<typename ElementType,typename OctreeSemantics>
@@ -370,8 +370,8 @@ private:
 #define IMPLEMENT_CONTROL_CHANNEL_MESSAGE(Name) static uint8 Dummy##_FNetControlMessage_##Name = FNetControlMessage<NMT_##Name>::Initialize();
 
 // message type definitions
-DEFINE_CONTROL_CHANNEL_MESSAGE_TWOPARAM(Hello, 0, uint8, uint32); // initial client connection message
-DEFINE_CONTROL_CHANNEL_MESSAGE_THREEPARAM(Welcome, 1, FString, FString, FString); // server tells client they're ok'ed to load the server's level
+DEFINE_CONTROL_CHANNEL_MESSAGE_THREEPARAM(Hello, 0, uint8, uint32, uint32); // initial client connection message (endianness, network version, packet compression dictionary checksum)
+DEFINE_CONTROL_CHANNEL_MESSAGE_FOURPARAM(Welcome, 1, FString, FString, FString, uint32); // server tells client they're ok'ed to load the server's level (and its packet compression dictionary checksum)
 DEFINE_CONTROL_CHANNEL_MESSAGE_ONEPARAM(Upgrade, 2, uint32); // server tells client their version is incompatible
 DEFINE_CONTROL_CHANNEL_MESSAGE_ONEPARAM(Challenge, 3, FString); // server sends client challenge string to verify integrity
 DEFINE_CONTROL_CHANNEL_MESSAGE_ONEPARAM(Netspeed, 4, int32); // client sends requested transfer rate
@@ -385,6 +385,8 @@ DEFINE_CONTROL_CHANNEL_MESSAGE_ONEPARAM(PCSwap, 15, int32); // client tells serv
 DEFINE_CONTROL_CHANNEL_MESSAGE_ONEPARAM(ActorChannelFailure, 16, int32); // client tells server that it failed to open an Actor channel sent by the server (e.g. couldn't serialize Actor archetype)
 DEFINE_CONTROL_CHANNEL_MESSAGE_ONEPARAM(DebugText, 17, FString); // debug text sent to all clients or to server
 DEFINE_CONTROL_CHANNEL_MESSAGE_TWOPARAM(NetGUIDAssign, 18, FNetworkGUID, FString); // Explicit NetworkGUID assignment. This is rare and only happens if a netguid is only serialized client->server (this msg goes server->client to tell client what ID to use in that case)
+DEFINE_CONTROL_CHANNEL_MESSAGE_FOURPARAM(LevelNetGUIDs, 19, FString, uint32, FNetworkGUID, int32); // server tells client the NetGUID range of a level's startup objects (package name, checksum, first NetGUID, count)
+DEFINE_CONTROL_CHANNEL_MESSAGE_THREEPARAM(LevelNetGUIDsAck, 20, FString, uint32, FNetworkGUID); // client's copy of the level matched and it mapped the range, the server can stop exporting paths for it
 
 // 			Beacon control channel flow
 // Client												Server
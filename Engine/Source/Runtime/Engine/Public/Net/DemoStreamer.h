@@ -0,0 +1,95 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	DemoStreamer.h: Pluggable storage for demo recording and playback.
+=============================================================================*/
+
+#pragma once
+
+/**
+ * Storage backend used by UDemoNetDriver.
+ * The driver owns the demo format (header, frames, checkpoints and the checkpoint index),
+ * the streamer only has to provide a seekable archive for it.
+ */
+class ENGINE_API IDemoStreamer
+{
+public:
+	virtual ~IDemoStreamer() {}
+
+	/**
+	 * Opens the named stream.
+	 *
+	 * @param StreamName	Name of the stream, interpretation is up to the streamer (file path, buffer name, ...)
+	 * @param bRecord		true to open for writing, false to open for reading
+	 * @return The archive to read from or write to, or NULL if the stream couldn't be opened
+	 */
+	virtual FArchive* StartStreaming( const FString& StreamName, bool bRecord ) = 0;
+
+	/** Closes the archive returned by StartStreaming, committing anything that was recorded */
+	virtual void StopStreaming() = 0;
+
+	/** @return The archive returned by StartStreaming, or NULL if we're not streaming */
+	virtual FArchive* GetStreamingArchive() = 0;
+};
+
+/** Creates demo streamers by name, so games and tests can plug in their own storage */
+class ENGINE_API FDemoStreamerFactory
+{
+public:
+	typedef IDemoStreamer* (*FCreateStreamerFunc)();
+
+	/** Registers a streamer under the given name, replacing any existing registration */
+	static void RegisterStreamer( const FName Name, FCreateStreamerFunc CreateFunc );
+
+	/** Removes a streamer that was added with RegisterStreamer */
+	static void UnregisterStreamer( const FName Name );
+
+	/** @return A new streamer of the given type, or an invalid pointer if no such streamer was registered */
+	static TSharedPtr< IDemoStreamer > CreateStreamer( const FName Name );
+};
+
+/** Streams demos to and from local files, the stream name is the file path */
+class ENGINE_API FLocalFileDemoStreamer : public IDemoStreamer
+{
+public:
+	FLocalFileDemoStreamer() : FileAr( NULL ) {}
+	virtual ~FLocalFileDemoStreamer();
+
+	// Begin IDemoStreamer interface
+	virtual FArchive* StartStreaming( const FString& StreamName, bool bRecord ) override;
+	virtual void StopStreaming() override;
+	virtual FArchive* GetStreamingArchive() override { return FileAr; }
+	// End IDemoStreamer interface
+
+private:
+	FArchive* FileAr;
+};
+
+/**
+ * Streams demos to and from named in-memory buffers.
+ * Buffers outlive the streamer, so a demo recorded in one session can be played back in the next one.
+ */
+class ENGINE_API FMemoryDemoStreamer : public IDemoStreamer
+{
+public:
+	FMemoryDemoStreamer() : Archive( NULL ) {}
+	virtual ~FMemoryDemoStreamer();
+
+	// Begin IDemoStreamer interface
+	virtual FArchive* StartStreaming( const FString& StreamName, bool bRecord ) override;
+	virtual void StopStreaming() override;
+	virtual FArchive* GetStreamingArchive() override { return Archive; }
+	// End IDemoStreamer interface
+
+	/** @return The contents of a stream recorded with this streamer, or NULL if there's no such stream */
+	static const TArray< uint8 >* FindStream( const FString& StreamName );
+
+	/** Frees the memory used by a recorded stream */
+	static void DiscardStream( const FString& StreamName );
+
+private:
+	/** Buffer the archive reads from or writes to, kept alive while streaming even if the stream is discarded */
+	TSharedPtr< TArray< uint8 > > Buffer;
+
+	FArchive* Archive;
+};
@@ -0,0 +1,87 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	PacketCompression.h: Optional entropy coding of net packets.
+=============================================================================*/
+
+#pragma once
+
+/**
+ * Compresses net packets with a static Huffman code trained from captured traffic (the "dictionary").
+ *
+ * Both sides of a connection must load the same dictionary. Compressed packets are marked by a trailing zero byte,
+ * which an uncompressed packet can never end with since the packet terminator bit is always set, so packets
+ * that don't get smaller are simply sent as they are.
+ */
+class ENGINE_API FNetPacketCompressor
+{
+public:
+	/** Longest code the coder will generate, this also sizes the decode table */
+	enum { MAX_CODE_LENGTH = 15 };
+
+	/** Largest packet we will decompress, anything bigger is treated as corrupt */
+	enum { MAX_UNCOMPRESSED_SIZE = 4096 };
+
+	FNetPacketCompressor();
+
+	/** @return true if a dictionary was loaded and packets can be compressed */
+	bool IsValid() const { return bIsValid; }
+
+	/** @return Checksum of the loaded dictionary, to make sure both sides use the same one */
+	uint32 GetDictionaryChecksum() const { return DictionaryChecksum; }
+
+	/** Sets up the coder from code lengths (one per byte value) as produced by BuildCodeLengths */
+	bool InitFromCodeLengths( const uint8* InCodeLengths );
+
+	/** Loads a dictionary written by SaveDictionary */
+	bool LoadDictionary( const FString& Filename );
+
+	/** Writes the code lengths of a dictionary to disk */
+	static bool SaveDictionary( const FString& Filename, const uint8* CodeLengths );
+
+	/**
+	 * Builds length limited Huffman code lengths from byte frequencies.
+	 * Every byte value gets a code, so any packet can be compressed even if it never showed up in training.
+	 */
+	static void BuildCodeLengths( const uint64* Frequencies, uint8* OutCodeLengths );
+
+	/**
+	 * Compresses a packet.
+	 *
+	 * @return true if the compressed packet (written to Out) is smaller than the original, false if the original should be sent
+	 */
+	bool Compress( const uint8* Data, int32 Count, TArray< uint8 >& Out ) const;
+
+	/** @return true if the packet was compressed by Compress */
+	static bool IsCompressedPacket( const uint8* Data, int32 Count ) { return Count > 0 && Data[Count - 1] == 0; }
+
+	/** Decompresses a packet produced by Compress, returns false if it's corrupt */
+	bool Decompress( const uint8* Data, int32 Count, TArray< uint8 >& Out ) const;
+
+private:
+	bool	bIsValid;
+	uint32	DictionaryChecksum;
+
+	/** Code length per byte value */
+	uint8	CodeLengths[256];
+
+	/** Canonical code per byte value, bit reversed so it can be written LSB first */
+	uint16	Codes[256];
+
+	/** Indexed by the next MAX_CODE_LENGTH bits of the stream, low byte is the symbol and high byte the code length */
+	TArray< uint16 > DecodeTable;
+};
+
+/** Records raw outgoing packets to Saved/NetCapture while net.PacketCapture is set, to train dictionaries from */
+class ENGINE_API FNetPacketCapture
+{
+public:
+	/** Appends a packet to the capture file if capturing is enabled */
+	static void CapturePacket( const uint8* Data, int32 Count );
+
+	/** Closes the current capture file, if any */
+	static void StopCapture();
+
+	/** Reads all packets from a capture file, returns false if the file couldn't be read */
+	static bool ReadCaptureFile( const FString& Filename, TArray< TArray< uint8 > >& OutPackets );
+};
@@ -48,7 +48,14 @@ struct ENGINE_API FNetworkVersion
 	static FIsNetworkCompatibleOverride IsNetworkCompatibleOverride;
 
 	/**
-	 * Generates a version number, that by default, is based on a checksum of the engine version + project name + project version string
+	 * Version of the engine's control messages and packet format, part of the default local network version.
+	 * Bump it when a change makes builds misparse each other's traffic, so they are rejected with NMT_Upgrade instead.
+	 *	1: NMT_Hello and NMT_Welcome carry the packet compression dictionary checksum
+	 */
+	static const uint32 EngineNetworkProtocolVersion = 1;
+
+	/**
+	 * Generates a version number, that by default, is based on a checksum of the engine version + network protocol version + project name + project version string
 	 * Game/project code can completely override what this value returns through the GetLocalNetworkVersionOverride delegate
 	 */
 	static uint32 GetLocalNetworkVersion();
@@ -0,0 +1,100 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	OverlapUpdateBatch.h: Deferred, parallel UpdateOverlaps for a tick group.
+=============================================================================*/
+
+#pragma once
+
+#include "WorldCollision.h"
+
+/**
+ * Collects the UPrimitiveComponent::UpdateOverlaps calls made on the game thread during a tick group, and runs them
+ * at the end of the group: the overlap queries of all deferred updates run on task graph worker threads, then the
+ * FOverlapInfo diffs, begin/end overlap notifies and physics volume updates are applied on the game thread in the
+ * order the updates were requested.
+ *
+ * UWorld::RunTickGroup opens the batch around every tick group when p.ParallelUpdateOverlaps is set.
+ * While deferred, OverlappingComponents of a moved component is stale until the end of the tick group.
+ * Overlap queries see the scene as it is when the batch is flushed; a component moved again by a notify
+ * dispatched during the flush is queried again on the game thread.
+ */
+class ENGINE_API FOverlapUpdateBatch : public FNoncopyable
+{
+public:
+	/** Starts deferring the overlap updates of World's components, if p.ParallelUpdateOverlaps is set. Game thread only */
+	static void Open(UWorld* World);
+
+	/** Runs the overlap updates deferred since Open and stops deferring. Does nothing if the batch isn't open */
+	static void Flush();
+
+	/**
+	 * Defers the overlap update of Component (not of its children, they defer their own update) if the batch is open for its world.
+	 * Repeated updates of a component are merged into its first one.
+	 *
+	 * @return false if the batch isn't open for Component, in which case its overlaps must be updated right away
+	 */
+	static bool Defer(UPrimitiveComponent* Component, TArray<FOverlapInfo> const* PendingOverlaps, bool bDoNotifies, const TArray<FOverlapInfo>* OverlapsAtEndLocation);
+
+private:
+	/** An overlap update waiting for the batch to be flushed */
+	struct FDeferredUpdate
+	{
+		TWeakObjectPtr<UPrimitiveComponent> Component;
+
+		/** Overlaps found by the sweeps of the deferred moves, dispatched before the update */
+		TArray<FOverlapInfo> PendingOverlaps;
+
+		/** Overlaps at the end of the last move, known without a query (see OverlapsAtEndLocation of UpdateOverlaps) */
+		TArray<FOverlapInfo> OverlapsAtEndLocation;
+		bool bHasOverlapsAtEndLocation;
+
+		bool bDoNotifies;
+
+		/** Whether QueryResults were queried during the flush */
+		bool bQueried;
+
+		/** Where the component was when its overlaps were queried or cached, they are stale if it moved since */
+		FVector Location;
+		FRotator Rotation;
+
+		/** Query inputs and results, owned by the worker running the query while in flight */
+		FComponentQueryParams QueryParams;
+		TArray<FOverlapResult> QueryResults;
+
+		FDeferredUpdate(UPrimitiveComponent* InComponent)
+			: Component(InComponent)
+			, bHasOverlapsAtEndLocation(false)
+			, bDoNotifies(false)
+			, bQueried(false)
+			, Location(FVector::ZeroVector)
+			, Rotation(FRotator::ZeroRotator)
+		{
+		}
+	};
+
+	/** Runs the queries of Updates [First, First + Num) */
+	void RunQueries(int32 First, int32 Num);
+
+	friend class FOverlapUpdateBatchTask;
+
+	/** World the batch is open for, NULL when closed */
+	UWorld* World;
+
+	/** Deferred updates, in the order they were first requested */
+	TArray<FDeferredUpdate> Updates;
+
+	/** Index in Updates of each component's update */
+	TMap<UPrimitiveComponent*, int32> UpdateIndices;
+
+	/** Indices in Updates of the updates that need a query */
+	TArray<int32> QueryIndices;
+
+	FOverlapUpdateBatch()
+		: World(NULL)
+	{
+	}
+
+	/** The batch of the game thread */
+	static FOverlapUpdateBatch& Get();
+};
@@ -243,6 +243,14 @@ private:
 	TArray<FPhysPendingCommand> PendingCommands;
 };
 
+/** Position and velocity of a simulated body at the end of a physics step */
+struct FSimulatedBodyState
+{
+	FTransform Transform;
+	FVector LinearVelocity;
+	FVector AngularVelocity;
+};
+
 /** Container object for a physics engine 'scene'. */
 
 class FPhysScene
@@ -300,6 +308,9 @@ private:
 	/** Completion events (task) for the physics scenes	(both apex and non-apex). This is a "join" of the above. */
 	FGraphEventRef PhysicsSceneCompletion;
 
+	/** Whether the sync scene step in flight was started by EndFrame, and gets fetched by the next StartFrame */
+	bool bLaggedSyncStepInFlight;
+
 #if WITH_PHYSX
 	/** Dispatcher for CPU tasks */
 	class PxCpuDispatcher*			CPUDispatcher;
@@ -360,6 +371,23 @@ public:
 	/** Waits for cloth scene to complete */
 	ENGINE_API void WaitClothScene();
 
+	/** @return Whether the sync scene step started at the end of the last frame is still waiting for its results to be fetched (see p.FrameLagSyncScene) */
+	bool IsSyncSceneFrameLagged() const
+	{
+		return bLaggedSyncStepInFlight;
+	}
+
+	/**
+	 * Gets the state of a body at the end of the last physics step applied to components by EndFrame, from a snapshot
+	 * instead of the physics scene. It needs no scene lock and doesn't change while the next step simulates, so worker
+	 * threads can read it at any time outside of EndFrame. Snapshots are only taken when p.FrameLagSyncScene is on.
+	 *
+	 * A body terminated since the last EndFrame keeps its state until the next one.
+	 *
+	 * @return false if the body didn't move during that step (or no snapshot was taken), its component transform is up to date then
+	 */
+	ENGINE_API bool GetSimulatedBodyState(const FBodyInstance* BodyInstance, FSimulatedBodyState& OutState) const;
+
 	/** Fetches results, fires events, and adds debug lines */
 	void ProcessPhysScene(uint32 SceneType);
 
@@ -464,6 +492,26 @@ private:
 	void UpdateActiveTransforms(uint32 SceneType);
 	void RemoveActiveBody(FBodyInstance* BodyInstance, uint32 SceneType);
 
+	/** Snapshot of the bodies that moved during a step */
+	struct FSimulatedBodyStates
+	{
+		TArray<FSimulatedBodyState> States;
+		TMap<const FBodyInstance*, int32> StateIndices;
+	};
+
+	/** Double buffered snapshots: results are fetched into the back buffer, which becomes the front one gameplay reads at EndFrame */
+	FSimulatedBodyStates SimulatedBodyStates[PST_MAX][2];
+	int32 FrontSimulatedBodyStates[PST_MAX];
+
+	/** Whether results were fetched into the back buffer since the last EndFrame */
+	bool bSimulatedBodyStatesFetched[PST_MAX];
+
+	/** Bodies terminated since the last EndFrame, removed from the snapshots when they flip so readers never see them change */
+	TArray<const FBodyInstance*> PendingSimulatedBodyStateRemovals[PST_MAX];
+
+	/** Removes the terminated bodies from both snapshot buffers, only called when nothing reads or writes them */
+	void ApplySimulatedBodyStateRemovals(uint32 SceneType);
+
 #endif
 
 #if WITH_SUBSTEPPING
@@ -0,0 +1,135 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	SceneComponentTransformStore.h: Flattened scene component attachment hierarchies.
+=============================================================================*/
+
+#pragma once
+
+/**
+ * World level store of the attachment hierarchies of registered scene components, each flattened into contiguous,
+ * parent sorted (depth first) arrays of relative and world transforms.
+ *
+ * When a component with attached children moves, USceneComponent::UpdateChildTransforms hands its subtree to the store,
+ * which gathers the relative transforms, recomputes every world transform in one pass over the arrays (parents come before
+ * their children), and then writes them to ComponentToWorld and runs the transform update of each component in the same
+ * order as the recursive walk would. ComponentToWorld stays what every accessor reads, the store only caches the layout
+ * of the hierarchy and the transforms of the update in flight.
+ *
+ * Children attached to a socket or to a parent with sockets, unregistered children and components adjusting their
+ * ComponentToWorld (USceneComponent::AdjustNewComponentToWorld overrides, found by AdjustsComponentToWorld) are updated the
+ * regular way, as the first component of their own hierarchy. A batched update interrupted by a component of its hierarchy
+ * being moved or re-attached from a transform update callback falls back to the regular walk for the whole subtree.
+ *
+ * Enabled by SceneComponent.TransformStore. Game thread only.
+ */
+class ENGINE_API FSceneComponentTransformStore : public FNoncopyable
+{
+public:
+	FSceneComponentTransformStore();
+	~FSceneComponentTransformStore();
+
+	/**
+	 * Updates the ComponentToWorld of every component attached below Parent.
+	 * @return false if the store can't update them, in which case the children must be updated the regular way
+	 */
+	static bool UpdateChildTransforms(USceneComponent* Parent);
+
+	/** Called when the ComponentToWorld of Component is updated the regular way, interrupts the batched update of its hierarchy */
+	static void NotifyTransformUpdated(USceneComponent* Component)
+	{
+		if (UpdatingStore)
+		{
+			UpdatingStore->OnTransformUpdatedOutsideBatch(Component);
+		}
+	}
+
+	/** Drops the cached hierarchies of Component and of its parent, after Component was attached, detached, registered or unregistered */
+	static void NotifyAttachmentChanged(USceneComponent* Component);
+
+	/** @return Number of components in the cached hierarchies */
+	int32 GetNumComponents() const
+	{
+		return Entries.Num();
+	}
+
+private:
+	/** Per component flags */
+	enum EEntryFlags
+	{
+		/** Updated with UpdateComponentToWorld, its children aren't part of the hierarchy */
+		EF_RegularUpdate	= 1 << 0,
+		EF_AbsoluteLocation	= 1 << 1,
+		EF_AbsoluteRotation	= 1 << 2,
+		EF_AbsoluteScale	= 1 << 3,
+	};
+
+	/** A flattened attachment hierarchy, all arrays are indexed by the depth first position of a component */
+	struct FHierarchy
+	{
+		TArray<USceneComponent*> Components;
+
+		/** Index of the parent, INDEX_NONE for the first component */
+		TArray<int32> ParentIndices;
+
+		/** One past the index of the last component below each component */
+		TArray<int32> SubtreeEnds;
+
+		/** Combination of EEntryFlags */
+		TArray<uint8> Flags;
+
+		TArray<FTransform> RelativeTransforms;
+		TArray<FTransform> WorldTransforms;
+
+		/** Set when the hierarchy changed while its batched update was in flight, it is dropped once the update is done */
+		bool bPendingRemove;
+	};
+
+	/** Where a component's entry is */
+	struct FEntryLocation
+	{
+		int32 HierarchyIndex;
+		int32 Index;
+	};
+
+	/** A component whose children are being updated, waiting for the end of its transform update */
+	struct FOpenEntry
+	{
+		int32 Index;
+		bool bTransformChanged;
+	};
+
+	/** @return Whether Child can be part of the hierarchy of its AttachParent */
+	static bool CanBatchWithParent(const USceneComponent* Child);
+
+	/** Finds the hierarchy holding Component, builds it if needed. @return false if Component can't be updated through the store */
+	bool FindOrAddEntry(USceneComponent* Component, FEntryLocation& OutLocation);
+
+	/** Appends Component and (unless updated the regular way) everything below it to a hierarchy */
+	void AddEntry(int32 HierarchyIndex, USceneComponent* Component, int32 ParentIndex, bool bRegularUpdate);
+
+	/** Drops a hierarchy, or flags it for removal if its update is in flight */
+	void RemoveHierarchy(int32 HierarchyIndex);
+
+	/** Updates the components below entry Index of a hierarchy. @return false if the update was interrupted */
+	bool UpdateSubtree(int32 HierarchyIndex, int32 Index);
+
+	/** Runs the part of the transform update of Component that comes after its children were updated */
+	static void CloseEntry(USceneComponent* Component, bool bTransformChanged);
+
+	void OnTransformUpdatedOutsideBatch(USceneComponent* Component);
+
+	TSparseArray<FHierarchy> Hierarchies;
+
+	/** Entry of every component in a hierarchy, except the components updated the regular way */
+	TMap<USceneComponent*, FEntryLocation> Entries;
+
+	/** Hierarchy of the batched update in flight, INDEX_NONE if none */
+	int32 UpdatingHierarchy;
+
+	/** Set when the batched update in flight must fall back to the regular walk */
+	bool bUpdateInterrupted;
+
+	/** Store running a batched update, NULL if none. Batched updates don't nest */
+	static FSceneComponentTransformStore* UpdatingStore;
+};
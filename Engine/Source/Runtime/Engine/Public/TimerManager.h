@@ -70,28 +70,26 @@ struct FTimerUnifiedDelegate
 };
 
 // Unique handle that can be used to distinguish timers that have identical delegates.
+// Holds the index of the timer in its FTimerManager, so the manager can find it without searching, and a serial
+// number, so a handle to a timer that was cleared never refers to a later timer stored at the same index.
 struct FTimerHandle
 {
-	FTimerHandle()
-	: Handle(INDEX_NONE)
-	{
-
-	}
+	friend class FTimerManager;
 
-	FTimerHandle(int32 InHandle)
-		: Handle(InHandle)
+	FTimerHandle()
+	: Handle(0)
 	{
 
 	}
 
 	bool IsValid() const
 	{
-		return Handle != INDEX_NONE;
+		return Handle != 0;
 	}
 
 	void Invalidate()
 	{
-		Handle = INDEX_NONE;
+		Handle = 0;
 	}
 
 	void MakeValid();
@@ -108,11 +106,31 @@ struct FTimerHandle
 
 	FString ToString() const
 	{
-		return FString::Printf(TEXT("%d"), Handle);
+		return FString::Printf(TEXT("%llu"), Handle);
 	}
 
 private:
-	int32 Handle;
+	enum
+	{
+		IndexBits = 24,
+		MaxIndex = 1 << IndexBits,
+		/** Index of handles made valid without being given to a timer manager */
+		NoIndex = MaxIndex - 1
+	};
+
+	void SetIndexAndSerialNumber(int32 Index, uint64 SerialNumber)
+	{
+		check(Index >= 0 && Index < MaxIndex);
+		check(SerialNumber > 0 && SerialNumber < ((uint64)1 << (64 - IndexBits)));
+		Handle = (SerialNumber << IndexBits) | (uint64)Index;
+	}
+
+	int32 GetIndex() const
+	{
+		return (int32)(Handle & (uint64)(MaxIndex - 1));
+	}
+
+	uint64 Handle;
 };
 
 namespace ETimerStatus
@@ -178,10 +196,7 @@ public:
 	// ----------------------------------
 	// Timer API
 
-	FTimerManager()
-		: InternalTime(0.0)
-		, LastTickedFrame(static_cast<uint64>(-1))
-	{}
+	FTimerManager();
 
 
 	/**
@@ -393,36 +408,41 @@ public:
 	DELEGATE_DEPRECATED("This overload of UnPauseTimer is deprecated, use UnPauseTimer(FTimerHandle InHandle) instead.")
 	FORCEINLINE void UnPauseTimer(UserClass* inObj, typename FTimerDelegate::TUObjectMethodDelegate< UserClass >::FMethodPtr inTimerMethod)
 	{
-		int32 TimerIdx = DEPRECATED_FindTimerInList( PausedTimerList, FTimerUnifiedDelegate( FTimerDelegate::CreateUObject(inObj, inTimerMethod) ) );
-		InternalUnPauseTimer(TimerIdx);
+		int32 TimerIdx;
+		FTimerData const* TimerToUnPause = DEPRECATED_FindTimer(FTimerUnifiedDelegate( FTimerDelegate::CreateUObject(inObj, inTimerMethod) ), &TimerIdx);
+		InternalUnPauseTimer(TimerToUnPause, TimerIdx);
 	}
 	template< class UserClass >
 	DELEGATE_DEPRECATED("This overload of UnPauseTimer is deprecated, use UnPauseTimer(FTimerHandle InHandle) instead.")
 	FORCEINLINE void UnPauseTimer(UserClass* inObj, typename FTimerDelegate::TUObjectMethodDelegate_Const< UserClass >::FMethodPtr inTimerMethod)
 	{
-		int32 TimerIdx = DEPRECATED_FindTimerInList( PausedTimerList, FTimerUnifiedDelegate( FTimerDelegate::CreateUObject(inObj, inTimerMethod) ) );
-		InternalUnPauseTimer(TimerIdx);
+		int32 TimerIdx;
+		FTimerData const* TimerToUnPause = DEPRECATED_FindTimer(FTimerUnifiedDelegate( FTimerDelegate::CreateUObject(inObj, inTimerMethod) ), &TimerIdx);
+		InternalUnPauseTimer(TimerToUnPause, TimerIdx);
 	}
 
 	/** Version that takes any generic delegate. */
 	DELEGATE_DEPRECATED("This overload of UnPauseTimer is deprecated, use UnPauseTimer(FTimerHandle InHandle) instead.")
 	FORCEINLINE void UnPauseTimer(FTimerDelegate const& InDelegate)
 	{
-		int32 TimerIdx = DEPRECATED_FindTimerInList( PausedTimerList, FTimerUnifiedDelegate(InDelegate) );
-		InternalUnPauseTimer(TimerIdx);
+		int32 TimerIdx;
+		FTimerData const* TimerToUnPause = DEPRECATED_FindTimer(FTimerUnifiedDelegate(InDelegate), &TimerIdx);
+		InternalUnPauseTimer(TimerToUnPause, TimerIdx);
 	}
 	/** Version that takes a dynamic delegate (e.g. for UFunctions). */
 	DELEGATE_DEPRECATED("This overload of UnPauseTimer is deprecated, use UnPauseTimer(FTimerHandle InHandle) instead.")
 	FORCEINLINE void UnPauseTimer(FTimerDynamicDelegate const& InDynDelegate)
 	{
-		int32 TimerIdx = DEPRECATED_FindTimerInList( PausedTimerList, FTimerUnifiedDelegate(InDynDelegate) );
-		InternalUnPauseTimer(TimerIdx);
+		int32 TimerIdx;
+		FTimerData const* TimerToUnPause = DEPRECATED_FindTimer(FTimerUnifiedDelegate(InDynDelegate), &TimerIdx);
+		InternalUnPauseTimer(TimerToUnPause, TimerIdx);
 	}
 	/** Version that takes a handle */
 	FORCEINLINE void UnPauseTimer(FTimerHandle InHandle)
 	{
-		int32 TimerIdx = FindTimerInList(PausedTimerList, InHandle);
-		InternalUnPauseTimer(TimerIdx);
+		int32 TimerIdx;
+		FTimerData const* TimerToUnPause = FindTimer(InHandle, &TimerIdx);
+		InternalUnPauseTimer(TimerToUnPause, TimerIdx);
 	}
 
 	/**
@@ -760,30 +780,90 @@ private:
 	void InternalSetTimerForNextTick( FTimerUnifiedDelegate const& InDelegate );
 	void DEPRECATED_InternalClearTimer( FTimerUnifiedDelegate const& InDelegate );
 	void InternalClearTimer( FTimerHandle const& InDelegate );
-	void InternalClearTimer( int32 TimerIdx, ETimerStatus::Type TimerStatus );
+	void InternalClearTimer( int32 TimerIdx );
 	void InternalClearAllTimers( void const* Object );
 
-	/** Will find a timer in the active, paused, or pending list. */
+	/** Will find a timer, regardless whether it is active, paused or pending. OutTimerIndex is the index of the timer in Timers. */
 	FTimerData const* DEPRECATED_FindTimer( FTimerUnifiedDelegate const& InDelegate, int32* OutTimerIndex=nullptr ) const;
 	FTimerData const* FindTimer( FTimerHandle const& InHandle, int32* OutTimerIndex = nullptr ) const;
 
 	void InternalPauseTimer( FTimerData const* TimerToPause, int32 TimerIdx );
-	void InternalUnPauseTimer( int32 PausedTimerIdx );
+	void InternalUnPauseTimer( FTimerData const* TimerToUnPause, int32 TimerIdx );
 	
 	float InternalGetTimerRate( FTimerData const* const TimerData ) const;
 	float InternalGetTimerElapsed( FTimerData const* const TimerData ) const;
 	float InternalGetTimerRemaining( FTimerData const* const TimerData ) const;
 
-	/** Will find the given timer in the given TArray and return its index. */ 
-	int32 DEPRECATED_FindTimerInList( const TArray<FTimerData> &SearchArray, FTimerUnifiedDelegate const& InDelegate ) const;
-	int32 FindTimerInList( const TArray<FTimerData> &SearchArray, FTimerHandle const& InHandle ) const;
+	/** Stores a new timer, reusing the index of its handle when possible. Handle timers are given a new handle otherwise. */
+	int32 AddTimer( FTimerData const& NewTimerData );
+
+	/** Removes a timer from the timing wheel or the pending list, it stays in Timers */
+	void UnlinkTimer( int32 TimerIdx );
+
+	/** Adds an active timer to the timing wheel bucket of its ExpireTime */
+	void LinkTimerToWheel( int32 TimerIdx );
 
-	/** Heap of actively running timers. */
-	TArray<FTimerData> ActiveTimerHeap;
-	/** Unordered list of paused timers. */
-	TArray<FTimerData> PausedTimerList;
-	/** List of timers added this frame, to be added after timer has been ticked */
-	TArray<FTimerData> PendingTimerList;
+	/** Adds a timer to the list of timers activated by the next tick */
+	void AddPendingTimer( int32 TimerIdx );
+
+	/** Advances the timing wheel to InternalTime, and collects the indices of the expired timers in ExpiredTimers */
+	void GatherExpiredTimers();
+
+	/** Re-links the timers of a bucket of one of the upper levels, once the levels below it went around */
+	void CascadeWheel();
+
+	/** @return Wheel tick at which the given time falls */
+	static uint64 GetWheelTick( double Time );
+
+	/** Timing wheel layout: WheelNumLevels levels of WheelLevelSize buckets, each level WheelLevelSize times coarser than the level below */
+	enum
+	{
+		WheelLevelBits = 8,
+		WheelLevelSize = 1 << WheelLevelBits,
+		WheelNumLevels = 4,
+		WheelTicksPerSecond = 128,
+	};
+
+	/** Bucket of a timer that was collected by GatherExpiredTimers and is waiting to fire */
+	enum { ExpiredBucket = -2 };
+
+	/** A timer, with its links in the timing wheel or its index in PendingTimers */
+	struct FTimerSlot
+	{
+		FTimerData Data;
+
+		/** Timing wheel bucket of an active timer, INDEX_NONE if the timer isn't in the wheel */
+		int32 Bucket;
+		int32 PrevInBucket;
+		int32 NextInBucket;
+
+		/** Index in PendingTimers of a pending timer */
+		int32 PendingIndex;
+
+		FTimerSlot()
+			: Bucket(INDEX_NONE), PrevInBucket(INDEX_NONE), NextInBucket(INDEX_NONE), PendingIndex(INDEX_NONE)
+		{}
+	};
+
+	friend struct FCompareExpiredTimers;
+
+	/** Every timer, active, paused or pending. Handles hold the index of their timer. */
+	TSparseArray<FTimerSlot> Timers;
+
+	/** First timer of each timing wheel bucket, the buckets of level L are at [L * WheelLevelSize, (L + 1) * WheelLevelSize) */
+	int32 WheelBuckets[WheelNumLevels * WheelLevelSize];
+
+	/** Number of timers in each level of the timing wheel */
+	int32 NumTimersInWheelLevel[WheelNumLevels];
+
+	/** Last wheel tick the timing wheel was advanced to */
+	uint64 WheelTick;
+
+	/** Indices of the timers added this frame, to be activated after the timer manager has been ticked */
+	TArray<int32> PendingTimers;
+
+	/** Indices of the timers that expired during the current tick, in the order they fire */
+	TArray<int32> ExpiredTimers;
 
 	/** An internally consistent clock, independent of World.  Advances during ticking. */
 	double InternalTime;
@@ -791,6 +871,9 @@ private:
 	/** Timer delegate currently being executed.  Used to handle "timer delegates that manipulating timers" cases. */
 	FTimerData CurrentlyExecutingTimer;
 
+	/** Index of the timer being executed, its slot is reserved until it either loops or gets removed. INDEX_NONE when the slot was reused by setting the timer again during its execution. */
+	int32 ExecutingTimerIndex;
+
 	/** Set this to GFrameCounter when Timer is ticked. To figure out if Timer has been already ticked or not this frame. */
 	uint64 LastTickedFrame;
 };
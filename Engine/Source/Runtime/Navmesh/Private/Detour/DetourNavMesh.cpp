@@ -1248,6 +1248,7 @@ void dtNavMesh::connectClusterLink(dtMeshTile* tile0, unsigned int clusterIdx0,
 	}
 
 	// assign cost and side properties
+	link->cost = dtVdist(cluster0.center, tile1->clusters[clusterIdx1].center);
 	link->flags = link->flags | flags;
 }
 
@@ -2364,6 +2365,38 @@ dtStatus dtNavMesh::getPolyArea(dtPolyRef ref, unsigned char* resultArea) const
 }
 
 //@UE4 BEGIN 
+static void applyTileOffset(dtMeshHeader* header, float* verts, float* detailVerts, dtOffMeshConnection* offMeshCons, dtCluster* clusters, const float* offset)
+{
+	// Shift tile bounds
+	dtVadd(header->bmin, header->bmin, offset);
+	dtVadd(header->bmax, header->bmax, offset);
+	
+	//Shift tile vertices
+	for (int j = 0; j < header->vertCount; ++j)
+	{
+		dtVadd(&(verts[j*3]), &(verts[j*3]), offset);
+	}
+	
+	//Shift tile details vertices
+	for (int j = 0; j < header->detailVertCount; ++j)
+	{
+		dtVadd(&(detailVerts[j*3]), &(detailVerts[j*3]), offset);
+	}
+
+	//Shift off-mesh connections
+	for (int j = 0; j < header->offMeshConCount; ++j)
+	{
+		dtVadd(&(offMeshCons[j].pos[0]), &(offMeshCons[j].pos[0]), offset);
+		dtVadd(&(offMeshCons[j].pos[3]), &(offMeshCons[j].pos[3]), offset);
+	}
+	
+	// Shift clusters
+	for (int j = 0; j < header->clusterCount; ++j)
+	{
+		dtVadd(&(clusters[j].center[0]), &(clusters[j].center[0]), offset);
+	}
+}
+
 void dtNavMesh::applyWorldOffset(const float* offset)
 {
 	//Shift navmesh origin
@@ -2376,35 +2409,33 @@ void dtNavMesh::applyWorldOffset(const float* offset)
 		dtMeshTile& tile = m_tiles[i];
 		if (tile.header != NULL)
 		{
-			// Shift tile bounds
-			dtVadd(tile.header->bmin, tile.header->bmin, offset);
-			dtVadd(tile.header->bmax, tile.header->bmax, offset);
-			
-			//Shift tile vertices
-			for (int j = 0; j < tile.header->vertCount; ++j)
-			{
-				dtVadd(&(tile.verts[j*3]), &(tile.verts[j*3]), offset);
-			}
-			
-			//Shift tile details vertices
-			for (int j = 0; j < tile.header->detailVertCount; ++j)
-			{
-				dtVadd(&(tile.detailVerts[j*3]), &(tile.detailVerts[j*3]), offset);
-			}
-
-			//Shift off-mesh connections
-			for (int j = 0; j < tile.header->offMeshConCount; ++j)
-			{
-				dtVadd(&(tile.offMeshCons[j].pos[0]), &(tile.offMeshCons[j].pos[0]), offset);
-				dtVadd(&(tile.offMeshCons[j].pos[3]), &(tile.offMeshCons[j].pos[3]), offset);
-			}
-			
-			// Shift clusters
-			for (int j = 0; j < tile.header->clusterCount; ++j)
-			{
-				dtVadd(&(tile.clusters[j].center[0]), &(tile.clusters[j].center[0]), offset);
-			}
+			applyTileOffset(tile.header, tile.verts, tile.detailVerts, tile.offMeshCons, tile.clusters, offset);
 		}
 	}
 }
+
+void dtApplyTileDataOffset(unsigned char* data, const float* offset)
+{
+	dtMeshHeader* header = (dtMeshHeader*)data;
+
+	// Same layout as in dtNavMesh::addTile
+	const int headerSize = dtAlign4(sizeof(dtMeshHeader));
+	const int vertsSize = dtAlign4(sizeof(float)*3*header->vertCount);
+	const int polysSize = dtAlign4(sizeof(dtPoly)*header->polyCount);
+	const int linksSize = dtAlign4(sizeof(dtLink)*(header->maxLinkCount));
+	const int detailMeshesSize = dtAlign4(sizeof(dtPolyDetail)*header->detailMeshCount);
+	const int detailVertsSize = dtAlign4(sizeof(float)*3*header->detailVertCount);
+	const int detailTrisSize = dtAlign4(sizeof(unsigned char)*4*header->detailTriCount);
+	const int bvtreeSize = dtAlign4(sizeof(dtBVNode)*header->bvNodeCount);
+	const int offMeshLinksSize = dtAlign4(sizeof(dtOffMeshConnection)*header->offMeshConCount);
+	const int offMeshSegsSize = dtAlign4(sizeof(dtOffMeshSegmentConnection)*header->offMeshSegConCount);
+
+	unsigned char* d = data + headerSize;
+	float* verts = (float*)d; d += vertsSize + polysSize + linksSize + detailMeshesSize;
+	float* detailVerts = (float*)d; d += detailVertsSize + detailTrisSize + bvtreeSize;
+	dtOffMeshConnection* offMeshCons = (dtOffMeshConnection*)d; d += offMeshLinksSize + offMeshSegsSize;
+	dtCluster* clusters = (dtCluster*)d;
+
+	applyTileOffset(header, verts, detailVerts, offMeshCons, clusters, offset);
+}
 //@UE4 END
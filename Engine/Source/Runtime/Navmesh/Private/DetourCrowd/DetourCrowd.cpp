@@ -354,7 +354,16 @@ dtCrowd::dtCrowd() :
 	m_velocitySampleCount(0),
 	m_navquery(0),
 	m_raycastSingleArea(0),
-	m_keepOffmeshConnections(0)
+	m_keepOffmeshConnections(0),
+	m_agentChunkSize(0),
+	m_maxAgentChunks(0),
+	m_chunkObstacleQueries(0),
+	m_chunkVelocitySamples(0),
+	m_avoidanceMaxNeighbors(0),
+	m_avoidanceMaxWalls(0),
+	m_avoidanceMaxPatterns(0),
+	m_parallelFor(0),
+	m_parallelForUserData(0)
 {
 }
 
@@ -384,6 +393,8 @@ void dtCrowd::purge()
 	dtFreeProximityGrid(m_grid);
 	m_grid = 0;
 
+	purgeAgentChunks();
+
 	dtFreeObstacleAvoidanceQuery(m_obstacleQuery);
 	m_obstacleQuery = 0;
 	
@@ -469,6 +480,13 @@ bool dtCrowd::initAvoidance(const int maxNeighbors, const int maxWalls, const in
 	if (!m_obstacleQuery->init(maxNeighbors, maxWalls, maxCustomPatterns))
 		return false;
 
+	m_avoidanceMaxNeighbors = maxNeighbors;
+	m_avoidanceMaxWalls = maxWalls;
+	m_avoidanceMaxPatterns = maxCustomPatterns;
+	purgeAgentChunks();
+	if (!setParallelUpdate(m_agentChunkSize, 1))
+		return false;
+
 	// Init obstacle query params.
 	memset(m_obstacleQueryParams, 0, sizeof(m_obstacleQueryParams));
 	for (int i = 0; i < DT_CROWD_MAX_OBSTAVOIDANCE_PARAMS; ++i)
@@ -504,7 +522,8 @@ const dtObstacleAvoidanceParams* dtCrowd::getObstacleAvoidanceParams(const int i
 
 void dtCrowd::setObstacleAvoidancePattern(int idx, const float* angles, const float* radii, int nsamples)
 {
-	m_obstacleQuery->setCustomSamplingPattern(idx, angles, radii, nsamples);
+	for (int i = 0; i < m_maxAgentChunks; ++i)
+		getChunkObstacleQuery(i)->setCustomSamplingPattern(idx, angles, radii, nsamples);
 }
 
 bool dtCrowd::getObstacleAvoidancePattern(int idx, float* angles, float* radii, int* nsamples)
@@ -512,6 +531,81 @@ bool dtCrowd::getObstacleAvoidancePattern(int idx, float* angles, float* radii,
 	return m_obstacleQuery->getCustomSamplingPattern(idx, angles, radii, nsamples);
 }
 
+void dtCrowd::purgeAgentChunks()
+{
+	for (int i = 0; i < m_maxAgentChunks - 1; ++i)
+		dtFreeObstacleAvoidanceQuery(m_chunkObstacleQueries[i]);
+	dtFree(m_chunkObstacleQueries);
+	m_chunkObstacleQueries = 0;
+
+	dtFree(m_chunkVelocitySamples);
+	m_chunkVelocitySamples = 0;
+	m_maxAgentChunks = 0;
+}
+
+bool dtCrowd::setParallelUpdate(const int chunkSize, const int maxChunks)
+{
+	m_agentChunkSize = dtMax(chunkSize, 0);
+	if (!m_obstacleQuery)
+		return false;
+
+	const int numChunks = dtMax(maxChunks, 1);
+	if (numChunks == m_maxAgentChunks)
+		return true;
+
+	purgeAgentChunks();
+
+	m_chunkVelocitySamples = (int*)dtAlloc(sizeof(int)*numChunks, DT_ALLOC_PERM);
+	if (!m_chunkVelocitySamples)
+		return false;
+	memset(m_chunkVelocitySamples, 0, sizeof(int)*numChunks);
+
+	if (numChunks > 1)
+	{
+		m_chunkObstacleQueries = (dtObstacleAvoidanceQuery**)dtAlloc(sizeof(dtObstacleAvoidanceQuery*)*(numChunks - 1), DT_ALLOC_PERM);
+		if (!m_chunkObstacleQueries)
+		{
+			// fall back to single chunk
+			purgeAgentChunks();
+			setParallelUpdate(m_agentChunkSize, 1);
+			return false;
+		}
+		memset(m_chunkObstacleQueries, 0, sizeof(dtObstacleAvoidanceQuery*)*(numChunks - 1));
+	}
+	m_maxAgentChunks = numChunks;
+
+	// copies of first query, with the same sampling patterns
+	for (int i = 0; i < numChunks - 1; ++i)
+	{
+		dtObstacleAvoidanceQuery* query = dtAllocObstacleAvoidanceQuery();
+		m_chunkObstacleQueries[i] = query;
+		if (!query || !query->init(m_avoidanceMaxNeighbors, m_avoidanceMaxWalls, m_avoidanceMaxPatterns))
+		{
+			// fall back to single chunk
+			purgeAgentChunks();
+			setParallelUpdate(m_agentChunkSize, 1);
+			return false;
+		}
+
+		for (int patternIdx = 0; patternIdx < m_avoidanceMaxPatterns; ++patternIdx)
+		{
+			float angles[DT_MAX_CUSTOM_SAMPLES];
+			float radii[DT_MAX_CUSTOM_SAMPLES];
+			int nsamples = 0;
+			m_obstacleQuery->getCustomSamplingPattern(patternIdx, angles, radii, &nsamples);
+			query->setCustomSamplingPattern(patternIdx, angles, radii, nsamples);
+		}
+	}
+
+	return true;
+}
+
+void dtCrowd::setParallelFor(dtParallelForFunc parallelFor, void* userData)
+{
+	m_parallelFor = parallelFor;
+	m_parallelForUserData = userData;
+}
+
 const int dtCrowd::getAgentCount() const
 {
 	return m_maxAgents;
@@ -1216,6 +1310,43 @@ void dtCrowd::checkPathValidity(dtCrowdAgent** agents, const int nagents, const
 	}
 }
 
+void dtCrowd::runAgentChunks(dtAgentChunkFunc func, const float dt, dtCrowdAgentDebugInfo* debug)
+{
+	const int nagents = m_numActiveAgents;
+	int numChunks = 1;
+	if (m_parallelFor && m_agentChunkSize > 0 && m_maxAgentChunks > 1)
+	{
+		numChunks = dtMin((nagents + m_agentChunkSize - 1) / m_agentChunkSize, m_maxAgentChunks);
+	}
+
+	if (numChunks <= 1)
+	{
+		(this->*func)(dt, debug, 0, nagents, 0);
+		return;
+	}
+
+	// spread agents evenly when there are more of them than chunks allow
+	const int chunkSize = (nagents + numChunks - 1) / numChunks;
+	numChunks = (nagents + chunkSize - 1) / chunkSize;
+
+	dtAgentChunkJob job;
+	job.crowd = this;
+	job.func = func;
+	job.dt = dt;
+	job.debug = debug;
+	job.chunkSize = chunkSize;
+	job.nagents = nagents;
+
+	m_parallelFor(m_parallelForUserData, &dtCrowd::runAgentChunkJob, &job, numChunks);
+}
+
+void dtCrowd::runAgentChunkJob(void* jobData, const int chunkIdx)
+{
+	const dtAgentChunkJob* job = (const dtAgentChunkJob*)jobData;
+	const int first = chunkIdx * job->chunkSize;
+	(job->crowd->*job->func)(job->dt, job->debug, first, dtMin(job->chunkSize, job->nagents - first), chunkIdx);
+}
+
 void dtCrowd::update(const float dt, dtCrowdAgentDebugInfo* debug)
 {
 	int numActive = cacheActiveAgents();
@@ -1244,7 +1375,7 @@ void dtCrowd::updateStepPaths(const float dt, dtCrowdAgentDebugInfo*)
 	updateTopologyOptimization(m_activeAgents, m_numActiveAgents, dt);
 }
 
-void dtCrowd::updateStepProximityData(const float dt, dtCrowdAgentDebugInfo*)
+void dtCrowd::updateStepProximityData(const float dt, dtCrowdAgentDebugInfo* debug)
 {
 	// Register agents to proximity grid.
 	m_grid->clear();
@@ -1307,6 +1438,20 @@ void dtCrowd::updateStepProximityData(const float dt, dtCrowdAgentDebugInfo*)
 
 			m_raycastFilter.setAreaCost(allowedArea, DT_UNWALKABLE_POLY_COST);
 		}
+	}
+
+	// [UE4] boundaries share navmesh query, only neighbour queries can run in parallel
+	runAgentChunks(&dtCrowd::updateNeighboursChunk, dt, debug);
+}
+
+void dtCrowd::updateNeighboursChunk(const float dt, dtCrowdAgentDebugInfo*, const int first, const int num, const int)
+{
+	for (int i = first; i < first + num; ++i)
+	{
+		dtCrowdAgent* ag = m_activeAgents[i];
+		if (ag->state != DT_CROWDAGENT_STATE_WALKING)
+			continue;
+
 		// Query neighbour agents
 		ag->nneis = getNeighbours(ag->npos, ag->params.height, ag->params.collisionQueryRange,
 			ag, ag->neis, DT_CROWDAGENT_MAX_NEIGHBOURS,
@@ -1428,10 +1573,15 @@ void dtCrowd::updateStepNextMovePoint(const float dt, dtCrowdAgentDebugInfo* deb
 	}
 }
 
-void dtCrowd::updateStepSteering(const float dt, dtCrowdAgentDebugInfo*)
+void dtCrowd::updateStepSteering(const float dt, dtCrowdAgentDebugInfo* debug)
+{
+	runAgentChunks(&dtCrowd::updateSteeringChunk, dt, debug);
+}
+
+void dtCrowd::updateSteeringChunk(const float dt, dtCrowdAgentDebugInfo*, const int first, const int num, const int)
 {
 	// Calculate steering.
-	for (int i = 0; i < m_numActiveAgents; ++i)
+	for (int i = first; i < first + num; ++i)
 	{
 		dtCrowdAgent* ag = m_activeAgents[i];
 
@@ -1517,11 +1667,23 @@ void dtCrowd::updateStepSteering(const float dt, dtCrowdAgentDebugInfo*)
 
 void dtCrowd::updateStepAvoidance(const float dt, dtCrowdAgentDebugInfo* debug)
 {
-	const int debugIdx = debug ? debug->idx : -1;
+	memset(m_chunkVelocitySamples, 0, sizeof(int)*m_maxAgentChunks);
+
+	runAgentChunks(&dtCrowd::updateAvoidanceChunk, dt, debug);
+
 	m_velocitySampleCount = 0;
+	for (int i = 0; i < m_maxAgentChunks; ++i)
+		m_velocitySampleCount += m_chunkVelocitySamples[i];
+}
+
+void dtCrowd::updateAvoidanceChunk(const float dt, dtCrowdAgentDebugInfo* debug, const int first, const int num, const int chunkIdx)
+{
+	const int debugIdx = debug ? debug->idx : -1;
+	dtObstacleAvoidanceQuery* obstacleQuery = getChunkObstacleQuery(chunkIdx);
+	int velocitySampleCount = 0;
 
 	// Velocity planning.	
-	for (int i = 0; i < m_numActiveAgents; ++i)
+	for (int i = first; i < first + num; ++i)
 	{
 		dtCrowdAgent* ag = m_activeAgents[i];
 
@@ -1530,13 +1692,13 @@ void dtCrowd::updateStepAvoidance(const float dt, dtCrowdAgentDebugInfo* debug)
 
 		if (ag->params.updateFlags & DT_CROWD_OBSTACLE_AVOIDANCE)
 		{
-			m_obstacleQuery->reset();
+			obstacleQuery->reset();
 
 			// Add neighbours as obstacles.
 			for (int j = 0; j < ag->nneis; ++j)
 			{
 				const dtCrowdAgent* nei = &m_agents[ag->neis[j].idx];
-				m_obstacleQuery->addCircle(nei->npos, nei->params.radius, nei->vel, nei->dvel);
+				obstacleQuery->addCircle(nei->npos, nei->params.radius, nei->vel, nei->dvel);
 			}
 
 			// Append neighbour segments as obstacles.
@@ -1545,7 +1707,7 @@ void dtCrowd::updateStepAvoidance(const float dt, dtCrowdAgentDebugInfo* debug)
 				const float* s = ag->boundary.getSegment(j);
 				if (dtTriArea2D(ag->npos, s, s + 3) < 0.0f)
 					continue;
-				m_obstacleQuery->addSegment(s, s + 3);
+				obstacleQuery->addSegment(s, s + 3);
 			}
 
 			dtObstacleAvoidanceDebugData* vod = 0;
@@ -1555,11 +1717,11 @@ void dtCrowd::updateStepAvoidance(const float dt, dtCrowdAgentDebugInfo* debug)
 
 			// Sample new safe velocity.
 			const dtObstacleAvoidanceParams* params = &m_obstacleQueryParams[ag->params.obstacleAvoidanceType];
-			const int ns = m_obstacleQuery->sampleVelocity(
+			const int ns = obstacleQuery->sampleVelocity(
 					ag->npos, ag->params.radius, ag->desiredSpeed,
 					ag->vel, ag->dvel, ag->nvel, params, vod);
 
-			m_velocitySampleCount += ns;
+			velocitySampleCount += ns;
 		}
 		else
 		{
@@ -1567,83 +1729,96 @@ void dtCrowd::updateStepAvoidance(const float dt, dtCrowdAgentDebugInfo* debug)
 			dtVcopy(ag->nvel, ag->dvel);
 		}
 	}
+
+	m_chunkVelocitySamples[chunkIdx] = velocitySampleCount;
 }
 
-void dtCrowd::updateStepMove(const float dt, dtCrowdAgentDebugInfo*)
+void dtCrowd::updateStepMove(const float dt, dtCrowdAgentDebugInfo* debug)
 {
 	// Integrate.
-	for (int i = 0; i < m_numActiveAgents; ++i)
+	runAgentChunks(&dtCrowd::integrateChunk, dt, debug);
+
+	// Handle collisions.
+	for (int iter = 0; iter < 4; ++iter)
+	{
+		// [UE4] displacements of all agents are computed from positions before the iteration, then applied
+		runAgentChunks(&dtCrowd::updateCollisionChunk, dt, debug);
+
+		for (int i = 0; i < m_numActiveAgents; ++i)
+		{
+			dtCrowdAgent* ag = m_activeAgents[i];
+			if (ag->state != DT_CROWDAGENT_STATE_WALKING)
+				continue;
+
+			dtVadd(ag->npos, ag->npos, ag->disp);
+		}
+	}
+}
+
+void dtCrowd::integrateChunk(const float dt, dtCrowdAgentDebugInfo*, const int first, const int num, const int)
+{
+	for (int i = first; i < first + num; ++i)
 	{
 		dtCrowdAgent* ag = m_activeAgents[i];
 		if (ag->state != DT_CROWDAGENT_STATE_WALKING)
 			continue;
 		integrate(ag, dt);
 	}
+}
 
-	// Handle collisions.
+void dtCrowd::updateCollisionChunk(const float dt, dtCrowdAgentDebugInfo*, const int first, const int num, const int)
+{
 	static const float COLLISION_RESOLVE_FACTOR = 0.7f;
 
-	for (int iter = 0; iter < 4; ++iter)
+	for (int i = first; i < first + num; ++i)
 	{
-		for (int i = 0; i < m_numActiveAgents; ++i)
-		{
-			dtCrowdAgent* ag = m_activeAgents[i];
-			const int idx0 = getAgentIndex(ag);
+		dtCrowdAgent* ag = m_activeAgents[i];
+		const int idx0 = getAgentIndex(ag);
 
-			if (ag->state != DT_CROWDAGENT_STATE_WALKING)
-				continue;
+		if (ag->state != DT_CROWDAGENT_STATE_WALKING)
+			continue;
 
-			dtVset(ag->disp, 0, 0, 0);
+		dtVset(ag->disp, 0, 0, 0);
 
-			float w = 0;
+		float w = 0;
 
-			for (int j = 0; j < ag->nneis; ++j)
-			{
-				const dtCrowdAgent* nei = &m_agents[ag->neis[j].idx];
-				const int idx1 = getAgentIndex(nei);
+		for (int j = 0; j < ag->nneis; ++j)
+		{
+			const dtCrowdAgent* nei = &m_agents[ag->neis[j].idx];
+			const int idx1 = getAgentIndex(nei);
 
-				float diff[3];
-				dtVsub(diff, ag->npos, nei->npos);
-				diff[1] = 0;
+			float diff[3];
+			dtVsub(diff, ag->npos, nei->npos);
+			diff[1] = 0;
 
-				float dist = dtVlenSqr(diff);
-				if (dist > dtSqr(ag->params.radius + nei->params.radius))
-					continue;
-				dist = sqrtf(dist);
-				float pen = (ag->params.radius + nei->params.radius) - dist;
-				if (dist < 0.0001f)
-				{
-					// m_activeAgents on top of each other, try to choose diverging separation directions.
-					if (idx0 > idx1)
-						dtVset(diff, -ag->dvel[2], 0, ag->dvel[0]);
-					else
-						dtVset(diff, ag->dvel[2], 0, -ag->dvel[0]);
-					pen = 0.01f;
-				}
+			float dist = dtVlenSqr(diff);
+			if (dist > dtSqr(ag->params.radius + nei->params.radius))
+				continue;
+			dist = sqrtf(dist);
+			float pen = (ag->params.radius + nei->params.radius) - dist;
+			if (dist < 0.0001f)
+			{
+				// m_activeAgents on top of each other, try to choose diverging separation directions.
+				if (idx0 > idx1)
+					dtVset(diff, -ag->dvel[2], 0, ag->dvel[0]);
 				else
-				{
-					pen = (1.0f / dist) * (pen*0.5f) * COLLISION_RESOLVE_FACTOR;
-				}
-
-				dtVmad(ag->disp, ag->disp, diff, pen);
-
-				w += 1.0f;
+					dtVset(diff, ag->dvel[2], 0, -ag->dvel[0]);
+				pen = 0.01f;
 			}
-
-			if (w > 0.0001f)
+			else
 			{
-				const float iw = 1.0f / w;
-				dtVscale(ag->disp, ag->disp, iw);
+				pen = (1.0f / dist) * (pen*0.5f) * COLLISION_RESOLVE_FACTOR;
 			}
+
+			dtVmad(ag->disp, ag->disp, diff, pen);
+
+			w += 1.0f;
 		}
 
-		for (int i = 0; i < m_numActiveAgents; ++i)
+		if (w > 0.0001f)
 		{
-			dtCrowdAgent* ag = m_activeAgents[i];
-			if (ag->state != DT_CROWDAGENT_STATE_WALKING)
-				continue;
-
-			dtVadd(ag->npos, ag->npos, ag->disp);
+			const float iw = 1.0f / w;
+			dtVscale(ag->disp, ag->disp, iw);
 		}
 	}
 }
@@ -31,48 +31,6 @@
 
 static const float DT_PI = 3.14159265f;
 
-static int sweepCircleCircle(const float* c0, const float r0, const float* v,
-							 const float* c1, const float r1,
-							 float& tmin, float& tmax)
-{
-	static const float EPS = 0.0001f;
-	float s[3];
-	dtVsub(s,c1,c0);
-	float r = r0+r1;
-	float c = dtVdot2D(s,s) - r*r;
-	float a = dtVdot2D(v,v);
-	if (a < EPS) return 0;	// not moving
-	
-	// Overlap, calc time to exit.
-	float b = dtVdot2D(v,s);
-	float d = b*b - a*c;
-	if (d < 0.0f) return 0; // no intersection.
-	a = 1.0f / a;
-	const float rd = dtSqrt(d);
-	tmin = (b - rd) * a;
-	tmax = (b + rd) * a;
-	return 1;
-}
-
-static int isectRaySeg(const float* ap, const float* u,
-					   const float* bp, const float* bq,
-					   float& t)
-{
-	float v[3], w[3];
-	dtVsub(v,bq,bp);
-	dtVsub(w,ap,bp);
-	float d = dtVperp2D(u,v);
-	if (fabsf(d) < 1e-6f) return 0;
-	d = 1.0f/d;
-	t = dtVperp2D(v,w) * d;
-	if (t < 0 || t > 1) return 0;
-	float s = dtVperp2D(u,w) * d;
-	if (s < 0 || s > 1) return 0;
-	return 1;
-}
-
-
-
 dtObstacleAvoidanceDebugData* dtAllocObstacleAvoidanceDebugData()
 {
 	void* mem = dtAlloc(sizeof(dtObstacleAvoidanceDebugData), DT_ALLOC_PERM);
@@ -218,7 +176,8 @@ dtObstacleAvoidanceQuery::dtObstacleAvoidanceQuery() :
 	m_ncircles(0),
 	m_maxSegments(0),
 	m_segments(0),
-	m_nsegments(0)
+	m_nsegments(0),
+	m_nsamples(0)
 {
 }
 
@@ -324,54 +283,89 @@ void dtObstacleAvoidanceQuery::prepare(const float* pos, const float* dvel)
 	}	
 }
 
-float dtObstacleAvoidanceQuery::processSample(const float* vcand, const float cs,
+// [UE4] penalty terms of single candidate velocity, shared by processSamples and its debug output
+static inline void calcSamplePenalties(const float vx, const float vz, const float side, const float tmin,
+									   const float* vel, const float* dvel, const dtObstacleAvoidanceParams& params,
+									   const float invVmax, const float invHorizTime,
+									   float& vpen, float& vcpen, float& spen, float& tpen)
+{
+	// same as dtVdist2D(vcand, dvel) and dtVdist2D(vcand, vel)
+	const float ddx = dvel[0] - vx;
+	const float ddz = dvel[2] - vz;
+	const float cdx = vel[0] - vx;
+	const float cdz = vel[2] - vz;
+
+	vpen = params.weightDesVel * (sqrtf(ddx*ddx + ddz*ddz) * invVmax);
+	vcpen = params.weightCurVel * (sqrtf(cdx*cdx + cdz*cdz) * invVmax);
+	spen = params.weightSide * side;
+	tpen = params.weightToi * (1.0f/(0.1f+tmin*invHorizTime));
+}
+
+/// @par
+///
+/// [UE4] Obstacles are iterated in outer loops and candidates in inner ones. Inner loops are branchless
+/// and work on contiguous arrays, so they can be vectorized, while every candidate still goes through
+/// obstacles in the same order and with the same math as in the per sample version: results are exactly the same.
+void dtObstacleAvoidanceQuery::processSamples(const float cs,
 											  const float* pos, const float rad,
 											  const float* vel, const float* dvel,
 											  dtObstacleAvoidanceDebugData* debug)
 {
+	static const float EPS = 0.0001f;
+	const int ns = m_nsamples;
+	const float* vx = m_sampleVelX;
+	const float* vz = m_sampleVelZ;
+	float* tmins = m_sampleTmin;
+	float* sides = m_sampleSide;
+
 	// Find min time of impact and exit amongst all obstacles.
-	float tmin = m_params.horizTime;
-	float side = 0;
-	int nside = 0;
-	
+	for (int j = 0; j < ns; ++j)
+	{
+		tmins[j] = m_params.horizTime;
+		sides[j] = 0;
+	}
+
 	for (int i = 0; i < m_ncircles; ++i)
 	{
 		const dtObstacleCircle* cir = &m_circles[i];
-			
-		// RVO
-		float vab[3];
-		dtVscale(vab, vcand, 2);
-		dtVsub(vab, vab, vel);
-		dtVsub(vab, vab, cir->vel);
-		
-		// Side
-		side += dtClamp(dtMin(dtVdot2D(cir->dp,vab)*0.5f+0.5f, dtVdot2D(cir->np,vab)*2), 0.0f, 1.0f);
-		nside++;
-		
-		float htmin = 0, htmax = 0;
-		if (!sweepCircleCircle(pos,rad, vab, cir->p,cir->rad, htmin, htmax))
-			continue;
-		
-		// Handle overlapping obstacles.
-		if (htmin < 0.0f && htmax > 0.0f)
-		{
-			// Avoid more when overlapped.
-			htmin = -htmin * 0.5f;
-		}
-		
-		if (htmin >= 0.0f)
+
+		// Sweep circle vs circle, parts independent from candidate velocity
+		float s[3];
+		dtVsub(s, cir->p, pos);
+		const float r = rad + cir->rad;
+		const float c = dtVdot2D(s, s) - r*r;
+
+		for (int j = 0; j < ns; ++j)
 		{
+			// RVO
+			const float vabx = (vx[j]*2 - vel[0]) - cir->vel[0];
+			const float vabz = (vz[j]*2 - vel[2]) - cir->vel[2];
+
+			// Side
+			sides[j] += dtClamp(dtMin((cir->dp[0]*vabx + cir->dp[2]*vabz)*0.5f+0.5f, (cir->np[0]*vabx + cir->np[2]*vabz)*2), 0.0f, 1.0f);
+
+			// Sweep, no intersection when not moving or d < 0
+			const float a = vabx*vabx + vabz*vabz;
+			const float b = vabx*s[0] + vabz*s[2];
+			const float d = b*b - a*c;
+			const bool bHit = !(a < EPS) && !(d < 0.0f);
+			const float ia = 1.0f / (bHit ? a : 1.0f);
+			const float rd = sqrtf(bHit ? d : 0.0f);
+			float htmin = (b - rd) * ia;
+			const float htmax = (b + rd) * ia;
+
+			// Handle overlapping obstacles, avoid more when overlapped.
+			htmin = (htmin < 0.0f && htmax > 0.0f) ? -htmin * 0.5f : htmin;
+
 			// The closest obstacle is somewhere ahead of us, keep track of nearest obstacle.
-			if (htmin < tmin)
-				tmin = htmin;
+			tmins[j] = (bHit && htmin >= 0.0f && htmin < tmins[j]) ? htmin : tmins[j];
 		}
 	}
 
 	for (int i = 0; i < m_nsegments; ++i)
 	{
 		const dtObstacleSegment* seg = &m_segments[i];
-		float htmin = 0;
-		
+
 		if (seg->touch)
 		{
 			// Special case when the agent is very close to the segment.
@@ -379,42 +373,66 @@ float dtObstacleAvoidanceQuery::processSample(const float* vcand, const float cs
 			dtVsub(sdir, seg->q, seg->p);
 			snorm[0] = -sdir[2];
 			snorm[2] = sdir[0];
-			// If the velocity is pointing towards the segment, no collision.
-			if (dtVdot2D(snorm, vcand) < 0.0f)
-				continue;
-			// Else immediate collision.
-			htmin = 0.0f;
+
+			for (int j = 0; j < ns; ++j)
+			{
+				// If the velocity is pointing towards the segment, no collision. Else immediate collision.
+				const bool bHit = !(snorm[0]*vx[j] + snorm[2]*vz[j] < 0.0f);
+				tmins[j] = (bHit && 0.0f < tmins[j]) ? 0.0f : tmins[j];
+			}
 		}
 		else
 		{
-			if (!isectRaySeg(pos, vcand, seg->p, seg->q, htmin))
-				continue;
+			// Ray vs segment intersection, parts independent from candidate velocity
+			float v[3], w[3];
+			dtVsub(v, seg->q, seg->p);
+			dtVsub(w, pos, seg->p);
+			const float vw = dtVperp2D(v, w);
+
+			for (int j = 0; j < ns; ++j)
+			{
+				const float d = vz[j]*v[0] - vx[j]*v[2];
+				const bool bCrossing = !(fabsf(d) < 1e-6f);
+				const float id = 1.0f / (bCrossing ? d : 1.0f);
+				const float t = vw * id;
+				const float u = (vz[j]*w[0] - vx[j]*w[2]) * id;
+				const bool bHit = bCrossing && !(t < 0 || t > 1) && !(u < 0 || u > 1);
+
+				// Avoid less when facing walls.
+				const float htmin = t * 2.0f;
+
+				// The closest obstacle is somewhere ahead of us, keep track of nearest obstacle.
+				tmins[j] = (bHit && htmin < tmins[j]) ? htmin : tmins[j];
+			}
 		}
-		
-		// Avoid less when facing walls.
-		htmin *= 2.0f;
-		
-		// The closest obstacle is somewhere ahead of us, keep track of nearest obstacle.
-		if (htmin < tmin)
-			tmin = htmin;
 	}
-	
+
 	// Normalize side bias, to prevent it dominating too much.
-	if (nside)
-		side /= nside;
-	
-	const float vpen = m_params.weightDesVel * (dtVdist2D(vcand, dvel) * m_invVmax);
-	const float vcpen = m_params.weightCurVel * (dtVdist2D(vcand, vel) * m_invVmax);
-	const float spen = m_params.weightSide * side;
-	const float tpen = m_params.weightToi * (1.0f/(0.1f+tmin*m_invHorizTime));
-	
-	const float penalty = vpen + vcpen + spen + tpen;
-	
+	if (m_ncircles)
+	{
+		for (int j = 0; j < ns; ++j)
+			sides[j] /= m_ncircles;
+	}
+
+	for (int j = 0; j < ns; ++j)
+	{
+		float vpen, vcpen, spen, tpen;
+		calcSamplePenalties(vx[j], vz[j], sides[j], tmins[j], vel, dvel, m_params, m_invVmax, m_invHorizTime, vpen, vcpen, spen, tpen);
+		m_samplePenalty[j] = vpen + vcpen + spen + tpen;
+	}
+
 	// Store different penalties for debug viewing
 	if (debug)
-		debug->addSample(vcand, cs, penalty, vpen, vcpen, spen, tpen);
-	
-	return penalty;
+	{
+		for (int j = 0; j < ns; ++j)
+		{
+			float vpen, vcpen, spen, tpen;
+			calcSamplePenalties(vx[j], vz[j], sides[j], tmins[j], vel, dvel, m_params, m_invVmax, m_invHorizTime, vpen, vcpen, spen, tpen);
+
+			const float vcand[3] = { vx[j], 0, vz[j] };
+			debug->addSample(vcand, cs, m_samplePenalty[j], vpen, vcpen, spen, tpen);
+		}
+	}
 }
 
 bool dtObstacleAvoidanceQuery::setCustomSamplingPattern(int idx, const float* angles, const float* radii, int nsamples)
@@ -478,21 +496,26 @@ int dtObstacleAvoidanceQuery::sampleVelocityCustom(const float* pos, const float
 	bool bFoundSample = false;
 	dtVset(res, dvel[0] * m_params.velBias, 0, dvel[2] * m_params.velBias);
 
+	m_nsamples = 0;
 	for (int i = 0; i < pattern.nsamples; ++i)
 	{
-		float vcand[3];
-		vcand[0] = res[0] + pat[i * 2 + 0] * cr;
-		vcand[1] = 0;
-		vcand[2] = res[2] + pat[i * 2 + 1] * cr;
+		const float vx = res[0] + pat[i * 2 + 0] * cr;
+		const float vz = res[2] + pat[i * 2 + 1] * cr;
 
-		if (dtSqr(vcand[0]) + dtSqr(vcand[2]) > dtSqr(vmax + 0.001f)) continue;
+		if (dtSqr(vx) + dtSqr(vz) > dtSqr(vmax + 0.001f)) continue;
 
-		const float penalty = processSample(vcand, 20.0f, pos, rad, vel, dvel, debug);
-		if (penalty < minPenalty)
+		addSample(vx, vz);
+	}
+
+	processSamples(20.0f, pos, rad, vel, dvel, debug);
+
+	for (int i = 0; i < m_nsamples; ++i)
+	{
+		if (m_samplePenalty[i] < minPenalty)
 		{
 			bFoundSample = true;
-			minPenalty = penalty;
-			dtVcopy(nvel, vcand);
+			minPenalty = m_samplePenalty[i];
+			dtVset(nvel, m_sampleVelX[i], 0, m_sampleVelZ[i]);
 		}
 	}
 
@@ -564,21 +587,26 @@ int dtObstacleAvoidanceQuery::sampleVelocityAdaptive(const float* pos, const flo
 		float bvel[3];
 		dtVset(bvel, 0,0,0);
 		
+		m_nsamples = 0;
 		for (int i = 0; i < npat; ++i)
 		{
-			float vcand[3];
-			vcand[0] = res[0] + pat[i*2+0]*cr;
-			vcand[1] = 0;
-			vcand[2] = res[2] + pat[i*2+1]*cr;
+			const float vx = res[0] + pat[i*2+0]*cr;
+			const float vz = res[2] + pat[i*2+1]*cr;
 			
-			if (dtSqr(vcand[0])+dtSqr(vcand[2]) > dtSqr(vmax+0.001f)) continue;
+			if (dtSqr(vx)+dtSqr(vz) > dtSqr(vmax+0.001f)) continue;
 			
-			const float penalty = processSample(vcand,cr/10, pos,rad,vel,dvel, debug);
-			ns++;
-			if (penalty < minPenalty)
+			addSample(vx, vz);
+		}
+
+		processSamples(cr/10, pos,rad,vel,dvel, debug);
+		ns += m_nsamples;
+
+		for (int i = 0; i < m_nsamples; ++i)
+		{
+			if (m_samplePenalty[i] < minPenalty)
 			{
-				minPenalty = penalty;
-				dtVcopy(bvel, vcand);
+				minPenalty = m_samplePenalty[i];
+				dtVset(bvel, m_sampleVelX[i], 0, m_sampleVelZ[i]);
 			}
 		}
 
@@ -313,6 +313,7 @@ struct dtClusterLink
 {
 	dtClusterRef ref;				///< Destination tile and cluster
 	unsigned int next;				///< Next link in dtMeshTile.links array
+	float cost;						///< Cost of traversing the link (distance between cluster centers)
 	unsigned char flags;			///< Link traversing data
 };
 
@@ -815,6 +816,14 @@ NAVMESH_API dtNavMesh* dtAllocNavMesh();
 ///  @ingroup detour
 NAVMESH_API void dtFreeNavMesh(dtNavMesh* navmesh);
 
+//@UE4 BEGIN
+/// Shifts tile data that is not added to any navigation mesh, the same way dtNavMesh::applyWorldOffset shifts its tiles.
+///  @param[in]	data		Data of the tile, laid out as by #dtCreateNavMeshData.
+///  @param[in]	offset		The offset to apply. [(x, y, z)]
+///  @ingroup detour
+NAVMESH_API void dtApplyTileDataOffset(unsigned char* data, const float* offset);
+//@UE4 END
+
 // @UE4 BEGIN: helper for reading tiles
 struct ReadTilesHelper
 {
@@ -264,6 +264,36 @@ public:
 
 };
 
+//@UE4 BEGIN
+/// Limits another filter to the ground polygons of a set of clusters, used to refine a path found with dtNavMeshQuery::findClusterPath.
+/// Off-mesh connections aren't part of any cluster and only need to pass the base filter.
+/// @ingroup detour
+class NAVMESH_API dtClusterCorridorFilter : public dtQueryFilter
+{
+public:
+	///  @param[in]		nav				The navigation mesh the clusters belong to.
+	///  @param[in]		baseFilter		The filter every polygon has to pass, also used for costs.
+	///  @param[in]		clusters		The clusters the path can go through, sorted in ascending order. [(clusterRef) * @p clusterCount]
+	///  @param[in]		clusterCount	The number of clusters.
+	dtClusterCorridorFilter(const dtNavMesh* nav, const dtQueryFilter* baseFilter, const dtClusterRef* clusters, const int clusterCount);
+
+protected:
+	virtual bool passVirtualFilter(const dtPolyRef ref,
+		const dtMeshTile* tile,
+		const dtPoly* poly) const;
+
+	virtual float getVirtualCost(const float* pa, const float* pb,
+		const dtPolyRef prevRef, const dtMeshTile* prevTile, const dtPoly* prevPoly,
+		const dtPolyRef curRef, const dtMeshTile* curTile, const dtPoly* curPoly,
+		const dtPolyRef nextRef, const dtMeshTile* nextTile, const dtPoly* nextPoly) const;
+
+	const dtNavMesh* m_nav;
+	const dtQueryFilter* m_baseFilter;
+	const dtClusterRef* m_clusters;
+	const int m_clusterCount;
+};
+//@UE4 END
+
 struct dtQueryResultPack
 {
 	dtPolyRef ref;
@@ -278,6 +308,7 @@ struct dtQueryResultPack
 struct NAVMESH_API dtQueryResult
 {
 	inline void reserve(int n) { data.resize(n); data.resize(0); }
+	inline void reset() { data.resize(0); }
 	inline int size() const { return data.size(); }
 
 	inline dtPolyRef getRef(int idx) const { return data[idx].ref; }
@@ -346,6 +377,19 @@ public:
 	///  @param[in]		endRef				The reference id of the end polygon.
 	dtStatus testClusterPath(dtPolyRef startRef, dtPolyRef endRef) const; 
 
+	//@UE4 BEGIN
+	/// Finds a path from the cluster of the start polygon to the cluster of the end polygon on the cluster graph,
+	/// using the cost of cluster links. Filters don't apply, refine it with findPath and dtClusterCorridorFilter.
+	///  @param[in]		startRef	The reference id of the start polygon.
+	///  @param[in]		endRef		The reference id of the end polygon.
+	///  @param[out]	path		An ordered list of cluster references representing the path. (Start to end.) [(clusterRef) * @p pathCount]
+	///  @param[out]	pathCount	The number of clusters returned in the @p path array.
+	///  @param[in]		maxPath		The maximum number of clusters the @p path array can hold. [Limit: >= 1]
+	/// @returns The status flags for the query. DT_INVALID_PARAM if the polygons have no clusters.
+	dtStatus findClusterPath(dtPolyRef startRef, dtPolyRef endRef,
+							 dtClusterRef* path, int* pathCount, const int maxPath) const;
+	//@UE4 END
+
 	/// Finds the straight path from the start to the end position within the polygon corridor.
 	///  @param[in]		startPos			Path start position. [(x, y, z)]
 	///  @param[in]		endPos				Path end position. [(x, y, z)]
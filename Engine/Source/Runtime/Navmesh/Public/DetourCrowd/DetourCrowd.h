@@ -210,6 +210,12 @@ struct NAVMESH_API dtCrowdAgentDebugInfo
 	dtObstacleAvoidanceDebugData* vod;
 };
 
+/// [UE4] Job run by a parallel for callback, processes chunk jobIdx of jobData
+typedef void (*dtParallelJobFunc)(void* jobData, const int jobIdx);
+
+/// [UE4] Runs func for every job in [0, numJobs), possibly on other threads, and returns when all of them are done
+typedef void (*dtParallelForFunc)(void* userData, dtParallelJobFunc func, void* jobData, const int numJobs);
+
 /// Provides local steering behaviors for a group of agents. 
 /// @ingroup crowd
 class NAVMESH_API dtCrowd
@@ -250,10 +256,60 @@ class NAVMESH_API dtCrowd
 	// [UE4] if set, offmesh connections won't be cut from corridor
 	bool m_keepOffmeshConnections;
 
+	// [UE4] number of active agents processed by single task in per agent parts of update steps, 0 = don't split
+	int m_agentChunkSize;
+	// [UE4] max number of chunks in flight, each one needs its own avoidance query
+	int m_maxAgentChunks;
+	// [UE4] avoidance queries of chunks [1..m_maxAgentChunks), first chunk uses m_obstacleQuery
+	dtObstacleAvoidanceQuery** m_chunkObstacleQueries;
+	// [UE4] velocity samples taken by each chunk in last avoidance step
+	int* m_chunkVelocitySamples;
+	// [UE4] initAvoidance params, for creating avoidance queries of chunks
+	int m_avoidanceMaxNeighbors;
+	int m_avoidanceMaxWalls;
+	int m_avoidanceMaxPatterns;
+	// [UE4] runs chunks of update steps, set by owner, 0 = all agents are processed on calling thread
+	dtParallelForFunc m_parallelFor;
+	void* m_parallelForUserData;
+
 	void updateTopologyOptimization(dtCrowdAgent** agents, const int nagents, const float dt);
 	void updateMoveRequest(const float dt);
 	void checkPathValidity(dtCrowdAgent** agents, const int nagents, const float dt);
 
+	/// [UE4] Per agent part of update step, processes active agents [first, first + num) and writes only their data
+	typedef void (dtCrowd::*dtAgentChunkFunc)(const float dt, dtCrowdAgentDebugInfo* debug, const int first, const int num, const int chunkIdx);
+
+	/// [UE4] Runs func over all active agents, split in chunks passed to parallel for callback when it's allowed by setParallelUpdate
+	void runAgentChunks(dtAgentChunkFunc func, const float dt, dtCrowdAgentDebugInfo* debug);
+
+	/// [UE4] Chunked run of update step, passed to parallel for callback as job data
+	struct dtAgentChunkJob
+	{
+		dtCrowd* crowd;
+		dtAgentChunkFunc func;
+		float dt;
+		dtCrowdAgentDebugInfo* debug;
+		int chunkSize;
+		int nagents;
+	};
+
+	/// [UE4] Processes single chunk of dtAgentChunkJob
+	static void runAgentChunkJob(void* jobData, const int chunkIdx);
+
+	void updateNeighboursChunk(const float dt, dtCrowdAgentDebugInfo* debug, const int first, const int num, const int chunkIdx);
+	void updateSteeringChunk(const float dt, dtCrowdAgentDebugInfo* debug, const int first, const int num, const int chunkIdx);
+	void updateAvoidanceChunk(const float dt, dtCrowdAgentDebugInfo* debug, const int first, const int num, const int chunkIdx);
+	void integrateChunk(const float dt, dtCrowdAgentDebugInfo* debug, const int first, const int num, const int chunkIdx);
+	void updateCollisionChunk(const float dt, dtCrowdAgentDebugInfo* debug, const int first, const int num, const int chunkIdx);
+
+	/// [UE4] Frees avoidance queries of chunks
+	void purgeAgentChunks();
+
+	inline dtObstacleAvoidanceQuery* getChunkObstacleQuery(const int chunkIdx) const
+	{
+		return chunkIdx ? m_chunkObstacleQueries[chunkIdx - 1] : m_obstacleQuery;
+	}
+
 	bool requestMoveTargetReplan(const int idx, dtPolyRef ref, const float* pos);
 
 	void purge();
@@ -275,6 +331,19 @@ public:
 	///  @param[in]		maxCustomPatterns	The maximum number of custom sampling patterns
 	/// @return True if the initialization succeeded.
 	bool initAvoidance(const int maxNeighbors, const int maxWalls, const int maxCustomPatterns);
+
+	/// [UE4] Splits neighbour queries, steering, avoidance and collisions of active agents in chunks, run by parallel for callback.
+	/// Every agent is processed the same way regardless of chunk it ends up in, so results don't depend on those settings.
+	/// Must be called after initAvoidance, chunks are processed on calling thread until setParallelFor is called.
+	///  @param[in]		chunkSize	Number of agents processed by single job, 0 to process all agents on calling thread
+	///  @param[in]		maxChunks	Max number of jobs in flight, including calling thread [Limit: >= 1]
+	/// @return True if the avoidance queries of chunks were allocated.
+	bool setParallelUpdate(const int chunkSize, const int maxChunks);
+
+	/// [UE4] Sets callback running chunks of update steps, jobs of single call can run concurrently
+	///  @param[in]		parallelFor	Callback, 0 to process all agents on calling thread
+	///  @param[in]		userData	Passed to callback
+	void setParallelFor(dtParallelForFunc parallelFor, void* userData);
 	
 	/// Sets the shared avoidance configuration for the specified index.
 	///  @param[in]		idx		The index. [Limits: 0 <= value < #DT_CROWD_MAX_OBSTAVOIDANCE_PARAMS]
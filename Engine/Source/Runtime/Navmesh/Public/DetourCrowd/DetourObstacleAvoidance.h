@@ -157,7 +157,16 @@ private:
 
 	void prepare(const float* pos, const float* dvel);
 
-	float processSample(const float* vcand, const float cs,
+	// [UE4] adds candidate velocity to current sampling step
+	inline void addSample(const float vx, const float vz)
+	{
+		m_sampleVelX[m_nsamples] = vx;
+		m_sampleVelZ[m_nsamples] = vz;
+		m_nsamples++;
+	}
+
+	// [UE4] computes penalties of all candidates of current sampling step, replaces per sample processSample
+	void processSamples(const float cs,
 						const float* pos, const float rad,
 						const float* vel, const float* dvel,
 						dtObstacleAvoidanceDebugData* debug);
@@ -180,6 +189,15 @@ private:
 	int m_maxSegments;
 	dtObstacleSegment* m_segments;
 	int m_nsegments;
+
+	// [UE4] candidates of current sampling step, stored as separate arrays for vectorized processing
+	static const int MAX_SAMPLES = DT_MAX_PATTERN_DIVS*DT_MAX_PATTERN_RINGS+1;
+	float m_sampleVelX[MAX_SAMPLES];
+	float m_sampleVelZ[MAX_SAMPLES];
+	float m_sampleTmin[MAX_SAMPLES];
+	float m_sampleSide[MAX_SAMPLES];
+	float m_samplePenalty[MAX_SAMPLES];
+	int m_nsamples;
 };
 
 NAVMESH_API dtObstacleAvoidanceQuery* dtAllocObstacleAvoidanceQuery();
@@ -47,7 +47,10 @@ bool AOnlineBeaconClient::InitClient(FURL& URL)
 
 				uint32 LocalNetworkVersion = FNetworkVersion::GetLocalNetworkVersion();
 				
-				FNetControlMessage<NMT_Hello>::Send(NetDriver->ServerConnection, IsLittleEndian, LocalNetworkVersion);
+				// Beacon connections don't compress packets
+				uint32 PacketCompressionChecksum = 0;
+
+				FNetControlMessage<NMT_Hello>::Send(NetDriver->ServerConnection, IsLittleEndian, LocalNetworkVersion, PacketCompressionChecksum);
 				NetDriver->ServerConnection->FlushNet();
 
 				bSuccess = true;